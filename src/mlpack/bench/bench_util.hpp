@@ -0,0 +1,194 @@
+/**
+ * @file bench/bench_util.hpp
+ * @author Ryan Curtin
+ *
+ * A minimal microbenchmark harness for the mlpack_bench target.  Benchmarks
+ * are registered with the MLPACK_BENCHMARK() macro and written in the usual
+ * timed-loop style:
+ *
+ * @code
+ * MLPACK_BENCHMARK(EuclideanEvaluate)
+ * {
+ *   const arma::vec a(128, arma::fill::randu);
+ *   const arma::vec b(128, arma::fill::randu);
+ *   while (state.KeepRunning())
+ *     DoNotOptimize(metric::EuclideanDistance::Evaluate(a, b));
+ * }
+ * @endcode
+ *
+ * The runner scales the iteration count automatically until a benchmark has
+ * run for long enough to give a stable ns/op figure, so setup code before the
+ * KeepRunning() loop may execute several times and should be cheap relative
+ * to the loop itself.
+ *
+ * We deliberately do not depend on an external benchmark library here; the
+ * harness is a single header so that mlpack_bench builds with exactly the
+ * dependencies mlpack_test already needs.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_BENCH_BENCH_UTIL_HPP
+#define MLPACK_BENCH_BENCH_UTIL_HPP
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+namespace mlpack {
+namespace bench {
+
+/**
+ * Iteration state handed to each benchmark function.  The benchmark body
+ * loops on KeepRunning(); timing starts at the first call and stops when the
+ * requested number of iterations has been handed out.
+ */
+class BenchmarkState
+{
+ public:
+  //! Create a state that will hand out the given number of iterations.
+  BenchmarkState(const size_t iterations) :
+      iterations(iterations),
+      count(0)
+  { }
+
+  //! Returns true until the requested number of iterations has been run.
+  bool KeepRunning()
+  {
+    if (count == 0)
+      start = std::chrono::high_resolution_clock::now();
+
+    if (count < iterations)
+    {
+      ++count;
+      return true;
+    }
+
+    stop = std::chrono::high_resolution_clock::now();
+    return false;
+  }
+
+  //! Return the number of iterations that were run.
+  size_t Iterations() const { return iterations; }
+
+  //! Return the wall-clock time spent inside the loop, in nanoseconds.
+  double ElapsedNanoseconds() const
+  {
+    return (double) std::chrono::duration_cast<std::chrono::nanoseconds>(
+        stop - start).count();
+  }
+
+ private:
+  //! Number of iterations to hand out.
+  size_t iterations;
+  //! Number of iterations handed out so far.
+  size_t count;
+  //! Time at which the first iteration started.
+  std::chrono::high_resolution_clock::time_point start;
+  //! Time at which the last iteration finished.
+  std::chrono::high_resolution_clock::time_point stop;
+};
+
+/**
+ * Prevent the compiler from optimizing away a value computed inside the
+ * benchmark loop.
+ */
+template<typename T>
+inline void DoNotOptimize(T&& value)
+{
+#if defined(__GNUC__) || defined(__clang__)
+  asm volatile("" : : "r"(&value) : "memory");
+#else
+  volatile const char sink = *((volatile const char*) &value);
+  (void) sink;
+#endif
+}
+
+//! The type of a registered benchmark function.
+typedef void (*BenchmarkFunction)(BenchmarkState& state);
+
+//! A registered benchmark: its printable name and its function.
+struct BenchmarkInfo
+{
+  std::string name;
+  BenchmarkFunction function;
+};
+
+//! Return the global list of registered benchmarks.
+inline std::vector<BenchmarkInfo>& BenchmarkRegistry()
+{
+  static std::vector<BenchmarkInfo> registry;
+  return registry;
+}
+
+/**
+ * Helper whose constructor registers a benchmark; MLPACK_BENCHMARK()
+ * instantiates one of these at static initialization time.
+ */
+struct BenchmarkRegistrar
+{
+  BenchmarkRegistrar(const std::string& name, BenchmarkFunction function)
+  {
+    BenchmarkRegistry().push_back({ name, function });
+  }
+};
+
+//! The result of running one benchmark.
+struct BenchmarkResult
+{
+  std::string name;
+  size_t iterations;
+  double nsPerOp;
+};
+
+/**
+ * Run one registered benchmark, scaling the iteration count until the timed
+ * loop has run for at least minTime seconds, and return the measured ns/op.
+ *
+ * @param info The benchmark to run.
+ * @param minTime Minimum wall-clock time (in seconds) the timed loop must
+ *     cover before the measurement is accepted.
+ */
+inline BenchmarkResult RunBenchmark(const BenchmarkInfo& info,
+                                    const double minTime = 0.5)
+{
+  const double minTimeNs = minTime * 1e9;
+  size_t iterations = 1;
+
+  while (true)
+  {
+    BenchmarkState state(iterations);
+    info.function(state);
+
+    const double elapsed = state.ElapsedNanoseconds();
+    if (elapsed >= minTimeNs || iterations >= (size_t) 1e9)
+      return { info.name, iterations, elapsed / iterations };
+
+    // Scale the iteration count toward the target time, with some headroom,
+    // but never grow by more than 100x in one step in case the first few runs
+    // were mistimed.
+    double factor = (elapsed > 0.0) ? 1.4 * minTimeNs / elapsed : 10.0;
+    if (factor < 2.0)
+      factor = 2.0;
+    if (factor > 100.0)
+      factor = 100.0;
+
+    iterations = (size_t) (iterations * factor);
+  }
+}
+
+} // namespace bench
+} // namespace mlpack
+
+/**
+ * Define and register a benchmark.  Use as a function definition whose body
+ * loops on state.KeepRunning().
+ */
+#define MLPACK_BENCHMARK(name) \
+    static void name(mlpack::bench::BenchmarkState& state); \
+    static mlpack::bench::BenchmarkRegistrar name##Registrar(#name, name); \
+    static void name(mlpack::bench::BenchmarkState& state)
+
+#endif
@@ -0,0 +1,49 @@
+/**
+ * @file bench/bound_bench.cpp
+ * @author Ryan Curtin
+ *
+ * Microbenchmarks for HRectBound::MinDistance(), the pruning kernel of
+ * kd-tree traversals.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#include <mlpack/core.hpp>
+#include <mlpack/core/tree/hrectbound.hpp>
+
+#include "bench_util.hpp"
+
+using namespace mlpack;
+using namespace mlpack::bench;
+using namespace mlpack::bound;
+
+MLPACK_BENCHMARK(HRectBoundMinDistancePoint)
+{
+  const arma::mat data(10, 1000, arma::fill::randu);
+  HRectBound<metric::EuclideanDistance> bound(data.n_rows);
+  bound |= data;
+
+  // Keep the point outside the bound so the distance computation cannot take
+  // the trivial zero path in any dimension.
+  arma::vec point(data.n_rows, arma::fill::randu);
+  point += 2.0;
+
+  while (state.KeepRunning())
+    DoNotOptimize(bound.MinDistance(point));
+}
+
+MLPACK_BENCHMARK(HRectBoundMinDistanceBound)
+{
+  const arma::mat data(10, 1000, arma::fill::randu);
+  HRectBound<metric::EuclideanDistance> bound(data.n_rows);
+  bound |= data;
+
+  arma::mat shifted = data + 2.0;
+  HRectBound<metric::EuclideanDistance> other(data.n_rows);
+  other |= shifted;
+
+  while (state.KeepRunning())
+    DoNotOptimize(bound.MinDistance(other));
+}
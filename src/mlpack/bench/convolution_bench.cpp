@@ -0,0 +1,61 @@
+/**
+ * @file bench/convolution_bench.cpp
+ * @author Ryan Curtin
+ *
+ * Microbenchmarks for the convolution rules used by the ANN convolutional
+ * layers.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#include <mlpack/core.hpp>
+#include <mlpack/methods/ann/convolution_rules/border_modes.hpp>
+#include <mlpack/methods/ann/convolution_rules/naive_convolution.hpp>
+#include <mlpack/methods/ann/convolution_rules/fft_convolution.hpp>
+
+#include "bench_util.hpp"
+
+using namespace mlpack;
+using namespace mlpack::ann;
+using namespace mlpack::bench;
+
+MLPACK_BENCHMARK(NaiveConvolutionValid)
+{
+  const arma::mat input(64, 64, arma::fill::randu);
+  const arma::mat filter(5, 5, arma::fill::randu);
+  arma::mat output;
+
+  while (state.KeepRunning())
+  {
+    NaiveConvolution<ValidConvolution>::Convolution(input, filter, output);
+    DoNotOptimize(output);
+  }
+}
+
+MLPACK_BENCHMARK(NaiveConvolutionFull)
+{
+  const arma::mat input(64, 64, arma::fill::randu);
+  const arma::mat filter(5, 5, arma::fill::randu);
+  arma::mat output;
+
+  while (state.KeepRunning())
+  {
+    NaiveConvolution<FullConvolution>::Convolution(input, filter, output);
+    DoNotOptimize(output);
+  }
+}
+
+MLPACK_BENCHMARK(FFTConvolutionValid)
+{
+  const arma::mat input(64, 64, arma::fill::randu);
+  const arma::mat filter(5, 5, arma::fill::randu);
+  arma::mat output;
+
+  while (state.KeepRunning())
+  {
+    FFTConvolution<ValidConvolution>::Convolution(input, filter, output);
+    DoNotOptimize(output);
+  }
+}
@@ -0,0 +1,74 @@
+/**
+ * @file bench/dataset_generators.hpp
+ * @author Ryan Curtin
+ *
+ * Parameterized synthetic dataset generators for the end-to-end method
+ * benchmarks.  All generators draw from the global random stream, so a run
+ * that seeds math::RandomSeed() first gets reproducible datasets.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_BENCH_DATASET_GENERATORS_HPP
+#define MLPACK_BENCH_DATASET_GENERATORS_HPP
+
+#include <mlpack/core.hpp>
+
+namespace mlpack {
+namespace bench {
+
+/**
+ * Generate a dataset drawn uniformly from the unit hypercube.
+ *
+ * @param dimensions Dimensionality of the dataset.
+ * @param points Number of points to generate.
+ * @param data Matrix to store the dataset in (one point per column).
+ */
+inline void UniformDataset(const size_t dimensions,
+                           const size_t points,
+                           arma::mat& data)
+{
+  data.randu(dimensions, points);
+}
+
+/**
+ * Generate a dataset of spherical Gaussian clusters with labels.  The cluster
+ * centers are drawn uniformly from a hypercube scaled by the separation
+ * factor, so larger separations give better-separated clusters.
+ *
+ * @param dimensions Dimensionality of the dataset.
+ * @param points Number of points to generate.
+ * @param clusters Number of Gaussian clusters.
+ * @param separation Edge length of the hypercube the centers are drawn from,
+ *     in units of the (unit) cluster standard deviation.
+ * @param data Matrix to store the dataset in (one point per column).
+ * @param labels Vector to store the cluster label of each point in.
+ */
+inline void GaussianClusterDataset(const size_t dimensions,
+                                   const size_t points,
+                                   const size_t clusters,
+                                   const double separation,
+                                   arma::mat& data,
+                                   arma::Row<size_t>& labels)
+{
+  arma::mat centers(dimensions, clusters, arma::fill::randu);
+  centers *= separation;
+
+  data.set_size(dimensions, points);
+  labels.set_size(points);
+
+  for (size_t i = 0; i < points; ++i)
+  {
+    const size_t cluster = i % clusters;
+    data.col(i) = centers.col(cluster) +
+        arma::randn<arma::vec>(dimensions);
+    labels[i] = cluster;
+  }
+}
+
+} // namespace bench
+} // namespace mlpack
+
+#endif
@@ -0,0 +1,178 @@
+/**
+ * @file bench/end_to_end_bench.cpp
+ * @author Ryan Curtin
+ *
+ * End-to-end benchmark driver for the major methods.  Each method (KNN,
+ * k-means, random forest, GMM, KDE) is run over a grid of synthetic datasets
+ * of varying size and dimensionality; for every run the driver records the
+ * wall-clock time, the throughput in points per second, the peak RSS of the
+ * process so far, and the per-phase timers the method itself emits (the same
+ * Timer names the command-line bindings report, e.g. "tree_building" and
+ * "computing_neighbors").  Results are printed as JSON lines on stdout so
+ * scaling behavior can be compared across machines and commits.
+ *
+ * Note that peak RSS is cumulative over the process lifetime, so only the
+ * first runs give a tight per-method figure; use the filter argument to
+ * measure a single method's footprint.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#include <mlpack/core.hpp>
+#include <mlpack/methods/neighbor_search/neighbor_search.hpp>
+#include <mlpack/methods/kmeans/kmeans.hpp>
+#include <mlpack/methods/random_forest/random_forest.hpp>
+#include <mlpack/methods/gmm/gmm.hpp>
+#include <mlpack/methods/kde/kde.hpp>
+
+#include <chrono>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+
+#ifndef _WIN32
+  #include <sys/resource.h>
+#endif
+
+#include "dataset_generators.hpp"
+
+using namespace mlpack;
+using namespace mlpack::bench;
+using namespace std;
+
+//! Return the peak resident set size of this process so far, in kilobytes.
+size_t PeakRSSKilobytes()
+{
+#ifndef _WIN32
+  struct rusage usage;
+  getrusage(RUSAGE_SELF, &usage);
+  return (size_t) usage.ru_maxrss;
+#else
+  return 0;
+#endif
+}
+
+/**
+ * Run one method over one dataset configuration and print a JSON line with
+ * the wall time, throughput, peak RSS and every phase timer the method
+ * emitted.
+ *
+ * @param method Name of the method being run.
+ * @param points Number of points in the dataset (for throughput).
+ * @param dimensions Dimensionality of the dataset.
+ * @param run The benchmark body.
+ */
+void RunScenario(const string& method,
+                 const size_t points,
+                 const size_t dimensions,
+                 const function<void()>& run)
+{
+  // Each scenario gets a fresh set of phase timers.
+  Timer::ResetAll();
+
+  const auto start = chrono::high_resolution_clock::now();
+  run();
+  const auto stop = chrono::high_resolution_clock::now();
+
+  const double seconds =
+      chrono::duration_cast<chrono::duration<double>>(stop - start).count();
+
+  cout << "{ \"method\": \"" << method << "\", "
+      << "\"points\": " << points << ", "
+      << "\"dimensions\": " << dimensions << ", "
+      << "\"seconds\": " << fixed << setprecision(6) << seconds << ", "
+      << "\"points_per_second\": " << setprecision(1)
+      << ((seconds > 0.0) ? (points / seconds) : 0.0) << ", "
+      << "\"peak_rss_kb\": " << PeakRSSKilobytes() << ", "
+      << "\"phases\": {";
+
+  bool first = true;
+  for (const auto& timer : CLI::GetSingleton().timer.GetAllTimers())
+  {
+    cout << (first ? " " : ", ") << "\"" << timer.first << "\": "
+        << setprecision(6) << (timer.second.count() / 1e6);
+    first = false;
+  }
+
+  cout << " } }" << endl;
+}
+
+int main(int argc, char** argv)
+{
+  const string filter = (argc > 1) ? argv[1] : "";
+
+  // The methods emit their phase timers only when timing is enabled.
+  Timer::EnableTiming();
+
+  // Pin the datasets so runs are comparable.
+  math::RandomSeed(42);
+
+  const size_t sizes[] = { 10000, 50000 };
+  const size_t dims[] = { 3, 10 };
+  const size_t clusters = 5;
+
+  for (const size_t n : sizes)
+  {
+    for (const size_t d : dims)
+    {
+      arma::mat data;
+      arma::Row<size_t> labels;
+      GaussianClusterDataset(d, n, clusters, 10.0, data, labels);
+
+      if (filter.empty() || filter == "knn")
+      {
+        RunScenario("knn", n, d, [&]()
+        {
+          neighbor::KNN knn(data);
+          arma::Mat<size_t> neighbors;
+          arma::mat distances;
+          knn.Search(5, neighbors, distances);
+        });
+      }
+
+      if (filter.empty() || filter == "kmeans")
+      {
+        RunScenario("kmeans", n, d, [&]()
+        {
+          kmeans::KMeans<> kmeans;
+          arma::Row<size_t> assignments;
+          arma::mat centroids;
+          kmeans.Cluster(data, clusters, assignments, centroids);
+        });
+      }
+
+      if (filter.empty() || filter == "random_forest")
+      {
+        RunScenario("random_forest", n, d, [&]()
+        {
+          tree::RandomForest<> rf;
+          rf.Train(data, labels, clusters, 10 /* numTrees */);
+        });
+      }
+
+      if (filter.empty() || filter == "gmm")
+      {
+        RunScenario("gmm", n, d, [&]()
+        {
+          gmm::GMM gmm(clusters, d);
+          gmm.Train(data, 1 /* trials */);
+        });
+      }
+
+      if (filter.empty() || filter == "kde")
+      {
+        RunScenario("kde", n, d, [&]()
+        {
+          kde::KDE<> kde;
+          kde.Train(data);
+          arma::vec estimations;
+          kde.Evaluate(estimations);
+        });
+      }
+    }
+  }
+
+  return 0;
+}
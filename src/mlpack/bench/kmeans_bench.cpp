@@ -0,0 +1,36 @@
+/**
+ * @file bench/kmeans_bench.cpp
+ * @author Ryan Curtin
+ *
+ * Microbenchmark for NaiveKMeans::Iterate(), the per-iteration kernel of
+ * Lloyd's algorithm.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#include <mlpack/core.hpp>
+#include <mlpack/methods/kmeans/naive_kmeans.hpp>
+
+#include "bench_util.hpp"
+
+using namespace mlpack;
+using namespace mlpack::bench;
+using namespace mlpack::kmeans;
+
+MLPACK_BENCHMARK(NaiveKMeansIterate)
+{
+  const arma::mat data(10, 2000, arma::fill::randu);
+  metric::EuclideanDistance metric;
+  NaiveKMeans<metric::EuclideanDistance, arma::mat> naive(data, metric);
+
+  const arma::mat centroids(10, 8, arma::fill::randu);
+  arma::mat newCentroids;
+  arma::Col<size_t> counts;
+
+  // UpdateBounds() is never called, so every Iterate() call takes the full
+  // unscreened pass; that is the kernel we want to measure.
+  while (state.KeepRunning())
+    DoNotOptimize(naive.Iterate(centroids, newCentroids, counts));
+}
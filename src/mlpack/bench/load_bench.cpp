@@ -0,0 +1,35 @@
+/**
+ * @file bench/load_bench.cpp
+ * @author Ryan Curtin
+ *
+ * Microbenchmark for CSV loading via data::Load().
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#include <mlpack/core.hpp>
+
+#include <cstdio>
+
+#include "bench_util.hpp"
+
+using namespace mlpack;
+using namespace mlpack::bench;
+
+MLPACK_BENCHMARK(LoadCSV)
+{
+  const std::string filename = "mlpack_bench_load.csv";
+  const arma::mat data(10, 2000, arma::fill::randu);
+  data::Save(filename, data);
+
+  arma::mat loaded;
+  while (state.KeepRunning())
+  {
+    data::Load(filename, loaded);
+    DoNotOptimize(loaded);
+  }
+
+  remove(filename.c_str());
+}
@@ -0,0 +1,47 @@
+/**
+ * @file bench/metric_bench.cpp
+ * @author Ryan Curtin
+ *
+ * Microbenchmarks for LMetric::Evaluate(), the innermost kernel of every
+ * distance-based method.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#include <mlpack/core.hpp>
+#include <mlpack/core/metrics/lmetric.hpp>
+
+#include "bench_util.hpp"
+
+using namespace mlpack;
+using namespace mlpack::bench;
+using namespace mlpack::metric;
+
+MLPACK_BENCHMARK(LMetricEuclideanEvaluate)
+{
+  const arma::vec a(128, arma::fill::randu);
+  const arma::vec b(128, arma::fill::randu);
+
+  while (state.KeepRunning())
+    DoNotOptimize(EuclideanDistance::Evaluate(a, b));
+}
+
+MLPACK_BENCHMARK(LMetricManhattanEvaluate)
+{
+  const arma::vec a(128, arma::fill::randu);
+  const arma::vec b(128, arma::fill::randu);
+
+  while (state.KeepRunning())
+    DoNotOptimize(ManhattanDistance::Evaluate(a, b));
+}
+
+MLPACK_BENCHMARK(LMetricSquaredEuclideanEvaluate)
+{
+  const arma::vec a(128, arma::fill::randu);
+  const arma::vec b(128, arma::fill::randu);
+
+  while (state.KeepRunning())
+    DoNotOptimize(SquaredEuclideanDistance::Evaluate(a, b));
+}
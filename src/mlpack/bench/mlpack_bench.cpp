@@ -0,0 +1,71 @@
+/**
+ * @file bench/mlpack_bench.cpp
+ * @author Ryan Curtin
+ *
+ * Driver for the mlpack_bench target.  Runs every registered microbenchmark
+ * (optionally filtered by a substring given as the first argument) and prints
+ * the results as a JSON document on stdout, so that runs can be archived and
+ * compared across commits; a human-readable summary goes to stderr.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#include <mlpack/core.hpp>
+
+#include <iomanip>
+#include <iostream>
+
+#include "bench_util.hpp"
+
+using namespace mlpack;
+using namespace mlpack::bench;
+using namespace std;
+
+int main(int argc, char** argv)
+{
+  const string filter = (argc > 1) ? argv[1] : "";
+
+  // Pin the datasets: every benchmark generates its data from this seed, so
+  // two runs of the same binary measure the same workload.
+  math::RandomSeed(42);
+
+  vector<BenchmarkResult> results;
+  for (const BenchmarkInfo& info : BenchmarkRegistry())
+  {
+    if (!filter.empty() && info.name.find(filter) == string::npos)
+      continue;
+
+    const BenchmarkResult result = RunBenchmark(info);
+    results.push_back(result);
+
+    cerr << left << setw(40) << result.name
+        << right << setw(12) << result.iterations << " iterations"
+        << setw(16) << fixed << setprecision(1) << result.nsPerOp
+        << " ns/op" << endl;
+  }
+
+  if (results.empty())
+  {
+    cerr << "No benchmarks matched filter '" << filter << "'!" << endl;
+    return 1;
+  }
+
+  // Emit the JSON document.  The fields are flat on purpose: downstream
+  // tracking only needs name, iterations and ns/op.
+  cout << "{" << endl;
+  cout << "  \"benchmarks\": [" << endl;
+  for (size_t i = 0; i < results.size(); ++i)
+  {
+    cout << "    { \"name\": \"" << results[i].name << "\", "
+        << "\"iterations\": " << results[i].iterations << ", "
+        << "\"ns_per_op\": " << fixed << setprecision(3)
+        << results[i].nsPerOp << " }"
+        << ((i + 1 < results.size()) ? "," : "") << endl;
+  }
+  cout << "  ]" << endl;
+  cout << "}" << endl;
+
+  return 0;
+}
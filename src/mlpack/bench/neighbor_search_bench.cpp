@@ -0,0 +1,74 @@
+/**
+ * @file bench/neighbor_search_bench.cpp
+ * @author Ryan Curtin
+ *
+ * Microbenchmarks for the NeighborSearchRules BaseCase() and Score() kernels,
+ * which dominate dual-tree and single-tree nearest neighbor search.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#include <mlpack/core.hpp>
+#include <mlpack/core/tree/binary_space_tree.hpp>
+#include <mlpack/methods/neighbor_search/neighbor_search_rules.hpp>
+#include <mlpack/methods/neighbor_search/neighbor_search_stat.hpp>
+#include <mlpack/methods/neighbor_search/sort_policies/nearest_neighbor_sort.hpp>
+
+#include "bench_util.hpp"
+
+using namespace mlpack;
+using namespace mlpack::bench;
+using namespace mlpack::neighbor;
+
+typedef tree::KDTree<metric::EuclideanDistance,
+    NeighborSearchStat<NearestNeighborSort>, arma::mat> TreeType;
+typedef NeighborSearchRules<NearestNeighborSort, metric::EuclideanDistance,
+    TreeType> RuleType;
+
+MLPACK_BENCHMARK(NeighborSearchRulesBaseCase)
+{
+  const arma::mat referenceSet(10, 1000, arma::fill::randu);
+  const arma::mat querySet(10, 256, arma::fill::randu);
+  metric::EuclideanDistance metric;
+  RuleType rules(referenceSet, querySet, 5 /* k */, metric);
+
+  // Walk the query/reference pairs so the BaseCase() duplicate-pair
+  // short-circuit never fires.
+  size_t q = 0, r = 0;
+  while (state.KeepRunning())
+  {
+    DoNotOptimize(rules.BaseCase(q, r));
+    if (++r == referenceSet.n_cols)
+    {
+      r = 0;
+      q = (q + 1) % querySet.n_cols;
+    }
+  }
+}
+
+MLPACK_BENCHMARK(NeighborSearchRulesScore)
+{
+  arma::mat referenceSet(10, 1000, arma::fill::randu);
+  const arma::mat querySet(10, 256, arma::fill::randu);
+
+  // The tree builder reorders its copy of the dataset, so the rules must see
+  // the tree's dataset, not the original.
+  TreeType tree(referenceSet);
+  metric::EuclideanDistance metric;
+  RuleType rules(tree.Dataset(), querySet, 5 /* k */, metric);
+
+  // No BaseCase() has run, so no prune can fire and every Score() call pays
+  // for the full bound computation.
+  TreeType& leftNode = (tree.Left() != NULL) ? *tree.Left() : tree;
+  TreeType& rightNode = (tree.Right() != NULL) ? *tree.Right() : tree;
+
+  size_t q = 0;
+  while (state.KeepRunning())
+  {
+    DoNotOptimize(rules.Score(q, leftNode));
+    DoNotOptimize(rules.Score(q, rightNode));
+    q = (q + 1) % querySet.n_cols;
+  }
+}
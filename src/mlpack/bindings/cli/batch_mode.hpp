@@ -0,0 +1,175 @@
+/**
+ * @file bindings/cli/batch_mode.hpp
+ * @author Ryan Curtin
+ *
+ * Batch mode for command-line bindings: one resident process reads successive
+ * command lines and runs the binding once per line, keeping models loaded
+ * from file cached between commands (see model_cache.hpp).
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_BINDINGS_CLI_BATCH_MODE_HPP
+#define MLPACK_BINDINGS_CLI_BATCH_MODE_HPP
+
+#include <mlpack/core.hpp>
+#include <fstream>
+#include "parse_command_line.hpp"
+#include "end_program.hpp"
+#include "model_cache.hpp"
+
+namespace mlpack {
+namespace bindings {
+namespace cli {
+
+/**
+ * Returns true if the user asked for batch mode, i.e. the first argument on
+ * the command line is '--batch'.  This is checked before ParseCommandLine()
+ * ever runs, so the flag cannot collide with any binding parameter.
+ */
+inline bool BatchModeRequested(int argc, char** argv)
+{
+  return (argc >= 2) && (std::string(argv[1]) == "--batch");
+}
+
+/**
+ * Split one command line into whitespace-separated tokens, honoring single
+ * and double quotes so that filenames containing spaces can be passed.
+ */
+inline std::vector<std::string> SplitCommandLine(const std::string& line)
+{
+  std::vector<std::string> tokens;
+  std::string token;
+  bool inToken = false;
+  char quote = '\0';
+  for (size_t i = 0; i < line.size(); ++i)
+  {
+    const char c = line[i];
+    if (quote != '\0')
+    {
+      if (c == quote)
+        quote = '\0';
+      else
+        token += c;
+    }
+    else if (c == '\'' || c == '"')
+    {
+      quote = c;
+      inToken = true;
+    }
+    else if (c == ' ' || c == '\t')
+    {
+      if (inToken)
+        tokens.push_back(token);
+      token.clear();
+      inToken = false;
+    }
+    else
+    {
+      token += c;
+      inToken = true;
+    }
+  }
+  if (inToken)
+    tokens.push_back(token);
+  return tokens;
+}
+
+/**
+ * Run the binding in batch mode.  Command lines are read from the file given
+ * after '--batch', or from stdin if no file was given, and the binding is run
+ * once per line inside this process:
+ *
+ * @code
+ * $ mlpack_knn --batch commands.txt
+ * $ generate_commands.sh | mlpack_knn --batch
+ * @endcode
+ *
+ * Each line holds the arguments of one invocation, without the program name
+ * (e.g. "--input_model_file model.bin --query_file q1.csv ...").  Every
+ * command starts from default parameter values, exactly as a fresh process
+ * would, but models loaded from file are kept in the ModelCache between
+ * commands: a pipeline that calls the same binding hundreds of times with the
+ * same input model pays the deserialization cost only once.
+ *
+ * Lines that are empty or start with '#' are skipped.  A failing command
+ * prints its error and does not abort the rest of the batch; the exit code is
+ * nonzero if any command failed.  One caveat: if a command modifies an input
+ * model without saving it back to its file, later commands in the same batch
+ * see the modified model rather than the file contents.
+ *
+ * @param argc Number of elements in argv.
+ * @param argv Arguments of the actual invocation; argv[1] is '--batch'.
+ * @param mlpackMain The binding function to run for each command.
+ */
+inline int RunBatchMode(int argc, char** argv, void (*mlpackMain)())
+{
+  ModelCache::Enabled() = true;
+
+  std::ifstream fileStream;
+  std::istream* commands = &std::cin;
+  if (argc > 2)
+  {
+    fileStream.open(argv[2]);
+    if (!fileStream.is_open())
+    {
+      std::cerr << "Could not open batch command file '" << argv[2] << "'!"
+          << std::endl;
+      return 1;
+    }
+    commands = &fileStream;
+  }
+
+  // Keep a pristine copy of the parameter list, so that each command starts
+  // from default values with freshly-reset matrix and model parameters.
+  CLI::StoreSettings("cli_batch_mode");
+
+  size_t failures = 0;
+  size_t lineNumber = 0;
+  std::string line;
+  while (std::getline(*commands, line))
+  {
+    ++lineNumber;
+    if (line.empty() || line[0] == '#')
+      continue;
+
+    std::vector<std::string> tokens = SplitCommandLine(line);
+    if (tokens.empty())
+      continue;
+
+    // Build an argv-style array; argv[0] is reused from the real invocation.
+    std::vector<char*> args;
+    args.push_back(argv[0]);
+    for (size_t i = 0; i < tokens.size(); ++i)
+      args.push_back(const_cast<char*>(tokens[i].c_str()));
+
+    CLI::RestoreSettings("cli_batch_mode");
+    try
+    {
+      ParseCommandLine((int) args.size(), args.data());
+      Timer::EnableTiming();
+      Timer::Start("total_time");
+      mlpackMain();
+      EndProgram();
+    }
+    catch (std::exception& e)
+    {
+      // Log::Fatal throws a std::runtime_error after printing, so the message
+      // itself has usually been shown already; mention the line either way.
+      std::cerr << "Batch command on line " << lineNumber << " failed: "
+          << e.what() << std::endl;
+      ++failures;
+    }
+  }
+
+  ModelCache::Clear();
+  return (failures == 0) ? 0 : 1;
+}
+
+} // namespace cli
+} // namespace bindings
+} // namespace mlpack
+
+#endif
@@ -14,6 +14,10 @@
 #define MLPACK_BINDINGS_CLI_END_PROGRAM_HPP
 
 #include <mlpack/core/util/cli.hpp>
+#include <mlpack/core/util/memory_counters.hpp>
+#include <mlpack/core/util/perf_counters.hpp>
+#include <mlpack/core/data/save_async.hpp>
+#include "model_cache.hpp"
 
 namespace mlpack {
 namespace bindings {
@@ -25,6 +29,9 @@ namespace cli {
  */
 inline void EndProgram()
 {
+  // Make sure any asynchronous saves started by the program have finished.
+  data::WaitForSaves();
+
   // Stop the CLI timers.
   CLI::GetSingleton().timer.StopAllTimers();
 
@@ -71,6 +78,32 @@ inline void EndProgram()
       Log::Info << "  " << it2.first << ": ";
       CLI::GetSingleton().timer.PrintTimer(it2.first);
     }
+
+    // Report hardware counters next to the timers, if any were recorded.
+    const std::map<std::string, PerfCounterValues> counters =
+        PerfCounters::GetAllCounters();
+    if (!counters.empty())
+    {
+      Log::Info << "Hardware counters:" << std::endl;
+      for (auto it2 : counters)
+      {
+        Log::Info << "  " << it2.first << ": ";
+        PerfCounters::Print(it2.first);
+      }
+    }
+
+    // Report allocation counters next to the timers, if tracking ran.
+    const std::map<std::string, MemoryCounterValues> memoryCounters =
+        MemoryCounters::GetAllCounters();
+    if (!memoryCounters.empty())
+    {
+      Log::Info << "Memory counters:" << std::endl;
+      for (auto it2 : memoryCounters)
+      {
+        Log::Info << "  " << it2.first << ": ";
+        MemoryCounters::Print(it2.first);
+      }
+    }
   }
 
   // Lastly clean up any memory.  If we are holding any pointers, then we "own"
@@ -85,7 +118,10 @@ inline void EndProgram()
     void* result;
     CLI::GetSingleton().functionMap[data.tname]["GetAllocatedMemory"](data,
         NULL, (void*) &result);
-    if (result != NULL && memoryAddresses.count(result) == 0)
+    // Pointers held by the batch-mode model cache are owned by the cache and
+    // must outlive this command; ModelCache::Has() is always false otherwise.
+    if (result != NULL && memoryAddresses.count(result) == 0 &&
+        !ModelCache::Has(result))
       memoryAddresses[result] = &data;
 
     ++it;
@@ -14,6 +14,7 @@
 
 #include <mlpack/prereqs.hpp>
 #include "parameter_type.hpp"
+#include "model_cache.hpp"
 
 namespace mlpack {
 namespace bindings {
@@ -97,6 +98,15 @@ T& GetParam(
 /**
  * Return a serializable object.
  *
+ * The model is deserialized lazily: nothing is read from disk until the
+ * binding first touches the parameter, so an invocation that fails parameter
+ * validation (or never uses the model) pays nothing.  The granularity is the
+ * whole model---boost::serialization archives are sequential streams with no
+ * per-subtree offsets, so individual subtrees cannot be faulted in on first
+ * traversal touch, and the archive cannot outlive the Load() call.  For
+ * repeated short sessions against a big model, batch mode's model cache
+ * makes every session after the first start warm instead.
+ *
  * @param d ParamData object to get parameter value from.
  */
 template<typename T>
@@ -112,8 +122,16 @@ T*& GetParam(
   const std::string& value = std::get<1>(*tuple);
   if (d.input && !d.loaded)
   {
-    T* model = new T();
-    data::Load(value, "model", *model, true);
+    // In batch mode, a model loaded from this file by an earlier command may
+    // still be cached; reuse it instead of deserializing it again.  The cache
+    // is a no-op unless batch mode enabled it.
+    T* model = (T*) ModelCache::Get(d.tname, value);
+    if (model == NULL)
+    {
+      model = new T();
+      data::Load(value, "model", *model, true);
+      ModelCache::Put(d.tname, value, (void*) model, &ModelCache::Delete<T>);
+    }
     d.loaded = true;
     std::get<0>(*tuple) = model;
   }
@@ -0,0 +1,173 @@
+/**
+ * @file bindings/cli/model_cache.hpp
+ * @author Ryan Curtin
+ *
+ * A process-lifetime cache of models loaded from file, used by the batch mode
+ * of the command-line bindings (see batch_mode.hpp) so that successive
+ * commands taking the same input model do not pay the boost::serialization
+ * load cost over and over.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_BINDINGS_CLI_MODEL_CACHE_HPP
+#define MLPACK_BINDINGS_CLI_MODEL_CACHE_HPP
+
+#include <mlpack/prereqs.hpp>
+
+namespace mlpack {
+namespace bindings {
+namespace cli {
+
+/**
+ * A cache of deserialized models, keyed by the filename they were loaded
+ * from.  The cache is disabled by default, so a regular single-command
+ * invocation behaves exactly as it always has; RunBatchMode() enables it.
+ *
+ * When the cache is enabled it owns the pointers it holds: EndProgram() skips
+ * deleting any model the cache reports via Has(), and Clear() frees
+ * everything once the batch run is over.  Because models of different types
+ * are stored through void pointers, each entry carries the type name it was
+ * stored under and a deleter with the correct static type.
+ */
+class ModelCache
+{
+ public:
+  //! Whether the cache is in use; modifiable.
+  static bool& Enabled()
+  {
+    static bool enabled = false;
+    return enabled;
+  }
+
+  /**
+   * Get the cached model loaded from the given file, or NULL if the cache is
+   * disabled, holds no model for that file, or holds a model of a different
+   * type (in which case the caller should reload from the file).
+   *
+   * @param tname Type name of the model (i.e. d.tname).
+   * @param filename Name of the file the model would be loaded from.
+   */
+  static void* Get(const std::string& tname, const std::string& filename)
+  {
+    if (!Enabled())
+      return NULL;
+
+    std::map<std::string, Entry>::const_iterator it = Cache().find(filename);
+    if (it == Cache().end() || it->second.tname != tname)
+      return NULL;
+    return it->second.model;
+  }
+
+  /**
+   * Store a model that was just loaded from the given file, taking ownership
+   * of the pointer.  If the cache is disabled this does nothing, and
+   * ownership stays with the caller.
+   *
+   * @param tname Type name of the model (i.e. d.tname).
+   * @param filename Name of the file the model was loaded from.
+   * @param model Pointer to the loaded model.
+   * @param deleter Function that deletes the model with its correct type;
+   *      pass &ModelCache::Delete<T>.
+   */
+  static void Put(const std::string& tname,
+                  const std::string& filename,
+                  void* model,
+                  void (*deleter)(void*))
+  {
+    if (!Enabled())
+      return;
+
+    Entry& entry = Cache()[filename];
+    // If an older model was cached from this file, free it first.
+    if (entry.model != NULL && entry.model != model)
+      entry.deleter(entry.model);
+    entry.tname = tname;
+    entry.model = model;
+    entry.deleter = deleter;
+  }
+
+  //! Return true if the given pointer is owned by the cache.
+  static bool Has(const void* model)
+  {
+    if (!Enabled() || model == NULL)
+      return false;
+
+    std::map<std::string, Entry>::const_iterator it = Cache().begin();
+    while (it != Cache().end())
+    {
+      if (it->second.model == model)
+        return true;
+      ++it;
+    }
+    return false;
+  }
+
+  /**
+   * Drop any entry for the given file, because the file is about to be
+   * overwritten and the cached model would be stale.  If the cached model is
+   * the very pointer being saved, the entry is only removed and ownership
+   * returns to the parameter holding the pointer; otherwise the stale model
+   * is freed.
+   *
+   * @param filename Name of the file being overwritten.
+   * @param current Pointer to the model being saved to the file.
+   */
+  static void Invalidate(const std::string& filename, const void* current)
+  {
+    if (!Enabled())
+      return;
+
+    std::map<std::string, Entry>::iterator it = Cache().find(filename);
+    if (it == Cache().end())
+      return;
+    if (it->second.model != current)
+      it->second.deleter(it->second.model);
+    Cache().erase(it);
+  }
+
+  //! Free every cached model; called once at the end of a batch run.
+  static void Clear()
+  {
+    std::map<std::string, Entry>::iterator it = Cache().begin();
+    while (it != Cache().end())
+    {
+      it->second.deleter(it->second.model);
+      ++it;
+    }
+    Cache().clear();
+  }
+
+  //! Deleter with the correct static type, for use with Put().
+  template<typename T>
+  static void Delete(void* model)
+  {
+    delete (T*) model;
+  }
+
+ private:
+  //! One cached model and what we need to manage it.
+  struct Entry
+  {
+    Entry() : model(NULL), deleter(NULL) { }
+
+    std::string tname;
+    void* model;
+    void (*deleter)(void*);
+  };
+
+  //! The cache itself, keyed by filename.
+  static std::map<std::string, Entry>& Cache()
+  {
+    static std::map<std::string, Entry> cache;
+    return cache;
+  }
+};
+
+} // namespace cli
+} // namespace bindings
+} // namespace mlpack
+
+#endif
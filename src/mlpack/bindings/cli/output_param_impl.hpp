@@ -13,6 +13,7 @@
 #define MLPACK_CORE_UTIL_OUTPUT_PARAM_IMPL_HPP
 
 #include "output_param.hpp"
+#include "model_cache.hpp"
 #include <mlpack/core/data/save.hpp>
 #include <iostream>
 
@@ -84,7 +85,12 @@ void OutputParamImpl(
       std::get<1>(*boost::any_cast<TupleType>(&data.value));
 
   if (filename != "")
+  {
     data::Save(filename, "model", *output);
+    // The file now holds this model, so any older model cached from it by
+    // batch mode would be stale.
+    ModelCache::Invalidate(filename, (const void*) output);
+  }
 }
 
 //! Output a mapped dataset.
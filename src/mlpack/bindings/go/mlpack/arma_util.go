@@ -41,6 +41,35 @@ func DataAndInfo() *matrixWithInfo {
   }
 }
 
+// NewPinnedDense returns a gonum matrix whose backing array lives in C-owned
+// memory.  Passing such a matrix to an mlpack binding hands the same buffer
+// to Armadillo with no copy and without retaining a Go pointer on the C side,
+// so a service that calls mlpack per request can allocate one pinned matrix
+// up front and refill it for every call.  The buffer is freed when the matrix
+// is garbage collected; keep the matrix reachable for as long as the data is
+// in use.
+func NewPinnedDense(r, c int) *mat.Dense {
+  mem := C.mlpackArmaAlloc(C.size_t(r * c))
+  array := (*[1<<30 - 1]float64)(mem)
+  data := array[:r*c]
+  output := mat.NewDense(r, c, data)
+  runtime.SetFinalizer(output, func(*mat.Dense) {
+    C.mlpackArmaFree(mem)
+  })
+  return output
+}
+
+// Free the C-owned result buffer once the gonum matrix wrapping it is
+// garbage collected.  The buffer is wrapped without copying, so it must live
+// exactly as long as the matrix.
+func (m *mlpackArma) freeOnCollect(output *mat.Dense) *mat.Dense {
+  mem := m.mem
+  runtime.SetFinalizer(output, func(*mat.Dense) {
+    C.mlpackArmaFree(mem)
+  })
+  return output
+}
+
 // Allocates a C memory Pointer via cgo and registers the finalizer
 // in order to free the C memory once the input has been registered in Go.
 func (m *mlpackArma) allocArmaPtrMat(identifier string) {
@@ -236,8 +265,8 @@ func (m *mlpackArma) armaToGonumMat(identifier string) *mat.Dense {
     // Initialize result matrix.
     output := mat.NewDense(r, c, data)
 
-    // Return gonum vector.
-    return output
+    // Return gonum vector; the C buffer is freed when it is collected.
+    return m.freeOnCollect(output)
   }
   return mat.NewDense(1, 1, nil)
 }
@@ -279,8 +308,8 @@ func (m *mlpackArma) armaToGonumUmat(identifier string) *mat.Dense {
     // Initialize result matrix.
     output := mat.NewDense(r, c, data)
 
-    // Return gonum vector.
-    return output
+    // Return gonum vector; the C buffer is freed when it is collected.
+    return m.freeOnCollect(output)
   }
   return mat.NewDense(1, 1, nil)
 }
@@ -302,8 +331,8 @@ func (m *mlpackArma) armaToGonumRow(identifier string) *mat.Dense{
     // Initialize result matrix.
     output := mat.NewDense(e, 1, data)
 
-    // Return gonum vector.
-    return output
+    // Return gonum vector; the C buffer is freed when it is collected.
+    return m.freeOnCollect(output)
   }
   return mat.NewDense(1, 1, nil)
 }
@@ -324,8 +353,8 @@ func (m *mlpackArma) armaToGonumUrow(identifier string) *mat.Dense {
 
     // Initialize result matrix.
     output := mat.NewDense(e, 1, data)
-    // Return gonum vector.
-    return output
+    // Return gonum vector; the C buffer is freed when it is collected.
+    return m.freeOnCollect(output)
   }
   return mat.NewDense(1, 1, nil)
 }
@@ -346,8 +375,8 @@ func (m *mlpackArma) armaToGonumCol(identifier string) *mat.Dense {
     // Initialize result matrix.
     output := mat.NewDense(1, e, data)
 
-    // Return gonum vector.
-    return output
+    // Return gonum vector; the C buffer is freed when it is collected.
+    return m.freeOnCollect(output)
   }
   return mat.NewDense(1, 1, nil)
 }
@@ -368,8 +397,8 @@ func (m *mlpackArma) armaToGonumUcol(identifier string) *mat.Dense {
     // Initialize result matrix.
     output := mat.NewDense(1, e, data)
 
-    // Return gonum vector.
-    return output
+    // Return gonum vector; the C buffer is freed when it is collected.
+    return m.freeOnCollect(output)
   }
   return mat.NewDense(1, 1, nil)
 }
@@ -391,8 +420,8 @@ func (m *mlpackArma) armaToGonumMatWithInfo(identifier string) *mat.Dense {
     // Initialize result matrix.
     output := mat.NewDense(r, c, data)
 
-    // Return gonum vector.
-    return output
+    // Return gonum vector; the C buffer is freed when it is collected.
+    return m.freeOnCollect(output)
   }
   return mat.NewDense(1, 1, nil)
 }
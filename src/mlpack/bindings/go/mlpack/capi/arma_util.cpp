@@ -321,6 +321,27 @@ int mlpackArmaMatWithInfoCols(const char* identifier)
   return std::get<1>(CLI::GetParam<TupleType>(identifier)).n_cols;
 }
 
+/**
+ * Allocate a C-owned buffer of the given number of double elements, for use
+ * as the pinned backing array of a gonum matrix.  Allocating the backing
+ * array on this side of the CGo boundary means the same buffer can be
+ * wrapped by both the gonum matrix and the Armadillo matrix, with no copy in
+ * either direction and no Go pointer retained by C.
+ */
+void* mlpackArmaAlloc(const size_t elem)
+{
+  return (void*) arma::memory::acquire<double>(elem);
+}
+
+/**
+ * Free a C-owned buffer returned by mlpackArmaAlloc() or by one of the
+ * mlpackArmaPtr*() functions.
+ */
+void mlpackArmaFree(void* mem)
+{
+  arma::memory::release((double*) mem);
+}
+
 /**
  * Get a pointer to the memory of the matrix.  The calling function is expected
  * to own the memory.
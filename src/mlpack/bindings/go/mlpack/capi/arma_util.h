@@ -175,6 +175,18 @@ int mlpackArmaMatWithInfoCols(const char* identifier);
  */
 void* mlpackArmaPtrMatWithInfoPtr(const char* identifier);
 
+/**
+ * Allocate a C-owned buffer of the given number of double elements, for use
+ * as the pinned backing array of a gonum matrix.
+ */
+void* mlpackArmaAlloc(const size_t elem);
+
+/**
+ * Free a C-owned buffer returned by mlpackArmaAlloc() or by one of the
+ * mlpackArmaPtr*() functions.
+ */
+void mlpackArmaFree(void* mem);
+
 #if defined(__cplusplus) || defined(c_plusplus)
 }
 #endif
@@ -53,7 +53,9 @@ def to_matrix(x, dtype=np.double, copy=False):
     else:
       return x, False
   elif (isinstance(x, np.ndarray) and x.dtype == dtype and x.flags.f_contiguous):
-    # A copy is always necessary here.
+    # A copy is always necessary here: the Cython layer views a C-order buffer
+    # as a transposed (column-major) Armadillo matrix, so a Fortran-order
+    # buffer would come out with the wrong orientation if borrowed directly.
     return x.copy("C"), True
   else:
     if isinstance(x, pd.core.series.Series) or isinstance(x, pd.DataFrame):
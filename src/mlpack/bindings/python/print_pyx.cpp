@@ -216,9 +216,14 @@ void PrintPYX(const ProgramDoc& programInfo,
     cout << "  CLI.SetPassed(<const string> '" << d.name << "')" << endl;
   }
 
-  // Call the method.
-  cout << "  # Call the mlpack program." << endl;
-  cout << "  mlpackMain()" << endl;
+  // Call the method.  The GIL is released during the call: the CLI parameter
+  // state is thread-local, so independent binding calls can run concurrently
+  // on different Python threads.
+  cout << "  # Call the mlpack program.  The GIL is released during the call,"
+      << endl;
+  cout << "  # so other binding calls can run concurrently." << endl;
+  cout << "  with nogil:" << endl;
+  cout << "    mlpackMain()" << endl;
 
   // Do any output processing and return.
   cout << "  # Initialize result dictionary." << endl;
@@ -240,6 +245,49 @@ void PrintPYX(const ProgramDoc& programInfo,
   cout << endl;
 
   cout << "  return result" << endl;
+
+  // If the binding both trains a model and can take one back in, also emit a
+  // class-style wrapper that keeps the trained model object in-process.  The
+  // trained model is passed back as 'input_model' on every predict() call, so
+  // successive batches reuse the same model pointer and never re-train or
+  // re-serialize.
+  const bool hasInputModel = (parameters.count("input_model") > 0) &&
+      parameters.at("input_model").input;
+  const bool hasOutputModel = (parameters.count("output_model") > 0) &&
+      !parameters.at("output_model").input;
+  if (hasInputModel && hasOutputModel)
+  {
+    cout << endl;
+    cout << "class " << functionName << "_model(object):" << endl;
+    cout << "  \"\"\"" << endl;
+    cout << "  Stateful wrapper around " << functionName << "().  The "
+        << "constructor takes the same" << endl;
+    cout << "  arguments as " << functionName << "() and trains a model; "
+        << "predict() then calls" << endl;
+    cout << "  " << functionName << "() with the trained model passed as "
+        << "'input_model', so" << endl;
+    cout << "  successive batches reuse the in-process model object and do "
+        << "not re-train." << endl;
+    cout << endl;
+    cout << "  predict() returns the same result dict as " << functionName
+        << "(), without the" << endl;
+    cout << "  'output_model' entry; the result dict of the training call is "
+        << "kept in" << endl;
+    cout << "  'train_result'." << endl;
+    cout << "  \"\"\"" << endl;
+    cout << "  def __init__(self, **kwargs):" << endl;
+    cout << "    result = " << functionName << "(**kwargs)" << endl;
+    cout << "    self.model = result.pop('output_model')" << endl;
+    cout << "    self.train_result = result" << endl;
+    cout << endl;
+    cout << "  def predict(self, **kwargs):" << endl;
+    cout << "    kwargs['input_model'] = self.model" << endl;
+    cout << "    result = " << functionName << "(**kwargs)" << endl;
+    cout << "    # If the binding updated the model, keep the updated one."
+        << endl;
+    cout << "    self.model = result.pop('output_model', self.model)" << endl;
+    cout << "    return result" << endl;
+  }
 }
 
 } // namespace python
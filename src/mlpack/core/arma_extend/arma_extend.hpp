@@ -42,6 +42,26 @@
   #define H5_USE_110_API
 #endif
 
+// Optionally route every Armadillo allocation through the mlpack memory
+// counters (see core/util/memory_counters.hpp), so peak bytes can be reported
+// per Timer region.  The hooks require Armadillo 9.900 or newer; older
+// versions silently ignore these macros and the counters read as zero.
+#if defined(MLPACK_ENABLE_MEMORY_TRACKING)
+  #include <cstddef>
+
+namespace mlpack {
+namespace memory {
+
+void* TrackedAlloc(const size_t bytes);
+void TrackedFree(void* mem);
+
+} // namespace memory
+} // namespace mlpack
+
+  #define ARMA_ALIEN_MEM_ALLOC_FUNCTION mlpack::memory::TrackedAlloc
+  #define ARMA_ALIEN_MEM_FREE_FUNCTION mlpack::memory::TrackedFree
+#endif
+
 // Include everything we'll need for serialize().
 #include <boost/serialization/serialization.hpp>
 #include <boost/serialization/nvp.hpp>
@@ -169,7 +169,9 @@ class KFoldCV
           const bool shuffle = true);
 
   /**
-   * Run k-fold cross-validation.
+   * Run k-fold cross-validation.  The folds are independent, so when OpenMP
+   * is enabled they are trained and evaluated in parallel, each with its own
+   * model instance.
    *
    * @param args Arguments for MLAlgorithm (in addition to the passed
    *     ones in the constructor).
@@ -305,6 +307,27 @@ class KFoldCV
   template<typename ElementType>
   inline arma::Row<ElementType> GetValidationSubset(arma::Row<ElementType>& r,
                                                     const size_t i);
+
+  /**
+   * Get an alias of the original (non-duplicated) part of a variable of a
+   * matrix type.
+   */
+  template<typename ElementType>
+  inline arma::Mat<ElementType> OriginalView(arma::Mat<ElementType>& m);
+
+  /**
+   * Get an alias of the original (non-duplicated) part of a variable of a row
+   * type.
+   */
+  template<typename ElementType>
+  inline arma::Row<ElementType> OriginalView(arma::Row<ElementType>& r);
+
+  /**
+   * Re-copy the first k - 2 bins into the duplicated tail of the given
+   * extended matrix after the original part has been permuted in place.
+   */
+  template<typename DataType>
+  void RefreshDuplicatedBins(DataType& m);
 };
 
 } // namespace cv
@@ -246,13 +246,20 @@ double KFoldCV<MLAlgorithm,
 {
   arma::vec evaluations(k);
 
-  for (size_t i = 0; i < k; ++i)
+  // The folds are independent, so they can be trained and evaluated in
+  // parallel; each iteration works on its own model instance and writes its
+  // result into its own element of 'evaluations'.  On the Visual Studio
+  // compiler, we have to use intmax_t because size_t is not yet supported by
+  // their OpenMP implementation; omp_size_t is the appropriate type according
+  // to the platform.
+  #pragma omp parallel for shared(evaluations)
+  for (omp_size_t i = 0; i < (omp_size_t) k; ++i)
   {
     MLAlgorithm&& model  = base.Train(GetTrainingSubset(xs, i),
         GetTrainingSubset(ys, i), args...);
     evaluations(i) = Metric::Evaluate(model, GetValidationSubset(xs, i),
         GetValidationSubset(ys, i));
-    if (i == k - 1)
+    if (i == (omp_size_t) k - 1)
       modelPtr.reset(new MLAlgorithm(std::move(model)));
   }
 
@@ -273,7 +280,10 @@ double KFoldCV<MLAlgorithm,
 {
   arma::vec evaluations(k);
 
-  for (size_t i = 0; i < k; ++i)
+  // As above, run the independent folds in parallel, each with its own model
+  // instance and its own element of 'evaluations'.
+  #pragma omp parallel for shared(evaluations)
+  for (omp_size_t i = 0; i < (omp_size_t) k; ++i)
   {
     MLAlgorithm&& model = (weights.n_elem > 0) ?
         base.Train(GetTrainingSubset(xs, i), GetTrainingSubset(ys, i),
@@ -282,7 +292,7 @@ double KFoldCV<MLAlgorithm,
             args...);
     evaluations(i) = Metric::Evaluate(model, GetValidationSubset(xs, i),
         GetValidationSubset(ys, i));
-    if (i == k - 1)
+    if (i == (omp_size_t) k - 1)
       modelPtr.reset(new MLAlgorithm(std::move(model)));
   }
 
@@ -301,14 +311,20 @@ void KFoldCV<MLAlgorithm,
              PredictionsType,
              WeightsType>::Shuffle()
 {
-  MatType xsOrig = xs.cols(0, (k - 1) * binSize + lastBinSize - 1);
-  PredictionsType ysOrig = ys.cols(0, (k - 1) * binSize + lastBinSize - 1);
-
-  // Now shuffle the data.
-  math::ShuffleData(xsOrig, ysOrig, xsOrig, ysOrig);
-
-  InitKFoldCVMat(xsOrig, xs);
-  InitKFoldCVMat(ysOrig, ys);
+  // The first (k - 1) * binSize + lastBinSize columns hold the original
+  // dataset; permute them in place with a common ordering instead of
+  // assembling shuffled copies, and then refresh the bins that are duplicated
+  // at the end of the extended matrices.
+  const arma::uvec ordering =
+      math::ShuffleOrdering((k - 1) * binSize + lastBinSize);
+
+  MatType xsView = OriginalView(xs);
+  PredictionsType ysView = OriginalView(ys);
+  math::PermuteColumns(xsView, ordering);
+  math::PermuteColumns(ysView, ordering);
+
+  RefreshDuplicatedBins(xs);
+  RefreshDuplicatedBins(ys);
 }
 
 template<typename MLAlgorithm,
@@ -323,22 +339,25 @@ void KFoldCV<MLAlgorithm,
              PredictionsType,
              WeightsType>::Shuffle()
 {
-  MatType xsOrig = xs.cols(0, (k - 1) * binSize + lastBinSize - 1);
-  PredictionsType ysOrig = ys.cols(0, (k - 1) * binSize + lastBinSize - 1);
-  WeightsType weightsOrig;
-  if (weights.n_elem > 0)
-    weightsOrig = weights.cols(0, (k - 1) * binSize + lastBinSize - 1);
-
-  // Now shuffle the data.
+  // As above, permute the original part of each extended matrix in place with
+  // a common ordering, then refresh the duplicated bins.
+  const arma::uvec ordering =
+      math::ShuffleOrdering((k - 1) * binSize + lastBinSize);
+
+  MatType xsView = OriginalView(xs);
+  PredictionsType ysView = OriginalView(ys);
+  math::PermuteColumns(xsView, ordering);
+  math::PermuteColumns(ysView, ordering);
   if (weights.n_elem > 0)
-    math::ShuffleData(xsOrig, ysOrig, weightsOrig, xsOrig, ysOrig, weightsOrig);
-  else
-    math::ShuffleData(xsOrig, ysOrig, xsOrig, ysOrig);
+  {
+    WeightsType weightsView = OriginalView(weights);
+    math::PermuteColumns(weightsView, ordering);
+  }
 
-  InitKFoldCVMat(xsOrig, xs);
-  InitKFoldCVMat(ysOrig, ys);
+  RefreshDuplicatedBins(xs);
+  RefreshDuplicatedBins(ys);
   if (weights.n_elem > 0)
-    InitKFoldCVMat(weightsOrig, weights);
+    RefreshDuplicatedBins(weights);
 }
 
 template<typename MLAlgorithm,
@@ -441,6 +460,59 @@ arma::Row<ElementType> KFoldCV<MLAlgorithm,
       subsetSize, false, true);
 }
 
+template<typename MLAlgorithm,
+         typename Metric,
+         typename MatType,
+         typename PredictionsType,
+         typename WeightsType>
+template<typename ElementType>
+arma::Mat<ElementType> KFoldCV<MLAlgorithm,
+                               Metric,
+                               MatType,
+                               PredictionsType,
+                               WeightsType>::OriginalView(
+    arma::Mat<ElementType>& m)
+{
+  return arma::Mat<ElementType>(m.memptr(), m.n_rows,
+      (k - 1) * binSize + lastBinSize, false, true);
+}
+
+template<typename MLAlgorithm,
+         typename Metric,
+         typename MatType,
+         typename PredictionsType,
+         typename WeightsType>
+template<typename ElementType>
+arma::Row<ElementType> KFoldCV<MLAlgorithm,
+                               Metric,
+                               MatType,
+                               PredictionsType,
+                               WeightsType>::OriginalView(
+    arma::Row<ElementType>& r)
+{
+  return arma::Row<ElementType>(r.memptr(),
+      (k - 1) * binSize + lastBinSize, false, true);
+}
+
+template<typename MLAlgorithm,
+         typename Metric,
+         typename MatType,
+         typename PredictionsType,
+         typename WeightsType>
+template<typename DataType>
+void KFoldCV<MLAlgorithm,
+             Metric,
+             MatType,
+             PredictionsType,
+             WeightsType>::RefreshDuplicatedBins(DataType& m)
+{
+  // Nothing is duplicated when k == 2, in which case the extended matrix is
+  // just the original dataset.
+  const size_t numOrigCols = (k - 1) * binSize + lastBinSize;
+  if (m.n_cols > numOrigCols)
+    m.cols(numOrigCols, m.n_cols - 1) = m.cols(0, m.n_cols - numOrigCols - 1);
+}
+
 } // namespace cv
 } // namespace mlpack
 
@@ -0,0 +1,80 @@
+/**
+ * @file core/cv/metrics/incremental_mse.hpp
+ *
+ * An accumulator-style mean squared error that can be updated with batches of
+ * predictions and read cheaply at any time.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_CV_METRICS_INCREMENTAL_MSE_HPP
+#define MLPACK_CORE_CV_METRICS_INCREMENTAL_MSE_HPP
+
+#include <mlpack/core.hpp>
+
+namespace mlpack {
+namespace cv {
+
+/**
+ * The class IncrementalMSE keeps mean squared error as a running summary of
+ * prediction results: it is updated with batches of predictions as they are
+ * made (e.g. while monitoring a long training run), accumulators of different
+ * threads can be merged, and the current value can be read at any time without
+ * buffering any predictions.  Unlike the MSE metric class it works on
+ * prediction vectors rather than on a model, so predictions made anyway during
+ * training can be accumulated for free.
+ */
+class IncrementalMSE
+{
+ public:
+  //! Create an empty accumulator.
+  IncrementalMSE();
+
+  /**
+   * Add a batch of predictions to the accumulator.  It is expected that
+   * predictions and responses have the same number of elements.
+   *
+   * @param predictions Predicted responses.
+   * @param responses Actual (ground truth) responses.
+   */
+  template<typename ResponsesType>
+  void Update(const ResponsesType& predictions,
+              const ResponsesType& responses);
+
+  /**
+   * Add the sums of another accumulator (e.g. one filled by another thread)
+   * to this one.
+   *
+   * @param other The accumulator to merge in.
+   */
+  void Merge(const IncrementalMSE& other);
+
+  /**
+   * Get the mean squared error so far.  Throws std::logic_error if no
+   * predictions have been accumulated.
+   */
+  double Value() const;
+
+  //! Get the number of accumulated predictions.
+  size_t NumPoints() const { return numPoints; }
+
+  //! Forget all accumulated predictions.
+  void Reset();
+
+ private:
+  //! The accumulated sum of squared errors.
+  double squaredErrorSum;
+
+  //! The number of accumulated predictions.
+  size_t numPoints;
+};
+
+} // namespace cv
+} // namespace mlpack
+
+// Include implementation.
+#include "incremental_mse_impl.hpp"
+
+#endif
@@ -0,0 +1,54 @@
+/**
+ * @file core/cv/metrics/incremental_mse_impl.hpp
+ *
+ * Implementation of the incrementally updated mean squared error.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_CV_METRICS_INCREMENTAL_MSE_IMPL_HPP
+#define MLPACK_CORE_CV_METRICS_INCREMENTAL_MSE_IMPL_HPP
+
+namespace mlpack {
+namespace cv {
+
+inline IncrementalMSE::IncrementalMSE() :
+    squaredErrorSum(0.0),
+    numPoints(0)
+{ /* Nothing left to do. */ }
+
+template<typename ResponsesType>
+void IncrementalMSE::Update(const ResponsesType& predictions,
+                            const ResponsesType& responses)
+{
+  squaredErrorSum += arma::accu(arma::square(predictions - responses));
+  numPoints += predictions.n_elem;
+}
+
+inline void IncrementalMSE::Merge(const IncrementalMSE& other)
+{
+  squaredErrorSum += other.squaredErrorSum;
+  numPoints += other.numPoints;
+}
+
+inline double IncrementalMSE::Value() const
+{
+  if (numPoints == 0)
+    throw std::logic_error(
+        "IncrementalMSE::Value(): no predictions have been accumulated");
+
+  return squaredErrorSum / (double) numPoints;
+}
+
+inline void IncrementalMSE::Reset()
+{
+  squaredErrorSum = 0.0;
+  numPoints = 0;
+}
+
+} // namespace cv
+} // namespace mlpack
+
+#endif
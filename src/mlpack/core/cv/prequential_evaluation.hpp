@@ -0,0 +1,155 @@
+/**
+ * @file core/cv/prequential_evaluation.hpp
+ *
+ * Prequential (test-then-train) evaluation over data streams.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_CV_PREQUENTIAL_EVALUATION_HPP
+#define MLPACK_CORE_CV_PREQUENTIAL_EVALUATION_HPP
+
+#include <mlpack/core/cv/meta_info_extractor.hpp>
+
+namespace mlpack {
+namespace cv {
+
+/**
+ * The class PrequentialEvaluation implements progressive (test-then-train)
+ * evaluation for incremental learners such as Hoeffding trees: each incoming
+ * chunk of the stream is first used to assess the current model with the given
+ * Metric, and then the model is trained on it.  Unlike SimpleCV and KFoldCV,
+ * no split of a static dataset is made and no stream history is kept -- only a
+ * fixed-size window of per-chunk metric values is stored, so the memory use is
+ * independent of the stream length.
+ *
+ * Chunks can be fed one at a time with Process() as they arrive (e.g. as they
+ * are loaded), or an already-loaded dataset can be replayed as a stream with
+ * Evaluate(), which walks it in chunk-sized column blocks.  For example, a
+ * Hoeffding tree can be progressively evaluated in the following way.
+ *
+ * @code
+ * HoeffdingTree<> tree(info, numClasses);
+ * PrequentialEvaluation<HoeffdingTree<>, Accuracy> eval;
+ *
+ * // Replay the dataset as a stream of 100-point chunks.
+ * eval.Evaluate(tree, data, labels);
+ *
+ * double recentAccuracy = eval.WindowedObjective();
+ * double overallAccuracy = eval.OverallObjective();
+ * @endcode
+ *
+ * The very first processed chunk is only used for training, since the model
+ * has not seen any data to predict with yet.
+ *
+ * @tparam MLAlgorithm A machine learning algorithm that supports incremental
+ *     training with a Train(xs, ys, ...) method.
+ * @tparam Metric A metric to assess the quality of the model on each chunk.
+ * @tparam MatType The type of data.
+ * @tparam PredictionsType The type of predictions (should be passed when the
+ *     predictions type is a template parameter in Train methods of
+ *     MLAlgorithm).
+ */
+template<typename MLAlgorithm,
+         typename Metric,
+         typename MatType = arma::mat,
+         typename PredictionsType =
+             typename MetaInfoExtractor<MLAlgorithm, MatType>::PredictionsType>
+class PrequentialEvaluation
+{
+ public:
+  /**
+   * Create a PrequentialEvaluation object.
+   *
+   * @param windowSize The number of most recent chunks the windowed metric is
+   *     computed over.
+   */
+  PrequentialEvaluation(const size_t windowSize = 10);
+
+  /**
+   * Process one chunk of the stream: assess the model on the chunk with the
+   * given Metric, and then train the model on it.  Any additional arguments
+   * are passed to the Train method of the model after the data and the
+   * predictions.
+   *
+   * @param model The incrementally trained model.
+   * @param xs Data points of the chunk.
+   * @param ys Predictions (labels for classification algorithms and responses
+   *     for regression algorithms) for each data point of the chunk.
+   * @param trainArgs Additional arguments for the Train method of the model.
+   * @return The metric value on the chunk (NaN for the first chunk, which is
+   *     only trained on).
+   */
+  template<typename... TrainArgs>
+  double Process(MLAlgorithm& model,
+                 const MatType& xs,
+                 const PredictionsType& ys,
+                 const TrainArgs&... trainArgs);
+
+  /**
+   * Replay an already-loaded dataset as a stream: walk it in chunk-sized
+   * column blocks and call Process() for each block.
+   *
+   * @param model The incrementally trained model.
+   * @param xs Data points of the stream.
+   * @param ys Predictions (labels for classification algorithms and responses
+   *     for regression algorithms) for each data point of the stream.
+   * @param chunkSize The number of points to process at a time.
+   * @param trainArgs Additional arguments for the Train method of the model.
+   * @return The overall (weighted by chunk sizes) metric value.
+   */
+  template<typename... TrainArgs>
+  double Evaluate(MLAlgorithm& model,
+                  const MatType& xs,
+                  const PredictionsType& ys,
+                  const size_t chunkSize = 100,
+                  const TrainArgs&... trainArgs);
+
+  //! Get the metric value over the window of most recent chunks (weighted by
+  //! chunk sizes).
+  double WindowedObjective() const;
+
+  //! Get the metric value over the whole processed stream (weighted by chunk
+  //! sizes).
+  double OverallObjective() const;
+
+  //! Get the number of processed points (including the first, train-only
+  //! chunk).
+  size_t NumPoints() const { return numPoints; }
+
+  //! Forget all processed chunks (the model is left untouched).
+  void Reset();
+
+ private:
+  //! The number of most recent chunks the windowed metric is computed over.
+  size_t windowSize;
+
+  //! Per-chunk metric values of the window (a ring buffer).
+  arma::vec windowObjectives;
+  //! Per-chunk numbers of points of the window (a ring buffer).
+  arma::vec windowWeights;
+  //! The position in the ring buffers where the next chunk is stored.
+  size_t windowPosition;
+  //! The number of filled ring buffer entries.
+  size_t windowCount;
+
+  //! The sum of the per-chunk metric values weighted by chunk sizes.
+  double totalObjective;
+  //! The number of points the model has been assessed on.
+  double totalWeight;
+  //! The number of processed points.
+  size_t numPoints;
+
+  //! Whether the model has been trained on at least one chunk.
+  bool modelSeeded;
+};
+
+} // namespace cv
+} // namespace mlpack
+
+// Include implementation
+#include "prequential_evaluation_impl.hpp"
+
+#endif
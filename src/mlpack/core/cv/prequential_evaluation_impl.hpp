@@ -0,0 +1,166 @@
+/**
+ * @file core/cv/prequential_evaluation_impl.hpp
+ *
+ * The implementation of prequential (test-then-train) evaluation.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_CV_PREQUENTIAL_EVALUATION_IMPL_HPP
+#define MLPACK_CORE_CV_PREQUENTIAL_EVALUATION_IMPL_HPP
+
+namespace mlpack {
+namespace cv {
+
+template<typename MLAlgorithm,
+         typename Metric,
+         typename MatType,
+         typename PredictionsType>
+PrequentialEvaluation<MLAlgorithm,
+                      Metric,
+                      MatType,
+                      PredictionsType>::PrequentialEvaluation(
+    const size_t windowSize) :
+    windowSize(windowSize),
+    windowObjectives(windowSize),
+    windowWeights(windowSize)
+{
+  if (windowSize == 0)
+    throw std::invalid_argument(
+        "PrequentialEvaluation: windowSize should not be zero");
+
+  Reset();
+}
+
+template<typename MLAlgorithm,
+         typename Metric,
+         typename MatType,
+         typename PredictionsType>
+template<typename... TrainArgs>
+double PrequentialEvaluation<MLAlgorithm,
+                             Metric,
+                             MatType,
+                             PredictionsType>::Process(
+    MLAlgorithm& model,
+    const MatType& xs,
+    const PredictionsType& ys,
+    const TrainArgs&... trainArgs)
+{
+  double objective = std::numeric_limits<double>::quiet_NaN();
+
+  if (xs.n_cols == 0)
+    return objective;
+
+  // Test first -- unless this is the very first chunk, in which case the
+  // model has not seen any data to predict with yet.
+  if (modelSeeded)
+  {
+    objective = Metric::Evaluate(model, xs, ys);
+
+    windowObjectives(windowPosition) = objective;
+    windowWeights(windowPosition) = (double) xs.n_cols;
+    windowPosition = (windowPosition + 1) % windowSize;
+    if (windowCount < windowSize)
+      ++windowCount;
+
+    totalObjective += objective * (double) xs.n_cols;
+    totalWeight += (double) xs.n_cols;
+  }
+
+  // Then train.
+  model.Train(xs, ys, trainArgs...);
+  modelSeeded = true;
+  numPoints += xs.n_cols;
+
+  return objective;
+}
+
+template<typename MLAlgorithm,
+         typename Metric,
+         typename MatType,
+         typename PredictionsType>
+template<typename... TrainArgs>
+double PrequentialEvaluation<MLAlgorithm,
+                             Metric,
+                             MatType,
+                             PredictionsType>::Evaluate(
+    MLAlgorithm& model,
+    const MatType& xs,
+    const PredictionsType& ys,
+    const size_t chunkSize,
+    const TrainArgs&... trainArgs)
+{
+  if (chunkSize == 0)
+    throw std::invalid_argument(
+        "PrequentialEvaluation::Evaluate(): chunkSize should not be zero");
+
+  for (size_t begin = 0; begin < xs.n_cols; begin += chunkSize)
+  {
+    const size_t end = std::min(begin + chunkSize, (size_t) xs.n_cols) - 1;
+    Process(model, xs.cols(begin, end), ys.cols(begin, end), trainArgs...);
+  }
+
+  return OverallObjective();
+}
+
+template<typename MLAlgorithm,
+         typename Metric,
+         typename MatType,
+         typename PredictionsType>
+double PrequentialEvaluation<MLAlgorithm,
+                             Metric,
+                             MatType,
+                             PredictionsType>::WindowedObjective() const
+{
+  if (windowCount == 0)
+    throw std::logic_error("PrequentialEvaluation::WindowedObjective(): no "
+        "chunks have been assessed");
+
+  // The positions of the entries in the ring buffers do not matter for the
+  // weighted mean.
+  return arma::dot(windowObjectives.subvec(0, windowCount - 1),
+      windowWeights.subvec(0, windowCount - 1)) /
+      arma::sum(windowWeights.subvec(0, windowCount - 1));
+}
+
+template<typename MLAlgorithm,
+         typename Metric,
+         typename MatType,
+         typename PredictionsType>
+double PrequentialEvaluation<MLAlgorithm,
+                             Metric,
+                             MatType,
+                             PredictionsType>::OverallObjective() const
+{
+  if (totalWeight == 0.0)
+    throw std::logic_error("PrequentialEvaluation::OverallObjective(): no "
+        "chunks have been assessed");
+
+  return totalObjective / totalWeight;
+}
+
+template<typename MLAlgorithm,
+         typename Metric,
+         typename MatType,
+         typename PredictionsType>
+void PrequentialEvaluation<MLAlgorithm,
+                           Metric,
+                           MatType,
+                           PredictionsType>::Reset()
+{
+  windowObjectives.zeros();
+  windowWeights.zeros();
+  windowPosition = 0;
+  windowCount = 0;
+  totalObjective = 0.0;
+  totalWeight = 0.0;
+  numPoints = 0;
+  modelSeeded = false;
+}
+
+} // namespace cv
+} // namespace mlpack
+
+#endif
@@ -0,0 +1,140 @@
+/**
+ * @file core/data/assignment_writer.hpp
+ * @author Ryan Curtin
+ *
+ * A bounded-memory sink for clustering assignments.  Instead of materializing
+ * a full results matrix and saving it at the end, assignments are appended to
+ * the writer and flushed to an output stream chunk-wise, so the memory used
+ * for results stays constant no matter how many points are clustered.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_DATA_ASSIGNMENT_WRITER_HPP
+#define MLPACK_CORE_DATA_ASSIGNMENT_WRITER_HPP
+
+#include <mlpack/prereqs.hpp>
+
+#include <fstream>
+
+namespace mlpack {
+namespace data {
+
+/**
+ * Streams cluster assignments to an output stream with bounded memory.  The
+ * output format is one assignment per line, in point order, which loads back
+ * as a single-column matrix.  Assignments are buffered and written to the
+ * stream one chunk at a time; the buffer never grows beyond the configured
+ * chunk size.
+ *
+ * The writer can either own a file (constructed from a filename) or append to
+ * a caller-owned stream.  The destructor flushes any buffered assignments, so
+ * simply letting the writer go out of scope finishes the output.
+ */
+class AssignmentWriter
+{
+ public:
+  /**
+   * Construct a writer that owns the given output file.  Throws
+   * std::runtime_error if the file cannot be opened.
+   *
+   * @param filename File to stream assignments to.
+   * @param chunkSize Number of assignments to buffer between flushes.
+   */
+  AssignmentWriter(const std::string& filename,
+                   const size_t chunkSize = 65536) :
+      file(new std::ofstream(filename)),
+      stream(*file),
+      chunkSize(chunkSize),
+      written(0)
+  {
+    if (!file->is_open())
+    {
+      throw std::runtime_error("AssignmentWriter: cannot open file '" +
+          filename + "' for writing!");
+    }
+    buffer.reserve(chunkSize);
+  }
+
+  /**
+   * Construct a writer that appends to a caller-owned stream, which must
+   * outlive the writer.
+   *
+   * @param stream Stream to write assignments to.
+   * @param chunkSize Number of assignments to buffer between flushes.
+   */
+  AssignmentWriter(std::ostream& stream, const size_t chunkSize = 65536) :
+      stream(stream),
+      chunkSize(chunkSize),
+      written(0)
+  {
+    buffer.reserve(chunkSize);
+  }
+
+  //! Flush any buffered assignments on destruction.
+  ~AssignmentWriter()
+  {
+    Flush();
+  }
+
+  /**
+   * Append one assignment, flushing the buffer to the stream if it is full.
+   *
+   * @param assignment Cluster assignment of the next point.
+   */
+  void Write(const size_t assignment)
+  {
+    buffer.push_back(assignment);
+    if (buffer.size() >= chunkSize)
+      Flush();
+  }
+
+  /**
+   * Append a whole row of assignments, flushing chunk-wise as the buffer
+   * fills; the buffer still never exceeds the chunk size.
+   *
+   * @param assignments Assignments to append.
+   */
+  template<typename RowType>
+  void Write(const RowType& assignments)
+  {
+    for (size_t i = 0; i < assignments.n_elem; ++i)
+      Write((size_t) assignments[i]);
+  }
+
+  //! Write all buffered assignments to the stream.
+  void Flush()
+  {
+    for (size_t i = 0; i < buffer.size(); ++i)
+      stream << buffer[i] << '\n';
+    written += buffer.size();
+    buffer.clear();
+    stream.flush();
+  }
+
+  //! Get the total number of assignments appended so far.
+  size_t Written() const { return written + buffer.size(); }
+
+ private:
+  //! The owned output file, if the writer was constructed from a filename.
+  std::unique_ptr<std::ofstream> file;
+
+  //! The stream assignments are written to.
+  std::ostream& stream;
+
+  //! Buffered assignments, bounded by chunkSize.
+  std::vector<size_t> buffer;
+
+  //! Number of assignments to buffer between flushes.
+  size_t chunkSize;
+
+  //! Number of assignments already flushed to the stream.
+  size_t written;
+};
+
+} // namespace data
+} // namespace mlpack
+
+#endif
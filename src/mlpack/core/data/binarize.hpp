@@ -86,6 +86,74 @@ void Binarize(const arma::Mat<T>& input,
     output(dimension, i) = input(dimension, i) > threshold;
 }
 
+/**
+ * Given a sparse input dataset and threshold, set values greater than
+ * threshold to 1 and values less than or equal to the threshold to 0, without
+ * densifying the matrix: only the stored nonzero entries are visited.  The
+ * threshold must be non-negative, since a negative threshold would turn every
+ * implicit zero entry into a 1 and thus produce a dense result; the dense
+ * overload should be used in that case.
+ *
+ * @param input Input matrix to Binarize.
+ * @param output Matrix you want to save binarized data into.
+ * @param threshold Threshold; must be non-negative.
+ */
+template<typename T>
+void Binarize(const arma::SpMat<T>& input,
+              arma::SpMat<T>& output,
+              const double threshold)
+{
+  if (threshold < 0)
+  {
+    throw std::invalid_argument("Binarize(): a negative threshold would turn "
+        "every zero entry of the sparse matrix into a 1; use the dense "
+        "overload instead");
+  }
+
+  output = input;
+  for (typename arma::SpMat<T>::iterator it = output.begin();
+      it != output.end(); ++it)
+    (*it) = ((*it) > threshold) ? T(1) : T(0);
+
+  // Entries that dropped to zero must not stay as stored nonzeros.
+  output.clean(0);
+}
+
+/**
+ * Given a sparse input dataset and threshold, set values greater than
+ * threshold to 1 and values less than or equal to the threshold to 0 in the
+ * given dimension, visiting only the stored nonzero entries.  As with the
+ * other sparse overload, the threshold must be non-negative.
+ *
+ * @param input Input matrix to Binarize.
+ * @param output Matrix you want to save binarized data into.
+ * @param threshold Threshold; must be non-negative.
+ * @param dimension Feature to apply the Binarize function.
+ */
+template<typename T>
+void Binarize(const arma::SpMat<T>& input,
+              arma::SpMat<T>& output,
+              const double threshold,
+              const size_t dimension)
+{
+  if (threshold < 0)
+  {
+    throw std::invalid_argument("Binarize(): a negative threshold would turn "
+        "every zero entry of the sparse matrix into a 1; use the dense "
+        "overload instead");
+  }
+
+  output = input;
+  for (typename arma::SpMat<T>::iterator it = output.begin();
+      it != output.end(); ++it)
+  {
+    if (it.row() == dimension)
+      (*it) = ((*it) > threshold) ? T(1) : T(0);
+  }
+
+  output.clean(0);
+}
+
 } // namespace data
 } // namespace mlpack
 
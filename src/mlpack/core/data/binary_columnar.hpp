@@ -0,0 +1,270 @@
+/**
+ * @file core/data/binary_columnar.hpp
+ * @author Ryan Curtin
+ *
+ * The mlpack binary columnar dataset format (.mbin): a small fixed header
+ * followed by the raw column-major matrix payload at an aligned offset, so
+ * that loading is a single read -- or, with MappedMatrix, a memory mapping
+ * with no copy at all.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_DATA_BINARY_COLUMNAR_HPP
+#define MLPACK_CORE_DATA_BINARY_COLUMNAR_HPP
+
+#include <mlpack/prereqs.hpp>
+
+#include <cstring>
+#include <fstream>
+
+#ifndef _WIN32
+  #include <fcntl.h>
+  #include <sys/mman.h>
+  #include <sys/stat.h>
+  #include <unistd.h>
+#endif
+
+namespace mlpack {
+namespace data {
+
+namespace details {
+
+/**
+ * The on-disk header of the binary columnar format.  The payload starts at
+ * `dataOffset`, which is cache-line aligned (and trivially 8-byte aligned
+ * inside a page-aligned memory mapping); all integers are stored in host
+ * byte order.
+ */
+struct BinaryColumnarHeader
+{
+  //! The magic bytes identifying the format.
+  char magic[16];
+
+  //! Element type: 0 = unsigned integer, 1 = signed integer,
+  //! 2 = floating point.
+  uint64_t typeCode;
+
+  //! Size of one element in bytes.
+  uint64_t elemSize;
+
+  //! Number of matrix rows.
+  uint64_t rows;
+
+  //! Number of matrix columns.
+  uint64_t cols;
+
+  //! Offset of the payload from the start of the file.
+  uint64_t dataOffset;
+};
+
+//! The magic bytes of the binary columnar format.
+const char BinaryColumnarMagic[16] = "MLPACK_MBIN_V1\0";
+
+//! The payload offset used when writing; reading honors the stored offset.
+const uint64_t BinaryColumnarDataOffset = 64;
+
+//! Return the type code of the given element type.
+template<typename eT>
+uint64_t BinaryColumnarTypeCode()
+{
+  if (std::is_floating_point<eT>::value)
+    return 2;
+  return std::is_signed<eT>::value ? 1 : 0;
+}
+
+/**
+ * Read and validate the header against the given element type.  Returns
+ * false on a magic, type or size mismatch.
+ */
+template<typename eT>
+bool CheckBinaryColumnarHeader(const BinaryColumnarHeader& header)
+{
+  if (std::memcmp(header.magic, BinaryColumnarMagic,
+      sizeof(BinaryColumnarMagic)) != 0)
+    return false;
+  if (header.typeCode != BinaryColumnarTypeCode<eT>() ||
+      header.elemSize != sizeof(eT))
+    return false;
+  return header.dataOffset >= sizeof(BinaryColumnarHeader);
+}
+
+} // namespace details
+
+/**
+ * Save the given matrix as binary columnar data.  The payload is the matrix
+ * exactly as it sits in memory (column-major), so saving is one header and
+ * one payload write with no reordering.
+ *
+ * @param filename Name of the file to write.
+ * @param matrix Matrix to save.
+ */
+template<typename eT>
+bool SaveBinaryColumnar(const std::string& filename,
+                        const arma::Mat<eT>& matrix)
+{
+  std::ofstream stream(filename.c_str(),
+      std::ofstream::out | std::ofstream::binary | std::ofstream::trunc);
+  if (!stream.is_open())
+    return false;
+
+  details::BinaryColumnarHeader header;
+  std::memset(&header, 0, sizeof(header));
+  std::memcpy(header.magic, details::BinaryColumnarMagic,
+      sizeof(details::BinaryColumnarMagic));
+  header.typeCode = details::BinaryColumnarTypeCode<eT>();
+  header.elemSize = sizeof(eT);
+  header.rows = matrix.n_rows;
+  header.cols = matrix.n_cols;
+  header.dataOffset = details::BinaryColumnarDataOffset;
+
+  stream.write((const char*) &header, sizeof(header));
+  for (uint64_t i = sizeof(header); i < header.dataOffset; ++i)
+    stream.put('\0');
+  stream.write((const char*) matrix.memptr(),
+      (std::streamsize) (matrix.n_elem * sizeof(eT)));
+
+  return stream.good();
+}
+
+/**
+ * Load binary columnar data into the given matrix with a single payload
+ * read.  Returns false if the file is not binary columnar data or was
+ * written with a different element type.
+ *
+ * @param filename Name of the file to read.
+ * @param matrix Matrix to load into.
+ */
+template<typename eT>
+bool LoadBinaryColumnar(const std::string& filename, arma::Mat<eT>& matrix)
+{
+  std::ifstream stream(filename.c_str(),
+      std::ifstream::in | std::ifstream::binary);
+  if (!stream.is_open())
+    return false;
+
+  details::BinaryColumnarHeader header;
+  stream.read((char*) &header, sizeof(header));
+  if (!stream || !details::CheckBinaryColumnarHeader<eT>(header))
+    return false;
+
+  matrix.set_size(header.rows, header.cols);
+  stream.seekg((std::streamoff) header.dataOffset);
+  stream.read((char*) matrix.memptr(),
+      (std::streamsize) (matrix.n_elem * sizeof(eT)));
+
+  return stream.good() || matrix.n_elem == 0;
+}
+
+/**
+ * A read-only matrix view backed by a memory-mapped binary columnar file.
+ * Construction maps the file and wraps the payload in an arma::Mat alias
+ * without copying, so even a many-gigabyte dataset is usable within
+ * milliseconds; pages are faulted in by the operating system as the matrix
+ * is accessed, and repeated runs over the same file are served from the
+ * page cache.
+ *
+ * The mapping lives as long as this object; keep it alive while the matrix
+ * returned by Matrix() is in use.  On platforms without POSIX memory
+ * mapping the file is read into owned memory instead, preserving the
+ * interface.
+ *
+ * A std::runtime_error is thrown if the file cannot be mapped or is not
+ * binary columnar data of the right element type.
+ */
+template<typename eT>
+class MappedMatrix
+{
+ public:
+  /**
+   * Map the given binary columnar file.
+   *
+   * @param filename Name of the file to map.
+   */
+  explicit MappedMatrix(const std::string& filename) :
+      mapping(NULL),
+      mappedLength(0)
+  {
+#ifndef _WIN32
+    const int fd = open(filename.c_str(), O_RDONLY);
+    if (fd < 0)
+      throw std::runtime_error("MappedMatrix: cannot open file '" + filename +
+          "'!");
+
+    struct stat info;
+    if (fstat(fd, &info) != 0)
+    {
+      close(fd);
+      throw std::runtime_error("MappedMatrix: cannot stat file '" + filename +
+          "'!");
+    }
+
+    details::BinaryColumnarHeader header;
+    if (read(fd, &header, sizeof(header)) != (ssize_t) sizeof(header) ||
+        !details::CheckBinaryColumnarHeader<eT>(header) ||
+        (uint64_t) info.st_size <
+            header.dataOffset + header.rows * header.cols * sizeof(eT))
+    {
+      close(fd);
+      throw std::runtime_error("MappedMatrix: '" + filename + "' is not "
+          "binary columnar data of the right element type!");
+    }
+
+    mappedLength = (size_t) info.st_size;
+    mapping = mmap(NULL, mappedLength, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd); // The mapping keeps its own reference.
+    if (mapping == MAP_FAILED)
+    {
+      mapping = NULL;
+      throw std::runtime_error("MappedMatrix: cannot map file '" + filename +
+          "'!");
+    }
+
+    // Wrap the payload without copying; strict aliasing keeps the matrix
+    // from ever reallocating away from the mapping.
+    matrix = arma::Mat<eT>(
+        (eT*) ((char*) mapping + header.dataOffset),
+        header.rows, header.cols, false, true);
+#else
+    if (!LoadBinaryColumnar(filename, matrix))
+    {
+      throw std::runtime_error("MappedMatrix: cannot load file '" + filename +
+          "'!");
+    }
+#endif
+  }
+
+  //! Unmap the file.
+  ~MappedMatrix()
+  {
+#ifndef _WIN32
+    if (mapping != NULL)
+      munmap(mapping, mappedLength);
+#endif
+  }
+
+  //! MappedMatrix owns a mapping and cannot be copied.
+  MappedMatrix(const MappedMatrix&) = delete;
+  //! MappedMatrix owns a mapping and cannot be copied.
+  MappedMatrix& operator=(const MappedMatrix&) = delete;
+
+  //! Get the matrix view over the mapped payload.
+  const arma::Mat<eT>& Matrix() const { return matrix; }
+
+ private:
+  //! Base address of the mapping (NULL on platforms without mmap).
+  void* mapping;
+
+  //! Length of the mapping in bytes.
+  size_t mappedLength;
+
+  //! Alias over the mapped payload (owned memory without mmap).
+  arma::Mat<eT> matrix;
+};
+
+} // namespace data
+} // namespace mlpack
+
+#endif
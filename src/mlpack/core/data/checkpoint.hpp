@@ -0,0 +1,130 @@
+/**
+ * @file core/data/checkpoint.hpp
+ * @author Ryan Curtin
+ *
+ * Periodic checkpointing of iterative training state.  Long-running trainers
+ * serialize a snapshot of their state every few iterations with the existing
+ * boost::serialization support, so that a preempted job can resume from the
+ * last snapshot instead of from zero.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_DATA_CHECKPOINT_HPP
+#define MLPACK_CORE_DATA_CHECKPOINT_HPP
+
+#include <mlpack/prereqs.hpp>
+
+#include <cstdio>
+#include <fstream>
+
+#include "load.hpp"
+#include "save.hpp"
+
+namespace mlpack {
+namespace data {
+
+/**
+ * Periodic checkpointing for iterative trainers.  The trainer bundles its
+ * resumable state into one serializable object, calls Restore() once before
+ * its loop, Save() once per iteration (only every interval-th call actually
+ * writes), and Finish() on successful completion (which removes the file, so
+ * a finished job does not resume from a stale snapshot).
+ *
+ * A checkpoint with an empty filename is disabled and every operation is a
+ * no-op, so call sites need no configuration checks.  The serialization
+ * format follows the filename extension, like model files ('.bin', '.xml' or
+ * '.txt').
+ */
+class Checkpoint
+{
+ public:
+  /**
+   * Construct a checkpoint.
+   *
+   * @param filename File to write snapshots to; empty disables checkpointing.
+   * @param interval Save a snapshot every `interval` calls to Save().
+   */
+  Checkpoint(const std::string& filename = "", const size_t interval = 10) :
+      filename(filename),
+      interval(interval)
+  { }
+
+  //! Return true if checkpointing is configured.
+  bool Enabled() const { return !filename.empty(); }
+
+  /**
+   * Restore the given state from the checkpoint file, if one exists.
+   * Returns true if state was restored.
+   *
+   * @param state Object to restore into.
+   */
+  template<typename T>
+  bool Restore(T& state) const
+  {
+    if (!Enabled())
+      return false;
+
+    // A missing file just means there is nothing to resume.
+    std::ifstream probe(filename);
+    if (!probe.good())
+      return false;
+    probe.close();
+
+    return Load(filename, "checkpoint", state, false);
+  }
+
+  /**
+   * Save the given state if the iteration number falls on the configured
+   * interval.  Failures are reported to Log::Warn but do not stop training:
+   * losing a snapshot is preferable to losing the job.
+   *
+   * @param iteration Current iteration number (1-based).
+   * @param state Object to snapshot.
+   */
+  template<typename T>
+  void Save(const size_t iteration, T& state) const
+  {
+    if (!Enabled() || interval == 0 || (iteration % interval) != 0)
+      return;
+
+    if (!data::Save(filename, "checkpoint", state, false))
+    {
+      Log::Warn << "Checkpoint: could not write snapshot to '" << filename
+          << "'!" << std::endl;
+    }
+  }
+
+  /**
+   * Mark the job as successfully finished, removing the checkpoint file.
+   */
+  void Finish() const
+  {
+    if (Enabled())
+      remove(filename.c_str());
+  }
+
+  //! Get the checkpoint filename.
+  const std::string& Filename() const { return filename; }
+  //! Modify the checkpoint filename.
+  std::string& Filename() { return filename; }
+
+  //! Get the checkpoint interval.
+  size_t Interval() const { return interval; }
+  //! Modify the checkpoint interval.
+  size_t& Interval() { return interval; }
+
+ private:
+  //! File the snapshots are written to; empty disables checkpointing.
+  std::string filename;
+
+  //! Number of iterations between snapshots.
+  size_t interval;
+};
+
+} // namespace data
+} // namespace mlpack
+
+#endif
@@ -0,0 +1,142 @@
+/**
+ * @file core/data/chunked_loader.hpp
+ * @author Ryan Curtin
+ *
+ * Definition of the ChunkedLoader class, a streaming reader that yields
+ * fixed-size column blocks of a dataset file with double-buffered background
+ * reads, for consumers that cannot (or do not want to) materialize the full
+ * matrix.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_DATA_CHUNKED_LOADER_HPP
+#define MLPACK_CORE_DATA_CHUNKED_LOADER_HPP
+
+#include <mlpack/prereqs.hpp>
+
+#include <fstream>
+#include <thread>
+
+namespace mlpack {
+namespace data {
+
+/**
+ * A streaming dataset reader that yields fixed-size column blocks instead of
+ * one full matrix, so datasets larger than RAM can be pushed through
+ * mini-batch consumers.  While the consumer works on the current block, the
+ * next one is read and parsed on a background thread, so Next() usually only
+ * swaps buffers.
+ *
+ * Supported formats are plain numeric text (CSV, TSV and whitespace-
+ * separated ASCII) and the mlpack binary columnar format (.mbin).  Text
+ * files follow the same convention as data::Load() with transpose: each file
+ * row becomes one matrix column.  For binary columnar files the stored
+ * columns are handed out directly, which makes chunked reads simple seeks.
+ *
+ * A std::runtime_error is thrown if the file cannot be opened or holds a
+ * malformed line.
+ *
+ * An example of streaming a dataset through a consumer:
+ *
+ * @code
+ * data::ChunkedLoader<> loader("dataset.csv", 10000);
+ *
+ * arma::mat chunk;
+ * while (loader.Next(chunk))
+ *   ConsumeBatch(chunk);
+ * @endcode
+ */
+template<typename eT = double>
+class ChunkedLoader
+{
+ public:
+  /**
+   * Open the given file for chunked reading and start reading the first
+   * block in the background.
+   *
+   * @param filename Name of the file to stream.
+   * @param chunkSize Maximum number of columns (points) per block.
+   */
+  ChunkedLoader(const std::string& filename, const size_t chunkSize);
+
+  //! Join the prefetch thread.
+  ~ChunkedLoader();
+
+  //! A ChunkedLoader owns a stream and a thread and cannot be copied.
+  ChunkedLoader(const ChunkedLoader&) = delete;
+  //! A ChunkedLoader owns a stream and a thread and cannot be copied.
+  ChunkedLoader& operator=(const ChunkedLoader&) = delete;
+
+  /**
+   * Hand out the next block of up to ChunkSize() columns.  Blocks until the
+   * background read has finished, then immediately starts reading the block
+   * after it.  Returns false when the file is exhausted.
+   *
+   * @param chunk Matrix the block is moved into.
+   */
+  bool Next(arma::Mat<eT>& chunk);
+
+  //! Rewind to the start of the data and restart the background read.
+  void Reset();
+
+  //! Get the dimensionality (number of rows) of the streamed matrix.
+  size_t Dimensionality() const { return dims; }
+
+  //! Get the maximum number of columns per block.
+  size_t ChunkSize() const { return chunkSize; }
+
+ private:
+  //! Open the file, detect the format and read the dimensionality.
+  void Open();
+
+  //! Read the next block synchronously; called on the prefetch thread.
+  void ReadChunk();
+
+  //! Name of the streamed file.
+  std::string filename;
+
+  //! Maximum number of columns per block.
+  size_t chunkSize;
+
+  //! The stream the blocks are read from.
+  std::ifstream stream;
+
+  //! Whether the file is binary columnar data (text otherwise).
+  bool binary;
+
+  //! Dimensionality of the streamed matrix.
+  size_t dims;
+
+  //! Total number of columns of a binary columnar file.
+  size_t totalCols;
+
+  //! Number of columns handed out or buffered so far (binary files).
+  size_t colsRead;
+
+  //! First data line of a text file, consumed while detecting the
+  //! dimensionality; used by the first block.
+  std::string pendingLine;
+
+  //! Whether pendingLine holds an unconsumed line.
+  bool havePendingLine;
+
+  //! The block read ahead by the prefetch thread.
+  arma::Mat<eT> buffered;
+
+  //! Error message of a failed background parse, rethrown by Next().
+  std::string bufferedError;
+
+  //! The background reader; joined before any state is touched.
+  std::thread prefetchThread;
+};
+
+} // namespace data
+} // namespace mlpack
+
+// Include implementation.
+#include "chunked_loader_impl.hpp"
+
+#endif
@@ -0,0 +1,187 @@
+/**
+ * @file core/data/chunked_loader_impl.hpp
+ * @author Ryan Curtin
+ *
+ * Implementation of the ChunkedLoader class.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_DATA_CHUNKED_LOADER_IMPL_HPP
+#define MLPACK_CORE_DATA_CHUNKED_LOADER_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "chunked_loader.hpp"
+
+#include "binary_columnar.hpp"
+#include "load_numeric_csv.hpp"
+#include "extension.hpp"
+
+namespace mlpack {
+namespace data {
+
+template<typename eT>
+ChunkedLoader<eT>::ChunkedLoader(const std::string& filename,
+                                 const size_t chunkSize) :
+    filename(filename),
+    chunkSize(chunkSize),
+    binary(Extension(filename) == "mbin"),
+    dims(0),
+    totalCols(0),
+    colsRead(0),
+    havePendingLine(false)
+{
+  if (chunkSize == 0)
+    throw std::runtime_error("ChunkedLoader: chunk size cannot be zero!");
+
+  Open();
+
+  // Read the first block in the background.
+  prefetchThread = std::thread([this]() { ReadChunk(); });
+}
+
+template<typename eT>
+ChunkedLoader<eT>::~ChunkedLoader()
+{
+  if (prefetchThread.joinable())
+    prefetchThread.join();
+}
+
+template<typename eT>
+void ChunkedLoader<eT>::Open()
+{
+  stream.close();
+  stream.clear();
+  stream.open(filename.c_str(), std::ifstream::in | std::ifstream::binary);
+  if (!stream.is_open())
+    throw std::runtime_error("ChunkedLoader: cannot open file '" + filename +
+        "'!");
+
+  colsRead = 0;
+  havePendingLine = false;
+
+  if (binary)
+  {
+    details::BinaryColumnarHeader header;
+    stream.read((char*) &header, sizeof(header));
+    if (!stream || !details::CheckBinaryColumnarHeader<eT>(header))
+    {
+      throw std::runtime_error("ChunkedLoader: '" + filename + "' is not "
+          "binary columnar data of the right element type!");
+    }
+
+    dims = (size_t) header.rows;
+    totalCols = (size_t) header.cols;
+    stream.seekg((std::streamoff) header.dataOffset);
+  }
+  else
+  {
+    // Find the first non-empty line to detect the dimensionality; the line
+    // is kept for the first block.
+    while (std::getline(stream, pendingLine))
+    {
+      const size_t fields = details::CountFields(pendingLine.data(),
+          pendingLine.data() + pendingLine.size());
+      if (fields > 0)
+      {
+        dims = fields;
+        havePendingLine = true;
+        break;
+      }
+    }
+
+    if (!havePendingLine)
+      throw std::runtime_error("ChunkedLoader: '" + filename + "' is empty!");
+  }
+}
+
+template<typename eT>
+void ChunkedLoader<eT>::ReadChunk()
+{
+  bufferedError.clear();
+
+  if (binary)
+  {
+    const size_t cols = std::min(chunkSize, totalCols - colsRead);
+    buffered.set_size(dims, cols);
+    if (cols > 0)
+    {
+      stream.read((char*) buffered.memptr(),
+          (std::streamsize) (buffered.n_elem * sizeof(eT)));
+      if (!stream)
+      {
+        bufferedError = "ChunkedLoader: short read from '" + filename + "'!";
+        return;
+      }
+      colsRead += cols;
+    }
+
+    return;
+  }
+
+  // Collect up to chunkSize non-empty lines, then parse them into columns.
+  std::vector<std::string> lines;
+  lines.reserve(chunkSize);
+  if (havePendingLine)
+  {
+    lines.push_back(std::move(pendingLine));
+    havePendingLine = false;
+  }
+
+  std::string line;
+  while (lines.size() < chunkSize && std::getline(stream, line))
+  {
+    if (details::CountFields(line.data(), line.data() + line.size()) > 0)
+      lines.push_back(std::move(line));
+  }
+
+  buffered.set_size(dims, lines.size());
+  for (size_t i = 0; i < lines.size(); ++i)
+  {
+    if (!details::ParseNumericLine(lines[i].data(),
+        lines[i].data() + lines[i].size(), dims, buffered.colptr(i), 1))
+    {
+      bufferedError = "ChunkedLoader: malformed line in '" + filename + "'!";
+      return;
+    }
+  }
+}
+
+template<typename eT>
+bool ChunkedLoader<eT>::Next(arma::Mat<eT>& chunk)
+{
+  if (prefetchThread.joinable())
+    prefetchThread.join();
+
+  if (!bufferedError.empty())
+    throw std::runtime_error(bufferedError);
+
+  if (buffered.n_cols == 0)
+    return false;
+
+  chunk = std::move(buffered);
+  buffered.set_size(dims, 0);
+
+  // Read the block after this one while the caller works.
+  prefetchThread = std::thread([this]() { ReadChunk(); });
+
+  return true;
+}
+
+template<typename eT>
+void ChunkedLoader<eT>::Reset()
+{
+  if (prefetchThread.joinable())
+    prefetchThread.join();
+
+  Open();
+  buffered.set_size(dims, 0);
+  prefetchThread = std::thread([this]() { ReadChunk(); });
+}
+
+} // namespace data
+} // namespace mlpack
+
+#endif
@@ -0,0 +1,324 @@
+/**
+ * @file core/data/compression.hpp
+ * @author Ryan Curtin
+ *
+ * A fast byte-oriented compression codec for serialized models.  The format
+ * is a simple LZ77 variant in the spirit of LZ4: greedy hash-table matching,
+ * nibble-packed literal/match lengths and raw little-endian offsets, tuned
+ * entirely for speed rather than ratio.  The stream is split into
+ * independently compressed blocks, so decompression parallelizes over blocks.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_DATA_COMPRESSION_HPP
+#define MLPACK_CORE_DATA_COMPRESSION_HPP
+
+#include <mlpack/prereqs.hpp>
+#include <algorithm>
+#include <cstring>
+#include <istream>
+#include <ostream>
+#include <vector>
+
+namespace mlpack {
+namespace data {
+namespace details {
+
+//! The uncompressed size of each independently compressed block.
+const size_t CompressedBlockSize = 1 << 20;
+
+//! Identifies a compressed model frame; exactly 16 bytes.
+const char CompressedFrameMagic[16] = "MLPACK_ZBIN_V1";
+
+/**
+ * Append the length to the output in the LZ4 style: the value is expected to
+ * have been capped at 15 in the token nibble; the remainder follows as bytes
+ * of up to 255, terminated by the first byte smaller than 255.
+ */
+inline void AppendLength(std::vector<unsigned char>& output, size_t length)
+{
+  while (length >= 255)
+  {
+    output.push_back(255);
+    length -= 255;
+  }
+  output.push_back((unsigned char) length);
+}
+
+/**
+ * Compress one block of input and append the result to the output.  The
+ * encoding is a sequence of tokens; each token holds a literal run length and
+ * a match length in its two nibbles (15 meaning "extended length bytes
+ * follow"), then the literals, then a 4-byte little-endian backwards offset.
+ * The final token of a block may carry literals only, which the decompressor
+ * detects by having produced the full block.
+ */
+inline void CompressBlock(const unsigned char* input,
+                          const size_t inputSize,
+                          std::vector<unsigned char>& output)
+{
+  const size_t minMatch = 4;
+  const size_t hashBits = 16;
+  std::vector<uint32_t> table((size_t) 1 << hashBits, 0);
+  // Position 0 is used as "empty"; matches at position 0 are simply lost.
+
+  size_t pos = 0;
+  size_t literalStart = 0;
+  while (pos + minMatch <= inputSize)
+  {
+    // Hash the next four bytes.
+    uint32_t sequence;
+    memcpy(&sequence, input + pos, sizeof(uint32_t));
+    const uint32_t hash = (sequence * 2654435761U) >> (32 - hashBits);
+    const size_t candidate = table[hash];
+    table[hash] = (uint32_t) pos;
+
+    uint32_t candidateSequence = 0;
+    if (candidate != 0 && candidate < pos)
+      memcpy(&candidateSequence, input + candidate, sizeof(uint32_t));
+
+    if (candidate == 0 || candidate >= pos || candidateSequence != sequence)
+    {
+      ++pos;
+      continue;
+    }
+
+    // Extend the match as far as possible.
+    size_t matchLength = minMatch;
+    while (pos + matchLength < inputSize &&
+        input[candidate + matchLength] == input[pos + matchLength])
+      ++matchLength;
+
+    // Emit the token: literal run since the last match, then the match.
+    const size_t literalLength = pos - literalStart;
+    const size_t litNibble = std::min(literalLength, (size_t) 15);
+    const size_t matchNibble = std::min(matchLength - minMatch, (size_t) 15);
+    output.push_back((unsigned char) ((litNibble << 4) | matchNibble));
+    if (litNibble == 15)
+      AppendLength(output, literalLength - 15);
+    output.insert(output.end(), input + literalStart, input + pos);
+    if (matchNibble == 15)
+      AppendLength(output, matchLength - minMatch - 15);
+
+    const uint32_t offset = (uint32_t) (pos - candidate);
+    output.insert(output.end(), (const unsigned char*) &offset,
+        (const unsigned char*) &offset + sizeof(uint32_t));
+
+    pos += matchLength;
+    literalStart = pos;
+  }
+
+  // Emit the trailing literals, if any, as a match-free token.
+  const size_t literalLength = inputSize - literalStart;
+  const size_t litNibble = std::min(literalLength, (size_t) 15);
+  output.push_back((unsigned char) (litNibble << 4));
+  if (litNibble == 15)
+    AppendLength(output, literalLength - 15);
+  output.insert(output.end(), input + literalStart, input + inputSize);
+}
+
+/**
+ * Decompress one block.  Returns false if the compressed data is corrupt.
+ */
+inline bool DecompressBlock(const unsigned char* input,
+                            const size_t inputSize,
+                            unsigned char* output,
+                            const size_t outputSize)
+{
+  const size_t minMatch = 4;
+  size_t inPos = 0;
+  size_t outPos = 0;
+  while (outPos < outputSize)
+  {
+    if (inPos >= inputSize)
+      return false;
+
+    const unsigned char token = input[inPos++];
+    size_t literalLength = token >> 4;
+    if (literalLength == 15)
+    {
+      unsigned char lengthByte;
+      do
+      {
+        if (inPos >= inputSize)
+          return false;
+        lengthByte = input[inPos++];
+        literalLength += lengthByte;
+      } while (lengthByte == 255);
+    }
+
+    if (inPos + literalLength > inputSize ||
+        outPos + literalLength > outputSize)
+      return false;
+    memcpy(output + outPos, input + inPos, literalLength);
+    inPos += literalLength;
+    outPos += literalLength;
+
+    // The last token of a block carries no match.
+    if (outPos == outputSize)
+      break;
+
+    size_t matchLength = (token & 15);
+    if (matchLength == 15)
+    {
+      unsigned char lengthByte;
+      do
+      {
+        if (inPos >= inputSize)
+          return false;
+        lengthByte = input[inPos++];
+        matchLength += lengthByte;
+      } while (lengthByte == 255);
+    }
+    matchLength += minMatch;
+
+    if (inPos + sizeof(uint32_t) > inputSize)
+      return false;
+    uint32_t offset;
+    memcpy(&offset, input + inPos, sizeof(uint32_t));
+    inPos += sizeof(uint32_t);
+
+    if (offset == 0 || offset > outPos || outPos + matchLength > outputSize)
+      return false;
+
+    // The match may overlap its own output, so copy byte by byte.
+    for (size_t i = 0; i < matchLength; ++i)
+    {
+      output[outPos] = output[outPos - offset];
+      ++outPos;
+    }
+  }
+
+  return (outPos == outputSize);
+}
+
+} // namespace details
+
+/**
+ * Compress the given payload and write it as a framed stream: a magic string,
+ * the payload size, and a sequence of independently compressed blocks (each
+ * stored raw instead if compression did not shrink it).  Compression is
+ * streamed block by block, so no second payload-sized buffer is held.
+ *
+ * @param stream Stream to write the frame to (opened in binary mode).
+ * @param payload Bytes to compress.
+ * @return true on success.
+ */
+inline bool WriteCompressedFrame(std::ostream& stream,
+                                 const std::string& payload)
+{
+  stream.write(details::CompressedFrameMagic,
+      sizeof(details::CompressedFrameMagic));
+  const uint64_t payloadSize = payload.size();
+  const uint64_t blockSize = details::CompressedBlockSize;
+  stream.write((const char*) &payloadSize, sizeof(uint64_t));
+  stream.write((const char*) &blockSize, sizeof(uint64_t));
+
+  std::vector<unsigned char> compressed;
+  for (size_t offset = 0; offset < payload.size() || payload.empty();
+       offset += blockSize)
+  {
+    const size_t thisBlockSize = std::min((size_t) blockSize,
+        payload.size() - offset);
+    compressed.clear();
+    details::CompressBlock((const unsigned char*) payload.data() + offset,
+        thisBlockSize, compressed);
+
+    // Store the block raw if compression did not help.
+    const unsigned char compressedFlag = (compressed.size() < thisBlockSize);
+    stream.put((char) compressedFlag);
+    if (compressedFlag)
+    {
+      const uint64_t storedSize = compressed.size();
+      stream.write((const char*) &storedSize, sizeof(uint64_t));
+      stream.write((const char*) compressed.data(), storedSize);
+    }
+    else
+    {
+      const uint64_t storedSize = thisBlockSize;
+      stream.write((const char*) &storedSize, sizeof(uint64_t));
+      stream.write(payload.data() + offset, storedSize);
+    }
+
+    if (payload.empty())
+      break;
+  }
+
+  return !stream.fail();
+}
+
+/**
+ * Read a frame written by WriteCompressedFrame() and decompress it.  The
+ * blocks are independent, so they are decompressed in parallel.
+ *
+ * @param stream Stream to read the frame from (opened in binary mode).
+ * @param payload Output string to store the decompressed bytes.
+ * @return true on success; false if the frame is missing or corrupt.
+ */
+inline bool ReadCompressedFrame(std::istream& stream, std::string& payload)
+{
+  char magic[sizeof(details::CompressedFrameMagic)];
+  stream.read(magic, sizeof(magic));
+  if (stream.fail() ||
+      memcmp(magic, details::CompressedFrameMagic, sizeof(magic)) != 0)
+    return false;
+
+  uint64_t payloadSize, blockSize;
+  stream.read((char*) &payloadSize, sizeof(uint64_t));
+  stream.read((char*) &blockSize, sizeof(uint64_t));
+  if (stream.fail() || blockSize == 0)
+    return false;
+
+  const size_t numBlocks = (payloadSize == 0) ? 1 :
+      (size_t) ((payloadSize + blockSize - 1) / blockSize);
+
+  // Read all compressed blocks first; decompression is then embarrassingly
+  // parallel.
+  std::vector<std::vector<unsigned char>> blocks(numBlocks);
+  std::vector<unsigned char> flags(numBlocks);
+  for (size_t i = 0; i < numBlocks; ++i)
+  {
+    flags[i] = (unsigned char) stream.get();
+    uint64_t storedSize;
+    stream.read((char*) &storedSize, sizeof(uint64_t));
+    if (stream.fail())
+      return false;
+    blocks[i].resize(storedSize);
+    stream.read((char*) blocks[i].data(), storedSize);
+    if (stream.fail())
+      return false;
+  }
+
+  payload.resize(payloadSize);
+  size_t failures = 0;
+  #pragma omp parallel for reduction(+:failures)
+  for (omp_size_t i = 0; i < (omp_size_t) numBlocks; ++i)
+  {
+    const size_t offset = i * blockSize;
+    const size_t thisBlockSize = std::min((size_t) blockSize,
+        (size_t) payloadSize - offset);
+    if (flags[i])
+    {
+      if (!details::DecompressBlock(blocks[i].data(), blocks[i].size(),
+          (unsigned char*) &payload[0] + offset, thisBlockSize))
+        ++failures;
+    }
+    else
+    {
+      if (blocks[i].size() != thisBlockSize)
+        ++failures;
+      else
+        memcpy(&payload[0] + offset, blocks[i].data(), thisBlockSize);
+    }
+  }
+
+  return (failures == 0);
+}
+
+} // namespace data
+} // namespace mlpack
+
+#endif
@@ -87,6 +87,27 @@ class DatasetMapper
   T MapString(const InputType& input,
               const size_t dimension);
 
+  /**
+   * Given the input and the dimension to which it belongs, look up its numeric
+   * mapping without modifying the mapper.  On success the mapping is stored in
+   * value and true is returned; if the input has no mapping (and, for numeric
+   * dimensions, cannot be parsed as a number), false is returned.
+   *
+   * Because this is read-only it is safe to call from multiple threads
+   * simultaneously, so a dataset can be encoded in two passes: a serial pass
+   * that builds the mappings with MapString(), and then a parallel pass that
+   * encodes every token with TryMapString().
+   *
+   * @tparam T Numeric type to map to (int/double/float/etc.).
+   * @param input Input to find the mapping for.
+   * @param dimension Index of the dimension of the input.
+   * @param value Output; set to the mapping if one exists.
+   */
+  template<typename T>
+  bool TryMapString(const InputType& input,
+                    const size_t dimension,
+                    T& value) const;
+
   /**
    * Return the input that corresponds to a given value in a given dimension.
    * If the value is not a valid mapping in the given dimension, a
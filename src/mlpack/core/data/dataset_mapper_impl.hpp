@@ -89,6 +89,36 @@ inline T DatasetMapper<PolicyType, InputType>::MapString(
   return policy.template MapString<MapType, T>(input, dimension, maps, types);
 }
 
+// Read-only lookup of an existing mapping; safe to call from many threads.
+template<typename PolicyType, typename InputType>
+template<typename T>
+inline bool DatasetMapper<PolicyType, InputType>::TryMapString(
+    const InputType& input,
+    const size_t dimension,
+    T& value) const
+{
+  if (dimension < types.size() && types[dimension] == Datatype::numeric)
+  {
+    // Numeric dimensions hold no mappings; parse the token directly.
+    std::stringstream token;
+    token << input;
+    token >> value;
+    return (!token.fail() && token.eof());
+  }
+
+  // Categorical dimension: the mapping must already exist.
+  typename MapType::const_iterator mapIt = maps.find(dimension);
+  if (mapIt == maps.end())
+    return false;
+
+  typename ForwardMapType::const_iterator it = mapIt->second.first.find(input);
+  if (it == mapIt->second.first.end())
+    return false;
+
+  value = T(it->second);
+  return true;
+}
+
 /**
  * A safe version of isnan() that only gets called when the type has a NaN at
  * all.  This is a workaround for Visual Studio, which doesn't seem to support
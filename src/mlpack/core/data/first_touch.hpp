@@ -0,0 +1,85 @@
+/**
+ * @file core/data/first_touch.hpp
+ * @author Ryan Curtin
+ *
+ * NUMA-aware placement of dataset memory.  On multi-socket machines the OS
+ * places each page of an allocation on the NUMA node of the thread that first
+ * writes it ("first touch"); since a dataset is normally loaded by one
+ * thread, the whole matrix lands on one node and the other socket's threads
+ * pay remote-memory latency in every parallel loop over it.
+ *
+ * FirstTouchPlacement() re-copies a matrix into a fresh buffer with one
+ * contiguous column shard per thread—the same decomposition that the
+ * column-parallel loops in mlpack use (static OpenMP scheduling and the
+ * query sharding in NeighborSearch)—so each thread's shard is resident on
+ * the node that will process it.  For the placement to stick, threads must
+ * be bound to cores (e.g. OMP_PROC_BIND=true with OMP_PLACES=cores);
+ * without binding the copy is harmless but buys nothing.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_DATA_FIRST_TOUCH_HPP
+#define MLPACK_CORE_DATA_FIRST_TOUCH_HPP
+
+#include <mlpack/prereqs.hpp>
+
+#ifdef HAS_OPENMP
+  #include <omp.h>
+#endif
+
+namespace mlpack {
+namespace data {
+
+/**
+ * Redistribute the memory of the given matrix across NUMA nodes by copying
+ * it into a fresh buffer with one contiguous column shard per thread.  Call
+ * this once after loading a dataset that parallel loops will sweep
+ * repeatedly (e.g. before NaiveKMeans or query-parallel NeighborSearch); the
+ * contents of the matrix are unchanged.
+ *
+ * Without OpenMP (or with a single thread) there is nothing to distribute
+ * and the matrix is left untouched.
+ *
+ * @param matrix Matrix whose memory should be redistributed.
+ */
+template<typename eT>
+void FirstTouchPlacement(arma::Mat<eT>& matrix)
+{
+#ifdef HAS_OPENMP
+  if (omp_get_max_threads() <= 1 || matrix.n_cols <= 1 || matrix.n_elem == 0)
+    return;
+
+  // The new buffer is allocated but not written here, so its pages are still
+  // unplaced when the threads below touch them.
+  arma::Mat<eT> placed(matrix.n_rows, matrix.n_cols);
+
+  #pragma omp parallel
+  {
+    // Contiguous shards, thread t owning [t * n / T, (t + 1) * n / T): the
+    // same decomposition a static-scheduled column loop or the NeighborSearch
+    // query sharding produces, so later passes hit local pages.
+    const size_t thread = (size_t) omp_get_thread_num();
+    const size_t actualThreads = (size_t) omp_get_num_threads();
+    const size_t shardBegin = (thread * matrix.n_cols) / actualThreads;
+    const size_t shardEnd = ((thread + 1) * matrix.n_cols) / actualThreads;
+
+    if (shardEnd > shardBegin)
+    {
+      std::memcpy(placed.colptr(shardBegin), matrix.colptr(shardBegin),
+          (shardEnd - shardBegin) * matrix.n_rows * sizeof(eT));
+    }
+  }
+
+  matrix = std::move(placed);
+#else
+  (void) matrix;
+#endif
+}
+
+} // namespace data
+} // namespace mlpack
+
+#endif
@@ -22,7 +22,9 @@ enum format
   autodetect,
   text,
   xml,
-  binary
+  binary,
+  //! A binary archive wrapped in mlpack's block-compressed frame format.
+  compressed_binary
 };
 
 } // namespace data
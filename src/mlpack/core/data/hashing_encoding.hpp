@@ -0,0 +1,161 @@
+/**
+ * @file core/data/hashing_encoding.hpp
+ * @author Jeffin Sam
+ *
+ * Definition of the HashingEncoding class.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_DATA_HASHING_ENCODING_HPP
+#define MLPACK_CORE_DATA_HASHING_ENCODING_HPP
+
+#include <mlpack/prereqs.hpp>
+#include <mlpack/core/boost_backport/boost_backport_string_view.hpp>
+#include <vector>
+
+namespace mlpack {
+namespace data {
+
+/**
+ * The class translates a set of strings into numbers using the hashing trick:
+ * each token is mapped to a column by hashing its characters, so no dictionary
+ * is ever built.  Unlike StringEncoding this needs no vocabulary memory and no
+ * first pass over the corpus, and every document is independent of the others,
+ * so the documents are encoded in parallel.  The price is that distinct tokens
+ * may collide in the same feature.
+ *
+ * The encoder writes data either in the column-major order or in the row-major
+ * order depending on the output data type, following the same convention as
+ * StringEncoding.
+ */
+class HashingEncoding
+{
+ public:
+  /**
+   * Construct the encoder with the given number of output features.
+   *
+   * @param numFeatures The number of rows of the encoded matrix; token hashes
+   *        are reduced modulo this value.
+   */
+  HashingEncoding(const size_t numFeatures = 1024) : numFeatures(numFeatures)
+  {
+    if (numFeatures == 0)
+      throw std::invalid_argument("HashingEncoding: numFeatures must be "
+          "positive!");
+  }
+
+  /**
+   * Encode the given text and write the token counts to the given dense
+   * matrix.  Each document becomes one column with numFeatures rows; the
+   * feature of each token is the hash of its characters reduced modulo
+   * numFeatures.  The documents are encoded in parallel.
+   *
+   * @tparam MatType Type of the output matrix; it must be dense, since the
+   *                 documents are written concurrently.
+   * @tparam TokenizerType Type of the tokenizer.
+   *
+   * @param input Corpus of text to encode.
+   * @param output Output matrix to store the result.
+   * @param tokenizer The tokenizer object; see StringEncoding for the
+   *        requirements on the tokenization algorithm.
+   */
+  template<typename MatType, typename TokenizerType>
+  void Encode(const std::vector<std::string>& input,
+              MatType& output,
+              const TokenizerType& tokenizer) const
+  {
+    output.zeros(numFeatures, input.size());
+
+    // Each document only writes to its own column.
+    #pragma omp parallel for
+    for (omp_size_t i = 0; i < (omp_size_t) input.size(); ++i)
+    {
+      boost::string_view strView(input[i]);
+      auto token = tokenizer(strView);
+
+      while (!tokenizer.IsTokenEmpty(token))
+      {
+        output(HashToken(token) % numFeatures, i) += 1;
+        token = tokenizer(strView);
+      }
+    }
+  }
+
+  /**
+   * Encode the given text as sequences of hashed token labels in the range
+   * [1, numFeatures] and write the result to the given 2D vector, one inner
+   * vector per document in the row-major order.  This mirrors the one pass
+   * mode of the dictionary encoding, but with hashed labels instead of
+   * dictionary values.  The documents are encoded in parallel.
+   *
+   * @tparam ElemType Type of the output values.
+   * @tparam TokenizerType Type of the tokenizer.
+   *
+   * @param input Corpus of text to encode.
+   * @param output Output container to store the result.
+   * @param tokenizer The tokenizer object; see StringEncoding for the
+   *        requirements on the tokenization algorithm.
+   */
+  template<typename ElemType, typename TokenizerType>
+  void Encode(const std::vector<std::string>& input,
+              std::vector<std::vector<ElemType>>& output,
+              const TokenizerType& tokenizer) const
+  {
+    output.resize(input.size());
+
+    #pragma omp parallel for
+    for (omp_size_t i = 0; i < (omp_size_t) input.size(); ++i)
+    {
+      output[i].clear();
+      boost::string_view strView(input[i]);
+      auto token = tokenizer(strView);
+
+      while (!tokenizer.IsTokenEmpty(token))
+      {
+        output[i].push_back(ElemType(HashToken(token) % numFeatures + 1));
+        token = tokenizer(strView);
+      }
+    }
+  }
+
+  //! Return the number of output features.
+  size_t NumFeatures() const { return numFeatures; }
+
+  /**
+   * Serialize the class to the given archive.
+   */
+  template<typename Archive>
+  void serialize(Archive& ar, const unsigned int /* version */)
+  {
+    ar & BOOST_SERIALIZATION_NVP(numFeatures);
+  }
+
+ private:
+  /**
+   * Hash the characters of the given token with the 64-bit FNV-1a hash, which
+   * is deterministic across platforms and standard library implementations
+   * (unlike std::hash), so encoded datasets and serialized models agree
+   * everywhere.
+   */
+  static size_t HashToken(const boost::string_view token)
+  {
+    uint64_t hash = 14695981039346656037ULL;
+    for (size_t i = 0; i < token.size(); ++i)
+    {
+      hash ^= (unsigned char) token[i];
+      hash *= 1099511628211ULL;
+    }
+    return (size_t) hash;
+  }
+
+  //! The number of output features.
+  size_t numFeatures;
+};
+
+} // namespace data
+} // namespace mlpack
+
+#endif
@@ -0,0 +1,127 @@
+/**
+ * @file core/data/incremental_confusion_matrix.hpp
+ *
+ * An accumulator-style confusion matrix that can be updated with batches of
+ * predictions and read cheaply at any time.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_DATA_INCREMENTAL_CONFUSION_MATRIX_HPP
+#define MLPACK_CORE_DATA_INCREMENTAL_CONFUSION_MATRIX_HPP
+
+#include <mlpack/prereqs.hpp>
+
+namespace mlpack {
+namespace data {
+
+/**
+ * The class IncrementalConfusionMatrix keeps a confusion matrix as a running
+ * summary of prediction results: it is updated with batches of predictions as
+ * they are made (e.g. while monitoring a long training run), accumulators of
+ * different threads can be merged, and the current value of accuracy,
+ * precision, recall, or F1 can be read at any time without buffering any
+ * predictions.
+ *
+ * The layout of the matrix is the same as for data::ConfusionMatrix(): the row
+ * index represents the predicted class and the column index represents the
+ * actual class.
+ *
+ * @code
+ * IncrementalConfusionMatrix cm(numClasses);
+ * for (...each batch...)
+ * {
+ *   model.Classify(batch, predictions);
+ *   cm.Update(predictions, batchLabels);
+ *   Log::Info << "accuracy so far: " << cm.Accuracy() << std::endl;
+ * }
+ * @endcode
+ */
+class IncrementalConfusionMatrix
+{
+ public:
+  /**
+   * Create an empty accumulator.
+   *
+   * @param numClasses Number of classes.
+   */
+  explicit IncrementalConfusionMatrix(const size_t numClasses);
+
+  /**
+   * Add a batch of predictions to the accumulator.  It is expected that
+   * predictions and labels have the same number of elements.
+   *
+   * @param predictions Predicted classes.
+   * @param labels Actual classes.
+   */
+  void Update(const arma::Row<size_t>& predictions,
+              const arma::Row<size_t>& labels);
+
+  /**
+   * Add the counts of another accumulator (e.g. one filled by another thread)
+   * to this one.
+   *
+   * @param other The accumulator to merge in (should be created for the same
+   *     number of classes).
+   */
+  void Merge(const IncrementalConfusionMatrix& other);
+
+  //! Get the accumulated confusion matrix (predicted classes as rows, actual
+  //! classes as columns).
+  const arma::Mat<size_t>& Matrix() const { return matrix; }
+
+  //! Get the number of accumulated predictions.
+  size_t NumPoints() const { return numPoints; }
+
+  /**
+   * Get the fraction of correct predictions so far.  Throws std::logic_error
+   * if no predictions have been accumulated.
+   */
+  double Accuracy() const;
+
+  /**
+   * Get the precision of the given class so far (the fraction of the
+   * predictions of that class that are correct).  Returns zero if the class
+   * has never been predicted.
+   *
+   * @param c The class of interest.
+   */
+  double Precision(const size_t c) const;
+
+  /**
+   * Get the recall of the given class so far (the fraction of the actual
+   * points of that class that are predicted correctly).  Returns zero if the
+   * class has never occurred.
+   *
+   * @param c The class of interest.
+   */
+  double Recall(const size_t c) const;
+
+  /**
+   * Get the F1 score of the given class so far (the harmonic mean of
+   * precision and recall).  Returns zero if both are zero.
+   *
+   * @param c The class of interest.
+   */
+  double F1(const size_t c) const;
+
+  //! Forget all accumulated predictions.
+  void Reset();
+
+ private:
+  //! The accumulated counts.
+  arma::Mat<size_t> matrix;
+
+  //! The number of accumulated predictions.
+  size_t numPoints;
+};
+
+} // namespace data
+} // namespace mlpack
+
+// Include implementation.
+#include "incremental_confusion_matrix_impl.hpp"
+
+#endif
@@ -0,0 +1,81 @@
+/**
+ * @file core/data/incremental_confusion_matrix_impl.hpp
+ *
+ * Implementation of the incrementally updated confusion matrix.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_DATA_INCREMENTAL_CONFUSION_MATRIX_IMPL_HPP
+#define MLPACK_CORE_DATA_INCREMENTAL_CONFUSION_MATRIX_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "incremental_confusion_matrix.hpp"
+
+namespace mlpack {
+namespace data {
+
+inline IncrementalConfusionMatrix::IncrementalConfusionMatrix(
+    const size_t numClasses) :
+    matrix(arma::zeros<arma::Mat<size_t>>(numClasses, numClasses)),
+    numPoints(0)
+{ /* Nothing left to do. */ }
+
+inline void IncrementalConfusionMatrix::Update(
+    const arma::Row<size_t>& predictions,
+    const arma::Row<size_t>& labels)
+{
+  for (size_t i = 0; i < predictions.n_elem; ++i)
+    matrix(predictions[i], labels[i])++;
+
+  numPoints += predictions.n_elem;
+}
+
+inline void IncrementalConfusionMatrix::Merge(
+    const IncrementalConfusionMatrix& other)
+{
+  matrix += other.matrix;
+  numPoints += other.numPoints;
+}
+
+inline double IncrementalConfusionMatrix::Accuracy() const
+{
+  if (numPoints == 0)
+    throw std::logic_error("IncrementalConfusionMatrix::Accuracy(): no "
+        "predictions have been accumulated");
+
+  return (double) arma::trace(matrix) / (double) numPoints;
+}
+
+inline double IncrementalConfusionMatrix::Precision(const size_t c) const
+{
+  const size_t predicted = arma::accu(matrix.row(c));
+  return (predicted == 0) ? 0.0 : (double) matrix(c, c) / (double) predicted;
+}
+
+inline double IncrementalConfusionMatrix::Recall(const size_t c) const
+{
+  const size_t actual = arma::accu(matrix.col(c));
+  return (actual == 0) ? 0.0 : (double) matrix(c, c) / (double) actual;
+}
+
+inline double IncrementalConfusionMatrix::F1(const size_t c) const
+{
+  const double precision = Precision(c);
+  const double recall = Recall(c);
+  return (precision + recall == 0.0) ? 0.0 :
+      2.0 * precision * recall / (precision + recall);
+}
+
+inline void IncrementalConfusionMatrix::Reset()
+{
+  matrix.zeros();
+  numPoints = 0;
+}
+
+} // namespace data
+} // namespace mlpack
+
+#endif
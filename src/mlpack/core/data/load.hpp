@@ -40,6 +40,7 @@ namespace data /** Functions to load and save matrices and models. */ {
  *  - PPM (ppm_binary), denoted by .ppm
  *  - Raw binary (raw_binary), denoted by .bin
  *  - Armadillo binary (arma_binary), denoted by .bin
+ *  - mlpack binary columnar data, denoted by .mbin
  *  - HDF5, denoted by .hdf, .hdf5, .h5, or .he5
  *
  * If the file extension is not one of those types, an error will be given.
@@ -76,6 +77,7 @@ bool Load(const std::string& filename,
  *  - TXT (coord_ascii), denoted by .txt
  *  - Raw binary (raw_binary), denoted by .bin
  *  - Armadillo binary (arma_binary), denoted by .bin
+ *  - mlpack binary columnar data, denoted by .mbin
  *
  * If the file extension is not one of those types, an error will be given.
  * This is preferable to Armadillo's default behavior of loading an unknown
@@ -185,6 +187,7 @@ extern template bool Load<double>(const std::string&,
  *  - PPM (ppm_binary), denoted by .ppm
  *  - Raw binary (raw_binary), denoted by .bin
  *  - Armadillo binary (arma_binary), denoted by .bin
+ *  - mlpack binary columnar data, denoted by .mbin
  *  - HDF5, denoted by .hdf, .hdf5, .h5, or .he5
  *
  * If the file extension is not one of those types, an error will be given.
@@ -217,6 +220,7 @@ bool Load(const std::string& filename,
  *  - PPM (ppm_binary), denoted by .ppm
  *  - Raw binary (raw_binary), denoted by .bin
  *  - Armadillo binary (arma_binary), denoted by .bin
+ *  - mlpack binary columnar data, denoted by .mbin
  *  - HDF5, denoted by .hdf, .hdf5, .h5, or .he5
  *
  * If the file extension is not one of those types, an error will be given.
@@ -332,9 +336,12 @@ extern template bool Load<double, IncrementPolicy>(
  *  - text, denoted by .txt
  *  - xml, denoted by .xml
  *  - binary, denoted by .bin
+ *  - compressed binary (a binary archive in mlpack's block-compressed frame
+ *    format), denoted by .zbin
  *
  * The format parameter can take any of the values in the 'format' enum:
- * 'format::autodetect', 'format::text', 'format::xml', and 'format::binary'.
+ * 'format::autodetect', 'format::text', 'format::xml', 'format::binary', and
+ * 'format::compressed_binary'.
  * The autodetect functionality operates on the file extension (so, "file.txt"
  * would be autodetected as text).
  *
@@ -400,6 +407,8 @@ bool LoadImage(const std::string& filename,
 #include "load_model_impl.hpp"
 // Include implementation of Load() for vectors.
 #include "load_vec_impl.hpp"
+// Include the batched parallel image loader.
+#include "load_images.hpp"
 // Include implementation of Load() for images.
 #include "load_image_impl.hpp"
 
@@ -1,5 +1,5 @@
 /**
- * @file core/data/load_image_impl.hpp
+ * @file core/data/load_image_impl.hpp
  * @author Mehul Kumar Nirala
  *
  * An image loading utility implementation.
@@ -45,49 +45,15 @@ bool Load(const std::string& filename,
   return true;
 }
 
-// Image loading API for multiple files.
+// Image loading API for multiple files.  The decoding work is done by the
+// batched loader, which spreads the files over all cores.
 template<typename eT>
 bool Load(const std::vector<std::string>& files,
           arma::Mat<eT>& matrix,
           ImageInfo& info,
           const bool fatal)
 {
-  if (files.size() == 0)
-  {
-    std::ostringstream oss;
-    oss << "Load(): vector of image files is empty." << std::endl;
-
-    if (fatal)
-      Log::Fatal << oss.str();
-    else
-      Log::Warn << oss.str();
-
-    return false;
-  }
-
-  arma::Mat<unsigned char> img;
-  bool status = LoadImage(files[0], img, info, fatal);
-
-  if (!status)
-    return false;
-
-  // Decide matrix dimension using the image height and width.
-  arma::Mat<unsigned char> tmpMatrix(
-      info.Width() * info.Height() * info.Channels(), files.size());
-  tmpMatrix.col(0) = img;
-
-  for (size_t i = 1; i < files.size() ; i++)
-  {
-    arma::Mat<unsigned char> colImg(tmpMatrix.colptr(i), tmpMatrix.n_rows, 1,
-        false, true);
-    status = LoadImage(files[i], colImg, info, fatal);
-
-    if (!status)
-      return false;
-  }
-
-  matrix = arma::conv_to<arma::Mat<eT>>::from(tmpMatrix);
-  return true;
+  return LoadImages(files, matrix, info, fatal);
 }
 
 } // namespace data
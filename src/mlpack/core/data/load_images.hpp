@@ -0,0 +1,224 @@
+/**
+ * @file core/data/load_images.hpp
+ * @author Mehul Kumar Nirala
+ *
+ * A batched image loader that decodes a listing of image files on all cores,
+ * optionally resizing each image during decode, and writes the pixels
+ * straight into the destination matrix columns.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_DATA_LOAD_IMAGES_HPP
+#define MLPACK_CORE_DATA_LOAD_IMAGES_HPP
+
+#include <mlpack/prereqs.hpp>
+
+#include "binary_columnar.hpp"
+#include "image_info.hpp"
+
+namespace mlpack {
+namespace data {
+
+// Declared in load.hpp and implemented in load_image.cpp.
+bool LoadImage(const std::string& filename,
+               arma::Mat<unsigned char>& matrix,
+               ImageInfo& info,
+               const bool fatal);
+
+namespace details {
+
+/**
+ * Resize an interleaved image buffer with nearest-neighbor sampling.  The
+ * source and destination use the STB pixel layout: row-major with
+ * interleaved channels.
+ *
+ * @param src Source pixel buffer.
+ * @param srcWidth Width of the source image.
+ * @param srcHeight Height of the source image.
+ * @param channels Number of channels of both buffers.
+ * @param dst Destination pixel buffer, of size dstWidth * dstHeight *
+ *     channels.
+ * @param dstWidth Width of the destination image.
+ * @param dstHeight Height of the destination image.
+ */
+inline void ResizeImageNearest(const unsigned char* src,
+                               const size_t srcWidth,
+                               const size_t srcHeight,
+                               const size_t channels,
+                               unsigned char* dst,
+                               const size_t dstWidth,
+                               const size_t dstHeight)
+{
+  for (size_t y = 0; y < dstHeight; ++y)
+  {
+    const size_t srcY = std::min((y * srcHeight) / dstHeight, srcHeight - 1);
+    for (size_t x = 0; x < dstWidth; ++x)
+    {
+      const size_t srcX = std::min((x * srcWidth) / dstWidth, srcWidth - 1);
+      const unsigned char* srcPixel = src +
+          (srcY * srcWidth + srcX) * channels;
+      unsigned char* dstPixel = dst + (y * dstWidth + x) * channels;
+      for (size_t c = 0; c < channels; ++c)
+        dstPixel[c] = srcPixel[c];
+    }
+  }
+}
+
+} // namespace details
+
+/**
+ * Load a listing of image files into the given matrix, one image per column,
+ * decoding the images on all cores.  If a target width and height are given,
+ * every image is resized (nearest-neighbor) during decode, so the listing
+ * may mix image sizes; otherwise every image must match the size of the
+ * first one.
+ *
+ * If a cache file name is given, the assembled matrix is written to it in
+ * the binary columnar format after a successful decode -- and, when the
+ * cache file already exists and holds a matrix of the expected
+ * dimensionality, it is loaded instead of decoding anything, so repeated
+ * runs over the same listing skip the decode entirely.
+ *
+ * @param files Listing of image files to load.
+ * @param matrix Matrix to load the images into, one image per column.
+ * @param info ImageInfo holding the channel count to decode with; the
+ *     dimensions of the loaded images are written back into it.
+ * @param fatal If an error should be reported as fatal (default false).
+ * @param targetWidth If nonzero, resize every image to this width.
+ * @param targetHeight If nonzero, resize every image to this height.
+ * @param cacheFile If nonempty, use this binary columnar file as a decode
+ *     cache.
+ * @return Boolean value indicating success or failure of load.
+ */
+template<typename eT>
+bool LoadImages(const std::vector<std::string>& files,
+                arma::Mat<eT>& matrix,
+                ImageInfo& info,
+                const bool fatal = false,
+                const size_t targetWidth = 0,
+                const size_t targetHeight = 0,
+                const std::string& cacheFile = "")
+{
+  if (files.size() == 0)
+  {
+    if (fatal)
+      Log::Fatal << "LoadImages(): vector of image files is empty."
+          << std::endl;
+    else
+      Log::Warn << "LoadImages(): vector of image files is empty."
+          << std::endl;
+
+    return false;
+  }
+
+  const bool resize = (targetWidth > 0 && targetHeight > 0);
+
+  // Try the decode cache first.
+  if (!cacheFile.empty())
+  {
+    arma::Mat<eT> cached;
+    if (LoadBinaryColumnar(cacheFile, cached) && cached.n_cols == files.size()
+        && (!resize ||
+            cached.n_rows == targetWidth * targetHeight * info.Channels()))
+    {
+      Log::Info << "LoadImages(): using decode cache '" << cacheFile << "'."
+          << std::endl;
+      if (resize)
+      {
+        info.Width() = targetWidth;
+        info.Height() = targetHeight;
+      }
+      matrix = std::move(cached);
+      return true;
+    }
+  }
+
+  // Decode the first image serially to fix the output dimensions.
+  arma::Mat<unsigned char> firstImage;
+  if (!LoadImage(files[0], firstImage, info, fatal))
+    return false;
+
+  const size_t channels = info.Channels();
+  const size_t outWidth = resize ? targetWidth : info.Width();
+  const size_t outHeight = resize ? targetHeight : info.Height();
+  const size_t outRows = outWidth * outHeight * channels;
+
+  arma::Mat<unsigned char> pixels(outRows, files.size());
+  if (resize && (info.Width() != outWidth || info.Height() != outHeight))
+  {
+    details::ResizeImageNearest(firstImage.memptr(), info.Width(),
+        info.Height(), channels, pixels.colptr(0), outWidth, outHeight);
+  }
+  else
+    pixels.col(0) = firstImage;
+
+  // Decode the remaining images on all cores, each thread writing straight
+  // into its destination column.  Failures are only counted here; the
+  // warning (or fatal error) is raised after the parallel region, since
+  // Log::Fatal throws.
+  size_t failures = 0;
+  #pragma omp parallel for schedule(dynamic) reduction(+:failures)
+  for (omp_size_t i = 1; i < (omp_size_t) files.size(); ++i)
+  {
+    arma::Mat<unsigned char> image;
+    ImageInfo localInfo(0, 0, channels);
+    if (!LoadImage(files[i], image, localInfo, false))
+    {
+      ++failures;
+      continue;
+    }
+
+    if (localInfo.Width() == outWidth && localInfo.Height() == outHeight &&
+        localInfo.Channels() == channels)
+    {
+      std::copy(image.begin(), image.end(), pixels.colptr(i));
+    }
+    else if (resize && localInfo.Channels() == channels)
+    {
+      details::ResizeImageNearest(image.memptr(), localInfo.Width(),
+          localInfo.Height(), channels, pixels.colptr(i), outWidth,
+          outHeight);
+    }
+    else
+    {
+      // The image does not match the output size and resizing was not
+      // requested (or the channel count differs).
+      ++failures;
+    }
+  }
+
+  if (failures > 0)
+  {
+    if (fatal)
+      Log::Fatal << "LoadImages(): " << failures << " of " << files.size()
+          << " images could not be loaded." << std::endl;
+    else
+      Log::Warn << "LoadImages(): " << failures << " of " << files.size()
+          << " images could not be loaded." << std::endl;
+
+    return false;
+  }
+
+  info.Width() = outWidth;
+  info.Height() = outHeight;
+
+  matrix = arma::conv_to<arma::Mat<eT>>::from(pixels);
+
+  // Write the decode cache for the next run.
+  if (!cacheFile.empty())
+  {
+    if (!SaveBinaryColumnar(cacheFile, matrix))
+      Log::Warn << "LoadImages(): could not write decode cache '" << cacheFile
+          << "'." << std::endl;
+  }
+
+  return true;
+}
+
+} // namespace data
+} // namespace mlpack
+
+#endif
@@ -18,7 +18,9 @@
 #include <algorithm>
 #include <mlpack/core/util/timers.hpp>
 
+#include "binary_columnar.hpp"
 #include "load_csv.hpp"
+#include "load_numeric_csv.hpp"
 #include "load.hpp"
 #include "extension.hpp"
 
@@ -27,6 +29,8 @@
 #include <boost/algorithm/string.hpp>
 
 #include "load_arff.hpp"
+#include "load_parquet.hpp"
+#include "shared_memory.hpp"
 
 namespace mlpack {
 namespace data {
@@ -92,6 +96,35 @@ bool Load(const std::string& filename,
 {
   Timer::Start("loading_data");
 
+  // A 'shm://' URI names a shared memory segment published by another
+  // process (with data::Save() or SaveSharedMemory()) rather than a file;
+  // attaching it is zero-copy, so all attached processes share one physical
+  // copy of the data.
+  if (filename.substr(0, 6) == "shm://")
+  {
+    Log::Info << "Attaching shared memory dataset '" << filename << "'.  "
+        << std::flush;
+    if (!LoadSharedMemory(filename, matrix))
+    {
+      Log::Info << std::endl;
+      Timer::Stop("loading_data");
+      if (fatal)
+        Log::Fatal << "Cannot attach shared memory dataset '" << filename
+            << "'; it may not be published, or it may hold a different "
+            << "element type." << std::endl;
+      else
+        Log::Warn << "Cannot attach shared memory dataset '" << filename
+            << "'; load failed." << std::endl;
+
+      return false;
+    }
+
+    Log::Info << "Size is " << matrix.n_rows << " x " << matrix.n_cols
+        << ".\n";
+    Timer::Stop("loading_data");
+    return true;
+  }
+
   // Get the extension.
   std::string extension = Extension(filename);
 
@@ -114,6 +147,53 @@ bool Load(const std::string& filename,
     return false;
   }
 
+  // The mlpack binary columnar format stores the matrix in its final
+  // in-memory layout, so loading is a single payload read with no parse and
+  // no transpose; the transpose flag does not apply.
+  if (extension == "mbin")
+  {
+    Log::Info << "Loading '" << filename << "' as binary columnar data.  "
+        << std::flush;
+    if (!LoadBinaryColumnar(filename, matrix))
+    {
+      Log::Info << std::endl;
+      Timer::Stop("loading_data");
+      if (fatal)
+        Log::Fatal << "Loading from '" << filename << "' failed." << std::endl;
+      else
+        Log::Warn << "Loading from '" << filename << "' failed." << std::endl;
+
+      return false;
+    }
+
+    Log::Info << "Size is " << matrix.n_rows << " x " << matrix.n_cols
+        << ".\n";
+    Timer::Stop("loading_data");
+    return true;
+  }
+
+  // Parquet and Arrow IPC files are columnar, so they get dispatched to the
+  // columnar loader, which reads column chunks directly into the matrix.
+  if (extension == "parquet" || extension == "feather" || extension == "arrow")
+  {
+    Log::Info << "Loading '" << filename << "' as "
+        << ((extension == "parquet") ? "Parquet" : "Arrow IPC") << " data.  "
+        << std::flush;
+    if (!LoadParquet(filename, matrix, std::vector<std::string>(), fatal,
+        transpose))
+    {
+      // LoadParquet() has already printed the reason for the failure.
+      Log::Info << std::endl;
+      Timer::Stop("loading_data");
+      return false;
+    }
+
+    Log::Info << "Size is " << matrix.n_rows << " x " << matrix.n_cols
+        << ".\n";
+    Timer::Stop("loading_data");
+    return true;
+  }
+
   bool unknownType = false;
   arma::file_type loadType;
   std::string stringType;
@@ -274,7 +354,20 @@ bool Load(const std::string& filename,
 
   // We can't use the stream if the type is HDF5.
   bool success;
-  if (loadType != arma::hdf5_binary)
+  bool alreadyTransposed = false;
+  if (loadType == arma::csv_ascii || loadType == arma::raw_ascii)
+  {
+    // Parse plain numeric text on all cores; each file row is written
+    // straight into its final position in the matrix, so no transposing copy
+    // is needed afterwards.  Files the fast path cannot handle (non-numeric
+    // tokens, ragged rows) fall back to the Armadillo parser, which also
+    // produces the usual diagnostics.
+    success = LoadNumericCSV(filename, matrix, transpose);
+    alreadyTransposed = success && transpose;
+    if (!success)
+      success = matrix.load(stream, loadType);
+  }
+  else if (loadType != arma::hdf5_binary)
     success = matrix.load(stream, loadType);
   else
     success = matrix.load(filename, loadType);
@@ -290,12 +383,15 @@ bool Load(const std::string& filename,
 
     return false;
   }
+  else if (alreadyTransposed)
+    Log::Info << "Size is " << matrix.n_rows << " x " << matrix.n_cols
+        << ".\n";
   else
     Log::Info << "Size is " << (transpose ? matrix.n_cols : matrix.n_rows)
         << " x " << (transpose ? matrix.n_rows : matrix.n_cols) << ".\n";
 
   // Now transpose the matrix, if necessary.
-  if (transpose)
+  if (transpose && !alreadyTransposed)
   {
     success = inplace_transpose(matrix, fatal);
   }
@@ -16,8 +16,10 @@
 #include "load.hpp"
 
 #include <algorithm>
+#include <sstream>
 #include <mlpack/core/util/timers.hpp>
 
+#include "compression.hpp"
 #include "extension.hpp"
 
 #include <boost/serialization/serialization.hpp>
@@ -47,6 +49,8 @@ bool Load(const std::string& filename,
       f = format::xml;
     else if (extension == "bin")
       f = format::binary;
+    else if (extension == "zbin")
+      f = format::compressed_binary;
     else if (extension == "txt")
       f = format::text;
     else
@@ -65,7 +69,7 @@ bool Load(const std::string& filename,
   // Now load the given format.
   std::ifstream ifs;
 #ifdef _WIN32 // Open non-text in binary mode on Windows.
-  if (f == format::binary)
+  if (f == format::binary || f == format::compressed_binary)
     ifs.open(filename, std::ifstream::in | std::ifstream::binary);
   else
     ifs.open(filename, std::ifstream::in);
@@ -102,6 +106,29 @@ bool Load(const std::string& filename,
       boost::archive::binary_iarchive ar(ifs);
       ar >> boost::serialization::make_nvp(name.c_str(), t);
     }
+    else if (f == format::compressed_binary)
+    {
+      // Decompress the frame into memory (the blocks are decompressed in
+      // parallel), then deserialize from the buffer.
+      std::string payload;
+      if (!ReadCompressedFrame(ifs, payload))
+      {
+        if (fatal)
+          Log::Fatal << "Unable to read compressed model from '" << filename
+              << "'; the file is not a compressed model or is corrupt."
+              << std::endl;
+        else
+          Log::Warn << "Unable to read compressed model from '" << filename
+              << "'; the file is not a compressed model or is corrupt."
+              << std::endl;
+
+        return false;
+      }
+
+      std::istringstream iss(payload, std::ios::binary);
+      boost::archive::binary_iarchive ar(iss);
+      ar >> boost::serialization::make_nvp(name.c_str(), t);
+    }
 
     return true;
   }
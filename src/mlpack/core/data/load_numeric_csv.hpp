@@ -0,0 +1,210 @@
+/**
+ * @file core/data/load_numeric_csv.hpp
+ * @author Ryan Curtin
+ *
+ * A parallel parser for plain numeric CSV and raw ASCII files.  The file is
+ * split on line boundaries and the lines are parsed on all cores, writing
+ * straight into the final matrix memory.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_DATA_LOAD_NUMERIC_CSV_HPP
+#define MLPACK_CORE_DATA_LOAD_NUMERIC_CSV_HPP
+
+#include <mlpack/prereqs.hpp>
+
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+
+namespace mlpack {
+namespace data {
+namespace details {
+
+/**
+ * Parse one line of numeric text into the given output.  Fields are separated
+ * by commas or whitespace; empty fields are read as zero, matching the
+ * Armadillo CSV parser.  Returns false if a field is not numeric or the line
+ * does not hold exactly `fields` values.
+ *
+ * The line must be followed by a character strtod() cannot consume (a
+ * newline or the terminating null byte of the file buffer), so the parse
+ * cannot run past the line end.
+ *
+ * @param begin First character of the line.
+ * @param end Past-the-end character of the line.
+ * @param fields Expected number of fields.
+ * @param output Output location; the values are written with stride `step`.
+ * @param step Stride between two written values.
+ */
+template<typename eT>
+bool ParseNumericLine(const char* begin,
+                      const char* end,
+                      const size_t fields,
+                      eT* output,
+                      const size_t step)
+{
+  const char* pos = begin;
+  for (size_t f = 0; f < fields; ++f)
+  {
+    while (pos != end && (*pos == ' ' || *pos == '\t'))
+      ++pos;
+
+    eT value = eT(0);
+    char* next = const_cast<char*>(pos);
+    if (pos != end && *pos != ',')
+    {
+      value = (eT) std::strtod(pos, &next);
+      if (next == pos)
+        return false; // Not a number.
+    }
+    output[f * step] = value;
+
+    pos = next;
+    while (pos != end && (*pos == ' ' || *pos == '\t'))
+      ++pos;
+
+    if (pos != end && *pos == ',')
+      ++pos;
+    else if (f + 1 < fields && pos == end)
+      return false; // Too few fields on this line.
+  }
+
+  while (pos != end && (*pos == ' ' || *pos == '\t' || *pos == '\r'))
+    ++pos;
+
+  return pos == end; // Anything left over means too many fields.
+}
+
+/**
+ * Count the fields of the given line, using the same rules as
+ * ParseNumericLine(): commas separate fields, and runs of whitespace between
+ * values do too.
+ */
+inline size_t CountFields(const char* begin, const char* end)
+{
+  size_t fields = 0;
+  const char* pos = begin;
+  while (pos != end)
+  {
+    while (pos != end && (*pos == ' ' || *pos == '\t' || *pos == '\r'))
+      ++pos;
+    if (pos == end)
+      break;
+
+    ++fields;
+    while (pos != end && *pos != ',' && *pos != ' ' && *pos != '\t' &&
+        *pos != '\r')
+      ++pos;
+    while (pos != end && (*pos == ' ' || *pos == '\t' || *pos == '\r'))
+      ++pos;
+    if (pos != end && *pos == ',')
+      ++pos;
+  }
+
+  return fields;
+}
+
+} // namespace details
+
+/**
+ * Load a plain numeric CSV (or whitespace-separated ASCII) file into the
+ * given matrix, parsing lines on all cores.  The file is read into memory
+ * once, split on newline boundaries, and every line is converted directly
+ * into its final position in the matrix; when transpose is true each file
+ * row becomes a matrix column, which is contiguous in memory, so no second
+ * transposing copy is made.
+ *
+ * Returns false when the file does not fit the fast path (a non-numeric
+ * token or ragged rows); the caller then falls back to the regular Armadillo
+ * loader, which produces the usual diagnostics.
+ *
+ * @param filename Name of the file to load.
+ * @param matrix Matrix to load the file into.
+ * @param transpose If true, each file row is stored as a matrix column.
+ */
+template<typename eT>
+bool LoadNumericCSV(const std::string& filename,
+                    arma::Mat<eT>& matrix,
+                    const bool transpose)
+{
+  std::ifstream stream(filename.c_str(),
+      std::ifstream::in | std::ifstream::binary);
+  if (!stream.is_open())
+    return false;
+
+  // Read the whole file into one buffer; std::string guarantees a
+  // terminating null byte after the data, which ends the last line's parse.
+  stream.seekg(0, std::ios::end);
+  const std::streampos size = stream.tellg();
+  stream.seekg(0, std::ios::beg);
+  if (size <= 0)
+    return false;
+
+  std::string buffer((size_t) size, '\0');
+  stream.read(&buffer[0], size);
+  if (!stream)
+    return false;
+
+  // Index the non-empty lines so that they can be dealt out to the threads.
+  std::vector<std::pair<const char*, const char*>> lines;
+  const char* pos = buffer.data();
+  const char* const bufferEnd = buffer.data() + buffer.size();
+  while (pos < bufferEnd)
+  {
+    const char* lineEnd = (const char*) std::memchr(pos, '\n',
+        bufferEnd - pos);
+    if (lineEnd == NULL)
+      lineEnd = bufferEnd;
+
+    const char* trimmedEnd = lineEnd;
+    while (trimmedEnd != pos && (*(trimmedEnd - 1) == '\r' ||
+        *(trimmedEnd - 1) == ' ' || *(trimmedEnd - 1) == '\t'))
+      --trimmedEnd;
+    if (trimmedEnd != pos)
+      lines.push_back(std::make_pair(pos, trimmedEnd));
+
+    pos = lineEnd + 1;
+  }
+
+  if (lines.empty())
+    return false;
+
+  const size_t fields = details::CountFields(lines[0].first, lines[0].second);
+  if (fields == 0)
+    return false;
+
+  if (transpose)
+    matrix.set_size(fields, lines.size());
+  else
+    matrix.set_size(lines.size(), fields);
+
+  // Parse the lines on all cores.  When transposing, line i fills column i,
+  // which is contiguous; otherwise line i fills row i with stride n_rows.
+  size_t failures = 0;
+  #pragma omp parallel for schedule(static) reduction(+:failures)
+  for (omp_size_t i = 0; i < (omp_size_t) lines.size(); ++i)
+  {
+    eT* output = transpose ? matrix.colptr(i) : (matrix.memptr() + i);
+    const size_t step = transpose ? 1 : matrix.n_rows;
+    if (!details::ParseNumericLine(lines[i].first, lines[i].second, fields,
+        output, step))
+      ++failures;
+  }
+
+  if (failures > 0)
+  {
+    matrix.reset();
+    return false;
+  }
+
+  return true;
+}
+
+} // namespace data
+} // namespace mlpack
+
+#endif
@@ -0,0 +1,58 @@
+/**
+ * @file core/data/load_parquet.hpp
+ * @author Ryan Curtin
+ *
+ * Load a matrix from an Apache Parquet or Arrow IPC (Feather) file.  This
+ * support is optional; it is only compiled in when mlpack is built against
+ * the Arrow and Parquet libraries (HAS_ARROW).
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_DATA_LOAD_PARQUET_HPP
+#define MLPACK_CORE_DATA_LOAD_PARQUET_HPP
+
+#include <mlpack/prereqs.hpp>
+
+namespace mlpack {
+namespace data {
+
+/**
+ * Load a matrix from a Parquet file (.parquet) or an Arrow IPC / Feather file
+ * (.feather, .arrow).  The source is columnar, so column chunks are read
+ * directly into the matrix with no text parsing.  Each file column is one
+ * dimension, following mlpack's convention: with transpose set to true (the
+ * default used by data::Load()), dimensions are rows of the resulting matrix
+ * and each file row becomes one column (one point).
+ *
+ * A subset of columns may be selected by name via the columns parameter; if
+ * it is empty, every column is loaded.  All loaded columns must have a
+ * numeric type (double, float, or 32-/64-bit integers); null entries are
+ * mapped to NaN.
+ *
+ * If mlpack was compiled without Arrow support, this function always fails.
+ *
+ * @param filename Name of the file to load.
+ * @param matrix Matrix to load data into.
+ * @param columns Names of the columns to load (empty means all columns).
+ * @param fatal If an error should be reported as fatal (default false).
+ * @param transpose If true, dimensions are rows of the output (default true).
+ * @return Boolean value indicating success or failure of load.
+ */
+template<typename eT>
+bool LoadParquet(const std::string& filename,
+                 arma::Mat<eT>& matrix,
+                 const std::vector<std::string>& columns =
+                     std::vector<std::string>(),
+                 const bool fatal = false,
+                 const bool transpose = true);
+
+} // namespace data
+} // namespace mlpack
+
+// Include implementation.
+#include "load_parquet_impl.hpp"
+
+#endif
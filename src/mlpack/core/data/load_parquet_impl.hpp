@@ -0,0 +1,214 @@
+/**
+ * @file core/data/load_parquet_impl.hpp
+ * @author Ryan Curtin
+ *
+ * Implementation of LoadParquet(), for loading matrices from Apache Parquet
+ * and Arrow IPC (Feather) files.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_DATA_LOAD_PARQUET_IMPL_HPP
+#define MLPACK_CORE_DATA_LOAD_PARQUET_IMPL_HPP
+
+#include "load_parquet.hpp"
+#include "extension.hpp"
+
+#ifdef HAS_ARROW
+  #include <arrow/api.h>
+  #include <arrow/io/api.h>
+  #include <arrow/ipc/feather.h>
+  #include <parquet/arrow/reader.h>
+#endif
+
+namespace mlpack {
+namespace data {
+
+namespace details {
+
+//! Report a loading error in the usual way and return false.
+inline bool LoadParquetError(const bool fatal, const std::string& message)
+{
+  if (fatal)
+    Log::Fatal << message << std::endl;
+  else
+    Log::Warn << message << std::endl;
+  return false;
+}
+
+#ifdef HAS_ARROW
+
+/**
+ * Copy one typed Arrow chunk into the matrix, starting at point offset.
+ * Nulls become NaN.  The dimension index is j; with transpose, dimensions are
+ * rows of the matrix.
+ */
+template<typename eT, typename ArrayType>
+void CopyArrowChunk(const ArrayType& chunk,
+                    arma::Mat<eT>& matrix,
+                    const size_t j,
+                    const size_t offset,
+                    const bool transpose)
+{
+  for (int64_t k = 0; k < chunk.length(); ++k)
+  {
+    const eT value = chunk.IsNull(k) ?
+        (eT) std::numeric_limits<double>::quiet_NaN() : (eT) chunk.Value(k);
+    if (transpose)
+      matrix(j, offset + k) = value;
+    else
+      matrix(offset + k, j) = value;
+  }
+}
+
+#endif
+
+} // namespace details
+
+template<typename eT>
+bool LoadParquet(const std::string& filename,
+                 arma::Mat<eT>& matrix,
+                 const std::vector<std::string>& columns,
+                 const bool fatal,
+                 const bool transpose)
+{
+#ifndef HAS_ARROW
+  (void) matrix;
+  (void) columns;
+  (void) transpose;
+  return details::LoadParquetError(fatal, "Cannot load '" + filename +
+      "': mlpack was not compiled with Arrow/Parquet support!");
+#else
+  const std::string extension = Extension(filename);
+
+  auto maybeFile = arrow::io::ReadableFile::Open(filename);
+  if (!maybeFile.ok())
+  {
+    return details::LoadParquetError(fatal, "Cannot open file '" + filename +
+        "': " + maybeFile.status().ToString());
+  }
+  std::shared_ptr<arrow::io::ReadableFile> file = *maybeFile;
+
+  // Read the (possibly column-selected) table.
+  std::shared_ptr<arrow::Table> table;
+  arrow::Status status;
+  if (extension == "parquet")
+  {
+    std::unique_ptr<parquet::arrow::FileReader> reader;
+    status = parquet::arrow::OpenFile(file, arrow::default_memory_pool(),
+        &reader);
+    if (!status.ok())
+    {
+      return details::LoadParquetError(fatal, "Cannot read Parquet file '" +
+          filename + "': " + status.ToString());
+    }
+
+    if (columns.empty())
+    {
+      status = reader->ReadTable(&table);
+    }
+    else
+    {
+      std::shared_ptr<arrow::Schema> schema;
+      status = reader->GetSchema(&schema);
+      if (!status.ok())
+      {
+        return details::LoadParquetError(fatal, "Cannot read schema of '" +
+            filename + "': " + status.ToString());
+      }
+
+      std::vector<int> indices;
+      for (size_t i = 0; i < columns.size(); ++i)
+      {
+        const int index = schema->GetFieldIndex(columns[i]);
+        if (index < 0)
+        {
+          return details::LoadParquetError(fatal, "File '" + filename +
+              "' has no column named '" + columns[i] + "'!");
+        }
+        indices.push_back(index);
+      }
+
+      status = reader->ReadTable(indices, &table);
+    }
+  }
+  else // Arrow IPC / Feather.
+  {
+    auto maybeReader = arrow::ipc::feather::Reader::Open(file);
+    if (!maybeReader.ok())
+    {
+      return details::LoadParquetError(fatal, "Cannot read Arrow IPC file '" +
+          filename + "': " + maybeReader.status().ToString());
+    }
+
+    if (columns.empty())
+      status = (*maybeReader)->Read(&table);
+    else
+      status = (*maybeReader)->Read(columns, &table);
+  }
+
+  if (!status.ok())
+  {
+    return details::LoadParquetError(fatal, "Loading from '" + filename +
+        "' failed: " + status.ToString());
+  }
+
+  // Each file column is one dimension; with transpose, dimensions are rows of
+  // the output matrix, so the matrix is filled in its final layout and no
+  // transpose pass is needed.
+  const size_t cols = (size_t) table->num_columns();
+  const size_t rows = (size_t) table->num_rows();
+  if (transpose)
+    matrix.set_size(cols, rows);
+  else
+    matrix.set_size(rows, cols);
+
+  for (size_t j = 0; j < cols; ++j)
+  {
+    const arrow::ChunkedArray& column = *table->column(j);
+    size_t offset = 0;
+    for (int c = 0; c < column.num_chunks(); ++c)
+    {
+      const std::shared_ptr<arrow::Array>& chunk = column.chunk(c);
+      switch (chunk->type_id())
+      {
+        case arrow::Type::DOUBLE:
+          details::CopyArrowChunk(
+              static_cast<const arrow::DoubleArray&>(*chunk), matrix, j,
+              offset, transpose);
+          break;
+        case arrow::Type::FLOAT:
+          details::CopyArrowChunk(
+              static_cast<const arrow::FloatArray&>(*chunk), matrix, j,
+              offset, transpose);
+          break;
+        case arrow::Type::INT64:
+          details::CopyArrowChunk(
+              static_cast<const arrow::Int64Array&>(*chunk), matrix, j,
+              offset, transpose);
+          break;
+        case arrow::Type::INT32:
+          details::CopyArrowChunk(
+              static_cast<const arrow::Int32Array&>(*chunk), matrix, j,
+              offset, transpose);
+          break;
+        default:
+          return details::LoadParquetError(fatal, "Column '" +
+              table->field(j)->name() + "' of '" + filename + "' has "
+              "non-numeric type '" + chunk->type()->ToString() + "'; only "
+              "double, float, int32, and int64 columns can be loaded!");
+      }
+      offset += (size_t) chunk->length();
+    }
+  }
+
+  return true;
+#endif
+}
+
+} // namespace data
+} // namespace mlpack
+
+#endif
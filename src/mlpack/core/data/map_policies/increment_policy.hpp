@@ -13,6 +13,7 @@
 #define MLPACK_CORE_DATA_MAP_POLICIES_INCREMENT_POLICY_HPP
 
 #include <mlpack/prereqs.hpp>
+#include <cstdlib>
 #include <unordered_map>
 #include <mlpack/core/data/map_policies/datatype.hpp>
 
@@ -62,13 +63,9 @@ class IncrementPolicy
     }
     else
     {
-      // Attempt to convert the input to an output type via a stringstream.
-      std::stringstream token;
-      token << input;
+      // Attempt to convert the input to an output type.
       T val;
-      token >> val;
-
-      if (token.fail() || !token.eof())
+      if (!ToNumber(input, val))
         types[dim] = Datatype::categorical;
     }
   }
@@ -98,12 +95,8 @@ class IncrementPolicy
       // Check if this input needs to be mapped or if it can be read
       // directly as a number.  This will be true if nothing else in this
       // dimension has yet been mapped, but this can't be read as a number.
-      std::stringstream token;
-      token << input;
       T val;
-      token >> val;
-
-      if (!token.fail() && token.eof())
+      if (ToNumber(input, val))
         return val;
 
       // Otherwise, we must map.
@@ -143,6 +136,77 @@ class IncrementPolicy
   }
 
  private:
+  /**
+   * Try to parse a string token as a floating-point number, without the
+   * allocation cost of a stringstream.  The token is only accepted if it
+   * consists entirely of digits, sign, decimal point and exponent characters,
+   * so tokens like "nan", "inf" or hexadecimal literals are rejected just as
+   * stringstream extraction would reject them.  Returns true and fills value
+   * on success.
+   */
+  template<typename T>
+  static typename std::enable_if<std::is_floating_point<T>::value, bool>::type
+  ToNumber(const std::string& token, T& value)
+  {
+    if (token.empty())
+      return false;
+
+    bool hasDigit = false;
+    for (size_t i = 0; i < token.size(); ++i)
+    {
+      const char c = token[i];
+      if (c >= '0' && c <= '9')
+        hasDigit = true;
+      else if (c != '.' && c != '+' && c != '-' && c != 'e' && c != 'E')
+        return false;
+    }
+    if (!hasDigit)
+      return false;
+
+    // std::string::data() is guaranteed to be null-terminated (C++11), so
+    // strtod() cannot run past the end of the token.
+    char* end;
+    const double val = strtod(token.data(), &end);
+    if (end != token.data() + token.size())
+      return false;
+
+    value = T(val);
+    return true;
+  }
+
+  /**
+   * Try to parse a string token as an integer.  Returns true and fills value
+   * on success.
+   */
+  template<typename T>
+  static typename std::enable_if<std::is_integral<T>::value, bool>::type
+  ToNumber(const std::string& token, T& value)
+  {
+    if (token.empty())
+      return false;
+
+    char* end;
+    const long long val = strtoll(token.data(), &end, 10);
+    if (end != token.data() + token.size())
+      return false;
+
+    value = T(val);
+    return true;
+  }
+
+  /**
+   * Fallback for non-string input types: convert via a stringstream, exactly
+   * as older versions of this policy did for all tokens.
+   */
+  template<typename T, typename InputType>
+  static bool ToNumber(const InputType& input, T& value)
+  {
+    std::stringstream token;
+    token << input;
+    token >> value;
+    return (!token.fail() && token.eof());
+  }
+
   // Whether or not we should map all tokens.
   bool forceAllMappings;
 }; // class IncrementPolicy
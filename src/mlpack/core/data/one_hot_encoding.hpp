@@ -32,6 +32,20 @@ template<typename eT, typename RowType>
 void OneHotEncoding(const RowType& labelsIn,
                     arma::Mat<eT>& output);
 
+/**
+ * Overload that produces a sparse binary matrix.  Since the encoding holds
+ * exactly one nonzero element per point, this needs orders of magnitude less
+ * memory than the dense overload when the number of categories is large.  The
+ * matrix is built with a single batch insertion instead of element-wise
+ * writes.
+ *
+ * @param labelsIn Input labels of arbitrary datatype.
+ * @param output Sparse binary matrix.
+ */
+template<typename eT, typename RowType>
+void OneHotEncoding(const RowType& labelsIn,
+                    arma::SpMat<eT>& output);
+
 } // namespace data
 } // namespace mlpack
 
@@ -64,6 +64,56 @@ void OneHotEncoding(const RowType& labelsIn,
   }
   labelMap.clear();
 }
+
+/**
+ * Overload that produces a sparse binary matrix.  See the documentation in
+ * one_hot_encoding.hpp.
+ *
+ * @param labelsIn Input labels of arbitrary datatype.
+ * @param output Sparse binary matrix.
+ */
+template<typename eT, typename RowType>
+void OneHotEncoding(const RowType& labelsIn,
+                    arma::SpMat<eT>& output)
+{
+  arma::Row<size_t> labels;
+  labels.set_size(labelsIn.n_elem);
+
+  // Loop over the input labels, and develop the mapping.  This pass has to be
+  // sequential, since the mapping depends on the order of first appearance.
+  std::unordered_map<eT, size_t> labelMap; // Map for labelsIn to labels.
+  size_t curLabel = 0;
+  for (size_t i = 0; i < labelsIn.n_elem; ++i)
+  {
+    // If labelsIn[i] is already in the map, use the existing label.
+    if (labelMap.count(labelsIn[i]) != 0)
+    {
+      labels[i] = labelMap[labelsIn[i]] - 1;
+    }
+    else
+    {
+      // If labelsIn[i] not there then add it to the map.
+      labelMap[labelsIn[i]] = curLabel + 1;
+      labels[i] = curLabel;
+      ++curLabel;
+    }
+  }
+
+  // Assemble the nonzero coordinates---one per point---and build the matrix
+  // with a single batch insertion, which is far cheaper than element-wise
+  // sp_mat writes.
+  arma::umat locations(2, labelsIn.n_elem);
+  #pragma omp parallel for
+  for (omp_size_t i = 0; i < (omp_size_t) labelsIn.n_elem; ++i)
+  {
+    locations(0, i) = i;
+    locations(1, i) = labels[i];
+  }
+
+  arma::Col<eT> values(labelsIn.n_elem);
+  values.ones();
+  output = arma::SpMat<eT>(locations, values, labelsIn.n_elem, curLabel);
+}
 } // namespace data
 } // namespace mlpack
 
@@ -0,0 +1,206 @@
+/**
+ * @file core/data/save_async.hpp
+ * @author Ryan Curtin
+ *
+ * Asynchronous saving: hand a result matrix to a background writer thread so
+ * that serialization overlaps with further computation, instead of adding a
+ * synchronous write tail after every result.  Used by the query manifest
+ * modes of the CLI programs, where file i's outputs are written while file
+ * i + 1 is being searched.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_DATA_SAVE_ASYNC_HPP
+#define MLPACK_CORE_DATA_SAVE_ASYNC_HPP
+
+#include <mlpack/prereqs.hpp>
+
+#include "save.hpp"
+
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <thread>
+
+namespace mlpack {
+namespace data {
+
+namespace details {
+
+/**
+ * The queue of pending background saves, drained by a single writer thread.
+ * The thread is started when the first job is pushed and exits when the
+ * queue runs dry; a later push starts a new one.  One writer is enough: the
+ * point is to overlap writing with computation, not to parallelize the
+ * writes themselves (which would just contend for the disk).
+ */
+class AsyncSaveQueue
+{
+ public:
+  //! Get the process-wide queue.
+  static AsyncSaveQueue& Get()
+  {
+    static AsyncSaveQueue queue;
+    return queue;
+  }
+
+  //! Push a save job; it returns false if the save failed.
+  void Push(std::function<bool()> job)
+  {
+    std::unique_lock<std::mutex> lock(mutex);
+    jobs.push(std::move(job));
+    ++pending;
+    if (!running)
+    {
+      running = true;
+      std::thread([this]() { this->Run(); }).detach();
+    }
+  }
+
+  //! Block until every pushed job has finished; returns false if any job
+  //! since the last Wait() failed.
+  bool Wait()
+  {
+    std::unique_lock<std::mutex> lock(mutex);
+    done.wait(lock, [this]() { return pending == 0; });
+    const bool result = allSucceeded;
+    allSucceeded = true;
+    return result;
+  }
+
+ private:
+  AsyncSaveQueue() : pending(0), running(false), allSucceeded(true) { }
+
+  //! The writer thread body.
+  void Run()
+  {
+    std::unique_lock<std::mutex> lock(mutex);
+    while (!jobs.empty())
+    {
+      std::function<bool()> job = std::move(jobs.front());
+      jobs.pop();
+
+      // Run the job without holding the lock, so pushes are never blocked on
+      // a write.  Any exception is a failure; it must not escape the thread.
+      lock.unlock();
+      bool ok;
+      try
+      {
+        ok = job();
+      }
+      catch (const std::exception& e)
+      {
+        Log::Warn << "Background save failed: " << e.what() << std::endl;
+        ok = false;
+      }
+      lock.lock();
+
+      if (!ok)
+        allSucceeded = false;
+      --pending;
+      if (pending == 0)
+        done.notify_all();
+    }
+
+    running = false;
+  }
+
+  //! Guards everything below.
+  std::mutex mutex;
+  //! Signaled when the queue drains.
+  std::condition_variable done;
+  //! Jobs not yet started.
+  std::queue<std::function<bool()>> jobs;
+  //! Jobs pushed but not yet finished.
+  size_t pending;
+  //! Whether a writer thread is alive.
+  bool running;
+  //! Whether every job since the last Wait() succeeded.
+  bool allSucceeded;
+};
+
+} // namespace details
+
+/**
+ * Save the given matrix on a background writer thread.  The matrix is moved
+ * into the writer, so this returns immediately and the caller's variable is
+ * left empty; computation can proceed while the write happens.  Failures are
+ * reported by WaitForSaves(), which must be called before the results are
+ * relied upon (and is called by the CLI bindings at program end).
+ *
+ * @param filename Name of the file (or URI) to save to.
+ * @param matrix Matrix to save; consumed by the call.
+ * @param transpose If true, transpose the matrix (so that saving and then
+ *     loading with default options round-trips).
+ */
+template<typename eT>
+void SaveAsync(const std::string& filename,
+               arma::Mat<eT>&& matrix,
+               const bool transpose = true)
+{
+  std::shared_ptr<arma::Mat<eT>> buffer =
+      std::make_shared<arma::Mat<eT>>(std::move(matrix));
+  details::AsyncSaveQueue::Get().Push([filename, buffer, transpose]()
+      { return Save(filename, *buffer, false, transpose); });
+}
+
+/**
+ * Save a copy of the given matrix on a background writer thread.  Prefer the
+ * rvalue overload when the matrix is not needed afterwards, since it avoids
+ * the copy entirely.
+ *
+ * @param filename Name of the file (or URI) to save to.
+ * @param matrix Matrix to save.
+ * @param transpose If true, transpose the matrix.
+ */
+template<typename eT>
+void SaveAsync(const std::string& filename,
+               const arma::Mat<eT>& matrix,
+               const bool transpose = true)
+{
+  SaveAsync(filename, arma::Mat<eT>(matrix), transpose);
+}
+
+/**
+ * Save the given column vector on a background writer thread; the vector is
+ * consumed by the call.  As with the synchronous Save() overload, the vector
+ * is written with one observation per line.
+ *
+ * @param filename Name of the file (or URI) to save to.
+ * @param vec Vector to save; consumed by the call.
+ */
+template<typename eT>
+void SaveAsync(const std::string& filename, arma::Col<eT>&& vec)
+{
+  std::shared_ptr<arma::Col<eT>> buffer =
+      std::make_shared<arma::Col<eT>>(std::move(vec));
+  details::AsyncSaveQueue::Get().Push([filename, buffer]()
+      { return Save(filename, *buffer, false); });
+}
+
+/**
+ * Block until all background saves have finished.  Returns false (or, if
+ * fatal is true, logs a fatal error) if any save since the last call failed;
+ * each failure has already been described by a warning from the writer
+ * thread.
+ *
+ * @param fatal If true, a failed save is a fatal error.
+ * @return false if any background save failed.
+ */
+inline bool WaitForSaves(const bool fatal = false)
+{
+  const bool result = details::AsyncSaveQueue::Get().Wait();
+  if (!result && fatal)
+    Log::Fatal << "A background save failed!" << std::endl;
+  return result;
+}
+
+} // namespace data
+} // namespace mlpack
+
+#endif
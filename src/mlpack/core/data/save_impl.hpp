@@ -14,7 +14,12 @@
 
 // In case it hasn't already been included.
 #include "save.hpp"
+#include "binary_columnar.hpp"
+#include "compression.hpp"
 #include "extension.hpp"
+#include "shared_memory.hpp"
+
+#include <sstream>
 
 #include <boost/serialization/serialization.hpp>
 #include <boost/archive/xml_oarchive.hpp>
@@ -49,6 +54,30 @@ bool Save(const std::string& filename,
 {
   Timer::Start("saving_data");
 
+  // A 'shm://' URI publishes the matrix into a named shared memory segment
+  // instead of a file, so that other processes can attach it zero-copy with
+  // data::Load() and the same URI.
+  if (filename.substr(0, 6) == "shm://")
+  {
+    Log::Info << "Publishing shared memory dataset '" << filename << "'."
+        << std::endl;
+    if (!SaveSharedMemory(filename, matrix))
+    {
+      Timer::Stop("saving_data");
+      if (fatal)
+        Log::Fatal << "Cannot publish shared memory dataset '" << filename
+            << "'." << std::endl;
+      else
+        Log::Warn << "Cannot publish shared memory dataset '" << filename
+            << "'; save failed." << std::endl;
+
+      return false;
+    }
+
+    Timer::Stop("saving_data");
+    return true;
+  }
+
   // First we will try to discriminate by file extension.
   std::string extension = Extension(filename);
   if (extension == "")
@@ -84,6 +113,29 @@ bool Save(const std::string& filename,
     return false;
   }
 
+  // The mlpack binary columnar format stores the matrix in its final
+  // in-memory layout, so saving is one header and one payload write; the
+  // transpose flag does not apply.
+  if (extension == "mbin")
+  {
+    stream.close();
+    Log::Info << "Saving binary columnar data to '" << filename << "'."
+        << std::endl;
+    if (!SaveBinaryColumnar(filename, matrix))
+    {
+      Timer::Stop("saving_data");
+      if (fatal)
+        Log::Fatal << "Save to '" << filename << "' failed." << std::endl;
+      else
+        Log::Warn << "Save to '" << filename << "' failed." << std::endl;
+
+      return false;
+    }
+
+    Timer::Stop("saving_data");
+    return true;
+  }
+
   bool unknownType = false;
   arma::file_type saveType;
   std::string stringType;
@@ -322,16 +374,18 @@ bool Save(const std::string& filename,
       f = format::xml;
     else if (extension == "bin")
       f = format::binary;
+    else if (extension == "zbin")
+      f = format::compressed_binary;
     else if (extension == "txt")
       f = format::text;
     else
     {
       if (fatal)
         Log::Fatal << "Unable to detect type of '" << filename << "'; incorrect"
-            << " extension? (allowed: xml/bin/txt)" << std::endl;
+            << " extension? (allowed: xml/bin/zbin/txt)" << std::endl;
       else
         Log::Warn << "Unable to detect type of '" << filename << "'; save "
-            << "failed.  Incorrect extension? (allowed: xml/bin/txt)"
+            << "failed.  Incorrect extension? (allowed: xml/bin/zbin/txt)"
             << std::endl;
 
       return false;
@@ -341,7 +395,8 @@ bool Save(const std::string& filename,
   // Open the file to save to.
   std::ofstream ofs;
 #ifdef _WIN32
-  if (f == format::binary) // Open non-text types in binary mode on Windows.
+  // Open non-text types in binary mode on Windows.
+  if (f == format::binary || f == format::compressed_binary)
     ofs.open(filename, std::ofstream::out | std::ofstream::binary);
   else
     ofs.open(filename, std::ofstream::out);
@@ -378,6 +433,27 @@ bool Save(const std::string& filename,
       boost::archive::binary_oarchive ar(ofs);
       ar << boost::serialization::make_nvp(name.c_str(), t);
     }
+    else if (f == format::compressed_binary)
+    {
+      // Serialize into memory first, then write the compressed frame.
+      std::ostringstream oss(std::ios::binary);
+      {
+        boost::archive::binary_oarchive ar(oss);
+        ar << boost::serialization::make_nvp(name.c_str(), t);
+      }
+
+      if (!WriteCompressedFrame(ofs, oss.str()))
+      {
+        if (fatal)
+          Log::Fatal << "Unable to write compressed model to '" << filename
+              << "'." << std::endl;
+        else
+          Log::Warn << "Unable to write compressed model to '" << filename
+              << "'." << std::endl;
+
+        return false;
+      }
+    }
 
     return true;
   }
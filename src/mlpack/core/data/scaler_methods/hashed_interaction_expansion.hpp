@@ -0,0 +1,232 @@
+/**
+ * @file core/data/scaler_methods/hashed_interaction_expansion.hpp
+ *
+ * HashedInteractionExpansion class to generate hashed quadratic feature
+ * crosses in a bounded-width sparse representation.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_DATA_HASHED_INTERACTION_EXPANSION_HPP
+#define MLPACK_CORE_DATA_HASHED_INTERACTION_EXPANSION_HPP
+
+#include <mlpack/prereqs.hpp>
+#include <map>
+
+namespace mlpack {
+namespace data {
+
+/**
+ * A preprocessing stage that expands each point with its quadratic feature
+ * crosses, hashed into a fixed number of buckets (the "hashing trick").
+ *
+ * For a point x, every product x_i * x_j (i <= j) is accumulated into bucket
+ * hash(i, j) mod numBuckets, with a hash-derived sign of +/-1 so that
+ * colliding crosses cancel in expectation instead of biasing the bucket.
+ * The output dimensionality is therefore bounded by the bucket count no
+ * matter how many input features there are, and the crosses are generated on
+ * the fly per point -- the full crossed dataset is never materialized.
+ * Optionally (and by default) the original features are kept as the leading
+ * rows of the output.
+ *
+ * The expansion is deterministic, so train and test data transformed with the
+ * same bucket count land in the same buckets; there is nothing to learn in
+ * Fit() beyond recording the input dimensionality for validation.  The output
+ * is sparse, making it a natural input for LogisticRegression or LinearSVM
+ * models templatized on arma::sp_mat.  Hashing is lossy, so there is no
+ * InverseTransform().
+ *
+ * @code
+ * arma::mat input;
+ * Load("train.csv", input);
+ * arma::sp_mat output;
+ *
+ * // Hash all quadratic crosses into 4096 buckets.
+ * HashedInteractionExpansion expansion(4096);
+ * expansion.Fit(input);
+ * expansion.Transform(input, output);
+ * @endcode
+ */
+class HashedInteractionExpansion
+{
+ public:
+  /**
+   * Construct the expansion with the given number of hash buckets.
+   *
+   * @param numBuckets Number of buckets the crosses are hashed into; this
+   *      bounds the width of the crossed part of the output.
+   * @param includeInput If true, the original features are kept as the first
+   *      input.n_rows rows of the output, above the hashed crosses.
+   */
+  HashedInteractionExpansion(const size_t numBuckets = 1 << 15,
+                             const bool includeInput = true) :
+      numBuckets(numBuckets),
+      includeInput(includeInput),
+      dimensionality(0)
+  {
+    if (numBuckets == 0)
+    {
+      throw std::invalid_argument("HashedInteractionExpansion: the number of "
+          "buckets must be positive!");
+    }
+  }
+
+  /**
+   * Fit the expansion to the given dataset.  The expansion itself is
+   * stateless; this only records the dimensionality so that Transform() can
+   * reject mismatched datasets.
+   *
+   * @param input Dataset to fit.
+   */
+  template<typename MatType>
+  void Fit(const MatType& input)
+  {
+    dimensionality = input.n_rows;
+  }
+
+  /**
+   * Expand each point of the dataset with its hashed quadratic crosses.
+   *
+   * @param input Dataset to expand.
+   * @param output Sparse matrix to store the expanded dataset; it will have
+   *      numBuckets rows (plus input.n_rows leading rows holding the original
+   *      features, if the expansion was constructed with includeInput true).
+   */
+  template<typename MatType>
+  void Transform(const MatType& input, arma::sp_mat& output)
+  {
+    if (dimensionality == 0)
+    {
+      throw std::runtime_error("Call Fit() before Transform(), please"
+          " refer to the documentation.");
+    }
+
+    if (input.n_rows != dimensionality)
+    {
+      std::ostringstream oss;
+      oss << "HashedInteractionExpansion::Transform(): input dataset has "
+          << input.n_rows << " dimensions, but the expansion was fit on "
+          << dimensionality << " dimensions!";
+      throw std::invalid_argument(oss.str());
+    }
+
+    const size_t offset = includeInput ? input.n_rows : 0;
+
+    // The crosses of one column are accumulated in an ordered map (so bucket
+    // collisions within a point sum up, and the rows come out sorted), then
+    // appended to the batch-constructor inputs.  Only a single column's
+    // crosses are live at a time, so the working set stays cache-resident no
+    // matter how large the dataset is.
+    std::vector<arma::uword> rowIndices, colIndices;
+    std::vector<double> entryValues;
+    std::map<arma::uword, double> colEntries;
+    for (size_t col = 0; col < input.n_cols; ++col)
+    {
+      colEntries.clear();
+
+      if (includeInput)
+      {
+        for (size_t row = 0; row < input.n_rows; ++row)
+        {
+          const double value = input(row, col);
+          if (value != 0.0)
+            colEntries[(arma::uword) row] = value;
+        }
+      }
+
+      for (size_t i = 0; i < input.n_rows; ++i)
+      {
+        const double valueI = input(i, col);
+        if (valueI == 0.0)
+          continue;
+
+        for (size_t j = i; j < input.n_rows; ++j)
+        {
+          const double valueJ = input(j, col);
+          if (valueJ == 0.0)
+            continue;
+
+          // The bucket comes from the low hash bits (the modulus) and the
+          // sign from the top bit, so they are not correlated.
+          const uint64_t hash = HashPair(i, j);
+          const double sign = (hash >> 63) ? -1.0 : 1.0;
+          const arma::uword bucket = offset +
+              ((hash & 0x7FFFFFFFFFFFFFFFULL) % numBuckets);
+
+          colEntries[bucket] += sign * valueI * valueJ;
+        }
+      }
+
+      for (std::map<arma::uword, double>::const_iterator it =
+          colEntries.begin(); it != colEntries.end(); ++it)
+      {
+        rowIndices.push_back(it->first);
+        colIndices.push_back((arma::uword) col);
+        entryValues.push_back(it->second);
+      }
+    }
+
+    // Assemble the output with the batch constructor; the locations are
+    // already in column-major order, and collisions may have cancelled to
+    // exact zeros, so let the constructor strip those.
+    arma::umat locations(2, rowIndices.size());
+    arma::vec values(rowIndices.size());
+    for (size_t index = 0; index < rowIndices.size(); ++index)
+    {
+      locations(0, index) = rowIndices[index];
+      locations(1, index) = colIndices[index];
+      values(index) = entryValues[index];
+    }
+
+    output = arma::sp_mat(locations, values, offset + numBuckets,
+        input.n_cols, false);
+  }
+
+  //! Get the number of hash buckets.
+  size_t NumBuckets() const { return numBuckets; }
+
+  //! Get whether the original features are kept in the output.
+  bool IncludeInput() const { return includeInput; }
+
+  //! Get the dimensionality the expansion was fit on (0 if not fitted).
+  size_t Dimensionality() const { return dimensionality; }
+
+  template<typename Archive>
+  void serialize(Archive& ar, const unsigned int /* version */)
+  {
+    ar & BOOST_SERIALIZATION_NVP(numBuckets);
+    ar & BOOST_SERIALIZATION_NVP(includeInput);
+    ar & BOOST_SERIALIZATION_NVP(dimensionality);
+  }
+
+ private:
+  /**
+   * Mix a feature index pair into a well-distributed hash (a SplitMix64-style
+   * finalizer).  Deterministic across runs, so train and test data always
+   * agree on bucket assignments.
+   */
+  static uint64_t HashPair(const size_t i, const size_t j)
+  {
+    uint64_t hash = (uint64_t(i) << 32) ^ uint64_t(j);
+    hash ^= hash >> 30;
+    hash *= 0xBF58476D1CE4E5B9ULL;
+    hash ^= hash >> 27;
+    hash *= 0x94D049BB133111EBULL;
+    hash ^= hash >> 31;
+    return hash;
+  }
+
+  //! Number of buckets the crosses are hashed into.
+  size_t numBuckets;
+  //! Whether the original features are kept in the output.
+  bool includeInput;
+  //! Dimensionality of the dataset the expansion was fit on.
+  size_t dimensionality;
+};
+
+} // namespace data
+} // namespace mlpack
+
+#endif
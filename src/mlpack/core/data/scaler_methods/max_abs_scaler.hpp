@@ -54,8 +54,35 @@ class MaxAbsScaler
   template<typename MatType>
   void Fit(const MatType& input)
   {
-    itemMin = arma::min(input, 1);
-    itemMax = arma::max(input, 1);
+    itemMin.reset();
+    itemMax.reset();
+    PartialFit(input);
+  }
+
+  /**
+   * Incrementally fit the scaler on one chunk of the dataset.  The running
+   * minimum and maximum are updated, so fitting chunk by chunk gives the same
+   * scaling as a single Fit() on the concatenated dataset.
+   *
+   * @param input Chunk of the dataset to fit.
+   */
+  template<typename MatType>
+  void PartialFit(const MatType& input)
+  {
+    if (input.n_cols == 0)
+      return;
+
+    if (itemMin.is_empty())
+    {
+      itemMin = arma::min(input, 1);
+      itemMax = arma::max(input, 1);
+    }
+    else
+    {
+      itemMin = arma::min(itemMin, arma::vec(arma::min(input, 1)));
+      itemMax = arma::max(itemMax, arma::vec(arma::max(input, 1)));
+    }
+
     scale = arma::max(arma::abs(itemMin), arma::abs(itemMax));
     // Handling zeros in scale vector.
     scale.for_each([](arma::vec::elem_type& val) { val =
@@ -80,6 +107,56 @@ class MaxAbsScaler
     output = input.each_col() / scale;
   }
 
+  /**
+   * Function to scale features in place, without an output copy.
+   *
+   * @param inputOutput Dataset to scale; overwritten with the scaled features.
+   */
+  template<typename MatType>
+  void Transform(MatType& inputOutput)
+  {
+    if (scale.is_empty())
+    {
+      throw std::runtime_error("Call Fit() before Transform(), please"
+        " refer to the documentation.");
+    }
+    inputOutput.each_col() /= scale;
+  }
+
+  /**
+   * Function to scale the features of a sparse dataset.  Scaling by a
+   * per-feature factor maps zeros to zeros, so only the stored nonzero
+   * entries are touched and the output stays sparse.
+   *
+   * @param input Dataset to scale features.
+   * @param output Output matrix with scaled features.
+   */
+  template<typename T>
+  void Transform(const arma::SpMat<T>& input, arma::SpMat<T>& output)
+  {
+    output = input;
+    Transform(output);
+  }
+
+  /**
+   * Function to scale the features of a sparse dataset in place, touching
+   * only the stored nonzero entries.
+   *
+   * @param inputOutput Dataset to scale; overwritten with the scaled features.
+   */
+  template<typename T>
+  void Transform(arma::SpMat<T>& inputOutput)
+  {
+    if (scale.is_empty())
+    {
+      throw std::runtime_error("Call Fit() before Transform(), please"
+        " refer to the documentation.");
+    }
+    for (typename arma::SpMat<T>::iterator it = inputOutput.begin();
+        it != inputOutput.end(); ++it)
+      (*it) = (*it) / scale[it.row()];
+  }
+
   /**
    * Function to retrieve original dataset.
    *
@@ -93,6 +170,22 @@ class MaxAbsScaler
     output = input.each_col() % scale;
   }
 
+  /**
+   * Function to retrieve the original sparse dataset, touching only the
+   * stored nonzero entries.
+   *
+   * @param input Scaled dataset.
+   * @param output Output matrix with original Dataset.
+   */
+  template<typename T>
+  void InverseTransform(const arma::SpMat<T>& input, arma::SpMat<T>& output)
+  {
+    output = input;
+    for (typename arma::SpMat<T>::iterator it = output.begin();
+        it != output.end(); ++it)
+      (*it) = (*it) * scale[it.row()];
+  }
+
   //! Get the Min row vector.
   const arma::vec& ItemMin() const { return itemMin; }
   //! Get the Max row vector.
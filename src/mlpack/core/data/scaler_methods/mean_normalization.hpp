@@ -54,9 +54,42 @@ class MeanNormalization
   template<typename MatType>
   void Fit(const MatType& input)
   {
-    itemMean = arma::mean(input, 1);
-    itemMin = arma::min(input, 1);
-    itemMax = arma::max(input, 1);
+    count = 0;
+    itemMin.reset();
+    itemMax.reset();
+    PartialFit(input);
+  }
+
+  /**
+   * Incrementally fit the scaler on one chunk of the dataset.  The running
+   * mean, minimum and maximum are updated, so fitting chunk by chunk gives
+   * the same scaling as a single Fit() on the concatenated dataset.
+   *
+   * @param input Chunk of the dataset to fit.
+   */
+  template<typename MatType>
+  void PartialFit(const MatType& input)
+  {
+    const size_t batchCount = input.n_cols;
+    if (batchCount == 0)
+      return;
+
+    const arma::vec batchMean = arma::mean(input, 1);
+    if (count == 0)
+    {
+      itemMean = batchMean;
+      itemMin = arma::min(input, 1);
+      itemMax = arma::max(input, 1);
+    }
+    else
+    {
+      itemMean += (batchMean - itemMean) *
+          ((double) batchCount / (count + batchCount));
+      itemMin = arma::min(itemMin, arma::vec(arma::min(input, 1)));
+      itemMax = arma::max(itemMax, arma::vec(arma::max(input, 1)));
+    }
+    count += batchCount;
+
     scale = itemMax - itemMin;
     // Handling zeros in scale vector.
     scale.for_each([](arma::vec::elem_type& val) { val =
@@ -81,6 +114,23 @@ class MeanNormalization
     output = (input.each_col() - itemMean).each_col() / scale;
   }
 
+  /**
+   * Function to scale features in place, without an output copy.
+   *
+   * @param inputOutput Dataset to scale; overwritten with the scaled features.
+   */
+  template<typename MatType>
+  void Transform(MatType& inputOutput)
+  {
+    if (itemMean.is_empty() || scale.is_empty())
+    {
+      throw std::runtime_error("Call Fit() before Transform(), please"
+        " refer to the documentation.");
+    }
+    inputOutput.each_col() -= itemMean;
+    inputOutput.each_col() /= scale;
+  }
+
   /**
    * Function to retrieve original dataset.
    *
@@ -110,11 +160,14 @@ class MeanNormalization
     ar & BOOST_SERIALIZATION_NVP(itemMax);
     ar & BOOST_SERIALIZATION_NVP(scale);
     ar & BOOST_SERIALIZATION_NVP(itemMean);
+    ar & BOOST_SERIALIZATION_NVP(count);
   }
 
  private:
   // Vector which holds mean of each feature.
   arma::vec itemMean;
+  // Number of points seen so far by PartialFit().
+  size_t count = 0;
   // Vector which holds minimum of each feature.
   arma::vec itemMin;
   // Vector which holds maximum of each feature.
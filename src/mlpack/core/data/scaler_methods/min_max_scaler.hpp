@@ -73,8 +73,35 @@ class MinMaxScaler
   template<typename MatType>
   void Fit(const MatType& input)
   {
-    itemMin = arma::min(input, 1);
-    itemMax = arma::max(input, 1);
+    itemMin.reset();
+    itemMax.reset();
+    PartialFit(input);
+  }
+
+  /**
+   * Incrementally fit the scaler on one chunk of the dataset.  The running
+   * minimum and maximum are updated, so fitting chunk by chunk gives the same
+   * scaling as a single Fit() on the concatenated dataset.
+   *
+   * @param input Chunk of the dataset to fit.
+   */
+  template<typename MatType>
+  void PartialFit(const MatType& input)
+  {
+    if (input.n_cols == 0)
+      return;
+
+    if (itemMin.is_empty())
+    {
+      itemMin = arma::min(input, 1);
+      itemMax = arma::max(input, 1);
+    }
+    else
+    {
+      itemMin = arma::min(itemMin, arma::vec(arma::min(input, 1)));
+      itemMax = arma::max(itemMax, arma::vec(arma::max(input, 1)));
+    }
+
     scale = itemMax - itemMin;
     // Handle zeros in scale vector.
     scale.for_each([](arma::vec::elem_type& val) { val =
@@ -103,6 +130,23 @@ class MinMaxScaler
     output = (input.each_col() % scale).each_col() + scalerowmin;
   }
 
+  /**
+   * Function to scale features in place, without an output copy.
+   *
+   * @param inputOutput Dataset to scale; overwritten with the scaled features.
+   */
+  template<typename MatType>
+  void Transform(MatType& inputOutput)
+  {
+    if (scalerowmin.is_empty() || scale.is_empty())
+    {
+      throw std::runtime_error("Call Fit() before Transform(), please"
+          " refer to the documentation.");
+    }
+    inputOutput.each_col() %= scale;
+    inputOutput.each_col() += scalerowmin;
+  }
+
   /**
    * Function to retrieve original dataset.
    *
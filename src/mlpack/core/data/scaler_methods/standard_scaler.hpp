@@ -55,8 +55,46 @@ class StandardScaler
   template<typename MatType>
   void Fit(const MatType& input)
   {
-    itemMean = arma::mean(input, 1);
-    itemStdDev = arma::stddev(input, 1, 1);
+    count = 0;
+    itemMean.reset();
+    runningM2.reset();
+    PartialFit(input);
+  }
+
+  /**
+   * Incrementally fit the scaler on one chunk of the dataset.  The running
+   * moments are combined with Chan's parallel variance update, so fitting
+   * chunk by chunk gives the same mean and standard deviation as a single
+   * Fit() on the concatenated dataset.
+   *
+   * @param input Chunk of the dataset to fit.
+   */
+  template<typename MatType>
+  void PartialFit(const MatType& input)
+  {
+    const size_t batchCount = input.n_cols;
+    if (batchCount == 0)
+      return;
+
+    const arma::vec batchMean = arma::mean(input, 1);
+    // Sum of squared deviations from the chunk mean.
+    const arma::vec batchM2 = arma::var(input, 1, 1) * batchCount;
+
+    if (count == 0)
+    {
+      itemMean = batchMean;
+      runningM2 = batchM2;
+    }
+    else
+    {
+      const arma::vec delta = batchMean - itemMean;
+      itemMean += delta * ((double) batchCount / (count + batchCount));
+      runningM2 += batchM2 + (delta % delta) *
+          ((double) count * batchCount / (count + batchCount));
+    }
+    count += batchCount;
+
+    itemStdDev = arma::sqrt(runningM2 / count);
     // Handle zeros in scale vector.
     itemStdDev.for_each([](arma::vec::elem_type& val) { val =
         (val == 0) ? 1 : val; });
@@ -80,6 +118,23 @@ class StandardScaler
     output = (input.each_col() - itemMean).each_col() / itemStdDev;
   }
 
+  /**
+   * Function to scale features in place, without an output copy.
+   *
+   * @param inputOutput Dataset to scale; overwritten with the scaled features.
+   */
+  template<typename MatType>
+  void Transform(MatType& inputOutput)
+  {
+    if (itemMean.is_empty() || itemStdDev.is_empty())
+    {
+      throw std::runtime_error("Call Fit() before Transform(), please"
+        " refer to the documentation.");
+    }
+    inputOutput.each_col() -= itemMean;
+    inputOutput.each_col() /= itemStdDev;
+  }
+
   /**
    * Function to retrieve original dataset.
    *
@@ -103,6 +158,8 @@ class StandardScaler
   {
     ar & BOOST_SERIALIZATION_NVP(itemMean);
     ar & BOOST_SERIALIZATION_NVP(itemStdDev);
+    ar & BOOST_SERIALIZATION_NVP(count);
+    ar & BOOST_SERIALIZATION_NVP(runningM2);
   }
 
  private:
@@ -110,6 +167,10 @@ class StandardScaler
   arma::vec itemMean;
   // Vector which holds standard devation of each feature.
   arma::vec itemStdDev;
+  // Number of points seen so far by PartialFit().
+  size_t count = 0;
+  // Running sum of squared deviations of each feature.
+  arma::vec runningM2;
 }; // class StandardScaler
 
 } // namespace data
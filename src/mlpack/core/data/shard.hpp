@@ -0,0 +1,89 @@
+/**
+ * @file core/data/shard.hpp
+ * @author Ryan Curtin
+ *
+ * Deterministic column sharding for data-parallel training.  Each worker in a
+ * data-parallel job (one MPI rank, one process, one machine) takes one
+ * contiguous column shard of the dataset, trains on it, and the per-shard
+ * results are reduced with the merge operations the individual methods
+ * provide (e.g. RandomForest::Merge() or NaiveKMeans::IterateStatistics()).
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_DATA_SHARD_HPP
+#define MLPACK_CORE_DATA_SHARD_HPP
+
+#include <mlpack/prereqs.hpp>
+
+namespace mlpack {
+namespace data {
+
+/**
+ * Compute the contiguous column range [begin, begin + count) that the given
+ * worker owns when totalColumns columns are divided over numWorkers workers.
+ * The decomposition is the same one OpenMP static scheduling and
+ * FirstTouchPlacement() use, so every layer of the stack agrees on which
+ * points belong to which worker.  The last shards may be one column smaller
+ * than the first when the division is not exact; a worker id at or past
+ * numWorkers gets an empty range.
+ *
+ * @param totalColumns Number of columns (points) in the full dataset.
+ * @param workerId Id of this worker, in [0, numWorkers).
+ * @param numWorkers Total number of workers.
+ * @param begin Output first column of the shard.
+ * @param count Output number of columns in the shard.
+ */
+inline void ShardBounds(const size_t totalColumns,
+                        const size_t workerId,
+                        const size_t numWorkers,
+                        size_t& begin,
+                        size_t& count)
+{
+  if (numWorkers == 0 || workerId >= numWorkers)
+  {
+    begin = totalColumns;
+    count = 0;
+    return;
+  }
+
+  begin = (workerId * totalColumns) / numWorkers;
+  count = ((workerId + 1) * totalColumns) / numWorkers - begin;
+}
+
+/**
+ * Extract the column shard of the given dataset that the given worker owns.
+ * The shard is a copy, so the worker can release the full dataset after
+ * sharding.  An empty shard (more workers than columns, or an out-of-range
+ * worker id) yields a matrix with zero columns.
+ *
+ * This works for data matrices and for label rows alike, so a labeled
+ * dataset is sharded consistently by calling it on both with the same worker
+ * id.
+ *
+ * @param input Full dataset (or label row).
+ * @param workerId Id of this worker, in [0, numWorkers).
+ * @param numWorkers Total number of workers.
+ * @param shard Output matrix to store the shard in.
+ */
+template<typename MatType>
+void ShardColumns(const MatType& input,
+                  const size_t workerId,
+                  const size_t numWorkers,
+                  MatType& shard)
+{
+  size_t begin, count;
+  ShardBounds(input.n_cols, workerId, numWorkers, begin, count);
+
+  if (count == 0)
+    shard.set_size(input.n_rows, 0);
+  else
+    shard = input.cols(begin, begin + count - 1);
+}
+
+} // namespace data
+} // namespace mlpack
+
+#endif
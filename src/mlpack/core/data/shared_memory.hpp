@@ -0,0 +1,211 @@
+/**
+ * @file core/data/shared_memory.hpp
+ * @author Ryan Curtin
+ *
+ * Shared-memory datasets: one process publishes a loaded matrix into a named
+ * POSIX shared memory segment, and any number of other processes attach it
+ * read-only without copying, so a fleet of processes working on the same
+ * reference data holds only one copy of it in physical memory.
+ *
+ * data::Load() and data::Save() accept 'shm://name' URIs and dispatch here.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_DATA_SHARED_MEMORY_HPP
+#define MLPACK_CORE_DATA_SHARED_MEMORY_HPP
+
+#include <mlpack/prereqs.hpp>
+
+// The segment reuses the binary columnar header, so the payload layout is
+// identical to a memory-mapped .mbin file.
+#include "binary_columnar.hpp"
+
+#include <cstring>
+
+#ifndef _WIN32
+  #include <fcntl.h>
+  #include <sys/mman.h>
+  #include <sys/stat.h>
+  #include <unistd.h>
+#endif
+
+namespace mlpack {
+namespace data {
+
+namespace details {
+
+/**
+ * Turn a user-facing segment name (with or without the 'shm://' prefix) into
+ * a POSIX shared memory object name.  The name is prefixed with 'mlpack.' so
+ * that mlpack segments are recognizable in /dev/shm and do not collide with
+ * other users of the namespace.
+ */
+inline std::string SharedMemoryObjectName(const std::string& name)
+{
+  std::string stripped = name;
+  if (stripped.substr(0, 6) == "shm://")
+    stripped = stripped.substr(6);
+  return "/mlpack." + stripped;
+}
+
+} // namespace details
+
+/**
+ * Publish the given matrix into a named shared memory segment, creating the
+ * segment (or replacing its previous contents) as needed.  The payload is
+ * the matrix exactly as it sits in memory (column-major), preceded by a
+ * binary columnar header, so attaching is zero-copy.
+ *
+ * The segment persists until RemoveSharedMemory() is called (or the system
+ * is rebooted), even after the publishing process exits.
+ *
+ * On platforms without POSIX shared memory this always fails.
+ *
+ * @param name Name of the segment ('shm://' prefix optional).
+ * @param matrix Matrix to publish.
+ * @return false on failure.
+ */
+template<typename eT>
+bool SaveSharedMemory(const std::string& name, const arma::Mat<eT>& matrix)
+{
+#ifndef _WIN32
+  const std::string shmName = details::SharedMemoryObjectName(name);
+
+  const int fd = shm_open(shmName.c_str(), O_CREAT | O_RDWR, 0600);
+  if (fd < 0)
+    return false;
+
+  const size_t length = (size_t) details::BinaryColumnarDataOffset +
+      matrix.n_elem * sizeof(eT);
+  if (ftruncate(fd, (off_t) length) != 0)
+  {
+    close(fd);
+    shm_unlink(shmName.c_str());
+    return false;
+  }
+
+  void* mapping = mmap(NULL, length, PROT_READ | PROT_WRITE, MAP_SHARED, fd,
+      0);
+  close(fd); // The mapping keeps its own reference.
+  if (mapping == MAP_FAILED)
+  {
+    shm_unlink(shmName.c_str());
+    return false;
+  }
+
+  details::BinaryColumnarHeader header;
+  std::memset(&header, 0, sizeof(header));
+  std::memcpy(header.magic, details::BinaryColumnarMagic,
+      sizeof(details::BinaryColumnarMagic));
+  header.typeCode = details::BinaryColumnarTypeCode<eT>();
+  header.elemSize = sizeof(eT);
+  header.rows = matrix.n_rows;
+  header.cols = matrix.n_cols;
+  header.dataOffset = details::BinaryColumnarDataOffset;
+
+  std::memcpy(mapping, &header, sizeof(header));
+  std::memcpy((char*) mapping + header.dataOffset, matrix.memptr(),
+      matrix.n_elem * sizeof(eT));
+
+  munmap(mapping, length);
+  return true;
+#else
+  (void) name;
+  (void) matrix;
+  return false;
+#endif
+}
+
+/**
+ * Attach a published shared memory segment and wrap its payload in the given
+ * matrix without copying, so all attached processes share one set of
+ * physical pages.  The mapping is copy-on-write: the matrix may be modified
+ * locally, but only the touched pages are duplicated and the published
+ * segment is never altered.
+ *
+ * The mapping intentionally lives for the rest of the process, since the
+ * matrix (and anything it was moved into) may alias it at any later point.
+ *
+ * Returns false if the segment does not exist or was published with a
+ * different element type; on platforms without POSIX shared memory this
+ * always fails.
+ *
+ * @param name Name of the segment ('shm://' prefix optional).
+ * @param matrix Matrix to wrap around the payload.
+ * @return false on failure.
+ */
+template<typename eT>
+bool LoadSharedMemory(const std::string& name, arma::Mat<eT>& matrix)
+{
+#ifndef _WIN32
+  const std::string shmName = details::SharedMemoryObjectName(name);
+
+  const int fd = shm_open(shmName.c_str(), O_RDONLY, 0);
+  if (fd < 0)
+    return false;
+
+  struct stat info;
+  if (fstat(fd, &info) != 0)
+  {
+    close(fd);
+    return false;
+  }
+
+  details::BinaryColumnarHeader header;
+  if (read(fd, &header, sizeof(header)) != (ssize_t) sizeof(header) ||
+      !details::CheckBinaryColumnarHeader<eT>(header) ||
+      (uint64_t) info.st_size <
+          header.dataOffset + header.rows * header.cols * sizeof(eT))
+  {
+    close(fd);
+    return false;
+  }
+
+  const size_t length = (size_t) info.st_size;
+  void* mapping = mmap(NULL, length, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd,
+      0);
+  close(fd); // The mapping keeps its own reference.
+  if (mapping == MAP_FAILED)
+    return false;
+
+  // Wrap the payload without copying.  The alias is marked as borrowed
+  // memory so that the move below transfers the pointer into the output
+  // matrix instead of copying the payload, and so that Armadillo never
+  // tries to free the mapping.
+  arma::Mat<eT> alias((eT*) ((char*) mapping + header.dataOffset),
+      header.rows, header.cols, false, false);
+  arma::access::rw(alias.mem_state) = 1;
+  matrix = std::move(alias);
+
+  return true;
+#else
+  (void) name;
+  (void) matrix;
+  return false;
+#endif
+}
+
+/**
+ * Remove a published shared memory segment.  Processes that have already
+ * attached it keep their mappings; new attachments will fail.
+ *
+ * @param name Name of the segment ('shm://' prefix optional).
+ * @return false if the segment did not exist or could not be removed.
+ */
+inline bool RemoveSharedMemory(const std::string& name)
+{
+#ifndef _WIN32
+  return shm_unlink(details::SharedMemoryObjectName(name).c_str()) == 0;
+#else
+  (void) name;
+  return false;
+#endif
+}
+
+} // namespace data
+} // namespace mlpack
+
+#endif
@@ -14,6 +14,7 @@
 #define MLPACK_CORE_DATA_SPLIT_DATA_HPP
 
 #include <mlpack/prereqs.hpp>
+#include <map>
 
 namespace mlpack {
 namespace data {
@@ -224,6 +225,410 @@ Split(const arma::Mat<T>& input,
                          std::move(testData));
 }
 
+/**
+ * Copy the given columns of a sparse matrix into a new sparse matrix, in the
+ * given order.  Sparse matrices do not support submatrix views of arbitrary
+ * column sets, so the output is assembled with batch insertion; only the
+ * nonzero entries of the selected columns are ever copied.
+ *
+ * @param input Sparse matrix to select columns from.
+ * @param columns Indices of the columns to copy, in output order.
+ * @param output Sparse matrix to store the selected columns into.
+ */
+template<typename T>
+void ExtractColumns(const arma::SpMat<T>& input,
+                    const arma::uvec& columns,
+                    arma::SpMat<T>& output)
+{
+  // Count the nonzeros of the selected columns, so the batch insertion
+  // buffers can be allocated in one shot.
+  size_t nonzeros = 0;
+  for (size_t i = 0; i < columns.n_elem; ++i)
+    nonzeros += input.col_ptrs[columns[i] + 1] - input.col_ptrs[columns[i]];
+
+  arma::umat locations(2, nonzeros);
+  arma::Col<T> values(nonzeros);
+  size_t index = 0;
+  for (size_t i = 0; i < columns.n_elem; ++i)
+  {
+    for (typename arma::SpMat<T>::const_col_iterator it =
+        input.begin_col(columns[i]); it != input.end_col(columns[i]); ++it)
+    {
+      locations(0, index) = it.row();
+      locations(1, index) = i;
+      values[index] = *it;
+      ++index;
+    }
+  }
+
+  // The locations are already sorted in column-major order.
+  output = arma::SpMat<T>(locations, values, input.n_rows, columns.n_elem,
+      false);
+}
+
+/**
+ * Given a sparse input dataset and labels, split into a training set and test
+ * set.  This behaves like the dense overload above, but never builds a dense
+ * copy of the data: the training and test sets are assembled from the nonzero
+ * entries only, so memory usage tracks the number of nonzeros.
+ *
+ * @param input Input dataset to split.
+ * @param inputLabel Input labels to split.
+ * @param trainData Matrix to store training data into.
+ * @param testData Matrix to store test data into.
+ * @param trainLabel Vector to store training labels into.
+ * @param testLabel Vector to store test labels into.
+ * @param testRatio Percentage of dataset to use for test set (between 0 and 1).
+ * @param shuffleData If true, the sample order is shuffled; otherwise, each
+ *       sample is visited in linear order. (Default true.)
+ */
+template<typename T, typename U>
+void Split(const arma::SpMat<T>& input,
+           const arma::Row<U>& inputLabel,
+           arma::SpMat<T>& trainData,
+           arma::SpMat<T>& testData,
+           arma::Row<U>& trainLabel,
+           arma::Row<U>& testLabel,
+           const double testRatio,
+           const bool shuffleData = true)
+{
+  const size_t testSize = static_cast<size_t>(input.n_cols * testRatio);
+  const size_t trainSize = input.n_cols - testSize;
+
+  arma::uvec order = arma::linspace<arma::uvec>(0, input.n_cols - 1,
+      input.n_cols);
+  if (shuffleData)
+    order = arma::shuffle(order);
+
+  if (trainSize > 0)
+  {
+    ExtractColumns(input, arma::uvec(order.subvec(0, trainSize - 1)),
+        trainData);
+    trainLabel = inputLabel.cols(order.subvec(0, trainSize - 1));
+  }
+  else
+  {
+    trainData.set_size(input.n_rows, 0);
+    trainLabel.set_size(0);
+  }
+
+  if (trainSize < input.n_cols)
+  {
+    ExtractColumns(input,
+        arma::uvec(order.subvec(trainSize, input.n_cols - 1)), testData);
+    testLabel = inputLabel.cols(order.subvec(trainSize, input.n_cols - 1));
+  }
+  else
+  {
+    testData.set_size(input.n_rows, 0);
+    testLabel.set_size(0);
+  }
+}
+
+/**
+ * Given a sparse input dataset, split into a training set and test set
+ * without ever building a dense copy of the data.  See the labeled sparse
+ * overload above for details.
+ *
+ * @param input Input dataset to split.
+ * @param trainData Matrix to store training data into.
+ * @param testData Matrix to store test data into.
+ * @param testRatio Percentage of dataset to use for test set (between 0 and 1).
+ * @param shuffleData If true, the sample order is shuffled; otherwise, each
+ *       sample is visited in linear order. (Default true.)
+ */
+template<typename T>
+void Split(const arma::SpMat<T>& input,
+           arma::SpMat<T>& trainData,
+           arma::SpMat<T>& testData,
+           const double testRatio,
+           const bool shuffleData = true)
+{
+  const size_t testSize = static_cast<size_t>(input.n_cols * testRatio);
+  const size_t trainSize = input.n_cols - testSize;
+
+  arma::uvec order = arma::linspace<arma::uvec>(0, input.n_cols - 1,
+      input.n_cols);
+  if (shuffleData)
+    order = arma::shuffle(order);
+
+  if (trainSize > 0)
+  {
+    ExtractColumns(input, arma::uvec(order.subvec(0, trainSize - 1)),
+        trainData);
+  }
+  else
+    trainData.set_size(input.n_rows, 0);
+
+  if (trainSize < input.n_cols)
+  {
+    ExtractColumns(input,
+        arma::uvec(order.subvec(trainSize, input.n_cols - 1)), testData);
+  }
+  else
+    testData.set_size(input.n_rows, 0);
+}
+
+/**
+ * Compute the column indices of a train/test split without touching the data.
+ * This is useful for very large datasets, where copying both halves of the
+ * dataset with Split() would transiently need far more memory; the index sets
+ * can be handed to ApplySplitInPlace() or used directly with submatrix views.
+ *
+ * @param count Number of points (columns) in the dataset.
+ * @param testRatio Percentage of dataset to use for test set (between 0 and 1).
+ * @param trainIndices Vector to store the training indices into.
+ * @param testIndices Vector to store the test indices into.
+ * @param shuffleData If true, the sample order is shuffled; otherwise, each
+ *       sample is visited in linear order. (Default true.)
+ */
+inline void SplitIndices(const size_t count,
+                         const double testRatio,
+                         arma::uvec& trainIndices,
+                         arma::uvec& testIndices,
+                         const bool shuffleData = true)
+{
+  const size_t testSize = static_cast<size_t>(count * testRatio);
+  const size_t trainSize = count - testSize;
+
+  arma::uvec order = arma::linspace<arma::uvec>(0, count - 1, count);
+  if (shuffleData)
+    order = arma::shuffle(order);
+
+  trainIndices = (trainSize > 0) ? order.subvec(0, trainSize - 1) :
+      arma::uvec();
+  testIndices = (trainSize < count) ? order.subvec(trainSize, count - 1) :
+      arma::uvec();
+}
+
+/**
+ * Compute the column indices of a stratified train/test split without touching
+ * the data.  The points of each label value are split separately, so every
+ * class appears in the training and test sets in (roughly) the same proportion
+ * as in the full dataset.
+ *
+ * @param inputLabel Labels of the dataset to split.
+ * @param testRatio Percentage of dataset to use for test set (between 0 and 1).
+ * @param trainIndices Vector to store the training indices into.
+ * @param testIndices Vector to store the test indices into.
+ * @param shuffleData If true, the points of each class and the resulting index
+ *       sets are shuffled; otherwise, each sample is visited in linear order.
+ *       (Default true.)
+ */
+template<typename U>
+void StratifiedSplitIndices(const arma::Row<U>& inputLabel,
+                            const double testRatio,
+                            arma::uvec& trainIndices,
+                            arma::uvec& testIndices,
+                            const bool shuffleData = true)
+{
+  // Group the points of each label value.  An ordered map keeps the result
+  // deterministic for a given random seed.
+  std::map<U, std::vector<arma::uword>> classIndices;
+  for (size_t i = 0; i < inputLabel.n_elem; ++i)
+    classIndices[inputLabel[i]].push_back(i);
+
+  std::vector<arma::uword> train, test;
+  train.reserve(inputLabel.n_elem);
+  for (typename std::map<U, std::vector<arma::uword>>::iterator it =
+      classIndices.begin(); it != classIndices.end(); ++it)
+  {
+    arma::uvec indices = arma::conv_to<arma::uvec>::from(it->second);
+    if (shuffleData)
+      indices = arma::shuffle(indices);
+
+    const size_t classTestSize =
+        static_cast<size_t>(indices.n_elem * testRatio);
+    const size_t classTrainSize = indices.n_elem - classTestSize;
+    for (size_t i = 0; i < classTrainSize; ++i)
+      train.push_back(indices[i]);
+    for (size_t i = classTrainSize; i < indices.n_elem; ++i)
+      test.push_back(indices[i]);
+  }
+
+  trainIndices = arma::conv_to<arma::uvec>::from(train);
+  testIndices = arma::conv_to<arma::uvec>::from(test);
+
+  // Don't leave the sets grouped by class.
+  if (shuffleData)
+  {
+    trainIndices = arma::shuffle(trainIndices);
+    testIndices = arma::shuffle(testIndices);
+  }
+}
+
+/**
+ * Permute the columns of the dataset in place so that the training points come
+ * first, followed by the test points.  Only one extra column of scratch space
+ * is used, so unlike Split() no second copy of the dataset is ever held.  The
+ * number of training points is returned; the two halves can then be aliased
+ * without a copy via SplitAlias().
+ *
+ * @param input Dataset to permute; overwritten with the permuted columns.
+ * @param trainIndices Indices of the training points (e.g. from
+ *       SplitIndices() or StratifiedSplitIndices()).
+ * @param testIndices Indices of the test points.
+ * @return The number of training points (the test points start there).
+ */
+template<typename T>
+size_t ApplySplitInPlace(arma::Mat<T>& input,
+                         const arma::uvec& trainIndices,
+                         const arma::uvec& testIndices)
+{
+  if (trainIndices.n_elem + testIndices.n_elem != input.n_cols)
+  {
+    std::ostringstream oss;
+    oss << "ApplySplitInPlace(): " << trainIndices.n_elem << " training and "
+        << testIndices.n_elem << " test indices given, but the dataset has "
+        << input.n_cols << " columns!";
+    throw std::invalid_argument(oss.str());
+  }
+
+  // order[i] is the old position of the column that ends up at position i.
+  arma::uvec order(input.n_cols);
+  if (trainIndices.n_elem > 0)
+    order.subvec(0, trainIndices.n_elem - 1) = trainIndices;
+  if (testIndices.n_elem > 0)
+    order.subvec(trainIndices.n_elem, input.n_cols - 1) = testIndices;
+
+  // Apply the permutation cycle by cycle, buffering one column at a time.
+  std::vector<bool> visited(input.n_cols, false);
+  arma::Col<T> buffer(input.n_rows);
+  for (size_t start = 0; start < input.n_cols; ++start)
+  {
+    if (visited[start] || order[start] == start)
+    {
+      visited[start] = true;
+      continue;
+    }
+
+    buffer = input.col(start);
+    size_t current = start;
+    while (true)
+    {
+      const size_t source = order[current];
+      visited[current] = true;
+      if (source == start)
+      {
+        input.col(current) = buffer;
+        break;
+      }
+      input.col(current) = input.col(source);
+      current = source;
+    }
+  }
+
+  return trainIndices.n_elem;
+}
+
+/**
+ * Permute the columns of the dataset and the labels in place so that the
+ * training points come first, followed by the test points.  See the other
+ * ApplySplitInPlace() overload for details.
+ *
+ * @param input Dataset to permute; overwritten with the permuted columns.
+ * @param inputLabel Labels to permute alongside the dataset.
+ * @param trainIndices Indices of the training points.
+ * @param testIndices Indices of the test points.
+ * @return The number of training points (the test points start there).
+ */
+template<typename T, typename U>
+size_t ApplySplitInPlace(arma::Mat<T>& input,
+                         arma::Row<U>& inputLabel,
+                         const arma::uvec& trainIndices,
+                         const arma::uvec& testIndices)
+{
+  const size_t trainSize = ApplySplitInPlace(input, trainIndices, testIndices);
+
+  // The labels are tiny compared to the data, so a copy is fine here.
+  arma::Row<U> permutedLabels(inputLabel.n_elem);
+  for (size_t i = 0; i < trainIndices.n_elem; ++i)
+    permutedLabels[i] = inputLabel[trainIndices[i]];
+  for (size_t i = 0; i < testIndices.n_elem; ++i)
+    permutedLabels[trainSize + i] = inputLabel[testIndices[i]];
+  inputLabel = std::move(permutedLabels);
+
+  return trainSize;
+}
+
+/**
+ * Return non-owning views of the first trainSize columns and the remaining
+ * columns of the given dataset, without copying any data.  This is meant to be
+ * used after ApplySplitInPlace(), when the training and test points are
+ * contiguous:
+ *
+ * @code
+ * arma::uvec trainIndices, testIndices;
+ * SplitIndices(input.n_cols, 0.3, trainIndices, testIndices);
+ * const size_t trainSize = ApplySplitInPlace(input, trainIndices, testIndices);
+ * auto views = SplitAlias(input, trainSize);
+ * arma::mat& trainData = std::get<0>(views);
+ * arma::mat& testData = std::get<1>(views);
+ * @endcode
+ *
+ * The views alias the memory of input, so they are only valid as long as input
+ * is alive and unmodified in size.
+ *
+ * @param input Dataset to alias.
+ * @param trainSize Number of leading columns to place in the training view.
+ * @return std::tuple of the training view and the test view.
+ */
+template<typename T>
+std::tuple<arma::Mat<T>, arma::Mat<T>>
+SplitAlias(arma::Mat<T>& input, const size_t trainSize)
+{
+  if (trainSize > input.n_cols)
+  {
+    std::ostringstream oss;
+    oss << "SplitAlias(): trainSize (" << trainSize << ") is larger than the "
+        << "number of columns (" << input.n_cols << ")!";
+    throw std::invalid_argument(oss.str());
+  }
+
+  arma::Mat<T> trainView(input.memptr(), input.n_rows, trainSize,
+      false, true);
+  arma::Mat<T> testView(input.memptr() + trainSize * input.n_rows,
+      input.n_rows, input.n_cols - trainSize, false, true);
+
+  return std::make_tuple(std::move(trainView), std::move(testView));
+}
+
+/**
+ * Given an input dataset and labels, split into a training set and test set
+ * such that every class appears in both sets in (roughly) the same proportion
+ * as in the full dataset.  Apart from the stratification this behaves like
+ * Split().
+ *
+ * @param input Input dataset to split.
+ * @param inputLabel Input labels to split.
+ * @param trainData Matrix to store training data into.
+ * @param testData Matrix to store test data into.
+ * @param trainLabel Vector to store training labels into.
+ * @param testLabel Vector to store test labels into.
+ * @param testRatio Percentage of dataset to use for test set (between 0 and 1).
+ * @param shuffleData If true, the sample order is shuffled; otherwise, each
+ *       sample is visited in linear order. (Default true.)
+ */
+template<typename T, typename U>
+void StratifiedSplit(const arma::Mat<T>& input,
+                     const arma::Row<U>& inputLabel,
+                     arma::Mat<T>& trainData,
+                     arma::Mat<T>& testData,
+                     arma::Row<U>& trainLabel,
+                     arma::Row<U>& testLabel,
+                     const double testRatio,
+                     const bool shuffleData = true)
+{
+  arma::uvec trainIndices, testIndices;
+  StratifiedSplitIndices(inputLabel, testRatio, trainIndices, testIndices,
+      shuffleData);
+
+  trainData = input.cols(trainIndices);
+  testData = input.cols(testIndices);
+  trainLabel = inputLabel.cols(trainIndices);
+  testLabel = inputLabel.cols(testIndices);
+}
+
 } // namespace data
 } // namespace mlpack
 
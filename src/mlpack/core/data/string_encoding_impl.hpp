@@ -15,7 +15,9 @@
 
 // In case it hasn't been included yet.
 #include "string_encoding.hpp"
+#include "tokenizers/tokenized_corpus.hpp"
 #include <type_traits>
+#include <utility>
 
 namespace mlpack {
 namespace data {
@@ -105,34 +107,37 @@ EncodeHelper(const std::vector<std::string>& input,
              const TokenizerType& tokenizer,
              PolicyType& policy)
 {
+  typedef typename std::remove_reference<
+      decltype(tokenizer(std::declval<boost::string_view&>()))>::type
+      TokenType;
+
+  static_assert(
+      std::is_same<TokenType,
+                   typename std::remove_reference<typename DictionaryType::
+                      TokenType>::type>::value,
+      "The dictionary token type doesn't match the return value type "
+      "of the tokenizer.");
+
   size_t numColumns = 0;
 
   policy.Reset();
 
+  // Tokenize every document exactly once, in parallel; both passes below
+  // iterate over the stored tokens instead of re-running the tokenizer.
+  const TokenizedCorpus<TokenType> corpus(input, tokenizer);
+
   // The first pass adds the extracted tokens to the dictionary.
-  for (size_t i = 0; i < input.size(); i++)
+  for (size_t i = 0; i < corpus.Documents(); i++)
   {
-    boost::string_view strView(input[i]);
-    auto token = tokenizer(strView);
-
-    static_assert(
-        std::is_same<typename std::remove_reference<decltype(token)>::type,
-                     typename std::remove_reference<typename DictionaryType::
-                        TokenType>::type>::value,
-        "The dictionary token type doesn't match the return value type "
-        "of the tokenizer.");
-
-    size_t numTokens = 0;
+    const size_t numTokens = corpus.NumTokens(i);
 
-    while (!tokenizer.IsTokenEmpty(token))
+    for (size_t j = 0; j < numTokens; j++)
     {
+      TokenType token = corpus.Token(i, j);
       if (!dictionary.HasToken(token))
         dictionary.AddToken(std::move(token));
 
-      policy.PreprocessToken(i, numTokens, dictionary.Value(token));
-
-      token = tokenizer(strView);
-      numTokens++;
+      policy.PreprocessToken(i, j, dictionary.Value(corpus.Token(i, j)));
     }
 
     numColumns = std::max(numColumns, numTokens);
@@ -140,19 +145,14 @@ EncodeHelper(const std::vector<std::string>& input,
 
   policy.InitMatrix(output, input.size(), numColumns, dictionary.Size());
 
-  // The second pass writes the encoded values to the output.
-  for (size_t i = 0; i < input.size(); i++)
+  // The second pass writes the encoded values to the output.  The dictionary
+  // is read-only here and every document writes to its own cells, so the
+  // documents are encoded in parallel.
+  #pragma omp parallel for
+  for (omp_size_t i = 0; i < (omp_size_t) corpus.Documents(); i++)
   {
-    boost::string_view strView(input[i]);
-    auto token = tokenizer(strView);
-    size_t numTokens = 0;
-
-    while (!tokenizer.IsTokenEmpty(token))
-    {
-      policy.Encode(output, dictionary.Value(token), i, numTokens);
-      token = tokenizer(strView);
-      numTokens++;
-    }
+    for (size_t j = 0; j < corpus.NumTokens(i); j++)
+      policy.Encode(output, dictionary.Value(corpus.Token(i, j)), i, j);
   }
 }
 
@@ -166,32 +166,36 @@ EncodeHelper(const std::vector<std::string>& input,
              typename std::enable_if<StringEncodingPolicyTraits<
                  PolicyType>::onePassEncoding>::type*)
 {
-  policy.Reset();
+  typedef typename std::remove_reference<
+      decltype(tokenizer(std::declval<boost::string_view&>()))>::type
+      TokenType;
 
-  // The loop below extracts the tokens and writes the encoded values
-  // at once.
-  for (size_t i = 0; i < input.size(); i++)
-  {
-    boost::string_view strView(input[i]);
-    auto token = tokenizer(strView);
+  static_assert(
+      std::is_same<TokenType,
+                   typename std::remove_reference<typename DictionaryType::
+                      TokenType>::type>::value,
+      "The dictionary token type doesn't match the return value type "
+      "of the tokenizer.");
+
+  policy.Reset();
 
-    static_assert(
-        std::is_same<typename std::remove_reference<decltype(token)>::type,
-                     typename std::remove_reference<typename DictionaryType::
-                        TokenType>::type>::value,
-        "The dictionary token type doesn't match the return value type "
-        "of the tokenizer.");
+  // Tokenize every document exactly once, in parallel.  The encoding loop
+  // below stays sequential, since it may grow the dictionary.
+  const TokenizedCorpus<TokenType> corpus(input, tokenizer);
 
-    output.emplace_back();
+  output.resize(input.size());
 
-    while (!tokenizer.IsTokenEmpty(token))
+  // The loop below writes the encoded values for the extracted tokens.
+  for (size_t i = 0; i < corpus.Documents(); i++)
+  {
+    for (size_t j = 0; j < corpus.NumTokens(i); j++)
     {
+      TokenType token = corpus.Token(i, j);
+
       if (dictionary.HasToken(token))
         policy.Encode(output[i], dictionary.Value(token));
       else
         policy.Encode(output[i], dictionary.AddToken(std::move(token)));
-
-      token = tokenizer(strView);
     }
   }
 }
@@ -0,0 +1,119 @@
+/**
+ * @file core/data/tokenizers/tokenized_corpus.hpp
+ * @author Jeffin Sam
+ *
+ * Definition of the TokenizedCorpus class: a bulk tokenization stage that
+ * tokenizes all documents of a corpus in parallel and stores the tokens in
+ * one contiguous arena, so downstream encoders iterate over plain arrays
+ * instead of re-running the tokenizer.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_DATA_TOKENIZERS_TOKENIZED_CORPUS_HPP
+#define MLPACK_CORE_DATA_TOKENIZERS_TOKENIZED_CORPUS_HPP
+
+#include <mlpack/prereqs.hpp>
+#include <mlpack/core/boost_backport/boost_backport_string_view.hpp>
+#include <vector>
+
+namespace mlpack {
+namespace data {
+
+/**
+ * The TokenizedCorpus class runs a tokenizer over a whole corpus up front:
+ * the documents are tokenized in parallel (they are independent of each
+ * other), and the resulting tokens are spliced into one flat array with a
+ * per-document offset table.  When the token type is boost::string_view the
+ * tokens are views into the input strings, so no token text is copied and
+ * the input corpus must outlive this object.
+ *
+ * StringEncoding uses this stage to tokenize each document exactly once,
+ * even for encodings that take two passes over the corpus.
+ *
+ * @tparam TokenType The type of the tokens which the tokenizer extracts.
+ */
+template<typename TokenType>
+class TokenizedCorpus
+{
+ public:
+  /**
+   * Tokenize the given corpus with the given tokenizer.
+   *
+   * @tparam TokenizerType Type of the tokenizer; it must extract tokens of
+   *         type TokenType (see StringEncoding for the requirements on the
+   *         tokenization algorithm).
+   *
+   * @param input Corpus of text to tokenize.
+   * @param tokenizer The tokenizer object.
+   */
+  template<typename TokenizerType>
+  TokenizedCorpus(const std::vector<std::string>& input,
+                  const TokenizerType& tokenizer)
+  {
+    std::vector<std::vector<TokenType>> docTokens(input.size());
+
+    // Each document is tokenized independently.
+    #pragma omp parallel for
+    for (omp_size_t i = 0; i < (omp_size_t) input.size(); ++i)
+    {
+      boost::string_view strView(input[i]);
+      auto token = tokenizer(strView);
+
+      while (!tokenizer.IsTokenEmpty(token))
+      {
+        docTokens[i].push_back(std::move(token));
+        token = tokenizer(strView);
+      }
+    }
+
+    // Lay the per-document token lists out in one contiguous arena, recording
+    // where each document starts.
+    offsets.resize(input.size() + 1);
+    offsets[0] = 0;
+    for (size_t i = 0; i < input.size(); ++i)
+      offsets[i + 1] = offsets[i] + docTokens[i].size();
+
+    tokens.resize(offsets.back());
+
+    #pragma omp parallel for
+    for (omp_size_t i = 0; i < (omp_size_t) input.size(); ++i)
+    {
+      std::copy(docTokens[i].begin(), docTokens[i].end(),
+          tokens.begin() + offsets[i]);
+    }
+  }
+
+  //! Return the number of documents in the corpus.
+  size_t Documents() const { return offsets.size() - 1; }
+
+  //! Return the number of tokens in the given document.
+  size_t NumTokens(const size_t doc) const
+  {
+    return offsets[doc + 1] - offsets[doc];
+  }
+
+  //! Return the given token of the given document.
+  const TokenType& Token(const size_t doc, const size_t token) const
+  {
+    return tokens[offsets[doc] + token];
+  }
+
+  //! Return the flat array of all tokens, in document order.
+  const std::vector<TokenType>& Tokens() const { return tokens; }
+
+ private:
+  //! All tokens of the corpus, one document after another.
+  std::vector<TokenType> tokens;
+
+  //! offsets[i] is the index of document i's first token in the arena;
+  //! the last element is the total number of tokens.
+  std::vector<size_t> offsets;
+};
+
+} // namespace data
+} // namespace mlpack
+
+#endif
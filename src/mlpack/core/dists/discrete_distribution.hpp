@@ -193,9 +193,10 @@ class DiscreteDistribution
    */
   void LogProbability(const arma::mat& x, arma::vec& logProbabilities) const
   {
-    logProbabilities.set_size(x.n_cols);
-    for (size_t i = 0; i < x.n_cols; i++)
-      logProbabilities(i) = log(Probability(x.unsafe_col(i)));
+    // The per-point evaluations are table lookups, but the logarithm can at
+    // least be applied to the whole batch at once.
+    Probability(x, logProbabilities);
+    logProbabilities = arma::log(logProbabilities);
   }
 
   /**
@@ -90,11 +90,10 @@ class GaussianDistribution
    */
   void Probability(const arma::mat& x, arma::vec& probabilities) const
   {
-    probabilities.set_size(x.n_cols);
-    for (size_t i = 0; i < x.n_cols; i++)
-    {
-      probabilities(i) = Probability(x.unsafe_col(i));
-    }
+    // Evaluate in log space in one batched pass (reusing the precomputed
+    // inverse covariance), then exponentiate.
+    LogProbability(x, probabilities);
+    probabilities = arma::exp(probabilities);
   }
 
   /**
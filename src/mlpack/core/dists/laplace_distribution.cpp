@@ -36,11 +36,9 @@ double LaplaceDistribution::LogProbability(const arma::vec& observation) const
 void LaplaceDistribution::Probability(const arma::mat& x,
                                       arma::vec& probabilities) const
 {
-  probabilities.set_size(x.n_cols);
-  for (size_t i = 0; i < x.n_cols; i++)
-  {
-    probabilities(i) = Probability(x.unsafe_col(i));
-  }
+  // Evaluate in log space in one batched pass, then exponentiate.
+  LogProbability(x, probabilities);
+  probabilities = arma::exp(probabilities);
 }
 
 /**
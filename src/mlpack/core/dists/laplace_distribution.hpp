@@ -112,11 +112,10 @@ class LaplaceDistribution
    */
   void LogProbability(const arma::mat& x, arma::vec& logProbabilities) const
   {
-    logProbabilities.set_size(x.n_cols);
-    for (size_t i = 0; i < x.n_cols; i++)
-    {
-      logProbabilities(i) = LogProbability(x.unsafe_col(i));
-    }
+    // The norms of all deviations from the mean are computed in one pass.
+    const arma::mat diffs = x.each_col() - mean;
+    logProbabilities = -log(2. * scale) -
+        arma::sqrt(arma::sum(arma::square(diffs), 0)).t() / scale;
   }
 
   /**
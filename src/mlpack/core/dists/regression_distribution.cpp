@@ -65,6 +65,38 @@ double RegressionDistribution::Probability(const arma::vec& observation) const
   return err.Probability(observation(0)-fitted.t());
 }
 
+/**
+ * Evaluate probability density function on each point (column) of the given
+ * matrix.
+ *
+ * @param x List of observations.
+ * @param probabilities Output probabilities for each input observation.
+ */
+void RegressionDistribution::Probability(const arma::mat& x,
+                                         arma::vec& probabilities) const
+{
+  LogProbability(x, probabilities);
+  probabilities = arma::exp(probabilities);
+}
+
+/**
+ * Evaluate log probability density function on each point (column) of the
+ * given matrix.
+ *
+ * @param x List of observations.
+ * @param logProbabilities Output log-probabilities for each input observation.
+ */
+void RegressionDistribution::LogProbability(
+    const arma::mat& x,
+    arma::vec& logProbabilities) const
+{
+  // One batched prediction gives the residual of every observation; the error
+  // distribution is then evaluated over all residuals at once.
+  arma::rowvec fitted;
+  rf.Predict(x.rows(1, x.n_rows - 1), fitted);
+  err.LogProbability(arma::mat(x.row(0) - fitted), logProbabilities);
+}
+
 void RegressionDistribution::Predict(const arma::mat& points,
                                      arma::vec& predictions) const
 {
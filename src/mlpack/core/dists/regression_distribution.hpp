@@ -122,6 +122,16 @@ class RegressionDistribution
    */
   double Probability(const arma::vec& observation) const;
 
+  /**
+   * Evaluate the probability density function on each point (column) of the
+   * given matrix.  The residual of every observation is obtained with a
+   * single batched prediction.
+   *
+   * @param x List of observations.
+   * @param probabilities Output probabilities for each input observation.
+   */
+  void Probability(const arma::mat& x, arma::vec& probabilities) const;
+
   /**
    * Evaluate log probability density function of given observation.
    *
@@ -132,6 +142,17 @@ class RegressionDistribution
     return log(Probability(observation));
   }
 
+  /**
+   * Evaluate the log probability density function on each point (column) of
+   * the given matrix.  The residual of every observation is obtained with a
+   * single batched prediction.
+   *
+   * @param x List of observations.
+   * @param logProbabilities Output log-probabilities for each input
+   *   observation.
+   */
+  void LogProbability(const arma::mat& x, arma::vec& logProbabilities) const;
+
   /**
    * Calculate y_i for each data point in points.
    *
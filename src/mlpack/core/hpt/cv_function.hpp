@@ -12,6 +12,8 @@
 #ifndef MLPACK_CORE_HPT_CV_FUNCTION_HPP
 #define MLPACK_CORE_HPT_CV_FUNCTION_HPP
 
+#include <map>
+
 #include <mlpack/core.hpp>
 
 namespace mlpack {
@@ -66,7 +68,9 @@ class CVFunction
              const BoundArgs&... args);
 
   /**
-   * Run cross-validation with the bound and passed parameters.
+   * Run cross-validation with the bound and passed parameters.  Results are
+   * cached, so assessing the same parameters again (as happens with the base
+   * point of each Gradient() call) does not train any models.
    *
    * @param parameters Arguments (rather than the bound arguments) that should
    *     be passed into the Evaluate method of the CVType object.
@@ -125,6 +129,9 @@ class CVFunction
   //! Minimum absolute increase of arguments for calculation of gradient.
   double minDelta;
 
+  //! Objectives of the parameters that have already been assessed.
+  std::map<std::vector<double>, double> evaluationCache;
+
   /**
    * Collect all arguments and run cross-validation.
    */
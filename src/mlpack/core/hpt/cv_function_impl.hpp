@@ -65,7 +65,19 @@ template<typename CVType,
 double CVFunction<CVType, MLAlgorithm, TotalArgs, BoundArgs...>::Evaluate(
     const arma::mat& parameters)
 {
-  return Evaluate<0, 0>(parameters);
+  // Optimizers assess some parameters repeatedly (e.g. the base point of each
+  // Gradient() call is also assessed by the optimizer itself), so cache the
+  // objectives of the parameters that have already been assessed to avoid
+  // training models for them again.
+  const std::vector<double> key(parameters.begin(), parameters.end());
+  const auto cached = evaluationCache.find(key);
+  if (cached != evaluationCache.end())
+    return cached->second;
+
+  const double objective = Evaluate<0, 0>(parameters);
+  evaluationCache[key] = objective;
+
+  return objective;
 }
 
 template<typename CVType,
@@ -0,0 +1,278 @@
+/**
+ * @file core/hpt/successive_halving.hpp
+ *
+ * Successive-halving hyper-parameter tuning.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_HPT_SUCCESSIVE_HALVING_HPP
+#define MLPACK_CORE_HPT_SUCCESSIVE_HALVING_HPP
+
+#include <mlpack/core/cv/meta_info_extractor.hpp>
+#include <mlpack/core/cv/simple_cv.hpp>
+
+namespace mlpack {
+namespace hpt {
+
+/**
+ * The class SuccessiveHalvingTuner searches a grid of hyper-parameter
+ * configurations with the successive-halving strategy: every configuration is
+ * first assessed on a small random subsample of the data, and only the best
+ * 1 / eta fraction of the candidates is promoted to the next round, which uses
+ * eta times more data.  The last round assesses the remaining candidates on
+ * the whole dataset.  Since most candidates are discarded after seeing only a
+ * small subsample, the total cost of a large sweep is a small multiple of the
+ * cost of assessing one configuration on the whole dataset, rather than
+ * proportional to the number of configurations.  The candidates of each round
+ * are independent and are assessed in parallel when OpenMP is enabled.
+ *
+ * Assessment is done with SimpleCV; the data passed to the constructor is
+ * shuffled once so that the subsamples of the early rounds are random.  For
+ * example, we can tune lambda of LinearRegression over a grid of 100 values
+ * in the following way.
+ *
+ * @code
+ * // 100-point 5-dimensional random dataset.
+ * arma::mat data = arma::randu<arma::mat>(5, 100);
+ * // Noisy responses retrieved by a random linear transformation of data.
+ * arma::rowvec responses = arma::randu<arma::rowvec>(5) * data +
+ *     0.1 * arma::randn<arma::rowvec>(100);
+ *
+ * // Using 80% of data for training and remaining 20% for assessing MSE.
+ * double validationSize = 0.2;
+ * SuccessiveHalvingTuner<LinearRegression, MSE> tuner(validationSize, data,
+ *     responses);
+ *
+ * arma::vec lambdas = arma::linspace(0.0, 1.0, 100);
+ * double bestLambda;
+ * std::tie(bestLambda) = tuner.Optimize(lambdas);
+ * @endcode
+ *
+ * Unlike HyperParameterTuner, only sets of values to choose from can be
+ * passed for hyper-parameters (a hyper-parameter can be fixed by passing a
+ * single-element collection).
+ *
+ * @tparam MLAlgorithm A machine learning algorithm.
+ * @tparam Metric A metric to assess the quality of a trained model.
+ * @tparam MatType The type of data.
+ * @tparam PredictionsType The type of predictions (should be passed when the
+ *     predictions type is a template parameter in Train methods of the given
+ *     MLAlgorithm; arma::Row<size_t> will be used otherwise).
+ * @tparam WeightsType The type of weights (should be passed when weighted
+ *     learning is supported, and the weights type is a template parameter in
+ *     Train methods of the given MLAlgorithm; arma::vec will be used
+ *     otherwise).
+ */
+template<typename MLAlgorithm,
+         typename Metric,
+         typename MatType = arma::mat,
+         typename PredictionsType =
+             typename cv::MetaInfoExtractor<MLAlgorithm,
+                 MatType>::PredictionsType,
+         typename WeightsType =
+             typename cv::MetaInfoExtractor<MLAlgorithm, MatType,
+                 PredictionsType>::WeightsType>
+class SuccessiveHalvingTuner
+{
+ public:
+  /**
+   * This constructor can be used for regression algorithms and for binary
+   * classification algorithms.
+   *
+   * @param validationSize A proportion (between 0 and 1) of the data used as
+   *     the validation set in each assessment.
+   * @param xs Data points to tune on.
+   * @param ys Predictions (labels for classification algorithms and responses
+   *     for regression algorithms) for each data point.
+   * @param eta The elimination rate: each round promotes roughly a 1 / eta
+   *     fraction of the candidates to eta times more data (should be greater
+   *     than 1).
+   */
+  SuccessiveHalvingTuner(const double validationSize,
+                         const MatType& xs,
+                         const PredictionsType& ys,
+                         const double eta = 3.0);
+
+  /**
+   * This constructor can be used for multiclass classification algorithms.
+   *
+   * @param validationSize A proportion (between 0 and 1) of the data used as
+   *     the validation set in each assessment.
+   * @param xs Data points to tune on.
+   * @param ys Labels for each data point.
+   * @param numClasses Number of classes in the dataset.
+   * @param eta The elimination rate: each round promotes roughly a 1 / eta
+   *     fraction of the candidates to eta times more data (should be greater
+   *     than 1).
+   */
+  SuccessiveHalvingTuner(const double validationSize,
+                         const MatType& xs,
+                         const PredictionsType& ys,
+                         const size_t numClasses,
+                         const double eta = 3.0);
+
+  /**
+   * Find the best hyper-parameters with successive halving.  For each
+   * hyper-parameter a set of values to choose from should be passed as an
+   * argument; the searched grid is the Cartesian product of the sets.  The
+   * set of values should be an STL-compatible container (it should provide
+   * begin() and end() methods returning iterators, and define value_type).
+   *
+   * All arguments should be passed in the same order as if the corresponding
+   * hyper-parameters would be passed into the Evaluate method of SimpleCV (in
+   * the order as they appear in the constructor(s) of the given MLAlgorithm).
+   *
+   * The method returns a tuple of the best found values for the
+   * hyper-parameters.
+   *
+   * @param collections Sets of values for each hyper-parameter.
+   */
+  template<typename... Collections>
+  std::tuple<typename Collections::value_type...> Optimize(
+      const Collections&... collections);
+
+  //! Get the elimination rate.
+  double Eta() const { return eta; }
+  //! Modify the elimination rate (should be greater than 1).
+  double& Eta() { return eta; }
+
+  //! Get the performance measurement of the best model from the last run.
+  double BestObjective() const { return bestObjective; }
+
+  //! Get the best model from the last run.
+  const MLAlgorithm& BestModel() const { return bestModel; }
+
+  //! Modify the best model from the last run.
+  MLAlgorithm& BestModel() { return bestModel; }
+
+ private:
+  /**
+   * A decorator that returns negated values of the original metric.
+   */
+  template<typename OriginalMetric>
+  struct Negated
+  {
+    static double Evaluate(MLAlgorithm& model,
+                           const MatType& xs,
+                           const PredictionsType& ys)
+    { return -OriginalMetric::Evaluate(model, xs, ys); }
+  };
+
+  //! A short alias for the type of the cross-validation.  The metric is
+  //! negated if it needs maximization, so smaller values are always better.
+  using CVType = typename std::conditional<Metric::NeedsMinimization,
+      cv::SimpleCV<MLAlgorithm, Metric, MatType, PredictionsType, WeightsType>,
+      cv::SimpleCV<MLAlgorithm, Negated<Metric>, MatType, PredictionsType,
+          WeightsType>>::type;
+
+  //! A short alias for the meta-information extractor.
+  using MIE =
+      cv::MetaInfoExtractor<MLAlgorithm, MatType, PredictionsType, WeightsType>;
+
+  //! The proportion of the data used as the validation set.
+  double validationSize;
+
+  //! The (shuffled) data points.
+  MatType xs;
+  //! The (shuffled) predictions.
+  PredictionsType ys;
+
+  //! The number of classes (used only when MLAlgorithm takes it).
+  size_t numClasses;
+
+  //! The elimination rate.
+  double eta;
+
+  //! The best objective from the last run.
+  double bestObjective;
+
+  //! The best model from the last run.
+  MLAlgorithm bestModel;
+
+  /**
+   * Construct a SimpleCV object for the given data budget.  This overload is
+   * called when numClasses is taken by the MLAlgorithm.
+   */
+  template<bool Enabled = MIE::TakesNumClasses,
+           typename = typename std::enable_if<Enabled>::type>
+  CVType MakeCV(const MatType& xsBudget, const PredictionsType& ysBudget);
+
+  /**
+   * Construct a SimpleCV object for the given data budget.  This overload is
+   * called when numClasses is not taken by the MLAlgorithm.
+   */
+  template<bool Enabled = !MIE::TakesNumClasses,
+           typename = typename std::enable_if<Enabled>::type,
+           typename = void>
+  CVType MakeCV(const MatType& xsBudget, const PredictionsType& ysBudget);
+
+  /**
+   * The set of methods to build all configurations (the Cartesian product of
+   * the passed collections).
+   *
+   * This template is called when values for all hyper-parameters have been
+   * chosen.
+   */
+  template<size_t I /* Index of the next collection to handle. */,
+           typename ConfigTupleType,
+           typename CollectionsTupleType,
+           typename = typename std::enable_if<
+               I == std::tuple_size<CollectionsTupleType>::value>::type>
+  void GenerateConfigs(const CollectionsTupleType& collections,
+                       ConfigTupleType& workspace,
+                       std::vector<ConfigTupleType>& configs);
+
+  /**
+   * The set of methods to build all configurations (the Cartesian product of
+   * the passed collections).
+   *
+   * This template is called when values for the hyper-parameter I should be
+   * enumerated.
+   */
+  template<size_t I /* Index of the next collection to handle. */,
+           typename ConfigTupleType,
+           typename CollectionsTupleType,
+           typename = typename std::enable_if<
+               (I < std::tuple_size<CollectionsTupleType>::value)>::type,
+           typename = void>
+  void GenerateConfigs(const CollectionsTupleType& collections,
+                       ConfigTupleType& workspace,
+                       std::vector<ConfigTupleType>& configs);
+
+  /**
+   * Gather all elements of the configuration tuple in an argument list and
+   * assess the configuration with the given cross-validation object.
+   */
+  template<typename ConfigTupleType,
+           size_t I /* Index of the element in the tuple to handle. */,
+           typename... Args,
+           typename = typename std::enable_if<
+               (I < std::tuple_size<ConfigTupleType>::value)>::type>
+  double EvaluateConfig(CVType& cvObject,
+                        const ConfigTupleType& config,
+                        const Args&... args);
+
+  /**
+   * Assess the gathered configuration with the given cross-validation object.
+   */
+  template<typename ConfigTupleType,
+           size_t I /* Index of the element in the tuple to handle. */,
+           typename... Args,
+           typename = typename std::enable_if<
+               I == std::tuple_size<ConfigTupleType>::value>::type,
+           typename = void>
+  double EvaluateConfig(CVType& cvObject,
+                        const ConfigTupleType& config,
+                        const Args&... args);
+};
+
+} // namespace hpt
+} // namespace mlpack
+
+// Include implementation
+#include "successive_halving_impl.hpp"
+
+#endif
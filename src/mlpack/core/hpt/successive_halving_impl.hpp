@@ -0,0 +1,289 @@
+/**
+ * @file core/hpt/successive_halving_impl.hpp
+ *
+ * Implementation of successive-halving hyper-parameter tuning.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_HPT_SUCCESSIVE_HALVING_IMPL_HPP
+#define MLPACK_CORE_HPT_SUCCESSIVE_HALVING_IMPL_HPP
+
+#include <mlpack/core.hpp>
+
+namespace mlpack {
+namespace hpt {
+
+template<typename MLAlgorithm,
+         typename Metric,
+         typename MatType,
+         typename PredictionsType,
+         typename WeightsType>
+SuccessiveHalvingTuner<MLAlgorithm,
+                       Metric,
+                       MatType,
+                       PredictionsType,
+                       WeightsType>::SuccessiveHalvingTuner(
+    const double validationSize,
+    const MatType& xs,
+    const PredictionsType& ys,
+    const double eta) :
+    validationSize(validationSize),
+    numClasses(0),
+    eta(eta)
+{
+  if (eta <= 1.0)
+    throw std::invalid_argument(
+        "SuccessiveHalvingTuner: eta should be greater than 1");
+
+  // Shuffle once, so that the subsamples of the early rounds are random.
+  math::ShuffleData(xs, ys, this->xs, this->ys);
+}
+
+template<typename MLAlgorithm,
+         typename Metric,
+         typename MatType,
+         typename PredictionsType,
+         typename WeightsType>
+SuccessiveHalvingTuner<MLAlgorithm,
+                       Metric,
+                       MatType,
+                       PredictionsType,
+                       WeightsType>::SuccessiveHalvingTuner(
+    const double validationSize,
+    const MatType& xs,
+    const PredictionsType& ys,
+    const size_t numClasses,
+    const double eta) :
+    validationSize(validationSize),
+    numClasses(numClasses),
+    eta(eta)
+{
+  if (eta <= 1.0)
+    throw std::invalid_argument(
+        "SuccessiveHalvingTuner: eta should be greater than 1");
+
+  // Shuffle once, so that the subsamples of the early rounds are random.
+  math::ShuffleData(xs, ys, this->xs, this->ys);
+}
+
+template<typename MLAlgorithm,
+         typename Metric,
+         typename MatType,
+         typename PredictionsType,
+         typename WeightsType>
+template<typename... Collections>
+std::tuple<typename Collections::value_type...>
+SuccessiveHalvingTuner<MLAlgorithm,
+                       Metric,
+                       MatType,
+                       PredictionsType,
+                       WeightsType>::Optimize(const Collections&... collections)
+{
+  using ConfigTupleType = std::tuple<typename Collections::value_type...>;
+
+  std::vector<ConfigTupleType> configs;
+  ConfigTupleType workspace;
+  GenerateConfigs<0>(std::tie(collections...), workspace, configs);
+
+  if (configs.empty())
+    throw std::invalid_argument("SuccessiveHalvingTuner::Optimize(): one of "
+        "the passed collections is empty");
+
+  // Use enough rounds to reduce the candidate set to one survivor when a
+  // 1 / eta fraction is promoted each round.
+  size_t numRounds = 1;
+  for (double m = (double) configs.size(); m > eta; m /= eta)
+    ++numRounds;
+
+  // A data budget should leave both parts of the validation split non-empty.
+  const size_t minBudgetCols = std::min((size_t) xs.n_cols, std::max(
+      (size_t) std::ceil(1.0 / validationSize),
+      (size_t) std::ceil(1.0 / (1.0 - validationSize))));
+
+  std::vector<size_t> candidates(configs.size());
+  for (size_t i = 0; i < candidates.size(); ++i)
+    candidates[i] = i;
+  arma::vec objectives(configs.size());
+
+  for (size_t round = 0; round < numRounds; ++round)
+  {
+    // The first round uses a 1 / eta^(numRounds - 1) fraction of the data,
+    // and the last round uses the whole dataset.
+    const double fraction =
+        std::pow(eta, (double) round + 1.0 - (double) numRounds);
+    const size_t budgetCols = std::max(minBudgetCols,
+        std::min((size_t) xs.n_cols,
+            (size_t) std::ceil(fraction * xs.n_cols)));
+
+    const MatType xsBudget = xs.cols(0, budgetCols - 1);
+    const PredictionsType ysBudget = ys.cols(0, budgetCols - 1);
+
+    // The candidates are independent, so they can be assessed in parallel;
+    // each iteration works on its own cross-validation object and writes its
+    // result into its own element of 'objectives'.
+    #pragma omp parallel for shared(objectives)
+    for (omp_size_t i = 0; i < (omp_size_t) candidates.size(); ++i)
+    {
+      CVType cvObject = MakeCV(xsBudget, ysBudget);
+      objectives(candidates[i]) =
+          EvaluateConfig<ConfigTupleType, 0>(cvObject, configs[candidates[i]]);
+    }
+
+    // Promote the best ceil(candidates / eta) candidates to the next round
+    // (smaller objectives are better: the metric is negated if it needs
+    // maximization).
+    if (round + 1 < numRounds)
+    {
+      const size_t numPromoted = std::max((size_t) 1,
+          (size_t) std::ceil(candidates.size() / eta));
+      std::sort(candidates.begin(), candidates.end(),
+          [&objectives](const size_t a, const size_t b)
+          { return objectives(a) < objectives(b); });
+      candidates.resize(numPromoted);
+    }
+  }
+
+  // Pick the winner among the survivors of the last round.
+  size_t best = candidates[0];
+  for (const size_t candidate : candidates)
+  {
+    if (objectives(candidate) < objectives(best))
+      best = candidate;
+  }
+
+  // Re-assess the winner on the whole dataset to expose the trained model.
+  CVType cvObject = MakeCV(xs, ys);
+  const double winnerObjective =
+      EvaluateConfig<ConfigTupleType, 0>(cvObject, configs[best]);
+  bestObjective =
+      Metric::NeedsMinimization ? winnerObjective : -winnerObjective;
+  bestModel = std::move(cvObject.Model());
+
+  return configs[best];
+}
+
+template<typename MLAlgorithm,
+         typename Metric,
+         typename MatType,
+         typename PredictionsType,
+         typename WeightsType>
+template<bool Enabled, typename>
+typename SuccessiveHalvingTuner<MLAlgorithm,
+                                Metric,
+                                MatType,
+                                PredictionsType,
+                                WeightsType>::CVType
+SuccessiveHalvingTuner<MLAlgorithm,
+                       Metric,
+                       MatType,
+                       PredictionsType,
+                       WeightsType>::MakeCV(const MatType& xsBudget,
+                                            const PredictionsType& ysBudget)
+{
+  return CVType(validationSize, xsBudget, ysBudget, numClasses);
+}
+
+template<typename MLAlgorithm,
+         typename Metric,
+         typename MatType,
+         typename PredictionsType,
+         typename WeightsType>
+template<bool Enabled, typename, typename>
+typename SuccessiveHalvingTuner<MLAlgorithm,
+                                Metric,
+                                MatType,
+                                PredictionsType,
+                                WeightsType>::CVType
+SuccessiveHalvingTuner<MLAlgorithm,
+                       Metric,
+                       MatType,
+                       PredictionsType,
+                       WeightsType>::MakeCV(const MatType& xsBudget,
+                                            const PredictionsType& ysBudget)
+{
+  return CVType(validationSize, xsBudget, ysBudget);
+}
+
+template<typename MLAlgorithm,
+         typename Metric,
+         typename MatType,
+         typename PredictionsType,
+         typename WeightsType>
+template<size_t I, typename ConfigTupleType, typename CollectionsTupleType,
+    typename>
+void SuccessiveHalvingTuner<MLAlgorithm,
+                            Metric,
+                            MatType,
+                            PredictionsType,
+                            WeightsType>::GenerateConfigs(
+    const CollectionsTupleType& /* collections */,
+    ConfigTupleType& workspace,
+    std::vector<ConfigTupleType>& configs)
+{
+  configs.push_back(workspace);
+}
+
+template<typename MLAlgorithm,
+         typename Metric,
+         typename MatType,
+         typename PredictionsType,
+         typename WeightsType>
+template<size_t I, typename ConfigTupleType, typename CollectionsTupleType,
+    typename, typename>
+void SuccessiveHalvingTuner<MLAlgorithm,
+                            Metric,
+                            MatType,
+                            PredictionsType,
+                            WeightsType>::GenerateConfigs(
+    const CollectionsTupleType& collections,
+    ConfigTupleType& workspace,
+    std::vector<ConfigTupleType>& configs)
+{
+  for (const auto& value : std::get<I>(collections))
+  {
+    std::get<I>(workspace) = value;
+    GenerateConfigs<I + 1>(collections, workspace, configs);
+  }
+}
+
+template<typename MLAlgorithm,
+         typename Metric,
+         typename MatType,
+         typename PredictionsType,
+         typename WeightsType>
+template<typename ConfigTupleType, size_t I, typename... Args, typename>
+double SuccessiveHalvingTuner<MLAlgorithm,
+                              Metric,
+                              MatType,
+                              PredictionsType,
+                              WeightsType>::EvaluateConfig(
+    CVType& cvObject, const ConfigTupleType& config, const Args&... args)
+{
+  return EvaluateConfig<ConfigTupleType, I + 1>(cvObject, config, args...,
+      std::get<I>(config));
+}
+
+template<typename MLAlgorithm,
+         typename Metric,
+         typename MatType,
+         typename PredictionsType,
+         typename WeightsType>
+template<typename ConfigTupleType, size_t I, typename... Args, typename,
+    typename>
+double SuccessiveHalvingTuner<MLAlgorithm,
+                              Metric,
+                              MatType,
+                              PredictionsType,
+                              WeightsType>::EvaluateConfig(
+    CVType& cvObject, const ConfigTupleType& /* config */, const Args&... args)
+{
+  return cvObject.Evaluate(args...);
+}
+
+} // namespace hpt
+} // namespace mlpack
+
+#endif
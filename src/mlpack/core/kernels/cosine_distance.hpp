@@ -56,6 +56,9 @@ class KernelTraits<CosineDistance>
 
   //! The cosine kernel doesn't include a squared distance.
   static const bool UsesSquaredDistance = false;
+
+  //! The cosine kernel is the inner product of the normalized points.
+  static const bool UsesInnerProduct = true;
 };
 
 } // namespace kernel
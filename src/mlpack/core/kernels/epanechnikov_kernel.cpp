@@ -34,6 +34,18 @@ double EpanechnikovKernel::Evaluate(const double distance) const
   return std::max(0.0, 1 - std::pow(distance, 2.0) * inverseBandwidthSquared);
 }
 
+/**
+ * Evaluate the kernel for a vector of distances at once.
+ */
+void EpanechnikovKernel::Evaluate(const arma::vec& distances,
+                                  arma::vec& results) const
+{
+  // The kernel value never exceeds 1, so clamping to [0, 1] only removes the
+  // negative values, and it vectorizes better than a per-element max().
+  results = arma::clamp(
+      1.0 - arma::square(distances) * inverseBandwidthSquared, 0.0, 1.0);
+}
+
 /**
  * Evaluate gradient of the kernel not for two points
  * but for a numerical value.
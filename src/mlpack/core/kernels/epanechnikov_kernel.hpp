@@ -57,6 +57,16 @@ class EpanechnikovKernel
    */
   double Evaluate(const double distance) const;
 
+  /**
+   * Evaluate the Epanechnikov kernel for a vector of distances at once,
+   * writing the kernel values into the results vector.  The memory of the
+   * results vector is reused if it already has the right size.
+   *
+   * @param distances Vector of distances to evaluate the kernel on.
+   * @param results Vector to store kernel values in.
+   */
+  void Evaluate(const arma::vec& distances, arma::vec& results) const;
+
   /**
    * Evaluate the Gradient of Epanechnikov kernel
    * given that the distance between the two
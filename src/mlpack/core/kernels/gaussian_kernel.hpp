@@ -81,6 +81,19 @@ class GaussianKernel
     return exp(gamma * std::pow(t, 2.0));
   }
 
+  /**
+   * Evaluation of the Gaussian kernel for a vector of distances at once.  The
+   * results vector is overwritten; its memory is reused if it already has the
+   * right size, so no allocation happens in steady state.
+   *
+   * @param distances Vector of distances to evaluate the kernel on.
+   * @param results Vector to store kernel values in.
+   */
+  void Evaluate(const arma::vec& distances, arma::vec& results) const
+  {
+    results = arma::exp(gamma * arma::square(distances));
+  }
+
   /**
    * Evaluation of the gradient of Gaussian kernel
    * given the distance between two points.
@@ -0,0 +1,239 @@
+/**
+ * @file core/kernels/kernel_matrix.hpp
+ * @author Ryan Curtin
+ *
+ * Blocked construction of kernel (Gram) matrices, shared by KernelPCA, the
+ * Nystroem method, and FastMKS.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_KERNELS_KERNEL_MATRIX_HPP
+#define MLPACK_CORE_KERNELS_KERNEL_MATRIX_HPP
+
+#include <mlpack/prereqs.hpp>
+#include "kernel_traits.hpp"
+
+namespace mlpack {
+namespace kernel {
+
+/**
+ * Evaluate one tile of a kernel matrix.  The generic rule evaluates the
+ * kernel directly on each pair of columns; the specializations below handle
+ * kernels that are functions of the squared Euclidean distance or of the
+ * inner product (according to KernelTraits) by computing all pairwise values
+ * of the tile with a single matrix product.
+ */
+template<typename KernelType,
+         typename MatTypeA,
+         typename MatTypeB,
+         bool UsesSquaredDistance =
+             KernelTraits<KernelType>::UsesSquaredDistance,
+         bool UsesInnerProduct = KernelTraits<KernelType>::UsesInnerProduct>
+struct KernelMatrixTileRule
+{
+  static void Evaluate(const MatTypeA& a,
+                       const MatTypeB& b,
+                       const size_t aBegin,
+                       const size_t aCount,
+                       const size_t bBegin,
+                       const size_t bCount,
+                       const arma::vec& /* aNorms */,
+                       const arma::vec& /* bNorms */,
+                       const KernelType& kernel,
+                       arma::mat& kernelMatrix)
+  {
+    for (size_t j = 0; j < bCount; ++j)
+      for (size_t i = 0; i < aCount; ++i)
+        kernelMatrix(aBegin + i, bBegin + j) =
+            kernel.Evaluate(a.col(aBegin + i), b.col(bBegin + j));
+  }
+};
+
+template<typename KernelType, typename MatTypeA, typename MatTypeB>
+struct KernelMatrixTileRule<KernelType, MatTypeA, MatTypeB, true, false>
+{
+  static void Evaluate(const MatTypeA& a,
+                       const MatTypeB& b,
+                       const size_t aBegin,
+                       const size_t aCount,
+                       const size_t bBegin,
+                       const size_t bCount,
+                       const arma::vec& aNorms,
+                       const arma::vec& bNorms,
+                       const KernelType& kernel,
+                       arma::mat& kernelMatrix)
+  {
+    // ||x - y||^2 = ||x||^2 + ||y||^2 - 2 x^T y, so all pairwise squared
+    // distances of the tile come out of one GEMM plus rank-one corrections.
+    arma::mat distances = -2.0 * arma::mat(
+        arma::trans(a.cols(aBegin, aBegin + aCount - 1)) *
+        b.cols(bBegin, bBegin + bCount - 1));
+    distances.each_col() += aNorms.subvec(aBegin, aBegin + aCount - 1);
+    distances.each_row() +=
+        bNorms.subvec(bBegin, bBegin + bCount - 1).t();
+
+    // Rounding can push tiny squared distances slightly below zero.
+    distances.transform([&kernel](double distanceSquared)
+        { return kernel.Evaluate(std::sqrt(
+              (distanceSquared > 0.0) ? distanceSquared : 0.0)); });
+
+    kernelMatrix.submat(aBegin, bBegin, aBegin + aCount - 1,
+        bBegin + bCount - 1) = distances;
+  }
+};
+
+template<typename KernelType,
+         typename MatTypeA,
+         typename MatTypeB,
+         bool UsesSquaredDistance>
+struct KernelMatrixTileRule<KernelType, MatTypeA, MatTypeB,
+    UsesSquaredDistance, true>
+{
+  static void Evaluate(const MatTypeA& a,
+                       const MatTypeB& b,
+                       const size_t aBegin,
+                       const size_t aCount,
+                       const size_t bBegin,
+                       const size_t bCount,
+                       const arma::vec& aNorms,
+                       const arma::vec& bNorms,
+                       const KernelType& /* kernel */,
+                       arma::mat& kernelMatrix)
+  {
+    // All pairwise inner products of the tile come out of one GEMM.
+    arma::mat products(arma::trans(a.cols(aBegin, aBegin + aCount - 1)) *
+        b.cols(bBegin, bBegin + bCount - 1));
+
+    // A normalized inner-product kernel (e.g. the cosine kernel) divides by
+    // the norms of the points.
+    if (KernelTraits<KernelType>::IsNormalized)
+    {
+      products.each_col() /= arma::sqrt(
+          aNorms.subvec(aBegin, aBegin + aCount - 1));
+      products.each_row() /= arma::sqrt(
+          bNorms.subvec(bBegin, bBegin + bCount - 1)).t();
+    }
+
+    kernelMatrix.submat(aBegin, bBegin, aBegin + aCount - 1,
+        bBegin + bCount - 1) = products;
+  }
+};
+
+/**
+ * Compute the full kernel matrix between two sets of points, so that
+ * kernelMatrix(i, j) = k(a_i, b_j).  The computation is tiled: tiles are
+ * distributed across OpenMP threads, and kernels that are functions of the
+ * squared Euclidean distance or of the inner product are evaluated with one
+ * matrix product per tile instead of per-pair kernel calls.
+ *
+ * @param a First set of points (one column per point).
+ * @param b Second set of points (one column per point).
+ * @param kernelMatrix Matrix to store kernel evaluations into (a.n_cols rows,
+ *     b.n_cols columns).
+ * @param kernel Kernel to evaluate.
+ * @param blockSize Number of points per tile dimension.
+ */
+template<typename KernelType, typename MatTypeA, typename MatTypeB>
+void KernelMatrix(const MatTypeA& a,
+                  const MatTypeB& b,
+                  arma::mat& kernelMatrix,
+                  const KernelType& kernel,
+                  const size_t blockSize = 128)
+{
+  kernelMatrix.set_size(a.n_cols, b.n_cols);
+  if (a.n_cols == 0 || b.n_cols == 0)
+    return;
+
+  const size_t tileSize = (blockSize == 0) ? 128 : blockSize;
+
+  // Squared column norms are only needed by the squared-distance rule and by
+  // normalized inner-product kernels.
+  arma::vec aNorms, bNorms;
+  if (KernelTraits<KernelType>::UsesSquaredDistance ||
+      (KernelTraits<KernelType>::UsesInnerProduct &&
+       KernelTraits<KernelType>::IsNormalized))
+  {
+    aNorms = arma::vec(arma::trans(arma::sum(arma::square(a), 0)));
+    bNorms = arma::vec(arma::trans(arma::sum(arma::square(b), 0)));
+  }
+
+  const size_t aBlocks = (a.n_cols + tileSize - 1) / tileSize;
+  const size_t bBlocks = (b.n_cols + tileSize - 1) / tileSize;
+
+  // Each tile writes a disjoint block of the output.
+  #pragma omp parallel for schedule(dynamic)
+  for (omp_size_t tile = 0; tile < (omp_size_t) (aBlocks * bBlocks); ++tile)
+  {
+    const size_t aBegin = ((size_t) tile / bBlocks) * tileSize;
+    const size_t bBegin = ((size_t) tile % bBlocks) * tileSize;
+    const size_t aCount = (aBegin + tileSize > a.n_cols) ?
+        a.n_cols - aBegin : tileSize;
+    const size_t bCount = (bBegin + tileSize > b.n_cols) ?
+        b.n_cols - bBegin : tileSize;
+
+    KernelMatrixTileRule<KernelType, MatTypeA, MatTypeB>::Evaluate(a, b,
+        aBegin, aCount, bBegin, bCount, aNorms, bNorms, kernel, kernelMatrix);
+  }
+}
+
+/**
+ * Compute the symmetric kernel (Gram) matrix of one set of points, so that
+ * kernelMatrix(i, j) = k(x_i, x_j).  Only the tiles of the upper triangular
+ * part are evaluated; the lower triangular part is mirrored afterwards, which
+ * roughly halves the work compared to the cross-kernel overload.
+ *
+ * @param data Set of points (one column per point).
+ * @param kernelMatrix Matrix to store kernel evaluations into.
+ * @param kernel Kernel to evaluate.
+ * @param blockSize Number of points per tile dimension.
+ */
+template<typename KernelType, typename MatType>
+void KernelMatrix(const MatType& data,
+                  arma::mat& kernelMatrix,
+                  const KernelType& kernel,
+                  const size_t blockSize = 128)
+{
+  kernelMatrix.set_size(data.n_cols, data.n_cols);
+  if (data.n_cols == 0)
+    return;
+
+  const size_t tileSize = (blockSize == 0) ? 128 : blockSize;
+
+  arma::vec norms;
+  if (KernelTraits<KernelType>::UsesSquaredDistance ||
+      (KernelTraits<KernelType>::UsesInnerProduct &&
+       KernelTraits<KernelType>::IsNormalized))
+    norms = arma::vec(arma::trans(arma::sum(arma::square(data), 0)));
+
+  // Enumerate the tiles of the upper triangular part, so they can be
+  // distributed evenly across threads.
+  const size_t blocks = (data.n_cols + tileSize - 1) / tileSize;
+  std::vector<std::pair<size_t, size_t>> tiles;
+  for (size_t ai = 0; ai < blocks; ++ai)
+    for (size_t bi = ai; bi < blocks; ++bi)
+      tiles.push_back(std::make_pair(ai * tileSize, bi * tileSize));
+
+  #pragma omp parallel for schedule(dynamic)
+  for (omp_size_t tile = 0; tile < (omp_size_t) tiles.size(); ++tile)
+  {
+    const size_t aBegin = tiles[tile].first;
+    const size_t bBegin = tiles[tile].second;
+    const size_t aCount = (aBegin + tileSize > data.n_cols) ?
+        data.n_cols - aBegin : tileSize;
+    const size_t bCount = (bBegin + tileSize > data.n_cols) ?
+        data.n_cols - bBegin : tileSize;
+
+    KernelMatrixTileRule<KernelType, MatType, MatType>::Evaluate(data, data,
+        aBegin, aCount, bBegin, bCount, norms, norms, kernel, kernelMatrix);
+  }
+
+  kernelMatrix = arma::symmatu(kernelMatrix);
+}
+
+} // namespace kernel
+} // namespace mlpack
+
+#endif
@@ -36,6 +36,13 @@ class KernelTraits
    * If true, then the kernel include a squared distance, ||x - y||^2 .
    */
   static const bool UsesSquaredDistance = false;
+
+  /**
+   * If true, then the kernel is a function of the inner product x^T y (and,
+   * if the kernel is also normalized, of the norms of x and y), so batches of
+   * kernel evaluations can be computed as a matrix product.
+   */
+  static const bool UsesInnerProduct = false;
 };
 
 } // namespace kernel
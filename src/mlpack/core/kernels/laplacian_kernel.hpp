@@ -78,6 +78,19 @@ class LaplacianKernel
     return exp(-t / bandwidth);
   }
 
+  /**
+   * Evaluation of the Laplacian kernel for a vector of distances at once.
+   * The results vector is overwritten; its memory is reused if it already has
+   * the right size.
+   *
+   * @param distances Vector of distances to evaluate the kernel on.
+   * @param results Vector to store kernel values in.
+   */
+  void Evaluate(const arma::vec& distances, arma::vec& results) const
+  {
+    results = arma::exp(-distances / bandwidth);
+  }
+
   /**
    * Evaluation of the gradient of the Laplacian kernel
    * given the distance between two points.
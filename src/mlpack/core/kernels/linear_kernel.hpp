@@ -15,6 +15,7 @@
 #define MLPACK_CORE_KERNELS_LINEAR_KERNEL_HPP
 
 #include <mlpack/prereqs.hpp>
+#include "kernel_traits.hpp"
 
 namespace mlpack {
 namespace kernel {
@@ -60,6 +61,21 @@ class LinearKernel
   void serialize(Archive& /* ar */, const unsigned int /* version */) { }
 };
 
+//! Kernel traits of the linear kernel.
+template<>
+class KernelTraits<LinearKernel>
+{
+ public:
+  //! The linear kernel is not normalized: K(x, x) can be arbitrary.
+  static const bool IsNormalized = false;
+
+  //! The linear kernel doesn't include a squared distance.
+  static const bool UsesSquaredDistance = false;
+
+  //! The linear kernel is exactly the inner product.
+  static const bool UsesInnerProduct = true;
+};
+
 } // namespace kernel
 } // namespace mlpack
 
@@ -15,6 +15,8 @@
  */
 #include "pspectrum_string_kernel.hpp"
 
+#include <algorithm>
+
 using namespace std;
 using namespace mlpack;
 using namespace mlpack::kernel;
@@ -31,11 +33,18 @@ mlpack::kernel::PSpectrumStringKernel::PSpectrumStringKernel(
     const size_t p) :
     p(p)
 {
-  // We have to assemble the counts of substrings.  This is not a particularly
-  // fast operation, unfortunately, but it only needs to be done once.
+  // We have to assemble the counts of substrings.  Each length-p window is
+  // fingerprinted with a rolling hash, so no per-substring strings are ever
+  // allocated, and the count tables are flat sorted arrays.
   Log::Info << "Assembling counts of substrings of length " << p << "."
       << std::endl;
 
+  // The contribution of the oldest character in a full window; used to roll
+  // the hash forward.
+  uint64_t leadPower = 1;
+  for (size_t j = 0; j + 1 < p; ++j)
+    leadPower *= fingerprintBase;
+
   // Resize for number of datasets.
   counts.resize(datasets.size());
 
@@ -46,42 +55,86 @@ mlpack::kernel::PSpectrumStringKernel::PSpectrumStringKernel(
     // Resize for number of strings in dataset.
     counts[dataset].resize(set.size());
 
-    // Inspect each string in the dataset.
-    for (size_t index = 0; index < set.size(); ++index)
+    // Each string is counted independently, so the strings of the dataset can
+    // be processed in parallel.
+    #pragma omp parallel for schedule(dynamic)
+    for (omp_size_t index = 0; index < (omp_size_t) set.size(); ++index)
     {
       // Convenience references.
       const std::string& str = set[index];
-      std::map<std::string, int>& mapping = counts[dataset][index];
+      CountTable& table = counts[dataset][index];
 
-      size_t start = 0;
-      while ((start + p) <= str.length())
-      {
-        string sub = str.substr(start, p);
+      // Fingerprint every valid window with a rolling hash.  A window is
+      // valid if all of its characters are alphanumeric; any other character
+      // resets the run.
+      std::vector<uint64_t> fingerprints;
+      if (str.length() >= p)
+        fingerprints.reserve(str.length() - p + 1);
 
-        // Convert all characters to lowercase.
-        bool invalid = false;
-        for (size_t j = 0; j < p; ++j)
+      uint64_t hash = 0;
+      size_t run = 0; // Number of characters currently in the hash.
+      for (size_t i = 0; i < str.length(); ++i)
+      {
+        if (!isalnum(str[i]))
         {
-          if (!isalnum(sub[j]))
-          {
-            invalid = true;
-            break; // Only consider substrings with alphanumerics.
-          }
-
-          sub[j] = tolower(sub[j]);
+          // Only consider substrings with alphanumerics.
+          hash = 0;
+          run = 0;
+          continue;
         }
 
-        // Increment position in string.
-        ++start;
-
-        if (!invalid)
+        if (run == p)
         {
-          // Add to the map.
-          ++mapping[sub];
+          // Remove the contribution of the oldest character of the window.
+          hash -= leadPower * (uint64_t) (unsigned char) tolower(str[i - p]);
+          --run;
         }
+
+        hash = hash * fingerprintBase +
+            (uint64_t) (unsigned char) tolower(str[i]);
+        ++run;
+
+        if (run == p)
+          fingerprints.push_back(hash);
+      }
+
+      // Sort the fingerprints and run-length encode them into the flat count
+      // table.
+      std::sort(fingerprints.begin(), fingerprints.end());
+      for (size_t i = 0; i < fingerprints.size(); ++i)
+      {
+        if (!table.empty() && table.back().first == fingerprints[i])
+          ++table.back().second;
+        else
+          table.push_back(std::make_pair(fingerprints[i], 1));
       }
     }
   }
 
   Log::Info << "Substring extraction complete." << std::endl;
 }
+
+uint64_t mlpack::kernel::PSpectrumStringKernel::Fingerprint(
+    const std::string& substring)
+{
+  uint64_t hash = 0;
+  for (size_t i = 0; i < substring.length(); ++i)
+    hash = hash * fingerprintBase +
+        (uint64_t) (unsigned char) tolower(substring[i]);
+  return hash;
+}
+
+int mlpack::kernel::PSpectrumStringKernel::Count(
+    const size_t dataset,
+    const size_t index,
+    const std::string& substring) const
+{
+  const CountTable& table = counts[dataset][index];
+  const uint64_t fingerprint = Fingerprint(substring);
+
+  const CountTable::const_iterator it = std::lower_bound(table.begin(),
+      table.end(), std::make_pair(fingerprint, 0));
+  if (it != table.end() && it->first == fingerprint)
+    return it->second;
+  return 0;
+}
@@ -16,8 +16,9 @@
 #ifndef MLPACK_CORE_KERNELS_PSPECTRUM_STRING_KERNEL_HPP
 #define MLPACK_CORE_KERNELS_PSPECTRUM_STRING_KERNEL_HPP
 
-#include <map>
+#include <cstdint>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include <mlpack/prereqs.hpp>
@@ -65,6 +66,16 @@ namespace kernel {
 class PSpectrumStringKernel
 {
  public:
+  /**
+   * A flat substring count table for a single string: (fingerprint, count)
+   * pairs sorted by fingerprint and stored contiguously.  The fingerprint is
+   * a 64-bit rolling hash of the lowercased substring, so counting and kernel
+   * evaluation never allocate or compare per-substring strings.  Two distinct
+   * substrings collide with probability on the order of 2^-64, which is
+   * negligible even for very large sequence collections.
+   */
+  typedef std::vector<std::pair<uint64_t, int>> CountTable;
+
   /**
    * Initialize the PSpectrumStringKernel with the given string datasets.  For
    * more information on this, see the general class documentation.
@@ -89,12 +100,34 @@ class PSpectrumStringKernel
   template<typename VecType>
   double Evaluate(const VecType& a, const VecType& b) const;
 
-  //! Access the lists of substrings.
-  const std::vector<std::vector<std::map<std::string, int> > >& Counts() const
-  { return counts; }
-  //! Modify the lists of substrings.
-  std::vector<std::vector<std::map<std::string, int> > >& Counts()
+  /**
+   * Compute the fingerprint of a single substring, the same way the
+   * constructor fingerprints every length-p window of the datasets.  The
+   * substring is lowercased before hashing; it is the caller's responsibility
+   * to pass an alphanumeric substring of length p.
+   *
+   * @param substring Substring to fingerprint.
+   */
+  static uint64_t Fingerprint(const std::string& substring);
+
+  /**
+   * Get the count of the given substring in the given string of the given
+   * dataset.  This is mainly useful for inspection and testing; the kernel
+   * evaluation works directly on the count tables.
+   *
+   * @param dataset Index of the dataset.
+   * @param index Index of the string in the dataset.
+   * @param substring Substring to look up.
+   */
+  int Count(const size_t dataset,
+            const size_t index,
+            const std::string& substring) const;
+
+  //! Access the substring count tables.
+  const std::vector<std::vector<CountTable> >& Counts() const
   { return counts; }
+  //! Modify the substring count tables.
+  std::vector<std::vector<CountTable> >& Counts() { return counts; }
 
   //! Access the value of p.
   size_t P() const { return p; }
@@ -102,12 +135,15 @@ class PSpectrumStringKernel
   size_t& P() { return p; }
 
  private:
-  //! Mappings of the datasets to counts of substrings.  Such a huge structure
-  //! is not wonderful...
-  std::vector<std::vector<std::map<std::string, int> > > counts;
+  //! Fingerprint count tables for each string of each dataset.
+  std::vector<std::vector<CountTable> > counts;
 
   //! The value of p to use in calculation.
   size_t p;
+
+  //! Base of the polynomial rolling hash (an arbitrary large odd constant;
+  //! arithmetic is modulo 2^64 via unsigned overflow).
+  static constexpr uint64_t fingerprintBase = 0x100000001b3;
 };
 
 } // namespace kernel
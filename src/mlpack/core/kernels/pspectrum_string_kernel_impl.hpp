@@ -36,38 +36,35 @@ template<typename VecType>
 double PSpectrumStringKernel::Evaluate(const VecType& a,
                                        const VecType& b) const
 {
-  // Get the map of substrings for the two strings we are interested in.
-  const std::map<std::string, int>& aMap = counts[a[0]][a[1]];
-  const std::map<std::string, int>& bMap = counts[b[0]][b[1]];
+  // Get the count tables for the two strings we are interested in.
+  const CountTable& aTable = counts[a[0]][a[1]];
+  const CountTable& bTable = counts[b[0]][b[1]];
 
   double eval = 0;
 
-  // Loop through the two maps (which, when iterated through, are sorted
-  // alphabetically).
-  std::map<std::string, int>::const_iterator aIt = aMap.begin();
-  std::map<std::string, int>::const_iterator bIt = bMap.begin();
+  // Merge the two tables, which are sorted by fingerprint; matching
+  // fingerprints correspond to matching substrings.
+  CountTable::const_iterator aIt = aTable.begin();
+  CountTable::const_iterator bIt = bTable.begin();
 
-  while ((aIt != aMap.end()) && (bIt != bMap.end()))
+  while ((aIt != aTable.end()) && (bIt != bTable.end()))
   {
-    // Compare alphabetically (this is how std::map is ordered).
-    int result = (*aIt).first.compare((*bIt).first);
-
-    if (result == 0) // The same substring.
+    if (aIt->first == bIt->first) // The same substring.
     {
-      eval += ((*aIt).second * (*bIt).second);
+      eval += (aIt->second * bIt->second);
 
       // Now increment both.
       ++aIt;
       ++bIt;
     }
-    else if (result > 0)
+    else if (aIt->first > bIt->first)
     {
-      // aIt is "ahead" of bIt (alphabetically); so increment bIt to "catch up".
+      // aIt is "ahead" of bIt; so increment bIt to "catch up".
       ++bIt;
     }
     else
     {
-      // bIt is "ahead" of aIt (alphabetically); so increment aIt to "catch up".
+      // bIt is "ahead" of aIt; so increment aIt to "catch up".
       ++aIt;
     }
   }
@@ -100,6 +100,19 @@ class SphericalKernel
   {
     return (t <= bandwidth) ? 1.0 : 0.0;
   }
+
+  /**
+   * Evaluate the spherical kernel for a vector of distances at once, writing
+   * the kernel values into the results vector.
+   *
+   * @param distances Vector of distances to evaluate the kernel on.
+   * @param results Vector to store kernel values in.
+   */
+  void Evaluate(const arma::vec& distances, arma::vec& results) const
+  {
+    results = arma::conv_to<arma::vec>::from(distances <= bandwidth);
+  }
+
   double Gradient(double t)
   {
     return t == bandwidth ? arma::datum::nan : 0.0;
@@ -63,6 +63,18 @@ class TriangularKernel
     return std::max(0.0, (1 - distance) / bandwidth);
   }
 
+  /**
+   * Evaluate the triangular kernel for a vector of distances at once, writing
+   * the kernel values into the results vector.
+   *
+   * @param distances Vector of distances to evaluate the kernel on.
+   * @param results Vector to store kernel values in.
+   */
+  void Evaluate(const arma::vec& distances, arma::vec& results) const
+  {
+    results = arma::clamp((1.0 - distances) / bandwidth, 0.0, DBL_MAX);
+  }
+
   /**
    * Evaluate the gradient of triangular kernel
    * given that the distance between the two
@@ -0,0 +1,101 @@
+/**
+ * @file core/math/blocked_ops.hpp
+ * @author Ryan Curtin
+ *
+ * Blocked, cache-friendly data movement primitives: a tiled matrix transpose
+ * and multi-column gather/scatter utilities.  These exist because several
+ * consumers of column-major data (tree splits scanning dimensions, block
+ * reshaping) otherwise perform long strided or element-wise accesses.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_MATH_BLOCKED_OPS_HPP
+#define MLPACK_CORE_MATH_BLOCKED_OPS_HPP
+
+#include <mlpack/prereqs.hpp>
+
+namespace mlpack {
+namespace math {
+
+/**
+ * Transpose the input matrix into the output matrix with cache-oblivious
+ * recursive blocking.  The matrix is recursively split along its larger
+ * dimension until a tile fits comfortably in L1 cache, so both the reads and
+ * the writes of each tile stay cache-resident regardless of the matrix shape.
+ * Strips of columns are processed in parallel when OpenMP is available.
+ *
+ * For large matrices this is considerably faster than an element-wise
+ * strided transpose; use it when a row-wise consumer needs a one-off
+ * transposed copy of a column-major dataset.
+ *
+ * @param input Matrix to transpose.
+ * @param output Matrix to store the transpose in; it is resized to
+ *     (input.n_cols x input.n_rows).
+ */
+template<typename eT>
+void BlockedTranspose(const arma::Mat<eT>& input, arma::Mat<eT>& output);
+
+/**
+ * Gather the given columns of the input matrix into a contiguous output
+ * matrix, in the given order: output.col(j) = input.col(indices[j]).  The
+ * column copies are contiguous memory moves and are performed in parallel
+ * when OpenMP is available.
+ *
+ * @param input Matrix to gather from.
+ * @param indices Column indices to gather, in output order.
+ * @param output Matrix to store the gathered columns in; it is resized to
+ *     (input.n_rows x indices.n_elem).
+ */
+template<typename eT>
+void GatherColumns(const arma::Mat<eT>& input,
+                   const arma::uvec& indices,
+                   arma::Mat<eT>& output);
+
+/**
+ * Scatter the columns of the input matrix into the given positions of the
+ * output matrix: output.col(indices[j]) = input.col(j).  This is the inverse
+ * of GatherColumns() when the indices are distinct; the output matrix must
+ * already be sized, and columns of the output that are not named by any index
+ * are left untouched.  The column copies are performed in parallel when
+ * OpenMP is available.
+ *
+ * @param input Matrix whose columns are scattered.
+ * @param indices Destination column index for each input column.
+ * @param output Pre-sized matrix to scatter into.
+ */
+template<typename eT>
+void ScatterColumns(const arma::Mat<eT>& input,
+                    const arma::uvec& indices,
+                    arma::Mat<eT>& output);
+
+/**
+ * Copy a segment of one row of a matrix into a contiguous buffer:
+ * output[i] = input(row, begin + i) for i in [0, count).  A row of a
+ * column-major matrix is strided in memory, so consumers that scan a row
+ * several times (dimension scans in tree splits, for instance) should gather
+ * it once with this and work on the contiguous copy.
+ *
+ * @param input Matrix to read from.
+ * @param row Row to copy.
+ * @param begin First column of the segment.
+ * @param count Number of columns in the segment.
+ * @param output Row vector to store the segment in; it is resized to count
+ *     elements.
+ */
+template<typename MatType, typename eT>
+void GatherRow(const MatType& input,
+               const size_t row,
+               const size_t begin,
+               const size_t count,
+               arma::Row<eT>& output);
+
+} // namespace math
+} // namespace mlpack
+
+// Include implementation.
+#include "blocked_ops_impl.hpp"
+
+#endif
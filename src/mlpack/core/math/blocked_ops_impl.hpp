@@ -0,0 +1,139 @@
+/**
+ * @file core/math/blocked_ops_impl.hpp
+ * @author Ryan Curtin
+ *
+ * Implementation of the blocked data movement primitives.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_MATH_BLOCKED_OPS_IMPL_HPP
+#define MLPACK_CORE_MATH_BLOCKED_OPS_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "blocked_ops.hpp"
+
+#include <algorithm>
+
+namespace mlpack {
+namespace math {
+
+/**
+ * Recursive kernel of BlockedTranspose(): split the given block along its
+ * larger dimension until it is no larger than a tile that fits in L1 cache,
+ * then transpose the tile element-wise.  Not intended to be called directly.
+ */
+template<typename eT>
+inline void BlockedTransposeRecursion(const arma::Mat<eT>& input,
+                                      arma::Mat<eT>& output,
+                                      const size_t rowBegin,
+                                      const size_t rowCount,
+                                      const size_t colBegin,
+                                      const size_t colCount)
+{
+  // A 64x64 tile of doubles is 32KB read plus 32KB written, which fits
+  // comfortably in typical L1/L2 caches.
+  const size_t tileSize = 64;
+
+  if (rowCount <= tileSize && colCount <= tileSize)
+  {
+    for (size_t c = colBegin; c < colBegin + colCount; ++c)
+      for (size_t r = rowBegin; r < rowBegin + rowCount; ++r)
+        output(c, r) = input(r, c);
+    return;
+  }
+
+  // Split the larger dimension in half and recurse.
+  if (rowCount >= colCount)
+  {
+    const size_t half = rowCount / 2;
+    BlockedTransposeRecursion(input, output, rowBegin, half, colBegin,
+        colCount);
+    BlockedTransposeRecursion(input, output, rowBegin + half, rowCount - half,
+        colBegin, colCount);
+  }
+  else
+  {
+    const size_t half = colCount / 2;
+    BlockedTransposeRecursion(input, output, rowBegin, rowCount, colBegin,
+        half);
+    BlockedTransposeRecursion(input, output, rowBegin, rowCount,
+        colBegin + half, colCount - half);
+  }
+}
+
+template<typename eT>
+inline void BlockedTranspose(const arma::Mat<eT>& input, arma::Mat<eT>& output)
+{
+  output.set_size(input.n_cols, input.n_rows);
+  if (input.n_elem == 0)
+    return;
+
+  // Hand strips of input columns to the threads; each strip is transposed
+  // with the cache-oblivious recursion.  The strips write disjoint row bands
+  // of the output, so no synchronization is needed.
+  const size_t stripSize = 256;
+  const size_t numStrips = (input.n_cols + stripSize - 1) / stripSize;
+
+  #pragma omp parallel for schedule(static)
+  for (omp_size_t strip = 0; strip < (omp_size_t) numStrips; ++strip)
+  {
+    const size_t colBegin = strip * stripSize;
+    const size_t colCount = std::min(stripSize,
+        (size_t) input.n_cols - colBegin);
+    BlockedTransposeRecursion(input, output, 0, input.n_rows, colBegin,
+        colCount);
+  }
+}
+
+template<typename eT>
+inline void GatherColumns(const arma::Mat<eT>& input,
+                          const arma::uvec& indices,
+                          arma::Mat<eT>& output)
+{
+  output.set_size(input.n_rows, indices.n_elem);
+
+  // Each column copy is one contiguous memory move.
+  #pragma omp parallel for schedule(static)
+  for (omp_size_t j = 0; j < (omp_size_t) indices.n_elem; ++j)
+    output.col(j) = input.col(indices[j]);
+}
+
+template<typename eT>
+inline void ScatterColumns(const arma::Mat<eT>& input,
+                           const arma::uvec& indices,
+                           arma::Mat<eT>& output)
+{
+  if (indices.n_elem != input.n_cols)
+    throw std::invalid_argument("ScatterColumns(): one destination index is "
+        "required for each input column!");
+  if (output.n_rows != input.n_rows)
+    throw std::invalid_argument("ScatterColumns(): output matrix must have "
+        "the same number of rows as the input matrix!");
+
+  // Each column copy is one contiguous memory move.  Parallelism is safe only
+  // because each input column writes to its own output column (the indices
+  // are expected to be distinct).
+  #pragma omp parallel for schedule(static)
+  for (omp_size_t j = 0; j < (omp_size_t) input.n_cols; ++j)
+    output.col(indices[j]) = input.col(j);
+}
+
+template<typename MatType, typename eT>
+inline void GatherRow(const MatType& input,
+                      const size_t row,
+                      const size_t begin,
+                      const size_t count,
+                      arma::Row<eT>& output)
+{
+  output.set_size(count);
+  for (size_t i = 0; i < count; ++i)
+    output[i] = input(row, begin + i);
+}
+
+} // namespace math
+} // namespace mlpack
+
+#endif
@@ -40,9 +40,39 @@ inline arma::Mat<eT> ColumnCovariance(const arma::Mat<eT>& x,
     const size_t n = xAlias.n_cols;
     const eT normVal = (normType == 0) ? ((n > 1) ? eT(n - 1) : eT(1)) : eT(n);
 
-    const arma::Mat<eT> tmp = xAlias.each_col() - arma::mean(xAlias, 1);
+    // Accumulate x * x^T over column blocks and apply the mean correction
+    // afterwards, instead of centering the data into a full temporary copy.
+    // Each block is a rank-k update computed as one GEMM, so the data is
+    // streamed through exactly once.
+    const arma::Col<eT> acc = arma::sum(xAlias, 1);
 
-    out = tmp * tmp.t();
+    out.zeros(xAlias.n_rows, xAlias.n_rows);
+
+    const size_t blockSize = 256;
+    const size_t numBlocks = (n + blockSize - 1) / blockSize;
+
+    #pragma omp parallel
+    {
+      arma::Mat<eT> localOut(out.n_rows, out.n_cols, arma::fill::zeros);
+
+      #pragma omp for schedule(static)
+      for (omp_size_t block = 0; block < (omp_size_t) numBlocks; ++block)
+      {
+        const size_t begin = block * blockSize;
+        const size_t end = std::min(begin + blockSize, n);
+
+        const auto xBlock = xAlias.cols(begin, end - 1);
+        localOut += xBlock * xBlock.t();
+      }
+
+      // Combine calculated state from each thread.
+      #pragma omp critical (columnCovarianceMerge)
+      {
+        out += localOut;
+      }
+    }
+
+    out -= (acc * acc.t()) / eT(n);
     out /= normVal;
   }
 
@@ -0,0 +1,151 @@
+/**
+ * @file core/math/fast_math.hpp
+ *
+ * Approximate transcendental functions for likelihood-heavy code paths.
+ * FastExp() and FastLog() trade the last bits of libm's accuracy (they are
+ * good to roughly 1e-7 relative error) for branch-light polynomial kernels
+ * that the compiler can inline and vectorize, which matters in E-step style
+ * loops that spend most of their time exponentiating log-likelihoods.
+ *
+ * The batch overloads apply the approximations to every element of an
+ * Armadillo object.  Log-space reductions (LogSumExp(), LogAdd()) route
+ * through these kernels when mlpack is configured with FAST_MATH=ON (which
+ * defines MLPACK_FAST_MATH); by default they use libm.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_MATH_FAST_MATH_HPP
+#define MLPACK_CORE_MATH_FAST_MATH_HPP
+
+#include <mlpack/prereqs.hpp>
+#include <cstring>
+
+namespace mlpack {
+namespace math {
+
+/**
+ * Approximate e^x with roughly 1e-7 relative error.  The argument is reduced
+ * to x = k log(2) + r with |r| <= log(2) / 2, e^r is evaluated with a degree
+ * seven polynomial, and the result is scaled by 2^k through exponent bit
+ * manipulation.  Arguments outside the representable range saturate to 0 or
+ * infinity, like std::exp().
+ *
+ * @param x Exponent.
+ */
+inline double FastExp(const double x)
+{
+  // Saturate outside the representable range (also catches NaN comparisons
+  // conservatively; NaN propagates through the polynomial below otherwise).
+  if (x > 709.0)
+    return std::numeric_limits<double>::infinity();
+  if (x < -708.0)
+    return 0.0;
+
+  // Reduce: x = k log(2) + r, |r| <= log(2) / 2.
+  const double kd = std::floor(x * 1.4426950408889634 + 0.5);
+  const double r = x - kd * 0.6931471805599453;
+
+  // e^r by a degree seven Taylor polynomial (remainder below 3e-8 on the
+  // reduced range), evaluated in Horner form.
+  const double p = 1.0 + r * (1.0 + r * (0.5 + r * (1.0 / 6.0 +
+      r * (1.0 / 24.0 + r * (1.0 / 120.0 + r * (1.0 / 720.0 +
+      r * (1.0 / 5040.0)))))));
+
+  // Scale by 2^k by building the bits of the power of two directly.
+  const int64_t k = (int64_t) kd;
+  const uint64_t scaleBits = (uint64_t) (k + 1023) << 52;
+  double scale;
+  std::memcpy(&scale, &scaleBits, sizeof(scale));
+
+  return p * scale;
+}
+
+/**
+ * Approximate log(x) with roughly 1e-7 relative error.  The argument is split
+ * into mantissa and exponent, the mantissa is mapped to [sqrt(1/2), sqrt(2))
+ * and its logarithm evaluated with an atanh series.  Zero gives -infinity and
+ * negative arguments give NaN, like std::log().
+ *
+ * @param x Argument; should be non-negative.
+ */
+inline double FastLog(const double x)
+{
+  if (x <= 0.0)
+  {
+    return (x == 0.0) ? -std::numeric_limits<double>::infinity() :
+        std::numeric_limits<double>::quiet_NaN();
+  }
+  if (x == std::numeric_limits<double>::infinity())
+    return x;
+
+  uint64_t bits;
+  double xScaled = x;
+  int exponent = 0;
+
+  // Bring subnormals into the normal range first.
+  if (x < std::numeric_limits<double>::min())
+  {
+    xScaled = x * 18014398509481984.0; // 2^54.
+    exponent = -54;
+  }
+
+  std::memcpy(&bits, &xScaled, sizeof(bits));
+  exponent += (int) ((bits >> 52) & 0x7ff) - 1023;
+
+  // Replace the exponent bits to get the mantissa m in [1, 2).
+  bits = (bits & 0x000fffffffffffffULL) | 0x3ff0000000000000ULL;
+  double m;
+  std::memcpy(&m, &bits, sizeof(m));
+
+  // Map to [sqrt(1/2), sqrt(2)) so the series argument stays small.
+  if (m > 1.4142135623730951)
+  {
+    m *= 0.5;
+    ++exponent;
+  }
+
+  // log(m) = 2 atanh((m - 1) / (m + 1)), by a short odd polynomial (the
+  // series argument is below 0.172, so the truncation error is under 1e-9).
+  const double s = (m - 1.0) / (m + 1.0);
+  const double s2 = s * s;
+  const double series = 2.0 * s * (1.0 + s2 * (1.0 / 3.0 + s2 * (1.0 / 5.0 +
+      s2 * (1.0 / 7.0 + s2 * (1.0 / 9.0)))));
+
+  return (double) exponent * 0.6931471805599453 + series;
+}
+
+/**
+ * Apply FastExp() to every element: y = e^x, elementwise.
+ *
+ * @param x Input vector or matrix of exponents.
+ * @param y Object to store the elementwise exponentials into.
+ */
+template<typename InType, typename OutType>
+void FastExp(const InType& x, OutType& y)
+{
+  y = x;
+  y.transform([](const typename OutType::elem_type v)
+      { return FastExp(v); });
+}
+
+/**
+ * Apply FastLog() to every element: y = log(x), elementwise.
+ *
+ * @param x Input vector or matrix of values.
+ * @param y Object to store the elementwise logarithms into.
+ */
+template<typename InType, typename OutType>
+void FastLog(const InType& x, OutType& y)
+{
+  y = x;
+  y.transform([](const typename OutType::elem_type v)
+      { return FastLog(v); });
+}
+
+} // namespace math
+} // namespace mlpack
+
+#endif // MLPACK_CORE_MATH_FAST_MATH_HPP
@@ -36,6 +36,30 @@ T LogAdd(T x, T y);
 template<typename T>
 typename T::elem_type AccuLog(const T& x);
 
+/**
+ * Sum the log values in each column of a matrix: y(j) = log(sum_i e^x(i, j)).
+ * Unlike repeated calls to LogAdd(), this is computed with vectorized
+ * (max-shifted) exponentials and logarithms, so the compiler can use SIMD
+ * instructions.  (T should be an Armadillo matrix type.)
+ *
+ * @param x matrix of log values
+ * @param y vector to store the per-column log sums into (one per column)
+ */
+template<typename T>
+void LogSumExp(const T& x, arma::Col<typename T::elem_type>& y);
+
+/**
+ * Sum the log values in each row of a matrix: y(i) = log(sum_j e^x(i, j)).
+ * Unlike repeated calls to LogAdd(), this is computed with vectorized
+ * (max-shifted) exponentials and logarithms, so the compiler can use SIMD
+ * instructions.  (T should be an Armadillo matrix type.)
+ *
+ * @param x matrix of log values
+ * @param y vector to store the per-row log sums into (one per row)
+ */
+template<typename T>
+void LogSumExpT(const T& x, arma::Col<typename T::elem_type>& y);
+
 } // namespace math
 } // namespace mlpack
 
@@ -13,6 +13,7 @@
 #define MLPACK_CORE_MATH_LOG_ADD_IMPL_HPP
 
 #include "log_add.hpp"
+#include "fast_math.hpp"
 
 namespace mlpack {
 namespace math {
@@ -47,8 +48,15 @@ T LogAdd(T x, T y)
     r = y;
   }
 
-  return (r == -std::numeric_limits<T>::infinity() ||
-          d == -std::numeric_limits<T>::infinity()) ? r : r + log(1 + exp(d));
+  if (r == -std::numeric_limits<T>::infinity() ||
+      d == -std::numeric_limits<T>::infinity())
+    return r;
+
+#ifdef MLPACK_FAST_MATH
+  return r + FastLog(1 + FastExp(d));
+#else
+  return r + log(1 + exp(d));
+#endif
 }
 
 /**
@@ -71,6 +79,66 @@ typename T::elem_type AccuLog(const T& x)
   return sum;
 }
 
+/**
+ * Sum the log values in each column of a matrix.
+ *
+ * @param x matrix of log values
+ * @param y vector to store the per-column log sums into
+ */
+template<typename T>
+void LogSumExp(const T& x, arma::Col<typename T::elem_type>& y)
+{
+  typedef typename T::elem_type ElemType;
+
+  // Shift by the maximum of each column so that the exponentials cannot
+  // overflow; the result is exact regardless of the shift.
+  arma::Col<ElemType> maxs = arma::max(x, 0).t();
+#ifdef MLPACK_FAST_MATH
+  arma::Mat<ElemType> shifted;
+  FastExp(x.each_row() - maxs.t(), shifted);
+  arma::Col<ElemType> sums = arma::sum(shifted, 0).t();
+  FastLog(sums, sums);
+  y = maxs + sums;
+#else
+  y = maxs + arma::log(arma::sum(arma::exp(x.each_row() - maxs.t()), 0)).t();
+#endif
+
+  // Columns holding no mass at all have a maximum of -inf, which turns the
+  // shifted exponentials into NaNs; patch those results directly.
+  y.elem(arma::find(maxs == -std::numeric_limits<ElemType>::infinity())).fill(
+      -std::numeric_limits<ElemType>::infinity());
+}
+
+/**
+ * Sum the log values in each row of a matrix.
+ *
+ * @param x matrix of log values
+ * @param y vector to store the per-row log sums into
+ */
+template<typename T>
+void LogSumExpT(const T& x, arma::Col<typename T::elem_type>& y)
+{
+  typedef typename T::elem_type ElemType;
+
+  // Shift by the maximum of each row so that the exponentials cannot
+  // overflow; the result is exact regardless of the shift.
+  arma::Col<ElemType> maxs = arma::max(x, 1);
+#ifdef MLPACK_FAST_MATH
+  arma::Mat<ElemType> shifted;
+  FastExp(x.each_col() - maxs, shifted);
+  arma::Col<ElemType> sums = arma::sum(shifted, 1);
+  FastLog(sums, sums);
+  y = maxs + sums;
+#else
+  y = maxs + arma::log(arma::sum(arma::exp(x.each_col() - maxs), 1));
+#endif
+
+  // Rows holding no mass at all have a maximum of -inf, which turns the
+  // shifted exponentials into NaNs; patch those results directly.
+  y.elem(arma::find(maxs == -std::numeric_limits<ElemType>::infinity())).fill(
+      -std::numeric_limits<ElemType>::infinity());
+}
+
 } // namespace math
 } // namespace mlpack
 
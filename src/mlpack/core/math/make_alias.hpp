@@ -29,6 +29,25 @@ arma::Cube<ElemType> MakeAlias(arma::Cube<ElemType>& input,
       input.n_slices, false, strict);
 }
 
+/**
+ * Make an alias of a column range of one slice of a dense cube.  This is
+ * useful for batched sequence processing, where a timestep corresponds to a
+ * slice and a batch to a contiguous set of columns; the returned matrix is a
+ * view into the cube's memory, so no copy is made.  If strict is true, then
+ * the alias cannot be resized or pointed at new memory.
+ */
+template<typename ElemType>
+arma::Mat<ElemType> MakeAlias(arma::Cube<ElemType>& input,
+                              const size_t slice,
+                              const size_t firstCol,
+                              const size_t numCols,
+                              const bool strict = true)
+{
+  // Use the advanced constructor.
+  return arma::Mat<ElemType>(input.slice(slice).colptr(firstCol),
+      input.n_rows, numCols, false, strict);
+}
+
 /**
  * Make an alias of a dense matrix.  If strict is true, then the alias cannot be
  * resized or pointed at new memory.
@@ -42,6 +61,21 @@ arma::Mat<ElemType> MakeAlias(arma::Mat<ElemType>& input,
       strict);
 }
 
+/**
+ * Make an alias of a column range of a dense matrix.  If strict is true, then
+ * the alias cannot be resized or pointed at new memory.
+ */
+template<typename ElemType>
+arma::Mat<ElemType> MakeAlias(arma::Mat<ElemType>& input,
+                              const size_t firstCol,
+                              const size_t numCols,
+                              const bool strict = true)
+{
+  // Use the advanced constructor.
+  return arma::Mat<ElemType>(input.colptr(firstCol), input.n_rows, numCols,
+      false, strict);
+}
+
 /**
  * Make an alias of a dense row.  If strict is true, then the alias cannot be
  * resized or pointed at new memory.
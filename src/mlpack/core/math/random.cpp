@@ -1,25 +1,71 @@
 /**
  * @file core/math/random.cpp
  *
- * Declarations of global random number generators.
+ * Definitions of the thread-local random number generator streams.
  *
  * mlpack is free software; you may redistribute it and/or modify it under the
  * terms of the 3-clause BSD license.  You should have received a copy of the
  * 3-clause BSD license along with mlpack.  If not, see
  * http://www.opensource.org/licenses/BSD-3-Clause for more information.
  */
+#include <atomic>
 #include <random>
 #include <mlpack/mlpack_export.hpp>
 
+#ifdef HAS_OPENMP
+  #include <omp.h>
+#endif
+
 namespace mlpack {
 namespace math {
 
-// Global random object.
-MLPACK_EXPORT std::mt19937 randGen;
-// Global uniform distribution.
-MLPACK_EXPORT std::uniform_real_distribution<> randUniformDist(0.0, 1.0);
-// Global normal distribution.
-MLPACK_EXPORT std::normal_distribution<> randNormalDist(0.0, 1.0);
+// Base seed from which each thread derives its own generator stream.
+MLPACK_EXPORT size_t randBaseSeed = std::mt19937::default_seed;
+// Bumped by RandomSeed(); threads lazily re-derive their streams when they
+// notice a new generation.
+MLPACK_EXPORT std::atomic<size_t> randSeedGeneration(0);
+
+// Per-thread random object.
+MLPACK_EXPORT thread_local std::mt19937 randGen;
+// Per-thread uniform distribution.
+MLPACK_EXPORT thread_local std::uniform_real_distribution<>
+    randUniformDist(0.0, 1.0);
+// Per-thread normal distribution.
+MLPACK_EXPORT thread_local std::normal_distribution<> randNormalDist(0.0, 1.0);
+
+// Hands out a distinct stream index to each thread when OpenMP thread numbers
+// are not available.
+static std::atomic<size_t> randStreamCounter(0);
+
+std::mt19937& RandGen()
+{
+  // The stream index of this thread.  OpenMP thread numbers are stable across
+  // parallel regions, so they make the thread-to-stream mapping reproducible;
+  // without OpenMP, each new thread just takes the next free index.
+#ifdef HAS_OPENMP
+  static thread_local const size_t streamId = (size_t) omp_get_thread_num();
+#else
+  static thread_local const size_t streamId = randStreamCounter++;
+#endif
+  // The seed generation this thread's generator was last derived from.
+  static thread_local size_t seenGeneration = size_t(-1);
+
+  const size_t generation = randSeedGeneration.load(std::memory_order_acquire);
+  if (seenGeneration != generation)
+  {
+    // Derive a reproducible stream for this thread: the base seed selects the
+    // experiment, and the stream index separates the threads.
+    std::seed_seq sequence{ (unsigned int) randBaseSeed,
+                            (unsigned int) streamId };
+    randGen.seed(sequence);
+    // The normal distribution caches a second variate; drop it so that
+    // reseeding gives a fully deterministic stream.
+    randNormalDist.reset();
+    seenGeneration = generation;
+  }
+
+  return randGen;
+}
 
 } // namespace math
 } // namespace mlpack
@@ -13,6 +13,7 @@
 
 #include <mlpack/prereqs.hpp>
 #include <mlpack/mlpack_export.hpp>
+#include <atomic>
 #include <random>
 
 namespace mlpack {
@@ -23,24 +24,47 @@ namespace math /** Miscellaneous math routines. */ {
  * correctly on Windows.
  */
 
-// Global random object.
-extern MLPACK_EXPORT std::mt19937 randGen;
-// Global uniform distribution.
-extern MLPACK_EXPORT std::uniform_real_distribution<> randUniformDist;
-// Global normal distribution.
-extern MLPACK_EXPORT std::normal_distribution<> randNormalDist;
+// Base seed from which each thread derives its own generator stream; set by
+// RandomSeed().
+extern MLPACK_EXPORT size_t randBaseSeed;
+// Seed generation; bumped by RandomSeed() so that every thread (including
+// pooled OpenMP worker threads) lazily re-derives its stream on its next draw.
+extern MLPACK_EXPORT std::atomic<size_t> randSeedGeneration;
+
+// Per-thread random object.  Each thread owns an independent stream derived
+// from the base seed and a stable stream index, so parallel sampling neither
+// races nor serializes on a shared generator.
+extern MLPACK_EXPORT thread_local std::mt19937 randGen;
+// Per-thread uniform distribution.
+extern MLPACK_EXPORT thread_local std::uniform_real_distribution<>
+    randUniformDist;
+// Per-thread normal distribution.
+extern MLPACK_EXPORT thread_local std::normal_distribution<> randNormalDist;
+
+/**
+ * Get the random generator stream of the calling thread.  If RandomSeed() has
+ * been called since this thread last drew a number, the stream is first
+ * re-derived from the new base seed, so seeding takes effect on every thread
+ * no matter when it was created.  Prefer this accessor over using randGen
+ * directly.
+ */
+MLPACK_EXPORT std::mt19937& RandGen();
 
 /**
  * Set the random seed used by the random functions (Random() and RandInt()).
  * The seed is casted to a 32-bit integer before being given to the random
  * number generator, but a size_t is taken as a parameter for API consistency.
+ * Each thread derives its own reproducible stream from this seed and its
+ * stream index.
  *
  * @param seed Seed for the random number generator.
  */
 inline void RandomSeed(const size_t seed)
 {
   #if (!defined(BINDING_TYPE) || BINDING_TYPE != BINDING_TYPE_TEST)
-    randGen.seed((uint32_t) seed);
+    randBaseSeed = seed;
+    randSeedGeneration.fetch_add(1, std::memory_order_release);
+    RandGen(); // Re-derive the calling thread's stream immediately.
     srand((unsigned int) seed);
     arma::arma_rng::set_seed(seed);
   #else
@@ -59,14 +83,18 @@ inline void RandomSeed(const size_t seed)
 inline void FixedRandomSeed()
 {
   const static size_t seed = rand();
-  randGen.seed((uint32_t) seed);
+  randBaseSeed = seed;
+  randSeedGeneration.fetch_add(1, std::memory_order_release);
+  RandGen(); // Re-derive the calling thread's stream immediately.
   srand((unsigned int) seed);
   arma::arma_rng::set_seed(seed);
 }
 
 inline void CustomRandomSeed(const size_t seed)
 {
-  randGen.seed((uint32_t) seed);
+  randBaseSeed = seed;
+  randSeedGeneration.fetch_add(1, std::memory_order_release);
+  RandGen(); // Re-derive the calling thread's stream immediately.
   srand((unsigned int) seed);
   arma::arma_rng::set_seed(seed);
 }
@@ -77,7 +105,7 @@ inline void CustomRandomSeed(const size_t seed)
  */
 inline double Random()
 {
-  return randUniformDist(randGen);
+  return randUniformDist(RandGen());
 }
 
 /**
@@ -85,7 +113,7 @@ inline double Random()
  */
 inline double Random(const double lo, const double hi)
 {
-  return lo + (hi - lo) * randUniformDist(randGen);
+  return lo + (hi - lo) * randUniformDist(RandGen());
 }
 
 /**
@@ -104,7 +132,7 @@ inline double RandBernoulli(const double input)
  */
 inline int RandInt(const int hiExclusive)
 {
-  return (int) std::floor((double) hiExclusive * randUniformDist(randGen));
+  return (int) std::floor((double) hiExclusive * randUniformDist(RandGen()));
 }
 
 /**
@@ -113,7 +141,7 @@ inline int RandInt(const int hiExclusive)
 inline int RandInt(const int lo, const int hiExclusive)
 {
   return lo + (int) std::floor((double) (hiExclusive - lo)
-                               * randUniformDist(randGen));
+                               * randUniformDist(RandGen()));
 }
 
 /**
@@ -121,7 +149,7 @@ inline int RandInt(const int lo, const int hiExclusive)
  */
 inline double RandNormal()
 {
-  return randNormalDist(randGen);
+  return randNormalDist(RandGen());
 }
 
 /**
@@ -133,7 +161,7 @@ inline double RandNormal()
  */
 inline double RandNormal(const double mean, const double variance)
 {
-  return variance * randNormalDist(randGen) + mean;
+  return variance * randNormalDist(RandGen()) + mean;
 }
 
 /**
@@ -17,12 +17,51 @@
 namespace mlpack {
 namespace math {
 
+/**
+ * Generate a random ordering of the given number of points.  This can be used
+ * as a lazy "shuffled view" of a dataset: instead of materializing a shuffled
+ * copy, extract shuffled batches directly with, e.g.,
+ * `data.cols(ordering.subvec(begin, begin + batchSize - 1))`.
+ */
+inline arma::uvec ShuffleOrdering(const size_t count)
+{
+  return arma::shuffle(arma::linspace<arma::uvec>(0, count - 1, count));
+}
+
+/**
+ * Apply the given ordering to the columns of the matrix in-place, so that
+ * column i of the input ends up as column ordering[i] of the result.  The
+ * permutation cycles are followed with column swaps, so no shuffled copy of
+ * the matrix is ever built; this is useful when the data is too large to hold
+ * twice in memory.  To shuffle a dataset and its labels consistently, apply
+ * the same ordering to both.
+ */
+template<typename MatType>
+void PermuteColumns(MatType& points,
+                    const arma::uvec& ordering,
+                    const std::enable_if_t<!arma::is_SpMat<MatType>::value>* = 0,
+                    const std::enable_if_t<!arma::is_Cube<MatType>::value>* = 0)
+{
+  // The copy of the ordering is destroyed as the cycles are resolved.
+  arma::uvec perm = ordering;
+  for (size_t i = 0; i < perm.n_elem; ++i)
+  {
+    while (perm[i] != i)
+    {
+      points.swap_cols(i, perm[i]);
+      std::swap(perm[i], perm[perm[i]]);
+    }
+  }
+}
+
 /**
  * Shuffle a dataset and associated labels (or responses).  It is expected that
  * inputPoints and inputLabels have the same number of columns (so, be sure that
  * inputLabels, if it is a vector, is a row vector).
  *
- * Shuffled data will be output into outputPoints and outputLabels.
+ * Shuffled data will be output into outputPoints and outputLabels.  If the
+ * inputs and outputs are the same objects, the shuffle is performed in-place
+ * without building shuffled copies.
  */
 template<typename MatType, typename LabelsType>
 void ShuffleData(const MatType& inputPoints,
@@ -33,8 +72,15 @@ void ShuffleData(const MatType& inputPoints,
                  const std::enable_if_t<!arma::is_Cube<MatType>::value>* = 0)
 {
   // Generate ordering.
-  arma::uvec ordering = arma::shuffle(arma::linspace<arma::uvec>(0,
-      inputPoints.n_cols - 1, inputPoints.n_cols));
+  const arma::uvec ordering = ShuffleOrdering(inputPoints.n_cols);
+
+  if (&inputPoints == &outputPoints && &inputLabels == &outputLabels)
+  {
+    // Shuffle in-place instead of building full shuffled copies.
+    PermuteColumns(outputPoints, ordering);
+    PermuteColumns(outputLabels, ordering);
+    return;
+  }
 
   outputPoints = inputPoints.cols(ordering);
   outputLabels = inputLabels.cols(ordering);
@@ -56,8 +102,7 @@ void ShuffleData(const MatType& inputPoints,
                  const std::enable_if_t<!arma::is_Cube<MatType>::value>* = 0)
 {
   // Generate ordering.
-  arma::uvec ordering = arma::shuffle(arma::linspace<arma::uvec>(0,
-      inputPoints.n_cols - 1, inputPoints.n_cols));
+  const arma::uvec ordering = ShuffleOrdering(inputPoints.n_cols);
 
   // Extract coordinate list representation.
   arma::umat locations(2, inputPoints.n_nonzero);
@@ -109,8 +154,7 @@ void ShuffleData(const MatType& inputPoints,
                  const std::enable_if_t<arma::is_Cube<LabelsType>::value>* = 0)
 {
   // Generate ordering.
-  arma::uvec ordering = arma::shuffle(arma::linspace<arma::uvec>(0,
-      inputPoints.n_cols - 1, inputPoints.n_cols));
+  const arma::uvec ordering = ShuffleOrdering(inputPoints.n_cols);
 
   // Properly handle the case where the input and output data are the same
   // object.
@@ -154,7 +198,8 @@ void ShuffleData(const MatType& inputPoints,
  * vector).
  *
  * Shuffled data will be output into outputPoints and outputLabels and
- * outputWeights.
+ * outputWeights.  If the inputs and outputs are the same objects, the shuffle
+ * is performed in-place without building shuffled copies.
  */
 template<typename MatType, typename LabelsType, typename WeightsType>
 void ShuffleData(const MatType& inputPoints,
@@ -167,8 +212,17 @@ void ShuffleData(const MatType& inputPoints,
                  const std::enable_if_t<!arma::is_Cube<MatType>::value>* = 0)
 {
   // Generate ordering.
-  arma::uvec ordering = arma::shuffle(arma::linspace<arma::uvec>(0,
-      inputPoints.n_cols - 1, inputPoints.n_cols));
+  const arma::uvec ordering = ShuffleOrdering(inputPoints.n_cols);
+
+  if (&inputPoints == &outputPoints && &inputLabels == &outputLabels &&
+      &inputWeights == &outputWeights)
+  {
+    // Shuffle in-place instead of building full shuffled copies.
+    PermuteColumns(outputPoints, ordering);
+    PermuteColumns(outputLabels, ordering);
+    PermuteColumns(outputWeights, ordering);
+    return;
+  }
 
   outputPoints = inputPoints.cols(ordering);
   outputLabels = inputLabels.cols(ordering);
@@ -195,8 +249,7 @@ void ShuffleData(const MatType& inputPoints,
                  const std::enable_if_t<!arma::is_Cube<MatType>::value>* = 0)
 {
   // Generate ordering.
-  arma::uvec ordering = arma::shuffle(arma::linspace<arma::uvec>(0,
-      inputPoints.n_cols - 1, inputPoints.n_cols));
+  const arma::uvec ordering = ShuffleOrdering(inputPoints.n_cols);
 
   // Extract coordinate list representation.
   arma::umat locations(2, inputPoints.n_nonzero);
@@ -64,7 +64,7 @@ class MahalanobisDistance
    * Initialize the Mahalanobis distance with the empty matrix as covariance.
    * Don't call Evaluate() until you set the covariance with Covariance()!
    */
-  MahalanobisDistance() { }
+  MahalanobisDistance() : factorUpToDate(false) { }
 
   /**
    * Initialize the Mahalanobis distance with the identity matrix of the given
@@ -73,7 +73,8 @@ class MahalanobisDistance
    * @param dimensionality Dimesnsionality of the covariance matrix.
    */
   MahalanobisDistance(const size_t dimensionality) :
-      covariance(arma::eye<arma::mat>(dimensionality, dimensionality)) { }
+      covariance(arma::eye<arma::mat>(dimensionality, dimensionality)),
+      factorUpToDate(false) { }
 
   /**
    * Initialize the Mahalanobis distance with the given covariance matrix.  The
@@ -82,7 +83,8 @@ class MahalanobisDistance
    * @param covariance The covariance matrix to use for this distance.
    */
   MahalanobisDistance(arma::mat covariance) :
-      covariance(std::move(covariance)) { }
+      covariance(std::move(covariance)),
+      factorUpToDate(false) { }
 
   /**
    * Evaluate the distance between the two given points using this Mahalanobis
@@ -108,15 +110,56 @@ class MahalanobisDistance
    *
    * @return Reference to the covariance matrix.
    */
-  arma::mat& Covariance() { return covariance; }
+  arma::mat& Covariance()
+  {
+    // The caller may change the covariance through this reference, so the
+    // cached factorization can no longer be trusted.
+    factorUpToDate = false;
+    return covariance;
+  }
+
+  /**
+   * Get the upper-triangular Cholesky factor R of the covariance matrix, with
+   * @f$ Q = R^T R @f$, computing and caching it if necessary.  Distances can
+   * be evaluated as plain (squared) L2 distances between points multiplied by
+   * this factor.  The covariance matrix must be positive definite; a
+   * std::runtime_error is thrown otherwise.
+   */
+  const arma::mat& Factor();
+
+  /**
+   * Transform the given dataset by the Cholesky factor of the covariance
+   * matrix, so that plain L2 distances between whitened points equal
+   * Mahalanobis distances between the original points.  Transforming a
+   * dataset once and then searching with an LMetric is much faster than
+   * evaluating this metric per pair, and also allows the default KDTree to be
+   * used.
+   *
+   * @param dataset Dataset to transform.
+   * @param whitenedDataset Matrix to store the transformed dataset into.
+   */
+  void Whiten(const arma::mat& dataset, arma::mat& whitenedDataset);
 
   //! Serialize the Mahalanobis distance.
   template<typename Archive>
   void serialize(Archive& ar, const unsigned int version);
 
  private:
+  /**
+   * Recompute the cached Cholesky factor from the covariance matrix.  If the
+   * covariance matrix is not positive definite, the factor is left empty and
+   * evaluations fall back to the direct quadratic form.
+   */
+  void UpdateFactor();
+
   //! The covariance matrix associated with this distance.
   arma::mat covariance;
+
+  //! Cached upper-triangular Cholesky factor of the covariance matrix.
+  arma::mat factor;
+
+  //! Whether the cached factor matches the current covariance matrix.
+  bool factorUpToDate;
 };
 
 } // namespace metric
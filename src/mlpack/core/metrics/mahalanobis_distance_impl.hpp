@@ -25,6 +25,19 @@ template<typename VecTypeA, typename VecTypeB>
 double MahalanobisDistance<false>::Evaluate(const VecTypeA& a,
                                             const VecTypeB& b)
 {
+  if (!factorUpToDate)
+    UpdateFactor();
+
+  // Multiplying the difference by the cached Cholesky factor needs only the
+  // upper triangle, instead of the full covariance product per pair.
+  if (factor.n_elem > 0)
+  {
+    const arma::vec m = factor * (a - b);
+    return arma::dot(m, m);
+  }
+
+  // The covariance matrix is not positive definite, so no factorization
+  // exists; evaluate the quadratic form directly.
   arma::vec m = (a - b);
   arma::mat out = trans(m) * covariance * m; // 1x1
   return out[0];
@@ -40,13 +53,58 @@ double MahalanobisDistance<true>::Evaluate(const VecTypeA& a,
 {
   // Check if covariance matrix has been initialized.
   if (covariance.n_rows == 0)
+  {
     covariance = arma::eye<arma::mat>(a.n_elem, a.n_elem);
+    factorUpToDate = false;
+  }
+
+  if (!factorUpToDate)
+    UpdateFactor();
+
+  if (factor.n_elem > 0)
+  {
+    const arma::vec m = factor * (a - b);
+    return sqrt(arma::dot(m, m));
+  }
 
   arma::vec m = (a - b);
   arma::mat out = trans(m) * covariance * m; // 1x1;
   return sqrt(out[0]);
 }
 
+template<bool TakeRoot>
+const arma::mat& MahalanobisDistance<TakeRoot>::Factor()
+{
+  if (!factorUpToDate)
+    UpdateFactor();
+
+  if (factor.n_elem == 0 && covariance.n_elem > 0)
+  {
+    Log::Fatal << "MahalanobisDistance::Factor(): covariance matrix is not "
+        << "positive definite!" << std::endl;
+  }
+
+  return factor;
+}
+
+template<bool TakeRoot>
+void MahalanobisDistance<TakeRoot>::UpdateFactor()
+{
+  // If the covariance matrix is not positive definite, leave the factor empty
+  // so that evaluations fall back to the direct quadratic form.
+  if (!arma::chol(factor, covariance))
+    factor.reset();
+
+  factorUpToDate = true;
+}
+
+template<bool TakeRoot>
+void MahalanobisDistance<TakeRoot>::Whiten(const arma::mat& dataset,
+                                           arma::mat& whitenedDataset)
+{
+  whitenedDataset = Factor() * dataset;
+}
+
 // Serialize the Mahalanobis distance.
 template<bool TakeRoot>
 template<typename Archive>
@@ -54,6 +112,10 @@ void MahalanobisDistance<TakeRoot>::serialize(Archive& ar,
                                               const unsigned int /* version */)
 {
   ar & BOOST_SERIALIZATION_NVP(covariance);
+
+  // A loaded covariance matrix invalidates any cached factorization.
+  if (Archive::is_loading::value)
+    factorUpToDate = false;
 }
 
 } // namespace metric
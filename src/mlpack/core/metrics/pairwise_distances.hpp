@@ -0,0 +1,414 @@
+/**
+ * @file core/metrics/pairwise_distances.hpp
+ * @author Ryan Curtin
+ *
+ * Batched distance computations: the distances of one point against many, and
+ * all pairs of distances between two sets of points.  For the LMetric family
+ * these are computed with vectorized expressions (and, for all-pairs L2
+ * distances, a matrix product) instead of one metric call per pair.  Sparse
+ * inputs dispatch to kernels that work on the nonzero entries only --
+ * index-merge loops for the Manhattan distance and sparse products for the
+ * L2 norm expansion -- so sparse datasets are never densified.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_METRICS_PAIRWISE_DISTANCES_HPP
+#define MLPACK_CORE_METRICS_PAIRWISE_DISTANCES_HPP
+
+#include <mlpack/prereqs.hpp>
+#include "lmetric.hpp"
+#include "mahalanobis_distance.hpp"
+
+namespace mlpack {
+namespace metric {
+
+/**
+ * Helper struct implementing batched distance computations for a given metric.
+ * The generic implementation evaluates the metric one pair at a time; it is
+ * specialized for the LMetric family, where the work can be expressed as
+ * vectorized column operations or a matrix product.
+ */
+template<typename MetricType>
+struct PairwiseDistanceRule
+{
+  //! Compute distances(j) = metric.Evaluate(point, set.col(j)) for all j.
+  template<typename VecType, typename MatType>
+  static void OneToMany(const VecType& point,
+                        const MatType& set,
+                        arma::vec& distances,
+                        MetricType& metric)
+  {
+    distances.set_size(set.n_cols);
+    for (size_t j = 0; j < set.n_cols; ++j)
+      distances[j] = metric.Evaluate(point, set.col(j));
+  }
+
+  //! Compute distances(i, j) = metric.Evaluate(a.col(i), b.col(j)) for all
+  //! pairs.
+  template<typename MatTypeA, typename MatTypeB>
+  static void AllPairs(const MatTypeA& a,
+                       const MatTypeB& b,
+                       arma::mat& distances,
+                       MetricType& metric)
+  {
+    distances.set_size(a.n_cols, b.n_cols);
+    for (size_t j = 0; j < b.n_cols; ++j)
+      for (size_t i = 0; i < a.n_cols; ++i)
+        distances(i, j) = metric.Evaluate(a.col(i), b.col(j));
+  }
+};
+
+/**
+ * Compute sum_i | a_i - b_i |^Power between two columns of sparse matrices
+ * with an index-merge loop over their nonzero entries, never touching the
+ * implicit zeros: entries present in both columns contribute the power of
+ * their difference, and entries present in only one contribute the power of
+ * their value.  The cost is linear in the number of nonzeros of the two
+ * columns, not in the dimensionality.
+ */
+template<int Power, typename eT>
+eT SparseLpPowerSum(const arma::SpMat<eT>& a,
+                    const size_t aCol,
+                    const arma::SpMat<eT>& b,
+                    const size_t bCol)
+{
+  eT sum = 0;
+  arma::uword ia = a.col_ptrs[aCol];
+  const arma::uword aEnd = a.col_ptrs[aCol + 1];
+  arma::uword ib = b.col_ptrs[bCol];
+  const arma::uword bEnd = b.col_ptrs[bCol + 1];
+
+  while (ia < aEnd && ib < bEnd)
+  {
+    const arma::uword rowA = a.row_indices[ia];
+    const arma::uword rowB = b.row_indices[ib];
+
+    if (rowA == rowB)
+    {
+      sum += std::pow(std::abs(a.values[ia] - b.values[ib]), (double) Power);
+      ++ia;
+      ++ib;
+    }
+    else if (rowA < rowB)
+    {
+      sum += std::pow(std::abs(a.values[ia]), (double) Power);
+      ++ia;
+    }
+    else
+    {
+      sum += std::pow(std::abs(b.values[ib]), (double) Power);
+      ++ib;
+    }
+  }
+  for (; ia < aEnd; ++ia)
+    sum += std::pow(std::abs(a.values[ia]), (double) Power);
+  for (; ib < bEnd; ++ib)
+    sum += std::pow(std::abs(b.values[ib]), (double) Power);
+
+  return sum;
+}
+
+/**
+ * Specialization for the Manhattan distance: each column of distances is
+ * computed with one vectorized pass over the set.  For sparse inputs, each
+ * pair is evaluated with an index-merge loop over the nonzero entries
+ * instead, so no column is ever densified.
+ */
+template<bool TakeRoot>
+struct PairwiseDistanceRule<LMetric<1, TakeRoot>>
+{
+  template<typename VecType, typename MatType>
+  static typename std::enable_if<
+      !arma::is_arma_sparse_type<MatType>::value, void>::type
+  OneToMany(const VecType& point,
+            const MatType& set,
+            arma::vec& distances,
+            LMetric<1, TakeRoot>& /* metric */)
+  {
+    const arma::vec pointVec(point);
+    distances = arma::sum(arma::abs(set.each_col() - pointVec), 0).t();
+  }
+
+  template<typename VecType, typename MatType>
+  static typename std::enable_if<
+      arma::is_arma_sparse_type<MatType>::value, void>::type
+  OneToMany(const VecType& point,
+            const MatType& set,
+            arma::vec& distances,
+            LMetric<1, TakeRoot>& /* metric */)
+  {
+    typedef typename MatType::elem_type ElemType;
+
+    // Materialize the expressions once; this only copies nonzero entries.
+    const arma::SpMat<ElemType> pointMat(point);
+    const arma::SpMat<ElemType> setMat(set);
+
+    distances.set_size(setMat.n_cols);
+    for (size_t j = 0; j < setMat.n_cols; ++j)
+      distances[j] = SparseLpPowerSum<1>(pointMat, 0, setMat, j);
+  }
+
+  template<typename MatTypeA, typename MatTypeB>
+  static typename std::enable_if<
+      !arma::is_arma_sparse_type<MatTypeA>::value &&
+      !arma::is_arma_sparse_type<MatTypeB>::value, void>::type
+  AllPairs(const MatTypeA& a,
+           const MatTypeB& b,
+           arma::mat& distances,
+           LMetric<1, TakeRoot>& /* metric */)
+  {
+    distances.set_size(a.n_cols, b.n_cols);
+    for (size_t j = 0; j < b.n_cols; ++j)
+    {
+      const arma::vec pointVec(b.col(j));
+      distances.col(j) = arma::sum(arma::abs(a.each_col() - pointVec), 0).t();
+    }
+  }
+
+  template<typename MatTypeA, typename MatTypeB>
+  static typename std::enable_if<
+      arma::is_arma_sparse_type<MatTypeA>::value ||
+      arma::is_arma_sparse_type<MatTypeB>::value, void>::type
+  AllPairs(const MatTypeA& a,
+           const MatTypeB& b,
+           arma::mat& distances,
+           LMetric<1, TakeRoot>& /* metric */)
+  {
+    typedef typename MatTypeA::elem_type ElemType;
+
+    const arma::SpMat<ElemType> aMat(a);
+    const arma::SpMat<ElemType> bMat(b);
+
+    distances.set_size(aMat.n_cols, bMat.n_cols);
+    for (size_t j = 0; j < bMat.n_cols; ++j)
+      for (size_t i = 0; i < aMat.n_cols; ++i)
+        distances(i, j) = SparseLpPowerSum<1>(aMat, i, bMat, j);
+  }
+};
+
+/**
+ * Specialization for the (squared) Euclidean distance.  One-to-many distances
+ * are a single vectorized pass; all-pairs distances expand
+ * || x - y ||^2 = || x ||^2 + || y ||^2 - 2 x^T y, so the dominant cost is a
+ * matrix product handled by BLAS (which blocks for cache internally).
+ */
+template<bool TakeRoot>
+struct PairwiseDistanceRule<LMetric<2, TakeRoot>>
+{
+  template<typename VecType, typename MatType>
+  static typename std::enable_if<
+      !arma::is_arma_sparse_type<MatType>::value, void>::type
+  OneToMany(const VecType& point,
+            const MatType& set,
+            arma::vec& distances,
+            LMetric<2, TakeRoot>& /* metric */)
+  {
+    const arma::vec pointVec(point);
+    distances = arma::sum(arma::square(set.each_col() - pointVec), 0).t();
+    if (TakeRoot)
+      distances = arma::sqrt(distances);
+  }
+
+  /**
+   * Sparse one-to-many distances use the same norm expansion as the
+   * all-pairs path: || x ||^2 and || y_j ||^2 come from one pass over the
+   * nonzeros, and the cross terms x^T y_j from one sparse vector-matrix
+   * product (an index-merge over nonzeros inside Armadillo), so the
+   * dimensionality never enters the cost.
+   */
+  template<typename VecType, typename MatType>
+  static typename std::enable_if<
+      arma::is_arma_sparse_type<MatType>::value, void>::type
+  OneToMany(const VecType& point,
+            const MatType& set,
+            arma::vec& distances,
+            LMetric<2, TakeRoot>& /* metric */)
+  {
+    typedef typename MatType::elem_type ElemType;
+
+    // Materialize the expressions once; this only copies nonzero entries.
+    const arma::SpMat<ElemType> pointMat(point);
+    const arma::SpMat<ElemType> setMat(set);
+
+    const double pointNorm = SparseColumnNorms(pointMat)[0];
+    const arma::vec setNorms = SparseColumnNorms(setMat);
+    const arma::mat cross(pointMat.t() * setMat);
+
+    distances.set_size(setMat.n_cols);
+    for (size_t j = 0; j < setMat.n_cols; ++j)
+    {
+      const double d = pointNorm + setNorms[j] - 2.0 * cross(0, j);
+      // Clamp tiny negative values produced by floating point cancellation.
+      distances[j] = TakeRoot ? std::sqrt((d > 0.0) ? d : 0.0) :
+          ((d > 0.0) ? d : 0.0);
+    }
+  }
+
+  template<typename MatTypeA, typename MatTypeB>
+  static typename std::enable_if<
+      !arma::is_arma_sparse_type<MatTypeA>::value &&
+      !arma::is_arma_sparse_type<MatTypeB>::value, void>::type
+  AllPairs(const MatTypeA& a,
+           const MatTypeB& b,
+           arma::mat& distances,
+           LMetric<2, TakeRoot>& /* metric */)
+  {
+    const arma::vec aNorms = arma::sum(arma::square(a), 0).t();
+    const arma::rowvec bNorms = arma::sum(arma::square(b), 0);
+
+    distances = -2.0 * (arma::trans(a) * b);
+    distances.each_col() += aNorms;
+    distances.each_row() += bNorms;
+
+    // Clamp tiny negative values produced by floating point cancellation.
+    if (TakeRoot)
+    {
+      distances.transform([](double d)
+          { return std::sqrt((d > 0.0) ? d : 0.0); });
+    }
+    else
+    {
+      distances.transform([](double d) { return (d > 0.0) ? d : 0.0; });
+    }
+  }
+
+  /**
+   * Sparse all-pairs distances keep the norm expansion, but the dominant
+   * cost becomes one sparse-times-sparse matrix product instead of a dense
+   * GEMM, so only nonzero entries are ever touched.
+   */
+  template<typename MatTypeA, typename MatTypeB>
+  static typename std::enable_if<
+      arma::is_arma_sparse_type<MatTypeA>::value ||
+      arma::is_arma_sparse_type<MatTypeB>::value, void>::type
+  AllPairs(const MatTypeA& a,
+           const MatTypeB& b,
+           arma::mat& distances,
+           LMetric<2, TakeRoot>& /* metric */)
+  {
+    typedef typename MatTypeA::elem_type ElemType;
+
+    const arma::SpMat<ElemType> aMat(a);
+    const arma::SpMat<ElemType> bMat(b);
+
+    const arma::vec aNorms = SparseColumnNorms(aMat);
+    const arma::vec bNorms = SparseColumnNorms(bMat);
+
+    distances = arma::mat(aMat.t() * bMat);
+    distances *= -2.0;
+    distances.each_col() += aNorms;
+    distances.each_row() += bNorms.t();
+
+    // Clamp tiny negative values produced by floating point cancellation.
+    if (TakeRoot)
+    {
+      distances.transform([](double d)
+          { return std::sqrt((d > 0.0) ? d : 0.0); });
+    }
+    else
+    {
+      distances.transform([](double d) { return (d > 0.0) ? d : 0.0; });
+    }
+  }
+
+ private:
+  //! Compute the squared L2 norm of every column in one pass over the
+  //! nonzero entries.
+  template<typename ElemType>
+  static arma::vec SparseColumnNorms(const arma::SpMat<ElemType>& m)
+  {
+    arma::vec norms(m.n_cols);
+    for (size_t j = 0; j < m.n_cols; ++j)
+    {
+      double norm = 0.0;
+      for (arma::uword i = m.col_ptrs[j]; i < m.col_ptrs[j + 1]; ++i)
+        norm += (double) (m.values[i] * m.values[i]);
+      norms[j] = norm;
+    }
+    return norms;
+  }
+};
+
+/**
+ * Specialization for the Mahalanobis distance: the points are whitened once
+ * through the cached Cholesky factor of the covariance (one matrix product),
+ * after which the distances are plain (squared) L2 distances in the whitened
+ * space.
+ */
+template<bool TakeRoot>
+struct PairwiseDistanceRule<MahalanobisDistance<TakeRoot>>
+{
+  template<typename VecType, typename MatType>
+  static void OneToMany(const VecType& point,
+                        const MatType& set,
+                        arma::vec& distances,
+                        MahalanobisDistance<TakeRoot>& metric)
+  {
+    const arma::vec whitenedPoint = metric.Factor() * point;
+    arma::mat whitenedSet = metric.Factor() * set;
+    whitenedSet.each_col() -= whitenedPoint;
+
+    distances = arma::sum(arma::square(whitenedSet), 0).t();
+    if (TakeRoot)
+      distances = arma::sqrt(distances);
+  }
+
+  template<typename MatTypeA, typename MatTypeB>
+  static void AllPairs(const MatTypeA& a,
+                       const MatTypeB& b,
+                       arma::mat& distances,
+                       MahalanobisDistance<TakeRoot>& metric)
+  {
+    arma::mat whitenedA, whitenedB;
+    metric.Whiten(a, whitenedA);
+    metric.Whiten(b, whitenedB);
+
+    LMetric<2, TakeRoot> euclidean;
+    PairwiseDistanceRule<LMetric<2, TakeRoot>>::AllPairs(whitenedA, whitenedB,
+        distances, euclidean);
+  }
+};
+
+/**
+ * Compute the distances between one point and every column of the given set:
+ * distances(j) = metric.Evaluate(point, set.col(j)).
+ *
+ * @param point The point to compute distances from.
+ * @param set The set of points to compute distances to.
+ * @param distances Vector to store the computed distances in.
+ * @param metric Instantiated metric.
+ */
+template<typename MetricType, typename VecType, typename MatType>
+void PairwiseDistances(const VecType& point,
+                       const MatType& set,
+                       arma::vec& distances,
+                       MetricType& metric)
+{
+  PairwiseDistanceRule<MetricType>::OneToMany(point, set, distances, metric);
+}
+
+/**
+ * Compute all pairs of distances between the columns of a and the columns of
+ * b: distances(i, j) = metric.Evaluate(a.col(i), b.col(j)).
+ *
+ * @param a First set of points.
+ * @param b Second set of points.
+ * @param distances Matrix to store the computed distances in.
+ * @param metric Instantiated metric.
+ */
+template<typename MetricType, typename MatTypeA, typename MatTypeB>
+void PairwiseDistances(const MatTypeA& a,
+                       const MatTypeB& b,
+                       arma::mat& distances,
+                       MetricType& metric)
+{
+  PairwiseDistanceRule<MetricType>::AllPairs(a, b, distances, metric);
+}
+
+} // namespace metric
+} // namespace mlpack
+
+#endif
@@ -0,0 +1,83 @@
+/**
+ * @file core/tree/batch_greedy_single_tree_traverser.hpp
+ * @author Marcos Pividori
+ *
+ * A batched version of the greedy single tree traverser: a whole batch of
+ * query points is pushed down the tree together, partitioned among the
+ * children at each node, so that every query sharing a path touches each
+ * node's data exactly once.  The RuleType class must implement the method
+ * 'GetBestChild()'.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_TREE_BATCH_GREEDY_SINGLE_TREE_TRAVERSER_HPP
+#define MLPACK_CORE_TREE_BATCH_GREEDY_SINGLE_TREE_TRAVERSER_HPP
+
+#include <mlpack/prereqs.hpp>
+
+namespace mlpack {
+namespace tree {
+
+/**
+ * A greedy traverser (no backtracking, one root-to-leaf path per query) that
+ * descends with a whole batch of queries at once.  Where the per-query
+ * GreedySingleTreeTraverser re-touches the top levels of the tree for every
+ * query, this traverser visits each node once per batch: it runs the base
+ * cases of every query in the batch against the node's points while they are
+ * hot in cache, then partitions the batch among the children by each query's
+ * best child and recurses into each nonempty part.  The per-query decisions
+ * (and therefore the results) are identical to running the per-query greedy
+ * traverser for each point.
+ */
+template<typename TreeType, typename RuleType>
+class BatchGreedySingleTreeTraverser
+{
+ public:
+  /**
+   * Instantiate the batched greedy single tree traverser with the given rule
+   * set.
+   */
+  BatchGreedySingleTreeTraverser(RuleType& rule);
+
+  /**
+   * Traverse the tree with the given batch of query points.  The batch is
+   * partitioned at every node, so the order of base cases differs from the
+   * per-query traverser, but the set of base cases per query is the same.
+   *
+   * @param queryIndices Indices of the query points to push down the tree.
+   * @param referenceNode The tree node to be traversed.
+   */
+  void Traverse(const std::vector<size_t>& queryIndices,
+                TreeType& referenceNode);
+
+  //! Get the number of prunes.
+  size_t NumPrunes() const { return numPrunes; }
+
+  //! Set value of minBaseCases.
+  size_t& MinBaseCases() { return minBaseCases; }
+
+  //! Get value of minBaseCases.
+  size_t MinBaseCases() const { return minBaseCases; }
+
+ private:
+  //! Reference to the rules with which the tree will be traversed.
+  RuleType& rule;
+
+  //! The number of nodes which have been pruned during traversal.
+  size_t numPrunes;
+
+  //! The number of base cases required. For example the number of nearest
+  //! neighbours(k) in case of knn.
+  size_t minBaseCases;
+};
+
+} // namespace tree
+} // namespace mlpack
+
+// Include implementation.
+#include "batch_greedy_single_tree_traverser_impl.hpp"
+
+#endif
@@ -0,0 +1,84 @@
+/**
+ * @file core/tree/batch_greedy_single_tree_traverser_impl.hpp
+ * @author Marcos Pividori
+ *
+ * A batched version of the greedy single tree traverser: a whole batch of
+ * query points is pushed down the tree together, partitioned among the
+ * children at each node, so that every query sharing a path touches each
+ * node's data exactly once.  The RuleType class must implement the method
+ * 'GetBestChild()'.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_TREE_BATCH_GREEDY_SINGLE_TREE_TRAVERSER_IMPL_HPP
+#define MLPACK_CORE_TREE_BATCH_GREEDY_SINGLE_TREE_TRAVERSER_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "batch_greedy_single_tree_traverser.hpp"
+
+namespace mlpack {
+namespace tree {
+
+template<typename TreeType, typename RuleType>
+BatchGreedySingleTreeTraverser<TreeType, RuleType>::
+BatchGreedySingleTreeTraverser(RuleType& rule) :
+    rule(rule),
+    numPrunes(0),
+    minBaseCases(0)
+{ /* Nothing to do. */ }
+
+template<typename TreeType, typename RuleType>
+void BatchGreedySingleTreeTraverser<TreeType, RuleType>::Traverse(
+    const std::vector<size_t>& queryIndices,
+    TreeType& referenceNode)
+{
+  if (queryIndices.empty())
+    return;
+
+  // Run the base cases of the whole batch against the points of this node;
+  // each reference point is loaded once and streamed past all the queries.
+  for (size_t i = 0; i < referenceNode.NumPoints(); ++i)
+    for (size_t j = 0; j < queryIndices.size(); ++j)
+      rule.BaseCase(queryIndices[j], referenceNode.Point(i));
+
+  if (referenceNode.IsLeaf())
+    return;
+
+  // Partition the batch among the children: each query goes to its best
+  // child, exactly as the per-query greedy traverser would descend.  Queries
+  // whose best child holds too few descendants fall back to base cases over
+  // the first descendants instead, as in the per-query traverser.
+  std::vector<std::vector<size_t>> childBatches(referenceNode.NumChildren());
+  for (size_t j = 0; j < queryIndices.size(); ++j)
+  {
+    const size_t queryIndex = queryIndices[j];
+    const size_t bestChild = rule.GetBestChild(queryIndex, referenceNode);
+    const size_t numDescendants =
+        referenceNode.Child(bestChild).NumDescendants();
+
+    if (numDescendants > minBaseCases)
+    {
+      // We are prunning all but one child.
+      numPrunes += referenceNode.NumChildren() - 1;
+      childBatches[bestChild].push_back(queryIndex);
+    }
+    else
+    {
+      // Run the base case over first minBaseCases number of descendants.
+      for (size_t i = 0; i <= minBaseCases; ++i)
+        rule.BaseCase(queryIndex, referenceNode.Descendant(i));
+    }
+  }
+
+  // Recurse into each child with the queries that chose it.
+  for (size_t c = 0; c < referenceNode.NumChildren(); ++c)
+    Traverse(childBatches[c], referenceNode.Child(c));
+}
+
+} // namespace tree
+} // namespace mlpack
+
+#endif
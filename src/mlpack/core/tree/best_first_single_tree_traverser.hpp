@@ -0,0 +1,81 @@
+/**
+ * @file core/tree/best_first_single_tree_traverser.hpp
+ *
+ * A best-first single tree traverser which expands nodes in order of their
+ * score, using a global priority queue.  An optional budget on the number of
+ * leaf nodes visited makes per-query work strictly bounded, at the cost of
+ * exactness.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_TREE_BEST_FIRST_SINGLE_TREE_TRAVERSER_HPP
+#define MLPACK_CORE_TREE_BEST_FIRST_SINGLE_TREE_TRAVERSER_HPP
+
+#include <mlpack/prereqs.hpp>
+
+namespace mlpack {
+namespace tree {
+
+/**
+ * The BestFirstSingleTreeTraverser traverses the tree in best-first order:
+ * nodes are kept in a priority queue keyed on the score assigned by the rule
+ * set, and the most promising node is always expanded next.  With an
+ * unlimited budget this visits exactly the nodes a depth-first traversal
+ * would (in a different order), but since the most promising subtrees are
+ * explored first, truncating the traversal after MaxLeafVisits() leaf nodes
+ * yields a good approximate result with strictly bounded work per query.
+ *
+ * The RuleType class must implement BaseCase(), the single-tree Score() and
+ * the single-tree Rescore() methods.
+ */
+template<typename TreeType, typename RuleType>
+class BestFirstSingleTreeTraverser
+{
+ public:
+  /**
+   * Instantiate the best-first single tree traverser with the given rule set.
+   */
+  BestFirstSingleTreeTraverser(RuleType& rule);
+
+  /**
+   * Traverse the tree with the given point.
+   *
+   * @param queryIndex The index of the point in the query set which is being
+   *     used as the query point.
+   * @param referenceNode The tree node to be traversed.
+   */
+  void Traverse(const size_t queryIndex, TreeType& referenceNode);
+
+  //! Get the number of prunes.
+  size_t NumPrunes() const { return numPrunes; }
+
+  //! Get the maximum number of leaves to visit per query (0 means no limit).
+  size_t MaxLeafVisits() const { return maxLeafVisits; }
+
+  //! Modify the maximum number of leaves to visit per query (0 means no
+  //! limit).
+  size_t& MaxLeafVisits() { return maxLeafVisits; }
+
+ private:
+  //! Reference to the rules with which the tree will be traversed.
+  RuleType& rule;
+
+  //! The number of nodes which have been pruned during traversal.
+  size_t numPrunes;
+
+  //! The maximum number of leaf nodes to visit per query; when this budget is
+  //! exhausted the traversal stops.  0 means no limit, in which case the
+  //! traversal is exact (modulo any approximation done by the rules).
+  size_t maxLeafVisits;
+};
+
+} // namespace tree
+} // namespace mlpack
+
+// Include implementation.
+#include "best_first_single_tree_traverser_impl.hpp"
+
+#endif
@@ -0,0 +1,94 @@
+/**
+ * @file core/tree/best_first_single_tree_traverser_impl.hpp
+ *
+ * Implementation of the best-first single tree traverser, which expands nodes
+ * in order of their score and optionally stops after a fixed number of leaf
+ * visits.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_TREE_BEST_FIRST_SINGLE_TREE_TRAVERSER_IMPL_HPP
+#define MLPACK_CORE_TREE_BEST_FIRST_SINGLE_TREE_TRAVERSER_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "best_first_single_tree_traverser.hpp"
+
+#include <queue>
+
+namespace mlpack {
+namespace tree {
+
+template<typename TreeType, typename RuleType>
+BestFirstSingleTreeTraverser<TreeType, RuleType>::BestFirstSingleTreeTraverser(
+    RuleType& rule) :
+    rule(rule),
+    numPrunes(0),
+    maxLeafVisits(0)
+{ /* Nothing to do. */ }
+
+template<typename TreeType, typename RuleType>
+void BestFirstSingleTreeTraverser<TreeType, RuleType>::Traverse(
+    const size_t queryIndex,
+    TreeType& referenceNode)
+{
+  // The priority queue holds (score, node) pairs ordered so that the node
+  // with the smallest (best) score is always expanded next.
+  typedef std::pair<double, TreeType*> QueueEntry;
+  std::priority_queue<QueueEntry, std::vector<QueueEntry>,
+      std::greater<QueueEntry>> queue;
+
+  const double rootScore = rule.Score(queryIndex, referenceNode);
+  if (rootScore == DBL_MAX)
+  {
+    ++numPrunes;
+    return;
+  }
+  queue.push(std::make_pair(rootScore, &referenceNode));
+
+  size_t leafVisits = 0;
+  while (!queue.empty())
+  {
+    const QueueEntry entry = queue.top();
+    queue.pop();
+    TreeType& node = *entry.second;
+
+    // The bound may have tightened since this node was enqueued, so check
+    // whether it can now be pruned.
+    if (rule.Rescore(queryIndex, node, entry.first) == DBL_MAX)
+    {
+      ++numPrunes;
+      continue;
+    }
+
+    // Run the base cases for any points held in this node.
+    for (size_t i = 0; i < node.NumPoints(); ++i)
+      rule.BaseCase(queryIndex, node.Point(i));
+
+    if (node.IsLeaf())
+    {
+      // Stop the traversal once the leaf visit budget is exhausted.
+      if (maxLeafVisits > 0 && ++leafVisits >= maxLeafVisits)
+        break;
+    }
+    else
+    {
+      // Score the children and enqueue any that cannot be pruned outright.
+      for (size_t i = 0; i < node.NumChildren(); ++i)
+      {
+        const double childScore = rule.Score(queryIndex, node.Child(i));
+        if (childScore == DBL_MAX)
+          ++numPrunes;
+        else
+          queue.push(std::make_pair(childScore, &node.Child(i)));
+      }
+    }
+  }
+}
+
+} // namespace tree
+} // namespace mlpack
+
+#endif
@@ -59,7 +59,7 @@ class BinarySpaceTree
   //! The type of element held in MatType.
   typedef typename MatType::elem_type ElemType;
 
-  typedef SplitType<BoundType<MetricType>, MatType> Split;
+  typedef SplitType<BoundType<MetricType, ElemType>, MatType> Split;
 
  private:
   //! The left child node.
@@ -75,7 +75,7 @@ class BinarySpaceTree
   //! children).
   size_t count;
   //! The bound object for this node.
-  BoundType<MetricType> bound;
+  BoundType<MetricType, ElemType> bound;
   //! Any extra data contained in the node.
   StatisticType stat;
   //! The distance from the centroid of this node to the centroid of the parent.
@@ -88,6 +88,12 @@ class BinarySpaceTree
   //! The dataset.  If we are the root of the tree, we own the dataset and must
   //! delete it.
   MatType* dataset;
+  //! If Compact() has been called on this (root) node, this is the contiguous
+  //! block of memory that holds all descendant nodes; otherwise NULL.
+  BinarySpaceTree* arena = NULL;
+  //! True if this node lives inside the arena of the root node, and therefore
+  //! does not own its children (the root's arena does).
+  bool inArena = false;
 
  public:
   //! A single-tree traverser for binary space trees; see
@@ -102,6 +108,11 @@ class BinarySpaceTree
   template<typename RuleType>
   class BreadthFirstDualTreeTraverser;
 
+  //! A parallel dual-tree traverser that shards the query tree across OpenMP
+  //! threads; see parallel_dual_tree_traverser.hpp.
+  template<typename RuleType>
+  class ParallelDualTreeTraverser;
+
   /**
    * Construct this as the root node of a binary space tree using the given
    * dataset.  This will copy the input matrix; if you don't want this, consider
@@ -109,8 +120,12 @@ class BinarySpaceTree
    *
    * @param data Dataset to create tree from.  This will be copied!
    * @param maxLeafSize Size of each leaf in the tree.
+   * @param parallelBuild If true, large subtrees will be built as parallel
+   *     OpenMP tasks (no effect if mlpack was built without OpenMP support).
    */
-  BinarySpaceTree(const MatType& data, const size_t maxLeafSize = 20);
+  BinarySpaceTree(const MatType& data,
+                  const size_t maxLeafSize = 20,
+                  const bool parallelBuild = false);
 
   /**
    * Construct this as the root node of a binary space tree using the given
@@ -123,10 +138,13 @@ class BinarySpaceTree
    * @param oldFromNew Vector which will be filled with the old positions for
    *     each new point.
    * @param maxLeafSize Size of each leaf in the tree.
+   * @param parallelBuild If true, large subtrees will be built as parallel
+   *     OpenMP tasks (no effect if mlpack was built without OpenMP support).
    */
   BinarySpaceTree(const MatType& data,
                   std::vector<size_t>& oldFromNew,
-                  const size_t maxLeafSize = 20);
+                  const size_t maxLeafSize = 20,
+                  const bool parallelBuild = false);
 
   /**
    * Construct this as the root node of a binary space tree using the given
@@ -142,11 +160,14 @@ class BinarySpaceTree
    * @param newFromOld Vector which will be filled with the new positions for
    *     each old point.
    * @param maxLeafSize Size of each leaf in the tree.
+   * @param parallelBuild If true, large subtrees will be built as parallel
+   *     OpenMP tasks (no effect if mlpack was built without OpenMP support).
    */
   BinarySpaceTree(const MatType& data,
                   std::vector<size_t>& oldFromNew,
                   std::vector<size_t>& newFromOld,
-                  const size_t maxLeafSize = 20);
+                  const size_t maxLeafSize = 20,
+                  const bool parallelBuild = false);
 
   /**
    * Construct this as the root node of a binary space tree using the given
@@ -156,9 +177,12 @@ class BinarySpaceTree
    *
    * @param data Dataset to create tree from.
    * @param maxLeafSize Size of each leaf in the tree.
+   * @param parallelBuild If true, large subtrees will be built as parallel
+   *     OpenMP tasks (no effect if mlpack was built without OpenMP support).
    */
   BinarySpaceTree(MatType&& data,
-                  const size_t maxLeafSize = 20);
+                  const size_t maxLeafSize = 20,
+                  const bool parallelBuild = false);
 
   /**
    * Construct this as the root node of a binary space tree using the given
@@ -171,10 +195,13 @@ class BinarySpaceTree
    * @param oldFromNew Vector which will be filled with the old positions for
    *     each new point.
    * @param maxLeafSize Size of each leaf in the tree.
+   * @param parallelBuild If true, large subtrees will be built as parallel
+   *     OpenMP tasks (no effect if mlpack was built without OpenMP support).
    */
   BinarySpaceTree(MatType&& data,
                   std::vector<size_t>& oldFromNew,
-                  const size_t maxLeafSize = 20);
+                  const size_t maxLeafSize = 20,
+                  const bool parallelBuild = false);
 
   /**
    * Construct this as the root node of a binary space tree using the given
@@ -190,11 +217,14 @@ class BinarySpaceTree
    * @param newFromOld Vector which will be filled with the new positions for
    *     each old point.
    * @param maxLeafSize Size of each leaf in the tree.
+   * @param parallelBuild If true, large subtrees will be built as parallel
+   *     OpenMP tasks (no effect if mlpack was built without OpenMP support).
    */
   BinarySpaceTree(MatType&& data,
                   std::vector<size_t>& oldFromNew,
                   std::vector<size_t>& newFromOld,
-                  const size_t maxLeafSize = 20);
+                  const size_t maxLeafSize = 20,
+                  const bool parallelBuild = false);
 
   /**
    * Construct this node as a child of the given parent, starting at column
@@ -211,7 +241,7 @@ class BinarySpaceTree
   BinarySpaceTree(BinarySpaceTree* parent,
                   const size_t begin,
                   const size_t count,
-                  SplitType<BoundType<MetricType>, MatType>& splitter,
+                  SplitType<BoundType<MetricType, ElemType>, MatType>& splitter,
                   const size_t maxLeafSize = 20);
 
   /**
@@ -237,7 +267,7 @@ class BinarySpaceTree
                   const size_t begin,
                   const size_t count,
                   std::vector<size_t>& oldFromNew,
-                  SplitType<BoundType<MetricType>, MatType>& splitter,
+                  SplitType<BoundType<MetricType, ElemType>, MatType>& splitter,
                   const size_t maxLeafSize = 20);
 
   /**
@@ -267,7 +297,7 @@ class BinarySpaceTree
                   const size_t count,
                   std::vector<size_t>& oldFromNew,
                   std::vector<size_t>& newFromOld,
-                  SplitType<BoundType<MetricType>, MatType>& splitter,
+                  SplitType<BoundType<MetricType, ElemType>, MatType>& splitter,
                   const size_t maxLeafSize = 20);
 
   /**
@@ -315,10 +345,73 @@ class BinarySpaceTree
    */
   ~BinarySpaceTree();
 
+  /**
+   * Compact the tree: relocate every descendant node into one contiguous
+   * block of memory owned by this node, laid out in preorder.  Traversals of
+   * a compacted tree touch node memory mostly sequentially instead of chasing
+   * scattered heap allocations, which can give a significant speedup for deep
+   * trees.  The structure of the tree is unchanged.
+   *
+   * This may only be called on the root of the tree, and it invalidates all
+   * pointers and references to descendant nodes.  Calling Compact() on an
+   * already-compacted tree has no effect.
+   */
+  void Compact();
+
+  /**
+   * Insert the given point into the tree, returning its index in the (tree's
+   * copy of the) dataset.  The point is placed into the leaf whose bound is
+   * nearest, widening the bounds of that leaf and its ancestors; no
+   * rebalancing is done, so after many inserts the tree may degrade --
+   * monitor Imbalance() and call Rebuild() when it grows too large.
+   *
+   * This may only be called on the root of the tree.  It invalidates any
+   * oldFromNew/newFromOld mappings from build time (indices at or after the
+   * insertion position shift by one).  The cost is dominated by shifting the
+   * dataset columns after the insertion position.
+   *
+   * @param point Point to insert.
+   * @return Index of the inserted point in the tree's dataset.
+   */
+  template<typename VecType>
+  size_t InsertPoint(const VecType& point);
+
+  /**
+   * Delete the point with the given (current) dataset index from the tree.
+   * The point is physically removed from the dataset and all node ranges are
+   * adjusted; bounds are not shrunk, so they stay valid but may become loose
+   * until the next Rebuild().
+   *
+   * This may only be called on the root of the tree; the same caveats as
+   * InsertPoint() apply.
+   *
+   * @param index Index of the point to delete.
+   */
+  void DeletePoint(const size_t index);
+
+  /**
+   * Return a measure of how unbalanced the tree is: the maximum, over all
+   * internal nodes, of the fraction of the node's points held by its larger
+   * child.  A perfectly balanced tree gives 0.5; values close to 1 indicate
+   * degenerate subtrees.  After a stream of InsertPoint()/DeletePoint()
+   * calls, a value above roughly 0.9 is a good signal to Rebuild().
+   */
+  double Imbalance() const;
+
+  /**
+   * Rebuild the tree in place over its current dataset.  This restores
+   * balance and tight bounds after a stream of incremental updates.  This may
+   * only be called on the root of the tree; all pointers and references into
+   * the old tree are invalidated.
+   *
+   * @param maxLeafSize Maximum number of points held in each leaf.
+   */
+  void Rebuild(const size_t maxLeafSize = 20);
+
   //! Return the bound object for this node.
-  const BoundType<MetricType>& Bound() const { return bound; }
+  const BoundType<MetricType, ElemType>& Bound() const { return bound; }
   //! Return the bound object for this node.
-  BoundType<MetricType>& Bound() { return bound; }
+  BoundType<MetricType, ElemType>& Bound() { return bound; }
 
   //! Return the statistic object for this node.
   const StatisticType& Stat() const { return stat; }
@@ -515,7 +608,7 @@ class BinarySpaceTree
    * @param splitter Instantiated SplitType object.
    */
   void SplitNode(const size_t maxLeafSize,
-                 SplitType<BoundType<MetricType>, MatType>& splitter);
+                 SplitType<BoundType<MetricType, ElemType>, MatType>& splitter);
 
   /**
    * Splits the current node, assigning its left and right children recursively.
@@ -527,7 +620,7 @@ class BinarySpaceTree
    */
   void SplitNode(std::vector<size_t>& oldFromNew,
                  const size_t maxLeafSize,
-                 SplitType<BoundType<MetricType>, MatType>& splitter);
+                 SplitType<BoundType<MetricType, ElemType>, MatType>& splitter);
 
   /**
    * Update the bound of the current node. This method does not take into
@@ -544,7 +637,40 @@ class BinarySpaceTree
    *
    * @param boundToUpdate The bound to update.
    */
-  void UpdateBound(bound::HollowBallBound<MetricType>& boundToUpdate);
+  void UpdateBound(bound::HollowBallBound<MetricType, ElemType>& boundToUpdate);
+
+  /**
+   * Count the number of nodes in the subtree rooted at this node, not
+   * including this node itself.  Used by Compact() to size the arena.
+   */
+  size_t NumDescendantNodes() const;
+
+  /**
+   * Move the subtree rooted at oldNode into the given arena in preorder,
+   * freeing the old heap-allocated nodes as it goes.  Returns the new
+   * location of the subtree root.
+   *
+   * @param oldNode Root of the subtree to relocate.
+   * @param newParent New parent pointer for the relocated subtree root.
+   * @param storage Arena to relocate nodes into.
+   * @param pos Next free slot in the arena; updated as nodes are placed.
+   */
+  BinarySpaceTree* CompactSubtree(BinarySpaceTree* oldNode,
+                                  BinarySpaceTree* newParent,
+                                  BinarySpaceTree* storage,
+                                  size_t& pos);
+
+  /**
+   * Shift the point ranges of every node in this subtree after a point was
+   * inserted into or deleted from the dataset.  For an insert at position
+   * pos, every node whose range starts at or after pos moves right by one;
+   * for a delete, every node whose range starts after pos moves left by one.
+   * Nodes on the modified leaf's path are handled separately by the caller.
+   *
+   * @param pos Dataset position of the inserted or deleted column.
+   * @param insert True for an insertion, false for a deletion.
+   */
+  void ShiftPointRanges(const size_t pos, const bool insert);
 
  protected:
   /**
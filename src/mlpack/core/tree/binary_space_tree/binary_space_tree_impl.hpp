@@ -16,7 +16,9 @@
 
 #include <mlpack/core/util/cli.hpp>
 #include <mlpack/core/util/log.hpp>
+#include <algorithm>
 #include <queue>
+#include <vector>
 
 namespace mlpack {
 namespace tree {
@@ -32,7 +34,8 @@ template<typename MetricType,
 BinarySpaceTree<MetricType, StatisticType, MatType, BoundType, SplitType>::
 BinarySpaceTree(
     const MatType& data,
-    const size_t maxLeafSize) :
+    const size_t maxLeafSize,
+    const bool parallelBuild) :
     left(NULL),
     right(NULL),
     parent(NULL),
@@ -43,8 +46,20 @@ BinarySpaceTree(
     dataset(new MatType(data)) // Copies the dataset.
 {
   // Do the actual splitting of this node.
-  SplitType<BoundType<MetricType>, MatType> splitter;
-  SplitNode(maxLeafSize, splitter);
+  SplitType<BoundType<MetricType, ElemType>, MatType> splitter;
+  if (parallelBuild)
+  {
+    // SplitNode() will push each sufficiently large subtree build as an OpenMP
+    // task; a single thread starts the recursion and the rest of the team
+    // picks up tasks as they are produced.
+    #pragma omp parallel
+    #pragma omp single
+    SplitNode(maxLeafSize, splitter);
+  }
+  else
+  {
+    SplitNode(maxLeafSize, splitter);
+  }
 
   // Create the statistic depending on if we are a leaf or not.
   stat = StatisticType(*this);
@@ -60,7 +75,8 @@ BinarySpaceTree<MetricType, StatisticType, MatType, BoundType, SplitType>::
 BinarySpaceTree(
     const MatType& data,
     std::vector<size_t>& oldFromNew,
-    const size_t maxLeafSize) :
+    const size_t maxLeafSize,
+    const bool parallelBuild) :
     left(NULL),
     right(NULL),
     parent(NULL),
@@ -76,8 +92,19 @@ BinarySpaceTree(
     oldFromNew[i] = i; // Fill with unharmed indices.
 
   // Now do the actual splitting.
-  SplitType<BoundType<MetricType>, MatType> splitter;
-  SplitNode(oldFromNew, maxLeafSize, splitter);
+  SplitType<BoundType<MetricType, ElemType>, MatType> splitter;
+  if (parallelBuild)
+  {
+    // Subtree builds touch disjoint column ranges of the dataset and disjoint
+    // ranges of oldFromNew, so they can safely run as parallel tasks.
+    #pragma omp parallel
+    #pragma omp single
+    SplitNode(oldFromNew, maxLeafSize, splitter);
+  }
+  else
+  {
+    SplitNode(oldFromNew, maxLeafSize, splitter);
+  }
 
   // Create the statistic depending on if we are a leaf or not.
   stat = StatisticType(*this);
@@ -94,7 +121,8 @@ BinarySpaceTree(
     const MatType& data,
     std::vector<size_t>& oldFromNew,
     std::vector<size_t>& newFromOld,
-    const size_t maxLeafSize) :
+    const size_t maxLeafSize,
+    const bool parallelBuild) :
     left(NULL),
     right(NULL),
     parent(NULL),
@@ -110,8 +138,17 @@ BinarySpaceTree(
     oldFromNew[i] = i; // Fill with unharmed indices.
 
   // Now do the actual splitting.
-  SplitType<BoundType<MetricType>, MatType> splitter;
-  SplitNode(oldFromNew, maxLeafSize, splitter);
+  SplitType<BoundType<MetricType, ElemType>, MatType> splitter;
+  if (parallelBuild)
+  {
+    #pragma omp parallel
+    #pragma omp single
+    SplitNode(oldFromNew, maxLeafSize, splitter);
+  }
+  else
+  {
+    SplitNode(oldFromNew, maxLeafSize, splitter);
+  }
 
   // Create the statistic depending on if we are a leaf or not.
   stat = StatisticType(*this);
@@ -129,7 +166,9 @@ template<typename MetricType,
          template<typename SplitBoundType, typename SplitMatType>
              class SplitType>
 BinarySpaceTree<MetricType, StatisticType, MatType, BoundType, SplitType>::
-BinarySpaceTree(MatType&& data, const size_t maxLeafSize) :
+BinarySpaceTree(MatType&& data,
+                const size_t maxLeafSize,
+                const bool parallelBuild) :
     left(NULL),
     right(NULL),
     parent(NULL),
@@ -140,8 +179,17 @@ BinarySpaceTree(MatType&& data, const size_t maxLeafSize) :
     dataset(new MatType(std::move(data)))
 {
   // Do the actual splitting of this node.
-  SplitType<BoundType<MetricType>, MatType> splitter;
-  SplitNode(maxLeafSize, splitter);
+  SplitType<BoundType<MetricType, ElemType>, MatType> splitter;
+  if (parallelBuild)
+  {
+    #pragma omp parallel
+    #pragma omp single
+    SplitNode(maxLeafSize, splitter);
+  }
+  else
+  {
+    SplitNode(maxLeafSize, splitter);
+  }
 
   // Create the statistic depending on if we are a leaf or not.
   stat = StatisticType(*this);
@@ -157,7 +205,8 @@ BinarySpaceTree<MetricType, StatisticType, MatType, BoundType, SplitType>::
 BinarySpaceTree(
     MatType&& data,
     std::vector<size_t>& oldFromNew,
-    const size_t maxLeafSize) :
+    const size_t maxLeafSize,
+    const bool parallelBuild) :
     left(NULL),
     right(NULL),
     parent(NULL),
@@ -173,8 +222,17 @@ BinarySpaceTree(
     oldFromNew[i] = i; // Fill with unharmed indices.
 
   // Now do the actual splitting.
-  SplitType<BoundType<MetricType>, MatType> splitter;
-  SplitNode(oldFromNew, maxLeafSize, splitter);
+  SplitType<BoundType<MetricType, ElemType>, MatType> splitter;
+  if (parallelBuild)
+  {
+    #pragma omp parallel
+    #pragma omp single
+    SplitNode(oldFromNew, maxLeafSize, splitter);
+  }
+  else
+  {
+    SplitNode(oldFromNew, maxLeafSize, splitter);
+  }
 
   // Create the statistic depending on if we are a leaf or not.
   stat = StatisticType(*this);
@@ -191,7 +249,8 @@ BinarySpaceTree(
     MatType&& data,
     std::vector<size_t>& oldFromNew,
     std::vector<size_t>& newFromOld,
-    const size_t maxLeafSize) :
+    const size_t maxLeafSize,
+    const bool parallelBuild) :
     left(NULL),
     right(NULL),
     parent(NULL),
@@ -207,8 +266,17 @@ BinarySpaceTree(
     oldFromNew[i] = i; // Fill with unharmed indices.
 
   // Now do the actual splitting.
-  SplitType<BoundType<MetricType>, MatType> splitter;
-  SplitNode(oldFromNew, maxLeafSize, splitter);
+  SplitType<BoundType<MetricType, ElemType>, MatType> splitter;
+  if (parallelBuild)
+  {
+    #pragma omp parallel
+    #pragma omp single
+    SplitNode(oldFromNew, maxLeafSize, splitter);
+  }
+  else
+  {
+    SplitNode(oldFromNew, maxLeafSize, splitter);
+  }
 
   // Create the statistic depending on if we are a leaf or not.
   stat = StatisticType(*this);
@@ -230,7 +298,7 @@ BinarySpaceTree(
     BinarySpaceTree* parent,
     const size_t begin,
     const size_t count,
-    SplitType<BoundType<MetricType>, MatType>& splitter,
+    SplitType<BoundType<MetricType, ElemType>, MatType>& splitter,
     const size_t maxLeafSize) :
     left(NULL),
     right(NULL),
@@ -259,7 +327,7 @@ BinarySpaceTree(
     const size_t begin,
     const size_t count,
     std::vector<size_t>& oldFromNew,
-    SplitType<BoundType<MetricType>, MatType>& splitter,
+    SplitType<BoundType<MetricType, ElemType>, MatType>& splitter,
     const size_t maxLeafSize) :
     left(NULL),
     right(NULL),
@@ -293,7 +361,7 @@ BinarySpaceTree(
     const size_t count,
     std::vector<size_t>& oldFromNew,
     std::vector<size_t>& newFromOld,
-    SplitType<BoundType<MetricType>, MatType>& splitter,
+    SplitType<BoundType<MetricType, ElemType>, MatType>& splitter,
     const size_t maxLeafSize) :
     left(NULL),
     right(NULL),
@@ -399,8 +467,16 @@ operator=(const BinarySpaceTree& other)
 
   // Freeing memory that will not be used anymore.
   delete dataset;
-  delete left;
-  delete right;
+  if (arena != NULL)
+  {
+    delete[] arena;
+    arena = NULL;
+  }
+  else
+  {
+    delete left;
+    delete right;
+  }
 
   left = NULL;
   right = NULL;
@@ -471,12 +547,18 @@ operator=(BinarySpaceTree&& other)
 
   // Freeing memory that will not be used anymore.
   delete dataset;
-  delete left;
-  delete right;
+  if (arena != NULL)
+    delete[] arena;
+  else
+  {
+    delete left;
+    delete right;
+  }
 
   parent = other.Parent();
   left = other.Left();
   right = other.Right();
+  arena = other.arena;
   begin = other.Begin();
   count = other.Count();
   bound = std::move(other.bound);
@@ -495,6 +577,13 @@ operator=(BinarySpaceTree&& other)
   other.furthestDescendantDistance = 0.0;
   other.minimumBoundDistance = 0.0;
   other.dataset = NULL;
+  other.arena = NULL;
+
+  // Adopt the children we took from the other tree.
+  if (left)
+    left->parent = this;
+  if (right)
+    right->parent = this;
 
   return *this;
 }
@@ -521,10 +610,12 @@ BinarySpaceTree(BinarySpaceTree&& other) :
     parentDistance(other.parentDistance),
     furthestDescendantDistance(other.furthestDescendantDistance),
     minimumBoundDistance(other.minimumBoundDistance),
-    dataset(other.dataset)
+    dataset(other.dataset),
+    arena(other.arena)
 {
   // Now we are a clone of the other tree.  But we must also clear the other
   // tree's contents, so it doesn't delete anything when it is destructed.
+  other.arena = NULL;
   other.left = NULL;
   other.right = NULL;
   other.parent = NULL;
@@ -577,14 +668,279 @@ template<typename MetricType,
 BinarySpaceTree<MetricType, StatisticType, MatType, BoundType, SplitType>::
     ~BinarySpaceTree()
 {
-  delete left;
-  delete right;
+  if (arena != NULL)
+  {
+    // All descendant nodes live in the arena; freeing it frees them all.
+    delete[] arena;
+  }
+  else if (!inArena)
+  {
+    delete left;
+    delete right;
+  }
+  // Nodes that live inside an arena do not own their children.
 
   // If we're the root, delete the matrix.
   if (!parent)
     delete dataset;
 }
 
+template<typename MetricType,
+         typename StatisticType,
+         typename MatType,
+         template<typename BoundMetricType, typename...> class BoundType,
+         template<typename SplitBoundType, typename SplitMatType>
+             class SplitType>
+void BinarySpaceTree<MetricType, StatisticType, MatType, BoundType, SplitType>::
+    Compact()
+{
+  if (parent != NULL)
+    throw std::invalid_argument("BinarySpaceTree::Compact(): only the root "
+        "node of a tree can be compacted!");
+
+  // Nothing to do if the tree is already compact, or if it is a single leaf.
+  if (arena != NULL || (left == NULL && right == NULL))
+    return;
+
+  // Size the arena exactly, then relocate all descendants into it in
+  // preorder.  The root itself stays where it is, since the user owns it.
+  const size_t numNodes = NumDescendantNodes();
+  BinarySpaceTree* storage = new BinarySpaceTree[numNodes];
+
+  size_t pos = 0;
+  if (left != NULL)
+    left = CompactSubtree(left, this, storage, pos);
+  if (right != NULL)
+    right = CompactSubtree(right, this, storage, pos);
+
+  arena = storage;
+}
+
+template<typename MetricType,
+         typename StatisticType,
+         typename MatType,
+         template<typename BoundMetricType, typename...> class BoundType,
+         template<typename SplitBoundType, typename SplitMatType>
+             class SplitType>
+size_t BinarySpaceTree<MetricType, StatisticType, MatType, BoundType,
+                       SplitType>::NumDescendantNodes() const
+{
+  size_t nodes = 0;
+  if (left != NULL)
+    nodes += 1 + left->NumDescendantNodes();
+  if (right != NULL)
+    nodes += 1 + right->NumDescendantNodes();
+  return nodes;
+}
+
+template<typename MetricType,
+         typename StatisticType,
+         typename MatType,
+         template<typename BoundMetricType, typename...> class BoundType,
+         template<typename SplitBoundType, typename SplitMatType>
+             class SplitType>
+BinarySpaceTree<MetricType, StatisticType, MatType, BoundType, SplitType>*
+BinarySpaceTree<MetricType, StatisticType, MatType, BoundType, SplitType>::
+    CompactSubtree(BinarySpaceTree* oldNode,
+                   BinarySpaceTree* newParent,
+                   BinarySpaceTree* storage,
+                   size_t& pos)
+{
+  // Move the node into the next free arena slot; this transfers the old
+  // node's children (and empties the old node).
+  BinarySpaceTree* newNode = &storage[pos++];
+  *newNode = std::move(*oldNode);
+  newNode->parent = newParent;
+  newNode->inArena = true;
+
+  // Recursively relocate the children so that each subtree is contiguous in
+  // preorder, then free the old heap-allocated shell.
+  if (newNode->left != NULL)
+    newNode->left = CompactSubtree(newNode->left, newNode, storage, pos);
+  if (newNode->right != NULL)
+    newNode->right = CompactSubtree(newNode->right, newNode, storage, pos);
+
+  delete oldNode;
+  return newNode;
+}
+
+template<typename MetricType,
+         typename StatisticType,
+         typename MatType,
+         template<typename BoundMetricType, typename...> class BoundType,
+         template<typename SplitBoundType, typename SplitMatType>
+             class SplitType>
+template<typename VecType>
+size_t BinarySpaceTree<MetricType, StatisticType, MatType, BoundType,
+                       SplitType>::InsertPoint(const VecType& point)
+{
+  if (parent != NULL)
+    throw std::invalid_argument("BinarySpaceTree::InsertPoint(): points may "
+        "only be inserted at the root of the tree!");
+
+  // Descend to the leaf whose bound is nearest to the point, recording the
+  // path so we can widen bounds and adjust point ranges afterwards.
+  std::vector<BinarySpaceTree*> path;
+  BinarySpaceTree* node = this;
+  path.push_back(node);
+  while (!node->IsLeaf())
+  {
+    // Avoid descending into empty nodes (these can arise after deletions).
+    if (node->right == NULL || node->right->count == 0)
+      node = node->left;
+    else if (node->left->count == 0)
+      node = node->right;
+    else if (node->left->MinDistance(point) <= node->right->MinDistance(point))
+      node = node->left;
+    else
+      node = node->right;
+
+    path.push_back(node);
+  }
+
+  // The new point goes at the end of the target leaf's range, so that every
+  // node's range stays contiguous.
+  const size_t pos = node->begin + node->count;
+  dataset->insert_cols(pos, 1);
+  dataset->col(pos) = point;
+  const arma::Col<ElemType> insertedPoint(dataset->col(pos));
+
+  // Widen the bounds along the path and shift the ranges of off-path
+  // subtrees that lie after the insertion position.
+  for (size_t i = 0; i < path.size(); ++i)
+  {
+    BinarySpaceTree* pathNode = path[i];
+    ++pathNode->count;
+    pathNode->bound |= insertedPoint;
+    pathNode->furthestDescendantDistance = 0.5 * pathNode->bound.Diameter();
+    pathNode->minimumBoundDistance = pathNode->bound.MinWidth() / 2.0;
+
+    if (i + 1 < path.size())
+    {
+      BinarySpaceTree* offPath = (path[i + 1] == pathNode->left) ?
+          pathNode->right : pathNode->left;
+      if (offPath != NULL)
+        offPath->ShiftPointRanges(pos, true);
+    }
+  }
+
+  return pos;
+}
+
+template<typename MetricType,
+         typename StatisticType,
+         typename MatType,
+         template<typename BoundMetricType, typename...> class BoundType,
+         template<typename SplitBoundType, typename SplitMatType>
+             class SplitType>
+void BinarySpaceTree<MetricType, StatisticType, MatType, BoundType,
+                     SplitType>::DeletePoint(const size_t index)
+{
+  if (parent != NULL)
+    throw std::invalid_argument("BinarySpaceTree::DeletePoint(): points may "
+        "only be deleted at the root of the tree!");
+  if (index >= begin + count)
+    throw std::invalid_argument("BinarySpaceTree::DeletePoint(): index out "
+        "of bounds!");
+
+  // Descend to the leaf whose range holds the point, recording the path.
+  std::vector<BinarySpaceTree*> path;
+  BinarySpaceTree* node = this;
+  path.push_back(node);
+  while (!node->IsLeaf())
+  {
+    if (node->left != NULL && index >= node->left->begin &&
+        index < node->left->begin + node->left->count)
+      node = node->left;
+    else
+      node = node->right;
+
+    path.push_back(node);
+  }
+
+  // Physically remove the column, then shrink the counts along the path and
+  // shift the ranges of off-path subtrees that lie after the deleted column.
+  // Bounds are left unmodified: they remain valid but may be loose.
+  dataset->shed_col(index);
+  for (size_t i = 0; i < path.size(); ++i)
+  {
+    BinarySpaceTree* pathNode = path[i];
+    --pathNode->count;
+
+    if (i + 1 < path.size())
+    {
+      BinarySpaceTree* offPath = (path[i + 1] == pathNode->left) ?
+          pathNode->right : pathNode->left;
+      if (offPath != NULL)
+        offPath->ShiftPointRanges(index, false);
+    }
+  }
+}
+
+template<typename MetricType,
+         typename StatisticType,
+         typename MatType,
+         template<typename BoundMetricType, typename...> class BoundType,
+         template<typename SplitBoundType, typename SplitMatType>
+             class SplitType>
+void BinarySpaceTree<MetricType, StatisticType, MatType, BoundType,
+                     SplitType>::ShiftPointRanges(const size_t pos,
+                                                  const bool insert)
+{
+  if (insert)
+  {
+    if (begin >= pos)
+      ++begin;
+  }
+  else
+  {
+    if (begin > pos)
+      --begin;
+  }
+
+  if (left != NULL)
+    left->ShiftPointRanges(pos, insert);
+  if (right != NULL)
+    right->ShiftPointRanges(pos, insert);
+}
+
+template<typename MetricType,
+         typename StatisticType,
+         typename MatType,
+         template<typename BoundMetricType, typename...> class BoundType,
+         template<typename SplitBoundType, typename SplitMatType>
+             class SplitType>
+double BinarySpaceTree<MetricType, StatisticType, MatType, BoundType,
+                       SplitType>::Imbalance() const
+{
+  if (left == NULL || right == NULL || count == 0)
+    return 0.5;
+
+  double worst = std::max(left->count, right->count) / (double) count;
+  worst = std::max(worst, left->Imbalance());
+  worst = std::max(worst, right->Imbalance());
+  return worst;
+}
+
+template<typename MetricType,
+         typename StatisticType,
+         typename MatType,
+         template<typename BoundMetricType, typename...> class BoundType,
+         template<typename SplitBoundType, typename SplitMatType>
+             class SplitType>
+void BinarySpaceTree<MetricType, StatisticType, MatType, BoundType,
+                     SplitType>::Rebuild(const size_t maxLeafSize)
+{
+  if (parent != NULL)
+    throw std::invalid_argument("BinarySpaceTree::Rebuild(): only the root "
+        "node of a tree can be rebuilt!");
+
+  // Take the dataset out of the tree, then replace ourselves with a tree
+  // freshly built on it.  The move assignment releases all of our old nodes.
+  MatType data(std::move(*dataset));
+  *this = BinarySpaceTree(std::move(data), maxLeafSize);
+}
+
 template<typename MetricType,
          typename StatisticType,
          typename MatType,
@@ -867,7 +1223,7 @@ template<typename MetricType,
              class SplitType>
 void BinarySpaceTree<MetricType, StatisticType, MatType, BoundType, SplitType>::
     SplitNode(const size_t maxLeafSize,
-              SplitType<BoundType<MetricType>, MatType>& splitter)
+              SplitType<BoundType<MetricType, ElemType>, MatType>& splitter)
 {
   // We need to expand the bounds of this node properly.
   UpdateBound(bound);
@@ -905,10 +1261,17 @@ void BinarySpaceTree<MetricType, StatisticType, MatType, BoundType, SplitType>::
 
   // Now that we know the split column, we will recursively split the children
   // by calling their constructors (which perform this splitting process).
+  // During a parallel build (see the parallelBuild constructor parameter),
+  // each sufficiently large child build is pushed as an OpenMP task; small
+  // subtrees are built inline to avoid drowning the runtime in tiny tasks.
+  // Outside of a parallel region the tasks simply execute immediately.
+  #pragma omp task default(shared) if (count > 1000)
   left = new BinarySpaceTree(this, begin, splitCol - begin, splitter,
       maxLeafSize);
+  #pragma omp task default(shared) if (count > 1000)
   right = new BinarySpaceTree(this, splitCol, begin + count - splitCol,
       splitter, maxLeafSize);
+  #pragma omp taskwait
 
   // Calculate parent distances for those two nodes.
   arma::vec center, leftCenter, rightCenter;
@@ -934,7 +1297,7 @@ template<typename MetricType,
 void BinarySpaceTree<MetricType, StatisticType, MatType, BoundType, SplitType>::
 SplitNode(std::vector<size_t>& oldFromNew,
           const size_t maxLeafSize,
-          SplitType<BoundType<MetricType>, MatType>& splitter)
+          SplitType<BoundType<MetricType, ElemType>, MatType>& splitter)
 {
   // We need to expand the bounds of this node properly.
   UpdateBound(bound);
@@ -973,10 +1336,15 @@ SplitNode(std::vector<size_t>& oldFromNew,
 
   // Now that we know the split column, we will recursively split the children
   // by calling their constructors (which perform this splitting process).
+  // The children cover disjoint ranges of the dataset and of oldFromNew, so
+  // during a parallel build they can safely be built as OpenMP tasks.
+  #pragma omp task default(shared) if (count > 1000)
   left = new BinarySpaceTree(this, begin, splitCol - begin, oldFromNew,
       splitter, maxLeafSize);
+  #pragma omp task default(shared) if (count > 1000)
   right = new BinarySpaceTree(this, splitCol, begin + count - splitCol,
       oldFromNew, splitter, maxLeafSize);
+  #pragma omp taskwait
 
   // Calculate parent distances for those two nodes.
   arma::vec center, leftCenter, rightCenter;
@@ -1014,7 +1382,7 @@ template<typename MetricType,
          template<typename SplitBoundType, typename SplitMatType>
              class SplitType>
 void BinarySpaceTree<MetricType, StatisticType, MatType, BoundType, SplitType>::
-UpdateBound(bound::HollowBallBound<MetricType>& boundToUpdate)
+UpdateBound(bound::HollowBallBound<MetricType, ElemType>& boundToUpdate)
 {
   if (!parent)
   {
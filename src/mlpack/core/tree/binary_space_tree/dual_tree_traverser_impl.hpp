@@ -17,9 +17,71 @@
 // In case it hasn't been included yet.
 #include "dual_tree_traverser.hpp"
 
+#include <mlpack/core/util/sfinae_utility.hpp>
+
 namespace mlpack {
 namespace tree {
 
+//! Detect whether the rule type provides a fused leaf-vs-leaf kernel (see
+//! e.g. NeighborSearchRules::LeafBaseCases()).
+HAS_MEM_FUNC(LeafBaseCases, HasLeafBaseCases);
+
+/**
+ * Run the base cases between two leaf nodes: through the rule's fused
+ * leaf-block kernel when it provides one (so the whole block is computed
+ * with one batched distance call), and point pair by point pair otherwise.
+ * Returns the number of base cases performed.
+ */
+template<typename RuleType,
+         typename TreeType,
+         bool HasFusedKernel = HasLeafBaseCases<RuleType,
+             size_t (RuleType::*)(TreeType&, TreeType&,
+                 const typename RuleType::TraversalInfoType&)>::value>
+struct LeafBaseCaseHelper
+{
+  static size_t Run(RuleType& rule,
+                    TreeType& queryNode,
+                    TreeType& referenceNode,
+                    const typename RuleType::TraversalInfoType& traversalInfo)
+  {
+    size_t numBaseCases = 0;
+
+    // Loop through each of the points in each node.
+    const size_t queryEnd = queryNode.Begin() + queryNode.Count();
+    const size_t refEnd = referenceNode.Begin() + referenceNode.Count();
+    for (size_t query = queryNode.Begin(); query < queryEnd; ++query)
+    {
+      // See if we need to investigate this point (this function should be
+      // implemented for the single-tree recursion too).  Restore the
+      // traversal information first.
+      rule.TraversalInfo() = traversalInfo;
+      const double childScore = rule.Score(query, referenceNode);
+
+      if (childScore == DBL_MAX)
+        continue; // We can't improve this particular point.
+
+      for (size_t ref = referenceNode.Begin(); ref < refEnd; ++ref)
+        rule.BaseCase(query, ref);
+
+      numBaseCases += referenceNode.Count();
+    }
+
+    return numBaseCases;
+  }
+};
+
+template<typename RuleType, typename TreeType>
+struct LeafBaseCaseHelper<RuleType, TreeType, true>
+{
+  static size_t Run(RuleType& rule,
+                    TreeType& queryNode,
+                    TreeType& referenceNode,
+                    const typename RuleType::TraversalInfoType& traversalInfo)
+  {
+    return rule.LeafBaseCases(queryNode, referenceNode, traversalInfo);
+  }
+};
+
 template<typename MetricType,
          typename StatisticType,
          typename MatType,
@@ -71,25 +133,12 @@ DualTreeTraverser<RuleType>::Traverse(
   // If both are leaves, we must evaluate the base case.
   if (queryNode.IsLeaf() && referenceNode.IsLeaf())
   {
-    // Loop through each of the points in each node.
-    const size_t queryEnd = queryNode.Begin() + queryNode.Count();
-    const size_t refEnd = referenceNode.Begin() + referenceNode.Count();
-    for (size_t query = queryNode.Begin(); query < queryEnd; ++query)
-    {
-      // See if we need to investigate this point (this function should be
-      // implemented for the single-tree recursion too).  Restore the traversal
-      // information first.
-      rule.TraversalInfo() = traversalInfo;
-      const double childScore = rule.Score(query, referenceNode);
-
-      if (childScore == DBL_MAX)
-        continue; // We can't improve this particular point.
-
-      for (size_t ref = referenceNode.Begin(); ref < refEnd; ++ref)
-        rule.BaseCase(query, ref);
-
-      numBaseCases += referenceNode.Count();
-    }
+    // Process the block through the rule's fused leaf kernel when it has
+    // one, and point pair by point pair otherwise.
+    typedef BinarySpaceTree<MetricType, StatisticType, MatType, BoundType,
+        SplitType> TreeType;
+    numBaseCases += LeafBaseCaseHelper<RuleType, TreeType>::Run(rule,
+        queryNode, referenceNode, traversalInfo);
   }
   else if (((!queryNode.IsLeaf()) && referenceNode.IsLeaf()) ||
            (queryNode.NumDescendants() > 3 * referenceNode.NumDescendants() &&
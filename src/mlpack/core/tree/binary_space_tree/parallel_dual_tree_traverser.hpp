@@ -0,0 +1,119 @@
+/**
+ * @file core/tree/binary_space_tree/parallel_dual_tree_traverser.hpp
+ *
+ * Defines the ParallelDualTreeTraverser for the BinarySpaceTree tree type: a
+ * dual-tree traversal engine that shards the query tree into independent
+ * subtrees and traverses each of them against the reference tree on its own
+ * thread, with dynamic (work-stealing-style) scheduling so that imbalanced
+ * subtrees do not leave cores idle.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_TREE_BINARY_SPACE_TREE_PARALLEL_DUAL_TREE_TRAVERSER_HPP
+#define MLPACK_CORE_TREE_BINARY_SPACE_TREE_PARALLEL_DUAL_TREE_TRAVERSER_HPP
+
+#include <mlpack/prereqs.hpp>
+
+#include "binary_space_tree.hpp"
+#include "dual_tree_traverser.hpp"
+
+namespace mlpack {
+namespace tree {
+
+/**
+ * A dual-tree traverser that runs the standard depth-first dual-tree
+ * traversal in parallel over disjoint query subtrees.  The query tree is
+ * expanded breadth-first into a frontier of several subtrees per thread, and
+ * each (query subtree, reference root) combination is then traversed with an
+ * ordinary DualTreeTraverser and a thread-local copy of the rule set; the
+ * combinations are handed out with dynamic scheduling, so threads that finish
+ * a cheap subtree steal the remaining ones.
+ *
+ * Every thread works on a disjoint set of query points and query nodes, so
+ * the thread-local copies never race on per-query state.  Because the copies
+ * accumulate their results privately, RuleType must additionally provide a
+ * MergeResults() method that folds the results of a copy back into the
+ * original rule set (see NeighborSearchRules::MergeResults()); it is called
+ * once per thread after the traversals finish.  Rule sets that accumulate
+ * global state across query subtrees (other than through query statistics)
+ * are not safe to use with this traverser.
+ *
+ * The results are identical to a serial dual-tree traversal, although less
+ * pruning may occur near the root of the query tree, since each subtree
+ * starts its traversal from the reference root.
+ */
+template<typename MetricType,
+         typename StatisticType,
+         typename MatType,
+         template<typename BoundMetricType, typename...> class BoundType,
+         template<typename SplitBoundType, typename SplitMatType>
+             class SplitType>
+template<typename RuleType>
+class BinarySpaceTree<MetricType, StatisticType, MatType, BoundType,
+                      SplitType>::ParallelDualTreeTraverser
+{
+ public:
+  /**
+   * Instantiate the parallel dual-tree traverser with the given rule set.
+   * The rule set is copied once per thread during Traverse(), and each copy
+   * is merged back into the given rule set with RuleType::MergeResults()
+   * when its thread finishes.
+   */
+  ParallelDualTreeTraverser(RuleType& rule);
+
+  /**
+   * Traverse the two trees.  This does not reset the number of prunes.
+   *
+   * @param queryNode The query node to be traversed.
+   * @param referenceNode The reference node to be traversed.
+   */
+  void Traverse(BinarySpaceTree& queryNode,
+                BinarySpaceTree& referenceNode);
+
+  //! Get the number of prunes.
+  size_t NumPrunes() const { return numPrunes; }
+  //! Modify the number of prunes.
+  size_t& NumPrunes() { return numPrunes; }
+
+  //! Get the number of visited combinations.
+  size_t NumVisited() const { return numVisited; }
+  //! Modify the number of visited combinations.
+  size_t& NumVisited() { return numVisited; }
+
+  //! Get the number of times a node combination was scored.
+  size_t NumScores() const { return numScores; }
+  //! Modify the number of times a node combination was scored.
+  size_t& NumScores() { return numScores; }
+
+  //! Get the number of times a base case was calculated.
+  size_t NumBaseCases() const { return numBaseCases; }
+  //! Modify the number of times a base case was calculated.
+  size_t& NumBaseCases() { return numBaseCases; }
+
+ private:
+  //! Reference to the rules with which the trees will be traversed.
+  RuleType& rule;
+
+  //! The number of prunes.
+  size_t numPrunes;
+
+  //! The number of node combinations that have been visited during traversal.
+  size_t numVisited;
+
+  //! The number of times a node combination was scored.
+  size_t numScores;
+
+  //! The number of times a base case was calculated.
+  size_t numBaseCases;
+};
+
+} // namespace tree
+} // namespace mlpack
+
+// Include implementation.
+#include "parallel_dual_tree_traverser_impl.hpp"
+
+#endif // MLPACK_CORE_TREE_BINARY_SPACE_TREE_PARALLEL_DUAL_TREE_TRAVERSER_HPP
@@ -0,0 +1,142 @@
+/**
+ * @file core/tree/binary_space_tree/parallel_dual_tree_traverser_impl.hpp
+ *
+ * Implementation of the ParallelDualTreeTraverser for BinarySpaceTree.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_TREE_BINARY_SPACE_TREE_PARALLEL_DUAL_TREE_TRAVERSER_IMPL_HPP
+#define MLPACK_CORE_TREE_BINARY_SPACE_TREE_PARALLEL_DUAL_TREE_TRAVERSER_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "parallel_dual_tree_traverser.hpp"
+
+#include <queue>
+
+#ifdef HAS_OPENMP
+  #include <omp.h>
+#endif
+
+namespace mlpack {
+namespace tree {
+
+template<typename MetricType,
+         typename StatisticType,
+         typename MatType,
+         template<typename BoundMetricType, typename...> class BoundType,
+         template<typename SplitBoundType, typename SplitMatType>
+             class SplitType>
+template<typename RuleType>
+BinarySpaceTree<MetricType, StatisticType, MatType, BoundType, SplitType>::
+ParallelDualTreeTraverser<RuleType>::ParallelDualTreeTraverser(RuleType& rule)
+    : rule(rule),
+      numPrunes(0),
+      numVisited(0),
+      numScores(0),
+      numBaseCases(0)
+{ /* Nothing to do. */ }
+
+template<typename MetricType,
+         typename StatisticType,
+         typename MatType,
+         template<typename BoundMetricType, typename...> class BoundType,
+         template<typename SplitBoundType, typename SplitMatType>
+             class SplitType>
+template<typename RuleType>
+void BinarySpaceTree<MetricType, StatisticType, MatType, BoundType,
+SplitType>::ParallelDualTreeTraverser<RuleType>::Traverse(
+    BinarySpaceTree<MetricType, StatisticType, MatType, BoundType, SplitType>&
+        queryNode,
+    BinarySpaceTree<MetricType, StatisticType, MatType, BoundType, SplitType>&
+        referenceNode)
+{
+#ifdef HAS_OPENMP
+  const size_t numThreads = (size_t) omp_get_max_threads();
+#else
+  const size_t numThreads = 1;
+#endif
+
+  // With a single thread there is no point sharding the query tree; fall
+  // back to the plain depth-first traversal.
+  if (numThreads == 1)
+  {
+    typename BinarySpaceTree::template DualTreeTraverser<RuleType>
+        traverser(rule);
+    traverser.Traverse(queryNode, referenceNode);
+    numPrunes += traverser.NumPrunes();
+    numVisited += traverser.NumVisited();
+    numScores += traverser.NumScores();
+    numBaseCases += traverser.NumBaseCases();
+    return;
+  }
+
+  // Expand the query tree breadth-first into a frontier of disjoint
+  // subtrees.  A handful of subtrees per thread gives the dynamic scheduler
+  // enough slack to balance unequal subtree costs.
+  const size_t targetFrontierSize = 8 * numThreads;
+  std::vector<BinarySpaceTree*> frontier;
+  std::queue<BinarySpaceTree*> expandQueue;
+  expandQueue.push(&queryNode);
+  while (!expandQueue.empty() &&
+      (frontier.size() + expandQueue.size()) < targetFrontierSize)
+  {
+    BinarySpaceTree* node = expandQueue.front();
+    expandQueue.pop();
+
+    if (node->IsLeaf())
+      frontier.push_back(node);
+    else
+    {
+      expandQueue.push(node->Left());
+      expandQueue.push(node->Right());
+    }
+  }
+  while (!expandQueue.empty())
+  {
+    frontier.push_back(expandQueue.front());
+    expandQueue.pop();
+  }
+
+  // Traverse each query subtree against the full reference tree with a
+  // thread-local copy of the rule set.  Dynamic scheduling lets threads that
+  // finish cheap subtrees pick up the remaining ones, which approximates a
+  // work-stealing deque without extra machinery.
+  size_t prunes = 0, visited = 0, scores = 0, baseCases = 0;
+  #pragma omp parallel reduction(+: prunes, visited, scores, baseCases)
+  {
+    // Each thread copies the rule set once; the copy carries private
+    // traversal state and private result storage, which is merged back into
+    // the shared rule set below.
+    RuleType localRule(rule);
+    typename BinarySpaceTree::template DualTreeTraverser<RuleType>
+        traverser(localRule);
+
+    #pragma omp for schedule(dynamic)
+    for (omp_size_t i = 0; i < (omp_size_t) frontier.size(); ++i)
+      traverser.Traverse(*frontier[i], referenceNode);
+
+    prunes += traverser.NumPrunes();
+    visited += traverser.NumVisited();
+    scores += traverser.NumScores();
+    baseCases += traverser.NumBaseCases();
+
+    // Fold this thread's results back into the shared rule set.  The
+    // frontier subtrees are disjoint, so each query point received results
+    // from exactly one thread.
+    #pragma omp critical
+    rule.MergeResults(localRule);
+  }
+
+  numPrunes += prunes;
+  numVisited += visited;
+  numScores += scores;
+  numBaseCases += baseCases;
+}
+
+} // namespace tree
+} // namespace mlpack
+
+#endif
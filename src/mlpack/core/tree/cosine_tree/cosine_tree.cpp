@@ -30,7 +30,8 @@ CosineTree::CosineTree(const arma::mat& dataset) :
   l2NormsSquared.zeros(numColumns);
 
   // Set indices and calculate squared norms of the columns.
-  for (size_t i = 0; i < numColumns; i++)
+  #pragma omp parallel for schedule(static)
+  for (omp_size_t i = 0; i < (omp_size_t) numColumns; i++)
   {
     indices[i] = i;
     double l2Norm = arma::norm(dataset.col(i), 2);
@@ -375,18 +376,26 @@ void CosineTree::ModifiedGramSchmidt(CosineNodeQueue& treeQueue,
   // Set new basis vector to centroid.
   newBasisVector = centroid;
 
-  // Variables for iterating throught the priority queue.
-  CosineTree *currentNode;
-  CosineNodeQueue::const_iterator i = treeQueue.begin();
+  // Collect the nodes in the queue so that the projections can be computed in
+  // parallel.  Every projection is measured against the original centroid, so
+  // the updates are independent of each other.
+  std::vector<CosineTree*> basisNodes(treeQueue.begin(), treeQueue.end());
 
   // For every vector in the current basis, remove its projection from the
   // centroid.
-  for ( ; i != treeQueue.end(); i++)
+  #pragma omp parallel
   {
-    currentNode = *i;
+    arma::vec localUpdate(centroid.n_elem, arma::fill::zeros);
 
-    double projection = arma::dot(currentNode->BasisVector(), centroid);
-    newBasisVector -= projection * currentNode->BasisVector();
+    #pragma omp for schedule(static) nowait
+    for (omp_size_t i = 0; i < (omp_size_t) basisNodes.size(); i++)
+    {
+      double projection = arma::dot(basisNodes[i]->BasisVector(), centroid);
+      localUpdate += projection * basisNodes[i]->BasisVector();
+    }
+
+    #pragma omp critical
+    newBasisVector -= localUpdate;
   }
 
   // If additional basis vector is passed, take it into account.
@@ -429,24 +438,25 @@ double CosineTree::MonteCarloError(CosineTree* node,
   else
     projectionSize = treeQueue.size();
 
+  // Collect the nodes in the queue so that the samples can be projected in
+  // parallel; the sampling itself happened above, so no random number
+  // generation takes place inside the parallel loop.
+  std::vector<CosineTree*> basisNodes(treeQueue.begin(), treeQueue.end());
+
   // For each sample, calculate the weighted projection onto the current basis.
-  for (size_t i = 0; i < numSamples; i++)
+  #pragma omp parallel for schedule(static)
+  for (omp_size_t i = 0; i < (omp_size_t) numSamples; i++)
   {
     // Initialize projection as a vector of zeros.
     arma::vec projection;
     projection.zeros(projectionSize);
 
-    CosineTree *currentNode;
-    CosineNodeQueue::const_iterator j = treeQueue.begin();
-
     size_t k = 0;
     // Compute the projection of the sampled vector onto the existing subspace.
-    for ( ; j != treeQueue.end(); j++, k++)
+    for ( ; k < basisNodes.size(); k++)
     {
-      currentNode = *j;
-
       projection(k) = arma::dot(dataset.col(sampledIndices[i]),
-                                currentNode->BasisVector());
+                                basisNodes[k]->BasisVector());
     }
     // If two additional vectors are passed, take their projections.
     if (addBasisVector1 && addBasisVector2)
@@ -633,7 +643,8 @@ void CosineTree::CalculateCosines(arma::vec& cosines)
   // Initialize cosine vector as a vector of zeros.
   cosines.zeros(numColumns);
 
-  for (size_t i = 0; i < numColumns; i++)
+  #pragma omp parallel for schedule(static)
+  for (omp_size_t i = 0; i < (omp_size_t) numColumns; i++)
   {
     // If norm is zero, store cosine value as zero. Else, calculate cosine value
     // between two vectors.
@@ -655,10 +666,18 @@ void CosineTree::CalculateCentroid()
   // Initialize centroid as vector of zeros.
   centroid.zeros(dataset->n_rows);
 
-  // Calculate centroid of columns in the node.
-  for (size_t i = 0; i < numColumns; i++)
+  // Calculate centroid of columns in the node, accumulating thread-local
+  // partial sums.
+  #pragma omp parallel
   {
-    centroid += dataset->col(indices[i]);
+    arma::vec localCentroid(dataset->n_rows, arma::fill::zeros);
+
+    #pragma omp for schedule(static) nowait
+    for (omp_size_t i = 0; i < (omp_size_t) numColumns; i++)
+      localCentroid += dataset->col(indices[i]);
+
+    #pragma omp critical
+    centroid += localCentroid;
   }
   centroid /= numColumns;
 }
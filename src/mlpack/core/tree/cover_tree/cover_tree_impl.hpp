@@ -1392,9 +1392,13 @@ void CoverTree<MetricType, StatisticType, MatType, RootPointPolicy>::
                      const size_t pointSetSize)
 {
   // For each point, rebuild the distances.  The indices do not need to be
-  // modified.
+  // modified.  The evaluations are independent and each one writes its own
+  // slot of the distances array, so they can be computed in parallel without
+  // changing the result; for small sets the loop stays serial to avoid the
+  // overhead of a parallel region.
   distanceComps += pointSetSize;
-  for (size_t i = 0; i < pointSetSize; ++i)
+  #pragma omp parallel for schedule(static) if (pointSetSize > 2048)
+  for (omp_size_t i = 0; i < (omp_size_t) pointSetSize; ++i)
   {
     distances[i] = metric->Evaluate(dataset->col(pointIndex),
         dataset->col(indices[i]));
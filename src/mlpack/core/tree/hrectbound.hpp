@@ -139,6 +139,21 @@ class HRectBound
    */
   ElemType MinDistance(const HRectBound& other) const;
 
+  /**
+   * Calculates the minimum distance between this bound and each of the given
+   * candidate bounds, storing the result in the distances vector.  This is
+   * equivalent to calling MinDistance() on each candidate in turn, but the
+   * batched form keeps this bound's ranges hot in registers/cache while many
+   * candidates are scored, which matters when ranking the children of a wide
+   * node during traversal.
+   *
+   * @param others Candidate bounds to score against.
+   * @param distances Vector to store the minimum distances into; it will be
+   *     resized to others.size().
+   */
+  void MinDistances(const std::vector<const HRectBound*>& others,
+                    arma::Col<ElemType>& distances) const;
+
   /**
    * Calculates maximum bound-to-point squared distance.
    *
@@ -232,6 +247,21 @@ class HRectBound
   void serialize(Archive& ar, const unsigned int version);
 
  private:
+  /**
+   * Expand the per-dimension ranges to include the given dense points; the
+   * helper behind operator|=(const MatType&).
+   */
+  template<typename MatType>
+  void Expand(const MatType& data, const std::false_type& isSparse);
+
+  /**
+   * Expand the per-dimension ranges to include the given sparse points in
+   * one pass over the nonzero entries, widening dimensions with implicit
+   * zeros to include zero.
+   */
+  template<typename MatType>
+  void Expand(const MatType& data, const std::true_type& isSparse);
+
   //! The dimensionality of the bound.
   size_t dim;
   //! The bounds for each dimension.
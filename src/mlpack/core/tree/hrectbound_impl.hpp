@@ -13,6 +13,7 @@
 #define MLPACK_CORE_TREE_HRECTBOUND_IMPL_HPP
 
 #include <math.h>
+#include <algorithm>
 
 // In case it has not been included yet.
 #include "hrectbound.hpp"
@@ -171,50 +172,34 @@ inline ElemType HRectBound<MetricType, ElemType>::MinDistance(
 
   ElemType sum = 0;
 
-  ElemType lower, higher;
   for (size_t d = 0; d < dim; d++)
   {
-    lower = bounds[d].Lo() - point[d];
-    higher = point[d] - bounds[d].Hi();
-
-    // Since only one of 'lower' or 'higher' is negative, if we add each's
-    // absolute value to itself and then sum those two, our result is the
-    // nonnegative half of the equation times two; then we raise to power Power.
+    const ElemType lower = bounds[d].Lo() - point[d];
+    const ElemType higher = point[d] - bounds[d].Hi();
+
+    // At most one of 'lower' and 'higher' is positive, and it is the distance
+    // to the nearer face of the bound in this dimension (or zero if the point
+    // is inside the slab).  max() compiles to a single branchless instruction
+    // and the loop body carries no other control flow, so this loop
+    // vectorizes under -O3.  The compiler should optimize out the if
+    // statement entirely.
+    const ElemType dist = std::max(std::max(lower, higher), (ElemType) 0);
     if (MetricType::Power == 1)
-      sum += (lower + std::fabs(lower)) + (higher + std::fabs(higher));
+      sum += dist;
     else if (MetricType::Power == 2)
-    {
-      ElemType dist = (lower + std::fabs(lower)) + (higher + std::fabs(higher));
       sum += dist * dist;
-    }
     else
-    {
-      sum += pow((lower + fabs(lower)) + (higher + fabs(higher)),
-          (ElemType) MetricType::Power);
-    }
+      sum += pow(dist, (ElemType) MetricType::Power);
   }
 
-  // Now take the Power'th root (but make sure our result is squared if it needs
-  // to be); then cancel out the constant of 2 (which may have been squared now)
-  // that was introduced earlier.  The compiler should optimize out the if
-  // statement entirely.
-  if (MetricType::Power == 1)
-    return sum * 0.5;
+  // Now take the Power'th root if needed.  The compiler should optimize out
+  // the if statement entirely.
+  if ((MetricType::Power == 1) || !MetricType::TakeRoot)
+    return sum;
   else if (MetricType::Power == 2)
-  {
-    if (MetricType::TakeRoot)
-      return (ElemType) std::sqrt(sum) * 0.5;
-    else
-      return sum * 0.25;
-  }
+    return (ElemType) std::sqrt(sum);
   else
-  {
-    if (MetricType::TakeRoot)
-      return (ElemType) pow((double) sum,
-          1.0 / (double) MetricType::Power) / 2.0;
-    else
-      return sum / pow(2.0, MetricType::Power);
-  }
+    return (ElemType) pow((double) sum, 1.0 / (double) MetricType::Power);
 }
 
 /**
@@ -230,52 +215,44 @@ ElemType HRectBound<MetricType, ElemType>::MinDistance(const HRectBound& other)
   const math::RangeType<ElemType>* mbound = bounds;
   const math::RangeType<ElemType>* obound = other.bounds;
 
-  ElemType lower, higher;
   for (size_t d = 0; d < dim; d++)
   {
-    lower = obound->Lo() - mbound->Hi();
-    higher = mbound->Lo() - obound->Hi();
-    // We invoke the following:
-    //   x + fabs(x) = max(x * 2, 0)
-    //   (x * 2)^2 / 4 = x^2
-
-    // The compiler should optimize out this if statement entirely.
+    const ElemType lower = obound[d].Lo() - mbound[d].Hi();
+    const ElemType higher = mbound[d].Lo() - obound[d].Hi();
+
+    // At most one of 'lower' and 'higher' is positive: the gap between the
+    // two slabs in this dimension, or zero if they overlap.  The branchless
+    // max() keeps this loop vectorizable.  The compiler should optimize out
+    // the if statement entirely.
+    const ElemType dist = std::max(std::max(lower, higher), (ElemType) 0);
     if (MetricType::Power == 1)
-      sum += (lower + std::fabs(lower)) + (higher + std::fabs(higher));
+      sum += dist;
     else if (MetricType::Power == 2)
-    {
-      ElemType dist = (lower + std::fabs(lower)) + (higher + std::fabs(higher));
       sum += dist * dist;
-    }
     else
-    {
-      sum += pow((lower + fabs(lower)) + (higher + fabs(higher)),
-          (ElemType) MetricType::Power);
-    }
-
-    // Move bound pointers.
-    mbound++;
-    obound++;
+      sum += pow(dist, (ElemType) MetricType::Power);
   }
 
   // The compiler should optimize out this if statement entirely.
-  if (MetricType::Power == 1)
-    return sum * 0.5;
+  if ((MetricType::Power == 1) || !MetricType::TakeRoot)
+    return sum;
   else if (MetricType::Power == 2)
-  {
-    if (MetricType::TakeRoot)
-      return (ElemType) std::sqrt(sum) * 0.5;
-    else
-      return sum * 0.25;
-  }
+    return (ElemType) std::sqrt(sum);
   else
-  {
-    if (MetricType::TakeRoot)
-      return (ElemType) pow((double) sum,
-          1.0 / (double) MetricType::Power) / 2.0;
-    else
-      return sum / pow(2.0, MetricType::Power);
-  }
+    return (ElemType) pow((double) sum, 1.0 / (double) MetricType::Power);
+}
+
+/**
+ * Calculates minimum bound-to-bound distance for a batch of candidates.
+ */
+template<typename MetricType, typename ElemType>
+void HRectBound<MetricType, ElemType>::MinDistances(
+    const std::vector<const HRectBound*>& others,
+    arma::Col<ElemType>& distances) const
+{
+  distances.set_size(others.size());
+  for (size_t i = 0; i < others.size(); ++i)
+    distances[i] = MinDistance(*others[i]);
 }
 
 /**
@@ -512,13 +489,12 @@ HRectBound<MetricType, ElemType>::operator|=(const MatType& data)
 {
   Log::Assert(data.n_rows == dim);
 
-  arma::Col<ElemType> mins(min(data, 1));
-  arma::Col<ElemType> maxs(max(data, 1));
+  Expand(data, std::integral_constant<bool,
+      arma::is_arma_sparse_type<MatType>::value>());
 
   minWidth = std::numeric_limits<ElemType>::max();
   for (size_t i = 0; i < dim; i++)
   {
-    bounds[i] |= math::RangeType<ElemType>(mins[i], maxs[i]);
     const ElemType width = bounds[i].Width();
     if (width < minWidth)
       minWidth = width;
@@ -527,6 +503,77 @@ HRectBound<MetricType, ElemType>::operator|=(const MatType& data)
   return *this;
 }
 
+/**
+ * Expand the per-dimension ranges to include the given dense points.
+ */
+template<typename MetricType, typename ElemType>
+template<typename MatType>
+inline void HRectBound<MetricType, ElemType>::Expand(
+    const MatType& data,
+    const std::false_type& /* isSparse */)
+{
+  arma::Col<ElemType> mins(min(data, 1));
+  arma::Col<ElemType> maxs(max(data, 1));
+
+  for (size_t i = 0; i < dim; i++)
+    bounds[i] |= math::RangeType<ElemType>(mins[i], maxs[i]);
+}
+
+/**
+ * Expand the per-dimension ranges to include the given sparse points.  The
+ * minima and maxima are gathered in one pass over the nonzero entries; a
+ * dimension whose nonzero count is smaller than the number of points also
+ * contains implicit zeros, so its range is widened to include zero.  The
+ * cost is linear in the number of nonzeros, not in dim times the number of
+ * points.
+ */
+template<typename MetricType, typename ElemType>
+template<typename MatType>
+inline void HRectBound<MetricType, ElemType>::Expand(
+    const MatType& data,
+    const std::true_type& /* isSparse */)
+{
+  // Materialize the expression once; this only copies nonzero entries.
+  const arma::SpMat<ElemType> m(data);
+
+  if (m.n_cols == 0)
+    return;
+
+  arma::Col<ElemType> mins(dim);
+  mins.fill(std::numeric_limits<ElemType>::max());
+  arma::Col<ElemType> maxs(dim);
+  maxs.fill(std::numeric_limits<ElemType>::lowest());
+  arma::Col<arma::uword> nonzeros(dim, arma::fill::zeros);
+
+  for (typename arma::SpMat<ElemType>::const_iterator it = m.begin();
+       it != m.end(); ++it)
+  {
+    const size_t row = it.row();
+    const ElemType value = *it;
+
+    if (value < mins[row])
+      mins[row] = value;
+    if (value > maxs[row])
+      maxs[row] = value;
+    ++nonzeros[row];
+  }
+
+  for (size_t i = 0; i < dim; i++)
+  {
+    // Dimensions with implicit zeros (fewer nonzeros than points) must
+    // include zero in their range; this also covers all-zero dimensions.
+    if (nonzeros[i] < m.n_cols)
+    {
+      if (mins[i] > 0)
+        mins[i] = 0;
+      if (maxs[i] < 0)
+        maxs[i] = 0;
+    }
+
+    bounds[i] |= math::RangeType<ElemType>(mins[i], maxs[i]);
+  }
+}
+
 /**
  * Expands this region to encompass another bound.
  */
@@ -0,0 +1,61 @@
+/**
+ * @file core/tree/morton_sort.hpp
+ *
+ * Pre-sort a dataset into Morton (Z-order) curve order.  Building an Octree
+ * or BinarySpaceTree on a Morton-ordered dataset turns the build's point
+ * permutation into a mostly sequential memory access pattern, and points that
+ * end up in the same leaf tend to be adjacent in memory for later traversals.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_TREE_MORTON_SORT_HPP
+#define MLPACK_CORE_TREE_MORTON_SORT_HPP
+
+#include <mlpack/prereqs.hpp>
+
+namespace mlpack {
+namespace tree {
+
+/**
+ * Reorder the columns of the dataset along the Morton (Z-order) curve.  Each
+ * dimension is scaled to a fixed-width integer grid, the per-dimension bits
+ * are interleaved into a single code, and the columns are sorted by that
+ * code.  The sort is performed bucket-by-bucket in parallel when OpenMP is
+ * enabled, and ties are broken by the original index so the result is
+ * deterministic; in particular, re-sorting an already sorted dataset is a
+ * no-op.
+ *
+ * The mapping follows the tree-building convention: oldFromNew[i] gives the
+ * original index of the point that now sits at column i.  If the dataset is
+ * subsequently passed to a mapping tree constructor, the two mappings must be
+ * composed.
+ *
+ * Only the first 63 dimensions contribute to the code; for datasets of higher
+ * dimensionality the remaining dimensions are ignored during sorting (the
+ * points themselves are not modified).
+ *
+ * @param dataset Dataset to reorder; modified in place.
+ * @param oldFromNew Vector to store the permutation in; it will be resized.
+ */
+template<typename MatType>
+void MortonOrder(MatType& dataset, std::vector<size_t>& oldFromNew);
+
+/**
+ * Reorder the columns of the dataset along the Morton (Z-order) curve,
+ * without storing the permutation.
+ *
+ * @param dataset Dataset to reorder; modified in place.
+ */
+template<typename MatType>
+void MortonOrder(MatType& dataset);
+
+} // namespace tree
+} // namespace mlpack
+
+// Include implementation.
+#include "morton_sort_impl.hpp"
+
+#endif
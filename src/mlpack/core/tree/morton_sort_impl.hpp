@@ -0,0 +1,109 @@
+/**
+ * @file core/tree/morton_sort_impl.hpp
+ *
+ * Implementation of the Morton (Z-order) dataset pre-sort.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_TREE_MORTON_SORT_IMPL_HPP
+#define MLPACK_CORE_TREE_MORTON_SORT_IMPL_HPP
+
+// In case it wasn't included already for some reason.
+#include "morton_sort.hpp"
+
+#include <algorithm>
+
+namespace mlpack {
+namespace tree {
+
+template<typename MatType>
+void MortonOrder(MatType& dataset, std::vector<size_t>& oldFromNew)
+{
+  typedef typename MatType::elem_type ElemType;
+
+  const size_t numPoints = dataset.n_cols;
+  oldFromNew.resize(numPoints);
+  if (numPoints == 0)
+    return;
+
+  // Split the 63 usable code bits evenly over the (leading) dimensions.
+  const size_t codeDims = std::min((size_t) dataset.n_rows, (size_t) 63);
+  const size_t bitsPerDim = std::min((size_t) (63 / codeDims), (size_t) 21);
+  const uint64_t gridSize = (uint64_t(1) << bitsPerDim) - 1;
+
+  // Scale each dimension onto the integer grid.
+  arma::Col<ElemType> mins = arma::min(dataset, 1);
+  arma::Col<ElemType> maxs = arma::max(dataset, 1);
+  arma::Col<ElemType> scales(dataset.n_rows);
+  for (size_t d = 0; d < codeDims; ++d)
+  {
+    const ElemType range = maxs[d] - mins[d];
+    scales[d] = (range > 0) ? (ElemType) gridSize / range : 0;
+  }
+
+  // Compute the interleaved code of every point.  The points are independent,
+  // so this parallelizes trivially.
+  std::vector<uint64_t> codes(numPoints);
+  #pragma omp parallel for schedule(static)
+  for (omp_size_t i = 0; i < (omp_size_t) numPoints; ++i)
+  {
+    // Quantize the coordinates.
+    uint64_t quantized[63];
+    for (size_t d = 0; d < codeDims; ++d)
+      quantized[d] = (uint64_t) (scales[d] * (dataset(d, i) - mins[d]));
+
+    // Interleave the bits, most significant bit first.
+    uint64_t code = 0;
+    for (size_t b = bitsPerDim; b > 0; --b)
+      for (size_t d = 0; d < codeDims; ++d)
+        code = (code << 1) | ((quantized[d] >> (b - 1)) & 1);
+
+    codes[i] = code;
+  }
+
+  // Sort the point indices by code.  We scatter the indices into 256 buckets
+  // by the high byte of the code first, so that the buckets can be sorted in
+  // parallel; this is a two-pass radix-then-comparison sort.
+  const size_t codeBits = codeDims * bitsPerDim;
+  const size_t shift = (codeBits > 8) ? (codeBits - 8) : 0;
+  std::vector<std::vector<size_t>> buckets(256);
+  for (size_t i = 0; i < numPoints; ++i)
+    buckets[(codes[i] >> shift) & 0xff].push_back(i);
+
+  #pragma omp parallel for schedule(dynamic)
+  for (omp_size_t b = 0; b < 256; ++b)
+  {
+    std::sort(buckets[b].begin(), buckets[b].end(),
+        [&codes](const size_t a, const size_t c)
+        {
+          return (codes[a] < codes[c]) || (codes[a] == codes[c] && a < c);
+        });
+  }
+
+  size_t next = 0;
+  for (size_t b = 0; b < 256; ++b)
+    for (size_t j = 0; j < buckets[b].size(); ++j)
+      oldFromNew[next++] = buckets[b][j];
+
+  // Gather the columns in sorted order; the writes are sequential.
+  MatType sorted(dataset.n_rows, numPoints);
+  for (size_t i = 0; i < numPoints; ++i)
+    sorted.col(i) = dataset.col(oldFromNew[i]);
+
+  dataset = std::move(sorted);
+}
+
+template<typename MatType>
+void MortonOrder(MatType& dataset)
+{
+  std::vector<size_t> oldFromNew;
+  MortonOrder(dataset, oldFromNew);
+}
+
+} // namespace tree
+} // namespace mlpack
+
+#endif
@@ -127,13 +127,18 @@ class RectangleTree
    *      have.
    * @param firstDataIndex The index of the first data point.  UNUSED UNLESS WE
    *      ADD SUPPORT FOR HAVING A "CENTERAL" DATA MATRIX.
+   * @param bulkLoad If true, build the tree with a Sort-Tile-Recursive (STR)
+   *      bulk load instead of one-point-at-a-time insertion.  This is much
+   *      faster for large datasets and produces tightly packed nodes, but the
+   *      tree should then be treated as read-only (see BulkLoad()).
    */
   RectangleTree(const MatType& data,
                 const size_t maxLeafSize = 20,
                 const size_t minLeafSize = 8,
                 const size_t maxNumChildren = 5,
                 const size_t minNumChildren = 2,
-                const size_t firstDataIndex = 0);
+                const size_t firstDataIndex = 0,
+                const bool bulkLoad = false);
 
   /**
    * Construct this as the root node of a rectangle tree type using the given
@@ -148,13 +153,18 @@ class RectangleTree
    *      have.
    * @param firstDataIndex The index of the first data point.  UNUSED UNLESS WE
    *      ADD SUPPORT FOR HAVING A "CENTERAL" DATA MATRIX.
+   * @param bulkLoad If true, build the tree with a Sort-Tile-Recursive (STR)
+   *      bulk load instead of one-point-at-a-time insertion.  This is much
+   *      faster for large datasets and produces tightly packed nodes, but the
+   *      tree should then be treated as read-only (see BulkLoad()).
    */
   RectangleTree(MatType&& data,
                 const size_t maxLeafSize = 20,
                 const size_t minLeafSize = 8,
                 const size_t maxNumChildren = 5,
                 const size_t minNumChildren = 2,
-                const size_t firstDataIndex = 0);
+                const size_t firstDataIndex = 0,
+                const bool bulkLoad = false);
 
   /**
    * Construct this as an empty node with the specified parent.  Copying the
@@ -557,6 +567,40 @@ class RectangleTree
    */
   void SplitNode(std::vector<bool>& relevels);
 
+  /**
+   * Build the tree with a Sort-Tile-Recursive bulk load: order the points
+   * with a recursive sort-and-tile pass, pack them into full leaves, and then
+   * stack internal levels on top until everything hangs off this (root) node.
+   * This avoids the per-point descent and node splitting of incremental
+   * insertion entirely, and every node except the last at each level is
+   * filled to capacity.
+   *
+   * Because the nodes are constructed directly, any auxiliary information
+   * that is normally maintained during insertion (e.g. the Hilbert values of
+   * a Hilbert R-tree) is left at its default.  Queries do not use that
+   * information, so a bulk-loaded tree of any variant can be searched as
+   * usual, but incremental modification of a bulk-loaded Hilbert R-tree or
+   * R++ tree is not supported.
+   *
+   * @param firstDataIndex Index of the first point to load.
+   */
+  void BulkLoad(const size_t firstDataIndex);
+
+  /**
+   * Order the point indices in [begin, end) with the Sort-Tile-Recursive
+   * scheme: sort by the given dimension, cut into vertical slabs of roughly
+   * equal leaf count, and recurse into each slab on the next dimension.
+   *
+   * @param ordering Point indices to reorder.
+   * @param begin First index of the range to order.
+   * @param end One past the last index of the range to order.
+   * @param dim Dimension to sort on at this level of the recursion.
+   */
+  void STRSort(std::vector<size_t>& ordering,
+               const size_t begin,
+               const size_t end,
+               const size_t dim) const;
+
   /**
    * Builds statistics for a node and all its descendants in a bottom-up way.
    *
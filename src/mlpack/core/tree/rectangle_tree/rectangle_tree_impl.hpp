@@ -18,10 +18,140 @@
 #include <mlpack/core/util/cli.hpp>
 #include <mlpack/core/util/log.hpp>
 
+#include <algorithm>
+
 namespace mlpack {
 namespace tree {
 
 // Build the statistics, bottom-up.
+template<typename MetricType,
+         typename StatisticType,
+         typename MatType,
+         typename SplitType,
+         typename DescentType,
+         template<typename> class AuxiliaryInformationType>
+void RectangleTree<MetricType, StatisticType, MatType, SplitType, DescentType,
+              AuxiliaryInformationType>::
+STRSort(std::vector<size_t>& ordering,
+        const size_t begin,
+        const size_t end,
+        const size_t dim) const
+{
+  // Sort this range of the ordering by the given dimension.
+  std::sort(ordering.begin() + begin, ordering.begin() + end,
+      [&](const size_t a, const size_t b)
+      { return (*dataset)(dim, a) < (*dataset)(dim, b); });
+
+  // In the last dimension the sorted order is the final order.
+  if (dim + 1 == dataset->n_rows)
+    return;
+
+  // Cut the range into vertical slabs, each holding roughly the number of
+  // leaves needed for this range raised to (d - 1) / d, and tile each slab
+  // recursively on the next dimension.
+  const size_t numPoints = end - begin;
+  const size_t numLeaves = (numPoints + maxLeafSize - 1) / maxLeafSize;
+  if (numLeaves <= 1)
+    return;
+
+  const size_t numSlabs = (size_t) std::ceil(std::pow((double) numLeaves,
+      1.0 / (double) (dataset->n_rows - dim)));
+  const size_t slabSize = (numPoints + numSlabs - 1) / numSlabs;
+
+  for (size_t slabBegin = begin; slabBegin < end; slabBegin += slabSize)
+  {
+    const size_t slabEnd = std::min(slabBegin + slabSize, end);
+    STRSort(ordering, slabBegin, slabEnd, dim + 1);
+  }
+}
+
+template<typename MetricType,
+         typename StatisticType,
+         typename MatType,
+         typename SplitType,
+         typename DescentType,
+         template<typename> class AuxiliaryInformationType>
+void RectangleTree<MetricType, StatisticType, MatType, SplitType, DescentType,
+              AuxiliaryInformationType>::
+BulkLoad(const size_t firstDataIndex)
+{
+  const size_t numPoints = dataset->n_cols - firstDataIndex;
+  if (numPoints == 0)
+    return;
+
+  // Compute the Sort-Tile-Recursive ordering of the points.
+  std::vector<size_t> ordering(numPoints);
+  for (size_t i = 0; i < numPoints; ++i)
+    ordering[i] = firstDataIndex + i;
+  STRSort(ordering, 0, numPoints, 0);
+
+  // If everything fits into the root, the root is the single leaf.
+  if (numPoints <= maxLeafSize)
+  {
+    for (size_t i = 0; i < numPoints; ++i)
+    {
+      points[count++] = ordering[i];
+      bound |= dataset->col(ordering[i]);
+    }
+    numDescendants = numPoints;
+    return;
+  }
+
+  // Pack consecutive runs of the ordering into full leaves.  The nodes of
+  // each level are distributed evenly over the groups, so no node ends up
+  // underfull.
+  std::vector<RectangleTree*> level;
+  size_t numGroups = (numPoints + maxLeafSize - 1) / maxLeafSize;
+  size_t next = 0;
+  for (size_t g = 0; g < numGroups; ++g)
+  {
+    // Integer arithmetic that splits numPoints as evenly as possible.
+    const size_t groupEnd = ((g + 1) * numPoints) / numGroups;
+
+    RectangleTree* leaf = new RectangleTree(this);
+    for (; next < groupEnd; ++next)
+    {
+      leaf->points[leaf->count++] = ordering[next];
+      leaf->bound |= dataset->col(ordering[next]);
+    }
+    leaf->numDescendants = leaf->count;
+    level.push_back(leaf);
+  }
+
+  // Now stack internal levels on top until the remaining nodes fit into the
+  // root; consecutive nodes are spatially close because of the STR order.
+  while (level.size() > maxNumChildren)
+  {
+    std::vector<RectangleTree*> nextLevel;
+    numGroups = (level.size() + maxNumChildren - 1) / maxNumChildren;
+    next = 0;
+    for (size_t g = 0; g < numGroups; ++g)
+    {
+      const size_t groupEnd = ((g + 1) * level.size()) / numGroups;
+
+      RectangleTree* node = new RectangleTree(this);
+      for (; next < groupEnd; ++next)
+      {
+        node->children[node->numChildren++] = level[next];
+        level[next]->parent = node;
+        node->bound |= level[next]->bound;
+        node->numDescendants += level[next]->numDescendants;
+      }
+      nextLevel.push_back(node);
+    }
+    level = std::move(nextLevel);
+  }
+
+  // Finally, hang the top level off the root.
+  for (size_t i = 0; i < level.size(); ++i)
+  {
+    children[numChildren++] = level[i];
+    level[i]->parent = this;
+    bound |= level[i]->bound;
+    numDescendants += level[i]->numDescendants;
+  }
+}
+
 template<typename MetricType,
          typename StatisticType,
          typename MatType,
@@ -53,7 +183,8 @@ RectangleTree(const MatType& data,
               const size_t minLeafSize,
               const size_t maxNumChildren,
               const size_t minNumChildren,
-              const size_t firstDataIndex) :
+              const size_t firstDataIndex,
+              const bool bulkLoad) :
     maxNumChildren(maxNumChildren),
     minNumChildren(minNumChildren),
     numChildren(0),
@@ -71,11 +202,18 @@ RectangleTree(const MatType& data,
     points(maxLeafSize + 1), // Add one to make splitting the node simpler.
     auxiliaryInfo(this)
 {
-  // For now, just insert the points in order.
-  RectangleTree* root = this;
+  if (bulkLoad)
+  {
+    BulkLoad(firstDataIndex);
+  }
+  else
+  {
+    // Just insert the points in order.
+    RectangleTree* root = this;
 
-  for (size_t i = firstDataIndex; i < data.n_cols; i++)
-    root->InsertPoint(i);
+    for (size_t i = firstDataIndex; i < data.n_cols; i++)
+      root->InsertPoint(i);
+  }
 
   // Initialize statistic recursively after tree construction is complete.
   BuildStatistics(this);
@@ -94,7 +232,8 @@ RectangleTree(MatType&& data,
               const size_t minLeafSize,
               const size_t maxNumChildren,
               const size_t minNumChildren,
-              const size_t firstDataIndex) :
+              const size_t firstDataIndex,
+              const bool bulkLoad) :
     maxNumChildren(maxNumChildren),
     minNumChildren(minNumChildren),
     numChildren(0),
@@ -112,11 +251,18 @@ RectangleTree(MatType&& data,
     points(maxLeafSize + 1), // Add one to make splitting the node simpler.
     auxiliaryInfo(this)
 {
-  // For now, just insert the points in order.
-  RectangleTree* root = this;
+  if (bulkLoad)
+  {
+    BulkLoad(firstDataIndex);
+  }
+  else
+  {
+    // Just insert the points in order.
+    RectangleTree* root = this;
 
-  for (size_t i = firstDataIndex; i < dataset->n_cols; i++)
-    root->InsertPoint(i);
+    for (size_t i = firstDataIndex; i < dataset->n_cols; i++)
+      root->InsertPoint(i);
+  }
 
   // Initialize statistic recursively after tree construction is complete.
   BuildStatistics(this);
@@ -0,0 +1,205 @@
+/**
+ * @file core/util/arena.hpp
+ *
+ * A bump (arena) allocator for per-traversal scratch state.  Tree traversals
+ * build many short-lived containers (candidate heaps, score arrays) whose
+ * lifetimes all end together when the traversal finishes; carving them out of
+ * a per-thread arena turns each allocation into a pointer bump and makes
+ * freeing them a single offset reset.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_UTIL_ARENA_HPP
+#define MLPACK_CORE_UTIL_ARENA_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace mlpack {
+namespace util {
+
+/**
+ * A growable bump allocator.  Memory is handed out by advancing an offset
+ * through a list of blocks; nothing is freed individually.  Instead, a Scope
+ * records the current position on construction and rewinds to it on
+ * destruction, releasing everything allocated inside the scope at once (the
+ * blocks themselves are kept for reuse).  Scopes must nest like stack frames.
+ *
+ * Each thread should use its own arena; ThreadLocal() returns one that lives
+ * for the lifetime of the thread.
+ */
+class Arena
+{
+ public:
+  /**
+   * Construct an arena.
+   *
+   * @param blockSize Default size of each underlying block, in bytes.
+   */
+  explicit Arena(const size_t blockSize = 1048576) :
+      defaultBlockSize(blockSize),
+      currentBlock(0),
+      offset(0)
+  {
+    /* Blocks are allocated lazily. */
+  }
+
+  /**
+   * Allocate the given number of bytes with the given alignment.  The memory
+   * is uninitialized and must not be freed; it is reclaimed when an enclosing
+   * Scope ends.
+   *
+   * @param bytes Number of bytes to allocate.
+   * @param alignment Required alignment (must be a power of two).
+   */
+  void* Allocate(const size_t bytes, const size_t alignment)
+  {
+    if (blocks.empty())
+      AddBlock(std::max(bytes + alignment, defaultBlockSize));
+
+    // Advance through the blocks until the allocation fits, growing the arena
+    // if necessary.  Retained blocks from a rewound scope may be smaller than
+    // this allocation, so more than one step may be needed.
+    while (true)
+    {
+      const uintptr_t base = (uintptr_t) blocks[currentBlock].get();
+      const uintptr_t aligned = (base + offset + alignment - 1) &
+          ~((uintptr_t) alignment - 1);
+      const size_t newOffset = (size_t) (aligned - base) + bytes;
+      if (newOffset <= blockSizes[currentBlock])
+      {
+        offset = newOffset;
+        return (void*) aligned;
+      }
+
+      if (currentBlock + 1 == blocks.size())
+        AddBlock(std::max(bytes + alignment, defaultBlockSize));
+      ++currentBlock;
+      offset = 0;
+    }
+  }
+
+  /**
+   * A scope that rewinds the arena on destruction, reclaiming everything that
+   * was allocated since its construction.  Scopes on the same arena must be
+   * destroyed in the reverse order of their construction.
+   */
+  class Scope
+  {
+   public:
+    //! Record the current position of the given arena.
+    explicit Scope(Arena& arena) :
+        arena(arena),
+        block(arena.currentBlock),
+        offset(arena.offset)
+    {
+      /* Nothing to do. */
+    }
+
+    //! Record the current position of the calling thread's arena.
+    Scope() : Scope(ThreadLocal()) { }
+
+    //! Rewind the arena to the recorded position.
+    ~Scope()
+    {
+      arena.currentBlock = block;
+      arena.offset = offset;
+    }
+
+    // A scope marks a position; it cannot be copied or moved.
+    Scope(const Scope&) = delete;
+    Scope& operator=(const Scope&) = delete;
+
+   private:
+    //! The arena this scope rewinds.
+    Arena& arena;
+    //! The recorded block index.
+    size_t block;
+    //! The recorded offset into the block.
+    size_t offset;
+  };
+
+  /**
+   * Get the arena of the calling thread.
+   */
+  static Arena& ThreadLocal()
+  {
+    static thread_local Arena arena;
+    return arena;
+  }
+
+ private:
+  //! Append a block of the given size.
+  void AddBlock(const size_t size)
+  {
+    blocks.push_back(std::unique_ptr<char[]>(new char[size]));
+    blockSizes.push_back(size);
+  }
+
+  //! The underlying blocks.
+  std::vector<std::unique_ptr<char[]>> blocks;
+  //! The size of each block.
+  std::vector<size_t> blockSizes;
+  //! Default size of newly added blocks.
+  size_t defaultBlockSize;
+  //! Index of the block currently being bumped through.
+  size_t currentBlock;
+  //! Offset of the first free byte in the current block.
+  size_t offset;
+};
+
+/**
+ * A standard-library-compatible allocator that carves memory out of the
+ * calling thread's arena.  deallocate() is a no-op: containers using this
+ * allocator must not outlive the Arena::Scope that covers their lifetime.
+ */
+template<typename T>
+class ArenaAllocator
+{
+ public:
+  typedef T value_type;
+
+  ArenaAllocator() = default;
+
+  template<typename U>
+  ArenaAllocator(const ArenaAllocator<U>& /* other */) { }
+
+  template<typename U>
+  struct rebind
+  {
+    typedef ArenaAllocator<U> other;
+  };
+
+  T* allocate(const size_t count)
+  {
+    return (T*) Arena::ThreadLocal().Allocate(count * sizeof(T), alignof(T));
+  }
+
+  void deallocate(T* /* pointer */, const size_t /* count */)
+  {
+    // Memory is reclaimed when the enclosing Arena::Scope ends.
+  }
+};
+
+template<typename T, typename U>
+inline bool operator==(const ArenaAllocator<T>&, const ArenaAllocator<U>&)
+{
+  return true;
+}
+
+template<typename T, typename U>
+inline bool operator!=(const ArenaAllocator<T>&, const ArenaAllocator<U>&)
+{
+  return false;
+}
+
+} // namespace util
+} // namespace mlpack
+
+#endif // MLPACK_CORE_UTIL_ARENA_HPP
@@ -156,13 +156,30 @@ void CLI::MakeInPlaceCopy(const std::string& outputParamName,
   }
 }
 
-// Returns the sole instance of this class.
+// Returns the sole instance of this class---for the calling thread.  The
+// active parameter state is thread-local, so independent binding invocations
+// on different threads do not interfere with each other; only the storage map
+// of stored parameter sets (see StorageMap()) is shared between threads.
 CLI& CLI::GetSingleton()
 {
-  static CLI singleton;
+  static thread_local CLI singleton;
   return singleton;
 }
 
+// Returns the storage map for stored parameter sets, shared by all threads.
+CLI::StorageMapType& CLI::StorageMap()
+{
+  static StorageMapType storageMap;
+  return storageMap;
+}
+
+// Returns the mutex guarding the shared storage map.
+std::mutex& CLI::StorageMutex()
+{
+  static std::mutex storageMutex;
+  return storageMutex;
+}
+
 /**
  * Registers a ProgramDoc object, which contains documentation about the
  * program.
@@ -211,11 +228,14 @@ void CLI::SetPassed(const std::string& name)
 // Store settings.
 void CLI::StoreSettings(const std::string& name)
 {
-  // Take all of the parameters and put them in the map.  Clear anything old
-  // first.
-  std::get<0>(GetSingleton().storageMap[name]) = GetSingleton().parameters;
-  std::get<1>(GetSingleton().storageMap[name]) = GetSingleton().aliases;
-  std::get<2>(GetSingleton().storageMap[name]) = GetSingleton().functionMap;
+  // Take all of the parameters and put them in the shared map.  Clear
+  // anything old first.
+  {
+    std::lock_guard<std::mutex> lock(StorageMutex());
+    std::get<0>(StorageMap()[name]) = GetSingleton().parameters;
+    std::get<1>(StorageMap()[name]) = GetSingleton().aliases;
+    std::get<2>(StorageMap()[name]) = GetSingleton().functionMap;
+  }
 
   ClearSettings();
 }
@@ -223,21 +243,25 @@ void CLI::StoreSettings(const std::string& name)
 // Restore settings.
 void CLI::RestoreSettings(const std::string& name, const bool fatal)
 {
-  if (GetSingleton().storageMap.count(name) == 0 && fatal)
+  // Copy the stored settings out of the shared map under the lock, into this
+  // thread's own parameter state.
+  std::unique_lock<std::mutex> lock(StorageMutex());
+  if (StorageMap().count(name) == 0 && fatal)
   {
     throw std::invalid_argument("no settings stored under the name '" + name
         + "'");
   }
-  else if (GetSingleton().storageMap.count(name) == 0 && !fatal)
+  else if (StorageMap().count(name) == 0 && !fatal)
   {
     // Nothing to do, just clear what's there.
+    lock.unlock();
     ClearSettings();
   }
   else
   {
-    GetSingleton().parameters = std::get<0>(GetSingleton().storageMap[name]);
-    GetSingleton().aliases = std::get<1>(GetSingleton().storageMap[name]);
-    GetSingleton().functionMap = std::get<2>(GetSingleton().storageMap[name]);
+    GetSingleton().parameters = std::get<0>(StorageMap()[name]);
+    GetSingleton().aliases = std::get<1>(StorageMap()[name]);
+    GetSingleton().functionMap = std::get<2>(StorageMap()[name]);
   }
 }
 
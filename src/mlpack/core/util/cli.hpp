@@ -17,6 +17,7 @@
 #include <list>
 #include <iostream>
 #include <map>
+#include <mutex>
 #include <string>
 
 #include <boost/any.hpp>
@@ -234,6 +235,13 @@ class CLI
    * as there is no point in defining static methods only to have users call
    * private instance methods.
    *
+   * The returned instance is thread-local: each thread has its own active
+   * parameter state, so independent binding invocations can run concurrently
+   * on different threads.  Parameter sets stored with StoreSettings() (which
+   * happens when each binding's options are registered, during static
+   * initialization) are shared by all threads, so any thread can call
+   * RestoreSettings() to populate its own state.
+   *
    * @return The singleton instance for use in the static methods.
    */
   static CLI& GetSingleton();
@@ -302,9 +310,23 @@ class CLI
   FunctionMapType functionMap;
 
  private:
-  //! Storage map for parameters.
-  std::map<std::string, std::tuple<std::map<std::string, util::ParamData>,
-      std::map<char, std::string>, FunctionMapType>> storageMap;
+  //! Type of the storage map for stored parameter sets.
+  typedef std::map<std::string, std::tuple<std::map<std::string,
+      util::ParamData>, std::map<char, std::string>, FunctionMapType>>
+      StorageMapType;
+
+  /**
+   * The storage map for stored parameter sets is shared by all threads: it is
+   * filled during static initialization (when each binding's options are
+   * registered and stored), and after that RestoreSettings() only reads from
+   * it.  The active parameter state, on the other hand, is per-thread (see
+   * GetSingleton()), so independent binding invocations on different threads
+   * do not interfere with each other.
+   */
+  static StorageMapType& StorageMap();
+
+  //! Mutex guarding writes to (and copies out of) the shared storage map.
+  static std::mutex& StorageMutex();
 
  public:
   //! True, if CLI was used to parse command line options.
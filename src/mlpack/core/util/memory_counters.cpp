@@ -0,0 +1,230 @@
+/**
+ * @file core/util/memory_counters.cpp
+ *
+ * Implementation of allocation tracking for named regions, and the Armadillo
+ * allocation hooks that feed it.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#include "memory_counters.hpp"
+#include "log.hpp"
+
+#include <atomic>
+#include <cstdlib>
+#include <mutex>
+
+using namespace std;
+
+namespace mlpack {
+
+namespace {
+
+//! Whether tracking is enabled; disabled by default, like timing.
+atomic<bool> trackingEnabled(false);
+
+//! Guards the region maps and the live byte count.
+mutex countersMutex;
+
+//! Number of Armadillo bytes currently allocated.  This is maintained even
+//! while tracking is disabled, so that a region started later sees the true
+//! baseline rather than only the allocations made after Enable().
+uint64_t liveBytes = 0;
+
+//! Finished (accumulated) values per region.
+map<string, MemoryCounterValues>& Counters()
+{
+  static map<string, MemoryCounterValues> counters;
+  return counters;
+}
+
+//! Values of the regions that are currently running.  peakBytes of a running
+//! region is updated on every allocation.
+map<string, MemoryCounterValues>& ActiveRegions()
+{
+  static map<string, MemoryCounterValues> active;
+  return active;
+}
+
+} // namespace
+
+void MemoryCounters::Enable()
+{
+  trackingEnabled = true;
+}
+
+void MemoryCounters::Disable()
+{
+  trackingEnabled = false;
+}
+
+bool MemoryCounters::Available()
+{
+#if defined(MLPACK_ENABLE_MEMORY_TRACKING)
+  return true;
+#else
+  return false;
+#endif
+}
+
+void MemoryCounters::Start(const string& name)
+{
+  if (!trackingEnabled)
+    return;
+
+  lock_guard<mutex> lock(countersMutex);
+
+  // The peak starts at the current live count: a region that allocates
+  // nothing still reports the memory that was already held while it ran.
+  MemoryCounterValues& values = ActiveRegions()[name];
+  values.peakBytes = liveBytes;
+  values.allocations = 0;
+  values.allocatedBytes = 0;
+}
+
+void MemoryCounters::Stop(const string& name)
+{
+  if (!trackingEnabled)
+    return;
+
+  lock_guard<mutex> lock(countersMutex);
+
+  map<string, MemoryCounterValues>::iterator it = ActiveRegions().find(name);
+  if (it == ActiveRegions().end())
+    return; // Start() was never called (or tracking was enabled in between).
+
+  MemoryCounterValues& total = Counters()[name];
+  total.peakBytes = max(total.peakBytes, it->second.peakBytes);
+  total.allocations += it->second.allocations;
+  total.allocatedBytes += it->second.allocatedBytes;
+
+  ActiveRegions().erase(it);
+}
+
+MemoryCounterValues MemoryCounters::Get(const string& name)
+{
+  lock_guard<mutex> lock(countersMutex);
+
+  map<string, MemoryCounterValues>::const_iterator it = Counters().find(name);
+  return (it == Counters().end()) ? MemoryCounterValues() : it->second;
+}
+
+map<string, MemoryCounterValues> MemoryCounters::GetAllCounters()
+{
+  lock_guard<mutex> lock(countersMutex);
+  return Counters();
+}
+
+void MemoryCounters::Print(const string& name)
+{
+  const MemoryCounterValues values = Get(name);
+
+  // Report the peak in the most convenient unit, like PrintTimer() does for
+  // times.
+  Log::Info << "peak ";
+  if (values.peakBytes >= (uint64_t) 1073741824)
+    Log::Info << (double) values.peakBytes / 1073741824.0 << " GB";
+  else if (values.peakBytes >= (uint64_t) 1048576)
+    Log::Info << (double) values.peakBytes / 1048576.0 << " MB";
+  else if (values.peakBytes >= (uint64_t) 1024)
+    Log::Info << (double) values.peakBytes / 1024.0 << " KB";
+  else
+    Log::Info << values.peakBytes << " bytes";
+
+  Log::Info << ", " << values.allocations << " allocations, "
+      << values.allocatedBytes << " bytes allocated" << std::endl;
+}
+
+void MemoryCounters::Reset()
+{
+  lock_guard<mutex> lock(countersMutex);
+  Counters().clear();
+  ActiveRegions().clear();
+}
+
+void MemoryCounters::RecordAllocation(const size_t bytes)
+{
+  lock_guard<mutex> lock(countersMutex);
+
+  liveBytes += bytes;
+
+  if (!trackingEnabled)
+    return;
+
+  for (auto& region : ActiveRegions())
+  {
+    region.second.peakBytes = max(region.second.peakBytes, liveBytes);
+    region.second.allocations++;
+    region.second.allocatedBytes += bytes;
+  }
+}
+
+void MemoryCounters::RecordDeallocation(const size_t bytes)
+{
+  lock_guard<mutex> lock(countersMutex);
+  liveBytes -= min(liveBytes, (uint64_t) bytes);
+}
+
+#if defined(MLPACK_ENABLE_MEMORY_TRACKING)
+
+namespace memory {
+
+// These are installed as ARMA_ALIEN_MEM_ALLOC_FUNCTION and
+// ARMA_ALIEN_MEM_FREE_FUNCTION in arma_extend.hpp, so every Armadillo
+// allocation in the process passes through here.  Armadillo's release()
+// hands back only the pointer, so the size of each live allocation is kept
+// here until it is freed.
+
+namespace {
+
+mutex sizesMutex;
+
+map<void*, size_t>& AllocationSizes()
+{
+  static map<void*, size_t> sizes;
+  return sizes;
+}
+
+} // namespace
+
+void* TrackedAlloc(const size_t bytes)
+{
+  void* mem = malloc(bytes);
+  if (mem != NULL)
+  {
+    {
+      lock_guard<mutex> lock(sizesMutex);
+      AllocationSizes()[mem] = bytes;
+    }
+    MemoryCounters::RecordAllocation(bytes);
+  }
+  return mem;
+}
+
+void TrackedFree(void* mem)
+{
+  if (mem == NULL)
+    return;
+
+  size_t bytes = 0;
+  {
+    lock_guard<mutex> lock(sizesMutex);
+    map<void*, size_t>::iterator it = AllocationSizes().find(mem);
+    if (it != AllocationSizes().end())
+    {
+      bytes = it->second;
+      AllocationSizes().erase(it);
+    }
+  }
+
+  free(mem);
+  MemoryCounters::RecordDeallocation(bytes);
+}
+
+} // namespace memory
+
+#endif
+
+} // namespace mlpack
@@ -0,0 +1,142 @@
+/**
+ * @file core/util/memory_counters.hpp
+ *
+ * Allocation tracking for named regions, alongside the Timer class.  When
+ * mlpack is built with MEMORY_TRACKING enabled, every Armadillo allocation
+ * and deallocation is routed through these counters (see arma_extend.hpp),
+ * so the peak number of live bytes and the allocation count of each
+ * instrumented region can be reported next to its time.  Without the build
+ * flag, every operation is a no-op and all counters read as zero.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_UTIL_MEMORY_COUNTERS_HPP
+#define MLPACK_CORE_UTIL_MEMORY_COUNTERS_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <string>
+
+namespace mlpack {
+
+/**
+ * The allocation statistics accumulated for one named region.
+ */
+struct MemoryCounterValues
+{
+  //! Highest number of live Armadillo bytes observed while the region ran.
+  uint64_t peakBytes = 0;
+  //! Number of allocations made while the region ran.
+  uint64_t allocations = 0;
+  //! Total bytes allocated while the region ran.
+  uint64_t allocatedBytes = 0;
+};
+
+/**
+ * Allocation instrumentation for named regions.  The interface mirrors the
+ * Timer class: tracking must be enabled before Start() has any effect, and
+ * values are additive across repeated Start()/Stop() runs of the same region
+ * (peaks combine by maximum).  A typical use brackets a phase the same way a
+ * timer would:
+ *
+ * @code
+ * MemoryCounters::Enable();
+ * MemoryCounters::Start("tree_building");
+ * // ... work ...
+ * MemoryCounters::Stop("tree_building");
+ * Log::Info << "peak bytes during tree building: "
+ *     << MemoryCounters::Get("tree_building").peakBytes << std::endl;
+ * @endcode
+ *
+ * Only memory that Armadillo allocates is visible here; containers that
+ * allocate through the default allocator (std::vector and friends) are not
+ * counted.  For the dense matrix copies that dominate mlpack's footprint
+ * this is the right scope, and it keeps the tracking overhead to one counter
+ * update per matrix allocation rather than one per operator new.
+ */
+class MemoryCounters
+{
+ public:
+  /**
+   * Enable allocation tracking.  Do not call this while regions are running.
+   */
+  static void Enable();
+
+  /**
+   * Disable allocation tracking.  Do not call this while regions are running.
+   */
+  static void Disable();
+
+  /**
+   * Return true if allocation tracking was compiled in (the MEMORY_TRACKING
+   * build flag, which requires Armadillo 9.900 or newer for the allocation
+   * hooks).  When this returns false, Start() and Stop() are no-ops and
+   * Get() returns zeros; callers do not need to check before instrumenting.
+   */
+  static bool Available();
+
+  /**
+   * Start tracking for the given region.
+   *
+   * @param name Name of the region.
+   */
+  static void Start(const std::string& name);
+
+  /**
+   * Stop tracking for the given region and accumulate its values.
+   *
+   * @param name Name of the region.
+   */
+  static void Stop(const std::string& name);
+
+  /**
+   * Get the accumulated values of the given region.
+   *
+   * @param name Name of the region.
+   */
+  static MemoryCounterValues Get(const std::string& name);
+
+  /**
+   * Return a copy of the values of every region tracked so far.
+   */
+  static std::map<std::string, MemoryCounterValues> GetAllCounters();
+
+  /**
+   * Print the values of the given region to Log::Info, in the same style the
+   * timers are reported in.
+   *
+   * @param name Name of the region.
+   */
+  static void Print(const std::string& name);
+
+  /**
+   * Remove all knowledge of existing regions.  Whether or not tracking is
+   * enabled is not changed.  Do not call this while regions are running.
+   */
+  static void Reset();
+
+  /**
+   * Record an allocation of the given size.  This is called by the Armadillo
+   * allocation hook; there should be no reason to call it directly.
+   *
+   * @param bytes Size of the allocation.
+   */
+  static void RecordAllocation(const size_t bytes);
+
+  /**
+   * Record a deallocation of the given size.  This is called by the
+   * Armadillo deallocation hook; there should be no reason to call it
+   * directly.
+   *
+   * @param bytes Size of the deallocation.
+   */
+  static void RecordDeallocation(const size_t bytes);
+};
+
+} // namespace mlpack
+
+#endif // MLPACK_CORE_UTIL_MEMORY_COUNTERS_HPP
@@ -90,11 +90,18 @@ static const std::string testName = "";
 #include <mlpack/core/util/param.hpp>
 #include <mlpack/bindings/cli/parse_command_line.hpp>
 #include <mlpack/bindings/cli/end_program.hpp>
+#include <mlpack/bindings/cli/batch_mode.hpp>
 
 static void mlpackMain(); // This is typically defined after this include.
 
 int main(int argc, char** argv)
 {
+  // If the first argument is '--batch', read successive command lines from a
+  // file (or stdin) and run the binding once per line in this process,
+  // reusing models loaded from file between commands.
+  if (mlpack::bindings::cli::BatchModeRequested(argc, argv))
+    return mlpack::bindings::cli::RunBatchMode(argc, argv, &mlpackMain);
+
   // Parse the command-line options; put them into CLI.
   mlpack::bindings::cli::ParseCommandLine(argc, argv);
   // Enable timing.
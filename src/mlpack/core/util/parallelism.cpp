@@ -0,0 +1,120 @@
+/**
+ * @file core/util/parallelism.cpp
+ *
+ * Implementation of the central thread-budget control.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#include "parallelism.hpp"
+
+#include <map>
+#include <mutex>
+
+#ifdef HAS_OPENMP
+  #include <omp.h>
+#endif
+
+using namespace std;
+
+namespace mlpack {
+
+namespace {
+
+//! Guards the budgets below.
+mutex budgetMutex;
+
+//! Global budget; 0 means "use the OpenMP default".
+size_t globalBudget = 0;
+
+//! Whether nested regions may fan out.
+bool nestedAllowed = false;
+
+//! Per-subsystem budgets; a missing entry means "no subsystem cap".
+map<string, size_t>& SubsystemBudgets()
+{
+  static map<string, size_t> budgets;
+  return budgets;
+}
+
+//! The thread count OpenMP would use on its own.
+size_t DefaultThreads()
+{
+#ifdef HAS_OPENMP
+  return (size_t) omp_get_max_threads();
+#else
+  return 1;
+#endif
+}
+
+} // namespace
+
+size_t Parallelism::MaxThreads()
+{
+  lock_guard<mutex> lock(budgetMutex);
+  return (globalBudget == 0) ? DefaultThreads() : globalBudget;
+}
+
+void Parallelism::MaxThreads(const size_t threads)
+{
+  lock_guard<mutex> lock(budgetMutex);
+  globalBudget = threads;
+}
+
+size_t Parallelism::Threads(const string& subsystem)
+{
+#ifdef HAS_OPENMP
+  lock_guard<mutex> lock(budgetMutex);
+
+  // A region opened inside another parallel region collapses to one thread
+  // unless nesting was explicitly allowed; this is what keeps parallel folds
+  // calling parallel forests from oversubscribing the machine.
+  if (omp_in_parallel() && !nestedAllowed)
+    return 1;
+
+  size_t threads = (globalBudget == 0) ? DefaultThreads() : globalBudget;
+
+  map<string, size_t>::const_iterator it = SubsystemBudgets().find(subsystem);
+  if (it != SubsystemBudgets().end() && it->second != 0 &&
+      it->second < threads)
+    threads = it->second;
+
+  return (threads == 0) ? 1 : threads;
+#else
+  (void) subsystem;
+  return 1;
+#endif
+}
+
+void Parallelism::Threads(const string& subsystem, const size_t threads)
+{
+  lock_guard<mutex> lock(budgetMutex);
+  if (threads == 0)
+    SubsystemBudgets().erase(subsystem);
+  else
+    SubsystemBudgets()[subsystem] = threads;
+}
+
+bool Parallelism::AllowNested()
+{
+  lock_guard<mutex> lock(budgetMutex);
+  return nestedAllowed;
+}
+
+void Parallelism::AllowNested(const bool allow)
+{
+  lock_guard<mutex> lock(budgetMutex);
+  nestedAllowed = allow;
+}
+
+void Parallelism::Reset()
+{
+  lock_guard<mutex> lock(budgetMutex);
+  globalBudget = 0;
+  nestedAllowed = false;
+  SubsystemBudgets().clear();
+}
+
+} // namespace mlpack
@@ -0,0 +1,108 @@
+/**
+ * @file core/util/parallelism.hpp
+ *
+ * Central control over how many OpenMP threads mlpack's parallel regions
+ * use.  The parallel sites scattered through the methods (k-means, random
+ * forest, LSH, DET and others) each used to take the OpenMP default, which
+ * oversubscribes the machine as soon as parallel code calls parallel code
+ * (e.g. parallel cross-validation folds training parallel forests).  All
+ * those sites now size their regions through this class, so thread budgets
+ * can be set in one place and nested regions collapse to one thread unless
+ * nesting is explicitly allowed.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_UTIL_PARALLELISM_HPP
+#define MLPACK_CORE_UTIL_PARALLELISM_HPP
+
+#include <cstddef>
+#include <string>
+
+namespace mlpack {
+
+/**
+ * Static interface to mlpack's thread budgets.  Budgets resolve in this
+ * order:
+ *
+ *  - inside an already-parallel OpenMP region, Threads() returns 1 unless
+ *    nested parallelism has been allowed with AllowNested(true);
+ *  - a per-subsystem budget, if one was set, caps that subsystem;
+ *  - the global budget caps everything (it defaults to the OpenMP thread
+ *    count, so without any configuration behavior is unchanged).
+ *
+ * A typical use at a parallel site looks like:
+ *
+ * @code
+ * #pragma omp parallel for num_threads((int) Parallelism::Threads("kmeans"))
+ * @endcode
+ *
+ * and a caller that wants to keep a method off most of the machine sets
+ *
+ * @code
+ * Parallelism::Threads("random_forest", 4);
+ * @endcode
+ *
+ * Without OpenMP, Threads() always returns 1 and the setters only store
+ * values.
+ */
+class Parallelism
+{
+ public:
+  /**
+   * Return the global thread budget.  Unless overridden, this is the OpenMP
+   * default thread count (1 without OpenMP).
+   */
+  static size_t MaxThreads();
+
+  /**
+   * Set the global thread budget.  A value of 0 restores the OpenMP default.
+   *
+   * @param threads Maximum threads any single region may use.
+   */
+  static void MaxThreads(const size_t threads);
+
+  /**
+   * Return the number of threads a parallel region in the given subsystem
+   * should use right now: 1 when called from inside a parallel region (and
+   * nesting is not allowed), otherwise the subsystem budget capped by the
+   * global budget.
+   *
+   * @param subsystem Name of the subsystem (e.g. "kmeans", "lsh").
+   */
+  static size_t Threads(const std::string& subsystem);
+
+  /**
+   * Set the thread budget of the given subsystem.  A value of 0 removes the
+   * subsystem budget, so only the global budget applies.
+   *
+   * @param subsystem Name of the subsystem (e.g. "kmeans", "lsh").
+   * @param threads Maximum threads the subsystem's regions may use.
+   */
+  static void Threads(const std::string& subsystem, const size_t threads);
+
+  /**
+   * Return whether nested parallel regions are allowed to fan out.  Off by
+   * default: a parallel region started from inside another parallel region
+   * runs on one thread.
+   */
+  static bool AllowNested();
+
+  /**
+   * Allow or forbid nested parallel regions fanning out.
+   *
+   * @param allow True to let nested regions use their full budget.
+   */
+  static void AllowNested(const bool allow);
+
+  /**
+   * Remove all configured budgets and restore the defaults.
+   */
+  static void Reset();
+};
+
+} // namespace mlpack
+
+#endif // MLPACK_CORE_UTIL_PARALLELISM_HPP
@@ -0,0 +1,236 @@
+/**
+ * @file core/util/perf_counters.cpp
+ *
+ * Implementation of hardware performance counters for named regions.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#include "perf_counters.hpp"
+#include "log.hpp"
+
+#include <atomic>
+#include <cstring>
+#include <mutex>
+
+#if defined(__linux__)
+  #include <linux/perf_event.h>
+  #include <sys/ioctl.h>
+  #include <sys/syscall.h>
+  #include <unistd.h>
+#endif
+
+namespace mlpack {
+
+namespace {
+
+//! Whether counting is enabled; disabled by default, like timing.
+std::atomic<bool> countersEnabled(false);
+
+//! Guards the region map.
+std::mutex countersMutex;
+
+#if defined(__linux__)
+
+//! The open perf event group and accumulated values of one region.
+struct Region
+{
+  //! Group leader (cycles); -1 when the group could not be opened.
+  int groupFd = -1;
+  //! Sibling counters (cache misses, branch misses).
+  int cacheFd = -1;
+  int branchFd = -1;
+  //! Whether the region is currently counting.
+  bool running = false;
+  //! Accumulated values.
+  PerfCounterValues values;
+};
+
+std::map<std::string, Region>& Regions()
+{
+  static std::map<std::string, Region> regions;
+  return regions;
+}
+
+//! Open one hardware counter, optionally into an existing group.
+int OpenCounter(const uint64_t config, const int groupFd)
+{
+  struct perf_event_attr attr;
+  memset(&attr, 0, sizeof(attr));
+  attr.type = PERF_TYPE_HARDWARE;
+  attr.size = sizeof(attr);
+  attr.config = config;
+  attr.disabled = (groupFd == -1) ? 1 : 0;
+  attr.exclude_kernel = 1;
+  attr.exclude_hv = 1;
+
+  return (int) syscall(__NR_perf_event_open, &attr, 0 /* this thread */,
+      -1 /* any cpu */, groupFd, 0);
+}
+
+//! Open the counter group for a region.  Returns false on failure.
+bool OpenRegion(Region& region)
+{
+  region.groupFd = OpenCounter(PERF_COUNT_HW_CPU_CYCLES, -1);
+  if (region.groupFd == -1)
+    return false;
+
+  // The siblings are optional: if the PMU runs out of counters we still get
+  // cycles.
+  region.cacheFd = OpenCounter(PERF_COUNT_HW_CACHE_MISSES, region.groupFd);
+  region.branchFd = OpenCounter(PERF_COUNT_HW_BRANCH_MISSES, region.groupFd);
+  return true;
+}
+
+//! Read and reset a single counter; returns 0 if it is not open.
+uint64_t ReadCounter(const int fd)
+{
+  if (fd == -1)
+    return 0;
+
+  uint64_t value = 0;
+  if (read(fd, &value, sizeof(value)) != sizeof(value))
+    return 0;
+  return value;
+}
+
+#endif // __linux__
+
+} // namespace
+
+void PerfCounters::Enable()
+{
+  countersEnabled = true;
+}
+
+void PerfCounters::Disable()
+{
+  countersEnabled = false;
+}
+
+bool PerfCounters::Available()
+{
+#if defined(__linux__)
+  static const bool available = []()
+  {
+    Region probe;
+    if (!OpenRegion(probe))
+      return false;
+
+    close(probe.groupFd);
+    if (probe.cacheFd != -1)
+      close(probe.cacheFd);
+    if (probe.branchFd != -1)
+      close(probe.branchFd);
+    return true;
+  }();
+  return available;
+#else
+  return false;
+#endif
+}
+
+void PerfCounters::Start(const std::string& name)
+{
+#if defined(__linux__)
+  if (!countersEnabled || !Available())
+    return;
+
+  std::lock_guard<std::mutex> lock(countersMutex);
+  Region& region = Regions()[name];
+
+  if (region.running)
+  {
+    Log::Fatal << "PerfCounters::Start(): region '" << name << "' already "
+        << "started!" << std::endl;
+  }
+
+  if (region.groupFd == -1 && !OpenRegion(region))
+    return;
+
+  ioctl(region.groupFd, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+  ioctl(region.groupFd, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+  region.running = true;
+#else
+  (void) name;
+#endif
+}
+
+void PerfCounters::Stop(const std::string& name)
+{
+#if defined(__linux__)
+  if (!countersEnabled || !Available())
+    return;
+
+  std::lock_guard<std::mutex> lock(countersMutex);
+  Region& region = Regions()[name];
+
+  if (!region.running)
+  {
+    Log::Fatal << "PerfCounters::Stop(): region '" << name << "' not "
+        << "started!" << std::endl;
+  }
+
+  ioctl(region.groupFd, PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+
+  region.values.cycles += ReadCounter(region.groupFd);
+  region.values.cacheMisses += ReadCounter(region.cacheFd);
+  region.values.branchMisses += ReadCounter(region.branchFd);
+  region.running = false;
+#else
+  (void) name;
+#endif
+}
+
+PerfCounterValues PerfCounters::Get(const std::string& name)
+{
+#if defined(__linux__)
+  std::lock_guard<std::mutex> lock(countersMutex);
+  if (Regions().count(name) == 0)
+    return PerfCounterValues();
+  return Regions()[name].values;
+#else
+  (void) name;
+  return PerfCounterValues();
+#endif
+}
+
+std::map<std::string, PerfCounterValues> PerfCounters::GetAllCounters()
+{
+  std::map<std::string, PerfCounterValues> values;
+#if defined(__linux__)
+  std::lock_guard<std::mutex> lock(countersMutex);
+  for (const auto& region : Regions())
+    values[region.first] = region.second.values;
+#endif
+  return values;
+}
+
+void PerfCounters::Print(const std::string& name)
+{
+  const PerfCounterValues values = Get(name);
+  Log::Info << values.cycles << " cycles, " << values.cacheMisses
+      << " cache misses, " << values.branchMisses << " branch misses"
+      << std::endl;
+}
+
+void PerfCounters::Reset()
+{
+#if defined(__linux__)
+  std::lock_guard<std::mutex> lock(countersMutex);
+  for (auto& region : Regions())
+  {
+    if (region.second.groupFd != -1)
+      close(region.second.groupFd);
+    if (region.second.cacheFd != -1)
+      close(region.second.cacheFd);
+    if (region.second.branchFd != -1)
+      close(region.second.branchFd);
+  }
+  Regions().clear();
+#endif
+}
+
+} // namespace mlpack
@@ -0,0 +1,118 @@
+/**
+ * @file core/util/perf_counters.hpp
+ *
+ * Hardware performance counters for named regions, alongside the Timer class.
+ * On Linux this samples CPU cycles, cache misses, and branch misses through
+ * the perf_event interface; on other platforms (or when perf events are not
+ * permitted, e.g. in restricted containers) every operation is a no-op and
+ * all counters read as zero.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_UTIL_PERF_COUNTERS_HPP
+#define MLPACK_CORE_UTIL_PERF_COUNTERS_HPP
+
+#include <cstdint>
+#include <map>
+#include <string>
+
+namespace mlpack {
+
+/**
+ * The counter values accumulated for one named region.
+ */
+struct PerfCounterValues
+{
+  //! Total CPU cycles spent in the region.
+  uint64_t cycles = 0;
+  //! Total last-level cache misses in the region.
+  uint64_t cacheMisses = 0;
+  //! Total mispredicted branches in the region.
+  uint64_t branchMisses = 0;
+};
+
+/**
+ * Hardware counter instrumentation for named regions.  The interface mirrors
+ * the Timer class: counters are additive across repeated Start()/Stop() runs
+ * of the same region, and counting must be enabled before Start() has any
+ * effect.  A typical use brackets a phase the same way a timer would:
+ *
+ * @code
+ * PerfCounters::Enable();
+ * PerfCounters::Start("tree_traversal");
+ * // ... work ...
+ * PerfCounters::Stop("tree_traversal");
+ * Log::Info << "traversal cache misses: "
+ *     << PerfCounters::Get("tree_traversal").cacheMisses << std::endl;
+ * @endcode
+ *
+ * Counters measure the calling thread only; start and stop a region on the
+ * thread whose work should be attributed to it.
+ */
+class PerfCounters
+{
+ public:
+  /**
+   * Enable hardware counting.  Do not call this while regions are running.
+   */
+  static void Enable();
+
+  /**
+   * Disable hardware counting.  Do not call this while regions are running.
+   */
+  static void Disable();
+
+  /**
+   * Return true if hardware counters can actually be opened on this system.
+   * When this returns false, Start() and Stop() are no-ops and Get() returns
+   * zeros; callers do not need to check before instrumenting.
+   */
+  static bool Available();
+
+  /**
+   * Start counting for the given region.
+   *
+   * @param name Name of the region.
+   */
+  static void Start(const std::string& name);
+
+  /**
+   * Stop counting for the given region and accumulate its values.
+   *
+   * @param name Name of the region.
+   */
+  static void Stop(const std::string& name);
+
+  /**
+   * Get the accumulated counter values of the given region.
+   *
+   * @param name Name of the region.
+   */
+  static PerfCounterValues Get(const std::string& name);
+
+  /**
+   * Return a copy of the values of every region counted so far.
+   */
+  static std::map<std::string, PerfCounterValues> GetAllCounters();
+
+  /**
+   * Print the counters of the given region to Log::Info, in the same style
+   * the timers are reported in.
+   *
+   * @param name Name of the region.
+   */
+  static void Print(const std::string& name);
+
+  /**
+   * Remove all knowledge of existing regions.  Whether or not counting is
+   * enabled is not changed.  Do not call this while regions are running.
+   */
+  static void Reset();
+};
+
+} // namespace mlpack
+
+#endif // MLPACK_CORE_UTIL_PERF_COUNTERS_HPP
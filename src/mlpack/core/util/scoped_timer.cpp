@@ -0,0 +1,203 @@
+/**
+ * @file core/util/scoped_timer.cpp
+ *
+ * Implementation of the low-overhead scoped profiler.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#include "scoped_timer.hpp"
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <vector>
+
+namespace mlpack {
+
+namespace {
+
+//! One node of a per-thread call tree, aggregating every entry of a timer ID
+//! under a given parent scope.
+struct ScopeNode
+{
+  //! Interned timer ID.
+  size_t id;
+  //! Index of the parent node, or size_t(-1) for a root scope.
+  size_t parent;
+  //! Total time spent in this scope.
+  uint64_t totalNanoseconds;
+  //! Number of times the scope was entered.
+  uint64_t calls;
+};
+
+//! All scopes recorded by one thread.  Nodes are found by a linear scan over
+//! this (small) vector; allocation happens only the first time a particular
+//! (timer, parent) pair is seen, so the steady-state cost of a scope is two
+//! clock reads and a handful of arithmetic.
+struct ThreadRecord
+{
+  std::vector<ScopeNode> nodes;
+  //! The currently open scope of this thread, or size_t(-1).
+  size_t currentNode = size_t(-1);
+};
+
+//! Guards the interning table and the list of thread records.
+std::mutex& ProfilerMutex()
+{
+  static std::mutex mutex;
+  return mutex;
+}
+
+//! Interned timer names; the ID of a timer is its index here.
+std::vector<std::string>& TimerNames()
+{
+  static std::vector<std::string> names;
+  return names;
+}
+
+//! Records of every thread that ever opened a scope.  The records are kept
+//! alive after thread exit so that PrintJSON() can still see them.
+std::vector<std::unique_ptr<ThreadRecord>>& ThreadRecords()
+{
+  static std::vector<std::unique_ptr<ThreadRecord>> records;
+  return records;
+}
+
+//! Get the calling thread's record, registering it on first use.
+ThreadRecord& LocalRecord()
+{
+  static thread_local ThreadRecord* record = []()
+  {
+    std::lock_guard<std::mutex> lock(ProfilerMutex());
+    ThreadRecords().push_back(std::unique_ptr<ThreadRecord>(
+        new ThreadRecord()));
+    return ThreadRecords().back().get();
+  }();
+  return *record;
+}
+
+//! Recursively print the children of the given parent node as a JSON array.
+void PrintNodesJSON(std::ostream& stream,
+                    const ThreadRecord& record,
+                    const size_t parent,
+                    const std::string& indent)
+{
+  stream << "[";
+  bool first = true;
+  for (size_t i = 0; i < record.nodes.size(); ++i)
+  {
+    const ScopeNode& node = record.nodes[i];
+    if (node.parent != parent)
+      continue;
+
+    stream << (first ? "" : ",") << "\n" << indent << "  {\n"
+        << indent << "    \"name\": \"" << TimerNames()[node.id] << "\",\n"
+        << indent << "    \"totalNanoseconds\": " << node.totalNanoseconds
+        << ",\n"
+        << indent << "    \"calls\": " << node.calls << ",\n"
+        << indent << "    \"children\": ";
+    PrintNodesJSON(stream, record, i, indent + "    ");
+    stream << "\n" << indent << "  }";
+    first = false;
+  }
+  if (!first)
+    stream << "\n" << indent;
+  stream << "]";
+}
+
+} // namespace
+
+size_t Profiler::RegisterTimer(const std::string& name)
+{
+  std::lock_guard<std::mutex> lock(ProfilerMutex());
+
+  std::vector<std::string>& names = TimerNames();
+  for (size_t i = 0; i < names.size(); ++i)
+    if (names[i] == name)
+      return i;
+
+  names.push_back(name);
+  return names.size() - 1;
+}
+
+void Profiler::PrintJSON(std::ostream& stream)
+{
+  std::lock_guard<std::mutex> lock(ProfilerMutex());
+
+  stream << "{\n  \"threads\": [";
+  bool first = true;
+  for (const std::unique_ptr<ThreadRecord>& record : ThreadRecords())
+  {
+    if (record->nodes.empty())
+      continue;
+
+    stream << (first ? "" : ",") << "\n    { \"scopes\": ";
+    PrintNodesJSON(stream, *record, size_t(-1), "    ");
+    stream << " }";
+    first = false;
+  }
+  if (!first)
+    stream << "\n  ";
+  stream << "]\n}\n";
+}
+
+void Profiler::Reset()
+{
+  std::lock_guard<std::mutex> lock(ProfilerMutex());
+
+  for (const std::unique_ptr<ThreadRecord>& record : ThreadRecords())
+  {
+    record->nodes.clear();
+    record->currentNode = size_t(-1);
+  }
+}
+
+ScopedTimer::ScopedTimer(const size_t id)
+{
+  ThreadRecord& record = LocalRecord();
+
+  // Find the node for this timer under the currently open scope, creating it
+  // on first encounter.
+  node = size_t(-1);
+  for (size_t i = 0; i < record.nodes.size(); ++i)
+  {
+    if (record.nodes[i].id == id && record.nodes[i].parent ==
+        record.currentNode)
+    {
+      node = i;
+      break;
+    }
+  }
+
+  if (node == size_t(-1))
+  {
+    record.nodes.push_back(ScopeNode{ id, record.currentNode, 0, 0 });
+    node = record.nodes.size() - 1;
+  }
+
+  record.currentNode = node;
+
+  // Read the clock last, so that the bookkeeping above is not billed to the
+  // scope.
+  start = std::chrono::steady_clock::now();
+}
+
+ScopedTimer::~ScopedTimer()
+{
+  const std::chrono::steady_clock::time_point end =
+      std::chrono::steady_clock::now();
+
+  ThreadRecord& record = LocalRecord();
+  ScopeNode& scope = record.nodes[node];
+  scope.totalNanoseconds += (uint64_t)
+      std::chrono::duration_cast<std::chrono::nanoseconds>(end - start)
+      .count();
+  scope.calls++;
+  record.currentNode = scope.parent;
+}
+
+} // namespace mlpack
@@ -14,6 +14,7 @@
 #include "timers.hpp"
 #include "cli.hpp"
 #include "log.hpp"
+#include "memory_counters.hpp"
 
 #include <map>
 #include <string>
@@ -165,8 +166,13 @@ void Timers::StopAllTimers()
 
   high_resolution_clock::time_point currTime = high_resolution_clock::now();
   for (auto it : timerStartTime)
+  {
     for (auto it2 : it.second)
+    {
       timers[it2.first] += duration_cast<microseconds>(currTime - it2.second);
+      MemoryCounters::Stop(it2.first);
+    }
+  }
 
   // If all timers are stopped, we can clear the maps.
   timerStartTime.clear();
@@ -199,6 +205,9 @@ void Timers::StartTimer(const string& timerName,
   }
 
   timerStartTime[threadId][timerName] = currTime;
+
+  // Track allocations over the same region, if tracking is enabled.
+  MemoryCounters::Start(timerName);
 }
 
 void Timers::StopTimer(const string& timerName,
@@ -229,4 +238,7 @@ void Timers::StopTimer(const string& timerName,
   timerStartTime[threadId].erase(timerName);
   if (timerStartTime[threadId].empty())
     timerStartTime.erase(threadId);
+
+  // Close the matching allocation-tracking region, if tracking is enabled.
+  MemoryCounters::Stop(timerName);
 }
@@ -173,6 +173,21 @@ class AdaBoost
   void Classify(const MatType& test,
                 arma::Row<size_t>& predictedLabels);
 
+  /**
+   * Classify the given test points with an early-exit cascade.  The weak
+   * learners are evaluated in order of decreasing weight, and a point stops
+   * being scored as soon as the margin of its leading class exceeds the total
+   * weight of the learners that have not been evaluated yet---at that point no
+   * remaining learner can change the argmax.  The predictions are identical to
+   * Classify(), but points that decide early skip most of the ensemble.
+   *
+   * @param test Testing data.
+   * @param predictedLabels Vector in which the predicted labels of the test
+   *      set will be stored.
+   */
+  void ClassifyCascade(const MatType& test,
+                       arma::Row<size_t>& predictedLabels);
+
   /**
    * Serialize the AdaBoost model.
    */
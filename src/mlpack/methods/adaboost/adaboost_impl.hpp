@@ -250,6 +250,68 @@ void AdaBoost<WeakLearnerType, MatType>::Classify(
   }
 }
 
+/**
+ * Classify the given test points with an early-exit cascade.
+ */
+template<typename WeakLearnerType, typename MatType>
+void AdaBoost<WeakLearnerType, MatType>::ClassifyCascade(
+    const MatType& test,
+    arma::Row<size_t>& predictedLabels)
+{
+  predictedLabels.set_size(test.n_cols);
+
+  // Order the weak learners by decreasing weight, and compute the total
+  // weight that remains after each stage of the cascade.
+  const arma::vec alphaVec(alpha);
+  const arma::uvec order = arma::sort_index(alphaVec, "descend");
+  arma::vec remaining(wl.size());
+  if (wl.size() > 0)
+  {
+    remaining[wl.size() - 1] = 0.0;
+    for (size_t i = wl.size() - 1; i > 0; i--)
+      remaining[i - 1] = remaining[i] + alphaVec[order[i]];
+  }
+
+  arma::mat scores = arma::zeros<arma::mat>(numClasses, test.n_cols);
+  arma::uvec active = arma::regspace<arma::uvec>(0, test.n_cols - 1);
+  arma::Row<size_t> stagePredictions;
+
+  for (size_t i = 0; i < wl.size() && active.n_elem > 0; i++)
+  {
+    // Evaluate this stage's weak learner on the undecided points only.
+    const MatType activeData = test.cols(active);
+    wl[order[i]].Classify(activeData, stagePredictions);
+
+    for (size_t j = 0; j < active.n_elem; j++)
+      scores(stagePredictions(j), active(j)) += alphaVec[order[i]];
+
+    // Retire the points whose leading class can no longer be overtaken: even
+    // if every remaining learner votes for the runner-up, the margin stands.
+    if (i + 1 < wl.size())
+    {
+      arma::uvec undecided(active.n_elem);
+      size_t numUndecided = 0;
+      for (size_t j = 0; j < active.n_elem; j++)
+      {
+        arma::vec pointScores = scores.col(active(j));
+        const arma::uword leader = pointScores.index_max();
+        pointScores(leader) = -DBL_MAX;
+        if (scores(leader, active(j)) - pointScores.max() <= remaining[i])
+          undecided(numUndecided++) = active(j);
+      }
+      active = undecided.head(numUndecided);
+    }
+  }
+
+  for (size_t i = 0; i < predictedLabels.n_cols; i++)
+  {
+    arma::colvec pRow = scores.unsafe_col(i);
+    arma::uword maxIndex = 0;
+    pRow.max(maxIndex);
+    predictedLabels(i) = maxIndex;
+  }
+}
+
 /**
  * Serialize the AdaBoost model.
  */
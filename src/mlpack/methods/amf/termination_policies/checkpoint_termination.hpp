@@ -0,0 +1,171 @@
+/**
+ * @file methods/amf/termination_policies/checkpoint_termination.hpp
+ * @author Sumedh Ghaisas
+ *
+ * Termination policy wrapper that periodically checkpoints the factorization
+ * state, used in AMF (Alternating Matrix Factorization).
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_AMF_CHECKPOINT_TERMINATION_HPP
+#define MLPACK_METHODS_AMF_CHECKPOINT_TERMINATION_HPP
+
+#include <mlpack/prereqs.hpp>
+#include <mlpack/core/data/checkpoint.hpp>
+
+#include "simple_residue_termination.hpp"
+
+namespace mlpack {
+namespace amf {
+
+/**
+ * This class wraps another AMF termination policy and checkpoints the
+ * factorization every few iterations: the W and H factors and the iteration
+ * count are serialized to a file, and a restarted job resumes from the last
+ * snapshot instead of from the initialization rule's output.  The wrapped
+ * policy makes the actual termination decision; note that on resume its
+ * internal convergence history (e.g. the previous residue) restarts, so the
+ * first resumed iteration never terminates spuriously, and an iteration
+ * limit in the wrapped policy counts iterations since the restart.
+ *
+ * The checkpoint file is removed when the factorization converges, so a
+ * finished job does not resume from a stale snapshot.  A typical use:
+ *
+ * @code
+ * CheckpointTermination<SimpleResidueTermination> termination(
+ *     SimpleResidueTermination(), "nmf.checkpoint.bin", 25);
+ * AMF<CheckpointTermination<SimpleResidueTermination>> amf(termination);
+ * amf.Apply(V, r, W, H); // Resumes automatically if the file exists.
+ * @endcode
+ *
+ * @see AMF
+ */
+template<typename TerminationPolicyType = SimpleResidueTermination>
+class CheckpointTermination
+{
+ public:
+  /**
+   * Construct the CheckpointTermination object.
+   *
+   * @param terminationPolicy Wrapped policy that decides termination.
+   * @param checkpointFile File to write snapshots to; empty disables
+   *     checkpointing (and resuming).
+   * @param interval Number of iterations between snapshots.
+   */
+  CheckpointTermination(
+      TerminationPolicyType terminationPolicy = TerminationPolicyType(),
+      const std::string& checkpointFile = "",
+      const size_t interval = 10) :
+      terminationPolicy(std::move(terminationPolicy)),
+      checkpoint(checkpointFile, interval),
+      iteration(0),
+      restored(false)
+  { }
+
+  /**
+   * Initializes the termination policy before starting the factorization.
+   *
+   * @param V Input matrix being factorized.
+   */
+  template<typename MatType>
+  void Initialize(const MatType& V)
+  {
+    terminationPolicy.Initialize(V);
+    iteration = 0;
+    restored = false;
+  }
+
+  /**
+   * Check if the termination criterion is met, restoring a previous snapshot
+   * on the first call and writing one every few iterations after that.
+   *
+   * @param W Basis matrix of output.
+   * @param H Encoding matrix of output.
+   */
+  bool IsConverged(arma::mat& W, arma::mat& H)
+  {
+    // The first call happens before the first update, so a restored snapshot
+    // replaces the initialization rule's output.
+    if (!restored)
+    {
+      restored = true;
+
+      State state;
+      if (checkpoint.Restore(state))
+      {
+        W = std::move(state.w);
+        H = std::move(state.h);
+        iteration = state.iteration;
+        Log::Info << "CheckpointTermination: resumed from '"
+            << checkpoint.Filename() << "' at iteration " << iteration << "."
+            << std::endl;
+      }
+    }
+
+    const bool converged = terminationPolicy.IsConverged(W, H);
+    ++iteration;
+
+    if (converged)
+    {
+      checkpoint.Finish();
+    }
+    else
+    {
+      State state;
+      state.w = W;
+      state.h = H;
+      state.iteration = iteration;
+      checkpoint.Save(iteration, state);
+    }
+
+    return converged;
+  }
+
+  //! Get current value of the wrapped policy's index.
+  const double& Index() const { return terminationPolicy.Index(); }
+
+  //! Get the current iteration count (including resumed iterations).
+  const size_t& Iteration() const { return iteration; }
+
+  //! Access the wrapped termination policy.
+  const TerminationPolicyType& TerminationPolicy() const
+  { return terminationPolicy; }
+  TerminationPolicyType& TerminationPolicy() { return terminationPolicy; }
+
+ private:
+  //! The serializable snapshot of the factorization.
+  struct State
+  {
+    arma::mat w;
+    arma::mat h;
+    size_t iteration = 0;
+
+    template<typename Archive>
+    void serialize(Archive& ar, const unsigned int /* version */)
+    {
+      ar & BOOST_SERIALIZATION_NVP(w);
+      ar & BOOST_SERIALIZATION_NVP(h);
+      ar & BOOST_SERIALIZATION_NVP(iteration);
+    }
+  };
+
+  //! The wrapped policy that decides termination.
+  TerminationPolicyType terminationPolicy;
+
+  //! The checkpoint configuration.
+  data::Checkpoint checkpoint;
+
+  //! Current iteration count, counted across restarts.
+  size_t iteration;
+
+  //! Whether a resume was already attempted for this factorization.
+  bool restored;
+}; // class CheckpointTermination
+
+} // namespace amf
+} // namespace mlpack
+
+#endif
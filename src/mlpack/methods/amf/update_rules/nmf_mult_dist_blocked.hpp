@@ -0,0 +1,137 @@
+/**
+ * @file methods/amf/update_rules/nmf_mult_dist_blocked.hpp
+ *
+ * Blocked, OpenMP-parallel multiplicative distance update rules for NMF.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_LMF_UPDATE_RULES_NMF_MULT_DIST_BLOCKED_UPDATE_RULES_HPP
+#define MLPACK_METHODS_LMF_UPDATE_RULES_NMF_MULT_DIST_BLOCKED_UPDATE_RULES_HPP
+
+#include <mlpack/prereqs.hpp>
+
+namespace mlpack {
+namespace amf {
+
+/**
+ * Blocked variant of the multiplicative distance update rules of
+ * NMFMultiplicativeDistanceUpdate.  The update formulas and the resulting
+ * factorization are identical, but the work is organized for large inputs:
+ * the small \f$ k \times k \f$ Gram matrix (\f$ HH^T \f$ or \f$ W^TW \f$) is
+ * computed once per update and shared by every tile, and the rows of W
+ * (columns of H) are then updated in independent tiles in parallel with
+ * OpenMP.  Within a tile the numerator product, the denominator product and
+ * the element-wise multiply/divide stage all operate on a cache-resident
+ * slice of W or H, instead of streaming three full-size temporaries through
+ * memory.
+ *
+ * This is worthwhile when V is large (particularly when it is sparse and
+ * tall), where the per-iteration cost of the standard rule is dominated by
+ * full-matrix temporaries.
+ */
+class NMFBlockedMultiplicativeDistanceUpdate
+{
+ public:
+  // Empty constructor required for the UpdateRule template.
+  NMFBlockedMultiplicativeDistanceUpdate() { }
+
+  /**
+   * Initialize the factorization.  These update rules hold no information, so
+   * the input parameters are ignored.
+   */
+  template<typename MatType>
+  void Initialize(const MatType& /* dataset */, const size_t /* rank */)
+  {
+    // Nothing to do.
+  }
+
+  /**
+   * The update rule for the basis matrix W, applied tile by tile:
+   *
+   * \f[
+   * W_{ia} \leftarrow W_{ia} \frac{(VH^T)_{ia}}{(W(HH^T))_{ia}}
+   * \f]
+   *
+   * The function takes in all the matrices and only changes the value of the W
+   * matrix.
+   *
+   * @param V Input matrix to be factorized.
+   * @param W Basis matrix to be updated.
+   * @param H Encoding matrix.
+   */
+  template<typename MatType>
+  inline static void WUpdate(const MatType& V,
+                             arma::mat& W,
+                             const arma::mat& H)
+  {
+    // The Gram matrix is only k x k; compute it once and share it across all
+    // tiles.
+    const arma::mat gram = H * H.t();
+    const arma::mat ht = H.t();
+
+    const size_t numBlocks = (W.n_rows + BlockSize - 1) / BlockSize;
+    #pragma omp parallel for schedule(dynamic)
+    for (omp_size_t block = 0; block < omp_size_t(numBlocks); ++block)
+    {
+      const size_t begin = block * BlockSize;
+      const size_t end = ((begin + BlockSize > W.n_rows) ?
+          (size_t) W.n_rows : begin + BlockSize) - 1;
+
+      W.rows(begin, end) = (W.rows(begin, end) % (V.rows(begin, end) * ht)) /
+          (W.rows(begin, end) * gram);
+    }
+  }
+
+  /**
+   * The update rule for the encoding matrix H, applied tile by tile:
+   *
+   * \f[
+   * H_{a\mu} \leftarrow H_{a\mu} \frac{(W^T V)_{a\mu}}{((W^TW)H)_{a\mu}}
+   * \f]
+   *
+   * The function takes in all the matrices and only changes the value of the H
+   * matrix.
+   *
+   * @param V Input matrix to be factorized.
+   * @param W Basis matrix.
+   * @param H Encoding matrix to be updated.
+   */
+  template<typename MatType>
+  inline static void HUpdate(const MatType& V,
+                             const arma::mat& W,
+                             arma::mat& H)
+  {
+    // The Gram matrix is only k x k; compute it once and share it across all
+    // tiles.
+    const arma::mat gram = W.t() * W;
+    const arma::mat wt = W.t();
+
+    const size_t numBlocks = (H.n_cols + BlockSize - 1) / BlockSize;
+    #pragma omp parallel for schedule(dynamic)
+    for (omp_size_t block = 0; block < omp_size_t(numBlocks); ++block)
+    {
+      const size_t begin = block * BlockSize;
+      const size_t end = ((begin + BlockSize > H.n_cols) ?
+          (size_t) H.n_cols : begin + BlockSize) - 1;
+
+      H.cols(begin, end) = (H.cols(begin, end) % (wt * V.cols(begin, end))) /
+          (gram * H.cols(begin, end));
+    }
+  }
+
+  //! Serialize the object (in this case, there is nothing to serialize).
+  template<typename Archive>
+  void serialize(Archive& /* ar */, const unsigned int /* version */) { }
+
+ private:
+  //! The number of rows of W (columns of H) updated by one tile.
+  static const size_t BlockSize = 512;
+};
+
+} // namespace amf
+} // namespace mlpack
+
+#endif
@@ -48,12 +48,17 @@ class SVDBatchLearning
    * @param kw regularization constant for W matrix
    * @param kh regularization constant for H matrix
    * @param momentum momentum applied to batch learning process
+   * @param negativeSamples number of random entries sampled as implicit
+   *     zeros per observed entry (sparse matrices only; 0 disables negative
+   *     sampling)
    */
   SVDBatchLearning(double u = 0.0002,
                    double kw = 0,
                    double kh = 0,
-                   double momentum = 0.9)
-        : u(u), kw(kw), kh(kh), momentum(momentum)
+                   double momentum = 0.9,
+                   size_t negativeSamples = 0)
+        : u(u), kw(kw), kh(kh), momentum(momentum),
+          negativeSamples(negativeSamples)
   {
     // empty constructor
   }
@@ -166,12 +171,16 @@ class SVDBatchLearning
 
   //! Serialize the SVDBatch object.
   template<typename Archive>
-  void serialize(Archive& ar, const unsigned int /* version */)
+  void serialize(Archive& ar, const unsigned int version)
   {
     ar & BOOST_SERIALIZATION_NVP(u);
     ar & BOOST_SERIALIZATION_NVP(kw);
     ar & BOOST_SERIALIZATION_NVP(kh);
     ar & BOOST_SERIALIZATION_NVP(momentum);
+    if (version > 0)
+      ar & BOOST_SERIALIZATION_NVP(negativeSamples);
+    else if (Archive::is_loading::value)
+      negativeSamples = 0;
     ar & BOOST_SERIALIZATION_NVP(mW);
     ar & BOOST_SERIALIZATION_NVP(mH);
   }
@@ -185,6 +194,8 @@ class SVDBatchLearning
   double kh;
   //! Momentum value (between 0 and 1).
   double momentum;
+  //! Number of implicit zeros sampled per observed entry (sparse only).
+  size_t negativeSamples;
 
   //! Momentum matrix for matrix W
   arma::mat mW;
@@ -219,6 +230,23 @@ inline void SVDBatchLearning::WUpdate<arma::sp_mat>(const arma::sp_mat& V,
                                              arma::trans(H.col(col));
   }
 
+  // For implicit feedback the zeros carry information too, but iterating them
+  // all would cost O(n * m).  Instead, sample a few random entries per
+  // observed entry and push their predictions towards zero.  On a very sparse
+  // matrix the chance of hitting an observed entry is negligible, so no
+  // lookup is done.
+  if (negativeSamples > 0)
+  {
+    const size_t numSamples = negativeSamples * V.n_nonzero;
+    for (size_t s = 0; s < numSamples; s++)
+    {
+      const size_t row = math::RandInt(V.n_rows);
+      const size_t col = math::RandInt(V.n_cols);
+      deltaW.row(row) -= arma::dot(W.row(row), H.col(col)) *
+          arma::trans(H.col(col));
+    }
+  }
+
   if (kw != 0)
     deltaW -= kw * W;
 
@@ -247,6 +275,18 @@ inline void SVDBatchLearning::HUpdate<arma::sp_mat>(const arma::sp_mat& V,
         W.row(row).t();
   }
 
+  // Sampled implicit zeros; see the comment in the WUpdate specialization.
+  if (negativeSamples > 0)
+  {
+    const size_t numSamples = negativeSamples * V.n_nonzero;
+    for (size_t s = 0; s < numSamples; s++)
+    {
+      const size_t row = math::RandInt(V.n_rows);
+      const size_t col = math::RandInt(V.n_cols);
+      deltaH.col(col) -= arma::dot(W.row(row), H.col(col)) * W.row(row).t();
+    }
+  }
+
   if (kh != 0)
     deltaH -= kh * H;
 
@@ -257,4 +297,17 @@ inline void SVDBatchLearning::HUpdate<arma::sp_mat>(const arma::sp_mat& V,
 } // namespace amf
 } // namespace mlpack
 
+//! Set the serialization version of the SVDBatchLearning class.
+namespace boost {
+namespace serialization {
+
+template<>
+struct version<mlpack::amf::SVDBatchLearning>
+{
+  BOOST_STATIC_CONSTANT(int, value = 1);
+};
+
+} // namespace serialization
+} // namespace boost
+
 #endif // MLPACK_METHODS_AMF_UPDATE_RULES_SVD_BATCH_LEARNING_HPP
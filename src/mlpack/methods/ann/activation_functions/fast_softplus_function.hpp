@@ -0,0 +1,129 @@
+/**
+ * @file methods/ann/activation_functions/fast_softplus_function.hpp
+ * @author Marcus Edel
+ *
+ * Definition and implementation of an approximated softplus function, built
+ * on the exponential approximation of FastLogisticFunction.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_ANN_ACTIVATION_FUNCTIONS_FAST_SOFTPLUS_FUNCTION_HPP
+#define MLPACK_METHODS_ANN_ACTIVATION_FUNCTIONS_FAST_SOFTPLUS_FUNCTION_HPP
+
+#include <mlpack/prereqs.hpp>
+
+#include "fast_logistic_function.hpp"
+
+namespace mlpack {
+namespace ann /** Artificial Neural Network. */ {
+
+/**
+ * An approximation of the softplus function, defined by
+ *
+ * @f{eqnarray*}{
+ * f(x) &=& \ln(1 + e^{x}) \\
+ * f'(x) &=& \frac{1}{1 + e^{-x}} \\
+ * f^{-1}(y) &=& \ln(e^{y} - 1)
+ * @f}
+ *
+ * where the inner exponential is replaced by the branch-free approximation of
+ * FastLogisticFunction; see that class for the meaning of the Squarings
+ * accuracy parameter.
+ *
+ * @tparam Squarings Number of squarings used by the exponential
+ *     approximation.
+ */
+template<size_t Squarings = 8>
+class FastSoftplusFunction
+{
+ public:
+  /**
+   * Computes the approximated softplus function.
+   *
+   * @param x Input data.
+   * @return f(x).
+   */
+  static double Fn(const double x)
+  {
+    const double val = std::log(1 +
+        FastLogisticFunction<Squarings>::ExpApprox(x));
+    if (std::isfinite(val))
+      return val;
+    return x;
+  }
+
+  /**
+   * Computes the approximated softplus function.
+   *
+   * @param x Input data.
+   * @param y The resulting output activation.
+   */
+  template<typename InputType, typename OutputType>
+  static void Fn(const InputType& x, OutputType& y)
+  {
+    y.set_size(arma::size(x));
+
+    for (size_t i = 0; i < x.n_elem; i++)
+      y(i) = Fn(x(i));
+  }
+
+  /**
+   * Computes the first derivative of the softplus function.
+   *
+   * @param y Input data.
+   * @return f'(x)
+   */
+  static double Deriv(const double y)
+  {
+    return 1.0 / (1 + std::exp(-y));
+  }
+
+  /**
+   * Computes the first derivatives of the softplus function.
+   *
+   * @param y Input data.
+   * @param x The resulting derivatives.
+   */
+  template<typename InputType, typename OutputType>
+  static void Deriv(const InputType& y, OutputType& x)
+  {
+    x = 1.0 / (1 + arma::exp(-y));
+  }
+
+  /**
+   * Computes the inverse of the softplus function.
+   *
+   * @param y Input data.
+   * @return f^{-1}(y)
+   */
+  static double Inv(const double y)
+  {
+    const double val = std::log(std::exp(y) - 1);
+    if (std::isfinite(val))
+      return val;
+    return y;
+  }
+
+  /**
+   * Computes the inverse of the softplus function.
+   *
+   * @param y Input data.
+   * @param x The resulting inverse of the input data.
+   */
+  template<typename InputType, typename OutputType>
+  static void Inv(const InputType& y, OutputType& x)
+  {
+    x.set_size(arma::size(y));
+
+    for (size_t i = 0; i < y.n_elem; i++)
+      x(i) = Inv(y(i));
+  }
+}; // class FastSoftplusFunction
+
+} // namespace ann
+} // namespace mlpack
+
+#endif
@@ -0,0 +1,117 @@
+/**
+ * @file methods/ann/activation_functions/fast_tanh_function.hpp
+ * @author Marcus Edel
+ *
+ * Definition and implementation of an approximated hyperbolic tangent
+ * function, built on the exponential approximation of FastLogisticFunction.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_ANN_ACTIVATION_FUNCTIONS_FAST_TANH_FUNCTION_HPP
+#define MLPACK_METHODS_ANN_ACTIVATION_FUNCTIONS_FAST_TANH_FUNCTION_HPP
+
+#include <mlpack/prereqs.hpp>
+
+#include "fast_logistic_function.hpp"
+
+namespace mlpack {
+namespace ann /** Artificial Neural Network. */ {
+
+/**
+ * An approximation of the tanh function, defined by
+ *
+ * @f{eqnarray*}{
+ * f(x) &=& \frac{e^x - e^{-x}}{e^x + e^{-x}} \\
+ * f'(x) &=& 1 - \tanh^2(x) \\
+ * f^{-1}(x) &=& \frac{1}{2}\log\left(\frac{1 + x}{1 - x}\right)
+ * @f}
+ *
+ * computed through the identity \f$ \tanh(x) = 2 \sigma(2x) - 1 \f$ with the
+ * branch-free approximated sigmoid of FastLogisticFunction.  See
+ * FastLogisticFunction for the meaning of the Squarings accuracy parameter.
+ *
+ * @tparam Squarings Number of squarings used by the exponential
+ *     approximation.
+ */
+template<size_t Squarings = 8>
+class FastTanhFunction
+{
+ public:
+  /**
+   * Computes the approximated tanh function.
+   *
+   * @param x Input data.
+   * @return f(x).
+   */
+  static double Fn(const double x)
+  {
+    return 2.0 * FastLogisticFunction<Squarings>::Fn(2.0 * x) - 1.0;
+  }
+
+  /**
+   * Computes the approximated tanh function.
+   *
+   * @param x Input data.
+   * @param y The resulting output activation.
+   */
+  template<typename InputVecType, typename OutputVecType>
+  static void Fn(const InputVecType& x, OutputVecType& y)
+  {
+    FastLogisticFunction<Squarings>::Fn(2.0 * x, y);
+    y = 2.0 * y - 1.0;
+  }
+
+  /**
+   * Computes the first derivative of the tanh function.
+   *
+   * @param y Input activation.
+   * @return f'(x)
+   */
+  static double Deriv(const double y)
+  {
+    return 1 - std::pow(y, 2);
+  }
+
+  /**
+   * Computes the first derivatives of the tanh function.
+   *
+   * @param y Input activations.
+   * @param x The resulting derivatives.
+   */
+  template<typename InputVecType, typename OutputVecType>
+  static void Deriv(const InputVecType& y, OutputVecType& x)
+  {
+    x = 1 - arma::pow(y, 2);
+  }
+
+  /**
+   * Computes the inverse of the tanh function.
+   *
+   * @param y Input data.
+   * @return f^{-1}(y)
+   */
+  static double Inv(const double y)
+  {
+    return std::atanh(y);
+  }
+
+  /**
+   * Computes the inverse of the tanh function.
+   *
+   * @param y Input data.
+   * @param x The resulting inverse of the input data.
+   */
+  template<typename InputVecType, typename OutputVecType>
+  static void Inv(const InputVecType& y, OutputVecType& x)
+  {
+    x = arma::atanh(y);
+  }
+}; // class FastTanhFunction
+
+} // namespace ann
+} // namespace mlpack
+
+#endif
@@ -218,24 +218,40 @@ void BRNN<OutputLayerType, MergeLayerType, MergeOutputType,
   std::vector<arma::mat> results1, results2;
   arma::mat input;
 
-  // Forward both RNN's from opposite directions.
+  // Forward both RNN's from opposite directions.  The two directional passes
+  // are independent until the merge layer, so run them concurrently when
+  // OpenMP is available.
   for (size_t begin = 0; begin < predictors.n_cols; begin += batchSize)
   {
     const size_t effectiveBatchSize = std::min(batchSize,
         size_t(predictors.n_cols - begin));
-    for (size_t seqNum = 0; seqNum < rho; ++seqNum)
+    #ifdef HAS_OPENMP
+    #pragma omp parallel sections num_threads(2)
+    #endif
     {
-      forwardRNN.Forward(arma::mat(
-          predictors.slice(seqNum).colptr(begin),
-          predictors.n_rows, effectiveBatchSize, false, true));
-      backwardRNN.Forward(std::move(arma::mat(
-          predictors.slice(rho - seqNum - 1).colptr(begin),
-          predictors.n_rows, effectiveBatchSize, false, true)));
-
-      boost::apply_visitor(SaveOutputParameterVisitor(results1),
-          forwardRNN.network.back());
-      boost::apply_visitor(SaveOutputParameterVisitor(results2),
-          backwardRNN.network.back());
+      #ifdef HAS_OPENMP
+      #pragma omp section
+      #endif
+      for (size_t seqNum = 0; seqNum < rho; ++seqNum)
+      {
+        forwardRNN.Forward(arma::mat(
+            predictors.slice(seqNum).colptr(begin),
+            predictors.n_rows, effectiveBatchSize, false, true));
+        boost::apply_visitor(SaveOutputParameterVisitor(results1),
+            forwardRNN.network.back());
+      }
+
+      #ifdef HAS_OPENMP
+      #pragma omp section
+      #endif
+      for (size_t seqNum = 0; seqNum < rho; ++seqNum)
+      {
+        backwardRNN.Forward(arma::mat(
+            predictors.slice(rho - seqNum - 1).colptr(begin),
+            predictors.n_rows, effectiveBatchSize, false, true));
+        boost::apply_visitor(SaveOutputParameterVisitor(results2),
+            backwardRNN.network.back());
+      }
     }
     reverse(results1.begin(), results1.end());
 
@@ -299,20 +315,36 @@ double BRNN<OutputLayerType, MergeLayerType, MergeOutputType,
   double performance = 0;
   size_t responseSeq = 0;
 
+  // The two directional passes are independent until the merge layer, so run
+  // them concurrently when OpenMP is available.
   std::vector<arma::mat> results1, results2;
-  for (size_t seqNum = 0; seqNum < rho; ++seqNum)
+  #ifdef HAS_OPENMP
+  #pragma omp parallel sections num_threads(2)
+  #endif
   {
-    forwardRNN.Forward(arma::mat(
-        predictors.slice(seqNum).colptr(begin),
-        predictors.n_rows, batchSize, false, true));
-    backwardRNN.Forward(arma::mat(
-        predictors.slice(rho - seqNum - 1).colptr(begin),
-        predictors.n_rows, batchSize, false, true));
+    #ifdef HAS_OPENMP
+    #pragma omp section
+    #endif
+    for (size_t seqNum = 0; seqNum < rho; ++seqNum)
+    {
+      forwardRNN.Forward(arma::mat(
+          predictors.slice(seqNum).colptr(begin),
+          predictors.n_rows, batchSize, false, true));
+      boost::apply_visitor(SaveOutputParameterVisitor(results1),
+          forwardRNN.network.back());
+    }
 
-    boost::apply_visitor(SaveOutputParameterVisitor(results1),
-        forwardRNN.network.back());
-    boost::apply_visitor(SaveOutputParameterVisitor(results2),
-        backwardRNN.network.back());
+    #ifdef HAS_OPENMP
+    #pragma omp section
+    #endif
+    for (size_t seqNum = 0; seqNum < rho; ++seqNum)
+    {
+      backwardRNN.Forward(arma::mat(
+          predictors.slice(rho - seqNum - 1).colptr(begin),
+          predictors.n_rows, batchSize, false, true));
+      boost::apply_visitor(SaveOutputParameterVisitor(results2),
+          backwardRNN.network.back());
+    }
   }
   if (outputSize == 0)
   {
@@ -416,28 +448,49 @@ EvaluateWithGradient(const arma::mat& /* parameters */,
   backwardRNN.ResetCells();
   size_t networkSize = backwardRNN.network.size();
 
-  // Forward propogation from both directions.
+  // Forward propogation from both directions.  The two directional passes
+  // are independent until the merge layer, so run them concurrently when
+  // OpenMP is available.
   std::vector<arma::mat> results1, results2;
-  for (size_t seqNum = 0; seqNum < rho; ++seqNum)
+  #ifdef HAS_OPENMP
+  #pragma omp parallel sections num_threads(2)
+  #endif
   {
-    forwardRNN.Forward(arma::mat(
-        predictors.slice(seqNum).colptr(begin),
-        predictors.n_rows, batchSize, false, true));
-    backwardRNN.Forward(arma::mat(
-        predictors.slice(rho - seqNum - 1).colptr(begin),
-        predictors.n_rows, batchSize, false, true));
+    #ifdef HAS_OPENMP
+    #pragma omp section
+    #endif
+    for (size_t seqNum = 0; seqNum < rho; ++seqNum)
+    {
+      forwardRNN.Forward(arma::mat(
+          predictors.slice(seqNum).colptr(begin),
+          predictors.n_rows, batchSize, false, true));
 
-    for (size_t l = 0; l < networkSize; ++l)
+      for (size_t l = 0; l < networkSize; ++l)
+      {
+        boost::apply_visitor(SaveOutputParameterVisitor(
+            forwardRNNOutputParameter), forwardRNN.network[l]);
+      }
+      boost::apply_visitor(SaveOutputParameterVisitor(results1),
+          forwardRNN.network.back());
+    }
+
+    #ifdef HAS_OPENMP
+    #pragma omp section
+    #endif
+    for (size_t seqNum = 0; seqNum < rho; ++seqNum)
     {
-      boost::apply_visitor(SaveOutputParameterVisitor(
-          forwardRNNOutputParameter), forwardRNN.network[l]);
-      boost::apply_visitor(SaveOutputParameterVisitor(
-          backwardRNNOutputParameter), backwardRNN.network[l]);
+      backwardRNN.Forward(arma::mat(
+          predictors.slice(rho - seqNum - 1).colptr(begin),
+          predictors.n_rows, batchSize, false, true));
+
+      for (size_t l = 0; l < networkSize; ++l)
+      {
+        boost::apply_visitor(SaveOutputParameterVisitor(
+            backwardRNNOutputParameter), backwardRNN.network[l]);
+      }
+      boost::apply_visitor(SaveOutputParameterVisitor(results2),
+          backwardRNN.network.back());
     }
-    boost::apply_visitor(SaveOutputParameterVisitor(results1),
-        forwardRNN.network.back());
-    boost::apply_visitor(SaveOutputParameterVisitor(results2),
-        backwardRNN.network.back());
   }
   if (outputSize == 0)
   {
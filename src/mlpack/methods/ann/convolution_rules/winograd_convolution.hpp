@@ -0,0 +1,278 @@
+/**
+ * @file methods/ann/convolution_rules/winograd_convolution.hpp
+ * @author Marcus Edel
+ *
+ * Implementation of the convolution using the Winograd minimal filtering
+ * algorithm F(2x2, 3x3).
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_ANN_CONVOLUTION_RULES_WINOGRAD_CONVOLUTION_HPP
+#define MLPACK_METHODS_ANN_CONVOLUTION_RULES_WINOGRAD_CONVOLUTION_HPP
+
+#include <mlpack/prereqs.hpp>
+#include "border_modes.hpp"
+#include "naive_convolution.hpp"
+
+namespace mlpack {
+namespace ann /** Artificial Neural Network. */ {
+
+/**
+ * Computes the two-dimensional convolution using the Winograd minimal
+ * filtering algorithm F(2x2, 3x3) (Lavin and Gray, "Fast Algorithms for
+ * Convolutional Neural Networks", 2016).  Each 2x2 output tile of a 3x3
+ * filter is produced from a 4x4 input tile with 16 multiplications instead of
+ * 36, a 2.25x reduction.  The algorithm only applies to 3x3 filters with unit
+ * stride and dilation, which is the hot case in most CNNs; any other
+ * configuration automatically falls back to NaiveConvolution, so the rule can
+ * be used unconditionally as a layer's convolution rule.
+ *
+ * FullConvolution: returns the full two-dimensional convolution.
+ * ValidConvolution: returns only those parts of the convolution that are
+ * computed without the zero-padded edges.
+ *
+ * @tparam BorderMode Type of the border mode (FullConvolution or
+ * ValidConvolution).
+ */
+template<typename BorderMode = FullConvolution>
+class WinogradConvolution
+{
+ public:
+  /*
+   * Perform a convolution (valid mode).
+   *
+   * @param input Input used to perform the convolution.
+   * @param filter Filter used to perform the convolution.
+   * @param output Output data that contains the results of the convolution.
+   * @param dW Stride of filter application in the x direction.
+   * @param dH Stride of filter application in the y direction.
+   * @param dilationW The dilation factor in x direction.
+   * @param dilationH The dilation factor in y direction.
+   */
+  template<typename eT, typename Border = BorderMode>
+  static typename std::enable_if<
+      std::is_same<Border, ValidConvolution>::value, void>::type
+  Convolution(const arma::Mat<eT>& input,
+              const arma::Mat<eT>& filter,
+              arma::Mat<eT>& output,
+              const size_t dW = 1,
+              const size_t dH = 1,
+              const size_t dilationW = 1,
+              const size_t dilationH = 1)
+  {
+    // The minimal filtering algorithm is specific to 3x3 filters with unit
+    // stride and dilation; fall back to the naive rule otherwise.
+    if (filter.n_rows != 3 || filter.n_cols != 3 || dW != 1 || dH != 1 ||
+        dilationW != 1 || dilationH != 1)
+    {
+      NaiveConvolution<ValidConvolution>::Convolution(input, filter, output,
+          dW, dH, dilationW, dilationH);
+      return;
+    }
+
+    const size_t outputRows = input.n_rows - 2;
+    const size_t outputCols = input.n_cols - 2;
+
+    // Round the working output size up to a multiple of the 2x2 tile; odd
+    // output extents need one row/column of zero padding on the input.
+    const size_t workRows = outputRows + (outputRows % 2);
+    const size_t workCols = outputCols + (outputCols % 2);
+
+    const arma::Mat<eT>* in = &input;
+    arma::Mat<eT> inputPadded;
+    if (workRows != outputRows || workCols != outputCols)
+    {
+      inputPadded = arma::zeros<arma::Mat<eT> >(workRows + 2, workCols + 2);
+      inputPadded.submat(0, 0, input.n_rows - 1, input.n_cols - 1) = input;
+      in = &inputPadded;
+    }
+
+    // Transform matrices of F(2x2, 3x3).
+    arma::Mat<eT> BT(4, 4), G(4, 3), AT(2, 4);
+    BT << 1 << 0 << -1 << 0 << arma::endr
+       << 0 << 1 << 1 << 0 << arma::endr
+       << 0 << -1 << 1 << 0 << arma::endr
+       << 0 << 1 << 0 << -1;
+    G << 1 << 0 << 0 << arma::endr
+      << 0.5 << 0.5 << 0.5 << arma::endr
+      << 0.5 << -0.5 << 0.5 << arma::endr
+      << 0 << 0 << 1;
+    AT << 1 << 1 << 1 << 0 << arma::endr
+       << 0 << 1 << -1 << -1;
+
+    // The filter is transformed once and reused for every tile.
+    const arma::Mat<eT> U = G * filter * G.t();
+
+    arma::Mat<eT> outputWork(workRows, workCols);
+    for (size_t j = 0; j < workCols; j += 2)
+    {
+      for (size_t i = 0; i < workRows; i += 2)
+      {
+        // Transform the 4x4 input tile, multiply elementwise with the
+        // transformed filter and transform back to the 2x2 output tile.
+        const arma::Mat<eT> V = BT * in->submat(i, j, i + 3, j + 3) * BT.t();
+        outputWork.submat(i, j, i + 1, j + 1) = AT * (U % V) * AT.t();
+      }
+    }
+
+    if (workRows != outputRows || workCols != outputCols)
+      output = outputWork.submat(0, 0, outputRows - 1, outputCols - 1);
+    else
+      output = std::move(outputWork);
+  }
+
+  /*
+   * Perform a convolution (full mode).
+   *
+   * @param input Input used to perform the convolution.
+   * @param filter Filter used to perform the convolution.
+   * @param output Output data that contains the results of the convolution.
+   * @param dW Stride of filter application in the x direction.
+   * @param dH Stride of filter application in the y direction.
+   * @param dilationW The dilation factor in x direction.
+   * @param dilationH The dilation factor in y direction.
+   */
+  template<typename eT, typename Border = BorderMode>
+  static typename std::enable_if<
+      std::is_same<Border, FullConvolution>::value, void>::type
+  Convolution(const arma::Mat<eT>& input,
+              const arma::Mat<eT>& filter,
+              arma::Mat<eT>& output,
+              const size_t dW = 1,
+              const size_t dH = 1,
+              const size_t dilationW = 1,
+              const size_t dilationH = 1)
+  {
+    if (filter.n_rows != 3 || filter.n_cols != 3 || dW != 1 || dH != 1 ||
+        dilationW != 1 || dilationH != 1)
+    {
+      NaiveConvolution<FullConvolution>::Convolution(input, filter, output,
+          dW, dH, dilationW, dilationH);
+      return;
+    }
+
+    // Pad the input by (filter size - 1) on every side and run the valid-mode
+    // tiling over the padded input.
+    arma::Mat<eT> inputPadded = arma::zeros<arma::Mat<eT> >(input.n_rows + 4,
+        input.n_cols + 4);
+    inputPadded.submat(2, 2, input.n_rows + 1, input.n_cols + 1) = input;
+
+    WinogradConvolution<ValidConvolution>::Convolution(inputPadded, filter,
+        output);
+  }
+
+  /*
+   * Perform a convolution using 3rd order tensors.
+   *
+   * @param input Input used to perform the convolution.
+   * @param filter Filter used to perform the convolution.
+   * @param output Output data that contains the results of the convolution.
+   * @param dW Stride of filter application in the x direction.
+   * @param dH Stride of filter application in the y direction.
+   * @param dilationW The dilation factor in x direction.
+   * @param dilationH The dilation factor in y direction.
+   */
+  template<typename eT>
+  static void Convolution(const arma::Cube<eT>& input,
+                          const arma::Cube<eT>& filter,
+                          arma::Cube<eT>& output,
+                          const size_t dW = 1,
+                          const size_t dH = 1,
+                          const size_t dilationW = 1,
+                          const size_t dilationH = 1)
+  {
+    arma::Mat<eT> convOutput;
+    WinogradConvolution<BorderMode>::Convolution(input.slice(0),
+        filter.slice(0), convOutput, dW, dH, dilationW, dilationH);
+
+    output = arma::Cube<eT>(convOutput.n_rows, convOutput.n_cols,
+        input.n_slices);
+    output.slice(0) = convOutput;
+
+    for (size_t i = 1; i < input.n_slices; i++)
+    {
+      WinogradConvolution<BorderMode>::Convolution(input.slice(i),
+          filter.slice(i), output.slice(i), dW, dH, dilationW, dilationH);
+    }
+  }
+
+  /*
+   * Perform a convolution using dense matrix as input and a 3rd order tensors
+   * as filter and output.
+   *
+   * @param input Input used to perform the convolution.
+   * @param filter Filter used to perform the convolution.
+   * @param output Output data that contains the results of the convolution.
+   * @param dW Stride of filter application in the x direction.
+   * @param dH Stride of filter application in the y direction.
+   * @param dilationW The dilation factor in x direction.
+   * @param dilationH The dilation factor in y direction.
+   */
+  template<typename eT>
+  static void Convolution(const arma::Mat<eT>& input,
+                          const arma::Cube<eT>& filter,
+                          arma::Cube<eT>& output,
+                          const size_t dW = 1,
+                          const size_t dH = 1,
+                          const size_t dilationW = 1,
+                          const size_t dilationH = 1)
+  {
+    arma::Mat<eT> convOutput;
+    WinogradConvolution<BorderMode>::Convolution(input, filter.slice(0),
+        convOutput, dW, dH, dilationW, dilationH);
+
+    output = arma::Cube<eT>(convOutput.n_rows, convOutput.n_cols,
+        filter.n_slices);
+    output.slice(0) = convOutput;
+
+    for (size_t i = 1; i < filter.n_slices; i++)
+    {
+      WinogradConvolution<BorderMode>::Convolution(input, filter.slice(i),
+          output.slice(i), dW, dH, dilationW, dilationH);
+    }
+  }
+
+  /*
+   * Perform a convolution using a 3rd order tensors as input and output and a
+   * dense matrix as filter.
+   *
+   * @param input Input used to perform the convolution.
+   * @param filter Filter used to perform the convolution.
+   * @param output Output data that contains the results of the convolution.
+   * @param dW Stride of filter application in the x direction.
+   * @param dH Stride of filter application in the y direction.
+   * @param dilationW The dilation factor in x direction.
+   * @param dilationH The dilation factor in y direction.
+   */
+  template<typename eT>
+  static void Convolution(const arma::Cube<eT>& input,
+                          const arma::Mat<eT>& filter,
+                          arma::Cube<eT>& output,
+                          const size_t dW = 1,
+                          const size_t dH = 1,
+                          const size_t dilationW = 1,
+                          const size_t dilationH = 1)
+  {
+    arma::Mat<eT> convOutput;
+    WinogradConvolution<BorderMode>::Convolution(input.slice(0), filter,
+        convOutput, dW, dH, dilationW, dilationH);
+
+    output = arma::Cube<eT>(convOutput.n_rows, convOutput.n_cols,
+        input.n_slices);
+    output.slice(0) = convOutput;
+
+    for (size_t i = 1; i < input.n_slices; i++)
+    {
+      WinogradConvolution<BorderMode>::Convolution(input.slice(i), filter,
+          output.slice(i), dW, dH, dilationW, dilationH);
+    }
+  }
+};  // class WinogradConvolution
+
+} // namespace ann
+} // namespace mlpack
+
+#endif
@@ -22,15 +22,18 @@
 #include "visitor/output_width_visitor.hpp"
 #include "visitor/reset_visitor.hpp"
 #include "visitor/weight_size_visitor.hpp"
+#include "visitor/compile_forward_visitor.hpp"
 #include "visitor/copy_visitor.hpp"
 #include "visitor/loss_visitor.hpp"
 
 #include "init_rules/network_init.hpp"
+#include "layer_profiler.hpp"
 
 #include <mlpack/methods/ann/layer/layer_types.hpp>
 #include <mlpack/methods/ann/layer/layer.hpp>
 #include <mlpack/methods/ann/init_rules/random_init.hpp>
 #include <mlpack/methods/ann/layer/layer_traits.hpp>
+#include <mlpack/methods/ann/prefetching_data_loader.hpp>
 #include <ensmallen.hpp>
 
 namespace mlpack {
@@ -163,6 +166,30 @@ class FFN
                arma::mat responses,
                CallbackTypes&&... callbacks);
 
+  /**
+   * Train the feedforward network on chunks streamed from the given data
+   * loader using the given optimizer.  Each chunk is trained on as soon as it
+   * is available, while the loader's background threads prefetch the
+   * following chunks, so datasets that do not fit in memory can be trained on
+   * without idle gaps between chunks.
+   *
+   * This will use the existing model parameters as a starting point for the
+   * optimization, and each chunk continues from the parameters the previous
+   * chunk ended with.
+   *
+   * @tparam OptimizerType Type of optimizer to use to train the model.
+   * @tparam CallbackTypes Types of Callback Functions.
+   * @param loader Data loader streaming the training chunks.
+   * @param optimizer Instantiated optimizer used to train the model.
+   * @param callbacks Callback function for ensmallen optimizer `OptimizerType`.
+   *      See https://www.ensmallen.org/docs.html#callback-documentation.
+   * @return The objective of the model on the last trained chunk.
+   */
+  template<typename OptimizerType, typename... CallbackTypes>
+  double Train(PrefetchingDataLoader<arma::mat, arma::mat>& loader,
+               OptimizerType& optimizer,
+               CallbackTypes&&... callbacks);
+
   /**
    * Predict the responses to a given set of predictors. The responses will
    * reflect the output of the given output layer as returned by the
@@ -176,6 +203,89 @@ class FFN
    */
   void Predict(arma::mat predictors, arma::mat& results);
 
+  /**
+   * Predict the responses to a given set of sparse predictors.  The first
+   * layer receives each sparse column directly, so a layer that implements a
+   * sparse Forward() overload (such as Linear) only touches the weight
+   * columns matching nonzero features; this is a large win for one-hot or
+   * multi-hot encoded predictors.  All later layers operate on the dense
+   * activations as usual.
+   *
+   * @param predictors Sparse input predictors.
+   * @param results Matrix to put output predictions of responses into.
+   */
+  void Predict(const arma::sp_mat& predictors, arma::mat& results);
+
+  /**
+   * Compile the network into an inference-only execution plan.  The Forward()
+   * function of every layer is resolved through the variant exactly once and
+   * stored as a directly callable function object together with a pointer to
+   * the layer's output buffer, so subsequent Predict() calls skip the
+   * per-layer visitor dispatch entirely.  The training-only buffers held by
+   * the network itself (stored predictors and responses, error, delta and
+   * gradient matrices) are released.
+   *
+   * The plan stays valid as long as the network structure is unchanged;
+   * adding a layer or training the model invalidates it, after which
+   * Predict() falls back to the regular dispatch path until Compile() is
+   * called again.  Parameter updates through Parameters() do not invalidate
+   * the plan, since the layers alias the parameter memory.
+   */
+  void Compile();
+
+  //! Return whether a compiled inference plan is currently valid.
+  bool Compiled() const { return compiled; }
+
+  /**
+   * Finalize the model for steady-state serving.  Every layer that supports
+   * an inference weight layout (such as Linear) repacks its weight matrices
+   * ahead of time into a dedicated, freshly aligned allocation, detached
+   * from the network-wide parameter matrix that training shares with the
+   * optimizer; afterwards the network is compiled into the inference-only
+   * execution plan (see Compile()).
+   *
+   * The repacked layout is a snapshot of the current weights.  Unlike with
+   * Compile() alone, later updates through Parameters() do not reach the
+   * repacked layers; train first, then call OptimizeForInference() again.
+   */
+  void OptimizeForInference();
+
+  /**
+   * Lay the per-layer activation (and delta) buffers out in one shared memory
+   * arena instead of one allocation per layer.  A forward pass with the given
+   * sample input is run first to propagate the input dimensions and size
+   * every buffer; the plan is therefore laid out for the batch size of
+   * sampleInput, and a later pass with a different batch size silently
+   * detaches the affected buffers from the arena again.
+   *
+   * During training every activation is consumed by the backward pass and
+   * every delta is held until the gradient pass, so no two buffers can share
+   * memory; the arena then only removes per-layer allocation churn.  For
+   * inference (inferenceOnly = true) the output of a layer is dead as soon as
+   * the next layer has consumed it, so all activations alternate between two
+   * slots and the delta buffers are dropped entirely, reducing the peak
+   * activation memory from the sum over all layers to the two largest
+   * neighbouring layers.
+   *
+   * @param sampleInput Input used to size the layer buffers; the memory plan
+   *      is valid for inputs of this dimensionality and batch size.
+   * @param inferenceOnly If true, plan for forward passes only; the network
+   *      must not be trained or run backward until PlanMemory() is called
+   *      again.
+   */
+  void PlanMemory(const arma::mat& sampleInput,
+                  const bool inferenceOnly = false);
+
+  /**
+   * Release the shared activation workspace.  Every layer's activation and
+   * delta buffer is detached from the arena and the arena itself is freed;
+   * the next forward pass sizes the buffers on the fly again, and the next
+   * optimizer step re-plans the workspace automatically for its batch shape.
+   * Call this to return the memory of a large planned batch shape before
+   * switching to a smaller one, or before serializing a long-lived network.
+   */
+  void ResetWorkspace();
+
   /**
    * Evaluate the feedforward network with the given predictors and responses.
    * This functions is usually used to monitor progress while training.
@@ -287,14 +397,30 @@ class FFN
    * @param args The layer parameter.
    */
   template <class LayerType, class... Args>
-  void Add(Args... args) { network.push_back(new LayerType(args...)); }
+  void Add(Args... args)
+  {
+    network.push_back(new LayerType(args...));
+    compiled = false;
+
+    // The new layer's buffers are not part of any planned workspace.
+    workspaceRows = 0;
+    workspaceCols = 0;
+  }
 
   /*
    * Add a new module to the model.
    *
    * @param layer The Layer to be added to the model.
    */
-  void Add(LayerTypes<CustomLayers...> layer) { network.push_back(layer); }
+  void Add(LayerTypes<CustomLayers...> layer)
+  {
+    network.push_back(layer);
+    compiled = false;
+
+    // The new layer's buffers are not part of any planned workspace.
+    workspaceRows = 0;
+    workspaceCols = 0;
+  }
 
   //! Get the network model.
   const std::vector<LayerTypes<CustomLayers...> >& Model() const
@@ -324,6 +450,30 @@ class FFN
   //! Modify the matrix of data points (predictors).
   arma::mat& Predictors() { return predictors; }
 
+  //! Get the number of threads used for gradient computation during training.
+  size_t Parallelism() const { return parallelism; }
+  //! Modify the number of threads used for gradient computation during
+  //! training.  If set to a value greater than one and mlpack was built with
+  //! OpenMP support, each mini-batch is split across that many worker copies
+  //! of the network (sharing the parameter values) and the partial gradients
+  //! are summed; with a single thread or without OpenMP the behavior is
+  //! unchanged.
+  size_t& Parallelism() { return parallelism; }
+
+  //! Get the per-layer profiler.
+  const LayerProfiler& Profiler() const { return profiler; }
+  //! Modify the per-layer profiler; set Profiler().Enabled() to true to
+  //! record per-layer forward/backward times (via the Timer infrastructure),
+  //! bytes moved and estimated FLOPs.
+  LayerProfiler& Profiler() { return profiler; }
+
+  /**
+   * Print a per-layer table of the statistics recorded by the profiler.
+   *
+   * @param os Stream to print the table into.
+   */
+  void ProfileSummary(std::ostream& os);
+
   /**
    * Reset the module infomration (weights/parameters).
    */
@@ -426,6 +576,63 @@ class FFN
    */
   void ResetGradients(arma::mat& gradient);
 
+  /**
+   * Run the forward pass of the layer with the given index.  The sparse
+   * overload dispatches through SparseForwardVisitor, so a layer that
+   * implements a sparse Forward() overload (such as Linear) accumulates only
+   * the weight columns matching nonzero input entries; a layer without such
+   * an overload receives a densified copy of the input.
+   *
+   * @param index Index of the layer to run.
+   * @param input Input of the given layer.
+   */
+  void ForwardLayer(const size_t index, const arma::mat& input);
+  void ForwardLayer(const size_t index, const arma::sp_mat& input);
+
+  /**
+   * Run the gradient pass of the layer with the given index.  As with
+   * ForwardLayer(), the sparse overload only visits the nonzero input
+   * entries when the layer provides a sparse Gradient() overload.
+   *
+   * @param index Index of the layer to run.
+   * @param input Input of the given layer.
+   * @param delta Backpropagated error of the following layer.
+   */
+  void GradientLayer(const size_t index,
+                     const arma::mat& input,
+                     const arma::mat& delta);
+  void GradientLayer(const size_t index,
+                     const arma::sp_mat& input,
+                     const arma::mat& delta);
+
+  /**
+   * Make sure the shared activation workspace is planned for the given batch
+   * of the stored predictors.  The workspace is laid out once per batch
+   * shape (input rows x batch size) and reused by every later call with the
+   * same shape; a shape change, Add(), or ResetWorkspace() triggers a
+   * re-plan on the next call.
+   *
+   * @param begin Index of the starting point of the batch.
+   * @param batchSize Number of points in the batch.
+   */
+  void EnsureWorkspace(const size_t begin, const size_t batchSize);
+
+  /**
+   * Compute the loss and gradient of a mini-batch with the batch split across
+   * the worker networks, summing the partial gradients into the given
+   * gradient matrix.  Called by EvaluateWithGradient() when Parallelism() is
+   * greater than one; the worker copies are (re)built lazily whenever the
+   * pool size or the parameter size changed.
+   *
+   * @param begin Index of the starting point of the mini-batch.
+   * @param gradient Matrix to output the summed gradient into.
+   * @param batchSize Number of points in the mini-batch.
+   */
+  template<typename GradType>
+  double EvaluateWithGradientParallel(const size_t begin,
+                                      GradType& gradient,
+                                      const size_t batchSize);
+
   /**
    * Swap the content of this network with given network.
    *
@@ -506,6 +713,38 @@ class FFN
   //! Locally-stored gradient parameter.
   arma::mat gradient;
 
+  //! Whether the compiled inference plan is valid.
+  bool compiled;
+
+  //! Pre-resolved Forward() function of each layer (inference plan).
+  std::vector<std::function<void(const arma::mat&, arma::mat&)> >
+      compiledForward;
+
+  //! Output buffer of each layer, resolved once at compile time.
+  std::vector<arma::mat*> compiledOutputs;
+
+  //! Shared arena holding the layer activation and delta buffers after
+  //! PlanMemory() has been called.
+  arma::mat activationArena;
+
+  //! Input rows the workspace is currently planned for; 0 if none.
+  size_t workspaceRows;
+  //! Batch size the workspace is currently planned for; 0 if none.
+  size_t workspaceCols;
+  //! Whether the current workspace was planned without delta buffers.
+  bool workspaceInferenceOnly;
+
+  //! The number of threads used for gradient computation during training.
+  size_t parallelism;
+
+  //! Opt-in per-layer instrumentation; disabled by default.
+  LayerProfiler profiler;
+
+  //! Worker copies of the network used for data-parallel gradient
+  //! computation; built lazily and owned by this network.
+  std::vector<FFN<OutputLayerType,
+                  InitializationRuleType, CustomLayers...>*> parallelNetworks;
+
   //! Locally-stored copy visitor
   CopyVisitor<CustomLayers...> copyVisitor;
 
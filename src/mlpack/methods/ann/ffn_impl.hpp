@@ -22,6 +22,11 @@
 #include "visitor/gradient_visitor.hpp"
 #include "visitor/set_input_height_visitor.hpp"
 #include "visitor/set_input_width_visitor.hpp"
+#include "visitor/sparse_forward_visitor.hpp"
+#include "visitor/sparse_gradient_visitor.hpp"
+#include "visitor/optimize_for_inference_visitor.hpp"
+
+#include "layer_names.hpp"
 
 #include <boost/serialization/variant.hpp>
 
@@ -39,7 +44,13 @@ FFN<OutputLayerType, InitializationRuleType, CustomLayers...>::FFN(
     height(0),
     reset(false),
     numFunctions(0),
-    deterministic(true)
+    deterministic(true),
+    compiled(false),
+    workspaceRows(0),
+    workspaceCols(0),
+    workspaceInferenceOnly(false),
+    parallelism(1),
+    profiler("ffn")
 {
   /* Nothing to do here. */
 }
@@ -50,6 +61,9 @@ FFN<OutputLayerType, InitializationRuleType, CustomLayers...>::~FFN()
 {
   std::for_each(network.begin(), network.end(),
       boost::apply_visitor(deleteVisitor));
+
+  for (size_t i = 0; i < parallelNetworks.size(); ++i)
+    delete parallelNetworks[i];
 }
 
 template<typename OutputLayerType, typename InitializationRuleType,
@@ -63,6 +77,10 @@ void FFN<OutputLayerType, InitializationRuleType, CustomLayers...>::ResetData(
   this->deterministic = true;
   ResetDeterministic();
 
+  // Training may change the network state, so any compiled inference plan is
+  // no longer valid.
+  compiled = false;
+
   if (!reset)
     ResetParameters();
 }
@@ -149,6 +167,32 @@ double FFN<OutputLayerType, InitializationRuleType, CustomLayers...>::Train(
   return out;
 }
 
+template<typename OutputLayerType, typename InitializationRuleType,
+         typename... CustomLayers>
+template<typename OptimizerType, typename... CallbackTypes>
+double FFN<OutputLayerType, InitializationRuleType, CustomLayers...>::Train(
+    PrefetchingDataLoader<arma::mat, arma::mat>& loader,
+    OptimizerType& optimizer,
+    CallbackTypes&&... callbacks)
+{
+  double out = 0;
+  arma::mat chunkPredictors, chunkResponses;
+
+  // Train on each chunk as it becomes available; the loader's background
+  // threads prefetch the following chunks in the meantime.
+  Timer::Start("ffn_optimization");
+  while (loader.Next(chunkPredictors, chunkResponses))
+  {
+    ResetData(std::move(chunkPredictors), std::move(chunkResponses));
+    out = optimizer.Optimize(*this, parameter, callbacks...);
+  }
+  Timer::Stop("ffn_optimization");
+
+  Log::Info << "FFN::FFN(): objective on the last trained chunk is " << out
+      << "." << std::endl;
+  return out;
+}
+
 template<typename OutputLayerType, typename InitializationRuleType,
          typename... CustomLayers>
 template<typename PredictorsType, typename ResponsesType>
@@ -177,9 +221,7 @@ void FFN<OutputLayerType, InitializationRuleType, CustomLayers...>::Forward(
     const size_t begin,
     const size_t end)
 {
-  boost::apply_visitor(ForwardVisitor(inputs,
-      boost::apply_visitor(outputParameterVisitor, network[begin])),
-      network[begin]);
+  ForwardLayer(begin, inputs);
 
   for (size_t i = 1; i < end - begin + 1; ++i)
   {
@@ -234,6 +276,30 @@ void FFN<OutputLayerType, InitializationRuleType, CustomLayers...>::Predict(
     ResetDeterministic();
   }
 
+  // If a compiled inference plan is available (and the input dimensions have
+  // already been propagated through the network), execute it instead of
+  // re-dispatching through the layer variant for every layer and point.
+  if (compiled && reset)
+  {
+    arma::mat& networkOutput = *compiledOutputs.back();
+
+    results = arma::mat(0, 0);
+    for (size_t i = 0; i < predictors.n_cols; i++)
+    {
+      compiledForward.front()(
+          arma::mat(predictors.colptr(i), predictors.n_rows, 1, false, true),
+          *compiledOutputs.front());
+      for (size_t l = 1; l < compiledForward.size(); ++l)
+        compiledForward[l](*compiledOutputs[l - 1], *compiledOutputs[l]);
+
+      if (i == 0)
+        results = arma::mat(networkOutput.n_elem, predictors.n_cols);
+      results.col(i) = arma::vectorise(networkOutput);
+    }
+
+    return;
+  }
+
   arma::mat resultsTemp;
   Forward(arma::mat(predictors.colptr(0), predictors.n_rows, 1, false, true));
   resultsTemp = boost::apply_visitor(outputParameterVisitor,
@@ -252,6 +318,225 @@ void FFN<OutputLayerType, InitializationRuleType, CustomLayers...>::Predict(
   }
 }
 
+template<typename OutputLayerType, typename InitializationRuleType,
+         typename... CustomLayers>
+void FFN<OutputLayerType, InitializationRuleType, CustomLayers...>::Predict(
+    const arma::sp_mat& predictors, arma::mat& results)
+{
+  if (parameter.is_empty())
+    ResetParameters();
+
+  if (!deterministic)
+  {
+    deterministic = true;
+    ResetDeterministic();
+  }
+
+  arma::mat resultsTemp;
+  Forward(arma::sp_mat(predictors.col(0)));
+  resultsTemp = boost::apply_visitor(outputParameterVisitor,
+      network.back()).col(0);
+
+  results = arma::mat(resultsTemp.n_elem, predictors.n_cols);
+  results.col(0) = resultsTemp.col(0);
+
+  for (size_t i = 1; i < predictors.n_cols; i++)
+  {
+    Forward(arma::sp_mat(predictors.col(i)));
+
+    resultsTemp = boost::apply_visitor(outputParameterVisitor,
+        network.back());
+    results.col(i) = resultsTemp.col(0);
+  }
+}
+
+template<typename OutputLayerType, typename InitializationRuleType,
+         typename... CustomLayers>
+void FFN<OutputLayerType, InitializationRuleType, CustomLayers...>::Compile()
+{
+  if (parameter.is_empty())
+    ResetParameters();
+
+  deterministic = true;
+  ResetDeterministic();
+
+  // Resolve each layer's Forward() function and output buffer through the
+  // variant exactly once; Predict() then calls them directly.
+  compiledForward.clear();
+  compiledOutputs.clear();
+  compiledForward.reserve(network.size());
+  compiledOutputs.reserve(network.size());
+  for (size_t i = 0; i < network.size(); ++i)
+  {
+    compiledForward.push_back(boost::apply_visitor(CompileForwardVisitor(),
+        network[i]));
+    compiledOutputs.push_back(&boost::apply_visitor(outputParameterVisitor,
+        network[i]));
+  }
+
+  // Inference does not use the training-only buffers; release the memory.
+  predictors.clear();
+  responses.clear();
+  error.clear();
+  delta.clear();
+  gradient.clear();
+  numFunctions = 0;
+
+  compiled = true;
+}
+
+template<typename OutputLayerType, typename InitializationRuleType,
+         typename... CustomLayers>
+void FFN<OutputLayerType, InitializationRuleType,
+         CustomLayers...>::OptimizeForInference()
+{
+  if (parameter.is_empty())
+    ResetParameters();
+
+  // Repack the weights of every layer that supports an inference layout into
+  // its own allocation; the layers alias the shared parameter matrix until
+  // this point.
+  for (size_t i = 0; i < network.size(); ++i)
+    boost::apply_visitor(OptimizeForInferenceVisitor(), network[i]);
+
+  Compile();
+}
+
+template<typename OutputLayerType, typename InitializationRuleType,
+         typename... CustomLayers>
+void FFN<OutputLayerType, InitializationRuleType,
+         CustomLayers...>::PlanMemory(const arma::mat& sampleInput,
+                                      const bool inferenceOnly)
+{
+  if (parameter.is_empty())
+    ResetParameters();
+
+  // Run one forward pass so that the input dimensions are propagated through
+  // the network and every activation buffer has its final size.
+  deterministic = true;
+  ResetDeterministic();
+  Forward(sampleInput);
+
+  if (inferenceOnly)
+  {
+    // During a forward-only pass the output of a layer is dead as soon as the
+    // next layer has consumed it, so the activations can alternate between
+    // two slots, each sized for the largest activation mapped to it.
+    size_t slotElems[2] = { 0, 0 };
+    for (size_t i = 0; i < network.size(); ++i)
+    {
+      const size_t elems = boost::apply_visitor(outputParameterVisitor,
+          network[i]).n_elem;
+      if (elems > slotElems[i % 2])
+        slotElems[i % 2] = elems;
+    }
+
+    activationArena.set_size(slotElems[0] + slotElems[1], 1);
+    for (size_t i = 0; i < network.size(); ++i)
+    {
+      arma::mat& outputParameter = boost::apply_visitor(
+          outputParameterVisitor, network[i]);
+      outputParameter = arma::mat(activationArena.memptr() +
+          ((i % 2 == 0) ? 0 : slotElems[0]), outputParameter.n_rows,
+          outputParameter.n_cols, false, false);
+
+      // Inference never runs the backward pass, so the delta buffers are not
+      // needed at all.
+      boost::apply_visitor(deltaVisitor, network[i]).clear();
+    }
+  }
+  else
+  {
+    // During training every activation is consumed by the backward pass and
+    // every delta is held until the gradient pass, so no two buffers may
+    // overlap; lay all of them out back to back in a single allocation.  The
+    // delta of layer i has the dimensions of that layer's input, which is the
+    // output of layer i - 1 (the delta of the first layer is never written).
+    size_t totalElems = 0;
+    for (size_t i = 0; i < network.size(); ++i)
+    {
+      totalElems += boost::apply_visitor(outputParameterVisitor,
+          network[i]).n_elem;
+      if (i > 0)
+      {
+        totalElems += boost::apply_visitor(outputParameterVisitor,
+            network[i - 1]).n_elem;
+      }
+    }
+
+    activationArena.set_size(totalElems, 1);
+    size_t offset = 0;
+    for (size_t i = 0; i < network.size(); ++i)
+    {
+      arma::mat& outputParameter = boost::apply_visitor(
+          outputParameterVisitor, network[i]);
+      if (i > 0)
+      {
+        arma::mat& delta = boost::apply_visitor(deltaVisitor, network[i]);
+        delta = arma::mat(activationArena.memptr() + offset,
+            boost::apply_visitor(outputParameterVisitor,
+            network[i - 1]).n_rows, boost::apply_visitor(
+            outputParameterVisitor, network[i - 1]).n_cols, false, false);
+        offset += delta.n_elem;
+      }
+
+      outputParameter = arma::mat(activationArena.memptr() + offset,
+          outputParameter.n_rows, outputParameter.n_cols, false, false);
+      offset += outputParameter.n_elem;
+    }
+  }
+
+  // Record the batch shape this workspace is valid for, so later passes with
+  // the same shape can reuse it without re-planning.
+  workspaceRows = sampleInput.n_rows;
+  workspaceCols = sampleInput.n_cols;
+  workspaceInferenceOnly = inferenceOnly;
+}
+
+template<typename OutputLayerType, typename InitializationRuleType,
+         typename... CustomLayers>
+void FFN<OutputLayerType, InitializationRuleType,
+         CustomLayers...>::ResetWorkspace()
+{
+  // Detach every layer buffer from the arena; the buffers size themselves
+  // again on the next forward or backward pass.
+  for (size_t i = 0; i < network.size(); ++i)
+  {
+    boost::apply_visitor(outputParameterVisitor, network[i]).clear();
+    boost::apply_visitor(deltaVisitor, network[i]).clear();
+  }
+
+  activationArena.reset();
+  workspaceRows = 0;
+  workspaceCols = 0;
+  workspaceInferenceOnly = false;
+}
+
+template<typename OutputLayerType, typename InitializationRuleType,
+         typename... CustomLayers>
+void FFN<OutputLayerType, InitializationRuleType,
+         CustomLayers...>::EnsureWorkspace(const size_t begin,
+                                           const size_t batchSize)
+{
+  // A workspace planned for this exact batch shape (with delta buffers) can
+  // be reused as-is.
+  if (!workspaceInferenceOnly && workspaceRows == predictors.n_rows &&
+      workspaceCols == batchSize)
+    return;
+
+  // PlanMemory() runs its sizing pass in deterministic mode; restore the
+  // caller's mode afterwards so a training step that triggered a re-plan
+  // still runs with stochastic layers (dropout and the like) enabled.
+  const bool wasDeterministic = deterministic;
+  PlanMemory(predictors.cols(begin, begin + batchSize - 1),
+      false /* inferenceOnly */);
+  if (deterministic != wasDeterministic)
+  {
+    deterministic = wasDeterministic;
+    ResetDeterministic();
+  }
+}
+
 template<typename OutputLayerType, typename InitializationRuleType,
          typename... CustomLayers>
 template<typename PredictorsType, typename ResponsesType>
@@ -370,6 +655,15 @@ EvaluateWithGradient(const arma::mat& /* parameters */,
     ResetDeterministic();
   }
 
+#ifdef HAS_OPENMP
+  if (parallelism > 1 && batchSize > 1)
+    return EvaluateWithGradientParallel(begin, gradient, batchSize);
+#endif
+
+  // Plan the shared workspace for this batch shape once; every later step
+  // with the same shape reuses the buffers without any allocation.
+  EnsureWorkspace(begin, batchSize);
+
   Forward(predictors.cols(begin, begin + batchSize - 1));
   double res = outputLayer.Forward(
       boost::apply_visitor(outputParameterVisitor, network.back()),
@@ -392,6 +686,102 @@ EvaluateWithGradient(const arma::mat& /* parameters */,
   return res;
 }
 
+template<typename OutputLayerType, typename InitializationRuleType,
+         typename... CustomLayers>
+template<typename GradType>
+double FFN<OutputLayerType, InitializationRuleType, CustomLayers...>::
+EvaluateWithGradientParallel(const size_t begin,
+                             GradType& gradient,
+                             const size_t batchSize)
+{
+  const size_t threads = std::min(parallelism, batchSize);
+
+  // (Re)build the worker pool if its size or the network changed.
+  if (parallelNetworks.size() != threads ||
+      parallelNetworks.front()->parameter.n_elem != parameter.n_elem ||
+      parallelNetworks.front()->network.size() != network.size())
+  {
+    for (size_t t = 0; t < parallelNetworks.size(); ++t)
+      delete parallelNetworks[t];
+    parallelNetworks.clear();
+
+    for (size_t t = 0; t < threads; ++t)
+    {
+      FFN* worker = new FFN(*this);
+
+      // The workers get their mini-batch slices passed in directly, so they
+      // do not need their own copy of the training data.
+      worker->predictors.clear();
+      worker->responses.clear();
+
+      // Re-alias the copied layers to the worker's own parameter matrix, so
+      // that a plain assignment below keeps the worker in sync.
+      size_t offset = 0;
+      for (size_t i = 0; i < worker->network.size(); ++i)
+      {
+        offset += boost::apply_visitor(WeightSetVisitor(worker->parameter,
+            offset), worker->network[i]);
+
+        boost::apply_visitor(resetVisitor, worker->network[i]);
+      }
+
+      parallelNetworks.push_back(worker);
+    }
+  }
+
+  // Split the mini-batch into contiguous chunks, one per worker, and sum the
+  // losses and partial gradients afterwards.
+  std::vector<double> losses(threads, 0.0);
+  std::vector<GradType> gradients(threads);
+
+  #pragma omp parallel for
+  for (omp_size_t t = 0; t < (omp_size_t) threads; ++t)
+  {
+    FFN& worker = *parallelNetworks[t];
+    const size_t chunkBegin = begin + (t * batchSize) / threads;
+    const size_t chunkEnd = begin + ((t + 1) * batchSize) / threads;
+
+    // The sizes match, so the assignment writes into the existing memory and
+    // the layer parameter aliases stay valid.
+    worker.parameter = parameter;
+    if (worker.deterministic)
+    {
+      worker.deterministic = false;
+      worker.ResetDeterministic();
+    }
+
+    worker.Forward(predictors.cols(chunkBegin, chunkEnd - 1));
+    losses[t] = worker.outputLayer.Forward(
+        boost::apply_visitor(worker.outputParameterVisitor,
+        worker.network.back()), responses.cols(chunkBegin, chunkEnd - 1));
+
+    for (size_t i = 0; i < worker.network.size(); ++i)
+    {
+      losses[t] += boost::apply_visitor(worker.lossVisitor, worker.network[i]);
+    }
+
+    worker.outputLayer.Backward(
+        boost::apply_visitor(worker.outputParameterVisitor,
+        worker.network.back()), responses.cols(chunkBegin, chunkEnd - 1),
+        worker.error);
+
+    worker.Backward();
+
+    gradients[t] = arma::zeros<arma::mat>(parameter.n_rows, parameter.n_cols);
+    worker.ResetGradients(gradients[t]);
+    worker.Gradient(predictors.cols(chunkBegin, chunkEnd - 1));
+  }
+
+  double res = 0;
+  for (size_t t = 0; t < threads; ++t)
+  {
+    res += losses[t];
+    gradient += gradients[t];
+  }
+
+  return res;
+}
+
 template<typename OutputLayerType, typename InitializationRuleType,
          typename... CustomLayers>
 void FFN<OutputLayerType, InitializationRuleType, CustomLayers...>::Gradient(
@@ -446,15 +836,68 @@ void FFN<OutputLayerType, InitializationRuleType,
   }
 }
 
+template<typename OutputLayerType, typename InitializationRuleType,
+         typename... CustomLayers>
+void FFN<OutputLayerType, InitializationRuleType,
+         CustomLayers...>::ForwardLayer(const size_t index,
+                                        const arma::mat& input)
+{
+  boost::apply_visitor(ForwardVisitor(input,
+      boost::apply_visitor(outputParameterVisitor, network[index])),
+      network[index]);
+}
+
+template<typename OutputLayerType, typename InitializationRuleType,
+         typename... CustomLayers>
+void FFN<OutputLayerType, InitializationRuleType,
+         CustomLayers...>::ForwardLayer(const size_t index,
+                                        const arma::sp_mat& input)
+{
+  boost::apply_visitor(SparseForwardVisitor(input,
+      boost::apply_visitor(outputParameterVisitor, network[index])),
+      network[index]);
+}
+
+template<typename OutputLayerType, typename InitializationRuleType,
+         typename... CustomLayers>
+void FFN<OutputLayerType, InitializationRuleType,
+         CustomLayers...>::GradientLayer(const size_t index,
+                                         const arma::mat& input,
+                                         const arma::mat& delta)
+{
+  boost::apply_visitor(GradientVisitor(input, delta), network[index]);
+}
+
+template<typename OutputLayerType, typename InitializationRuleType,
+         typename... CustomLayers>
+void FFN<OutputLayerType, InitializationRuleType,
+         CustomLayers...>::GradientLayer(const size_t index,
+                                         const arma::sp_mat& input,
+                                         const arma::mat& delta)
+{
+  boost::apply_visitor(SparseGradientVisitor(input, delta), network[index]);
+}
+
 template<typename OutputLayerType, typename InitializationRuleType,
          typename... CustomLayers>
 template<typename InputType>
 void FFN<OutputLayerType, InitializationRuleType,
          CustomLayers...>::Forward(const InputType& input)
 {
-  boost::apply_visitor(ForwardVisitor(input,
-      boost::apply_visitor(outputParameterVisitor, network.front())),
-      network.front());
+  if (profiler.Enabled())
+  {
+    profiler.Start(0, "forward");
+    ForwardLayer(0, input);
+    profiler.Stop(0, "forward");
+    profiler.Add(0, input.n_elem,
+        boost::apply_visitor(outputParameterVisitor, network.front()).n_elem,
+        boost::apply_visitor(weightSizeVisitor, network.front()),
+        input.n_cols);
+  }
+  else
+  {
+    ForwardLayer(0, input);
+  }
 
   if (!reset)
   {
@@ -480,10 +923,23 @@ void FFN<OutputLayerType, InitializationRuleType,
       boost::apply_visitor(SetInputHeightVisitor(height), network[i]);
     }
 
+    if (profiler.Enabled())
+      profiler.Start(i, "forward");
+
     boost::apply_visitor(ForwardVisitor(boost::apply_visitor(
         outputParameterVisitor, network[i - 1]),
         boost::apply_visitor(outputParameterVisitor, network[i])), network[i]);
 
+    if (profiler.Enabled())
+    {
+      profiler.Stop(i, "forward");
+      profiler.Add(i,
+          boost::apply_visitor(outputParameterVisitor, network[i - 1]).n_elem,
+          boost::apply_visitor(outputParameterVisitor, network[i]).n_elem,
+          boost::apply_visitor(weightSizeVisitor, network[i]),
+          boost::apply_visitor(outputParameterVisitor, network[i]).n_cols);
+    }
+
     if (!reset)
     {
       // Get the output width.
@@ -508,28 +964,52 @@ template<typename OutputLayerType, typename InitializationRuleType,
          typename... CustomLayers>
 void FFN<OutputLayerType, InitializationRuleType, CustomLayers...>::Backward()
 {
+  if (profiler.Enabled())
+    profiler.Start(network.size() - 1, "backward");
+
   boost::apply_visitor(BackwardVisitor(boost::apply_visitor(
       outputParameterVisitor, network.back()), error,
       boost::apply_visitor(deltaVisitor, network.back())), network.back());
 
+  if (profiler.Enabled())
+    profiler.Stop(network.size() - 1, "backward");
+
   for (size_t i = 2; i < network.size(); ++i)
   {
+    if (profiler.Enabled())
+      profiler.Start(network.size() - i, "backward");
+
     boost::apply_visitor(BackwardVisitor(boost::apply_visitor(
         outputParameterVisitor, network[network.size() - i]),
         boost::apply_visitor(deltaVisitor, network[network.size() - i + 1]),
         boost::apply_visitor(deltaVisitor, network[network.size() - i])),
         network[network.size() - i]);
+
+    if (profiler.Enabled())
+      profiler.Stop(network.size() - i, "backward");
   }
 }
 
+template<typename OutputLayerType, typename InitializationRuleType,
+         typename... CustomLayers>
+void FFN<OutputLayerType, InitializationRuleType,
+         CustomLayers...>::ProfileSummary(std::ostream& os)
+{
+  std::vector<std::string> names(network.size());
+  LayerNameVisitor layerNameVisitor;
+  for (size_t i = 0; i < network.size(); ++i)
+    names[i] = boost::apply_visitor(layerNameVisitor, network[i]);
+
+  profiler.Summary(os, names);
+}
+
 template<typename OutputLayerType, typename InitializationRuleType,
          typename... CustomLayers>
 template<typename InputType>
 void FFN<OutputLayerType, InitializationRuleType,
          CustomLayers...>::Gradient(const InputType& input)
 {
-  boost::apply_visitor(GradientVisitor(input,
-      boost::apply_visitor(deltaVisitor, network[1])), network.front());
+  GradientLayer(0, input, boost::apply_visitor(deltaVisitor, network[1]));
 
   for (size_t i = 1; i < network.size() - 1; ++i)
   {
@@ -596,6 +1076,22 @@ void FFN<OutputLayerType, InitializationRuleType, CustomLayers...>::serialize(
 
     deterministic = true;
     ResetDeterministic();
+
+    // A compiled inference plan refers to the old layer objects, and any
+    // worker copies were made from them too.
+    compiled = false;
+    compiledForward.clear();
+    compiledOutputs.clear();
+
+    // Likewise, any planned workspace belonged to the old layer objects.
+    activationArena.reset();
+    workspaceRows = 0;
+    workspaceCols = 0;
+    workspaceInferenceOnly = false;
+
+    for (size_t i = 0; i < parallelNetworks.size(); ++i)
+      delete parallelNetworks[i];
+    parallelNetworks.clear();
   }
 }
 
@@ -620,6 +1116,15 @@ void FFN<OutputLayerType, InitializationRuleType,
   std::swap(inputParameter, network.inputParameter);
   std::swap(outputParameter, network.outputParameter);
   std::swap(gradient, network.gradient);
+  std::swap(compiled, network.compiled);
+  std::swap(compiledForward, network.compiledForward);
+  std::swap(compiledOutputs, network.compiledOutputs);
+  std::swap(activationArena, network.activationArena);
+  std::swap(workspaceRows, network.workspaceRows);
+  std::swap(workspaceCols, network.workspaceCols);
+  std::swap(workspaceInferenceOnly, network.workspaceInferenceOnly);
+  std::swap(parallelism, network.parallelism);
+  std::swap(parallelNetworks, network.parallelNetworks);
 };
 
 template<typename OutputLayerType, typename InitializationRuleType,
@@ -640,7 +1145,15 @@ FFN<OutputLayerType, InitializationRuleType, CustomLayers...>::FFN(
     delta(network.delta),
     inputParameter(network.inputParameter),
     outputParameter(network.outputParameter),
-    gradient(network.gradient)
+    gradient(network.gradient),
+    compiled(false),
+    workspaceRows(0),
+    workspaceCols(0),
+    workspaceInferenceOnly(false),
+    parallelism(network.parallelism),
+    // Profiling state is deliberately not copied; worker copies of the
+    // network would otherwise double-start the shared named timers.
+    profiler("ffn")
 {
   // Build new layers according to source network
   for (size_t i = 0; i < network.network.size(); ++i)
@@ -668,9 +1181,20 @@ FFN<OutputLayerType, InitializationRuleType, CustomLayers...>::FFN(
     delta(std::move(network.delta)),
     inputParameter(std::move(network.inputParameter)),
     outputParameter(std::move(network.outputParameter)),
-    gradient(std::move(network.gradient))
+    gradient(std::move(network.gradient)),
+    compiled(network.compiled),
+    compiledForward(std::move(network.compiledForward)),
+    compiledOutputs(std::move(network.compiledOutputs)),
+    activationArena(std::move(network.activationArena)),
+    workspaceRows(network.workspaceRows),
+    workspaceCols(network.workspaceCols),
+    workspaceInferenceOnly(network.workspaceInferenceOnly),
+    parallelism(network.parallelism),
+    profiler("ffn"),
+    parallelNetworks(std::move(network.parallelNetworks))
 {
   this->network = std::move(network.network);
+  network.compiled = false;
 };
 
 template<typename OutputLayerType, typename InitializationRuleType,
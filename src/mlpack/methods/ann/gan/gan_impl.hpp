@@ -267,12 +267,12 @@ GAN<Model, InitializationRuleType, Noise, PolicyType>::Evaluate(
   noise.imbue( [&]() { return noiseFunction();} );
   generator.Forward(noise);
 
-  predictors.cols(numFunctions, numFunctions + batchSize - 1) =
-      boost::apply_visitor(outputParameterVisitor, generator.network.back());
-  discriminator.Forward(predictors.cols(numFunctions,
-      numFunctions + batchSize - 1));
-  responses.cols(numFunctions, numFunctions + batchSize - 1) =
-      arma::zeros(1, batchSize);
+  // Feed the generator's forward output directly to the discriminator; the
+  // copy into the shared predictor columns is only needed when gradients are
+  // computed.
+  discriminator.Forward(boost::apply_visitor(outputParameterVisitor,
+      generator.network.back()));
+  responses.cols(numFunctions, numFunctions + batchSize - 1).zeros();
 
   currentTarget = arma::mat(responses.memptr() + numFunctions,
       1, batchSize, false, false);
@@ -343,8 +343,7 @@ EvaluateWithGradient(const arma::mat& /* parameters */,
   generator.Forward(noise);
   predictors.cols(numFunctions, numFunctions + batchSize - 1) =
       boost::apply_visitor(outputParameterVisitor, generator.network.back());
-  responses.cols(numFunctions, numFunctions + batchSize - 1) =
-      arma::zeros(1, batchSize);
+  responses.cols(numFunctions, numFunctions + batchSize - 1).zeros();
 
   // Get the gradients of the Generator.
   res += discriminator.EvaluateWithGradient(discriminator.parameter,
@@ -355,8 +354,7 @@ EvaluateWithGradient(const arma::mat& /* parameters */,
   {
     // Minimize -log(D(G(noise))).
     // Pass the error from Discriminator to Generator.
-    responses.cols(numFunctions, numFunctions + batchSize - 1) =
-        arma::ones(1, batchSize);
+    responses.cols(numFunctions, numFunctions + batchSize - 1).ones();
 
     discriminator.outputLayer.Backward(
         boost::apply_visitor(outputParameterVisitor,
@@ -367,10 +365,12 @@ EvaluateWithGradient(const arma::mat& /* parameters */,
     generator.error = boost::apply_visitor(deltaVisitor,
         discriminator.network[1]);
 
-    generator.Predictors() = noise;
+    // The generator's activations from the forward pass above are still in
+    // place, so backpropagate and compute the gradient directly against the
+    // noise batch instead of copying it into the generator's predictors.
     generator.Backward();
     generator.ResetGradients(gradientGenerator);
-    generator.Gradient(generator.Predictors().cols(0, batchSize - 1));
+    generator.Gradient(noise);
 
     gradientGenerator *= multiplier;
   }
@@ -27,6 +27,9 @@
 #include <mlpack/methods/ann/activation_functions/elliot_function.hpp>
 #include <mlpack/methods/ann/activation_functions/elish_function.hpp>
 #include <mlpack/methods/ann/activation_functions/gaussian_function.hpp>
+#include <mlpack/methods/ann/activation_functions/fast_logistic_function.hpp>
+#include <mlpack/methods/ann/activation_functions/fast_tanh_function.hpp>
+#include <mlpack/methods/ann/activation_functions/fast_softplus_function.hpp>
 
 namespace mlpack {
 namespace ann /** Artificial Neural Network. */ {
@@ -50,6 +53,9 @@ namespace ann /** Artificial Neural Network. */ {
  *  - ELiSHLayer
  *  - ElliotLayer
  *  - GaussianLayer
+ *  - FastSigmoidLayer
+ *  - FastTanHLayer
+ *  - FastSoftPlusLayer
  *
  * @tparam ActivationFunction Activation function used for the embedding layer.
  * @tparam InputDataType Type of the input data (arma::colvec, arma::mat,
@@ -277,6 +283,44 @@ template <
 using GaussianFunctionLayer = BaseLayer<
     ActivationFunction, InputDataType, OutputDataType>;
 
+/**
+ * Sigmoid-Layer using the approximated (vectorizable) logistic function; a
+ * drop-in replacement for SigmoidLayer where activation throughput matters
+ * more than the last decimals.  See FastLogisticFunction for the accuracy
+ * parameter.
+ */
+template <
+    class ActivationFunction = FastLogisticFunction<>,
+    typename InputDataType = arma::mat,
+    typename OutputDataType = arma::mat
+>
+using FastSigmoidLayer = BaseLayer<
+    ActivationFunction, InputDataType, OutputDataType>;
+
+/**
+ * Hyperbolic tangent layer using the approximated (vectorizable) tanh
+ * function; a drop-in replacement for TanHLayer.
+ */
+template <
+    class ActivationFunction = FastTanhFunction<>,
+    typename InputDataType = arma::mat,
+    typename OutputDataType = arma::mat
+>
+using FastTanHLayer = BaseLayer<
+    ActivationFunction, InputDataType, OutputDataType>;
+
+/**
+ * Softplus-Layer using the approximated softplus function; a drop-in
+ * replacement for SoftPlusLayer.
+ */
+template <
+    class ActivationFunction = FastSoftplusFunction<>,
+    typename InputDataType = arma::mat,
+    typename OutputDataType = arma::mat
+>
+using FastSoftPlusLayer = BaseLayer<
+    ActivationFunction, InputDataType, OutputDataType>;
+
 } // namespace ann
 } // namespace mlpack
 
@@ -128,45 +128,50 @@ void FastLSTM<InputDataType, OutputDataType>::Forward(
       forwardStep, forwardStep + batchStep);
   gate.cols(forwardStep, forwardStep + batchStep).each_col() += input2GateBias;
 
-  arma::subview<double> sigmoidOut = gateActivation.cols(forwardStep,
-      forwardStep + batchStep);
-  FastSigmoid(
-      gate.submat(0, forwardStep, 3 * outSize - 1, forwardStep + batchStep),
-      sigmoidOut);
-
-  stateActivation.cols(forwardStep, forwardStep + batchStep) = arma::tanh(
-      gate.submat(3 * outSize, forwardStep, 4 * outSize - 1,
-      forwardStep + batchStep));
-
-  // Update the cell: cmul1 + cmul2
-  // where cmul1 is input gate * hidden state and
-  // cmul2 is forget gate * cell (prevCell).
-  if (forwardStep == 0)
+  // The four gate projections are already batched into the single GEMM above
+  // (the gate weights are stored concatenated); here the gate nonlinearities,
+  // the cell update and the output computation are fused into one pass over
+  // the state, so every value is touched once instead of once per
+  // element-wise operation.
+  const bool firstStep = (forwardStep == 0);
+  for (size_t c = 0; c <= batchStep; ++c)
   {
-    cell.cols(forwardStep, forwardStep + batchStep) =
-        gateActivation.submat(0, forwardStep, outSize - 1,
-        forwardStep + batchStep) %
-        stateActivation.cols(forwardStep, forwardStep + batchStep);
-  }
-  else
-  {
-    cell.cols(forwardStep, forwardStep + batchStep) =
-        gateActivation.submat(0, forwardStep, outSize - 1,
-        forwardStep + batchStep) %
-        stateActivation.cols(forwardStep, forwardStep + batchStep) +
-        gateActivation.submat(2 * outSize, forwardStep, 3 * outSize - 1,
-        forwardStep + batchStep) %
-        cell.cols(forwardStep - batchSize, forwardStep - batchSize + batchStep);
+    const ElemType* gatePtr = gate.colptr(forwardStep + c);
+    ElemType* gateActPtr = gateActivation.colptr(forwardStep + c);
+    ElemType* stateActPtr = stateActivation.colptr(forwardStep + c);
+    ElemType* cellPtr = cell.colptr(forwardStep + c);
+    const ElemType* prevCellPtr = firstStep ? NULL :
+        cell.colptr(forwardStep - batchSize + c);
+    ElemType* cellActPtr = cellActivation.colptr(forwardStep + c);
+    ElemType* outPtr = outParameter.colptr(forwardStep + batchSize + c);
+
+    for (size_t k = 0; k < outSize; ++k)
+    {
+      const ElemType inGate = FastSigmoid(gatePtr[k]);
+      const ElemType outGate = FastSigmoid(gatePtr[outSize + k]);
+      const ElemType forgetGate = FastSigmoid(gatePtr[2 * outSize + k]);
+      const ElemType state = std::tanh(gatePtr[3 * outSize + k]);
+
+      // The activations are kept for the backward and gradient pass.
+      gateActPtr[k] = inGate;
+      gateActPtr[outSize + k] = outGate;
+      gateActPtr[2 * outSize + k] = forgetGate;
+      stateActPtr[k] = state;
+
+      // Update the cell: cmul1 + cmul2
+      // where cmul1 is input gate * hidden state and
+      // cmul2 is forget gate * cell (prevCell).
+      ElemType cellValue = inGate * state;
+      if (!firstStep)
+        cellValue += forgetGate * prevCellPtr[k];
+      cellPtr[k] = cellValue;
+
+      const ElemType cellAct = std::tanh(cellValue);
+      cellActPtr[k] = cellAct;
+      outPtr[k] = cellAct * outGate;
+    }
   }
 
-  cellActivation.cols(forwardStep, forwardStep + batchStep) =
-      arma::tanh(cell.cols(forwardStep, forwardStep + batchStep));
-
-  outParameter.cols(forwardStep + batchSize,
-      forwardStep + batchSize + batchStep) = cellActivation.cols(
-      forwardStep, forwardStep + batchStep) % gateActivation.submat(
-      outSize, forwardStep, 2 * outSize - 1, forwardStep + batchStep);
-
   output = OutputType(outParameter.memptr() +
       (forwardStep + batchSize) * outSize, outSize, batchSize, false, false);
 
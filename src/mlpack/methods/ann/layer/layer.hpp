@@ -55,6 +55,7 @@
 #include "noisylinear.hpp"
 #include "padding.hpp"
 #include "parametric_relu.hpp"
+#include "quantized_linear.hpp"
 #include "recurrent_attention.hpp"
 #include "recurrent.hpp"
 #include "reinforce_normal.hpp"
@@ -63,6 +64,7 @@
 #include "sequential.hpp"
 #include "softshrink.hpp"
 #include "softmax.hpp"
+#include "sparse_embedding.hpp"
 #include "subview.hpp"
 #include "transposed_convolution.hpp"
 #include "virtual_batch_norm.hpp"
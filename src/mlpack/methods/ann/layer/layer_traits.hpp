@@ -55,6 +55,10 @@ class LayerTraits
   static const bool IsConnection = false;
 };
 
+// This gives us a HasForwardCheck<T, U> type (where U is a function pointer)
+// we can use with SFINAE to catch when a type has a Forward(...) function.
+HAS_MEM_FUNC(Forward, HasForwardCheck);
+
 // This gives us a HasGradientCheck<T, U> type (where U is a function pointer)
 // we can use with SFINAE to catch when a type has a Gradient(...) function.
 HAS_MEM_FUNC(Gradient, HasGradientCheck);
@@ -120,6 +124,11 @@ HAS_MEM_FUNC(Bias, HasBiasCheck);
 // we can use with SFINAE to catch when a type has a MaxIterations() function.
 HAS_MEM_FUNC(MaxIterations, HasMaxIterations);
 
+// This gives us a HasOptimizeForInferenceCheck<T, U> type (where U is a
+// function pointer) we can use with SFINAE to catch when a type has an
+// OptimizeForInference() function.
+HAS_MEM_FUNC(OptimizeForInference, HasOptimizeForInferenceCheck);
+
 } // namespace ann
 } // namespace mlpack
 
@@ -57,6 +57,16 @@ class Linear
    */
   void Reset();
 
+  /**
+   * Repack the weights into their inference layout: the weight matrix and
+   * bias are copied out of the network-wide parameter matrix into a
+   * dedicated, freshly aligned allocation of this layer, so the serving
+   * working set is compact and independent of the training buffers.  The
+   * packed copy is a snapshot; training the network or calling Reset()
+   * re-attaches the layer to the shared parameter matrix.
+   */
+  void OptimizeForInference();
+
   /**
    * Ordinary feed forward pass of a neural network, evaluating the function
    * f(x) by propagating the activity forward through f.
@@ -67,6 +77,18 @@ class Linear
   template<typename eT>
   void Forward(const arma::Mat<eT>& input, arma::Mat<eT>& output);
 
+  /**
+   * Ordinary feed forward pass of a neural network with sparse input,
+   * accumulating only the weight columns that match nonzero input entries.
+   * For one-hot or multi-hot encoded features this turns the dense
+   * multiplication into a cheap gather.
+   *
+   * @param input Sparse input data used for evaluating the specified function.
+   * @param output Resulting output activation.
+   */
+  template<typename eT>
+  void Forward(const arma::SpMat<eT>& input, arma::Mat<eT>& output);
+
   /**
    * Ordinary feed backward pass of a neural network, calculating the function
    * f(x) by propagating x backwards trough f. Using the results from the feed
@@ -93,6 +115,19 @@ class Linear
                 const arma::Mat<eT>& error,
                 arma::Mat<eT>& gradient);
 
+  /*
+   * Calculate the gradient for sparse input, scattering the error into the
+   * weight gradient over the nonzero input entries only.
+   *
+   * @param input The sparse input parameter used for calculating the gradient.
+   * @param error The calculated error.
+   * @param gradient The calculated gradient.
+   */
+  template<typename eT>
+  void Gradient(const arma::SpMat<eT>& input,
+                const arma::Mat<eT>& error,
+                arma::Mat<eT>& gradient);
+
   //! Get the parameters.
   OutputDataType const& Parameters() const { return weights; }
   //! Modify the parameters.
@@ -125,7 +160,7 @@ class Linear
   OutputDataType& Gradient() { return gradient; }
 
   //! Modify the bias weights of the layer.
-  arma::mat& Bias() { return bias; }
+  OutputDataType& Bias() { return bias; }
 
   /**
    * Serialize the layer
@@ -149,6 +184,10 @@ class Linear
   //! Locally-stored bias term parameters.
   OutputDataType bias;
 
+  //! Locally-owned packed copy of the weights used for inference; empty
+  //! until OptimizeForInference() is called.
+  OutputDataType packedWeights;
+
   //! Locally-stored delta object.
   OutputDataType delta;
 
@@ -45,8 +45,23 @@ template<typename InputDataType, typename OutputDataType,
     typename RegularizerType>
 void Linear<InputDataType, OutputDataType, RegularizerType>::Reset()
 {
-  weight = arma::mat(weights.memptr(), outSize, inSize, false, false);
-  bias = arma::mat(weights.memptr() + weight.n_elem,
+  weight = OutputDataType(weights.memptr(), outSize, inSize, false, false);
+  bias = OutputDataType(weights.memptr() + weight.n_elem,
+      outSize, 1, false, false);
+}
+
+template<typename InputDataType, typename OutputDataType,
+    typename RegularizerType>
+void Linear<InputDataType, OutputDataType,
+    RegularizerType>::OptimizeForInference()
+{
+  // Snapshot the weights into a dedicated allocation and re-alias the weight
+  // matrix and bias into it, detaching the forward pass from the shared
+  // parameter matrix.
+  packedWeights = OutputDataType(weights);
+  weight = OutputDataType(packedWeights.memptr(), outSize, inSize, false,
+      false);
+  bias = OutputDataType(packedWeights.memptr() + weight.n_elem,
       outSize, 1, false, false);
 }
 
@@ -60,6 +75,23 @@ void Linear<InputDataType, OutputDataType, RegularizerType>::Forward(
   output.each_col() += bias;
 }
 
+template<typename InputDataType, typename OutputDataType,
+    typename RegularizerType>
+template<typename eT>
+void Linear<InputDataType, OutputDataType, RegularizerType>::Forward(
+    const arma::SpMat<eT>& input, arma::Mat<eT>& output)
+{
+  // Only the weight columns matching nonzero input entries contribute, so
+  // gather those instead of multiplying over all the zeros.
+  output.zeros(outSize, input.n_cols);
+  for (typename arma::SpMat<eT>::const_iterator it = input.begin();
+      it != input.end(); ++it)
+  {
+    output.col(it.col()) += (*it) * weight.col(it.row());
+  }
+  output.each_col() += bias;
+}
+
 template<typename InputDataType, typename OutputDataType,
     typename RegularizerType>
 template<typename eT>
@@ -84,6 +116,29 @@ void Linear<InputDataType, OutputDataType, RegularizerType>::Gradient(
   regularizer.Evaluate(weights, gradient);
 }
 
+template<typename InputDataType, typename OutputDataType,
+    typename RegularizerType>
+template<typename eT>
+void Linear<InputDataType, OutputDataType, RegularizerType>::Gradient(
+    const arma::SpMat<eT>& input,
+    const arma::Mat<eT>& error,
+    arma::Mat<eT>& gradient)
+{
+  // Scatter the outer product over the nonzero input entries only; each
+  // nonzero entry contributes its scaled error column to one weight column.
+  gradient.submat(0, 0, weight.n_elem - 1, 0).zeros();
+  arma::Mat<eT> weightGradient(gradient.memptr(), outSize, inSize, false,
+      true);
+  for (typename arma::SpMat<eT>::const_iterator it = input.begin();
+      it != input.end(); ++it)
+  {
+    weightGradient.col(it.row()) += (*it) * error.col(it.col());
+  }
+  gradient.submat(weight.n_elem, 0, gradient.n_elem - 1, 0) =
+      arma::sum(error, 1);
+  regularizer.Evaluate(weights, gradient);
+}
+
 template<typename InputDataType, typename OutputDataType,
     typename RegularizerType>
 template<typename Archive>
@@ -56,6 +56,15 @@ class LinearNoBias
    */
   void Reset();
 
+  /**
+   * Repack the weight matrix into its inference layout: it is copied out of
+   * the network-wide parameter matrix into a dedicated, freshly aligned
+   * allocation of this layer.  The packed copy is a snapshot; training the
+   * network or calling Reset() re-attaches the layer to the shared parameter
+   * matrix.
+   */
+  void OptimizeForInference();
+
   /**
    * Ordinary feed forward pass of a neural network, evaluating the function
    * f(x) by propagating the activity forward through f.
@@ -66,6 +75,18 @@ class LinearNoBias
   template<typename eT>
   void Forward(const arma::Mat<eT>& input, arma::Mat<eT>& output);
 
+  /**
+   * Ordinary feed forward pass of a neural network with sparse input,
+   * accumulating only the weight columns that match nonzero input entries.
+   * For one-hot or multi-hot encoded features this turns the dense
+   * multiplication into a cheap gather.
+   *
+   * @param input Sparse input data used for evaluating the specified function.
+   * @param output Resulting output activation.
+   */
+  template<typename eT>
+  void Forward(const arma::SpMat<eT>& input, arma::Mat<eT>& output);
+
   /**
    * Ordinary feed backward pass of a neural network, calculating the function
    * f(x) by propagating x backwards trough f. Using the results from the feed
@@ -92,6 +113,19 @@ class LinearNoBias
                 const arma::Mat<eT>& error,
                 arma::Mat<eT>& gradient);
 
+  /*
+   * Calculate the gradient for sparse input, scattering the error into the
+   * weight gradient over the nonzero input entries only.
+   *
+   * @param input The sparse input parameter used for calculating the gradient.
+   * @param error The calculated error.
+   * @param gradient The calculated gradient.
+   */
+  template<typename eT>
+  void Gradient(const arma::SpMat<eT>& input,
+                const arma::Mat<eT>& error,
+                arma::Mat<eT>& gradient);
+
   //! Get the parameters.
   OutputDataType const& Parameters() const { return weights; }
   //! Modify the parameters.
@@ -142,6 +176,10 @@ class LinearNoBias
   //! Locally-stored weight parameter.
   OutputDataType weight;
 
+  //! Locally-owned packed copy of the weights used for inference; empty
+  //! until OptimizeForInference() is called.
+  OutputDataType packedWeights;
+
   //! Locally-stored delta object.
   OutputDataType delta;
 
@@ -29,23 +29,25 @@ template<typename InputType, typename OutputType>
 void LogSoftMax<InputDataType, OutputDataType>::Forward(
     const InputType& input, OutputType& output)
 {
-  arma::mat maxInput = arma::repmat(arma::max(input), input.n_rows, 1);
+  typedef typename OutputType::elem_type ElemType;
+
+  OutputType maxInput = arma::repmat(arma::max(input), input.n_rows, 1);
   output = (maxInput - input);
 
   // Approximation of the base-e exponential function. The acuracy however is
   // about 0.00001 lower as using exp. Credits go to Leon Bottou.
-  output.transform([](double x)
+  output.transform([](ElemType x)
   {
     //! Fast approximation of exp(-x) for x positive.
-    static constexpr double A0 = 1.0;
-    static constexpr double A1 = 0.125;
-    static constexpr double A2 = 0.0078125;
-    static constexpr double A3 = 0.00032552083;
-    static constexpr double A4 = 1.0172526e-5;
+    static constexpr ElemType A0 = 1.0;
+    static constexpr ElemType A1 = 0.125;
+    static constexpr ElemType A2 = 0.0078125;
+    static constexpr ElemType A3 = 0.00032552083;
+    static constexpr ElemType A4 = 1.0172526e-5;
 
     if (x < 13.0)
     {
-      double y = A0 + x * (A1 + x * (A2 + x * (A3 + x * A4)));
+      ElemType y = A0 + x * (A1 + x * (A2 + x * (A3 + x * A4)));
       y *= y;
       y *= y;
       y *= y;
@@ -54,7 +56,7 @@ void LogSoftMax<InputDataType, OutputDataType>::Forward(
       return y;
     }
 
-    return 0.0;
+    return ElemType(0.0);
   });
 
   maxInput.each_row() += arma::log(arma::sum(output));
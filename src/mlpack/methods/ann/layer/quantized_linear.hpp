@@ -0,0 +1,165 @@
+/**
+ * @file methods/ann/layer/quantized_linear.hpp
+ * @author Marcus Edel
+ *
+ * Definition of the QuantizedLinear layer, an int8 inference-time
+ * replacement for a trained Linear layer.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_ANN_LAYER_QUANTIZED_LINEAR_HPP
+#define MLPACK_METHODS_ANN_LAYER_QUANTIZED_LINEAR_HPP
+
+#include <mlpack/prereqs.hpp>
+
+#include "linear.hpp"
+
+namespace mlpack {
+namespace ann /** Artificial Neural Network. */ {
+
+/**
+ * Implementation of the QuantizedLinear layer, which performs the affine
+ * transformation of a trained Linear layer with weights stored as 8-bit
+ * integers.  The weights are quantized symmetrically per tensor, and the
+ * input scale is calibrated once from sample data, so at inference time the
+ * input is quantized, multiplied in integer arithmetic and the product is
+ * dequantized on output (the bias is applied after dequantization in full
+ * precision).
+ *
+ * Weight storage drops to a quarter of the float32 footprint.  Armadillo has
+ * no 8-bit GEMM kernels, so the integer product is computed through 32-bit
+ * integers; the layer is intended for memory-bound deployments and as the
+ * reference for specialised kernels.
+ *
+ * The layer is inference-only: Backward() propagates the error through the
+ * dequantized weights (straight-through), but the layer exposes no trainable
+ * parameters.  To use it inside an FFN, pass it through the network's
+ * CustomLayers template parameter and build the network from a trained
+ * float model with the converting constructor.
+ *
+ * @tparam InputDataType Type of the input data (arma::colvec, arma::mat,
+ *         arma::sp_mat or arma::cube).
+ * @tparam OutputDataType Type of the output data (arma::colvec, arma::mat,
+ *         arma::sp_mat or arma::cube).
+ */
+template <
+    typename InputDataType = arma::mat,
+    typename OutputDataType = arma::mat
+>
+class QuantizedLinear
+{
+ public:
+  //! Create the QuantizedLinear object.
+  QuantizedLinear();
+
+  /**
+   * Create the QuantizedLinear layer from a trained Linear layer,
+   * calibrating the input quantization scale on the given sample data.
+   *
+   * The weight scale is chosen so that the largest absolute weight maps to
+   * 127; the input scale is chosen the same way over the calibration data,
+   * so the calibration set should cover the activation range seen in
+   * deployment.
+   *
+   * @param layer Trained Linear layer to quantize (Reset() must have been
+   *     called so that the parameters are set).
+   * @param calibrationData Sample inputs used to calibrate the input scale.
+   */
+  template<typename RegularizerType>
+  QuantizedLinear(
+      const Linear<InputDataType, OutputDataType, RegularizerType>& layer,
+      const InputDataType& calibrationData);
+
+  /**
+   * Ordinary feed forward pass of a neural network: quantize the input,
+   * multiply in integer arithmetic and dequantize the result.
+   *
+   * @param input Input data used for evaluating the specified function.
+   * @param output Resulting output activation.
+   */
+  template<typename eT>
+  void Forward(const arma::Mat<eT>& input, arma::Mat<eT>& output);
+
+  /**
+   * Ordinary feed backward pass of a neural network, propagating the error
+   * through the dequantized weights.
+   *
+   * @param * (input) The propagated input activation.
+   * @param gy The backpropagated error.
+   * @param g The calculated gradient.
+   */
+  template<typename eT>
+  void Backward(const arma::Mat<eT>& /* input */,
+                const arma::Mat<eT>& gy,
+                arma::Mat<eT>& g);
+
+  //! Get the output parameter.
+  OutputDataType const& OutputParameter() const { return outputParameter; }
+  //! Modify the output parameter.
+  OutputDataType& OutputParameter() { return outputParameter; }
+
+  //! Get the delta.
+  OutputDataType const& Delta() const { return delta; }
+  //! Modify the delta.
+  OutputDataType& Delta() { return delta; }
+
+  //! Get the input size.
+  size_t InputSize() const { return inSize; }
+
+  //! Get the output size.
+  size_t OutputSize() const { return outSize; }
+
+  //! Get the quantized weight matrix.
+  arma::Mat<arma::s8> const& QuantizedWeight() const
+  {
+    return quantizedWeight;
+  }
+
+  //! Get the weight quantization scale.
+  double WeightScale() const { return weightScale; }
+
+  //! Get the calibrated input quantization scale.
+  double InputScale() const { return inputScale; }
+
+  /**
+   * Serialize the layer
+   */
+  template<typename Archive>
+  void serialize(Archive& ar, const unsigned int /* version */);
+
+ private:
+  //! Locally-stored number of input units.
+  size_t inSize;
+
+  //! Locally-stored number of output units.
+  size_t outSize;
+
+  //! Locally-stored quantized weight parameters.
+  arma::Mat<arma::s8> quantizedWeight;
+
+  //! Locally-stored bias, applied in full precision after dequantization.
+  OutputDataType bias;
+
+  //! Scale mapping float weights to the int8 grid.
+  double weightScale;
+
+  //! Calibrated scale mapping inputs to the int8 grid.
+  double inputScale;
+
+  //! Locally-stored delta object.
+  OutputDataType delta;
+
+  //! Locally-stored output parameter object.
+  OutputDataType outputParameter;
+}; // class QuantizedLinear
+
+} // namespace ann
+} // namespace mlpack
+
+// Include implementation.
+#include "quantized_linear_impl.hpp"
+
+#endif
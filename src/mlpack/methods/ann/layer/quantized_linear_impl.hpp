@@ -0,0 +1,112 @@
+/**
+ * @file methods/ann/layer/quantized_linear_impl.hpp
+ * @author Marcus Edel
+ *
+ * Implementation of the QuantizedLinear layer, an int8 inference-time
+ * replacement for a trained Linear layer.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_ANN_LAYER_QUANTIZED_LINEAR_IMPL_HPP
+#define MLPACK_METHODS_ANN_LAYER_QUANTIZED_LINEAR_IMPL_HPP
+
+// In case it hasn't yet been included.
+#include "quantized_linear.hpp"
+
+namespace mlpack {
+namespace ann /** Artificial Neural Network. */ {
+
+template<typename InputDataType, typename OutputDataType>
+QuantizedLinear<InputDataType, OutputDataType>::QuantizedLinear() :
+    inSize(0),
+    outSize(0),
+    weightScale(1.0),
+    inputScale(1.0)
+{
+  // Nothing to do here.
+}
+
+template<typename InputDataType, typename OutputDataType>
+template<typename RegularizerType>
+QuantizedLinear<InputDataType, OutputDataType>::QuantizedLinear(
+    const Linear<InputDataType, OutputDataType, RegularizerType>& layer,
+    const InputDataType& calibrationData) :
+    inSize(layer.InputSize()),
+    outSize(layer.OutputSize())
+{
+  // The Linear parameter vector stores the weight matrix (column-major)
+  // followed by the bias.
+  const OutputDataType weight(
+      const_cast<typename OutputDataType::elem_type*>(
+      layer.Parameters().memptr()), outSize, inSize, false, false);
+  bias = OutputDataType(
+      const_cast<typename OutputDataType::elem_type*>(
+      layer.Parameters().memptr()) + outSize * inSize, outSize, 1, true);
+
+  // Symmetric per-tensor quantization: the largest absolute value maps to
+  // 127, so no zero point is needed.
+  const double weightMax = arma::abs(weight).max();
+  weightScale = (weightMax > 0.0) ? 127.0 / weightMax : 1.0;
+  quantizedWeight = arma::conv_to<arma::Mat<arma::s8>>::from(
+      arma::clamp(arma::round(weightScale * weight), -127.0, 127.0));
+
+  const double inputMax = calibrationData.is_empty() ? 0.0 :
+      double(arma::abs(calibrationData).max());
+  inputScale = (inputMax > 0.0) ? 127.0 / inputMax : 1.0;
+}
+
+template<typename InputDataType, typename OutputDataType>
+template<typename eT>
+void QuantizedLinear<InputDataType, OutputDataType>::Forward(
+    const arma::Mat<eT>& input, arma::Mat<eT>& output)
+{
+  // Quantize the input with the calibrated scale; values outside the
+  // calibration range saturate at the edges of the int8 grid.
+  const arma::Mat<arma::s8> quantizedInput =
+      arma::conv_to<arma::Mat<arma::s8>>::from(
+      arma::clamp(arma::round(inputScale * input), eT(-127), eT(127)));
+
+  // Accumulate the product in 32-bit integers; Armadillo provides no 8-bit
+  // GEMM kernels and the products would overflow 8 bits anyway.
+  const arma::Mat<arma::s32> product =
+      arma::conv_to<arma::Mat<arma::s32>>::from(quantizedWeight) *
+      arma::conv_to<arma::Mat<arma::s32>>::from(quantizedInput);
+
+  // Dequantize on output and apply the bias in full precision.
+  output = arma::conv_to<arma::Mat<eT>>::from(product) /
+      eT(weightScale * inputScale);
+  output.each_col() += bias;
+}
+
+template<typename InputDataType, typename OutputDataType>
+template<typename eT>
+void QuantizedLinear<InputDataType, OutputDataType>::Backward(
+    const arma::Mat<eT>& /* input */,
+    const arma::Mat<eT>& gy,
+    arma::Mat<eT>& g)
+{
+  // Straight-through: propagate the error through the dequantized weights.
+  g = (arma::conv_to<arma::Mat<eT>>::from(quantizedWeight).t() * gy) /
+      eT(weightScale);
+}
+
+template<typename InputDataType, typename OutputDataType>
+template<typename Archive>
+void QuantizedLinear<InputDataType, OutputDataType>::serialize(
+    Archive& ar, const unsigned int /* version */)
+{
+  ar & BOOST_SERIALIZATION_NVP(inSize);
+  ar & BOOST_SERIALIZATION_NVP(outSize);
+  ar & BOOST_SERIALIZATION_NVP(quantizedWeight);
+  ar & BOOST_SERIALIZATION_NVP(bias);
+  ar & BOOST_SERIALIZATION_NVP(weightScale);
+  ar & BOOST_SERIALIZATION_NVP(inputScale);
+}
+
+} // namespace ann
+} // namespace mlpack
+
+#endif
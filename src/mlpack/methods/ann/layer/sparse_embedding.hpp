@@ -0,0 +1,158 @@
+/**
+ * @file methods/ann/layer/sparse_embedding.hpp
+ * @author Marcus Edel
+ *
+ * Definition of the SparseEmbedding class, an embedding table lookup with
+ * sparse gradient accumulation by index.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_ANN_LAYER_SPARSE_EMBEDDING_HPP
+#define MLPACK_METHODS_ANN_LAYER_SPARSE_EMBEDDING_HPP
+
+#include <mlpack/prereqs.hpp>
+#include <mlpack/methods/ann/layer/layer_traits.hpp>
+
+namespace mlpack {
+namespace ann /** Artificial Neural Network. */ {
+
+/**
+ * Implementation of the SparseEmbedding class.  Like Lookup, the forward pass
+ * gathers one embedding column per input index; unlike Lookup, the backward
+ * pass does not materialize a gradient the size of the whole table.  Instead
+ * it accumulates one summed update per embedding actually touched by the
+ * batch, available as an index list (TouchedIndices()) with the matching
+ * update columns (TouchedGradients()), and ApplyGradient() scatters those
+ * updates into the table in place.  For large vocabularies this avoids
+ * writing a mostly-zero gradient matrix every step.
+ *
+ * Because the updates are applied in place, the embedding table is owned by
+ * the layer itself and is not part of the network parameter; the table is
+ * initialized by the layer and trained through ApplyGradient() from the
+ * training loop, while the optimizer only sees the dense layers.
+ *
+ * @tparam InputDataType Type of the input data (arma::colvec, arma::mat,
+ *         arma::sp_mat or arma::cube).
+ * @tparam OutputDataType Type of the output data (arma::colvec, arma::mat,
+ *         arma::sp_mat or arma::cube).
+ */
+template <
+    typename InputDataType = arma::mat,
+    typename OutputDataType = arma::mat
+>
+class SparseEmbedding
+{
+ public:
+  /**
+   * Create the SparseEmbedding object using the specified vocabulary size and
+   * embedding dimension.  The table is initialized with small random values.
+   *
+   * @param inSize The number of embeddings (vocabulary size).
+   * @param outSize The dimension of each embedding.
+   */
+  SparseEmbedding(const size_t inSize = 0, const size_t outSize = 0);
+
+  /**
+   * Ordinary feed forward pass of a neural network, gathering the embedding
+   * column of each (one-based) input index.
+   *
+   * @param input Input data used for evaluating the specified function.
+   * @param output Resulting output activation.
+   */
+  template<typename eT>
+  void Forward(const arma::Mat<eT>& input, arma::Mat<eT>& output);
+
+  /**
+   * Ordinary feed backward pass of a neural network.  The error columns are
+   * accumulated by embedding index, so repeated indices within the batch
+   * share one summed update; only the touched embeddings are recorded.
+   *
+   * @param * (input) The propagated input activation.
+   * @param gy The backpropagated error.
+   * @param g The calculated gradient.
+   */
+  template<typename eT>
+  void Backward(const arma::Mat<eT>& /* input */,
+                const arma::Mat<eT>& gy,
+                arma::Mat<eT>& g);
+
+  /**
+   * Apply the accumulated sparse gradient to the embedding table in place and
+   * clear the accumulated updates.  Only the touched columns are written.
+   *
+   * @param stepSize Step size for the update.
+   */
+  void ApplyGradient(const double stepSize);
+
+  //! Get the embedding table.
+  OutputDataType const& Weights() const { return weights; }
+  //! Modify the embedding table.
+  OutputDataType& Weights() { return weights; }
+
+  //! Get the indices of the embeddings touched by the last backward pass.
+  const arma::uvec& TouchedIndices() const { return touchedIndices; }
+
+  //! Get the accumulated updates of the touched embeddings, one column per
+  //! entry of TouchedIndices().
+  OutputDataType const& TouchedGradients() const { return touchedGradients; }
+
+  //! Get the output parameter.
+  OutputDataType const& OutputParameter() const { return outputParameter; }
+  //! Modify the output parameter.
+  OutputDataType& OutputParameter() { return outputParameter; }
+
+  //! Get the delta.
+  OutputDataType const& Delta() const { return delta; }
+  //! Modify the delta.
+  OutputDataType& Delta() { return delta; }
+
+  //! Get the number of embeddings.
+  size_t InSize() const { return inSize; }
+
+  //! Get the embedding dimension.
+  size_t OutSize() const { return outSize; }
+
+  /**
+   * Serialize the layer
+   */
+  template<typename Archive>
+  void serialize(Archive& ar, const unsigned int /* version */);
+
+ private:
+  //! Locally-stored number of embeddings.
+  size_t inSize;
+
+  //! Locally-stored embedding dimension.
+  size_t outSize;
+
+  //! Locally-stored embedding table; owned by the layer and updated in
+  //! place, so it is not part of the network parameter.
+  OutputDataType weights;
+
+  //! Locally-stored (zero-based) indices gathered by the last forward pass.
+  arma::uvec inputIndices;
+
+  //! Locally-stored indices of the embeddings touched by the last backward
+  //! pass.
+  arma::uvec touchedIndices;
+
+  //! Locally-stored accumulated updates of the touched embeddings.
+  OutputDataType touchedGradients;
+
+  //! Locally-stored delta object.
+  OutputDataType delta;
+
+  //! Locally-stored output parameter object.
+  OutputDataType outputParameter;
+}; // class SparseEmbedding
+
+} // namespace ann
+} // namespace mlpack
+
+// Include implementation.
+#include "sparse_embedding_impl.hpp"
+
+#endif
@@ -0,0 +1,100 @@
+/**
+ * @file methods/ann/layer/sparse_embedding_impl.hpp
+ * @author Marcus Edel
+ *
+ * Implementation of the SparseEmbedding class, an embedding table lookup with
+ * sparse gradient accumulation by index.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_ANN_LAYER_SPARSE_EMBEDDING_IMPL_HPP
+#define MLPACK_METHODS_ANN_LAYER_SPARSE_EMBEDDING_IMPL_HPP
+
+// In case it hasn't yet been included.
+#include "sparse_embedding.hpp"
+
+namespace mlpack {
+namespace ann /** Artificial Neural Network. */ {
+
+template<typename InputDataType, typename OutputDataType>
+SparseEmbedding<InputDataType, OutputDataType>::SparseEmbedding(
+    const size_t inSize,
+    const size_t outSize) :
+    inSize(inSize),
+    outSize(outSize)
+{
+  // The table is not part of the network parameter, so initialize it here.
+  weights = 0.01 * arma::randn<OutputDataType>(outSize, inSize);
+}
+
+template<typename InputDataType, typename OutputDataType>
+template<typename eT>
+void SparseEmbedding<InputDataType, OutputDataType>::Forward(
+    const arma::Mat<eT>& input, arma::Mat<eT>& output)
+{
+  inputIndices = arma::conv_to<arma::uvec>::from(input) - 1;
+  output = weights.cols(inputIndices);
+}
+
+template<typename InputDataType, typename OutputDataType>
+template<typename eT>
+void SparseEmbedding<InputDataType, OutputDataType>::Backward(
+    const arma::Mat<eT>& /* input */,
+    const arma::Mat<eT>& gy,
+    arma::Mat<eT>& g)
+{
+  // Assign one update slot per distinct index of the last forward pass.
+  std::map<arma::uword, arma::uword> slots;
+  for (size_t i = 0; i < inputIndices.n_elem; ++i)
+  {
+    if (slots.count(inputIndices(i)) == 0)
+    {
+      const arma::uword slot = slots.size();
+      slots[inputIndices(i)] = slot;
+    }
+  }
+
+  touchedIndices.set_size(slots.size());
+  for (std::map<arma::uword, arma::uword>::const_iterator it = slots.begin();
+      it != slots.end(); ++it)
+  {
+    touchedIndices(it->second) = it->first;
+  }
+
+  // Accumulate the error columns by slot; repeated indices within the batch
+  // sum into the same update column.
+  touchedGradients.zeros(outSize, slots.size());
+  for (size_t i = 0; i < inputIndices.n_elem; ++i)
+    touchedGradients.col(slots[inputIndices(i)]) += gy.col(i);
+
+  g = gy;
+}
+
+template<typename InputDataType, typename OutputDataType>
+void SparseEmbedding<InputDataType, OutputDataType>::ApplyGradient(
+    const double stepSize)
+{
+  for (size_t i = 0; i < touchedIndices.n_elem; ++i)
+    weights.col(touchedIndices(i)) -= stepSize * touchedGradients.col(i);
+
+  touchedIndices.clear();
+  touchedGradients.clear();
+}
+
+template<typename InputDataType, typename OutputDataType>
+template<typename Archive>
+void SparseEmbedding<InputDataType, OutputDataType>::serialize(
+    Archive& ar, const unsigned int /* version */)
+{
+  ar & BOOST_SERIALIZATION_NVP(inSize);
+  ar & BOOST_SERIALIZATION_NVP(outSize);
+  ar & BOOST_SERIALIZATION_NVP(weights);
+}
+
+} // namespace ann
+} // namespace mlpack
+
+#endif
@@ -0,0 +1,163 @@
+/**
+ * @file methods/ann/layer_profiler.hpp
+ * @author Marcus Edel
+ *
+ * Definition of the LayerProfiler class, opt-in per-layer instrumentation for
+ * the FFN and RNN classes.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_ANN_LAYER_PROFILER_HPP
+#define MLPACK_METHODS_ANN_LAYER_PROFILER_HPP
+
+#include <mlpack/prereqs.hpp>
+#include <mlpack/core/util/timers.hpp>
+
+#include <iomanip>
+
+namespace mlpack {
+namespace ann /** Artificial Neural Network. */ {
+
+/**
+ * Opt-in per-layer instrumentation for the network classes.  When enabled,
+ * the network wraps every per-layer forward and backward dispatch in a named
+ * timer of the existing Timer infrastructure ("<prefix>_layer_<i>_forward"
+ * and "<prefix>_layer_<i>_backward"), and records the data volume and an
+ * estimated FLOP count of every forward dispatch.  Summary() prints the
+ * recorded statistics as a per-layer table.
+ *
+ * The wall times are collected by the global Timer class and therefore only
+ * accumulate while timing is enabled (Timer::EnableTiming()); the byte and
+ * FLOP counters are collected by the profiler itself.  Profiling is disabled
+ * by default and adds a single branch per layer dispatch when off.
+ */
+class LayerProfiler
+{
+ public:
+  /**
+   * Create the LayerProfiler object; profiling starts disabled.
+   *
+   * @param prefix Prefix of the timer names used for the per-layer timers.
+   */
+  LayerProfiler(const std::string& prefix = "network") :
+      enabled(false),
+      prefix(prefix)
+  {
+    /* Nothing to do here. */
+  }
+
+  //! Get whether profiling is enabled.
+  bool Enabled() const { return enabled; }
+  //! Modify whether profiling is enabled.
+  bool& Enabled() { return enabled; }
+
+  //! Get the timer name of the given layer and pass (e.g. "forward").
+  std::string TimerName(const size_t index, const std::string& pass) const
+  {
+    return prefix + "_layer_" + std::to_string(index) + "_" + pass;
+  }
+
+  //! Start the timer of the given layer and pass.
+  void Start(const size_t index, const std::string& pass) const
+  {
+    Timer::Start(TimerName(index, pass));
+  }
+
+  //! Stop the timer of the given layer and pass.
+  void Stop(const size_t index, const std::string& pass) const
+  {
+    Timer::Stop(TimerName(index, pass));
+  }
+
+  /**
+   * Record the data volume and estimated FLOPs of one forward dispatch of
+   * the given layer.  The estimate charges one multiply-add per weight and
+   * batch point plus one operation per output element, which is exact for
+   * the linear layers and a reasonable floor for the rest.
+   *
+   * @param index Index of the layer.
+   * @param inputElems Number of elements of the layer input.
+   * @param outputElems Number of elements of the layer output.
+   * @param weightElems Number of trainable parameters of the layer.
+   * @param batchSize Number of points in the batch.
+   */
+  void Add(const size_t index,
+           const size_t inputElems,
+           const size_t outputElems,
+           const size_t weightElems,
+           const size_t batchSize)
+  {
+    if (bytesMoved.size() <= index)
+    {
+      bytesMoved.resize(index + 1, 0);
+      flopEstimate.resize(index + 1, 0);
+    }
+
+    bytesMoved[index] += (inputElems + outputElems) * sizeof(double);
+    flopEstimate[index] += 2 * weightElems * batchSize + outputElems;
+  }
+
+  //! Clear the recorded byte and FLOP counters.
+  void Clear()
+  {
+    bytesMoved.clear();
+    flopEstimate.clear();
+  }
+
+  /**
+   * Print a per-layer table of the recorded statistics.
+   *
+   * @param os Stream to print the table into.
+   * @param names Name of each layer, one entry per layer.
+   */
+  void Summary(std::ostream& os, const std::vector<std::string>& names) const
+  {
+    os << std::setw(5) << "layer" << "  "
+       << std::setw(20) << std::left << "name" << std::right
+       << std::setw(13) << "forward(us)"
+       << std::setw(14) << "backward(us)"
+       << std::setw(10) << "MB moved"
+       << std::setw(10) << "MFLOP" << std::endl;
+
+    for (size_t i = 0; i < names.size(); ++i)
+    {
+      const double forwardTime =
+          (double) Timer::Get(TimerName(i, "forward")).count();
+      const double backwardTime =
+          (double) Timer::Get(TimerName(i, "backward")).count();
+      const double megabytes =
+          (i < bytesMoved.size()) ? bytesMoved[i] / 1.0e6 : 0.0;
+      const double megaflop =
+          (i < flopEstimate.size()) ? flopEstimate[i] / 1.0e6 : 0.0;
+
+      os << std::setw(5) << i << "  "
+         << std::setw(20) << std::left << names[i] << std::right
+         << std::setw(13) << forwardTime
+         << std::setw(14) << backwardTime
+         << std::setw(10) << std::fixed << std::setprecision(2) << megabytes
+         << std::setw(10) << megaflop << std::endl;
+      os.unsetf(std::ios_base::fixed);
+    }
+  }
+
+ private:
+  //! Whether profiling is enabled.
+  bool enabled;
+
+  //! Prefix of the per-layer timer names.
+  std::string prefix;
+
+  //! Accumulated bytes moved per layer (forward dispatches).
+  std::vector<size_t> bytesMoved;
+
+  //! Accumulated estimated FLOPs per layer (forward dispatches).
+  std::vector<size_t> flopEstimate;
+}; // class LayerProfiler
+
+} // namespace ann
+} // namespace mlpack
+
+#endif
@@ -0,0 +1,134 @@
+/**
+ * @file methods/ann/loss_functions/softmax_cross_entropy.hpp
+ * @author Marcus Edel
+ *
+ * Definition of the SoftmaxCrossEntropy class.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_ANN_LOSS_FUNCTION_SOFTMAX_CROSS_ENTROPY_HPP
+#define MLPACK_METHODS_ANN_LOSS_FUNCTION_SOFTMAX_CROSS_ENTROPY_HPP
+
+#include <mlpack/prereqs.hpp>
+
+namespace mlpack {
+namespace ann /** Artificial Neural Network. */ {
+
+/**
+ * Implementation of the fused softmax cross-entropy output layer.  The layer
+ * takes raw logits as input, so no separate LogSoftMax layer is needed; the
+ * log-normalizer and the loss are computed in one pass over each column, and
+ * the backward pass emits the softmax-minus-one-hot gradient directly.  As
+ * with NegativeLogLikelihood, the target contains one class index per column,
+ * in the range between 1 and the number of classes.
+ *
+ * For very large numbers of classes the loss can additionally be evaluated in
+ * sampled-softmax mode: setting NumSamples() to a nonzero value draws that
+ * many candidate classes (shared by the whole batch) and computes the
+ * normalizer of each column over the drawn classes and the column's target
+ * only.  The loss and gradient then no longer scale with the number of
+ * classes; this is the usual biased constant-size approximation used for
+ * training, so NumSamples() should be left at zero for evaluation.
+ *
+ * @tparam InputDataType Type of the input data (arma::colvec, arma::mat,
+ *         arma::sp_mat or arma::cube).
+ * @tparam OutputDataType Type of the output data (arma::colvec, arma::mat,
+ *         arma::sp_mat or arma::cube).
+ */
+template <
+    typename InputDataType = arma::mat,
+    typename OutputDataType = arma::mat
+>
+class SoftmaxCrossEntropy
+{
+ public:
+  /**
+   * Create the SoftmaxCrossEntropy object.
+   *
+   * @param numSamples Number of candidate classes drawn in sampled-softmax
+   *        mode; zero computes the exact loss over all classes.
+   */
+  SoftmaxCrossEntropy(const size_t numSamples = 0);
+
+  /**
+   * Computes the softmax cross-entropy loss of the given logits.
+   *
+   * @param input Input data used for evaluating the specified function.
+   * @param target The target vector, that contains the class index in the
+   *        range between 1 and the number of classes.
+   */
+  template<typename InputType, typename TargetType>
+  typename InputType::elem_type Forward(const InputType& input,
+                                        const TargetType& target);
+
+  /**
+   * Ordinary feed backward pass of a neural network.  The gradient with
+   * respect to the logits is the softmax of the input minus the one-hot
+   * target; in sampled-softmax mode only the entries of the classes drawn by
+   * the last Forward() call (and the targets) are nonzero.
+   *
+   * @param input The propagated input activation.
+   * @param target The target vector, that contains the class index in the
+   *        range between 1 and the number of classes.
+   * @param output The calculated error.
+   */
+  template<typename InputType, typename TargetType, typename OutputType>
+  void Backward(const InputType& input,
+                const TargetType& target,
+                OutputType& output);
+
+  //! Get the input parameter.
+  InputDataType& InputParameter() const { return inputParameter; }
+  //! Modify the input parameter.
+  InputDataType& InputParameter() { return inputParameter; }
+
+  //! Get the output parameter.
+  OutputDataType& OutputParameter() const { return outputParameter; }
+  //! Modify the output parameter.
+  OutputDataType& OutputParameter() { return outputParameter; }
+
+  //! Get the delta.
+  OutputDataType& Delta() const { return delta; }
+  //! Modify the delta.
+  OutputDataType& Delta() { return delta; }
+
+  //! Get the number of candidate classes of the sampled-softmax mode.
+  size_t NumSamples() const { return numSamples; }
+  //! Modify the number of candidate classes of the sampled-softmax mode.
+  size_t& NumSamples() { return numSamples; }
+
+  /**
+   * Serialize the layer
+   */
+  template<typename Archive>
+  void serialize(Archive& ar, const unsigned int /* version */);
+
+ private:
+  //! Number of candidate classes drawn in sampled-softmax mode; zero
+  //! computes the exact loss.
+  size_t numSamples;
+
+  //! Classes drawn by the last sampled-softmax Forward() call, shared with
+  //! the backward pass.
+  arma::uvec sampledClasses;
+
+  //! Locally-stored delta object.
+  OutputDataType delta;
+
+  //! Locally-stored input parameter object.
+  InputDataType inputParameter;
+
+  //! Locally-stored output parameter object.
+  OutputDataType outputParameter;
+}; // class SoftmaxCrossEntropy
+
+} // namespace ann
+} // namespace mlpack
+
+// Include implementation.
+#include "softmax_cross_entropy_impl.hpp"
+
+#endif
@@ -0,0 +1,157 @@
+/**
+ * @file methods/ann/loss_functions/softmax_cross_entropy_impl.hpp
+ * @author Marcus Edel
+ *
+ * Implementation of the SoftmaxCrossEntropy class.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_ANN_LOSS_FUNCTION_SOFTMAX_CROSS_ENTROPY_IMPL_HPP
+#define MLPACK_METHODS_ANN_LOSS_FUNCTION_SOFTMAX_CROSS_ENTROPY_IMPL_HPP
+
+// In case it hasn't yet been included.
+#include "softmax_cross_entropy.hpp"
+
+namespace mlpack {
+namespace ann /** Artificial Neural Network. */ {
+
+template<typename InputDataType, typename OutputDataType>
+SoftmaxCrossEntropy<InputDataType, OutputDataType>::SoftmaxCrossEntropy(
+    const size_t numSamples) : numSamples(numSamples)
+{
+  // Nothing to do here.
+}
+
+template<typename InputDataType, typename OutputDataType>
+template<typename InputType, typename TargetType>
+typename InputType::elem_type
+SoftmaxCrossEntropy<InputDataType, OutputDataType>::Forward(
+    const InputType& input,
+    const TargetType& target)
+{
+  typedef typename InputType::elem_type ElemType;
+  ElemType output = 0;
+
+  if (numSamples > 0 && numSamples < input.n_rows)
+  {
+    // Draw a shared set of candidate classes for the whole batch; the
+    // normalizer of each column is computed over the drawn classes and the
+    // column's target only, so the cost is independent of the number of
+    // classes.
+    sampledClasses = arma::unique(arma::randi<arma::uvec>(numSamples,
+        arma::distr_param(0, input.n_rows - 1)));
+
+    for (size_t i = 0; i < input.n_cols; ++i)
+    {
+      const size_t currentTarget = target(i) - 1;
+      Log::Assert(currentTarget >= 0 && currentTarget < input.n_rows,
+          "Target class out of range.");
+
+      ElemType maxValue = input(currentTarget, i);
+      for (size_t j = 0; j < sampledClasses.n_elem; ++j)
+        maxValue = std::max(maxValue, input(sampledClasses(j), i));
+
+      ElemType sum = std::exp(input(currentTarget, i) - maxValue);
+      for (size_t j = 0; j < sampledClasses.n_elem; ++j)
+      {
+        if (sampledClasses(j) != currentTarget)
+          sum += std::exp(input(sampledClasses(j), i) - maxValue);
+      }
+
+      output += maxValue + std::log(sum) - input(currentTarget, i);
+    }
+
+    return output;
+  }
+
+  for (size_t i = 0; i < input.n_cols; ++i)
+  {
+    const size_t currentTarget = target(i) - 1;
+    Log::Assert(currentTarget >= 0 && currentTarget < input.n_rows,
+        "Target class out of range.");
+
+    // Log-sum-exp of the logits and the loss in one pass over the column.
+    const ElemType maxValue = input.col(i).max();
+    const ElemType logSum = std::log(arma::accu(
+        arma::exp(input.col(i) - maxValue)));
+    output += maxValue + logSum - input(currentTarget, i);
+  }
+
+  return output;
+}
+
+template<typename InputDataType, typename OutputDataType>
+template<typename InputType, typename TargetType, typename OutputType>
+void SoftmaxCrossEntropy<InputDataType, OutputDataType>::Backward(
+    const InputType& input,
+    const TargetType& target,
+    OutputType& output)
+{
+  typedef typename InputType::elem_type ElemType;
+  output = arma::zeros<OutputType>(input.n_rows, input.n_cols);
+
+  if (numSamples > 0 && numSamples < input.n_rows &&
+      !sampledClasses.is_empty())
+  {
+    for (size_t i = 0; i < input.n_cols; ++i)
+    {
+      const size_t currentTarget = target(i) - 1;
+      Log::Assert(currentTarget >= 0 && currentTarget < input.n_rows,
+          "Target class out of range.");
+
+      ElemType maxValue = input(currentTarget, i);
+      for (size_t j = 0; j < sampledClasses.n_elem; ++j)
+        maxValue = std::max(maxValue, input(sampledClasses(j), i));
+
+      ElemType sum = std::exp(input(currentTarget, i) - maxValue);
+      for (size_t j = 0; j < sampledClasses.n_elem; ++j)
+      {
+        if (sampledClasses(j) != currentTarget)
+          sum += std::exp(input(sampledClasses(j), i) - maxValue);
+      }
+
+      // Softmax over the sampled subset, minus the one-hot target.
+      output(currentTarget, i) =
+          std::exp(input(currentTarget, i) - maxValue) / sum - 1;
+      for (size_t j = 0; j < sampledClasses.n_elem; ++j)
+      {
+        if (sampledClasses(j) != currentTarget)
+        {
+          output(sampledClasses(j), i) =
+              std::exp(input(sampledClasses(j), i) - maxValue) / sum;
+        }
+      }
+    }
+
+    return;
+  }
+
+  for (size_t i = 0; i < input.n_cols; ++i)
+  {
+    const size_t currentTarget = target(i) - 1;
+    Log::Assert(currentTarget >= 0 && currentTarget < input.n_rows,
+        "Target class out of range.");
+
+    const ElemType maxValue = input.col(i).max();
+    output.col(i) = arma::exp(input.col(i) - maxValue);
+    output.col(i) /= arma::accu(output.col(i));
+    output(currentTarget, i) -= 1;
+  }
+}
+
+template<typename InputDataType, typename OutputDataType>
+template<typename Archive>
+void SoftmaxCrossEntropy<InputDataType, OutputDataType>::serialize(
+    Archive& ar,
+    const unsigned int /* version */)
+{
+  ar & BOOST_SERIALIZATION_NVP(numSamples);
+}
+
+} // namespace ann
+} // namespace mlpack
+
+#endif
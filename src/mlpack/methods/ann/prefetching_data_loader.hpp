@@ -0,0 +1,132 @@
+/**
+ * @file methods/ann/prefetching_data_loader.hpp
+ * @author Marcus Edel
+ *
+ * Definition of the PrefetchingDataLoader class, which loads training chunks
+ * on background threads into a bounded buffer while the optimizer consumes
+ * the current one.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_ANN_PREFETCHING_DATA_LOADER_HPP
+#define MLPACK_METHODS_ANN_PREFETCHING_DATA_LOADER_HPP
+
+#include <mlpack/prereqs.hpp>
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+namespace mlpack {
+namespace ann /** Artificial Neural Network. */ {
+
+/**
+ * Implementation of the PrefetchingDataLoader class.  The loader wraps a
+ * user-supplied chunk function that produces the next chunk of predictors and
+ * responses - typically by reading, decoding and augmenting data that does not
+ * fit in memory - and runs it on background threads, so the next chunks are
+ * already buffered while the current one is being trained on.  The buffer is
+ * bounded, so loading stalls instead of exhausting memory when training is
+ * the slower side.
+ *
+ * The chunk function is called repeatedly and should fill the passed
+ * predictor and response matrices, returning false when the data is
+ * exhausted.  With more than one worker thread the chunk function is called
+ * concurrently and must be thread-safe; chunks may then be consumed in a
+ * different order than they were produced.
+ *
+ * A simple usage example:
+ *
+ * @code
+ * PrefetchingDataLoader<> loader([&](arma::mat& predictors,
+ *     arma::mat& responses) { return LoadNextImages(predictors, responses); });
+ *
+ * FFN<> model;
+ * model.Add<Linear<> >(inputSize, hiddenSize);
+ * ...
+ * model.Train(loader, optimizer);
+ * @endcode
+ *
+ * @tparam InputType Type of the predictor chunks (arma::mat is supported by
+ *         FFN; any movable type can be buffered).
+ * @tparam OutputType Type of the response chunks.
+ */
+template<typename InputType = arma::mat, typename OutputType = arma::mat>
+class PrefetchingDataLoader
+{
+ public:
+  //! The type of the function producing the next chunk.
+  typedef std::function<bool(InputType&, OutputType&)> ChunkFunction;
+
+  /**
+   * Create the PrefetchingDataLoader object and start the worker threads.
+   *
+   * @param chunkFunction Function that fills the next chunk of predictors and
+   *     responses, returning false when the data is exhausted.
+   * @param bufferSize Maximum number of chunks buffered ahead of training.
+   * @param workers Number of background threads calling the chunk function;
+   *     with more than one worker the chunk function must be thread-safe.
+   */
+  PrefetchingDataLoader(ChunkFunction chunkFunction,
+                        const size_t bufferSize = 2,
+                        const size_t workers = 1);
+
+  //! Delete the PrefetchingDataLoader object, joining the worker threads.
+  ~PrefetchingDataLoader();
+
+  /**
+   * Get the next chunk, blocking until one is buffered.  Returns false once
+   * the chunk function has signaled exhaustion and the buffer has drained.
+   *
+   * @param predictors Matrix to move the chunk's predictors into.
+   * @param responses Matrix to move the chunk's responses into.
+   */
+  bool Next(InputType& predictors, OutputType& responses);
+
+  //! Get whether all chunks have been produced and consumed.
+  bool Exhausted();
+
+ private:
+  //! The worker loop: produce chunks until the data is exhausted.
+  void WorkerLoop();
+
+  //! The function producing the next chunk.
+  ChunkFunction chunkFunction;
+
+  //! Maximum number of chunks buffered ahead of training.
+  size_t bufferSize;
+
+  //! Buffered chunks waiting to be consumed.
+  std::deque<std::pair<InputType, OutputType> > buffer;
+
+  //! Whether the loader is shutting down.
+  bool done;
+
+  //! Mutex guarding the buffer and the done flag.
+  std::mutex mutex;
+
+  //! Signaled when a chunk was added to the buffer or production finished.
+  std::condition_variable produced;
+
+  //! Signaled when a chunk was taken from the buffer.
+  std::condition_variable consumed;
+
+  //! The background worker threads.
+  std::vector<std::thread> workers;
+
+  //! Number of workers that are still running.
+  size_t activeWorkers;
+}; // class PrefetchingDataLoader
+
+} // namespace ann
+} // namespace mlpack
+
+// Include implementation.
+#include "prefetching_data_loader_impl.hpp"
+
+#endif
@@ -0,0 +1,116 @@
+/**
+ * @file methods/ann/prefetching_data_loader_impl.hpp
+ * @author Marcus Edel
+ *
+ * Implementation of the PrefetchingDataLoader class, which loads training
+ * chunks on background threads into a bounded buffer while the optimizer
+ * consumes the current one.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_ANN_PREFETCHING_DATA_LOADER_IMPL_HPP
+#define MLPACK_METHODS_ANN_PREFETCHING_DATA_LOADER_IMPL_HPP
+
+// In case it hasn't yet been included.
+#include "prefetching_data_loader.hpp"
+
+namespace mlpack {
+namespace ann /** Artificial Neural Network. */ {
+
+template<typename InputType, typename OutputType>
+PrefetchingDataLoader<InputType, OutputType>::PrefetchingDataLoader(
+    ChunkFunction chunkFunction,
+    const size_t bufferSize,
+    const size_t workers) :
+    chunkFunction(std::move(chunkFunction)),
+    bufferSize(std::max(bufferSize, (size_t) 1)),
+    done(false),
+    activeWorkers(std::max(workers, (size_t) 1))
+{
+  for (size_t i = 0; i < std::max(workers, (size_t) 1); ++i)
+    this->workers.push_back(std::thread(
+        &PrefetchingDataLoader::WorkerLoop, this));
+}
+
+template<typename InputType, typename OutputType>
+PrefetchingDataLoader<InputType, OutputType>::~PrefetchingDataLoader()
+{
+  // Stop the workers: mark the loader as done and drain the buffer, so any
+  // worker blocked on a full buffer can finish.
+  {
+    std::unique_lock<std::mutex> lock(mutex);
+    done = true;
+    buffer.clear();
+  }
+  consumed.notify_all();
+
+  for (size_t i = 0; i < workers.size(); ++i)
+    workers[i].join();
+}
+
+template<typename InputType, typename OutputType>
+void PrefetchingDataLoader<InputType, OutputType>::WorkerLoop()
+{
+  InputType predictors;
+  OutputType responses;
+
+  while (true)
+  {
+    // Produce the next chunk outside of the lock; this is where the actual
+    // loading, decoding and augmentation work happens.
+    const bool haveChunk = chunkFunction(predictors, responses);
+
+    std::unique_lock<std::mutex> lock(mutex);
+
+    // Wait until there is room in the buffer.
+    if (haveChunk && !done)
+      consumed.wait(lock, [this] { return buffer.size() < bufferSize || done; });
+
+    if (!haveChunk || done)
+    {
+      --activeWorkers;
+      lock.unlock();
+      produced.notify_all();
+      return;
+    }
+
+    buffer.push_back(std::make_pair(std::move(predictors),
+        std::move(responses)));
+    lock.unlock();
+    produced.notify_one();
+  }
+}
+
+template<typename InputType, typename OutputType>
+bool PrefetchingDataLoader<InputType, OutputType>::Next(
+    InputType& predictors, OutputType& responses)
+{
+  std::unique_lock<std::mutex> lock(mutex);
+  produced.wait(lock, [this] { return !buffer.empty() || activeWorkers == 0; });
+
+  if (buffer.empty())
+    return false;
+
+  predictors = std::move(buffer.front().first);
+  responses = std::move(buffer.front().second);
+  buffer.pop_front();
+  lock.unlock();
+  consumed.notify_one();
+
+  return true;
+}
+
+template<typename InputType, typename OutputType>
+bool PrefetchingDataLoader<InputType, OutputType>::Exhausted()
+{
+  std::unique_lock<std::mutex> lock(mutex);
+  return buffer.empty() && activeWorkers == 0;
+}
+
+} // namespace ann
+} // namespace mlpack
+
+#endif
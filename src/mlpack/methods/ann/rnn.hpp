@@ -20,6 +20,7 @@
 #include "visitor/reset_visitor.hpp"
 
 #include "init_rules/network_init.hpp"
+#include "layer_profiler.hpp"
 
 #include <mlpack/methods/ann/layer/layer_types.hpp>
 #include <mlpack/methods/ann/layer/layer.hpp>
@@ -301,6 +302,20 @@ class RNN
   //! Modify the matrix of data points (predictors).
   arma::cube& Predictors() { return predictors; }
 
+  //! Get the per-layer profiler.
+  const LayerProfiler& Profiler() const { return profiler; }
+  //! Modify the per-layer profiler; set Profiler().Enabled() to true to
+  //! record per-layer forward/backward times (via the Timer infrastructure),
+  //! bytes moved and estimated FLOPs, accumulated over all time steps.
+  LayerProfiler& Profiler() { return profiler; }
+
+  /**
+   * Print a per-layer table of the statistics recorded by the profiler.
+   *
+   * @param os Stream to print the table into.
+   */
+  void ProfileSummary(std::ostream& os);
+
   /**
    * Reset the state of the network.  This ensures that all internally-held
    * gradients are set to 0, all memory cells are reset, and the parameters
@@ -424,6 +439,9 @@ class RNN
   //! The current gradient for the gradient pass.
   arma::mat currentGradient;
 
+  //! Opt-in per-layer instrumentation; disabled by default.
+  LayerProfiler profiler;
+
   // The BRN class should have access to internal members.
   template<
     typename OutputLayerType1,
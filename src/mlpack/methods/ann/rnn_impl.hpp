@@ -25,6 +25,10 @@
 #include "visitor/gradient_visitor.hpp"
 #include "visitor/weight_set_visitor.hpp"
 
+#include "layer_names.hpp"
+
+#include <mlpack/core/math/make_alias.hpp>
+
 #include <boost/serialization/variant.hpp>
 
 namespace mlpack {
@@ -46,7 +50,8 @@ RNN<OutputLayerType, InitializationRuleType, CustomLayers...>::RNN(
     reset(false),
     single(single),
     numFunctions(0),
-    deterministic(true)
+    deterministic(true),
+    profiler("rnn")
 {
   /* Nothing to do here */
 }
@@ -196,8 +201,7 @@ void RNN<OutputLayerType, InitializationRuleType, CustomLayers...>::Predict(
   const size_t effectiveBatchSize = std::min(batchSize,
       size_t(predictors.n_cols));
 
-  Forward(arma::mat(predictors.slice(0).colptr(0), predictors.n_rows,
-      effectiveBatchSize, false, true));
+  Forward(math::MakeAlias(predictors, 0, 0, effectiveBatchSize));
   arma::mat resultsTemp = boost::apply_visitor(outputParameterVisitor,
       network.back());
 
@@ -213,8 +217,7 @@ void RNN<OutputLayerType, InitializationRuleType, CustomLayers...>::Predict(
         size_t(predictors.n_cols - begin));
     for (size_t seqNum = !begin; seqNum < rho; ++seqNum)
     {
-      Forward(arma::mat(predictors.slice(seqNum).colptr(begin),
-          predictors.n_rows, effectiveBatchSize, false, true));
+      Forward(math::MakeAlias(predictors, seqNum, begin, effectiveBatchSize));
 
       results.slice(seqNum).submat(0, begin, results.n_rows - 1, begin +
           effectiveBatchSize - 1) = boost::apply_visitor(outputParameterVisitor,
@@ -260,8 +263,7 @@ double RNN<OutputLayerType, InitializationRuleType, CustomLayers...>::Evaluate(
   for (size_t seqNum = 0; seqNum < rho; ++seqNum)
   {
     // Wrap a matrix around our data to avoid a copy.
-    arma::mat stepData(predictors.slice(seqNum).colptr(begin),
-        predictors.n_rows, batchSize, false, true);
+    arma::mat stepData = math::MakeAlias(predictors, seqNum, begin, batchSize);
     Forward(stepData);
     if (!single)
     {
@@ -270,8 +272,7 @@ double RNN<OutputLayerType, InitializationRuleType, CustomLayers...>::Evaluate(
 
     performance += outputLayer.Forward(boost::apply_visitor(
         outputParameterVisitor, network.back()),
-        arma::mat(responses.slice(responseSeq).colptr(begin),
-            responses.n_rows, batchSize, false, true));
+        math::MakeAlias(responses, responseSeq, begin, batchSize));
   }
 
   if (outputSize == 0)
@@ -342,8 +343,7 @@ EvaluateWithGradient(const arma::mat& /* parameters */,
   for (size_t seqNum = 0; seqNum < effectiveRho; ++seqNum)
   {
     // Wrap a matrix around our data to avoid a copy.
-    arma::mat stepData(predictors.slice(seqNum).colptr(begin),
-        predictors.n_rows, batchSize, false, true);
+    arma::mat stepData = math::MakeAlias(predictors, seqNum, begin, batchSize);
     Forward(stepData);
     if (!single)
     {
@@ -358,8 +358,7 @@ EvaluateWithGradient(const arma::mat& /* parameters */,
 
     performance += outputLayer.Forward(boost::apply_visitor(
         outputParameterVisitor, network.back()),
-        arma::mat(responses.slice(responseSeq).colptr(begin),
-            responses.n_rows, batchSize, false, true));
+        math::MakeAlias(responses, responseSeq, begin, batchSize));
   }
 
   if (outputSize == 0)
@@ -394,21 +393,19 @@ EvaluateWithGradient(const arma::mat& /* parameters */,
     {
       outputLayer.Backward(boost::apply_visitor(
           outputParameterVisitor, network.back()),
-          arma::mat(responses.slice(0).colptr(begin),
-          responses.n_rows, batchSize, false, true), error);
+          math::MakeAlias(responses, 0, begin, batchSize), error);
     }
     else
     {
       outputLayer.Backward(boost::apply_visitor(
           outputParameterVisitor, network.back()),
-          arma::mat(responses.slice(effectiveRho - seqNum - 1).colptr(begin),
-          responses.n_rows, batchSize, false, true), error);
+          math::MakeAlias(responses, effectiveRho - seqNum - 1, begin,
+          batchSize), error);
     }
 
     Backward();
-    Gradient(
-        arma::mat(predictors.slice(effectiveRho - seqNum - 1).colptr(begin),
-        predictors.n_rows, batchSize, false, true));
+    Gradient(math::MakeAlias(predictors, effectiveRho - seqNum - 1, begin,
+        batchSize));
     gradient += currentGradient;
   }
 
@@ -430,11 +427,46 @@ template<typename OutputLayerType, typename InitializationRuleType,
          typename... CustomLayers>
 void RNN<OutputLayerType, InitializationRuleType, CustomLayers...>::Shuffle()
 {
-  arma::cube newPredictors, newResponses;
-  math::ShuffleData(predictors, responses, newPredictors, newResponses);
+  // Generate ordering.
+  arma::uvec ordering = arma::shuffle(arma::linspace<arma::uvec>(0,
+      predictors.n_cols - 1, predictors.n_cols));
+
+  // Apply the permutation in place, one cycle at a time, so that no shuffled
+  // copy of the full sequence data has to be materialized; only a single
+  // sequence is buffered at any time.
+  std::vector<bool> moved(predictors.n_cols, false);
+  arma::cube predictorsTemp, responsesTemp, predictorsSwap, responsesSwap;
+  for (size_t i = 0; i < predictors.n_cols; ++i)
+  {
+    if (moved[i] || ordering[i] == i)
+      continue;
+
+    predictorsTemp = predictors.subcube(arma::span::all, arma::span(i),
+        arma::span::all);
+    responsesTemp = responses.subcube(arma::span::all, arma::span(i),
+        arma::span::all);
 
-  predictors = std::move(newPredictors);
-  responses = std::move(newResponses);
+    size_t current = i;
+    do
+    {
+      const size_t target = ordering[current];
+      predictorsSwap = predictors.subcube(arma::span::all, arma::span(target),
+          arma::span::all);
+      responsesSwap = responses.subcube(arma::span::all, arma::span(target),
+          arma::span::all);
+
+      predictors.subcube(arma::span::all, arma::span(target),
+          arma::span::all) = predictorsTemp;
+      responses.subcube(arma::span::all, arma::span(target),
+          arma::span::all) = responsesTemp;
+
+      predictorsTemp = std::move(predictorsSwap);
+      responsesTemp = std::move(responsesSwap);
+
+      moved[target] = true;
+      current = target;
+    } while (current != i);
+  }
 }
 
 template<typename OutputLayerType, typename InitializationRuleType,
@@ -491,16 +523,41 @@ template<typename InputType>
 void RNN<OutputLayerType, InitializationRuleType,
          CustomLayers...>::Forward(const InputType& input)
 {
+  if (profiler.Enabled())
+    profiler.Start(0, "forward");
+
   boost::apply_visitor(ForwardVisitor(input,
       boost::apply_visitor(outputParameterVisitor, network.front())),
       network.front());
 
+  if (profiler.Enabled())
+  {
+    profiler.Stop(0, "forward");
+    profiler.Add(0, input.n_elem,
+        boost::apply_visitor(outputParameterVisitor, network.front()).n_elem,
+        boost::apply_visitor(weightSizeVisitor, network.front()),
+        input.n_cols);
+  }
+
   for (size_t i = 1; i < network.size(); ++i)
   {
+    if (profiler.Enabled())
+      profiler.Start(i, "forward");
+
     boost::apply_visitor(ForwardVisitor(
         boost::apply_visitor(outputParameterVisitor, network[i - 1]),
         boost::apply_visitor(outputParameterVisitor, network[i])),
         network[i]);
+
+    if (profiler.Enabled())
+    {
+      profiler.Stop(i, "forward");
+      profiler.Add(i,
+          boost::apply_visitor(outputParameterVisitor, network[i - 1]).n_elem,
+          boost::apply_visitor(outputParameterVisitor, network[i]).n_elem,
+          boost::apply_visitor(weightSizeVisitor, network[i]),
+          boost::apply_visitor(outputParameterVisitor, network[i]).n_cols);
+    }
   }
 }
 
@@ -508,22 +565,47 @@ template<typename OutputLayerType, typename InitializationRuleType,
          typename... CustomLayers>
 void RNN<OutputLayerType, InitializationRuleType, CustomLayers...>::Backward()
 {
+  if (profiler.Enabled())
+    profiler.Start(network.size() - 1, "backward");
+
   boost::apply_visitor(BackwardVisitor(
         boost::apply_visitor(outputParameterVisitor, network.back()),
         error, boost::apply_visitor(deltaVisitor,
         network.back())), network.back());
 
+  if (profiler.Enabled())
+    profiler.Stop(network.size() - 1, "backward");
+
   for (size_t i = 2; i < network.size(); ++i)
   {
+    if (profiler.Enabled())
+      profiler.Start(network.size() - i, "backward");
+
     boost::apply_visitor(BackwardVisitor(
         boost::apply_visitor(outputParameterVisitor,
         network[network.size() - i]), boost::apply_visitor(
         deltaVisitor, network[network.size() - i + 1]),
         boost::apply_visitor(deltaVisitor, network[network.size() - i])),
         network[network.size() - i]);
+
+    if (profiler.Enabled())
+      profiler.Stop(network.size() - i, "backward");
   }
 }
 
+template<typename OutputLayerType, typename InitializationRuleType,
+         typename... CustomLayers>
+void RNN<OutputLayerType, InitializationRuleType,
+         CustomLayers...>::ProfileSummary(std::ostream& os)
+{
+  std::vector<std::string> names(network.size());
+  LayerNameVisitor layerNameVisitor;
+  for (size_t i = 0; i < network.size(); ++i)
+    names[i] = boost::apply_visitor(layerNameVisitor, network[i]);
+
+  profiler.Summary(os, names);
+}
+
 template<typename OutputLayerType, typename InitializationRuleType,
          typename... CustomLayers>
 template<typename InputType>
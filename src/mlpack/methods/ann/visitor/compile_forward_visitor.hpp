@@ -0,0 +1,53 @@
+/**
+ * @file methods/ann/visitor/compile_forward_visitor.hpp
+ * @author Marcus Edel
+ *
+ * This file provides an abstraction to resolve the Forward() function of a
+ * layer once and return it as a directly callable function object, avoiding
+ * repeated variant visitation.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_ANN_VISITOR_COMPILE_FORWARD_VISITOR_HPP
+#define MLPACK_METHODS_ANN_VISITOR_COMPILE_FORWARD_VISITOR_HPP
+
+#include <mlpack/methods/ann/layer/layer_traits.hpp>
+#include <mlpack/methods/ann/layer/layer_types.hpp>
+
+#include <boost/variant.hpp>
+
+#include <functional>
+
+namespace mlpack {
+namespace ann {
+
+/**
+ * CompileForwardVisitor resolves the concrete layer type once and returns the
+ * layer's Forward() function bound into a function object.  Calling the
+ * returned object repeatedly skips the variant dispatch that ForwardVisitor
+ * performs on every call.
+ */
+class CompileForwardVisitor :
+    public boost::static_visitor<std::function<
+        void(const arma::mat&, arma::mat&)> >
+{
+ public:
+  //! Return the bound Forward() function of the given layer.
+  template<typename LayerType>
+  std::function<void(const arma::mat&, arma::mat&)> operator()(
+      LayerType* layer) const;
+
+  std::function<void(const arma::mat&, arma::mat&)> operator()(
+      MoreTypes layer) const;
+};
+
+} // namespace ann
+} // namespace mlpack
+
+// Include implementation.
+#include "compile_forward_visitor_impl.hpp"
+
+#endif
@@ -0,0 +1,41 @@
+/**
+ * @file methods/ann/visitor/compile_forward_visitor_impl.hpp
+ * @author Marcus Edel
+ *
+ * Implementation of the Forward() function resolution layer abstraction.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_ANN_VISITOR_COMPILE_FORWARD_VISITOR_IMPL_HPP
+#define MLPACK_METHODS_ANN_VISITOR_COMPILE_FORWARD_VISITOR_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "compile_forward_visitor.hpp"
+
+namespace mlpack {
+namespace ann {
+
+//! CompileForwardVisitor visitor class.
+template<typename LayerType>
+inline std::function<void(const arma::mat&, arma::mat&)>
+CompileForwardVisitor::operator()(LayerType* layer) const
+{
+  return [layer](const arma::mat& input, arma::mat& output)
+  {
+    layer->Forward(input, output);
+  };
+}
+
+inline std::function<void(const arma::mat&, arma::mat&)>
+CompileForwardVisitor::operator()(MoreTypes layer) const
+{
+  return layer.apply_visitor(*this);
+}
+
+} // namespace ann
+} // namespace mlpack
+
+#endif
@@ -0,0 +1,78 @@
+/**
+ * @file methods/ann/visitor/optimize_for_inference_visitor.hpp
+ * @author Marcus Edel
+ *
+ * This file provides an abstraction for the OptimizeForInference() function
+ * for different layers and automatically directs any parameter to the right
+ * layer type.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_ANN_VISITOR_OPTIMIZE_FOR_INFERENCE_VISITOR_HPP
+#define MLPACK_METHODS_ANN_VISITOR_OPTIMIZE_FOR_INFERENCE_VISITOR_HPP
+
+#include <mlpack/methods/ann/layer/layer_traits.hpp>
+
+#include <boost/variant.hpp>
+
+namespace mlpack {
+namespace ann {
+
+/**
+ * OptimizeForInferenceVisitor repacks the weights of every layer that
+ * implements the OptimizeForInference() function into its
+ * multiplication-optimal inference layout; layers without such a function are
+ * left untouched.  Container layers are traversed recursively.
+ */
+class OptimizeForInferenceVisitor : public boost::static_visitor<void>
+{
+ public:
+  //! Repack the layer weights for inference.
+  template<typename LayerType>
+  void operator()(LayerType* layer) const;
+
+  void operator()(MoreTypes layer) const;
+
+ private:
+  //! Repack the weights if the module implements the OptimizeForInference()
+  //! and Model() function.
+  template<typename T>
+  typename std::enable_if<
+      HasOptimizeForInferenceCheck<T, void(T::*)()>::value &&
+      HasModelCheck<T>::value, void>::type
+  LayerOptimize(T* layer) const;
+
+  //! Traverse the sub-layers if the module implements the Model() function.
+  template<typename T>
+  typename std::enable_if<
+      !HasOptimizeForInferenceCheck<T, void(T::*)()>::value &&
+      HasModelCheck<T>::value, void>::type
+  LayerOptimize(T* layer) const;
+
+  //! Repack the weights if the module implements the OptimizeForInference()
+  //! function.
+  template<typename T>
+  typename std::enable_if<
+      HasOptimizeForInferenceCheck<T, void(T::*)()>::value &&
+      !HasModelCheck<T>::value, void>::type
+  LayerOptimize(T* layer) const;
+
+  //! Do not repack the weights if the module doesn't implement the
+  //! OptimizeForInference() or Model() function.
+  template<typename T>
+  typename std::enable_if<
+      !HasOptimizeForInferenceCheck<T, void(T::*)()>::value &&
+      !HasModelCheck<T>::value, void>::type
+  LayerOptimize(T* layer) const;
+};
+
+} // namespace ann
+} // namespace mlpack
+
+// Include implementation.
+#include "optimize_for_inference_visitor_impl.hpp"
+
+#endif
@@ -0,0 +1,80 @@
+/**
+ * @file methods/ann/visitor/optimize_for_inference_visitor_impl.hpp
+ * @author Marcus Edel
+ *
+ * Implementation of the OptimizeForInference() function layer abstraction.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_ANN_VISITOR_OPTIMIZE_FOR_INFERENCE_VISITOR_IMPL_HPP
+#define MLPACK_METHODS_ANN_VISITOR_OPTIMIZE_FOR_INFERENCE_VISITOR_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "optimize_for_inference_visitor.hpp"
+
+namespace mlpack {
+namespace ann {
+
+//! OptimizeForInferenceVisitor visitor class.
+template<typename LayerType>
+inline void OptimizeForInferenceVisitor::operator()(LayerType* layer) const
+{
+  LayerOptimize(layer);
+}
+
+inline void OptimizeForInferenceVisitor::operator()(MoreTypes layer) const
+{
+  layer.apply_visitor(*this);
+}
+
+template<typename T>
+inline typename std::enable_if<
+    HasOptimizeForInferenceCheck<T, void(T::*)()>::value &&
+    HasModelCheck<T>::value, void>::type
+OptimizeForInferenceVisitor::LayerOptimize(T* layer) const
+{
+  layer->OptimizeForInference();
+
+  for (size_t i = 0; i < layer->Model().size(); ++i)
+  {
+    boost::apply_visitor(OptimizeForInferenceVisitor(), layer->Model()[i]);
+  }
+}
+
+template<typename T>
+inline typename std::enable_if<
+    !HasOptimizeForInferenceCheck<T, void(T::*)()>::value &&
+    HasModelCheck<T>::value, void>::type
+OptimizeForInferenceVisitor::LayerOptimize(T* layer) const
+{
+  for (size_t i = 0; i < layer->Model().size(); ++i)
+  {
+    boost::apply_visitor(OptimizeForInferenceVisitor(), layer->Model()[i]);
+  }
+}
+
+template<typename T>
+inline typename std::enable_if<
+    HasOptimizeForInferenceCheck<T, void(T::*)()>::value &&
+    !HasModelCheck<T>::value, void>::type
+OptimizeForInferenceVisitor::LayerOptimize(T* layer) const
+{
+  layer->OptimizeForInference();
+}
+
+template<typename T>
+inline typename std::enable_if<
+    !HasOptimizeForInferenceCheck<T, void(T::*)()>::value &&
+    !HasModelCheck<T>::value, void>::type
+OptimizeForInferenceVisitor::LayerOptimize(T* /* layer */) const
+{
+  /* Nothing to do here. */
+}
+
+} // namespace ann
+} // namespace mlpack
+
+#endif
@@ -0,0 +1,71 @@
+/**
+ * @file methods/ann/visitor/sparse_forward_visitor.hpp
+ * @author Marcus Edel
+ *
+ * This file provides an abstraction for the Forward() function with sparse
+ * input and automatically directs any parameter to the right layer type.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_ANN_VISITOR_SPARSE_FORWARD_VISITOR_HPP
+#define MLPACK_METHODS_ANN_VISITOR_SPARSE_FORWARD_VISITOR_HPP
+
+#include <mlpack/methods/ann/layer/layer_traits.hpp>
+#include <mlpack/methods/ann/layer/layer_types.hpp>
+
+#include <boost/variant.hpp>
+
+namespace mlpack {
+namespace ann {
+
+/**
+ * SparseForwardVisitor executes the Forward() function given a sparse input
+ * and the output parameter.  A layer that implements a sparse Forward()
+ * overload (such as Linear) receives the sparse matrix directly and can
+ * restrict its work to the nonzero entries; any other layer receives a
+ * densified copy of the input.
+ */
+class SparseForwardVisitor : public boost::static_visitor<void>
+{
+ public:
+  //! Execute the Forward() function given the input and output parameter.
+  SparseForwardVisitor(const arma::sp_mat& input, arma::mat& output);
+
+  //! Execute the Forward() function.
+  template<typename LayerType>
+  void operator()(LayerType* layer) const;
+
+  void operator()(MoreTypes layer) const;
+
+ private:
+  //! The input parameter set.
+  const arma::sp_mat& input;
+
+  //! The output parameter set.
+  arma::mat& output;
+
+  //! Execute the sparse Forward() overload if the module implements one.
+  template<typename T>
+  typename std::enable_if<
+      HasForwardCheck<T,
+          void(T::*)(const arma::sp_mat&, arma::mat&)>::value, void>::type
+  LayerForward(T* layer) const;
+
+  //! Densify the input if the module has no sparse Forward() overload.
+  template<typename T>
+  typename std::enable_if<
+      !HasForwardCheck<T,
+          void(T::*)(const arma::sp_mat&, arma::mat&)>::value, void>::type
+  LayerForward(T* layer) const;
+};
+
+} // namespace ann
+} // namespace mlpack
+
+// Include implementation.
+#include "sparse_forward_visitor_impl.hpp"
+
+#endif
@@ -0,0 +1,83 @@
+/**
+ * @file methods/ann/visitor/sparse_gradient_visitor.hpp
+ * @author Marcus Edel
+ *
+ * This file provides an abstraction for the Gradient() function with sparse
+ * input and automatically directs any parameter to the right layer type.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_ANN_VISITOR_SPARSE_GRADIENT_VISITOR_HPP
+#define MLPACK_METHODS_ANN_VISITOR_SPARSE_GRADIENT_VISITOR_HPP
+
+#include <mlpack/methods/ann/layer/layer_traits.hpp>
+#include <mlpack/methods/ann/layer/layer_types.hpp>
+
+#include <boost/variant.hpp>
+
+namespace mlpack {
+namespace ann {
+
+/**
+ * SparseGradientVisitor executes the Gradient() method of the given module
+ * using a sparse input and the delta parameter.  A layer that implements a
+ * sparse Gradient() overload (such as Linear) receives the sparse matrix
+ * directly and can restrict its work to the nonzero entries; any other layer
+ * with a Gradient() method receives a densified copy of the input.
+ */
+class SparseGradientVisitor : public boost::static_visitor<void>
+{
+ public:
+  //! Executes the Gradient() method of the given module using the input and
+  //! delta parameter.
+  SparseGradientVisitor(const arma::sp_mat& input, const arma::mat& delta);
+
+  //! Executes the Gradient() method.
+  template<typename LayerType>
+  void operator()(LayerType* layer) const;
+
+  void operator()(MoreTypes layer) const;
+
+ private:
+  //! The input set.
+  const arma::sp_mat& input;
+
+  //! The delta parameter.
+  const arma::mat& delta;
+
+  //! Execute the sparse Gradient() overload if the module implements one.
+  template<typename T>
+  typename std::enable_if<
+      HasGradientCheck<T, void(T::*)(const arma::sp_mat&, const arma::mat&,
+          arma::mat&)>::value, void>::type
+  LayerGradients(T* layer) const;
+
+  //! Densify the input if the module implements the Gradient() function but
+  //! has no sparse overload of it.
+  template<typename T>
+  typename std::enable_if<
+      !HasGradientCheck<T, void(T::*)(const arma::sp_mat&, const arma::mat&,
+          arma::mat&)>::value &&
+      HasGradientCheck<T, arma::mat&(T::*)()>::value, void>::type
+  LayerGradients(T* layer) const;
+
+  //! Do not execute the Gradient() function if the module doesn't implement
+  //! the Gradient() function.
+  template<typename T>
+  typename std::enable_if<
+      !HasGradientCheck<T, void(T::*)(const arma::sp_mat&, const arma::mat&,
+          arma::mat&)>::value &&
+      !HasGradientCheck<T, arma::mat&(T::*)()>::value, void>::type
+  LayerGradients(T* layer) const;
+};
+
+} // namespace ann
+} // namespace mlpack
+
+// Include implementation.
+#include "sparse_gradient_visitor_impl.hpp"
+
+#endif
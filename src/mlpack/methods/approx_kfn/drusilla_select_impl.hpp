@@ -21,6 +21,10 @@
 #include <mlpack/core/tree/binary_space_tree.hpp>
 #include <algorithm>
 
+#ifdef HAS_OPENMP
+  #include <omp.h>
+#endif
+
 namespace mlpack {
 namespace neighbor {
 
@@ -100,6 +104,10 @@ void DrusillaSelect<MatType>::Train(
 
     arma::vec line(refCopy.col(maxIndex) / arma::norm(refCopy.col(maxIndex)));
 
+    // Project every point onto the line with a single matrix-vector product
+    // instead of one dot product per point.
+    const arma::vec offsets(refCopy.t() * line);
+
     // Calculate distortion and offset and make scores.
     std::vector<bool> closeAngle(referenceSet.n_cols, false);
     arma::vec sums(referenceSet.n_cols);
@@ -107,11 +115,11 @@ void DrusillaSelect<MatType>::Train(
     {
       if (norms[j] > 0.0)
       {
-        const double offset = arma::dot(refCopy.col(j), line);
-        const double distortion = arma::norm(refCopy.col(j) - offset * line);
-        sums[j] = std::abs(offset) - std::abs(distortion);
+        const double distortion = arma::norm(refCopy.col(j) -
+            offsets[j] * line);
+        sums[j] = std::abs(offsets[j]) - std::abs(distortion);
         closeAngle[j] =
-            (std::atan(distortion / std::abs(offset)) < (M_PI / 8.0));
+            (std::atan(distortion / std::abs(offsets[j])) < (M_PI / 8.0));
       }
       else
       {
@@ -182,16 +190,58 @@ void DrusillaSelect<MatType>::Search(const MatType& querySet,
   // We'll use the NeighborSearchRules class to perform our brute-force search.
   // Note that we aren't using trees for our search, so we can use 'int' as a
   // TreeType.
-  metric::EuclideanDistance metric;
-  NeighborSearchRules<FurthestNeighborSort, metric::EuclideanDistance,
+  typedef NeighborSearchRules<FurthestNeighborSort, metric::EuclideanDistance,
       tree::KDTree<metric::EuclideanDistance, tree::EmptyStatistic, MatType>>
-      rules(candidateSet, querySet, k, metric, 0, false);
+      RuleType;
+  metric::EuclideanDistance metric;
+  RuleType rules(candidateSet, querySet, k, metric, 0, false);
+
+#ifdef HAS_OPENMP
+  const size_t numThreads = (size_t) omp_get_max_threads();
+  if (numThreads > 1 && querySet.n_cols > 1)
+  {
+    neighbors.set_size(k, querySet.n_cols);
+    distances.set_size(k, querySet.n_cols);
+
+    // Shard the query set across the threads, giving each its own copy of the
+    // rules (the per-query candidate lists are independent, but the base case
+    // cache is not).  Each thread extracts and stores the results for its own
+    // shard, so the shared output matrices are written without contention.
+    #pragma omp parallel
+    {
+      const size_t thread = (size_t) omp_get_thread_num();
+      const size_t actualThreads = (size_t) omp_get_num_threads();
+      const size_t shardBegin = (thread * querySet.n_cols) / actualThreads;
+      const size_t shardEnd =
+          ((thread + 1) * querySet.n_cols) / actualThreads;
 
-  for (size_t q = 0; q < querySet.n_cols; ++q)
-    for (size_t r = 0; r < candidateSet.n_cols; ++r)
-      rules.BaseCase(q, r);
+      if (shardEnd > shardBegin)
+      {
+        RuleType localRules(rules);
+        for (size_t q = shardBegin; q < shardEnd; ++q)
+          for (size_t r = 0; r < candidateSet.n_cols; ++r)
+            localRules.BaseCase(q, r);
+
+        arma::Mat<size_t> shardNeighbors;
+        arma::mat shardDistances;
+        localRules.GetResults(shardNeighbors, shardDistances);
 
-  rules.GetResults(neighbors, distances);
+        neighbors.cols(shardBegin, shardEnd - 1) =
+            shardNeighbors.cols(shardBegin, shardEnd - 1);
+        distances.cols(shardBegin, shardEnd - 1) =
+            shardDistances.cols(shardBegin, shardEnd - 1);
+      }
+    }
+  }
+  else
+#endif
+  {
+    for (size_t q = 0; q < querySet.n_cols; ++q)
+      for (size_t r = 0; r < candidateSet.n_cols; ++r)
+        rules.BaseCase(q, r);
+
+    rules.GetResults(neighbors, distances);
+  }
 
   // Map the neighbors back to their original indices in the reference set.
   for (size_t i = 0; i < neighbors.n_elem; ++i)
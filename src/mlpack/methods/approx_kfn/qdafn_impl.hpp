@@ -15,6 +15,7 @@
 // In case it hasn't been included yet.
 #include "qdafn.hpp"
 
+#include <algorithm>
 #include <queue>
 #include <mlpack/methods/neighbor_search/sort_policies/furthest_neighbor_sort.hpp>
 
@@ -104,8 +105,15 @@ void QDAFN<MatType>::Search(const MatType& querySet,
   neighbors.fill(size_t() - 1);
   distances.zeros(k, querySet.n_cols);
 
-  // Search for each point.
-  for (size_t q = 0; q < querySet.n_cols; ++q)
+  // Project the whole query set onto every table's line with one matrix
+  // product, instead of computing l dot products for each query separately.
+  const arma::mat queryProjections = lines.t() * querySet;
+
+  // Search for each point.  Each query is completely independent of the
+  // others and writes only to its own column of the output matrices, so the
+  // queries can be processed in parallel.
+  #pragma omp parallel for schedule(dynamic)
+  for (omp_size_t q = 0; q < (omp_size_t) querySet.n_cols; ++q)
   {
     // Initialize a priority queue.
     // The size_t represents the index of the table, and the double represents
@@ -113,8 +121,7 @@ void QDAFN<MatType>::Search(const MatType& querySet,
     std::priority_queue<std::pair<double, size_t>> queue;
     for (size_t i = 0; i < l; ++i)
     {
-      const double val = sValues(0, i) - arma::dot(querySet.col(q),
-          lines.col(i));
+      const double val = sValues(0, i) - queryProjections(i, q);
       queue.push(std::make_pair(val, i));
     }
 
@@ -122,14 +129,13 @@ void QDAFN<MatType>::Search(const MatType& querySet,
     // in each table (they start at 0).
     arma::Col<size_t> tableLocations = arma::zeros<arma::Col<size_t>>(l);
 
-    // Now that the queue is initialized, iterate over m elements.
-    std::vector<std::pair<double, size_t>> v(k, std::make_pair(-1.0,
-        size_t(-1)));
-    std::priority_queue<std::pair<double, size_t>>
-        resultsQueue(std::less<std::pair<double, size_t>>(), std::move(v));
+    // Now that the queue is initialized, iterate over m elements, collecting
+    // the candidates in a preallocated buffer.
+    std::vector<std::pair<double, size_t>> results;
+    results.reserve(m);
     for (size_t i = 0; i < m; ++i)
     {
-      std::pair<size_t, double> p = queue.top();
+      const std::pair<double, size_t> p = queue.top();
       queue.pop();
 
       // Get index of reference point to look at.
@@ -139,7 +145,7 @@ void QDAFN<MatType>::Search(const MatType& querySet,
       const double dist = mlpack::metric::EuclideanDistance::Evaluate(
           querySet.col(q), candidateSet[p.second].col(tableIndex));
 
-      resultsQueue.push(std::make_pair(dist, sIndices(tableIndex, p.second)));
+      results.push_back(std::make_pair(dist, sIndices(tableIndex, p.second)));
 
       // Now (line 14) get the next element and insert into the queue.  Do this
       // by adjusting the previous value.  Don't insert anything if we are at
@@ -154,25 +160,30 @@ void QDAFN<MatType>::Search(const MatType& querySet,
       }
     }
 
-    // Extract the results and deduplicate them.
-    size_t extracted = 1;
-    neighbors(0, q) = resultsQueue.top().second;
-    distances(0, q) = resultsQueue.top().first;
-    resultsQueue.pop();
+    // Sort the candidates by descending distance and extract the top k,
+    // skipping duplicates: the same reference point may be the top candidate
+    // of several tables.  k is small, so a linear scan over the neighbors
+    // already extracted is cheap.
+    std::sort(results.begin(), results.end(),
+        std::greater<std::pair<double, size_t>>());
 
-    while (!resultsQueue.empty())
+    size_t extracted = 0;
+    for (size_t i = 0; i < results.size() && extracted < k; ++i)
     {
-      if (extracted == k)
-        break;
-
-      std::pair<double, size_t> result = resultsQueue.top();
-      resultsQueue.pop();
+      bool duplicate = false;
+      for (size_t j = 0; j < extracted; ++j)
+      {
+        if (neighbors(j, q) == results[i].second)
+        {
+          duplicate = true;
+          break;
+        }
+      }
 
-      // Avoid inserting any duplicates.
-      if (neighbors(extracted - 1, q) != result.second)
+      if (!duplicate)
       {
-        neighbors(extracted, q) = resultsQueue.top().second;
-        distances(extracted, q) = resultsQueue.top().first;
+        neighbors(extracted, q) = results[i].second;
+        distances(extracted, q) = results[i].first;
         ++extracted;
       }
     }
@@ -95,6 +95,21 @@ class BiasSVD
   double lambda;
 };
 
+/**
+ * Hogwild-style parallel training mode.  When BiasSVD is instantiated with
+ * ens::ParallelSGD<ens::ConstantStep>, Apply() shards the ratings evenly
+ * across the OpenMP threads and applies unsynchronized SGD updates to the
+ * factors and biases.
+ */
+template<>
+void BiasSVD<ens::ParallelSGD<ens::ConstantStep>>::Apply(
+    const arma::mat& data,
+    const size_t rank,
+    arma::mat& u,
+    arma::mat& v,
+    arma::vec& p,
+    arma::vec& q);
+
 } // namespace svd
 } // namespace mlpack
 
@@ -63,6 +63,55 @@ void BiasSVD<OptimizerType>::Apply(const arma::mat& data,
   q = parameters.row(rank).subvec(0, numUsers - 1).t();
 }
 
+/**
+ * Hogwild-style parallel training.  A rating only touches the factor columns
+ * and biases of its own user and item, so unsynchronized updates from
+ * different threads collide rarely and the factorization converges as in the
+ * serial case.
+ */
+template<>
+inline void BiasSVD<ens::ParallelSGD<ens::ConstantStep>>::Apply(
+    const arma::mat& data,
+    const size_t rank,
+    arma::mat& u,
+    arma::mat& v,
+    arma::vec& p,
+    arma::vec& q)
+{
+  // Make the optimizer object using a BiasSVDFunction object.
+  BiasSVDFunction<arma::mat> biasSVDFunc(data, rank, lambda);
+
+  #ifdef HAS_OPENMP
+  const size_t threads = omp_get_max_threads();
+  #else
+  const size_t threads = 1;
+  Log::Warn << "Using parallel SGD, but OpenMP support is not available!"
+      << std::endl;
+  #endif
+
+  // Shard the ratings evenly across the threads; each iteration is one epoch
+  // over the whole dataset.
+  ens::ConstantStep decayPolicy(alpha);
+  ens::ParallelSGD<ens::ConstantStep> optimizer(iterations,
+      std::ceil((double) biasSVDFunc.NumFunctions() / threads), 1e-5, true,
+      decayPolicy);
+
+  // Get optimized parameters.
+  arma::mat parameters = biasSVDFunc.GetInitialPoint();
+  optimizer.Optimize(biasSVDFunc, parameters);
+
+  // Constants for extracting user and item matrices.
+  const size_t numUsers = max(data.row(0)) + 1;
+  const size_t numItems = max(data.row(1)) + 1;
+
+  // Extract user and item matrices, user and item bias from the optimized
+  // parameters.
+  u = parameters.submat(0, numUsers, rank - 1, numUsers + numItems - 1).t();
+  v = parameters.submat(0, 0, rank - 1, numUsers - 1);
+  p = parameters.row(rank).subvec(numUsers, numUsers + numItems - 1).t();
+  q = parameters.row(rank).subvec(0, numUsers - 1).t();
+}
+
 } // namespace svd
 } // namespace mlpack
 
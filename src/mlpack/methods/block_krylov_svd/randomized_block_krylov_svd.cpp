@@ -21,9 +21,11 @@ RandomizedBlockKrylovSVD::RandomizedBlockKrylovSVD(const arma::mat& data,
                                                    arma::mat& v,
                                                    const size_t maxIterations,
                                                    const size_t rank,
-                                                   const size_t blockSize) :
+                                                   const size_t blockSize,
+                                                   const size_t maxBasisBlocks) :
     maxIterations(maxIterations),
-    blockSize(blockSize)
+    blockSize(blockSize),
+    maxBasisBlocks(maxBasisBlocks)
 {
   if (rank == 0)
   {
@@ -36,9 +38,11 @@ RandomizedBlockKrylovSVD::RandomizedBlockKrylovSVD(const arma::mat& data,
 }
 
 RandomizedBlockKrylovSVD::RandomizedBlockKrylovSVD(const size_t maxIterations,
-                                                   const size_t blockSize) :
+                                                   const size_t blockSize,
+                                                   const size_t maxBasisBlocks) :
     maxIterations(maxIterations),
-    blockSize(blockSize)
+    blockSize(blockSize),
+    maxBasisBlocks(maxBasisBlocks)
 {
   /* Nothing to do here */
 }
@@ -49,47 +53,9 @@ void RandomizedBlockKrylovSVD::Apply(const arma::mat& data,
                                      arma::mat& v,
                                      const size_t rank)
 {
-  arma::mat Q, R, block, blockIteration;
-
-  if (blockSize == 0)
-  {
-    blockSize = rank + 10;
-  }
-
-  // Random block initialization.
-  arma::mat G = arma::randn(data.n_cols, blockSize);
-
-  // Construct and orthonormalize Krylov subspace.
-  arma::mat K(data.n_rows, blockSize * (maxIterations + 1));
-
-  // Create a working matrix using data from writable auxiliary memory
-  // (K matrix). Doing so avoids an uncessary copy in upcoming step.
-  block = arma::mat(K.memptr(), data.n_rows, blockSize, false, false);
-  arma::qr_econ(block, R, data * G);
-
-  for (size_t blockOffset = block.n_elem; blockOffset < K.n_elem;
-      blockOffset += block.n_elem)
-  {
-    // Temporary working matrix to store the result in the correct place.
-    blockIteration = arma::mat(K.memptr() + blockOffset, block.n_rows,
-        block.n_cols, false, false);
-
-    arma::qr_econ(blockIteration, R, data * (data.t() * block));
-
-    // Update working matrix for the next iteration.
-    block = arma::mat(K.memptr() + blockOffset, block.n_rows, block.n_cols,
-        false, false);
-  }
-
-  arma::qr_econ(Q, R, K);
-
-  // Approximate eigenvalues and eigenvectors using Rayleigh–Ritz method.
-  arma::svd_econ(u, s, v, Q.t() * data);
-
-  // Do economical singular value decomposition and compute only the
-  // approximations of the left singular vectors by using the centered data
-  // applied to Q.
-  u = Q * u;
+  // Route the in-memory matrix through the operand interface; the templated
+  // overload implements the (optionally restarted) block Krylov iteration.
+  Apply(MatrixOperand(data), u, s, v, rank);
 }
 
 } // namespace svd
@@ -55,6 +55,42 @@ namespace svd {
  * bSVD.Apply(data, u, s, v, rank);
  * @endcode
  */
+/**
+ * Adapter that presents an in-memory Armadillo matrix through the operand
+ * interface expected by the templated
+ * RandomizedBlockKrylovSVD::Apply() overload.  A user-supplied operand type
+ * only needs to provide the same four members; the products may then be
+ * computed matrix-free or by streaming chunks from disk, so the data never
+ * has to exist as a single in-memory matrix.
+ */
+class MatrixOperand
+{
+ public:
+  //! Wrap the given matrix (a reference is kept, not a copy).
+  explicit MatrixOperand(const arma::mat& data) : data(data) { }
+
+  //! Get the number of rows of the operand.
+  size_t NumRows() const { return data.n_rows; }
+  //! Get the number of columns of the operand.
+  size_t NumCols() const { return data.n_cols; }
+
+  //! Compute out = A * x.
+  void Multiply(const arma::mat& x, arma::mat& out) const
+  {
+    out = data * x;
+  }
+
+  //! Compute out = A^T * x.
+  void MultiplyTranspose(const arma::mat& x, arma::mat& out) const
+  {
+    out = data.t() * x;
+  }
+
+ private:
+  //! The wrapped matrix.
+  const arma::mat& data;
+};
+
 class RandomizedBlockKrylovSVD
 {
  public:
@@ -69,6 +105,10 @@ class RandomizedBlockKrylovSVD
    *        (Default: 2).
    * @param rank Rank of the approximation (Default: number of rows.)
    * @param blockSize The block size, must be >= rank (Default: rank + 10).
+   * @param maxBasisBlocks Maximum number of Krylov blocks held in memory at
+   *        once; when the bound is reached, the method restarts from the
+   *        current singular vector estimate.  0 means no restarting
+   *        (Default: 0).
    */
   RandomizedBlockKrylovSVD(const arma::mat& data,
                            arma::mat& u,
@@ -76,7 +116,8 @@ class RandomizedBlockKrylovSVD
                            arma::mat& v,
                            const size_t maxIterations = 2,
                            const size_t rank = 0,
-                           const size_t blockSize = 0);
+                           const size_t blockSize = 0,
+                           const size_t maxBasisBlocks = 0);
 
   /**
    * Create object for the randomized block krylov SVD method.
@@ -84,9 +125,12 @@ class RandomizedBlockKrylovSVD
    * @param maxIterations Number of iterations for the power method
    *        (Default: 2).
    * @param blockSize The block size, must be >= rank (Default: rank + 10).
+   * @param maxBasisBlocks Maximum number of Krylov blocks held in memory at
+   *        once; 0 means no restarting (Default: 0).
    */
   RandomizedBlockKrylovSVD(const size_t maxIterations = 2,
-                           const size_t blockSize = 0);
+                           const size_t blockSize = 0,
+                           const size_t maxBasisBlocks = 0);
 
   /**
    * Apply Principal Component Analysis to the provided data set using the
@@ -104,6 +148,102 @@ class RandomizedBlockKrylovSVD
              arma::mat& v,
              const size_t rank);
 
+  /**
+   * Apply the randomized block krylov SVD to the given operand, which only
+   * has to provide NumRows(), NumCols(), Multiply() and MultiplyTranspose()
+   * (see MatrixOperand for the reference implementation).  This allows
+   * matrix-free and out-of-core operators, e.g. operators that stream the
+   * matrix in chunks from disk for each product.
+   *
+   * If a maximum basis size is set, the Krylov basis is never grown beyond
+   * maxBasisBlocks blocks; instead, the method computes a Rayleigh-Ritz
+   * estimate and restarts the basis from the current top right singular
+   * vectors, repeating until maxIterations blocks have been processed.  This
+   * bounds the memory used by the basis regardless of the iteration count.
+   *
+   * @param operand Operand providing products with the implicit matrix.
+   * @param u First unitary matrix.
+   * @param v Second unitary matrix.
+   * @param s Diagonal matrix of singular values.
+   * @param rank Rank of the approximation.
+   */
+  template<typename OperandType>
+  void Apply(const OperandType& operand,
+             arma::mat& u,
+             arma::vec& s,
+             arma::mat& v,
+             const size_t rank)
+  {
+    arma::mat Q, R, K, block, tmp, tmp2;
+
+    if (blockSize == 0)
+    {
+      blockSize = rank + 10;
+    }
+
+    // Number of Krylov blocks held in memory at once.  At least two blocks
+    // are needed to make progress between restarts; without a bound, the
+    // whole basis is kept as before.
+    size_t basisBlocks = maxIterations + 1;
+    if (maxBasisBlocks > 0)
+    {
+      basisBlocks = std::min(std::max(maxBasisBlocks, (size_t) 2),
+          maxIterations + 1);
+    }
+
+    // Random block initialization.
+    arma::mat G = arma::randn(operand.NumCols(), blockSize);
+
+    // Number of additional Krylov blocks still to be built.
+    size_t remaining = maxIterations;
+    while (true)
+    {
+      const size_t blocksThisPass = std::min(basisBlocks - 1, remaining);
+
+      // Construct and orthonormalize the (bounded) Krylov subspace, starting
+      // from the current starting block.
+      K.set_size(operand.NumRows(), blockSize * (blocksThisPass + 1));
+
+      operand.Multiply(G, tmp);
+      arma::qr_econ(block, R, tmp);
+      K.cols(0, blockSize - 1) = block;
+
+      for (size_t b = 1; b <= blocksThisPass; ++b)
+      {
+        operand.MultiplyTranspose(block, tmp);
+        operand.Multiply(tmp, tmp2);
+        arma::qr_econ(block, R, tmp2);
+        K.cols(b * blockSize, (b + 1) * blockSize - 1) = block;
+      }
+      remaining -= blocksThisPass;
+
+      arma::qr_econ(Q, R, K);
+
+      // Approximate eigenvalues and eigenvectors using Rayleigh–Ritz method.
+      operand.MultiplyTranspose(Q, tmp);
+      arma::svd_econ(u, s, v, arma::trans(tmp));
+
+      // Compute only the approximations of the left singular vectors by
+      // using the operand applied to Q.
+      u = Q * u;
+
+      if (remaining == 0)
+        break;
+
+      // Restart: seed the next basis with the current top right singular
+      // vectors, padded with fresh random directions to fill the block.
+      if (v.n_cols >= blockSize)
+      {
+        G = v.cols(0, blockSize - 1);
+      }
+      else
+      {
+        G = arma::join_rows(v, arma::randn(operand.NumCols(),
+            blockSize - v.n_cols));
+      }
+    }
+  }
+
   //! Get the number of iterations for the power method.
   size_t MaxIterations() const { return maxIterations; }
   //! Modify the number of iterations for the power method.
@@ -114,12 +254,20 @@ class RandomizedBlockKrylovSVD
   //! Modify the block size.
   size_t& BlockSize() { return blockSize; }
 
+  //! Get the maximum number of in-memory Krylov blocks (0 = no restarting).
+  size_t MaxBasisBlocks() const { return maxBasisBlocks; }
+  //! Modify the maximum number of in-memory Krylov blocks.
+  size_t& MaxBasisBlocks() { return maxBasisBlocks; }
+
  private:
   //! Locally stored number of iterations for the power method.
   size_t maxIterations;
 
   //! The block size value.
   size_t blockSize;
+
+  //! Maximum number of Krylov blocks held in memory (0 = no restarting).
+  size_t maxBasisBlocks;
 };
 
 } // namespace svd
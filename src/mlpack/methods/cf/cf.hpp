@@ -153,6 +153,8 @@ class CFType
       return;
     }
     this->numUsersForSimilarity = num;
+    // Cached neighborhoods were computed for the old neighborhood size.
+    neighborhoodCached = false;
   }
 
   //! Gets number of users for calculating similarity.
@@ -216,6 +218,23 @@ class CFType
                           arma::Mat<size_t>& recommendations,
                           const arma::Col<size_t>& users);
 
+  /**
+   * Precompute and cache the neighborhood of every user.  Afterwards,
+   * GetRecommendations() serves queries from the cache instead of running a
+   * fresh neighbor search per call, which is the dominant cost of a request.
+   * The cache is invalidated whenever the model is retrained with new ratings
+   * or the neighborhood size changes, and GetRecommendations() must be called
+   * with the same NeighborSearchPolicy the cache was built with for the
+   * results to be meaningful.
+   *
+   * @tparam NeighborSearchPolicy The policy used to search neighbors.
+   */
+  template<typename NeighborSearchPolicy = EuclideanSearch>
+  void CacheNeighborhoods();
+
+  //! Get whether the user neighborhoods are currently cached.
+  bool NeighborhoodCached() const { return neighborhoodCached; }
+
   //! Converts the User, Item, Value Matrix to User-Item Table.
   static void CleanData(const arma::mat& data, arma::sp_mat& cleanedData);
 
@@ -274,6 +293,13 @@ class CFType
   //! Data normalization object.
   NormalizationType normalization;
 
+  //! Whether cachedNeighborhood and cachedSimilarities are valid.
+  bool neighborhoodCached;
+  //! Cached neighborhood of every user (column u holds user u's neighbors).
+  arma::Mat<size_t> cachedNeighborhood;
+  //! Cached similarities corresponding to cachedNeighborhood.
+  arma::mat cachedSimilarities;
+
   //! Candidate represents a possible recommendation (value, item).
   typedef std::pair<double, size_t> Candidate;
 
@@ -30,7 +30,8 @@ CFType<DecompositionPolicy,
 CFType(const size_t numUsersForSimilarity,
        const size_t rank) :
     numUsersForSimilarity(numUsersForSimilarity),
-    rank(rank)
+    rank(rank),
+    neighborhoodCached(false)
 {
   // Validate neighbourhood size.
   if (numUsersForSimilarity < 1)
@@ -58,7 +59,8 @@ CFType(const MatType& data,
        const double minResidue,
        const bool mit) :
     numUsersForSimilarity(numUsersForSimilarity),
-    rank(rank)
+    rank(rank),
+    neighborhoodCached(false)
 {
   // Validate neighbourhood size.
   if (numUsersForSimilarity < 1)
@@ -85,6 +87,9 @@ Train(const arma::mat& data,
 {
   this->decomposition = decomposition;
 
+  // Any cached neighborhoods were computed on the old factorization.
+  neighborhoodCached = false;
+
   // Make a copy of data before performing normalization.
   arma::mat normalizedData(data);
   normalization.Normalize(normalizedData);
@@ -126,6 +131,9 @@ Train(const arma::sp_mat& data,
 {
   this->decomposition = decomposition;
 
+  // Any cached neighborhoods were computed on the old factorization.
+  neighborhoodCached = false;
+
   // data is not used in the following decomposition.Apply() method, so we only
   // need to Normalize cleanedData.
   cleanedData = data;
@@ -193,10 +201,24 @@ GetRecommendations(const size_t numRecs,
   // Calculate the neighborhood of the queried users.  Note that the query user
   // is part of the neighborhood---this is intentional.  We want to use the
   // weighted sum of both the query user and the local neighborhood of the
-  // query user.
-  // Calculate the neighborhood of the queried users.
-  decomposition.template GetNeighborhood<NeighborSearchPolicy>(
-      users, numUsersForSimilarity, neighborhood, similarities);
+  // query user.  If the neighborhoods have been cached with
+  // CacheNeighborhoods(), serve them from the cache instead of running a
+  // fresh search.
+  if (neighborhoodCached)
+  {
+    neighborhood.set_size(numUsersForSimilarity, users.n_elem);
+    similarities.set_size(numUsersForSimilarity, users.n_elem);
+    for (size_t i = 0; i < users.n_elem; i++)
+    {
+      neighborhood.col(i) = cachedNeighborhood.col(users(i));
+      similarities.col(i) = cachedSimilarities.col(users(i));
+    }
+  }
+  else
+  {
+    decomposition.template GetNeighborhood<NeighborSearchPolicy>(
+        users, numUsersForSimilarity, neighborhood, similarities);
+  }
 
   // Generate recommendations for each query user by finding the maximum numRecs
   // elements in the ratings vector.
@@ -210,23 +232,45 @@ GetRecommendations(const size_t numRecs,
   // time and we don't want to repeat the initialization process in each loop.
   InterpolationPolicy interpolation(cleanedData);
 
+  // Calculate the interpolation weights of every queried user.
+  arma::mat weights(numUsersForSimilarity, users.n_elem);
   for (size_t i = 0; i < users.n_elem; i++)
   {
-    // First, calculate the weighted sum of neighborhood values.
-    arma::vec ratings;
-    ratings.zeros(cleanedData.n_rows);
-
-    // Calculate interpolation weights.
-    arma::vec weights(numUsersForSimilarity);
-    interpolation.GetWeights(weights, decomposition, users(i),
+    interpolation.GetWeights(weights.col(i), decomposition, users(i),
         neighborhood.col(i), similarities.col(i), cleanedData);
+  }
+
+  // Batch-score the candidate items for the whole request: the rating vector
+  // of each distinct neighbor is computed only once (neighborhoods of similar
+  // users overlap heavily), and the weighted sums of every queried user are
+  // then a single matrix product.
+  const arma::Col<size_t> distinctNeighbors =
+      arma::unique(arma::vectorise(neighborhood));
+  std::map<size_t, size_t> neighborIndex;
+  for (size_t j = 0; j < distinctNeighbors.n_elem; ++j)
+    neighborIndex[distinctNeighbors(j)] = j;
+
+  arma::mat neighborRatings(cleanedData.n_rows, distinctNeighbors.n_elem);
+  for (size_t j = 0; j < distinctNeighbors.n_elem; ++j)
+  {
+    arma::vec neighborRating;
+    decomposition.GetRatingOfUser(distinctNeighbors(j), neighborRating);
+    neighborRatings.col(j) = neighborRating;
+  }
 
+  arma::mat combineWeights(distinctNeighbors.n_elem, users.n_elem,
+      arma::fill::zeros);
+  for (size_t i = 0; i < users.n_elem; i++)
     for (size_t j = 0; j < neighborhood.n_rows; ++j)
-    {
-      arma::vec neighborRatings;
-      decomposition.GetRatingOfUser(neighborhood(j, i), neighborRatings);
-      ratings += weights(j) * neighborRatings;
-    }
+      combineWeights(neighborIndex[neighborhood(j, i)], i) += weights(j, i);
+
+  // One GEMM scores every candidate item for every queried user.
+  const arma::mat batchRatings = neighborRatings * combineWeights;
+
+  for (size_t i = 0; i < users.n_elem; i++)
+  {
+    // The weighted sum of neighborhood values for this user.
+    const arma::vec ratings = batchRatings.col(i);
 
     // Let's build the list of candidate recomendations for the given user.
     // Default candidate: the smallest possible value and invalid item number.
@@ -273,6 +317,27 @@ GetRecommendations(const size_t numRecs,
   }
 }
 
+// Precompute the neighborhood of every user for serving recommendations.
+template<typename DecompositionPolicy,
+         typename NormalizationType>
+template<typename NeighborSearchPolicy>
+void CFType<DecompositionPolicy,
+            NormalizationType>::
+CacheNeighborhoods()
+{
+  // One search over all users; GetRecommendations() then serves any subset of
+  // users from the cached columns.
+  arma::Col<size_t> users = arma::linspace<arma::Col<size_t>>(0,
+      cleanedData.n_cols - 1, cleanedData.n_cols);
+
+  Timer::Start("cf_cache_neighborhoods");
+  decomposition.template GetNeighborhood<NeighborSearchPolicy>(
+      users, numUsersForSimilarity, cachedNeighborhood, cachedSimilarities);
+  Timer::Stop("cf_cache_neighborhoods");
+
+  neighborhoodCached = true;
+}
+
 // Predict the rating for a single user/item combination.
 template<typename DecompositionPolicy,
          typename NormalizationType>
@@ -436,6 +501,9 @@ serialize(Archive& ar, const unsigned int /* version */)
   ar & BOOST_SERIALIZATION_NVP(decomposition);
   ar & BOOST_SERIALIZATION_NVP(cleanedData);
   ar & BOOST_SERIALIZATION_NVP(normalization);
+  ar & BOOST_SERIALIZATION_NVP(neighborhoodCached);
+  ar & BOOST_SERIALIZATION_NVP(cachedNeighborhood);
+  ar & BOOST_SERIALIZATION_NVP(cachedSimilarities);
 }
 
 } // namespace cf
@@ -15,7 +15,8 @@
 
 #include <mlpack/core.hpp>
 #include <mlpack/methods/range_search/range_search.hpp>
-#include <mlpack/methods/emst/union_find.hpp>
+#include <mlpack/methods/emst/concurrent_union_find.hpp>
+#include "grid_range_search.hpp"
 #include "random_point_selection.hpp"
 #include "ordered_point_selection.hpp"
 #include <boost/dynamic_bitset.hpp>
@@ -42,7 +43,9 @@ namespace dbscan {
  * The DBSCAN algorithm iteratively clusters points using range searches with a
  * specified radius parameter.  This implementation allows configuration of the
  * range search technique used and the point selection strategy by means of
- * template parameters.
+ * template parameters.  For low-dimensional data (roughly 2-4 dimensions),
+ * GridRangeSearch can be used as the RangeSearchType for significantly faster
+ * clustering than any tree-based range search.
  *
  * @tparam RangeSearchType Class to use for range searching.
  * @tparam PointSelectionPolicy Strategy for selecting next point to cluster
@@ -137,11 +140,11 @@ class DBSCAN
    *
    * @param data Dataset to cluster.
    * @param assignments Assignments for each point.
-   * @param uf UnionFind structure that will be modified.
+   * @param uf Union-find structure that will be modified.
    */
   template<typename MatType>
   void PointwiseCluster(const MatType& data,
-                        emst::UnionFind& uf);
+                        emst::ConcurrentUnionFind& uf);
 
   /**
    * Performs DBSCAN clustering on the data, returning number of clusters
@@ -150,11 +153,11 @@ class DBSCAN
    *
    * @param data Dataset to cluster.
    * @param assignments Assignments for each point.
-   * @param uf UnionFind structure that will be modified.
+   * @param uf Union-find structure that will be modified.
    */
   template<typename MatType>
   void BatchCluster(const MatType& data,
-                    emst::UnionFind& uf);
+                    emst::ConcurrentUnionFind& uf);
 };
 
 } // namespace dbscan
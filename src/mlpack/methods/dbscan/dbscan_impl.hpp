@@ -100,8 +100,9 @@ size_t DBSCAN<RangeSearchType, PointSelectionPolicy>::Cluster(
     const MatType& data,
     arma::Row<size_t>& assignments)
 {
-  // Initialize the UnionFind object.
-  emst::UnionFind uf(data.n_cols);
+  // Initialize the union-find object.  The concurrent variant is used so that
+  // BatchCluster() can perform its unions in parallel.
+  emst::ConcurrentUnionFind uf(data.n_cols);
   rangeSearch.Train(data);
 
   if (batchMode)
@@ -150,7 +151,7 @@ template<typename RangeSearchType, typename PointSelectionPolicy>
 template<typename MatType>
 void DBSCAN<RangeSearchType, PointSelectionPolicy>::PointwiseCluster(
     const MatType& data,
-    emst::UnionFind& uf)
+    emst::ConcurrentUnionFind& uf)
 {
   std::vector<std::vector<size_t>> neighbors;
   std::vector<std::vector<double>> distances;
@@ -179,7 +180,7 @@ template<typename RangeSearchType, typename PointSelectionPolicy>
 template<typename MatType>
 void DBSCAN<RangeSearchType, PointSelectionPolicy>::BatchCluster(
     const MatType& data,
-    emst::UnionFind& uf)
+    emst::ConcurrentUnionFind& uf)
 {
   // For each point, find the points in epsilon-nighborhood and their distances.
   std::vector<std::vector<size_t>> neighbors;
@@ -189,11 +190,19 @@ void DBSCAN<RangeSearchType, PointSelectionPolicy>::BatchCluster(
   rangeSearch.Search(data, math::Range(0.0, epsilon), neighbors, distances);
   Log::Info << "Range search complete." << std::endl;
 
-  // Now loop over all points.
+  // Select the processing order up front; the selection policy may use the
+  // global random number generator, which is not safe to call concurrently.
+  std::vector<size_t> order(data.n_cols);
   for (size_t i = 0; i < data.n_cols; ++i)
+    order[i] = pointSelector.Select(i, data);
+
+  // Now loop over all points.  The union-find structure is lock-free, so the
+  // unions can be performed in parallel; the final components do not depend
+  // on the order in which the unions happen.
+  #pragma omp parallel for schedule(dynamic, 128)
+  for (omp_size_t i = 0; i < (omp_size_t) data.n_cols; ++i)
   {
-    // Get the next index.
-    const size_t index = pointSelector.Select(i, data);
+    const size_t index = order[i];
     for (size_t j = 0; j < neighbors[index].size(); ++j)
       uf.Union(index, neighbors[index][j]);
   }
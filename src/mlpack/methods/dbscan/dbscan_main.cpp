@@ -10,6 +10,7 @@
  * http://www.opensource.org/licenses/BSD-3-Clause for more information.
  */
 #include <mlpack/prereqs.hpp>
+#include <mlpack/core/data/assignment_writer.hpp>
 #include <mlpack/core/util/cli.hpp>
 #include <mlpack/core/util/mlpack_main.hpp>
 #include <mlpack/core/tree/binary_space_tree.hpp>
@@ -55,7 +56,11 @@ PROGRAM_INFO("DBSCAN clustering",
     PRINT_PARAM_STRING("naive") + " parameters.  " +
     PRINT_PARAM_STRING("tree_type") + " can control the type of tree used for "
     "range search; this can take a variety of values: 'kd', 'r', 'r-star', 'x',"
-    " 'hilbert-r', 'r-plus', 'r-plus-plus', 'cover', 'ball'. The " +
+    " 'hilbert-r', 'r-plus', 'r-plus-plus', 'cover', 'ball', 'grid'.  The "
+    "'grid' option does not use a tree at all, but instead hashes the points "
+    "into a uniform grid; it is usually by far the fastest option for "
+    "low-dimensional data (2 to 4 dimensions, e.g. geospatial coordinates), "
+    "but should not be used for higher-dimensional data.  The " +
     PRINT_PARAM_STRING("single_mode") + " parameter will force single-tree "
     "search (as opposed to the default dual-tree search), and '" +
     PRINT_PARAM_STRING("naive") + " will force brute-force range search."
@@ -77,12 +82,16 @@ PARAM_UROW_OUT("assignments", "Output matrix for assignments of each "
     "point.", "a");
 PARAM_MATRIX_OUT("centroids", "Matrix to save output centroids to.", "C");
 
+PARAM_STRING_IN("streaming_output", "If specified, cluster assignments are "
+    "streamed to this file chunk-wise (one assignment per line) instead of "
+    "being materialized as a full output matrix.", "o", "");
+
 PARAM_DOUBLE_IN("epsilon", "Radius of each range search.", "e", 1.0);
 PARAM_INT_IN("min_size", "Minimum number of points for a cluster.", "m", 5);
 
 PARAM_STRING_IN("tree_type", "If using single-tree or dual-tree search, the "
     "type of tree to use ('kd', 'r', 'r-star', 'x', 'hilbert-r', 'r-plus', "
-    "'r-plus-plus', 'cover', 'ball').", "t", "kd");
+    "'r-plus-plus', 'cover', 'ball', 'grid').", "t", "kd");
 PARAM_STRING_IN("selection_type", "If using point selection policy, the "
     "type of selection to use ('ordered', 'random').", "s", "ordered");
 PARAM_FLAG("single_mode", "If set, single-tree range search (not dual-tree) "
@@ -121,6 +130,15 @@ void RunDBSCAN(RangeSearchType rs,
     d.Cluster(dataset, assignments);
   }
 
+  // Stream the assignments out chunk-wise if requested.  The clustering
+  // itself needs the assignments row in memory, but this avoids building a
+  // second full-size output matrix for the results.
+  if (CLI::HasParam("streaming_output"))
+  {
+    data::AssignmentWriter writer(CLI::GetParam<string>("streaming_output"));
+    writer.Write(assignments);
+  }
+
   if (CLI::HasParam("assignments"))
     CLI::GetParam<arma::Row<size_t>>("assignments") = std::move(assignments);
 }
@@ -139,13 +157,13 @@ void ChoosePointSelectionPolicy(RangeSearchType rs = RangeSearchType())
 
 static void mlpackMain()
 {
-  RequireAtLeastOnePassed({ "assignments", "centroids" }, false,
-      "no output will be saved");
+  RequireAtLeastOnePassed({ "assignments", "centroids", "streaming_output" },
+      false, "no output will be saved");
 
   ReportIgnoredParam({{ "naive", true }}, "single_mode");
 
   RequireParamInSet<string>("tree_type", { "kd", "cover", "r", "r-star", "x",
-      "hilbert-r", "r-plus", "r-plus-plus", "ball" }, true,
+      "hilbert-r", "r-plus", "r-plus-plus", "ball", "grid" }, true,
       "unknown tree type");
 
   // Value of epsilon should be positive.
@@ -209,5 +227,9 @@ static void mlpackMain()
       ChoosePointSelectionPolicy<RangeSearch<EuclideanDistance, arma::mat,
           BallTree>>();
     }
+    else if (treeType == "grid")
+    {
+      ChoosePointSelectionPolicy<GridRangeSearch>();
+    }
   }
 }
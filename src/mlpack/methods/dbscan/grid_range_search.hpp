@@ -0,0 +1,134 @@
+/**
+ * @file methods/dbscan/grid_range_search.hpp
+ * @author Ryan Curtin
+ *
+ * A uniform grid hash for epsilon-range search in low dimensions.  This is a
+ * drop-in range search policy for DBSCAN: for 2-4 dimensional data (such as
+ * geospatial coordinates) hashing each point into a cell of side length
+ * epsilon and scanning only the neighboring cells is dramatically faster than
+ * a tree-based range search.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_DBSCAN_GRID_RANGE_SEARCH_HPP
+#define MLPACK_METHODS_DBSCAN_GRID_RANGE_SEARCH_HPP
+
+#include <mlpack/prereqs.hpp>
+#include <mlpack/core/metrics/lmetric.hpp>
+#include <algorithm>
+#include <functional>
+#include <unordered_map>
+
+namespace mlpack {
+namespace dbscan {
+
+/**
+ * The GridRangeSearch class performs exact Euclidean range search by hashing
+ * the reference points into a uniform grid whose cell side length equals the
+ * upper bound of the search range.  All points within range of a query then
+ * lie in the query's cell or one of its immediate neighbors, so each query
+ * only needs to scan 3^d cells.  Because candidates are verified with exact
+ * distance computations, the results are identical to those of RangeSearch.
+ *
+ * The number of scanned cells grows exponentially with the dimensionality, so
+ * this class is only useful for low-dimensional data (roughly d <= 4); for
+ * higher-dimensional data, use RangeSearch instead.  The grid is built lazily
+ * at the first Search() call (the cell size depends on the search range), and
+ * rebuilt if a later search uses a different upper bound.
+ *
+ * This class satisfies the RangeSearchType policy of DBSCAN, so it can be
+ * used as a drop-in replacement for RangeSearch there.
+ */
+class GridRangeSearch
+{
+ public:
+  /**
+   * Construct the GridRangeSearch object with an empty reference set.  Train()
+   * must be called before Search().
+   */
+  GridRangeSearch();
+
+  /**
+   * Set the reference set to the given dataset.  The dataset is copied; the
+   * grid itself is built lazily at the first Search() call, since the cell
+   * size depends on the search range.
+   *
+   * @param referenceSet New reference set to use.
+   */
+  void Train(const arma::mat& referenceSet);
+
+  /**
+   * Search for all reference points in the given range for each point in the
+   * query set, returning the results in the neighbors and distances objects.
+   * Each entry in the external vector corresponds to a query point; the
+   * matching entries of neighbors and distances are built in the same order.
+   *
+   * If the upper bound of the range differs from the one used by the previous
+   * search, the grid is rebuilt with the new cell size.
+   *
+   * @param querySet Set of query points (each column is a point).
+   * @param range Range of distances for which to search.
+   * @param neighbors Object which will hold the list of neighbors for each
+   *      query point.
+   * @param distances Object which will hold the list of distances for each
+   *      query point.
+   */
+  void Search(const arma::mat& querySet,
+              const math::Range& range,
+              std::vector<std::vector<size_t>>& neighbors,
+              std::vector<std::vector<double>>& distances);
+
+  //! Get whether single-tree search is being used.  This has no effect on
+  //! GridRangeSearch (each query is always searched independently), but is
+  //! provided for compatibility with the RangeSearch interface.
+  bool SingleMode() const { return singleMode; }
+  //! Modify whether single-tree search is being used (no effect).
+  bool& SingleMode() { return singleMode; }
+
+  //! Get the reference set.
+  const arma::mat& ReferenceSet() const { return referenceSet; }
+
+ private:
+  //! The copied reference set.
+  arma::mat referenceSet;
+
+  //! Side length of each grid cell; 0 means the grid has not been built yet.
+  double cellSize;
+
+  //! Maps the hash of a cell's integer coordinates to the indices of the
+  //! reference points that fall in that cell.  Distinct cells may collide in
+  //! the same bucket; this only adds candidates, which the exact distance
+  //! check filters out.
+  std::unordered_map<size_t, std::vector<size_t>> grid;
+
+  //! Unused; kept so that SingleMode() can be assigned (see above).
+  bool singleMode;
+
+  /**
+   * Hash the cell containing the given point, using the current cell size.
+   *
+   * @param point Point whose cell should be hashed.
+   * @param offsets Integer offset to add to the cell coordinate in each
+   *      dimension (used to enumerate neighboring cells).
+   */
+  size_t HashCell(const arma::vec& point,
+                  const arma::Col<long long>& offsets) const;
+
+  /**
+   * Build the grid over the reference set with the given cell size.
+   *
+   * @param newCellSize Side length of each grid cell.
+   */
+  void BuildGrid(const double newCellSize);
+};
+
+} // namespace dbscan
+} // namespace mlpack
+
+// Include implementation.
+#include "grid_range_search_impl.hpp"
+
+#endif
@@ -0,0 +1,171 @@
+/**
+ * @file methods/dbscan/grid_range_search_impl.hpp
+ * @author Ryan Curtin
+ *
+ * Implementation of the GridRangeSearch class.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_DBSCAN_GRID_RANGE_SEARCH_IMPL_HPP
+#define MLPACK_METHODS_DBSCAN_GRID_RANGE_SEARCH_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "grid_range_search.hpp"
+
+namespace mlpack {
+namespace dbscan {
+
+inline GridRangeSearch::GridRangeSearch() :
+    cellSize(0.0),
+    singleMode(false)
+{
+  // Nothing to do.
+}
+
+inline void GridRangeSearch::Train(const arma::mat& referenceSet)
+{
+  this->referenceSet = referenceSet;
+
+  // Invalidate any previously built grid; it will be rebuilt lazily at the
+  // next Search() call, when the cell size is known.
+  cellSize = 0.0;
+  grid.clear();
+
+  if (referenceSet.n_rows > 4)
+  {
+    Log::Warn << "GridRangeSearch::Train(): each query scans 3^d cells, so "
+        << "grid-based search over " << referenceSet.n_rows << " dimensions "
+        << "is likely to be slow; consider RangeSearch instead." << std::endl;
+  }
+}
+
+inline size_t GridRangeSearch::HashCell(
+    const arma::vec& point,
+    const arma::Col<long long>& offsets) const
+{
+  size_t seed = 0;
+  for (size_t d = 0; d < point.n_elem; ++d)
+  {
+    const long long cell = (long long) std::floor(point[d] / cellSize) +
+        offsets[d];
+    const size_t h = std::hash<long long>()(cell);
+    seed ^= h + 0x9e3779b97f4a7c15 + (seed << 6) + (seed >> 2);
+  }
+  return seed;
+}
+
+inline void GridRangeSearch::BuildGrid(const double newCellSize)
+{
+  cellSize = newCellSize;
+  grid.clear();
+
+  const arma::Col<long long> noOffsets(referenceSet.n_rows,
+      arma::fill::zeros);
+  for (size_t i = 0; i < referenceSet.n_cols; ++i)
+  {
+    const arma::vec point = referenceSet.col(i);
+    grid[HashCell(point, noOffsets)].push_back(i);
+  }
+
+  Log::Info << "Built grid with cell size " << cellSize << " over "
+      << grid.size() << " occupied cells." << std::endl;
+}
+
+inline void GridRangeSearch::Search(
+    const arma::mat& querySet,
+    const math::Range& range,
+    std::vector<std::vector<size_t>>& neighbors,
+    std::vector<std::vector<double>>& distances)
+{
+  if (referenceSet.n_cols == 0)
+  {
+    throw std::invalid_argument("GridRangeSearch::Search(): no reference set; "
+        "call Train() first!");
+  }
+
+  if (range.Hi() <= 0.0)
+  {
+    std::stringstream oss;
+    oss << "GridRangeSearch::Search(): upper bound of range (" << range.Hi()
+        << ") must be positive!";
+    throw std::invalid_argument(oss.str());
+  }
+
+  // (Re)build the grid if the cell size does not match the search radius.
+  if (cellSize != range.Hi())
+    BuildGrid(range.Hi());
+
+  neighbors.clear();
+  neighbors.resize(querySet.n_cols);
+  distances.clear();
+  distances.resize(querySet.n_cols);
+
+  const size_t dims = querySet.n_rows;
+
+  // Each query point only writes to its own result slot, so the queries can
+  // be searched in parallel.
+  #pragma omp parallel for schedule(dynamic, 128)
+  for (omp_size_t i = 0; i < (omp_size_t) querySet.n_cols; ++i)
+  {
+    const arma::vec query = querySet.col(i);
+
+    // Enumerate the query's cell and all immediate neighbor cells by cycling
+    // an offset vector through every combination in {-1, 0, 1}^d.  Distinct
+    // cells may hash to the same bucket, so remember which buckets have
+    // already been scanned to avoid emitting duplicate neighbors.
+    arma::Col<long long> offsets(dims);
+    offsets.fill(-1);
+    std::vector<size_t> scannedKeys;
+
+    bool done = false;
+    while (!done)
+    {
+      const size_t key = HashCell(query, offsets);
+      if (std::find(scannedKeys.begin(), scannedKeys.end(), key) ==
+          scannedKeys.end())
+      {
+        scannedKeys.push_back(key);
+
+        const std::unordered_map<size_t, std::vector<size_t>>::const_iterator
+            cell = grid.find(key);
+        if (cell != grid.end())
+        {
+          // The bucket may contain points from far-away colliding cells, so
+          // verify every candidate with an exact distance computation.
+          for (size_t j = 0; j < cell->second.size(); ++j)
+          {
+            const size_t index = cell->second[j];
+            const double dist = metric::EuclideanDistance::Evaluate(query,
+                referenceSet.col(index));
+            if (range.Contains(dist))
+            {
+              neighbors[i].push_back(index);
+              distances[i].push_back(dist);
+            }
+          }
+        }
+      }
+
+      // Advance the offset vector to the next combination.
+      done = true;
+      for (size_t d = 0; d < dims; ++d)
+      {
+        if (offsets[d] < 1)
+        {
+          ++offsets[d];
+          done = false;
+          break;
+        }
+        offsets[d] = -1;
+      }
+    }
+  }
+}
+
+} // namespace dbscan
+} // namespace mlpack
+
+#endif
@@ -104,29 +104,52 @@ double DecisionStump<MatType>::Train(const MatType& data,
 {
   // If classLabels are not all identical, proceed with training.
   size_t bestDim = 0;
-  double entropy;
   const double rootEntropy = CalculateEntropy<UseWeights>(labels, weights);
 
-  double gain, bestGain = 0.0;
-  for (size_t i = 0; i < data.n_rows; i++)
+  // The candidate dimensions are scored independently, so the search is
+  // parallelized: each thread tracks its own best dimension, and the results
+  // are merged afterwards.  Ties are broken towards the smaller dimension
+  // index, which is the dimension the sequential search would have kept, so
+  // the result does not depend on the number of threads.
+  double bestGain = 0.0;
+  #pragma omp parallel
   {
-    // Go through each dimension of the data.
-    if (IsDistinct(data.row(i)))
-    {
-      // For each dimension with non-identical values, treat it as a potential
-      // splitting dimension and calculate entropy if split on it.
-      entropy = SetupSplitDimension<UseWeights>(data.row(i), labels, weights);
+    size_t localBestDim = 0;
+    double localBestGain = 0.0;
 
-      gain = rootEntropy - entropy;
-      // Find the dimension with the best entropy so that the gain is
-      // maximized.
+    #pragma omp for schedule(dynamic) nowait
+    for (omp_size_t i = 0; i < (omp_size_t) data.n_rows; i++)
+    {
+      // Go through each dimension of the data.
+      if (IsDistinct(data.row(i)))
+      {
+        // For each dimension with non-identical values, treat it as a
+        // potential splitting dimension and calculate entropy if split on it.
+        const double entropy = SetupSplitDimension<UseWeights>(data.row(i),
+            labels, weights);
+
+        const double gain = rootEntropy - entropy;
+        // Find the dimension with the best entropy so that the gain is
+        // maximized.
+
+        // We are maximizing gain, which is what is returned from
+        // SetupSplitDimension().
+        if (gain < localBestGain ||
+            (gain == localBestGain && (size_t) i < localBestDim))
+        {
+          localBestDim = (size_t) i;
+          localBestGain = gain;
+        }
+      }
+    }
 
-      // We are maximizing gain, which is what is returned from
-      // SetupSplitDimension().
-      if (gain < bestGain)
+    #pragma omp critical (decisionStumpDimensionSearch)
+    {
+      if (localBestGain < bestGain ||
+          (localBestGain == bestGain && localBestDim < bestDim))
       {
-        bestDim = i;
-        bestGain = gain;
+        bestDim = localBestDim;
+        bestGain = localBestGain;
       }
     }
   }
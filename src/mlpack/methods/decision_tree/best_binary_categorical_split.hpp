@@ -0,0 +1,133 @@
+/**
+ * @file methods/decision_tree/best_binary_categorical_split.hpp
+ *
+ * A tree splitter that finds a binary partition of the categories of a
+ * categorical feature, instead of creating one child per category.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_DECISION_TREE_BEST_BINARY_CATEGORICAL_SPLIT_HPP
+#define MLPACK_METHODS_DECISION_TREE_BEST_BINARY_CATEGORICAL_SPLIT_HPP
+
+#include <mlpack/prereqs.hpp>
+
+namespace mlpack {
+namespace tree {
+
+/**
+ * The BestBinaryCategoricalSplit is a splitting function for decision trees
+ * that splits a categorical feature into exactly two children, each holding a
+ * subset of the categories.  This handles high-cardinality categorical
+ * features natively: there is no need to one-hot encode them, and each node
+ * costs one counting pass over its points plus a sweep over the categories.
+ *
+ * The category subset is found by ordering the categories by the fraction of
+ * points belonging to the majority class and sweeping prefixes of that order,
+ * which is optimal for two-class problems and a standard CART-style heuristic
+ * for more classes.  The chosen subset is stored as a bitset packed into the
+ * classProbabilities vector (16 category bits per element, so the encoding is
+ * exact even for single-precision element types), and each point is routed in
+ * O(1) by testing its category's bit.
+ *
+ * @tparam FitnessFunction Fitness function to evaluate gain with.
+ */
+template<typename FitnessFunction>
+class BestBinaryCategoricalSplit
+{
+ public:
+  // No extra info needed for split.
+  template<typename ElemType>
+  class AuxiliarySplitInfo { };
+
+  /**
+   * Check if we can split a node.  If we can split a node in a way that
+   * improves on 'bestGain', then we return the improved gain.  Otherwise we
+   * return the value 'bestGain'.  If a split is made, then classProbabilities
+   * holds the number of categories followed by the packed bitset of the
+   * categories sent to the left child, and aux will be empty.
+   *
+   * @param bestGain Best gain seen so far (we'll only split if we find gain
+   *      better than this).
+   * @param data The dimension of data points to check for a split in.
+   * @param numCategories Number of categories in the categorical data.
+   * @param labels Labels for each point.
+   * @param numClasses Number of classes in the dataset.
+   * @param weights Weights associated with labels.
+   * @param minimumLeafSize Minimum number of points in a leaf node for
+   *      splitting.
+   * @param minimumGainSplit Minimum gain split.
+   * @param classProbabilities Class probabilities vector, which may be filled
+   *      with split information on a successful split.
+   * @param aux Auxiliary split information, which may be modified on a
+   *      successful split.
+   */
+  template<bool UseWeights, typename VecType, typename WeightVecType>
+  static double SplitIfBetter(
+      const double bestGain,
+      const VecType& data,
+      const size_t numCategories,
+      const arma::Row<size_t>& labels,
+      const size_t numClasses,
+      const WeightVecType& weights,
+      const size_t minimumLeafSize,
+      const double minimumGainSplit,
+      arma::Col<typename VecType::elem_type>& classProbabilities,
+      AuxiliarySplitInfo<typename VecType::elem_type>& aux);
+
+  /**
+   * Return the number of children in the split; this is always two.
+   *
+   * @param * (classProbabilities) Auxiliary information for the split
+   *      (Unused).
+   * @param * (aux) Auxiliary information for the split (Unused).
+   */
+  template<typename ElemType>
+  static size_t NumChildren(const arma::Col<ElemType>& /* classProbabilities */,
+                            const AuxiliarySplitInfo<ElemType>& /* aux */)
+  {
+    return 2;
+  }
+
+  /**
+   * Calculate the direction a point should percolate to: 0 if the bit of the
+   * point's category is set in the stored subset, 1 otherwise.
+   *
+   * @param point the Point to use.
+   * @param classProbabilities Column vector holding the packed category
+   *      subset.
+   * @param * (aux) Auxiliary information for the split (Unused).
+   */
+  template<typename ElemType>
+  static size_t CalculateDirection(
+      const ElemType& point,
+      const arma::Col<ElemType>& classProbabilities,
+      const AuxiliarySplitInfo<ElemType>& /* aux */);
+
+ private:
+  //! Number of category bits packed into each classProbabilities element.
+  //! 16 bits are exactly representable even in single precision.
+  static const size_t BitsPerElem = 16;
+
+  /**
+   * Encode the subset of categories given by the first prefix entries of
+   * order into classProbabilities: element 0 holds the number of categories,
+   * and the remaining elements hold the packed bitset of the categories sent
+   * to the left child.
+   */
+  template<typename ElemType>
+  static void EncodeSubset(const arma::uvec& order,
+                           const size_t prefix,
+                           const size_t numCategories,
+                           arma::Col<ElemType>& classProbabilities);
+};
+
+} // namespace tree
+} // namespace mlpack
+
+// Include implementation.
+#include "best_binary_categorical_split_impl.hpp"
+
+#endif
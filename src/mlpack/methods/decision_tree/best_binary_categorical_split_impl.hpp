@@ -0,0 +1,247 @@
+/**
+ * @file methods/decision_tree/best_binary_categorical_split_impl.hpp
+ *
+ * Implementation of the BestBinaryCategoricalSplit categorical split class.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_DECISION_TREE_BEST_BINARY_CATEGORICAL_SPLIT_IMPL_HPP
+#define MLPACK_METHODS_DECISION_TREE_BEST_BINARY_CATEGORICAL_SPLIT_IMPL_HPP
+
+namespace mlpack {
+namespace tree {
+
+template<typename FitnessFunction>
+template<bool UseWeights, typename VecType, typename WeightVecType>
+double BestBinaryCategoricalSplit<FitnessFunction>::SplitIfBetter(
+    const double bestGain,
+    const VecType& data,
+    const size_t numCategories,
+    const arma::Row<size_t>& labels,
+    const size_t numClasses,
+    const WeightVecType& weights,
+    const size_t minimumLeafSize,
+    const double minimumGainSplit,
+    arma::Col<typename VecType::elem_type>& classProbabilities,
+    AuxiliarySplitInfo<typename VecType::elem_type>& /* aux */)
+{
+  typedef typename VecType::elem_type ElemType;
+
+  // First sanity check: if we don't have enough points, we can't split.
+  if (data.n_elem < (minimumLeafSize * 2))
+    return DBL_MAX;
+  if (bestGain == 0.0)
+    return DBL_MAX; // It can't be outperformed.
+  if (numCategories < 2)
+    return DBL_MAX; // There is nothing to partition.
+
+  // One pass over the points: per-category point counts and class statistics.
+  arma::Col<size_t> counts(numCategories, arma::fill::zeros);
+  arma::Mat<size_t> classCounts;
+  arma::mat classWeightSums;
+  arma::vec categoryWeightSums;
+  double totalWeight = 0.0;
+  if (UseWeights)
+  {
+    classWeightSums.zeros(numClasses, numCategories);
+    categoryWeightSums.zeros(numCategories);
+  }
+  else
+  {
+    classCounts.zeros(numClasses, numCategories);
+  }
+
+  for (size_t i = 0; i < data.n_elem; ++i)
+  {
+    const size_t category = (size_t) data[i];
+    ++counts[category];
+    if (UseWeights)
+    {
+      classWeightSums(labels[i], category) += weights[i];
+      categoryWeightSums[category] += weights[i];
+      totalWeight += weights[i];
+    }
+    else
+    {
+      ++classCounts(labels[i], category);
+    }
+  }
+
+  // Order the categories by the fraction of their points that belong to the
+  // overall majority class.  For two classes, the best binary partition is a
+  // prefix of this order; for more classes it is a good heuristic.  Empty
+  // categories score zero and end up at the front, where they are skipped.
+  size_t majorityClass;
+  if (UseWeights)
+    majorityClass = arma::sum(classWeightSums, 1).index_max();
+  else
+    majorityClass = arma::conv_to<arma::vec>::from(
+        arma::sum(classCounts, 1)).index_max();
+
+  arma::vec scores(numCategories, arma::fill::zeros);
+  for (size_t c = 0; c < numCategories; ++c)
+  {
+    if (UseWeights && categoryWeightSums[c] > 0.0)
+      scores[c] = classWeightSums(majorityClass, c) / categoryWeightSums[c];
+    else if (!UseWeights && counts[c] > 0)
+      scores[c] = (double) classCounts(majorityClass, c) / (double) counts[c];
+  }
+  const arma::uvec order = arma::stable_sort_index(scores);
+
+  // Sweep prefixes of the order, moving one category at a time from the right
+  // child to the left child, with the same scaled-gain bookkeeping as the
+  // binary numeric split.
+  double bestFoundGain = std::min(bestGain + minimumGainSplit, 0.0);
+  bool improved = false;
+  size_t bestPrefix = 0;
+
+  arma::Col<size_t> leftClassCounts;
+  arma::Col<size_t> rightClassCounts;
+  arma::vec leftClassWeightSums;
+  arma::vec rightClassWeightSums;
+  if (UseWeights)
+  {
+    leftClassWeightSums.zeros(numClasses);
+    rightClassWeightSums = arma::sum(classWeightSums, 1);
+    bestFoundGain *= totalWeight;
+  }
+  else
+  {
+    leftClassCounts.zeros(numClasses);
+    rightClassCounts = arma::sum(classCounts, 1);
+    bestFoundGain *= data.n_elem;
+  }
+
+  size_t leftCount = 0;
+  size_t rightCount = data.n_elem;
+  double totalLeftWeight = 0.0;
+  double totalRightWeight = totalWeight;
+  for (size_t prefix = 1; prefix < numCategories; ++prefix)
+  {
+    // Move this category to the left child.
+    const size_t category = order[prefix - 1];
+    leftCount += counts[category];
+    rightCount -= counts[category];
+    if (UseWeights)
+    {
+      leftClassWeightSums += classWeightSums.col(category);
+      rightClassWeightSums -= classWeightSums.col(category);
+      totalLeftWeight += categoryWeightSums[category];
+      totalRightWeight -= categoryWeightSums[category];
+    }
+    else
+    {
+      leftClassCounts += classCounts.col(category);
+      rightClassCounts -= classCounts.col(category);
+    }
+
+    // An empty category gives the same partition as the previous prefix.
+    if (counts[category] == 0)
+      continue;
+
+    // Enforce the minimum leaf size on both sides.
+    if (leftCount < minimumLeafSize)
+      continue;
+    if (rightCount < minimumLeafSize)
+      break;
+
+    // Calculate the gain for the left and right child.  Only use weights if
+    // needed.
+    const double leftGain = UseWeights ?
+        FitnessFunction::template EvaluatePtr<true>(
+            leftClassWeightSums.memptr(), numClasses, totalLeftWeight) :
+        FitnessFunction::template EvaluatePtr<false>(
+            leftClassCounts.memptr(), numClasses, leftCount);
+    const double rightGain = UseWeights ?
+        FitnessFunction::template EvaluatePtr<true>(
+            rightClassWeightSums.memptr(), numClasses, totalRightWeight) :
+        FitnessFunction::template EvaluatePtr<false>(
+            rightClassCounts.memptr(), numClasses, rightCount);
+
+    double gain;
+    if (UseWeights)
+    {
+      gain = totalLeftWeight * leftGain + totalRightWeight * rightGain;
+    }
+    else
+    {
+      gain = double(leftCount) * leftGain + double(rightCount) * rightGain;
+    }
+
+    if (gain >= 0.0)
+    {
+      // We can take a shortcut: no split will be better than this, so just
+      // take this one.
+      EncodeSubset(order, prefix, numCategories, classProbabilities);
+      return gain;
+    }
+    else if (gain > bestFoundGain)
+    {
+      // We still have a better split.
+      bestFoundGain = gain;
+      bestPrefix = prefix;
+      improved = true;
+    }
+  }
+
+  // If we didn't improve, return the original gain exactly as we got it
+  // (without introducing floating point errors).
+  if (!improved)
+    return DBL_MAX;
+
+  EncodeSubset(order, bestPrefix, numCategories, classProbabilities);
+
+  if (UseWeights)
+    bestFoundGain /= totalWeight;
+  else
+    bestFoundGain /= data.n_elem;
+
+  return bestFoundGain;
+}
+
+template<typename FitnessFunction>
+template<typename ElemType>
+void BestBinaryCategoricalSplit<FitnessFunction>::EncodeSubset(
+    const arma::uvec& order,
+    const size_t prefix,
+    const size_t numCategories,
+    arma::Col<ElemType>& classProbabilities)
+{
+  const size_t numBlocks = (numCategories + BitsPerElem - 1) / BitsPerElem;
+  classProbabilities.zeros(1 + numBlocks);
+  classProbabilities[0] = (ElemType) numCategories;
+
+  // Each category appears in the order exactly once, so adding the bit value
+  // sets the bit.
+  for (size_t i = 0; i < prefix; ++i)
+  {
+    const size_t category = order[i];
+    classProbabilities[1 + category / BitsPerElem] +=
+        (ElemType) (size_t(1) << (category % BitsPerElem));
+  }
+}
+
+template<typename FitnessFunction>
+template<typename ElemType>
+size_t BestBinaryCategoricalSplit<FitnessFunction>::CalculateDirection(
+    const ElemType& point,
+    const arma::Col<ElemType>& classProbabilities,
+    const AuxiliarySplitInfo<ElemType>& /* aux */)
+{
+  const size_t category = (size_t) point;
+  const size_t block = 1 + category / BitsPerElem;
+  const size_t bit = category % BitsPerElem;
+
+  if (((size_t) classProbabilities[block] >> bit) & 1)
+    return 0; // Go left.
+  else
+    return 1; // Go right.
+}
+
+} // namespace tree
+} // namespace mlpack
+
+#endif
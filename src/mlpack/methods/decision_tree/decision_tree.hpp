@@ -17,7 +17,9 @@
 #include "gini_gain.hpp"
 #include "information_gain.hpp"
 #include "best_binary_numeric_split.hpp"
+#include "histogram_binary_numeric_split.hpp"
 #include "all_categorical_split.hpp"
+#include "best_binary_categorical_split.hpp"
 #include "all_dimension_select.hpp"
 #include <type_traits>
 
@@ -465,6 +467,15 @@ class DecisionTree :
   //! trained tree).
   size_t SplitDimension() const { return splitDimension; }
 
+  //! Get the type of the split dimension (casted from data::Datatype) if this
+  //! is a non-leaf; if this is a leaf, this is the majority class instead.
+  size_t DimensionTypeOrMajorityClass() const
+  { return dimensionTypeOrMajorityClass; }
+
+  //! Get the class probabilities of this node, if it is a leaf; if it is a
+  //! non-leaf, this is the split information instead (see classProbabilities).
+  const arma::vec& ClassProbabilities() const { return classProbabilities; }
+
   /**
    * Given a point and that this node is not a leaf, calculate the index of the
    * child node this point would go towards.  This method is primarily used by
@@ -14,6 +14,12 @@
 
 #include "decision_tree.hpp"
 
+#include <mlpack/core/math/blocked_ops.hpp>
+
+#ifdef HAS_OPENMP
+  #include <omp.h>
+#endif
+
 namespace mlpack {
 namespace tree {
 
@@ -681,6 +687,30 @@ double DecisionTree<FitnessFunction,
     const size_t maximumDepth,
     DimensionSelectionType& dimensionSelector)
 {
+  // If this is the root of a training call and we are not already inside a
+  // parallel region, set up a thread team first: each child node created by
+  // the recursion below is handed to the team as an independent task, so the
+  // growing frontier of nodes is processed across all cores.  (When this is
+  // called from inside an existing parallel region---for instance per-tree
+  // training in RandomForest---the nested team has a single thread and the
+  // recursion runs sequentially, preserving the outer parallelism.)
+  #ifdef HAS_OPENMP
+  if (!omp_in_parallel())
+  {
+    double result = 0.0;
+    #pragma omp parallel shared(result)
+    {
+      #pragma omp single
+      {
+        result = Train<UseWeights>(data, begin, count, datasetInfo, labels,
+            numClasses, weights, minimumLeafSize, minimumGainSplit,
+            maximumDepth, dimensionSelector);
+      }
+    }
+    return result;
+  }
+  #endif
+
   // Clear children if needed.
   for (size_t i = 0; i < children.size(); ++i)
     delete children[i];
@@ -700,14 +730,21 @@ double DecisionTree<FitnessFunction,
 
   if (maximumDepth != 1)
   {
+    // The splitters make several passes over the dimension's values, and a
+    // row of a column-major matrix is strided in memory, so gather each
+    // scanned row into this contiguous buffer first.
+    arma::Row<ElemType> dimValues(count);
+
     for (size_t i = dimensionSelector.Begin(); i != end;
          i = dimensionSelector.Next())
     {
+      math::GatherRow(data, i, begin, count, dimValues);
+
       double dimGain = -DBL_MAX;
       if (datasetInfo.Type(i) == data::Datatype::categorical)
       {
         dimGain = CategoricalSplit::template SplitIfBetter<UseWeights>(bestGain,
-            data.cols(begin, begin + count - 1).row(i),
+            dimValues,
             datasetInfo.NumMappings(i),
             labels.subvec(begin, begin + count - 1),
             numClasses,
@@ -720,7 +757,7 @@ double DecisionTree<FitnessFunction,
       else if (datasetInfo.Type(i) == data::Datatype::numeric)
       {
         dimGain = NumericSplit::template SplitIfBetter<UseWeights>(bestGain,
-            data.cols(begin, begin + count - 1).row(i),
+            dimValues,
             labels.subvec(begin, begin + count - 1),
             numClasses,
             UseWeights ? weights.subvec(begin, begin + count - 1) : weights,
@@ -786,12 +823,14 @@ double DecisionTree<FitnessFunction,
       bestGain = 0.0;
     }
 
-    // Split into children.
+    // Partition the columns into the children up front; afterwards the
+    // children cover disjoint column ranges and can be trained independently.
+    arma::Row<size_t> childBegins(numChildren);
     size_t currentCol = begin;
     for (size_t i = 0; i < numChildren; ++i)
     {
-      size_t currentChildBegin = currentCol;
-      for (size_t j = currentChildBegin; j < begin + count; ++j)
+      childBegins[i] = currentCol;
+      for (size_t j = currentCol; j < begin + count; ++j)
       {
         if (childAssignments[j - begin] == i)
         {
@@ -804,25 +843,42 @@ double DecisionTree<FitnessFunction,
         }
       }
 
-      // Now build the child recursively.
-      DecisionTree* child = new DecisionTree();
+      children.push_back(new DecisionTree());
+    }
+
+    // Now build the children recursively, each as an independent task.
+    arma::vec childGains(numChildren, arma::fill::zeros);
+    for (size_t i = 0; i < numChildren; ++i)
+    {
       if (NoRecursion)
       {
-        child->Train<UseWeights>(data, currentChildBegin,
-            currentCol - currentChildBegin, datasetInfo, labels, numClasses,
-            weights, currentCol - currentChildBegin, minimumGainSplit,
-            maximumDepth - 1, dimensionSelector);
+        children[i]->Train<UseWeights>(data, childBegins[i], childCounts[i],
+            datasetInfo, labels, numClasses, weights, childCounts[i],
+            minimumGainSplit, maximumDepth - 1, dimensionSelector);
       }
       else
       {
-        // During recursion entropy of child node may change.
-        double childGain = child->Train<UseWeights>(data, currentChildBegin,
-            currentCol - currentChildBegin, datasetInfo, labels, numClasses,
-            weights, minimumLeafSize, minimumGainSplit, maximumDepth - 1,
-            dimensionSelector);
-        bestGain += double(childCounts[i]) / double(count) * (-childGain);
+        // Tiny children are trained inline; the cutoff keeps task overhead
+        // away from the bottom of the tree.  The dimension selector is
+        // stateful, so each task works on its own copy.
+        #pragma omp task default(shared) firstprivate(i) \
+            if (childCounts[i] > 4 * minimumLeafSize)
+        {
+          DimensionSelectionType childSelector(dimensionSelector);
+          // During recursion entropy of child node may change.
+          childGains[i] = children[i]->Train<UseWeights>(data, childBegins[i],
+              childCounts[i], datasetInfo, labels, numClasses, weights,
+              minimumLeafSize, minimumGainSplit, maximumDepth - 1,
+              childSelector);
+        }
       }
-      children.push_back(child);
+    }
+
+    if (!NoRecursion)
+    {
+      #pragma omp taskwait
+      for (size_t i = 0; i < numChildren; ++i)
+        bestGain += double(childCounts[i]) / double(count) * (-childGains[i]);
     }
   }
   else
@@ -866,6 +922,26 @@ double DecisionTree<FitnessFunction,
     const size_t maximumDepth,
     DimensionSelectionType& dimensionSelector)
 {
+  // If this is the root of a training call and we are not already inside a
+  // parallel region, set up a thread team first; see the overload above for
+  // details on the frontier-parallel recursion.
+  #ifdef HAS_OPENMP
+  if (!omp_in_parallel())
+  {
+    double result = 0.0;
+    #pragma omp parallel shared(result)
+    {
+      #pragma omp single
+      {
+        result = Train<UseWeights>(data, begin, count, labels, numClasses,
+            weights, minimumLeafSize, minimumGainSplit, maximumDepth,
+            dimensionSelector);
+      }
+    }
+    return result;
+  }
+  #endif
+
   // Clear children if needed.
   for (size_t i = 0; i < children.size(); ++i)
     delete children[i];
@@ -887,12 +963,19 @@ double DecisionTree<FitnessFunction,
 
   if (maximumDepth != 1)
   {
+    // The splitters make several passes over the dimension's values, and a
+    // row of a column-major matrix is strided in memory, so gather each
+    // scanned row into this contiguous buffer first.
+    arma::Row<ElemType> dimValues(count);
+
     for (size_t i = dimensionSelector.Begin(); i != dimensionSelector.End();
          i = dimensionSelector.Next())
     {
+      math::GatherRow(data, i, begin, count, dimValues);
+
       const double dimGain = NumericSplitType<FitnessFunction>::template
           SplitIfBetter<UseWeights>(bestGain,
-                                    data.cols(begin, begin + count - 1).row(i),
+                                    dimValues,
                                     labels.cols(begin, begin + count - 1),
                                     numClasses,
                                     UseWeights ?
@@ -946,11 +1029,14 @@ double DecisionTree<FitnessFunction,
       bestGain = 0.0;
     }
 
+    // Partition the columns into the children up front; afterwards the
+    // children cover disjoint column ranges and can be trained independently.
+    arma::Row<size_t> childBegins(numChildren);
     size_t currentCol = begin;
     for (size_t i = 0; i < numChildren; ++i)
     {
-      size_t currentChildBegin = currentCol;
-      for (size_t j = currentChildBegin; j < begin + count; ++j)
+      childBegins[i] = currentCol;
+      for (size_t j = currentCol; j < begin + count; ++j)
       {
         if (childAssignments[j - begin] == i)
         {
@@ -963,25 +1049,41 @@ double DecisionTree<FitnessFunction,
         }
       }
 
-      // Now build the child recursively.
-      DecisionTree* child = new DecisionTree();
+      children.push_back(new DecisionTree());
+    }
+
+    // Now build the children recursively, each as an independent task.
+    arma::vec childGains(numChildren, arma::fill::zeros);
+    for (size_t i = 0; i < numChildren; ++i)
+    {
       if (NoRecursion)
       {
-        child->Train<UseWeights>(data, currentChildBegin,
-            currentCol - currentChildBegin, labels, numClasses, weights,
-            currentCol - currentChildBegin, minimumGainSplit, maximumDepth - 1,
-            dimensionSelector);
+        children[i]->Train<UseWeights>(data, childBegins[i], childCounts[i],
+            labels, numClasses, weights, childCounts[i], minimumGainSplit,
+            maximumDepth - 1, dimensionSelector);
       }
       else
       {
-        // During recursion entropy of child node may change.
-        double childGain = child->Train<UseWeights>(data, currentChildBegin,
-            currentCol - currentChildBegin, labels, numClasses, weights,
-            minimumLeafSize, minimumGainSplit, maximumDepth - 1,
-            dimensionSelector);
-        bestGain += double(childCounts[i]) / double(count) * (-childGain);
+        // Tiny children are trained inline; the cutoff keeps task overhead
+        // away from the bottom of the tree.  The dimension selector is
+        // stateful, so each task works on its own copy.
+        #pragma omp task default(shared) firstprivate(i) \
+            if (childCounts[i] > 4 * minimumLeafSize)
+        {
+          DimensionSelectionType childSelector(dimensionSelector);
+          // During recursion entropy of child node may change.
+          childGains[i] = children[i]->Train<UseWeights>(data, childBegins[i],
+              childCounts[i], labels, numClasses, weights, minimumLeafSize,
+              minimumGainSplit, maximumDepth - 1, childSelector);
+        }
       }
-      children.push_back(child);
+    }
+
+    if (!NoRecursion)
+    {
+      #pragma omp taskwait
+      for (size_t i = 0; i < numChildren; ++i)
+        bestGain += double(childCounts[i]) / double(count) * (-childGains[i]);
     }
   }
   else
@@ -0,0 +1,209 @@
+/**
+ * @file methods/decision_tree/histogram_binary_numeric_split_impl.hpp
+ *
+ * Implementation of the histogram-based binary numeric split strategy.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_DECISION_TREE_HISTOGRAM_BINARY_NUMERIC_SPLIT_IMPL_HPP
+#define MLPACK_METHODS_DECISION_TREE_HISTOGRAM_BINARY_NUMERIC_SPLIT_IMPL_HPP
+
+namespace mlpack {
+namespace tree {
+
+template<typename FitnessFunction>
+template<bool UseWeights, typename VecType, typename WeightVecType>
+double HistogramBinaryNumericSplit<FitnessFunction>::SplitIfBetter(
+    const double bestGain,
+    const VecType& data,
+    const arma::Row<size_t>& labels,
+    const size_t numClasses,
+    const WeightVecType& weights,
+    const size_t minimumLeafSize,
+    const double minimumGainSplit,
+    arma::Col<typename VecType::elem_type>& classProbabilities,
+    AuxiliarySplitInfo<typename VecType::elem_type>& /* aux */)
+{
+  typedef typename VecType::elem_type ElemType;
+
+  // First sanity check: if we don't have enough points, we can't split.
+  if (data.n_elem < (minimumLeafSize * 2))
+    return DBL_MAX;
+  if (bestGain == 0.0)
+    return DBL_MAX; // It can't be outperformed.
+
+  // Find the range of the dimension; if all values are identical, we can't
+  // split.  This pass and the binning pass below are the only ones over the
+  // points---there is no sort.
+  const ElemType minValue = data.min();
+  const ElemType maxValue = data.max();
+  if (minValue == maxValue)
+    return DBL_MAX;
+
+  const double binWidth = ((double) maxValue - (double) minValue) / NumBins;
+
+  // Accumulate the per-bin class histogram.  Point counts are tracked even
+  // in the weighted case, since the minimum leaf size is a count constraint.
+  arma::Mat<size_t> binClassCounts;
+  arma::mat binClassWeightSums;
+  arma::Col<size_t> binCounts(NumBins, arma::fill::zeros);
+  double totalWeight = 0.0;
+  if (UseWeights)
+    binClassWeightSums.zeros(numClasses, NumBins);
+  else
+    binClassCounts.zeros(numClasses, NumBins);
+
+  for (size_t i = 0; i < data.n_elem; ++i)
+  {
+    const size_t bin = std::min(
+        (size_t) (((double) data[i] - (double) minValue) / binWidth),
+        NumBins - 1);
+
+    ++binCounts[bin];
+    if (UseWeights)
+    {
+      binClassWeightSums(labels[i], bin) += weights[i];
+      totalWeight += weights[i];
+    }
+    else
+    {
+      ++binClassCounts(labels[i], bin);
+    }
+  }
+
+  // Loop over the bin boundaries, moving one bin at a time from the right
+  // child to the left child, and keep the boundary with the best gain.  Also,
+  // force a minimum leaf size of 1 (empty children don't make sense).
+  double bestFoundGain = std::min(bestGain + minimumGainSplit, 0.0);
+  bool improved = false;
+  const size_t minimum = std::max(minimumLeafSize, (size_t) 1);
+
+  arma::Col<size_t> leftClassCounts;
+  arma::Col<size_t> rightClassCounts;
+  arma::vec leftClassWeightSums;
+  arma::vec rightClassWeightSums;
+  if (UseWeights)
+  {
+    leftClassWeightSums.zeros(numClasses);
+    rightClassWeightSums = arma::sum(binClassWeightSums, 1);
+    bestFoundGain *= totalWeight;
+  }
+  else
+  {
+    leftClassCounts.zeros(numClasses);
+    rightClassCounts = arma::sum(binClassCounts, 1);
+    bestFoundGain *= data.n_elem;
+  }
+
+  size_t leftCount = 0;
+  size_t rightCount = data.n_elem;
+  double totalLeftWeight = 0.0;
+  double totalRightWeight = totalWeight;
+  for (size_t bin = 0; bin + 1 < NumBins; ++bin)
+  {
+    // Move this bin to the left child.
+    leftCount += binCounts[bin];
+    rightCount -= binCounts[bin];
+    if (UseWeights)
+    {
+      leftClassWeightSums += binClassWeightSums.col(bin);
+      rightClassWeightSums -= binClassWeightSums.col(bin);
+      totalLeftWeight += arma::accu(binClassWeightSums.col(bin));
+      totalRightWeight -= arma::accu(binClassWeightSums.col(bin));
+    }
+    else
+    {
+      leftClassCounts += binClassCounts.col(bin);
+      rightClassCounts -= binClassCounts.col(bin);
+    }
+
+    // An empty bin gives the same partition as the previous boundary.
+    if (binCounts[bin] == 0)
+      continue;
+
+    // Enforce the minimum leaf size on both sides.
+    if (leftCount < minimum)
+      continue;
+    if (rightCount < minimum)
+      break;
+
+    // Calculate the gain for the left and right child.  Only use weights if
+    // needed.
+    const double leftGain = UseWeights ?
+        FitnessFunction::template EvaluatePtr<true>(
+            leftClassWeightSums.memptr(), numClasses, totalLeftWeight) :
+        FitnessFunction::template EvaluatePtr<false>(
+            leftClassCounts.memptr(), numClasses, leftCount);
+    const double rightGain = UseWeights ?
+        FitnessFunction::template EvaluatePtr<true>(
+            rightClassWeightSums.memptr(), numClasses, totalRightWeight) :
+        FitnessFunction::template EvaluatePtr<false>(
+            rightClassCounts.memptr(), numClasses, rightCount);
+
+    double gain;
+    if (UseWeights)
+    {
+      gain = totalLeftWeight * leftGain + totalRightWeight * rightGain;
+    }
+    else
+    {
+      // Calculate the gain at this boundary.
+      gain = double(leftCount) * leftGain + double(rightCount) * rightGain;
+    }
+
+    // The threshold is the upper edge of the bin we just moved left.
+    const ElemType threshold =
+        (ElemType) ((double) minValue + (bin + 1) * binWidth);
+
+    // Corner case: is this the best possible split?
+    if (gain >= 0.0)
+    {
+      // We can take a shortcut: no split will be better than this, so just
+      // take this one.
+      classProbabilities.set_size(1);
+      classProbabilities[0] = threshold;
+      return gain;
+    }
+    else if (gain > bestFoundGain)
+    {
+      // We still have a better split.
+      bestFoundGain = gain;
+      classProbabilities.set_size(1);
+      classProbabilities[0] = threshold;
+      improved = true;
+    }
+  }
+
+  // If we didn't improve, return the original gain exactly as we got it
+  // (without introducing floating point errors).
+  if (!improved)
+    return DBL_MAX;
+
+  if (UseWeights)
+    bestFoundGain /= totalWeight;
+  else
+    bestFoundGain /= data.n_elem;
+
+  return bestFoundGain;
+}
+
+template<typename FitnessFunction>
+template<typename ElemType>
+size_t HistogramBinaryNumericSplit<FitnessFunction>::CalculateDirection(
+    const ElemType& point,
+    const arma::Col<ElemType>& classProbabilities,
+    const AuxiliarySplitInfo<ElemType>& /* aux */)
+{
+  if (point <= classProbabilities[0])
+    return 0; // Go left.
+  else
+    return 1; // Go right.
+}
+
+} // namespace tree
+} // namespace mlpack
+
+#endif
@@ -171,10 +171,9 @@ static void mlpackMain()
     if (CLI::HasParam("training_set_estimates"))
     {
       // Compute density estimates for each point in the training set.
-      arma::rowvec trainingDensities(trainingData.n_cols);
+      arma::rowvec trainingDensities;
       Timer::Start("det_estimation_time");
-      for (size_t i = 0; i < trainingData.n_cols; i++)
-        trainingDensities[i] = tree->ComputeValue(trainingData.unsafe_col(i));
+      tree->ComputeValue(trainingData, trainingDensities);
       Timer::Stop("det_estimation_time");
 
       CLI::GetParam<arma::mat>("training_set_estimates") =
@@ -195,11 +194,8 @@ static void mlpackMain()
     {
       // Compute test set densities.
       Timer::Start("det_test_set_estimation");
-      arma::rowvec testDensities(testData.n_cols);
-
-      for (size_t i = 0; i < testData.n_cols; i++)
-        testDensities[i] = tree->ComputeValue(testData.unsafe_col(i));
-
+      arma::rowvec testDensities;
+      tree->ComputeValue(testData, testDensities);
       Timer::Stop("det_test_set_estimation");
 
       CLI::GetParam<arma::mat>("test_set_estimates") = std::move(testDensities);
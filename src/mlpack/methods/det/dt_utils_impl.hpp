@@ -15,6 +15,7 @@
 
 #include "dt_utils.hpp"
 #include <mlpack/core/tree/enumerate_tree.hpp>
+#include <mlpack/core/util/parallelism.hpp>
 
 namespace mlpack {
 namespace det {
@@ -184,7 +185,8 @@ DTree<MatType, TagType>* Trainer(MatType& dataset,
   // intmax_t because size_t is not yet supported by their OpenMP
   // implementation. omp_size_t is the appropriate type according to the
   // platform.
-  #pragma omp parallel for shared(prunedSequence, regularizationConstants)
+  #pragma omp parallel for shared(prunedSequence, regularizationConstants) \
+      num_threads((int) Parallelism::Threads("det"))
   for (omp_size_t fold = 0; fold < (omp_size_t) folds; fold++)
   {
     // Break up data into train and test sets.
@@ -182,6 +182,19 @@ class DTree
    */
   double ComputeValue(const VecType& query) const;
 
+  /**
+   * Compute the density estimate of every column of the given query matrix.
+   * Instead of walking the tree once per point, the whole batch is routed
+   * level-by-level: the query indices are partitioned between the two
+   * children at every split, so each node is visited once per batch and the
+   * grouped descents stay cache-friendly.  The batch is processed in blocks
+   * that are parallelized with OpenMP.
+   *
+   * @param queries Matrix of query points (one point per column).
+   * @param densities Output density estimates, one per query point.
+   */
+  void ComputeValue(const MatType& queries, arma::rowvec& densities) const;
+
   /**
    * Index the buckets for possible usage later; this results in every leaf in
    * the tree having a specific tag (accessible with BucketTag()).  This
@@ -353,6 +366,14 @@ class DTree
                    const ElemType splitValue,
                    arma::Col<size_t>& oldFromNew) const;
 
+  /**
+   * Route the given query indices through this subtree, partitioning them at
+   * every split, and fill in the density estimate of each routed query.
+   */
+  void ComputeValueBatch(const MatType& queries,
+                         arma::uvec&& indices,
+                         arma::rowvec& densities) const;
+
   void  FillMinMax(const StatType& mins,
                    const StatType& maxs);
 };
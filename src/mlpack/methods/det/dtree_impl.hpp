@@ -889,6 +889,107 @@ double DTree<MatType, TagType>::ComputeValue(const VecType& query) const
   return 0.0;
 }
 
+template<typename MatType, typename TagType>
+void DTree<MatType, TagType>::ComputeValue(const MatType& queries,
+                                           arma::rowvec& densities) const
+{
+  Log::Assert(queries.n_rows == maxVals.n_elem);
+
+  // Out-of-range queries keep a density of zero.
+  densities.zeros(queries.n_cols);
+
+  // Process the queries in blocks; the blocks are independent, so they can be
+  // routed through the tree in parallel.
+  const size_t blockSize = 1024;
+  const size_t numBlocks = (queries.n_cols + blockSize - 1) / blockSize;
+
+  #pragma omp parallel for schedule(dynamic)
+  for (omp_size_t b = 0; b < numBlocks; ++b)
+  {
+    const size_t begin = b * blockSize;
+    const size_t end = std::min(begin + blockSize, (size_t) queries.n_cols);
+
+    // Collect the in-range queries of this block (the range check is only
+    // performed at the root, as in the single-point ComputeValue()).
+    arma::uvec indices(end - begin);
+    size_t count = 0;
+    for (size_t i = begin; i < end; ++i)
+    {
+      bool inRange = true;
+      for (size_t d = 0; d < queries.n_rows; ++d)
+      {
+        const ElemType value = queries(d, i);
+        if ((value < minVals[d]) || (value > maxVals[d]))
+        {
+          inRange = false;
+          break;
+        }
+      }
+
+      if (inRange)
+        indices[count++] = i;
+    }
+    indices.resize(count);
+
+    if (count > 0)
+      ComputeValueBatch(queries, std::move(indices), densities);
+  }
+}
+
+template<typename MatType, typename TagType>
+void DTree<MatType, TagType>::ComputeValueBatch(const MatType& queries,
+                                                arma::uvec&& indicesIn,
+                                                arma::rowvec& densities) const
+{
+  // Walk the subtree with an explicit stack, partitioning the query indices
+  // at every split, so that each node is visited only once per batch.
+  std::stack<std::pair<const DTree*, arma::uvec>> frontier;
+  frontier.push(std::make_pair(this, std::move(indicesIn)));
+
+  while (!frontier.empty())
+  {
+    const DTree* node = frontier.top().first;
+    const arma::uvec indices = std::move(frontier.top().second);
+    frontier.pop();
+
+    if (node->subtreeLeaves == 1) // If this is a leaf...
+    {
+      const double density = std::exp(std::log(node->ratio) -
+          node->logVolume);
+      for (size_t j = 0; j < indices.n_elem; ++j)
+        densities[indices[j]] = density;
+
+      continue;
+    }
+
+    // Partition the queries between the two children on the split value.
+    arma::uvec leftIndices(indices.n_elem);
+    arma::uvec rightIndices(indices.n_elem);
+    size_t leftCount = 0;
+    size_t rightCount = 0;
+    for (size_t j = 0; j < indices.n_elem; ++j)
+    {
+      if (queries(node->splitDim, indices[j]) <= node->splitValue)
+        leftIndices[leftCount++] = indices[j];
+      else
+        rightIndices[rightCount++] = indices[j];
+    }
+
+    if (leftCount > 0)
+    {
+      leftIndices.resize(leftCount);
+      frontier.push(std::make_pair((const DTree*) node->left,
+          std::move(leftIndices)));
+    }
+    if (rightCount > 0)
+    {
+      rightIndices.resize(rightCount);
+      frontier.push(std::make_pair((const DTree*) node->right,
+          std::move(rightIndices)));
+    }
+  }
+}
+
 // Index the buckets for possible usage later.
 template<typename MatType, typename TagType>
 TagType DTree<MatType, TagType>::TagTree(const TagType& tag, bool every)
@@ -0,0 +1,112 @@
+/**
+ * @file methods/emst/concurrent_union_find.hpp
+ * @author Ryan Curtin
+ *
+ * Implements a lock-free union-find data structure that may be safely used
+ * from multiple threads at once.  Like UnionFind, the structure tracks the
+ * components of a graph: each point is initially in its own component, and
+ * Union(x, y) unites the components containing x and y.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_EMST_CONCURRENT_UNION_FIND_HPP
+#define MLPACK_METHODS_EMST_CONCURRENT_UNION_FIND_HPP
+
+#include <mlpack/prereqs.hpp>
+#include <atomic>
+
+namespace mlpack {
+namespace emst {
+
+/**
+ * A thread-safe union-find data structure.  The parent array is held as
+ * atomics and all updates are done with compare-and-swap operations, so any
+ * number of threads may call Union() and Find() concurrently without locking
+ * (see Anderson & Woll, "Wait-free parallel algorithms for the union-find
+ * problem", STOC 1991).
+ *
+ * Instead of union-by-rank, a component's root is always the smallest index
+ * in the component; thus the final set of representatives is deterministic
+ * and does not depend on the order in which threads performed their unions.
+ * Find() uses path halving to keep the trees shallow.
+ */
+class ConcurrentUnionFind
+{
+ private:
+  std::vector<std::atomic<size_t>> parent;
+
+ public:
+  //! Construct the object with the given size.
+  ConcurrentUnionFind(const size_t size) : parent(size)
+  {
+    for (size_t i = 0; i < size; ++i)
+      parent[i].store(i, std::memory_order_relaxed);
+  }
+
+  //! The structure cannot be copied (atomics are not copyable).
+  ConcurrentUnionFind(const ConcurrentUnionFind&) = delete;
+  //! The structure cannot be assigned.
+  ConcurrentUnionFind& operator=(const ConcurrentUnionFind&) = delete;
+
+  /**
+   * Returns the component containing an element.  Path halving is applied
+   * along the way; a failed compare-and-swap just means another thread
+   * shortened the path first, so failures are ignored.
+   *
+   * @param x the component to be found
+   * @return The index of the component containing x
+   */
+  size_t Find(const size_t x)
+  {
+    size_t current = x;
+    size_t p = parent[current].load(std::memory_order_relaxed);
+    while (p != current)
+    {
+      const size_t grandparent = parent[p].load(std::memory_order_relaxed);
+      parent[current].compare_exchange_weak(p, grandparent,
+          std::memory_order_relaxed);
+      current = grandparent;
+      p = parent[current].load(std::memory_order_relaxed);
+    }
+    return current;
+  }
+
+  /**
+   * Union the components containing x and y.  The root with the larger index
+   * is linked under the root with the smaller index; if another thread races
+   * us and changes either root first, we simply retry with the new roots.
+   *
+   * @param x one component
+   * @param y the other component
+   */
+  void Union(const size_t x, const size_t y)
+  {
+    size_t xRoot = Find(x);
+    size_t yRoot = Find(y);
+
+    while (xRoot != yRoot)
+    {
+      // Link the larger root under the smaller one, so that the smallest
+      // index in a component is always its representative.
+      if (xRoot > yRoot)
+        std::swap(xRoot, yRoot);
+
+      size_t expected = yRoot;
+      if (parent[yRoot].compare_exchange_strong(expected, xRoot,
+          std::memory_order_relaxed))
+        return;
+
+      // yRoot was no longer a root; find the new roots and try again.
+      xRoot = Find(xRoot);
+      yRoot = Find(expected);
+    }
+  }
+}; // class ConcurrentUnionFind
+
+} // namespace emst
+} // namespace mlpack
+
+#endif // MLPACK_METHODS_EMST_CONCURRENT_UNION_FIND_HPP
@@ -25,6 +25,7 @@
 #ifndef MLPACK_METHODS_EMST_DTB_HPP
 #define MLPACK_METHODS_EMST_DTB_HPP
 
+#include "concurrent_union_find.hpp"
 #include "dtb_stat.hpp"
 #include "edge_pair.hpp"
 
@@ -102,8 +103,9 @@ class DualTreeBoruvka
   //! Edges.
   std::vector<EdgePair> edges; // We must use vector with non-numerical types.
 
-  //! Connections.
-  UnionFind connections;
+  //! Connections.  The concurrent structure is used so that the
+  //! nearest-neighbor pass of each Boruvka round can run in parallel.
+  ConcurrentUnionFind connections;
 
   //! List of edge nodes.
   arma::Col<size_t> neighborsInComponent;
@@ -186,6 +188,19 @@ class DualTreeBoruvka
    */
   void AddAllEdges();
 
+  /**
+   * Merge the candidate edges found by one thread into the global
+   * per-component candidate edges, keeping the shorter edge for each
+   * component.  Must be called from inside a critical section.
+   *
+   * @param localDistances Candidate edge distances found by the thread.
+   * @param localInComponent In-component endpoints found by the thread.
+   * @param localOutComponent Out-of-component endpoints found by the thread.
+   */
+  void MergeRoundResults(const arma::vec& localDistances,
+                         const arma::Col<size_t>& localInComponent,
+                         const arma::Col<size_t>& localOutComponent);
+
   /**
    * Unpermute the edge list and output it to results.
    */
@@ -14,6 +14,10 @@
 
 #include "dtb_rules.hpp"
 
+#ifdef HAS_OPENMP
+  #include <omp.h>
+#endif
+
 namespace mlpack {
 namespace emst {
 
@@ -130,15 +134,83 @@ void DualTreeBoruvka<MetricType, MatType, TreeType>::ComputeMST(
   {
     if (naive)
     {
-      // Full O(N^2) traversal.
-      for (size_t i = 0; i < data.n_cols; ++i)
-        for (size_t j = 0; j < data.n_cols; ++j)
-          rules.BaseCase(i, j);
+      // Full O(N^2) traversal.  The rows of the distance matrix are
+      // independent, so each thread scans its own set of query points into
+      // thread-local candidate edges, which are merged at the end of the
+      // round; Find() on the concurrent union-find is thread-safe.
+      #pragma omp parallel
+      {
+        arma::vec localDistances(data.n_cols);
+        localDistances.fill(DBL_MAX);
+        arma::Col<size_t> localInComponent(data.n_cols);
+        arma::Col<size_t> localOutComponent(data.n_cols);
+
+        RuleType localRules(data, connections, localDistances,
+            localInComponent, localOutComponent, metric);
+
+        #pragma omp for schedule(dynamic, 128)
+        for (omp_size_t i = 0; i < (omp_size_t) data.n_cols; ++i)
+          for (size_t j = 0; j < data.n_cols; ++j)
+            localRules.BaseCase(i, j);
+
+        #pragma omp critical (dtbRoundMerge)
+        {
+          MergeRoundResults(localDistances, localInComponent,
+              localOutComponent);
+          rules.BaseCases() += localRules.BaseCases();
+        }
+      }
     }
     else
     {
-      typename Tree::template DualTreeTraverser<RuleType> traverser(rules);
-      traverser.Traverse(*tree, *tree);
+      // If multiple threads are available, each thread runs single-tree
+      // traversals over a contiguous shard of the query points, finding
+      // thread-local candidate edges that are merged at the end of the round.
+      // Otherwise fall through to the usual dual-tree traversal, which prunes
+      // more aggressively than sharded single-tree traversals.
+      bool traversedInParallel = false;
+      #ifdef HAS_OPENMP
+      const size_t numThreads = (size_t) omp_get_max_threads();
+      if (numThreads > 1)
+      {
+        traversedInParallel = true;
+
+        #pragma omp parallel
+        {
+          arma::vec localDistances(data.n_cols);
+          localDistances.fill(DBL_MAX);
+          arma::Col<size_t> localInComponent(data.n_cols);
+          arma::Col<size_t> localOutComponent(data.n_cols);
+
+          RuleType localRules(data, connections, localDistances,
+              localInComponent, localOutComponent, metric);
+          typename Tree::template SingleTreeTraverser<RuleType>
+              traverser(localRules);
+
+          // Each thread traverses a contiguous shard of the query points.
+          const size_t threadId = (size_t) omp_get_thread_num();
+          const size_t begin = (threadId * data.n_cols) / numThreads;
+          const size_t end = ((threadId + 1) * data.n_cols) / numThreads;
+
+          for (size_t i = begin; i < end; ++i)
+            traverser.Traverse(i, *tree);
+
+          #pragma omp critical (dtbRoundMerge)
+          {
+            MergeRoundResults(localDistances, localInComponent,
+                localOutComponent);
+            rules.BaseCases() += localRules.BaseCases();
+            rules.Scores() += localRules.Scores();
+          }
+        }
+      }
+      #endif
+
+      if (!traversedInParallel)
+      {
+        typename Tree::template DualTreeTraverser<RuleType> traverser(rules);
+        traverser.Traverse(*tree, *tree);
+      }
     }
 
     AddAllEdges();
@@ -211,6 +283,32 @@ void DualTreeBoruvka<MetricType, MatType, TreeType>::AddAllEdges()
   }
 }
 
+/**
+ * Merge the candidate edges found by one thread into the global
+ * per-component candidate edges.
+ */
+template<
+    typename MetricType,
+    typename MatType,
+    template<typename TreeMetricType,
+             typename TreeStatType,
+             typename TreeMatType> class TreeType>
+void DualTreeBoruvka<MetricType, MatType, TreeType>::MergeRoundResults(
+    const arma::vec& localDistances,
+    const arma::Col<size_t>& localInComponent,
+    const arma::Col<size_t>& localOutComponent)
+{
+  for (size_t c = 0; c < neighborsDistances.n_elem; ++c)
+  {
+    if (localDistances[c] < neighborsDistances[c])
+    {
+      neighborsDistances[c] = localDistances[c];
+      neighborsInComponent[c] = localInComponent[c];
+      neighborsOutComponent[c] = localOutComponent[c];
+    }
+  }
+}
+
 /**
  * Unpermute the edge list (if necessary) and output it to results.
  */
@@ -18,6 +18,11 @@
 #include "fastmks_rules.hpp"
 
 #include <mlpack/core/kernels/gaussian_kernel.hpp>
+#include <mlpack/core/kernels/kernel_matrix.hpp>
+
+#ifdef HAS_OPENMP
+  #include <omp.h>
+#endif
 
 namespace mlpack {
 namespace fastmks {
@@ -426,31 +431,53 @@ void FastMKS<KernelType, MatType, TreeType>::Search(
   // Naive implementation.
   if (naive)
   {
-    // Simple double loop.  Stupid, slow, but a good benchmark.
+    // Evaluate the kernel in blocks of reference points with the blocked
+    // kernel-matrix builder (which maps suitable kernels to matrix products),
+    // then scan each block for top-k candidates.
+    const Candidate def = std::make_pair(-DBL_MAX, size_t() - 1);
+    std::vector<CandidateList> pqueues;
+    pqueues.reserve(querySet.n_cols);
     for (size_t q = 0; q < querySet.n_cols; ++q)
     {
-      const Candidate def = std::make_pair(-DBL_MAX, size_t() - 1);
       std::vector<Candidate> cList(k, def);
-      CandidateList pqueue(CandidateCmp(), std::move(cList));
+      pqueues.push_back(CandidateList(CandidateCmp(), std::move(cList)));
+    }
 
-      for (size_t r = 0; r < referenceSet->n_cols; ++r)
+    const size_t blockSize = 1024;
+    arma::mat kernelBlock;
+    for (size_t rBegin = 0; rBegin < referenceSet->n_cols; rBegin += blockSize)
+    {
+      const size_t rEnd = ((rBegin + blockSize > referenceSet->n_cols) ?
+          referenceSet->n_cols : rBegin + blockSize) - 1;
+      kernel::KernelMatrix(querySet, referenceSet->cols(rBegin, rEnd),
+          kernelBlock, metric.Kernel());
+
+      // Each query has its own candidate queue, so the scan of the block can
+      // be done in parallel.
+      #pragma omp parallel for schedule(dynamic)
+      for (omp_size_t q = 0; q < (omp_size_t) querySet.n_cols; ++q)
       {
-        const double eval = metric.Kernel().Evaluate(querySet.col(q),
-                                                     referenceSet->col(r));
-
-        if (eval > pqueue.top().first)
+        for (size_t r = 0; r < kernelBlock.n_cols; ++r)
         {
-          Candidate c = std::make_pair(eval, r);
-          pqueue.pop();
-          pqueue.push(c);
+          const double eval = kernelBlock(q, r);
+
+          if (eval > pqueues[q].top().first)
+          {
+            Candidate c = std::make_pair(eval, rBegin + r);
+            pqueues[q].pop();
+            pqueues[q].push(c);
+          }
         }
       }
+    }
 
+    for (size_t q = 0; q < querySet.n_cols; ++q)
+    {
       for (size_t j = 1; j <= k; j++)
       {
-        indices(k - j, q) = pqueue.top().second;
-        kernels(k - j, q) = pqueue.top().first;
-        pqueue.pop();
+        indices(k - j, q) = pqueues[q].top().second;
+        kernels(k - j, q) = pqueues[q].top().first;
+        pqueues[q].pop();
       }
     }
 
@@ -467,6 +494,57 @@ void FastMKS<KernelType, MatType, TreeType>::Search(
     typedef FastMKSRules<KernelType, Tree> RuleType;
     RuleType rules(*referenceSet, querySet, k, metric.Kernel());
 
+    // If more than one thread is available, shard the query set across the
+    // threads, giving each its own copy of the rules (the per-query candidate
+    // lists are independent, but the counters are not).  Each thread extracts
+    // and stores the results for its own shard, so the shared output matrices
+    // are written without contention.
+#ifdef HAS_OPENMP
+    const size_t numThreads = (size_t) omp_get_max_threads();
+    if (numThreads > 1 && querySet.n_cols > 1)
+    {
+      size_t parallelScores = 0;
+      size_t parallelBaseCases = 0;
+
+      #pragma omp parallel reduction(+: parallelScores, parallelBaseCases)
+      {
+        const size_t thread = (size_t) omp_get_thread_num();
+        const size_t actualThreads = (size_t) omp_get_num_threads();
+        const size_t shardBegin = (thread * querySet.n_cols) / actualThreads;
+        const size_t shardEnd =
+            ((thread + 1) * querySet.n_cols) / actualThreads;
+
+        if (shardEnd > shardBegin)
+        {
+          RuleType localRules(rules);
+          typename Tree::template SingleTreeTraverser<RuleType>
+              traverser(localRules);
+
+          for (size_t i = shardBegin; i < shardEnd; ++i)
+            traverser.Traverse(i, *referenceTree);
+
+          parallelScores += localRules.Scores();
+          parallelBaseCases += localRules.BaseCases();
+
+          arma::Mat<size_t> shardIndices;
+          arma::mat shardKernels;
+          localRules.GetResults(shardIndices, shardKernels);
+
+          indices.cols(shardBegin, shardEnd - 1) =
+              shardIndices.cols(shardBegin, shardEnd - 1);
+          kernels.cols(shardBegin, shardEnd - 1) =
+              shardKernels.cols(shardBegin, shardEnd - 1);
+        }
+      }
+
+      Log::Info << parallelBaseCases << " base cases." << std::endl;
+      Log::Info << parallelScores << " scores." << std::endl;
+
+      Timer::Stop("computing_products");
+      return;
+    }
+#endif
+
     typename Tree::template SingleTreeTraverser<RuleType> traverser(rules);
 
     for (size_t i = 0; i < querySet.n_cols; ++i)
@@ -563,34 +641,56 @@ void FastMKS<KernelType, MatType, TreeType>::Search(
   // Naive implementation.
   if (naive)
   {
-    // Simple double loop.  Stupid, slow, but a good benchmark.
+    // Evaluate the kernel in blocks of reference points with the blocked
+    // kernel-matrix builder (which maps suitable kernels to matrix products),
+    // then scan each block for top-k candidates.
+    const Candidate def = std::make_pair(-DBL_MAX, size_t() - 1);
+    std::vector<CandidateList> pqueues;
+    pqueues.reserve(referenceSet->n_cols);
     for (size_t q = 0; q < referenceSet->n_cols; ++q)
     {
-      const Candidate def = std::make_pair(-DBL_MAX, size_t() - 1);
       std::vector<Candidate> cList(k, def);
-      CandidateList pqueue(CandidateCmp(), std::move(cList));
+      pqueues.push_back(CandidateList(CandidateCmp(), std::move(cList)));
+    }
 
-      for (size_t r = 0; r < referenceSet->n_cols; ++r)
+    const size_t blockSize = 1024;
+    arma::mat kernelBlock;
+    for (size_t rBegin = 0; rBegin < referenceSet->n_cols; rBegin += blockSize)
+    {
+      const size_t rEnd = ((rBegin + blockSize > referenceSet->n_cols) ?
+          referenceSet->n_cols : rBegin + blockSize) - 1;
+      kernel::KernelMatrix(*referenceSet, referenceSet->cols(rBegin, rEnd),
+          kernelBlock, metric.Kernel());
+
+      // Each query has its own candidate queue, so the scan of the block can
+      // be done in parallel.
+      #pragma omp parallel for schedule(dynamic)
+      for (omp_size_t q = 0; q < (omp_size_t) referenceSet->n_cols; ++q)
       {
-        if (q == r)
-          continue; // Don't return the point as its own candidate.
+        for (size_t r = 0; r < kernelBlock.n_cols; ++r)
+        {
+          if ((size_t) q == rBegin + r)
+            continue; // Don't return the point as its own candidate.
 
-        const double eval = metric.Kernel().Evaluate(referenceSet->col(q),
-                                                     referenceSet->col(r));
+          const double eval = kernelBlock(q, r);
 
-        if (eval > pqueue.top().first)
-        {
-          Candidate c = std::make_pair(eval, r);
-          pqueue.pop();
-          pqueue.push(c);
+          if (eval > pqueues[q].top().first)
+          {
+            Candidate c = std::make_pair(eval, rBegin + r);
+            pqueues[q].pop();
+            pqueues[q].push(c);
+          }
         }
       }
+    }
 
+    for (size_t q = 0; q < referenceSet->n_cols; ++q)
+    {
       for (size_t j = 1; j <= k; j++)
       {
-        indices(k - j, q) = pqueue.top().second;
-        kernels(k - j, q) = pqueue.top().first;
-        pqueue.pop();
+        indices(k - j, q) = pqueues[q].top().second;
+        kernels(k - j, q) = pqueues[q].top().first;
+        pqueues[q].pop();
       }
     }
 
@@ -607,6 +707,55 @@ void FastMKS<KernelType, MatType, TreeType>::Search(
     typedef FastMKSRules<KernelType, Tree> RuleType;
     RuleType rules(*referenceSet, *referenceSet, k, metric.Kernel());
 
+    // Shard the query points across the available threads, as in the
+    // bichromatic Search() above.
+#ifdef HAS_OPENMP
+    const size_t numThreads = (size_t) omp_get_max_threads();
+    if (numThreads > 1 && referenceSet->n_cols > 1)
+    {
+      size_t parallelScores = 0;
+      size_t parallelBaseCases = 0;
+
+      #pragma omp parallel reduction(+: parallelScores, parallelBaseCases)
+      {
+        const size_t thread = (size_t) omp_get_thread_num();
+        const size_t actualThreads = (size_t) omp_get_num_threads();
+        const size_t shardBegin =
+            (thread * referenceSet->n_cols) / actualThreads;
+        const size_t shardEnd =
+            ((thread + 1) * referenceSet->n_cols) / actualThreads;
+
+        if (shardEnd > shardBegin)
+        {
+          RuleType localRules(rules);
+          typename Tree::template SingleTreeTraverser<RuleType>
+              traverser(localRules);
+
+          for (size_t i = shardBegin; i < shardEnd; ++i)
+            traverser.Traverse(i, *referenceTree);
+
+          parallelScores += localRules.Scores();
+          parallelBaseCases += localRules.BaseCases();
+
+          arma::Mat<size_t> shardIndices;
+          arma::mat shardKernels;
+          localRules.GetResults(shardIndices, shardKernels);
+
+          indices.cols(shardBegin, shardEnd - 1) =
+              shardIndices.cols(shardBegin, shardEnd - 1);
+          kernels.cols(shardBegin, shardEnd - 1) =
+              shardKernels.cols(shardBegin, shardEnd - 1);
+        }
+      }
+
+      Log::Info << parallelBaseCases << " base cases." << std::endl;
+      Log::Info << parallelScores << " scores." << std::endl;
+
+      Timer::Stop("computing_products");
+      return;
+    }
+#endif
+
     typename Tree::template SingleTreeTraverser<RuleType> traverser(rules);
 
     for (size_t i = 0; i < referenceSet->n_cols; ++i)
@@ -174,6 +174,30 @@ class DiagonalGMM
    */
   double LogProbability(const arma::vec& observation) const;
 
+  /**
+   * Return the probability that each observation (column) of the given
+   * matrix came from this distribution.  Every component is evaluated over
+   * the whole matrix at once, which is much faster than repeated
+   * single-observation calls.
+   *
+   * @param observation Matrix of observations.
+   * @param probabilities Output probabilities for each observation.
+   */
+  void Probability(const arma::mat& observation,
+                   arma::vec& probabilities) const;
+
+  /**
+   * Return the log probability that each observation (column) of the given
+   * matrix came from this distribution.  Every component is evaluated over
+   * the whole matrix at once, which is much faster than repeated
+   * single-observation calls.
+   *
+   * @param observation Matrix of observations.
+   * @param logProbabilities Output log-probabilities for each observation.
+   */
+  void LogProbability(const arma::mat& observation,
+                      arma::vec& logProbabilities) const;
+
   /**
    * Return the probability that the given observation came from the given
    * Gaussian component in this distribution.
@@ -15,6 +15,7 @@
 #define MLPACK_METHODS_GMM_EM_FIT_HPP
 
 #include <mlpack/prereqs.hpp>
+#include <mlpack/core/data/checkpoint.hpp>
 #include <mlpack/core/dists/gaussian_distribution.hpp>
 #include <mlpack/core/dists/diagonal_gaussian_distribution.hpp>
 
@@ -127,11 +128,46 @@ class EMFit
   //! Modify the tolerance for the convergence of the EM algorithm.
   double& Tolerance() { return tolerance; }
 
+  //! Get the checkpoint file (empty means checkpointing is disabled).
+  const std::string& CheckpointFile() const { return checkpointFile; }
+  //! Modify the checkpoint file; a restarted fit resumes from this file.
+  std::string& CheckpointFile() { return checkpointFile; }
+
+  //! Get the number of EM iterations between checkpoint snapshots.
+  size_t CheckpointInterval() const { return checkpointInterval; }
+  //! Modify the number of EM iterations between checkpoint snapshots.
+  size_t& CheckpointInterval() { return checkpointInterval; }
+
   //! Serialize the fitter.
   template<typename Archive>
   void serialize(Archive& ar, const unsigned int version);
 
- private:
+  //! Virtual destructor, since derived fitters override the E-step.
+  virtual ~EMFit() { }
+
+ protected:
+  /**
+   * Compute the normalized conditional log probabilities (responsibilities)
+   * of every component for every observation.  The E-step is blocked: the
+   * observations are processed in column blocks, and for each block all
+   * components' log probabilities are computed and normalized with LogAdd in
+   * the same pass, with the blocks distributed across threads.
+   *
+   * This is virtual so that derived fitters (e.g. TreeEMFit) can substitute
+   * an accelerated E-step while reusing the EM loop and M-step unchanged.
+   *
+   * @param observations List of observations.
+   * @param dists Current component distributions.
+   * @param weights Current a priori weights.
+   * @param condLogProb Matrix to store the normalized conditional log
+   *     probabilities into (n_points rows, one column per component).
+   */
+  virtual void ComputeConditionalLogProbabilities(
+      const arma::mat& observations,
+      const std::vector<Distribution>& dists,
+      const arma::vec& weights,
+      arma::mat& condLogProb) const;
+
   /**
    * Run the clusterer, and then turn the cluster assignments into Gaussians.
    * This is a helper function for both overloads of Estimate().  The vectors
@@ -178,6 +214,31 @@ class EMFit
       arma::vec& weights,
       const bool useInitialModel);
 
+  /**
+   * The resumable state of the EM loop, bundled for checkpointing: the
+   * component distributions, the a priori weights, the iteration count, and
+   * the last two log-likelihood values (so the convergence check picks up
+   * exactly where it left off).
+   */
+  struct CheckpointState
+  {
+    std::vector<Distribution> dists;
+    arma::vec weights;
+    size_t iteration = 1;
+    double logLikelihood = 0.0;
+    double oldLogLikelihood = -DBL_MAX;
+
+    template<typename Archive>
+    void serialize(Archive& ar, const unsigned int /* version */)
+    {
+      ar & BOOST_SERIALIZATION_NVP(dists);
+      ar & BOOST_SERIALIZATION_NVP(weights);
+      ar & BOOST_SERIALIZATION_NVP(iteration);
+      ar & BOOST_SERIALIZATION_NVP(logLikelihood);
+      ar & BOOST_SERIALIZATION_NVP(oldLogLikelihood);
+    }
+  };
+
   //! Maximum iterations of EM algorithm.
   size_t maxIterations;
   //! Tolerance for convergence of EM.
@@ -186,6 +247,12 @@ class EMFit
   InitialClusteringType clusterer;
   //! Object which applies constraints to the covariance matrix.
   CovarianceConstraintPolicy constraint;
+  //! File the EM state is periodically snapshotted to; empty disables
+  //! checkpointing.  This is run configuration, so it is not serialized with
+  //! the fitter.
+  std::string checkpointFile;
+  //! Number of EM iterations between snapshots.
+  size_t checkpointInterval;
 };
 
 } // namespace gmm
@@ -33,7 +33,9 @@ EMFit<InitialClusteringType, CovarianceConstraintPolicy, Distribution>::EMFit(
     maxIterations(maxIterations),
     tolerance(tolerance),
     clusterer(clusterer),
-    constraint(constraint)
+    constraint(constraint),
+    checkpointFile(""),
+    checkpointInterval(10)
 { /* Nothing to do. */ }
 
 template<typename InitialClusteringType,
@@ -81,31 +83,32 @@ Estimate(const arma::mat& observations,
 
   // Iterate to update the model until no more improvement is found.
   size_t iteration = 1;
+
+  // If a checkpoint file is configured and exists, resume the EM loop from
+  // the last snapshot instead of from the initial clustering.
+  const data::Checkpoint checkpoint(checkpointFile, checkpointInterval);
+  CheckpointState state;
+  if (checkpoint.Restore(state))
+  {
+    dists = std::move(state.dists);
+    weights = std::move(state.weights);
+    iteration = state.iteration;
+    l = state.logLikelihood;
+    lOld = state.oldLogLikelihood;
+    Log::Info << "EMFit::Estimate(): resumed from '" << checkpoint.Filename()
+        << "' at iteration " << iteration << "." << std::endl;
+  }
+
   while (std::abs(l - lOld) > tolerance && iteration != maxIterations)
   {
     Log::Info << "EMFit::Estimate(): iteration " << iteration << ", "
         << "log-likelihood " << l << "." << std::endl;
 
     // Calculate the conditional probabilities of choosing a particular
-    // Gaussian given the observations and the present theta value.
-    for (size_t i = 0; i < dists.size(); i++)
-    {
-      // Store conditional log probabilities into condLogProb vector for each
-      // Gaussian.  First we make an alias of the condLogProb vector.
-      arma::vec condLogProbAlias = condLogProb.unsafe_col(i);
-      dists[i].LogProbability(observations, condLogProbAlias);
-      condLogProbAlias += log(weights[i]);
-    }
-
-    // Normalize row-wise.
-    for (size_t i = 0; i < condLogProb.n_rows; i++)
-    {
-      // Avoid dividing by zero; if the probability for everything is 0, we
-      // don't want to make it NaN.
-      const double probSum = mlpack::math::AccuLog(condLogProb.row(i));
-      if (probSum != -std::numeric_limits<double>::infinity())
-        condLogProb.row(i) -= probSum;
-    }
+    // Gaussian given the observations and the present theta value.  The
+    // E-step is blocked over points and runs across threads.
+    ComputeConditionalLogProbabilities(observations, dists, weights,
+        condLogProb);
 
     // Store the sum of the probability of each state over all the observations.
     arma::vec probRowSums(dists.size());
@@ -163,7 +166,21 @@ Estimate(const arma::mat& observations,
     l = LogLikelihood(observations, dists, weights);
 
     iteration++;
+
+    // Snapshot the EM state every checkpointInterval iterations.
+    if (checkpoint.Enabled())
+    {
+      state.dists = dists;
+      state.weights = weights;
+      state.iteration = iteration;
+      state.logLikelihood = l;
+      state.oldLogLikelihood = lOld;
+      checkpoint.Save(iteration, state);
+    }
   }
+
+  // The fit finished, so a restarted job should not resume from a snapshot.
+  checkpoint.Finish();
 }
 
 template<typename InitialClusteringType,
@@ -192,25 +209,10 @@ Estimate(const arma::mat& observations,
   while (std::abs(l - lOld) > tolerance && iteration != maxIterations)
   {
     // Calculate the conditional probabilities of choosing a particular
-    // Gaussian given the observations and the present theta value.
-    for (size_t i = 0; i < dists.size(); i++)
-    {
-      // Store conditional log probabilities into condLogProb vector for each
-      // Gaussian.  First we make an alias of the condLogProb vector.
-      arma::vec condLogProbAlias = condLogProb.unsafe_col(i);
-      dists[i].LogProbability(observations, condLogProbAlias);
-      condLogProbAlias += log(weights[i]);
-    }
-
-    // Normalize row-wise.
-    for (size_t i = 0; i < condLogProb.n_rows; i++)
-    {
-      // Avoid dividing by zero; if the probability for everything is 0, we
-      // don't want to make it NaN.
-      const double probSum = mlpack::math::AccuLog(condLogProb.row(i));
-      if (probSum != -std::numeric_limits<double>::infinity())
-        condLogProb.row(i) -= probSum;
-    }
+    // Gaussian given the observations and the present theta value.  The
+    // E-step is blocked over points and runs across threads.
+    ComputeConditionalLogProbabilities(observations, dists, weights,
+        condLogProb);
 
     // This will store the sum of probabilities of each state over all the
     // observations.
@@ -373,6 +375,53 @@ InitialClustering(const arma::mat& observations,
   weights /= accu(weights);
 }
 
+template<typename InitialClusteringType,
+         typename CovarianceConstraintPolicy,
+         typename Distribution>
+void EMFit<InitialClusteringType, CovarianceConstraintPolicy, Distribution>::
+ComputeConditionalLogProbabilities(const arma::mat& observations,
+                                   const std::vector<Distribution>& dists,
+                                   const arma::vec& weights,
+                                   arma::mat& condLogProb) const
+{
+  condLogProb.set_size(observations.n_cols, dists.size());
+
+  // Process the observations in column blocks.  Each thread owns a block,
+  // computes every component's log probabilities for it, and normalizes the
+  // block's responsibilities in the same pass, so each block of points is
+  // touched once while it is hot in cache.
+  const size_t blockSize = 512;
+  const size_t numBlocks = (observations.n_cols + blockSize - 1) / blockSize;
+
+  #pragma omp parallel for schedule(static)
+  for (omp_size_t block = 0; block < (omp_size_t) numBlocks; ++block)
+  {
+    const size_t begin = block * blockSize;
+    const size_t end = (begin + blockSize > observations.n_cols) ?
+        (observations.n_cols - 1) : (begin + blockSize - 1);
+
+    const arma::mat blockObservations = observations.cols(begin, end);
+
+    arma::vec blockLogProb;
+    for (size_t i = 0; i < dists.size(); i++)
+    {
+      dists[i].LogProbability(blockObservations, blockLogProb);
+      condLogProb.col(i).subvec(begin, end) = blockLogProb +
+          std::log(weights[i]);
+    }
+
+    // Normalize row-wise.
+    for (size_t j = begin; j <= end; j++)
+    {
+      // Avoid dividing by zero; if the probability for everything is 0, we
+      // don't want to make it NaN.
+      const double probSum = mlpack::math::AccuLog(condLogProb.row(j));
+      if (probSum != -std::numeric_limits<double>::infinity())
+        condLogProb.row(j) -= probSum;
+    }
+  }
+}
+
 template<typename InitialClusteringType,
          typename CovarianceConstraintPolicy,
          typename Distribution>
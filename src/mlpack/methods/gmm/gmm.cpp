@@ -74,6 +74,37 @@ double GMM::Probability(const arma::vec& observation) const
   return exp(LogProbability(observation));
 }
 
+/**
+ * Return the log probability of each observation (column) being from this
+ * GMM.
+ */
+void GMM::LogProbability(const arma::mat& observation,
+                         arma::vec& logProbabilities) const
+{
+  // Evaluate every component over the whole matrix of observations at once,
+  // then combine with the priors via a vectorized log-space sum over
+  // components.
+  arma::mat logComponentProbs(gaussians, observation.n_cols);
+  arma::vec tmp;
+  for (size_t i = 0; i < gaussians; i++)
+  {
+    dists[i].LogProbability(observation, tmp);
+    logComponentProbs.row(i) = log(weights[i]) + tmp.t();
+  }
+
+  math::LogSumExp(logComponentProbs, logProbabilities);
+}
+
+/**
+ * Return the probability of each observation (column) being from this GMM.
+ */
+void GMM::Probability(const arma::mat& observation,
+                      arma::vec& probabilities) const
+{
+  LogProbability(observation, probabilities);
+  probabilities = arma::exp(probabilities);
+}
+
 /**
  * Return the log probability of the given observation being from the given
  * component in the mixture.
@@ -133,26 +164,23 @@ arma::vec GMM::Random() const
 void GMM::Classify(const arma::mat& observations,
                    arma::Row<size_t>& labels) const
 {
-  // This is not the best way to do this!
-
-  // We should not have to fill this with values, because each one should be
-  // overwritten.
+  // Evaluate every component over all observations at once; we have to work
+  // in log space, otherwise Probability() would overflow easily.
   labels.set_size(observations.n_cols);
+  arma::mat logComponentProbs(gaussians, observations.n_cols);
+  arma::vec tmp;
+  for (size_t j = 0; j < gaussians; ++j)
+  {
+    dists[j].LogProbability(observations, tmp);
+    logComponentProbs.row(j) = log(weights[j]) + tmp.t();
+  }
+
+  // Now pick the maximum probability component for each point.
+  arma::uword index;
   for (size_t i = 0; i < observations.n_cols; ++i)
   {
-    // Find maximum probability component.
-    double probability = -std::numeric_limits<double>::infinity();
-    for (size_t j = 0; j < gaussians; ++j)
-    {
-      // We have to use LogProbability() otherwise Probability() would overflow
-      // easily.
-      double newProb = LogProbability(observations.unsafe_col(i), j);
-      if (newProb >= probability)
-      {
-        probability = newProb;
-        labels[i] = j;
-      }
-    }
+    logComponentProbs.unsafe_col(i).max(index);
+    labels[i] = index;
   }
 }
 
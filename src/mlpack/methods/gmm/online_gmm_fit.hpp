@@ -0,0 +1,125 @@
+/**
+ * @file methods/gmm/online_gmm_fit.hpp
+ * @author Ryan Curtin
+ *
+ * Online (stochastic) EM estimation of a Gaussian Mixture Model from a stream
+ * of mini-batches, using exponentially-forgotten sufficient statistics.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_GMM_ONLINE_GMM_FIT_HPP
+#define MLPACK_METHODS_GMM_ONLINE_GMM_FIT_HPP
+
+#include <mlpack/prereqs.hpp>
+
+#include "gmm.hpp"
+#include "positive_definite_constraint.hpp"
+
+namespace mlpack {
+namespace gmm {
+
+/**
+ * OnlineGMMFit fits a GMM to a stream of mini-batches with stepwise
+ * (stochastic) EM.  Instead of iterating batch EM over an ever-growing
+ * observation window, the class maintains one set of per-component sufficient
+ * statistics---the responsibility mass, the responsibility-weighted
+ * observation sums, and the responsibility-weighted second moments---and
+ * blends the statistics of every new mini-batch into them with an exponential
+ * forgetting factor eta:
+ *
+ * @code
+ * s <- (1 - eta) * s + eta * s_batch
+ * @endcode
+ *
+ * The model is re-derived from the blended statistics after every batch, so
+ * memory use is constant in the length of the stream, and the model tracks
+ * drift in the underlying distribution at a rate controlled by eta: larger
+ * values adapt faster but are noisier, and the effective observation window
+ * is roughly (batch size / eta) points.
+ *
+ * The first call to Update() seeds the model and the statistics by running
+ * ordinary batch EM (GMM::Train()) on the first mini-batch, so the first
+ * batch should be large enough for a reasonable initial fit.
+ *
+ * @tparam CovarianceConstraintPolicy The type of constraint to apply to the
+ *     covariance matrices after each update (PositiveDefiniteConstraint is
+ *     suggested).
+ */
+template<typename CovarianceConstraintPolicy = PositiveDefiniteConstraint>
+class OnlineGMMFit
+{
+ public:
+  /**
+   * Construct the online fitter with the given forgetting factor.
+   *
+   * @param forgettingFactor Weight eta in (0, 1] given to the statistics of
+   *     each new mini-batch.
+   * @param constraint The constraint to apply to the covariances.
+   */
+  OnlineGMMFit(const double forgettingFactor = 0.05,
+               CovarianceConstraintPolicy constraint =
+                   CovarianceConstraintPolicy());
+
+  /**
+   * Update the given GMM from one mini-batch of observations.  On the first
+   * call (or after Reset()), the model is seeded with batch EM on the given
+   * mini-batch; on every later call one stepwise EM update is performed.  The
+   * GMM must already have its number of components and dimensionality set,
+   * and the same model should be passed to every call.
+   *
+   * The average log-likelihood of the batch under the model from *before*
+   * the update is returned; a drop in this value is a useful drift or
+   * anomaly signal.
+   *
+   * @param batch Mini-batch of observations (one column per observation).
+   * @param gmm Model to update.
+   * @return Average per-point log-likelihood of the batch.
+   */
+  double Update(const arma::mat& batch, GMM& gmm);
+
+  /**
+   * Discard the accumulated sufficient statistics; the next call to Update()
+   * will re-seed the model from its mini-batch.
+   */
+  void Reset();
+
+  //! Whether the statistics have been seeded by a first mini-batch.
+  bool Initialized() const { return initialized; }
+
+  //! Get the forgetting factor.
+  double ForgettingFactor() const { return forgettingFactor; }
+  //! Modify the forgetting factor.
+  double& ForgettingFactor() { return forgettingFactor; }
+
+  //! Get the responsibility mass of each component (sums to one).
+  const arma::vec& ComponentMasses() const { return componentMasses; }
+
+  //! Serialize the fitter (including the accumulated statistics).
+  template<typename Archive>
+  void serialize(Archive& ar, const unsigned int /* version */);
+
+ private:
+  //! Forgetting factor eta applied to each new mini-batch.
+  double forgettingFactor;
+  //! Covariance constraint policy.
+  CovarianceConstraintPolicy constraint;
+  //! Whether the statistics have been seeded.
+  bool initialized;
+  //! Responsibility mass of each component; sums to one.
+  arma::vec componentMasses;
+  //! Responsibility-weighted observation sums (one column per component).
+  arma::mat weightedSums;
+  //! Responsibility-weighted second moments of each component.
+  std::vector<arma::mat> secondMoments;
+};
+
+} // namespace gmm
+} // namespace mlpack
+
+// Include implementation.
+#include "online_gmm_fit_impl.hpp"
+
+#endif
@@ -0,0 +1,162 @@
+/**
+ * @file methods/gmm/online_gmm_fit_impl.hpp
+ * @author Ryan Curtin
+ *
+ * Implementation of the OnlineGMMFit class.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_GMM_ONLINE_GMM_FIT_IMPL_HPP
+#define MLPACK_METHODS_GMM_ONLINE_GMM_FIT_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "online_gmm_fit.hpp"
+
+#include <mlpack/core/math/log_add.hpp>
+
+namespace mlpack {
+namespace gmm {
+
+template<typename CovarianceConstraintPolicy>
+OnlineGMMFit<CovarianceConstraintPolicy>::OnlineGMMFit(
+    const double forgettingFactor,
+    CovarianceConstraintPolicy constraint) :
+    forgettingFactor(forgettingFactor),
+    constraint(constraint),
+    initialized(false)
+{
+  if (forgettingFactor <= 0.0 || forgettingFactor > 1.0)
+    throw std::invalid_argument("OnlineGMMFit::OnlineGMMFit(): invalid "
+        "forgetting factor; must be in (0, 1]!");
+}
+
+template<typename CovarianceConstraintPolicy>
+double OnlineGMMFit<CovarianceConstraintPolicy>::Update(const arma::mat& batch,
+                                                        GMM& gmm)
+{
+  const size_t gaussians = gmm.Gaussians();
+  const size_t dims = gmm.Dimensionality();
+
+  if (gaussians == 0)
+    throw std::invalid_argument("OnlineGMMFit::Update(): the given GMM has "
+        "no components!");
+  if (batch.n_rows != dims)
+    throw std::invalid_argument("OnlineGMMFit::Update(): dimensionality of "
+        "the batch does not match the dimensionality of the GMM!");
+  if (batch.n_cols == 0)
+    throw std::invalid_argument("OnlineGMMFit::Update(): empty batch!");
+
+  if (!initialized)
+  {
+    // Seed the model with ordinary batch EM on the first mini-batch, then
+    // derive the initial sufficient statistics from the fitted model.
+    const double logLikelihood = gmm.Train(batch);
+
+    componentMasses = gmm.Weights();
+    weightedSums.set_size(dims, gaussians);
+    secondMoments.resize(gaussians);
+    for (size_t j = 0; j < gaussians; ++j)
+    {
+      const arma::vec& mean = gmm.Component(j).Mean();
+      weightedSums.col(j) = componentMasses[j] * mean;
+      secondMoments[j] = componentMasses[j] *
+          (gmm.Component(j).Covariance() + mean * mean.t());
+    }
+
+    initialized = true;
+    return logLikelihood / batch.n_cols;
+  }
+
+  // E-step: compute the normalized conditional log probabilities
+  // (responsibilities) of the batch under the current model, the same way
+  // EMFit does.
+  arma::mat condLogProb(batch.n_cols, gaussians);
+  arma::vec logPhis;
+  for (size_t j = 0; j < gaussians; ++j)
+  {
+    gmm.Component(j).LogProbability(batch, logPhis);
+    condLogProb.col(j) = logPhis + std::log(gmm.Weights()[j]);
+  }
+
+  double batchLogLikelihood = 0.0;
+  for (size_t i = 0; i < batch.n_cols; ++i)
+  {
+    // Avoid dividing by zero; if the probability for everything is 0, we
+    // don't want to make it NaN.
+    const double probSum = mlpack::math::AccuLog(condLogProb.row(i));
+    if (probSum != -std::numeric_limits<double>::infinity())
+    {
+      batchLogLikelihood += probSum;
+      condLogProb.row(i) -= probSum;
+    }
+  }
+
+  // Sufficient statistics of this batch, normalized per point so they are on
+  // the same scale as the running statistics.
+  const arma::mat resp = arma::exp(condLogProb);
+  const arma::vec batchMasses = arma::trans(arma::sum(resp, 0)) /
+      batch.n_cols;
+  const arma::mat batchSums = batch * resp / batch.n_cols;
+
+  // Blend the batch statistics into the running statistics with exponential
+  // forgetting, then re-derive the model (the M-step).
+  const double eta = forgettingFactor;
+  componentMasses = (1.0 - eta) * componentMasses + eta * batchMasses;
+  weightedSums = (1.0 - eta) * weightedSums + eta * batchSums;
+
+  for (size_t j = 0; j < gaussians; ++j)
+  {
+    const arma::mat batchMoment = (batch.each_row() %
+        arma::trans(resp.col(j))) * batch.t() / batch.n_cols;
+    secondMoments[j] = (1.0 - eta) * secondMoments[j] + eta * batchMoment;
+
+    // Don't update a component that has no responsibility mass.
+    if (componentMasses[j] <= 0.0)
+      continue;
+
+    const arma::vec mean = weightedSums.col(j) / componentMasses[j];
+    arma::mat covariance = secondMoments[j] / componentMasses[j] -
+        mean * mean.t();
+
+    // Apply covariance constraint.
+    constraint.ApplyConstraint(covariance);
+
+    gmm.Component(j).Mean() = mean;
+    gmm.Component(j).Covariance(std::move(covariance));
+  }
+
+  gmm.Weights() = componentMasses / arma::accu(componentMasses);
+
+  return batchLogLikelihood / batch.n_cols;
+}
+
+template<typename CovarianceConstraintPolicy>
+void OnlineGMMFit<CovarianceConstraintPolicy>::Reset()
+{
+  initialized = false;
+  componentMasses.reset();
+  weightedSums.reset();
+  secondMoments.clear();
+}
+
+template<typename CovarianceConstraintPolicy>
+template<typename Archive>
+void OnlineGMMFit<CovarianceConstraintPolicy>::serialize(
+    Archive& ar,
+    const unsigned int /* version */)
+{
+  ar & BOOST_SERIALIZATION_NVP(forgettingFactor);
+  ar & BOOST_SERIALIZATION_NVP(constraint);
+  ar & BOOST_SERIALIZATION_NVP(initialized);
+  ar & BOOST_SERIALIZATION_NVP(componentMasses);
+  ar & BOOST_SERIALIZATION_NVP(weightedSums);
+  ar & BOOST_SERIALIZATION_NVP(secondMoments);
+}
+
+} // namespace gmm
+} // namespace mlpack
+
+#endif
@@ -0,0 +1,136 @@
+/**
+ * @file methods/gmm/tree_em_fit.hpp
+ * @author Ryan Curtin
+ *
+ * Tree-accelerated EM fitting for Gaussian mixture models.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_GMM_TREE_EM_FIT_HPP
+#define MLPACK_METHODS_GMM_TREE_EM_FIT_HPP
+
+#include <mlpack/prereqs.hpp>
+#include <mlpack/core/tree/binary_space_tree.hpp>
+
+#include "em_fit.hpp"
+
+namespace mlpack {
+namespace gmm {
+
+/**
+ * A tree-accelerated variant of EMFit for Gaussian mixture models.  The
+ * observations are indexed once with a kd-tree (a BinarySpaceTree); during
+ * each E-step, the tree is traversed and, for every node, per-component
+ * bounds on the responsibilities are computed from the node's bounding box
+ * and the component covariance spectra.  Components whose maximum possible
+ * responsibility anywhere in the node is below the prune tolerance are
+ * dropped for the entire subtree, so leaves only evaluate the handful of
+ * components that can actually matter for their points.
+ *
+ * This pays off when the number of points is large and the dimension is
+ * small (roughly d <= 10), where most components are provably negligible for
+ * most regions of space; in high dimensions the bounding boxes become too
+ * loose to prune much and plain EMFit is preferable.  The M-step, initial
+ * clustering, and convergence logic are inherited from EMFit unchanged, so
+ * TreeEMFit can be passed anywhere a FittingType is expected (e.g.
+ * GMM::Train()).
+ *
+ * @tparam InitialClusteringType Type of clustering for initialization.
+ * @tparam CovarianceConstraintPolicy Policy for constraining covariances.
+ */
+template<typename InitialClusteringType = kmeans::KMeans<>,
+         typename CovarianceConstraintPolicy = PositiveDefiniteConstraint>
+class TreeEMFit :
+    public EMFit<InitialClusteringType,
+                 CovarianceConstraintPolicy,
+                 distribution::GaussianDistribution>
+{
+ public:
+  /**
+   * Construct the TreeEMFit object.  Setting the maximum number of
+   * iterations to 0 means that the EM algorithm will iterate until
+   * convergence (with the given tolerance).
+   *
+   * @param maxIterations Maximum number of iterations for EM.
+   * @param tolerance Log-likelihood tolerance required for convergence.
+   * @param pruneTolerance Components whose maximum possible responsibility
+   *     within a tree node falls below this value are pruned for the node's
+   *     entire subtree.
+   * @param clusterer Object which will perform the initial clustering.
+   * @param constraint Constraint policy of covariance.
+   */
+  TreeEMFit(const size_t maxIterations = 300,
+            const double tolerance = 1e-10,
+            const double pruneTolerance = 1e-10,
+            InitialClusteringType clusterer = InitialClusteringType(),
+            CovarianceConstraintPolicy constraint =
+                CovarianceConstraintPolicy());
+
+  //! Get the responsibility prune tolerance.
+  double PruneTolerance() const { return pruneTolerance; }
+  //! Modify the responsibility prune tolerance.
+  double& PruneTolerance() { return pruneTolerance; }
+
+ protected:
+  //! Convenience typedef for the tree type used by the E-step.
+  typedef tree::KDTree<metric::EuclideanDistance, tree::EmptyStatistic,
+      arma::mat> TreeType;
+
+  /**
+   * Compute the normalized conditional log probabilities via kd-tree
+   * traversal with per-node component pruning.  Entries for pruned
+   * components are set to -inf (zero responsibility).
+   *
+   * @param observations List of observations.
+   * @param dists Current component distributions.
+   * @param weights Current a priori weights.
+   * @param condLogProb Matrix to store the normalized conditional log
+   *     probabilities into (n_points rows, one column per component).
+   */
+  virtual void ComputeConditionalLogProbabilities(
+      const arma::mat& observations,
+      const std::vector<distribution::GaussianDistribution>& dists,
+      const arma::vec& weights,
+      arma::mat& condLogProb) const;
+
+ private:
+  /**
+   * Recurse into the tree, pruning components whose maximum possible
+   * responsibility in the given node is negligible, and computing exact
+   * responsibilities over the surviving components at the leaves.
+   *
+   * @param node Current tree node.
+   * @param activeComponents Components not yet pruned for this subtree.
+   * @param dists Current component distributions.
+   * @param logWeights Log of the a priori weights.
+   * @param logNormalizers Log normalization constant of each component.
+   * @param minEigenvalues Smallest covariance eigenvalue of each component.
+   * @param maxEigenvalues Largest covariance eigenvalue of each component.
+   * @param oldFromNew Mapping from tree point indices to original indices.
+   * @param condLogProb Output responsibility matrix.
+   */
+  void EStepRecursion(
+      TreeType& node,
+      const std::vector<size_t>& activeComponents,
+      const std::vector<distribution::GaussianDistribution>& dists,
+      const arma::vec& logWeights,
+      const arma::vec& logNormalizers,
+      const arma::vec& minEigenvalues,
+      const arma::vec& maxEigenvalues,
+      const std::vector<size_t>& oldFromNew,
+      arma::mat& condLogProb) const;
+
+  //! Responsibilities below this are pruned per tree node.
+  double pruneTolerance;
+};
+
+} // namespace gmm
+} // namespace mlpack
+
+// Include implementation.
+#include "tree_em_fit_impl.hpp"
+
+#endif
@@ -0,0 +1,166 @@
+/**
+ * @file methods/gmm/tree_em_fit_impl.hpp
+ * @author Ryan Curtin
+ *
+ * Implementation of the tree-accelerated EM algorithm for fitting GMMs.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_GMM_TREE_EM_FIT_IMPL_HPP
+#define MLPACK_METHODS_GMM_TREE_EM_FIT_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "tree_em_fit.hpp"
+#include <mlpack/core/math/log_add.hpp>
+
+namespace mlpack {
+namespace gmm {
+
+//! Constructor.
+template<typename InitialClusteringType, typename CovarianceConstraintPolicy>
+TreeEMFit<InitialClusteringType, CovarianceConstraintPolicy>::TreeEMFit(
+    const size_t maxIterations,
+    const double tolerance,
+    const double pruneTolerance,
+    InitialClusteringType clusterer,
+    CovarianceConstraintPolicy constraint) :
+    EMFit<InitialClusteringType, CovarianceConstraintPolicy,
+        distribution::GaussianDistribution>(maxIterations, tolerance,
+        clusterer, constraint),
+    pruneTolerance(pruneTolerance)
+{ /* Nothing to do. */ }
+
+template<typename InitialClusteringType, typename CovarianceConstraintPolicy>
+void TreeEMFit<InitialClusteringType, CovarianceConstraintPolicy>::
+ComputeConditionalLogProbabilities(
+    const arma::mat& observations,
+    const std::vector<distribution::GaussianDistribution>& dists,
+    const arma::vec& weights,
+    arma::mat& condLogProb) const
+{
+  // Pruned components get zero responsibility.
+  condLogProb.set_size(observations.n_cols, dists.size());
+  condLogProb.fill(-std::numeric_limits<double>::infinity());
+
+  // Index the observations.  The tree permutes its copy of the dataset, so
+  // keep the mapping back to the original column order.
+  std::vector<size_t> oldFromNew;
+  TreeType tree(observations, oldFromNew);
+
+  // Precompute, for every component, the log weight, the log normalization
+  // constant, and the extreme covariance eigenvalues; the eigenvalues turn
+  // Euclidean distance bounds from the tree's bounding boxes into bounds on
+  // the Mahalanobis distance.
+  const size_t dimensionality = observations.n_rows;
+  arma::vec logWeights = arma::log(weights);
+  arma::vec logNormalizers(dists.size());
+  arma::vec minEigenvalues(dists.size()), maxEigenvalues(dists.size());
+  for (size_t i = 0; i < dists.size(); ++i)
+  {
+    arma::vec eigenvalues;
+    arma::eig_sym(eigenvalues, dists[i].Covariance());
+
+    minEigenvalues(i) = eigenvalues.min();
+    maxEigenvalues(i) = eigenvalues.max();
+    logNormalizers(i) = -0.5 * (dimensionality * std::log(2.0 * M_PI) +
+        arma::accu(arma::log(eigenvalues)));
+  }
+
+  // Start with every component active.
+  std::vector<size_t> activeComponents(dists.size());
+  for (size_t i = 0; i < dists.size(); ++i)
+    activeComponents[i] = i;
+
+  EStepRecursion(tree, activeComponents, dists, logWeights, logNormalizers,
+      minEigenvalues, maxEigenvalues, oldFromNew, condLogProb);
+}
+
+template<typename InitialClusteringType, typename CovarianceConstraintPolicy>
+void TreeEMFit<InitialClusteringType, CovarianceConstraintPolicy>::
+EStepRecursion(
+    TreeType& node,
+    const std::vector<size_t>& activeComponents,
+    const std::vector<distribution::GaussianDistribution>& dists,
+    const arma::vec& logWeights,
+    const arma::vec& logNormalizers,
+    const arma::vec& minEigenvalues,
+    const arma::vec& maxEigenvalues,
+    const std::vector<size_t>& oldFromNew,
+    arma::mat& condLogProb) const
+{
+  // Bound each active component's weighted log probability over the node's
+  // bounding box.  For a Gaussian, the Mahalanobis distance to any point of
+  // the box is at least dmin^2 / lambda_max and at most dmax^2 / lambda_min,
+  // where dmin and dmax are the Euclidean distance bounds to the mean.
+  arma::vec upperBounds(activeComponents.size());
+  arma::vec lowerBounds(activeComponents.size());
+  for (size_t a = 0; a < activeComponents.size(); ++a)
+  {
+    const size_t i = activeComponents[a];
+    const double minDistance = node.Bound().MinDistance(dists[i].Mean());
+    const double maxDistance = node.Bound().MaxDistance(dists[i].Mean());
+
+    upperBounds(a) = logWeights(i) + logNormalizers(i) -
+        0.5 * minDistance * minDistance / maxEigenvalues(i);
+    lowerBounds(a) = logWeights(i) + logNormalizers(i) -
+        0.5 * maxDistance * maxDistance / minEigenvalues(i);
+  }
+
+  // A lower bound on any point's total (denominator) likelihood in this node.
+  const double totalLowerBound = mlpack::math::AccuLog(lowerBounds);
+
+  // Keep only components whose best-case responsibility in this node reaches
+  // the prune tolerance.  If the lower bound is degenerate, keep everything.
+  std::vector<size_t> survivors;
+  if (totalLowerBound == -std::numeric_limits<double>::infinity())
+  {
+    survivors = activeComponents;
+  }
+  else
+  {
+    const double logPruneTolerance = std::log(pruneTolerance);
+    for (size_t a = 0; a < activeComponents.size(); ++a)
+    {
+      if (upperBounds(a) - totalLowerBound >= logPruneTolerance)
+        survivors.push_back(activeComponents[a]);
+    }
+  }
+
+  if (node.IsLeaf())
+  {
+    // Compute exact responsibilities over the surviving components only.
+    for (size_t k = 0; k < node.NumPoints(); ++k)
+    {
+      const size_t newIndex = node.Point(k);
+      const size_t oldIndex = oldFromNew[newIndex];
+      const arma::vec point = node.Dataset().col(newIndex);
+
+      for (size_t i : survivors)
+      {
+        condLogProb(oldIndex, i) = logWeights(i) +
+            dists[i].LogProbability(point);
+      }
+
+      // Normalize; avoid dividing by zero if every probability is 0.
+      const double probSum = mlpack::math::AccuLog(condLogProb.row(oldIndex));
+      if (probSum != -std::numeric_limits<double>::infinity())
+        condLogProb.row(oldIndex) -= probSum;
+    }
+  }
+  else
+  {
+    EStepRecursion(*node.Left(), survivors, dists, logWeights, logNormalizers,
+        minEigenvalues, maxEigenvalues, oldFromNew, condLogProb);
+    EStepRecursion(*node.Right(), survivors, dists, logWeights,
+        logNormalizers, minEigenvalues, maxEigenvalues, oldFromNew,
+        condLogProb);
+  }
+}
+
+} // namespace gmm
+} // namespace mlpack
+
+#endif
@@ -0,0 +1,214 @@
+/**
+ * @file methods/gradient_boosting/gradient_boosting.hpp
+ *
+ * Definition of the GradientBoosting class, a gradient boosted decision tree
+ * classifier built on histogram splits.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_GRADIENT_BOOSTING_GRADIENT_BOOSTING_HPP
+#define MLPACK_METHODS_GRADIENT_BOOSTING_GRADIENT_BOOSTING_HPP
+
+#include <mlpack/prereqs.hpp>
+
+namespace mlpack {
+namespace tree {
+
+/**
+ * The GradientBoosting class implements gradient boosted decision trees for
+ * classification, using the multiclass logistic (softmax) objective of
+ *
+ * @code
+ * @article{friedman2001greedy,
+ *   title={Greedy function approximation: a gradient boosting machine},
+ *   author={Friedman, J.H.},
+ *   journal={Annals of Statistics},
+ *   volume={29},
+ *   number={5},
+ *   pages={1189--1232},
+ *   year={2001}
+ * }
+ * @endcode
+ *
+ * Each boosting round fits one regression tree per class to the gradients and
+ * Hessians of the objective, with Newton leaf values and shrinkage.  The
+ * engine is built for training speed: the features are binned into
+ * equal-width histograms once, before the first round, and the shared bin
+ * matrix is reused by every tree; split finding sweeps the per-bin
+ * gradient/Hessian sums instead of sorting; the nodes of each level of a
+ * growing tree are expanded in parallel with OpenMP; and rows and columns can
+ * be subsampled per tree.
+ */
+class GradientBoosting
+{
+ public:
+  /**
+   * Construct the gradient boosting model without any training.  Classify()
+   * will throw an exception until Train() is called.
+   */
+  GradientBoosting();
+
+  /**
+   * Construct the gradient boosting model on the given labeled training data.
+   *
+   * @param data Dataset to train on.
+   * @param labels Labels for dataset.
+   * @param numClasses Number of classes in dataset.
+   * @param numTrees Number of boosting rounds (one tree per class per round).
+   * @param learningRate Shrinkage applied to the leaf values of each tree.
+   * @param maximumDepth Maximum depth of each tree.
+   * @param minimumLeafSize Minimum number of points in each leaf node.
+   * @param minimumGainSplit Minimum gain for a node to split.
+   * @param rowSubsampling Fraction of points sampled (without replacement)
+   *      for each tree.
+   * @param colSubsampling Fraction of dimensions sampled for each tree.
+   * @param numBins Number of histogram bins per dimension.
+   */
+  template<typename MatType>
+  GradientBoosting(const MatType& data,
+                   const arma::Row<size_t>& labels,
+                   const size_t numClasses,
+                   const size_t numTrees = 100,
+                   const double learningRate = 0.1,
+                   const size_t maximumDepth = 6,
+                   const size_t minimumLeafSize = 10,
+                   const double minimumGainSplit = 1e-7,
+                   const double rowSubsampling = 1.0,
+                   const double colSubsampling = 1.0,
+                   const size_t numBins = 256);
+
+  /**
+   * Train the gradient boosting model on the given labeled training data.
+   * This overwrites any previous training.
+   *
+   * @param data Dataset to train on.
+   * @param labels Labels for dataset.
+   * @param numClasses Number of classes in dataset.
+   * @param numTrees Number of boosting rounds (one tree per class per round).
+   * @param learningRate Shrinkage applied to the leaf values of each tree.
+   * @param maximumDepth Maximum depth of each tree.
+   * @param minimumLeafSize Minimum number of points in each leaf node.
+   * @param minimumGainSplit Minimum gain for a node to split.
+   * @param rowSubsampling Fraction of points sampled (without replacement)
+   *      for each tree.
+   * @param colSubsampling Fraction of dimensions sampled for each tree.
+   * @param numBins Number of histogram bins per dimension.
+   * @return The training set log-loss of the final model.
+   */
+  template<typename MatType>
+  double Train(const MatType& data,
+               const arma::Row<size_t>& labels,
+               const size_t numClasses,
+               const size_t numTrees = 100,
+               const double learningRate = 0.1,
+               const size_t maximumDepth = 6,
+               const size_t minimumLeafSize = 10,
+               const double minimumGainSplit = 1e-7,
+               const double rowSubsampling = 1.0,
+               const double colSubsampling = 1.0,
+               const size_t numBins = 256);
+
+  /**
+   * Predict the classes of each point in the given dataset.  If the model has
+   * not been trained, this will throw an exception.
+   *
+   * @param data Dataset to be classified.
+   * @param predictions Output predictions for each point in the dataset.
+   */
+  template<typename MatType>
+  void Classify(const MatType& data, arma::Row<size_t>& predictions) const;
+
+  /**
+   * Predict the classes of each point in the given dataset, also returning
+   * the softmax class probabilities for each point.  If the model has not
+   * been trained, this will throw an exception.
+   *
+   * @param data Dataset to be classified.
+   * @param predictions Output predictions for each point in the dataset.
+   * @param probabilities Output matrix of class probabilities for each point.
+   */
+  template<typename MatType>
+  void Classify(const MatType& data,
+                arma::Row<size_t>& predictions,
+                arma::mat& probabilities) const;
+
+  //! Get the number of classes in the model.
+  size_t NumClasses() const { return numClasses; }
+  //! Get the number of boosting rounds in the trained model.
+  size_t NumTrees() const
+  { return (numClasses == 0) ? 0 : trees.size() / numClasses; }
+  //! Get the learning rate (shrinkage) of the model.
+  double LearningRate() const { return learningRate; }
+
+  /**
+   * Serialize the gradient boosting model.
+   */
+  template<typename Archive>
+  void serialize(Archive& ar, const unsigned int /* version */);
+
+ private:
+  /**
+   * A single regression tree of the ensemble, in a flat node layout.  A left
+   * child index of 0 marks a leaf (the root is never a child).  The right
+   * child of node i is stored at leftChildren[i] + 1, and the leaf values
+   * already include the shrinkage.
+   */
+  struct RegressionTree
+  {
+    //! The dimension each node splits on (unused for leaves).
+    arma::Col<size_t> splitDimensions;
+    //! The split threshold of each node; points with values less than or
+    //! equal to the threshold go to the left child (unused for leaves).
+    arma::vec thresholds;
+    //! Index of the left child of each node, or 0 if the node is a leaf.
+    arma::Col<size_t> leftChildren;
+    //! The output value of each node (unused for internal nodes).
+    arma::vec values;
+
+    //! Compute the output value for a single point.
+    template<typename VecType>
+    double Predict(const VecType& point) const;
+
+    //! Serialize the tree.
+    template<typename Archive>
+    void serialize(Archive& ar, const unsigned int /* version */);
+  };
+
+  /**
+   * Grow a single regression tree on the binned dataset, fitting the given
+   * gradients and Hessians over the given row and dimension samples.  The
+   * frontier of each level is expanded in parallel.
+   */
+  void GrowTree(const arma::Mat<unsigned char>& bins,
+                const arma::vec& binMins,
+                const arma::vec& binWidths,
+                const arma::vec& gradients,
+                const arma::vec& hessians,
+                const arma::uvec& rows,
+                const arma::uvec& dims,
+                const size_t maximumDepth,
+                const size_t minimumLeafSize,
+                const double minimumGainSplit,
+                const size_t numBins,
+                RegressionTree& tree,
+                arma::Col<size_t>& splitBins) const;
+
+  //! The number of classes in the model.
+  size_t numClasses;
+  //! The learning rate (shrinkage) the model was trained with.
+  double learningRate;
+  //! The trees of the ensemble; tree r * numClasses + k is the tree of class
+  //! k in boosting round r.
+  std::vector<RegressionTree> trees;
+};
+
+} // namespace tree
+} // namespace mlpack
+
+// Include implementation.
+#include "gradient_boosting_impl.hpp"
+
+#endif
@@ -0,0 +1,455 @@
+/**
+ * @file methods/gradient_boosting/gradient_boosting_impl.hpp
+ *
+ * Implementation of gradient boosted decision trees.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_GRADIENT_BOOSTING_GRADIENT_BOOSTING_IMPL_HPP
+#define MLPACK_METHODS_GRADIENT_BOOSTING_GRADIENT_BOOSTING_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "gradient_boosting.hpp"
+
+namespace mlpack {
+namespace tree {
+
+inline GradientBoosting::GradientBoosting() :
+    numClasses(0),
+    learningRate(0.0)
+{
+  // Nothing to do here.
+}
+
+template<typename MatType>
+GradientBoosting::GradientBoosting(
+    const MatType& data,
+    const arma::Row<size_t>& labels,
+    const size_t numClasses,
+    const size_t numTrees,
+    const double learningRate,
+    const size_t maximumDepth,
+    const size_t minimumLeafSize,
+    const double minimumGainSplit,
+    const double rowSubsampling,
+    const double colSubsampling,
+    const size_t numBins) :
+    numClasses(0),
+    learningRate(0.0)
+{
+  Train(data, labels, numClasses, numTrees, learningRate, maximumDepth,
+      minimumLeafSize, minimumGainSplit, rowSubsampling, colSubsampling,
+      numBins);
+}
+
+template<typename MatType>
+double GradientBoosting::Train(
+    const MatType& data,
+    const arma::Row<size_t>& labels,
+    const size_t numClasses,
+    const size_t numTrees,
+    const double learningRate,
+    const size_t maximumDepth,
+    const size_t minimumLeafSize,
+    const double minimumGainSplit,
+    const double rowSubsampling,
+    const double colSubsampling,
+    const size_t numBins)
+{
+  if (numClasses < 2)
+  {
+    throw std::invalid_argument("GradientBoosting::Train(): at least two "
+        "classes are required!");
+  }
+  if (labels.n_elem != data.n_cols)
+  {
+    throw std::invalid_argument("GradientBoosting::Train(): number of points "
+        "and number of labels do not match!");
+  }
+
+  this->numClasses = numClasses;
+  this->learningRate = learningRate;
+  trees.clear();
+  trees.resize(numTrees * numClasses);
+
+  const size_t numPoints = data.n_cols;
+  const size_t numDims = data.n_rows;
+
+  // Bin the features into equal-width histograms once; the bin matrix is
+  // shared by every boosting round.
+  Timer::Start("bin_features");
+  arma::Mat<unsigned char> bins(numDims, numPoints);
+  arma::vec binMins(numDims);
+  arma::vec binWidths(numDims);
+  #pragma omp parallel for
+  for (omp_size_t d = 0; d < omp_size_t(numDims); ++d)
+  {
+    const double minVal = (double) data.row(d).min();
+    const double maxVal = (double) data.row(d).max();
+    double width = (maxVal - minVal) / (double) numBins;
+    if (width <= 0.0)
+      width = 1.0; // Constant dimension; every point lands in bin 0.
+    binMins[d] = minVal;
+    binWidths[d] = width;
+
+    for (size_t i = 0; i < numPoints; ++i)
+    {
+      bins(d, i) = (unsigned char) std::min(
+          (size_t) (((double) data(d, i) - minVal) / width), numBins - 1);
+    }
+  }
+  Timer::Stop("bin_features");
+
+  const size_t sampledRows = std::max((size_t) 2,
+      std::min(numPoints, (size_t) (rowSubsampling * numPoints)));
+  const size_t sampledDims = std::max((size_t) 1,
+      std::min(numDims, (size_t) (colSubsampling * numDims)));
+
+  // Raw scores of the additive model, one row per class.
+  arma::mat scores(numClasses, numPoints, arma::fill::zeros);
+  arma::mat probabilities(numClasses, numPoints);
+
+  Timer::Start("gradient_boosting_training");
+  for (size_t r = 0; r < numTrees; ++r)
+  {
+    // Softmax probabilities under the current model.
+    #pragma omp parallel for
+    for (omp_size_t i = 0; i < omp_size_t(numPoints); ++i)
+    {
+      probabilities.col(i) = arma::exp(scores.col(i) - scores.col(i).max());
+      probabilities.col(i) /= arma::accu(probabilities.col(i));
+    }
+
+    for (size_t k = 0; k < numClasses; ++k)
+    {
+      // Gradients and Hessians of the softmax objective for class k.
+      arma::vec gradients(numPoints);
+      arma::vec hessians(numPoints);
+      #pragma omp parallel for
+      for (omp_size_t i = 0; i < omp_size_t(numPoints); ++i)
+      {
+        const double p = probabilities(k, i);
+        gradients[i] = p - ((labels[i] == k) ? 1.0 : 0.0);
+        hessians[i] = std::max(p * (1.0 - p), 1e-16);
+      }
+
+      // Sample the rows and dimensions this tree may use.
+      arma::uvec rows;
+      if (sampledRows < numPoints)
+      {
+        rows = arma::shuffle(
+            arma::regspace<arma::uvec>(0, numPoints - 1)).head(sampledRows);
+      }
+      else
+      {
+        rows = arma::regspace<arma::uvec>(0, numPoints - 1);
+      }
+
+      arma::uvec dims;
+      if (sampledDims < numDims)
+      {
+        dims = arma::shuffle(
+            arma::regspace<arma::uvec>(0, numDims - 1)).head(sampledDims);
+      }
+      else
+      {
+        dims = arma::regspace<arma::uvec>(0, numDims - 1);
+      }
+
+      RegressionTree& tree = trees[r * numClasses + k];
+      arma::Col<size_t> splitBins;
+      GrowTree(bins, binMins, binWidths, gradients, hessians, rows, dims,
+          maximumDepth, minimumLeafSize, minimumGainSplit, numBins, tree,
+          splitBins);
+
+      // Update the scores of every point (not just the sampled rows).  The
+      // points are routed through the bin matrix, so the update matches the
+      // partition that was used during growth exactly.
+      #pragma omp parallel for
+      for (omp_size_t i = 0; i < omp_size_t(numPoints); ++i)
+      {
+        size_t node = 0;
+        while (tree.leftChildren[node] != 0)
+        {
+          node = tree.leftChildren[node] +
+              ((bins(tree.splitDimensions[node], i) <= splitBins[node]) ?
+               0 : 1);
+        }
+        scores(k, i) += tree.values[node];
+      }
+    }
+  }
+  Timer::Stop("gradient_boosting_training");
+
+  // Compute the training set log-loss of the final model.
+  double logLoss = 0.0;
+  #pragma omp parallel for reduction(+ : logLoss)
+  for (omp_size_t i = 0; i < omp_size_t(numPoints); ++i)
+  {
+    const double maxScore = scores.col(i).max();
+    const double logSumExp = maxScore +
+        std::log(arma::accu(arma::exp(scores.col(i) - maxScore)));
+    logLoss += logSumExp - scores(labels[i], i);
+  }
+
+  return logLoss / (double) numPoints;
+}
+
+template<typename MatType>
+void GradientBoosting::Classify(const MatType& data,
+                                arma::Row<size_t>& predictions) const
+{
+  arma::mat probabilities;
+  Classify(data, predictions, probabilities);
+}
+
+template<typename MatType>
+void GradientBoosting::Classify(const MatType& data,
+                                arma::Row<size_t>& predictions,
+                                arma::mat& probabilities) const
+{
+  // Check for a trained model.
+  if (trees.size() == 0)
+  {
+    throw std::invalid_argument("GradientBoosting::Classify(): no model "
+        "trained!");
+  }
+
+  predictions.set_size(data.n_cols);
+  probabilities.set_size(numClasses, data.n_cols);
+
+  #pragma omp parallel for
+  for (omp_size_t i = 0; i < omp_size_t(data.n_cols); ++i)
+  {
+    arma::vec pointScores(numClasses, arma::fill::zeros);
+    for (size_t t = 0; t < trees.size(); ++t)
+      pointScores[t % numClasses] += trees[t].Predict(data.col(i));
+
+    pointScores = arma::exp(pointScores - pointScores.max());
+    probabilities.col(i) = pointScores / arma::accu(pointScores);
+    predictions[i] = probabilities.col(i).index_max();
+  }
+}
+
+inline void GradientBoosting::GrowTree(
+    const arma::Mat<unsigned char>& bins,
+    const arma::vec& binMins,
+    const arma::vec& binWidths,
+    const arma::vec& gradients,
+    const arma::vec& hessians,
+    const arma::uvec& rows,
+    const arma::uvec& dims,
+    const size_t maximumDepth,
+    const size_t minimumLeafSize,
+    const double minimumGainSplit,
+    const size_t numBins,
+    RegressionTree& tree,
+    arma::Col<size_t>& splitBins) const
+{
+  // XGBoost-style L2 regularization of the Newton leaf values.
+  const double l2 = 1.0;
+
+  // The tree is built directly into flat node arrays, level by level, so the
+  // two children of a node are always adjacent.
+  std::vector<size_t> treeSplitDimensions(1, 0);
+  std::vector<double> treeThresholds(1, 0.0);
+  std::vector<size_t> treeLeftChildren(1, 0);
+  std::vector<double> treeValues(1, 0.0);
+  std::vector<size_t> treeSplitBins(1, 0);
+
+  // The frontier holds the node index and the sampled points routed to each
+  // node of the current level.
+  std::vector<std::pair<size_t, arma::uvec>> frontier;
+  frontier.emplace_back(0, rows);
+
+  for (size_t depth = 0; !frontier.empty(); ++depth)
+  {
+    // Find the best split of every frontier node in parallel.
+    std::vector<size_t> bestDims(frontier.size(), 0);
+    std::vector<size_t> bestBins(frontier.size(), 0);
+    std::vector<bool> doSplit(frontier.size(), false);
+    std::vector<double> leafValues(frontier.size(), 0.0);
+    std::vector<arma::uvec> leftPoints(frontier.size());
+    std::vector<arma::uvec> rightPoints(frontier.size());
+
+    #pragma omp parallel for schedule(dynamic)
+    for (omp_size_t f = 0; f < omp_size_t(frontier.size()); ++f)
+    {
+      const arma::uvec& points = frontier[f].second;
+
+      // The totals of the node give its Newton leaf value; the shrinkage is
+      // folded into the stored value.
+      double sumG = 0.0, sumH = 0.0;
+      for (size_t j = 0; j < points.n_elem; ++j)
+      {
+        sumG += gradients[points[j]];
+        sumH += hessians[points[j]];
+      }
+      leafValues[f] = -learningRate * sumG / (sumH + l2);
+
+      if (depth >= maximumDepth || points.n_elem < (minimumLeafSize * 2))
+        continue;
+
+      const double parentScore = sumG * sumG / (sumH + l2);
+      double bestGain = minimumGainSplit;
+      arma::vec binG(numBins);
+      arma::vec binH(numBins);
+      arma::Col<size_t> binCounts(numBins);
+      for (size_t j = 0; j < dims.n_elem; ++j)
+      {
+        const size_t d = dims[j];
+
+        // One pass over the node's points gives the per-bin sums; sweeping
+        // the bins then evaluates every candidate threshold.
+        binG.zeros();
+        binH.zeros();
+        binCounts.zeros();
+        for (size_t p = 0; p < points.n_elem; ++p)
+        {
+          const size_t b = bins(d, points[p]);
+          binG[b] += gradients[points[p]];
+          binH[b] += hessians[points[p]];
+          ++binCounts[b];
+        }
+
+        double leftG = 0.0, leftH = 0.0;
+        size_t leftCount = 0;
+        for (size_t b = 0; b < numBins - 1; ++b)
+        {
+          leftG += binG[b];
+          leftH += binH[b];
+          leftCount += binCounts[b];
+
+          if (leftCount < minimumLeafSize)
+            continue;
+          if (points.n_elem - leftCount < minimumLeafSize)
+            break;
+
+          const double rightG = sumG - leftG;
+          const double rightH = sumH - leftH;
+          const double gain = 0.5 * (leftG * leftG / (leftH + l2) +
+              rightG * rightG / (rightH + l2) - parentScore);
+          if (gain > bestGain)
+          {
+            bestGain = gain;
+            bestDims[f] = d;
+            bestBins[f] = b;
+            doSplit[f] = true;
+          }
+        }
+      }
+
+      if (doSplit[f])
+      {
+        // Partition the node's points on the chosen bin.
+        size_t leftCount = 0;
+        for (size_t p = 0; p < points.n_elem; ++p)
+          if (bins(bestDims[f], points[p]) <= bestBins[f])
+            ++leftCount;
+
+        leftPoints[f].set_size(leftCount);
+        rightPoints[f].set_size(points.n_elem - leftCount);
+        size_t l = 0, r = 0;
+        for (size_t p = 0; p < points.n_elem; ++p)
+        {
+          if (bins(bestDims[f], points[p]) <= bestBins[f])
+            leftPoints[f][l++] = points[p];
+          else
+            rightPoints[f][r++] = points[p];
+        }
+      }
+    }
+
+    // Sequentially append the children of the split nodes and assemble the
+    // next frontier.
+    std::vector<std::pair<size_t, arma::uvec>> next;
+    for (size_t f = 0; f < frontier.size(); ++f)
+    {
+      const size_t node = frontier[f].first;
+      if (!doSplit[f])
+      {
+        treeValues[node] = leafValues[f];
+        continue;
+      }
+
+      const size_t leftIndex = treeSplitDimensions.size();
+      for (size_t c = 0; c < 2; ++c)
+      {
+        treeSplitDimensions.push_back(0);
+        treeThresholds.push_back(0.0);
+        treeLeftChildren.push_back(0);
+        treeValues.push_back(0.0);
+        treeSplitBins.push_back(0);
+      }
+
+      treeSplitDimensions[node] = bestDims[f];
+      treeSplitBins[node] = bestBins[f];
+      treeThresholds[node] = binMins[bestDims[f]] +
+          (double) (bestBins[f] + 1) * binWidths[bestDims[f]];
+      treeLeftChildren[node] = leftIndex;
+
+      next.emplace_back(leftIndex, std::move(leftPoints[f]));
+      next.emplace_back(leftIndex + 1, std::move(rightPoints[f]));
+    }
+
+    frontier = std::move(next);
+  }
+
+  tree.splitDimensions = arma::Col<size_t>(treeSplitDimensions);
+  tree.thresholds = arma::vec(treeThresholds);
+  tree.leftChildren = arma::Col<size_t>(treeLeftChildren);
+  tree.values = arma::vec(treeValues);
+  splitBins = arma::Col<size_t>(treeSplitBins);
+}
+
+template<typename VecType>
+double GradientBoosting::RegressionTree::Predict(const VecType& point) const
+{
+  size_t node = 0;
+  while (leftChildren[node] != 0)
+  {
+    node = leftChildren[node] +
+        ((point[splitDimensions[node]] <= thresholds[node]) ? 0 : 1);
+  }
+  return values[node];
+}
+
+template<typename Archive>
+void GradientBoosting::RegressionTree::serialize(
+    Archive& ar, const unsigned int /* version */)
+{
+  ar & BOOST_SERIALIZATION_NVP(splitDimensions);
+  ar & BOOST_SERIALIZATION_NVP(thresholds);
+  ar & BOOST_SERIALIZATION_NVP(leftChildren);
+  ar & BOOST_SERIALIZATION_NVP(values);
+}
+
+template<typename Archive>
+void GradientBoosting::serialize(Archive& ar,
+                                 const unsigned int /* version */)
+{
+  ar & BOOST_SERIALIZATION_NVP(numClasses);
+  ar & BOOST_SERIALIZATION_NVP(learningRate);
+
+  size_t numModelTrees;
+  if (Archive::is_loading::value)
+    trees.clear();
+  else
+    numModelTrees = trees.size();
+
+  ar & BOOST_SERIALIZATION_NVP(numModelTrees);
+
+  // Allocate space if needed.
+  if (Archive::is_loading::value)
+    trees.resize(numModelTrees);
+
+  ar & BOOST_SERIALIZATION_NVP(trees);
+}
+
+} // namespace tree
+} // namespace mlpack
+
+#endif
@@ -274,13 +274,24 @@ class HMM
    * sequence, using the Viterbi algorithm, returning the log-likelihood of the
    * most likely state sequence.
    *
+   * If beamWidth is nonzero and smaller than the number of states, a beam
+   * search is used instead of the full Viterbi lattice: at each timestep only
+   * the beamWidth highest-scoring states are expanded, so each step costs
+   * O(beamWidth * states) instead of O(states^2).  The returned sequence is
+   * then not guaranteed to be the globally most probable one, but for large
+   * state spaces a modest beam loses very little probability in exchange for
+   * a large speedup.
+   *
    * @param dataSeq Sequence of observations.
    * @param stateSeq Vector in which the most probable state sequence will be
    *    stored.
+   * @param beamWidth Number of states to expand per timestep; 0 (the default)
+   *    computes the exact Viterbi solution.
    * @return Log-likelihood of most probable state sequence.
    */
   double Predict(const arma::mat& dataSeq,
-                 arma::Row<size_t>& stateSeq) const;
+                 arma::Row<size_t>& stateSeq,
+                 const size_t beamWidth = 0) const;
 
   /**
    * Compute the log-likelihood of the given data sequence.
@@ -101,10 +101,15 @@ double HMM<Distribution>::Train(const std::vector<arma::mat>& dataSeq)
   // Maximum iterations?
   size_t iterations = 1000;
 
-  // Find length of all sequences and ensure they are the correct size.
+  // Find length of all sequences and ensure they are the correct size.  Also
+  // compute where each sequence's observations land in the emission list, so
+  // that the per-sequence E-steps can run in parallel and write to disjoint
+  // column ranges.
+  std::vector<size_t> seqOffsets(dataSeq.size());
   size_t totalLength = 0;
   for (size_t seq = 0; seq < dataSeq.size(); seq++)
   {
+    seqOffsets[seq] = totalLength;
     totalLength += dataSeq[seq].n_cols;
 
     if (dataSeq[seq].n_rows != dimensionality)
@@ -130,27 +135,68 @@ double HMM<Distribution>::Train(const std::vector<arma::mat>& dataSeq)
     arma::mat newLogTransition(logTransition.n_rows, logTransition.n_cols);
     newLogTransition.fill(-std::numeric_limits<double>::infinity());
 
-    // Reset log likelihood.
-    loglik = 0;
-
-    // Sum over time.
-    size_t sumTime = 0;
+    // The per-sequence E-steps are independent, so the sequences are sharded
+    // across threads, with per-thread accumulators for the initial and
+    // transition statistics.  Make sure the log-space representation is up to
+    // date before the threads start reading it.
+    ConvertToLogSpace();
+
+    #ifdef HAS_OPENMP
+    const size_t numThreads = (size_t) omp_get_max_threads();
+    #else
+    const size_t numThreads = 1;
+    #endif
+
+    arma::vec seqLogLik(dataSeq.size());
+    std::vector<arma::vec> threadLogInitial(numThreads,
+        arma::vec(logTransition.n_rows));
+    std::vector<arma::mat> threadLogTransition(numThreads,
+        arma::mat(logTransition.n_rows, logTransition.n_cols));
+    for (size_t thread = 0; thread < numThreads; ++thread)
+    {
+      threadLogInitial[thread].fill(-std::numeric_limits<double>::infinity());
+      threadLogTransition[thread].fill(
+          -std::numeric_limits<double>::infinity());
+    }
 
-    // Loop over each sequence.
-    for (size_t seq = 0; seq < dataSeq.size(); seq++)
+    // Loop over each sequence.  The static schedule fixes the assignment of
+    // sequences to threads, so that together with the ordered merge below the
+    // result does not depend on thread timing.
+    #pragma omp parallel for schedule(static)
+    for (omp_size_t seq = 0; seq < (omp_size_t) dataSeq.size(); seq++)
     {
+      #ifdef HAS_OPENMP
+      const size_t threadId = (size_t) omp_get_thread_num();
+      #else
+      const size_t threadId = 0;
+      #endif
+      arma::vec& localLogInitial = threadLogInitial[threadId];
+      arma::mat& localLogTransition = threadLogTransition[threadId];
+
       arma::mat stateLogProb;
       arma::mat forwardLog;
       arma::mat backwardLog;
       arma::vec logScales;
 
-      // Add the log-likelihood of this sequence.  This is the E-step.
-      loglik += LogEstimate(dataSeq[seq], stateLogProb, forwardLog,
+      // Compute the log-likelihood of this sequence.  This is the E-step.
+      seqLogLik(seq) = LogEstimate(dataSeq[seq], stateLogProb, forwardLog,
           backwardLog, logScales);
 
+      // Batch-evaluate each state's emission distribution over the sequence;
+      // the transition update below would otherwise re-evaluate every one of
+      // them once per originating state.
+      arma::mat emissionLogProb(logTransition.n_rows, dataSeq[seq].n_cols);
+      arma::vec emissionLogProbCol;
+      for (size_t state = 0; state < logTransition.n_rows; state++)
+      {
+        emission[state].LogProbability(dataSeq[seq], emissionLogProbCol);
+        emissionLogProb.row(state) = emissionLogProbCol.t();
+      }
+
       // Add to estimate of initial probability for state j.
       for (size_t j = 0; j < logTransition.n_cols; ++j)
-        newLogInitial[j] = math::LogAdd(newLogInitial[j], stateLogProb(j, 0));
+        localLogInitial[j] = math::LogAdd(localLogInitial[j],
+            stateLogProb(j, 0));
 
       // Now re-estimate the parameters.  This is the M-step.
       //   pi_i = sum_d ((1 / P(seq[d])) sum_t (f(i, 0) b(i, 0))
@@ -158,31 +204,48 @@ double HMM<Distribution>::Train(const std::vector<arma::mat>& dataSeq)
       //           t + 1)))
       //   E_ij = sum_d ((1 / P(seq[d])) sum_{t | seq[d][t] = j} f(i, t) b(i, t)
       // We store the new estimates in a different matrix.
+      size_t sumTime = seqOffsets[seq];
       for (size_t t = 0; t < dataSeq[seq].n_cols; ++t)
       {
-        for (size_t j = 0; j < logTransition.n_cols; ++j)
+        if (t < dataSeq[seq].n_cols - 1)
         {
-          if (t < dataSeq[seq].n_cols - 1)
+          // Estimate of T_ij (probability of transition from state j to state
+          // i).  We postpone multiplication of the old T_ij until later.
+          for (size_t j = 0; j < logTransition.n_cols; ++j)
           {
-            // Estimate of T_ij (probability of transition from state j to state
-            // i).  We postpone multiplication of the old T_ij until later.
             for (size_t i = 0; i < logTransition.n_rows; i++)
             {
-              newLogTransition(i, j) = math::LogAdd(newLogTransition(i, j),
+              localLogTransition(i, j) = math::LogAdd(localLogTransition(i, j),
                   forwardLog(j, t) + backwardLog(i, t + 1) +
-                  emission[i].LogProbability(dataSeq[seq].unsafe_col(t + 1)) -
-                  logScales[t + 1]);
+                  emissionLogProb(i, t + 1) - logScales[t + 1]);
             }
           }
+        }
 
-          // Add to list of emission observations, for Distribution::Train().
-          emissionList.col(sumTime) = dataSeq[seq].col(t);
+        // Add to list of emission observations, for Distribution::Train().
+        // Every sequence owns a disjoint column range of the emission list.
+        emissionList.col(sumTime) = dataSeq[seq].col(t);
+        for (size_t j = 0; j < logTransition.n_cols; ++j)
           emissionProb[j][sumTime] = exp(stateLogProb(j, t));
-        }
         sumTime++;
       }
     }
 
+    // Ordered reductions: sum the sequence log-likelihoods and merge the
+    // per-thread statistics in thread order.
+    loglik = arma::accu(seqLogLik);
+    for (size_t thread = 0; thread < numThreads; ++thread)
+    {
+      for (size_t j = 0; j < logTransition.n_cols; ++j)
+      {
+        newLogInitial[j] = math::LogAdd(newLogInitial[j],
+            threadLogInitial[thread][j]);
+        for (size_t i = 0; i < logTransition.n_rows; i++)
+          newLogTransition(i, j) = math::LogAdd(newLogTransition(i, j),
+              threadLogTransition[thread](i, j));
+      }
+    }
+
     if (std::abs(oldLoglik - loglik) < tolerance)
     {
       Log::Debug << "Converged after " << iter << " iterations." << std::endl;
@@ -456,7 +519,8 @@ void HMM<Distribution>::Generate(const size_t length,
  */
 template<typename Distribution>
 double HMM<Distribution>::Predict(const arma::mat& dataSeq,
-                                  arma::Row<size_t>& stateSeq) const
+                                  arma::Row<size_t>& stateSeq,
+                                  const size_t beamWidth) const
 {
   // This is an implementation of the Viterbi algorithm for finding the most
   // probable sequence of states to produce the observed data sequence.  We
@@ -468,6 +532,24 @@ double HMM<Distribution>::Predict(const arma::mat& dataSeq,
 
   ConvertToLogSpace();
 
+  // A beam width of 0 (or one covering every state) means exact decoding.
+  const bool useBeam = (beamWidth > 0) && (beamWidth < logTransition.n_rows);
+
+  // Select the beamWidth highest-scoring states of the given timestep.  This
+  // is a partial selection (std::nth_element), so it costs O(states) instead
+  // of a full sort.
+  std::vector<size_t> beam;
+  auto selectBeam = [&](const size_t t)
+  {
+    beam.resize(logTransition.n_rows);
+    for (size_t i = 0; i < beam.size(); ++i)
+      beam[i] = i;
+    std::nth_element(beam.begin(), beam.begin() + (beamWidth - 1), beam.end(),
+        [&](const size_t a, const size_t b)
+        { return logStateProb(a, t) > logStateProb(b, t); });
+    beam.resize(beamWidth);
+  };
+
   // The calculation of the first state is slightly different; the probability
   // of the first state being state j is the maximum probability that the state
   // came to be j from another state.
@@ -479,6 +561,9 @@ double HMM<Distribution>::Predict(const arma::mat& dataSeq,
     stateSeqBack(state, 0) = state;
   }
 
+  if (useBeam)
+    selectBeam(0);
+
   // Store the best first state.
   arma::uword index;
   for (size_t t = 1; t < dataSeq.n_cols; t++)
@@ -488,11 +573,39 @@ double HMM<Distribution>::Predict(const arma::mat& dataSeq,
     // of being the previous state.
     for (size_t j = 0; j < logTransition.n_rows; j++)
     {
-      arma::vec prob = logStateProb.col(t - 1) + logTransition.row(j).t();
-      logStateProb(j, t) = prob.max(index) +
-          emission[j].LogProbability(dataSeq.unsafe_col(t));
-      stateSeqBack(j, t) = index;
+      if (useBeam)
+      {
+        // Only transitions out of the surviving states are considered.
+        double best = -std::numeric_limits<double>::infinity();
+        size_t bestPrev = 0;
+        for (const size_t prev : beam)
+        {
+          const double cand = logStateProb(prev, t - 1) +
+              logTransition(j, prev);
+          if (cand > best)
+          {
+            best = cand;
+            bestPrev = prev;
+          }
+        }
+
+        // Don't bother evaluating the emission if the state is unreachable
+        // from the beam.
+        logStateProb(j, t) = std::isfinite(best) ?
+            best + emission[j].LogProbability(dataSeq.unsafe_col(t)) : best;
+        stateSeqBack(j, t) = bestPrev;
+      }
+      else
+      {
+        arma::vec prob = logStateProb.col(t - 1) + logTransition.row(j).t();
+        logStateProb(j, t) = prob.max(index) +
+            emission[j].LogProbability(dataSeq.unsafe_col(t));
+        stateSeqBack(j, t) = index;
+      }
     }
+
+    if (useBeam)
+      selectBeam(t);
   }
 
   // Backtrack to find the most probable state sequence.
@@ -587,16 +700,22 @@ void HMM<Distribution>::Forward(const arma::mat& dataSeq,
 
   ConvertToLogSpace();
 
+  // Evaluate each state's emission distribution over the whole sequence with
+  // a single batched call; distribution evaluation is the inner loop here.
+  arma::mat emissionLogProb(logTransition.n_rows, dataSeq.n_cols);
+  arma::vec emissionLogProbCol;
+  for (size_t state = 0; state < logTransition.n_rows; state++)
+  {
+    emission[state].LogProbability(dataSeq, emissionLogProbCol);
+    emissionLogProb.row(state) = emissionLogProbCol.t();
+  }
+
   // The first entry in the forward algorithm uses the initial state
   // probabilities.  Note that MATLAB assumes that the starting state (at
   // t = -1) is state 0; this is not our assumption here.  To force that
   // behavior, you could append a single starting state to every single data
   // sequence and that should produce results in line with MATLAB.
-  for (size_t state = 0; state < logTransition.n_rows; state++)
-  {
-    forwardLogProb(state, 0) = logInitial(state) +
-        emission[state].LogProbability(dataSeq.unsafe_col(0));
-  }
+  forwardLogProb.col(0) = logInitial + emissionLogProb.col(0);
 
   // Then normalize the column.
   logScales[0] = math::AccuLog(forwardLogProb.col(0));
@@ -604,17 +723,18 @@ void HMM<Distribution>::Forward(const arma::mat& dataSeq,
     forwardLogProb.col(0) -= logScales[0];
 
   // Now compute the probabilities for each successive observation.
+  arma::vec alpha(logTransition.n_rows);
   for (size_t t = 1; t < dataSeq.n_cols; t++)
   {
-    for (size_t j = 0; j < logTransition.n_rows; j++)
-    {
-      // The forward probability of state j at time t is the sum over all states
-      // of the probability of the previous state transitioning to the current
-      // state and emitting the given observation.
-      arma::vec tmp = forwardLogProb.col(t - 1) + logTransition.row(j).t();
-      forwardLogProb(j, t) = math::AccuLog(tmp) +
-          emission[j].LogProbability(dataSeq.unsafe_col(t));
-    }
+    // The forward probability of state j at time t is the sum over all states
+    // of the probability of the previous state transitioning to the current
+    // state and emitting the given observation.  In log space this is a
+    // matrix-vector product against the transition matrix, reduced row-wise
+    // with a vectorized LogAdd.
+    arma::mat shifted = logTransition;
+    shifted.each_row() += forwardLogProb.col(t - 1).t();
+    math::LogSumExpT(shifted, alpha);
+    forwardLogProb.col(t) = alpha + emissionLogProb.col(t);
 
     // Normalize probability.
     logScales[t] = math::AccuLog(forwardLogProb.col(t));
@@ -636,26 +756,34 @@ void HMM<Distribution>::Backward(const arma::mat& dataSeq,
   // The last element probability is 1.
   backwardLogProb.col(dataSeq.n_cols - 1).fill(0);
 
+  // Evaluate each state's emission distribution over the whole sequence with
+  // a single batched call; distribution evaluation is the inner loop here.
+  arma::mat emissionLogProb(logTransition.n_rows, dataSeq.n_cols);
+  arma::vec emissionLogProbCol;
+  for (size_t state = 0; state < logTransition.n_rows; state++)
+  {
+    emission[state].LogProbability(dataSeq, emissionLogProbCol);
+    emissionLogProb.row(state) = emissionLogProbCol.t();
+  }
+
   // Now step backwards through all other observations.
+  arma::vec beta(logTransition.n_rows);
   for (size_t t = dataSeq.n_cols - 2; t + 1 > 0; t--)
   {
-    for (size_t j = 0; j < logTransition.n_rows; j++)
-    {
-      // The backward probability of state j at time t is the sum over all state
-      // of the probability of the next state having been a transition from the
-      // current state multiplied by the probability of each of those states
-      // emitting the given observation.
-      for (size_t state = 0; state < logTransition.n_rows; state++)
-      {
-        backwardLogProb(j, t) = math::LogAdd(backwardLogProb(j, t),
-            logTransition(state, j) + backwardLogProb(state, t + 1)
-            + emission[state].LogProbability(dataSeq.unsafe_col(t + 1)));
-      }
-
-      // Normalize by the weights from the forward algorithm.
-      if (std::isfinite(logScales[t + 1]))
-        backwardLogProb(j, t) -= logScales[t + 1];
-    }
+    // The backward probability of state j at time t is the sum over all states
+    // of the probability of the next state having been a transition from the
+    // current state multiplied by the probability of each of those states
+    // emitting the given observation.  In log space this is a matrix-vector
+    // product against the transposed transition matrix, reduced column-wise
+    // with a vectorized LogAdd.
+    arma::mat shifted = logTransition;
+    shifted.each_col() += backwardLogProb.col(t + 1) + emissionLogProb.col(t + 1);
+    math::LogSumExp(shifted, beta);
+    backwardLogProb.col(t) = beta;
+
+    // Normalize by the weights from the forward algorithm.
+    if (std::isfinite(logScales[t + 1]))
+      backwardLogProb.col(t) -= logScales[t + 1];
   }
 }
 
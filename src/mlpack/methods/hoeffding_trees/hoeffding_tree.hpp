@@ -240,6 +240,13 @@ class HoeffdingTree
   //! Modify the number of samples before a split check is performed.
   void CheckInterval(const size_t checkInterval);
 
+  //! Get the sliding window size used for drift detection (0 means drift
+  //! detection is disabled).
+  size_t DriftWindowSize() const { return driftWindowSize; }
+  //! Modify the sliding window size used for drift detection (0 disables
+  //! drift detection).  The new size is propagated to all children.
+  void DriftWindowSize(const size_t driftWindowSize);
+
   /**
    * Given a point and that this node is not a leaf, calculate the index of the
    * child node this point would go towards.  This method is primarily used by
@@ -309,6 +316,16 @@ class HoeffdingTree
    */
   void CreateChildren();
 
+  /**
+   * Retire the subtree below this node: delete all children and revert this
+   * node to an untrained leaf with fresh split statistics.  The storage of the
+   * first retired child's split statistics is reused where possible, so that
+   * repeated retirement under drift does not grow allocator pressure.  This is
+   * called internally when drift is detected, but it can be used in a
+   * standalone sense too.
+   */
+  void ResetSubtree();
+
   //! Serialize the split.
   template<typename Archive>
   void serialize(Archive& ar, const unsigned int /* version */);
@@ -343,6 +360,21 @@ class HoeffdingTree
   //! The required probability of success for a split to be performed.
   double successProbability;
 
+  // Members for the sliding-window drift detection mode (used at nodes that
+  // have split; leaves do not monitor drift).
+
+  //! The size of the sliding windows used for drift detection (0 disables
+  //! drift detection).
+  size_t driftWindowSize;
+  //! The number of samples seen in the current drift detection window.
+  size_t windowSamples;
+  //! The number of misclassified samples in the current drift window.
+  size_t windowErrors;
+  //! The error rate of the previously completed drift window.
+  double previousErrorRate;
+  //! Whether or not a drift window has been completed yet.
+  bool hasCompleteWindow;
+
   // And we need to keep some information for after we have split.
 
   //! The dimension that this node has split on.
@@ -50,6 +50,11 @@ HoeffdingTree<
     datasetInfo(new data::DatasetInfo(datasetInfo)),
     ownsInfo(true),
     successProbability(successProbability),
+    driftWindowSize(0),
+    windowSamples(0),
+    windowErrors(0),
+    previousErrorRate(0.0),
+    hasCompleteWindow(false),
     splitDimension(size_t(-1)),
     majorityClass(0),
     majorityProbability(0.0),
@@ -110,6 +115,11 @@ HoeffdingTree<
         &datasetInfo),
     ownsInfo(copyDatasetInfo),
     successProbability(successProbability),
+    driftWindowSize(0),
+    windowSamples(0),
+    windowErrors(0),
+    previousErrorRate(0.0),
+    hasCompleteWindow(false),
     splitDimension(size_t(-1)),
     majorityClass(0),
     majorityProbability(0.0),
@@ -174,6 +184,11 @@ HoeffdingTree<
     datasetInfo(new data::DatasetInfo()),
     ownsInfo(true),
     successProbability(0.95),
+    driftWindowSize(0),
+    windowSamples(0),
+    windowErrors(0),
+    previousErrorRate(0.0),
+    hasCompleteWindow(false),
     splitDimension(size_t(-1)),
     majorityClass(0),
     majorityProbability(0.0),
@@ -202,6 +217,11 @@ HoeffdingTree<FitnessFunction, NumericSplitType, CategoricalSplitType>::
     datasetInfo(new data::DatasetInfo(*other.datasetInfo)),
     ownsInfo(true),
     successProbability(other.successProbability),
+    driftWindowSize(other.driftWindowSize),
+    windowSamples(other.windowSamples),
+    windowErrors(other.windowErrors),
+    previousErrorRate(other.previousErrorRate),
+    hasCompleteWindow(other.hasCompleteWindow),
     splitDimension(other.splitDimension),
     majorityClass(other.majorityClass),
     majorityProbability(other.majorityProbability),
@@ -258,8 +278,56 @@ void HoeffdingTree<
     // Don't split if there are fewer than five points.
     size_t oldMaxSamples = maxSamples;
     maxSamples = std::max(size_t(data.n_cols - 1), size_t(5));
-    for (size_t i = 0; i < data.n_cols; ++i)
-      Train(data.col(i), labels[i]);
+
+    if (splitDimension == size_t(-1))
+    {
+      // This node is a leaf, so we can accumulate the sufficient statistics
+      // of the whole chunk in a single pass.  Each dimension only touches its
+      // own split object, so the pass is parallelized over dimensions.
+      const size_t dimensionality = data.n_rows;
+
+      #pragma omp parallel for
+      for (omp_size_t d = 0; d < dimensionality; ++d)
+      {
+        if (datasetInfo->Type(d) == data::Datatype::categorical)
+        {
+          CategoricalSplitType<FitnessFunction>& split =
+              categoricalSplits[dimensionMappings->at(d).second];
+          for (size_t i = 0; i < data.n_cols; ++i)
+            split.Train(data(d, i), labels[i]);
+        }
+        else if (datasetInfo->Type(d) == data::Datatype::numeric)
+        {
+          NumericSplitType<FitnessFunction>& split =
+              numericSplits[dimensionMappings->at(d).second];
+          for (size_t i = 0; i < data.n_cols; ++i)
+            split.Train(data(d, i), labels[i]);
+        }
+      }
+      numSamples += data.n_cols;
+
+      // Grab majority class from splits.
+      if (categoricalSplits.size() > 0)
+      {
+        majorityClass = categoricalSplits[0].MajorityClass();
+        majorityProbability = categoricalSplits[0].MajorityProbability();
+      }
+      else
+      {
+        majorityClass = numericSplits[0].MajorityClass();
+        majorityProbability = numericSplits[0].MajorityProbability();
+      }
+
+      // All points have been seen, so check for a split once.
+      if (SplitCheck() > 0)
+        CreateChildren();
+    }
+    else
+    {
+      // The node has already split, so pass the points through one at a time.
+      for (size_t i = 0; i < data.n_cols; ++i)
+        Train(data.col(i), labels[i]);
+    }
     maxSamples = oldMaxSamples;
 
     // Now, if we did split, find out which points go to which child, and
@@ -284,8 +352,10 @@ void HoeffdingTree<
       }
 
       // Now pass each of these submatrices to the children to perform
-      // batch-mode training.
-      for (size_t i = 0; i < children.size(); ++i)
+      // batch-mode training.  The children are disjoint, so they can be
+      // trained in parallel.
+      #pragma omp parallel for schedule(dynamic)
+      for (omp_size_t i = 0; i < children.size(); ++i)
       {
         // If we don't have any points that go to the child in question, don't
         // train that child.
@@ -423,6 +493,41 @@ void HoeffdingTree<
   }
   else
   {
+    if (driftWindowSize > 0)
+    {
+      // Monitor the prequential error of the subtree (test, then train) over
+      // adjacent sliding windows of driftWindowSize samples.
+      if (Classify(point) != label)
+        ++windowErrors;
+
+      if (++windowSamples == driftWindowSize)
+      {
+        const double errorRate = (double) windowErrors / (double) windowSamples;
+
+        // Use a Hoeffding bound to decide whether the error rate of this
+        // window is significantly worse than that of the previous window,
+        // with the same success probability as the split checks.
+        const double epsilon = std::sqrt(
+            std::log(1.0 / (1.0 - successProbability)) /
+            (2.0 * driftWindowSize));
+
+        if (hasCompleteWindow && (errorRate - previousErrorRate > epsilon))
+        {
+          // The concept has drifted; retire the stale subtree and train this
+          // node as a fresh leaf from here on.
+          ResetSubtree();
+          Train(point, label);
+          return;
+        }
+
+        // Slide the window.
+        previousErrorRate = errorRate;
+        hasCompleteWindow = true;
+        windowSamples = 0;
+        windowErrors = 0;
+      }
+    }
+
     // Already split.  Pass the training point to the relevant child.
     size_t direction = CalculateDirection(point);
     children[direction]->Train(point, label);
@@ -582,6 +687,25 @@ void HoeffdingTree<
     children[i]->CheckInterval(checkInterval);
 }
 
+template<
+    typename FitnessFunction,
+    template<typename> class NumericSplitType,
+    template<typename> class CategoricalSplitType
+>
+void HoeffdingTree<
+    FitnessFunction,
+    NumericSplitType,
+    CategoricalSplitType
+>::DriftWindowSize(const size_t driftWindowSize)
+{
+  this->driftWindowSize = driftWindowSize;
+  this->windowSamples = 0;
+  this->windowErrors = 0;
+  this->hasCompleteWindow = false;
+  for (size_t i = 0; i < children.size(); ++i)
+    children[i]->DriftWindowSize(driftWindowSize);
+}
+
 template<
     typename FitnessFunction,
     template<typename> class NumericSplitType,
@@ -776,6 +900,7 @@ void HoeffdingTree<
     }
 
     children[i]->MajorityClass() = childMajorities[i];
+    children[i]->driftWindowSize = driftWindowSize;
   }
 
   // Eliminate now-unnecessary split information.
@@ -783,6 +908,53 @@ void HoeffdingTree<
   categoricalSplits.clear();
 }
 
+template<
+    typename FitnessFunction,
+    template<typename> class NumericSplitType,
+    template<typename> class CategoricalSplitType
+>
+void HoeffdingTree<
+    FitnessFunction,
+    NumericSplitType,
+    CategoricalSplitType
+>::ResetSubtree()
+{
+  // Salvage the split statistic storage of the first retired child (if it is
+  // still a leaf) before deleting the subtree, so repeated retirement reuses
+  // the allocated vectors instead of going back to the allocator every time.
+  if (children.size() > 0)
+  {
+    numericSplits = std::move(children[0]->numericSplits);
+    categoricalSplits = std::move(children[0]->categoricalSplits);
+  }
+
+  for (size_t i = 0; i < children.size(); ++i)
+    delete children[i];
+  children.clear();
+
+  // Reinitialize the split statistics in place, in the same order that the
+  // constructor creates them (so the shared dimension mappings stay valid).
+  numericSplits.clear();
+  categoricalSplits.clear();
+  for (size_t i = 0; i < datasetInfo->Dimensionality(); ++i)
+  {
+    if (datasetInfo->Type(i) == data::Datatype::categorical)
+      categoricalSplits.push_back(CategoricalSplitType<FitnessFunction>(
+          datasetInfo->NumMappings(i), numClasses));
+    else
+      numericSplits.push_back(NumericSplitType<FitnessFunction>(numClasses));
+  }
+
+  // Revert to an untrained leaf.  The majority class information is kept, so
+  // that Classify() remains usable while the leaf retrains.
+  splitDimension = size_t(-1);
+  numSamples = 0;
+  windowSamples = 0;
+  windowErrors = 0;
+  previousErrorRate = 0.0;
+  hasCompleteWindow = false;
+}
+
 template<
     typename FitnessFunction,
     template<typename> class NumericSplitType,
@@ -796,6 +968,16 @@ void HoeffdingTree<
 >::serialize(Archive& ar, const unsigned int /* version */)
 {
   ar & BOOST_SERIALIZATION_NVP(splitDimension);
+  ar & BOOST_SERIALIZATION_NVP(driftWindowSize);
+
+  // The drift window contents are transient; start a fresh window on load.
+  if (Archive::is_loading::value)
+  {
+    windowSamples = 0;
+    windowErrors = 0;
+    previousErrorRate = 0.0;
+    hasCompleteWindow = false;
+  }
 
   // Clear memory for the mappings if necessary.
   if (Archive::is_loading::value && ownsMappings && dimensionMappings)
@@ -899,6 +1081,9 @@ void HoeffdingTree<
       numClasses = 0;
       maxSamples = 0;
       successProbability = 0.0;
+      // Split nodes drop their training configuration on load, so drift
+      // monitoring is disabled for them too.
+      driftWindowSize = 0;
     }
   }
 }
@@ -220,6 +220,33 @@ class KDE
    */
   void Evaluate(arma::vec& estimations);
 
+  /**
+   * Estimate the density of each query point for several candidate bandwidths
+   * with a single traversal of the reference tree.  The traversal computes
+   * each query-to-node distance range and each base-case distance only once;
+   * those distances are the sufficient statistics shared by every bandwidth,
+   * and each candidate kernel is evaluated from them.  A reference node is
+   * only approximated when the pruning bound holds for every candidate
+   * bandwidth, so each row of the result satisfies the same error tolerances
+   * as a separate Evaluate() call with that bandwidth.  This turns the B
+   * traversals of a bandwidth sweep into one.
+   *
+   * - KernelType must be constructible from a bandwidth value and evaluable
+   *   from a distance (e.g. GaussianKernel or EpanechnikovKernel).
+   *
+   * - Tree types with self-children (e.g. cover trees) are not supported by
+   *   this method.
+   *
+   * @pre The model has to be previously trained.
+   * @param querySet Set of query points to get the density of.
+   * @param bandwidths Candidate bandwidth values.
+   * @param estimations Matrix which will hold the density of each query point
+   *     (one row per bandwidth, one column per query point).
+   */
+  void EvaluateMultipleBandwidths(const MatType& querySet,
+                                  const arma::vec& bandwidths,
+                                  arma::mat& estimations);
+
   //! Get the kernel.
   const KernelType& Kernel() const { return kernel; }
 
@@ -259,6 +286,23 @@ class KDE
   //! Modify the mode of KDE.
   KDEMode& Mode() { return mode; }
 
+  //! Get whether the query tree is cached between evaluations.
+  bool CacheQueryTree() const { return cacheQueryTree; }
+
+  //! Modify whether the query tree is cached between evaluations. When
+  //! enabled, the query tree built by a dual-tree Evaluate() call is kept and
+  //! reused by later calls whose query set has the same size, so bandwidth
+  //! sweeps over a fixed query grid only pay the tree-build cost once. The
+  //! tree only depends on the geometry of the query set, so it stays valid
+  //! when the kernel bandwidth changes; bandwidth-dependent per-node
+  //! accumulators are reset before each evaluation. It is the caller's
+  //! responsibility to pass the same query set on every call while caching is
+  //! enabled (or to call ClearQueryTreeCache() in between).
+  bool& CacheQueryTree() { return cacheQueryTree; }
+
+  //! Delete any cached query tree.
+  void ClearQueryTreeCache();
+
   //! Get whether Monte Carlo estimations are being used or not.
   bool MonteCarlo() const { return monteCarlo; }
 
@@ -307,6 +351,15 @@ class KDE
   //! Permutations of reference points.
   std::vector<size_t>* oldFromNewReferences;
 
+  //! Cached query tree (only used when cacheQueryTree is true).
+  Tree* cachedQueryTree;
+
+  //! Permutations of cached query points.
+  std::vector<size_t>* oldFromNewCachedQueries;
+
+  //! Whether to cache the query tree between evaluations.
+  bool cacheQueryTree;
+
   //! Relative error tolerance.
   double relError;
 
@@ -341,6 +394,14 @@ class KDE
   //! is the limit before Monte Carlo estimation recurses.
   double mcBreakCoef;
 
+  //! Recurse over the reference tree for a single query point, evaluating
+  //! every candidate kernel from each distance computed along the way.
+  void MultiBandwidthRecursion(const arma::vec& queryPoint,
+                               const size_t queryIndex,
+                               Tree& referenceNode,
+                               std::vector<KernelType>& kernels,
+                               arma::mat& estimations);
+
   //! Check whether absolute and relative error values are compatible.
   static void CheckErrorValues(const double relError, const double absError);
 
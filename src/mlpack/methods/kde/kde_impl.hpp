@@ -66,6 +66,9 @@ KDE(const double relError,
     metric(metric),
     referenceTree(nullptr),
     oldFromNewReferences(nullptr),
+    cachedQueryTree(nullptr),
+    oldFromNewCachedQueries(nullptr),
+    cacheQueryTree(false),
     relError(relError),
     absError(absError),
     ownsReferenceTree(false),
@@ -97,6 +100,10 @@ KDE<KernelType,
 KDE(const KDE& other) :
     kernel(KernelType(other.kernel)),
     metric(MetricType(other.metric)),
+    // The query tree cache is not copied; it will be rebuilt on demand.
+    cachedQueryTree(nullptr),
+    oldFromNewCachedQueries(nullptr),
+    cacheQueryTree(other.cacheQueryTree),
     relError(other.relError),
     absError(other.absError),
     ownsReferenceTree(other.ownsReferenceTree),
@@ -143,6 +150,9 @@ KDE(KDE&& other) :
     metric(std::move(other.metric)),
     referenceTree(other.referenceTree),
     oldFromNewReferences(other.oldFromNewReferences),
+    cachedQueryTree(other.cachedQueryTree),
+    oldFromNewCachedQueries(other.oldFromNewCachedQueries),
+    cacheQueryTree(other.cacheQueryTree),
     relError(other.relError),
     absError(other.absError),
     ownsReferenceTree(other.ownsReferenceTree),
@@ -158,6 +168,9 @@ KDE(KDE&& other) :
   other.metric = std::move(MetricType());
   other.referenceTree = nullptr;
   other.oldFromNewReferences = nullptr;
+  other.cachedQueryTree = nullptr;
+  other.oldFromNewCachedQueries = nullptr;
+  other.cacheQueryTree = false;
   other.relError = KDEDefaultParams::relError;
   other.absError = KDEDefaultParams::absError;
   other.ownsReferenceTree = false;
@@ -198,12 +211,18 @@ operator=(KDE other)
     delete referenceTree;
     delete oldFromNewReferences;
   }
+  ClearQueryTreeCache();
 
   // Move the other object.
   this->kernel = std::move(other.kernel);
   this->metric = std::move(other.metric);
   this->referenceTree = std::move(other.referenceTree);
   this->oldFromNewReferences = std::move(other.oldFromNewReferences);
+  this->cachedQueryTree = other.cachedQueryTree;
+  this->oldFromNewCachedQueries = other.oldFromNewCachedQueries;
+  this->cacheQueryTree = other.cacheQueryTree;
+  other.cachedQueryTree = nullptr;
+  other.oldFromNewCachedQueries = nullptr;
   this->relError = other.relError;
   this->absError = other.absError;
   this->ownsReferenceTree = other.ownsReferenceTree;
@@ -239,6 +258,7 @@ KDE<KernelType,
     delete referenceTree;
     delete oldFromNewReferences;
   }
+  ClearQueryTreeCache();
 }
 
 template<typename KernelType,
@@ -330,7 +350,25 @@ void KDE<KernelType,
          SingleTreeTraversalType>::
 Evaluate(MatType querySet, arma::vec& estimations)
 {
-  if (mode == DUAL_TREE_MODE)
+  if (mode == DUAL_TREE_MODE && cacheQueryTree)
+  {
+    // Reuse the cached query tree if its size matches the query set; the tree
+    // only depends on the geometry of the query set, so a bandwidth change
+    // does not invalidate it.
+    if (cachedQueryTree == nullptr ||
+        cachedQueryTree->Dataset().n_rows != querySet.n_rows ||
+        cachedQueryTree->Dataset().n_cols != querySet.n_cols)
+    {
+      ClearQueryTreeCache();
+      Timer::Start("building_query_tree");
+      oldFromNewCachedQueries = new std::vector<size_t>;
+      cachedQueryTree = BuildTree<Tree>(std::move(querySet),
+                                        *oldFromNewCachedQueries);
+      Timer::Stop("building_query_tree");
+    }
+    this->Evaluate(cachedQueryTree, *oldFromNewCachedQueries, estimations);
+  }
+  else if (mode == DUAL_TREE_MODE)
   {
     Timer::Start("building_query_tree");
     std::vector<size_t> oldFromNewQueries;
@@ -584,6 +622,159 @@ Evaluate(arma::vec& estimations)
   Log::Info << rules.BaseCases() << " base cases were calculated." << std::endl;
 }
 
+template<typename KernelType,
+         typename MetricType,
+         typename MatType,
+         template<typename TreeMetricType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType,
+         template<typename> class DualTreeTraversalType,
+         template<typename> class SingleTreeTraversalType>
+void KDE<KernelType,
+         MetricType,
+         MatType,
+         TreeType,
+         DualTreeTraversalType,
+         SingleTreeTraversalType>::
+EvaluateMultipleBandwidths(const MatType& querySet,
+                           const arma::vec& bandwidths,
+                           arma::mat& estimations)
+{
+  // Check whether has already been trained.
+  if (!trained)
+  {
+    throw std::runtime_error("cannot evaluate KDE model: model needs to be "
+                             "trained before evaluation");
+  }
+
+  if (bandwidths.n_elem == 0)
+  {
+    throw std::invalid_argument("cannot evaluate KDE model: at least one "
+                                "candidate bandwidth is required");
+  }
+
+  // Check whether dimensions match.
+  if (querySet.n_rows != referenceTree->Dataset().n_rows)
+  {
+    throw std::invalid_argument("cannot evaluate KDE model: querySet and "
+                                "referenceSet dimensions don't match");
+  }
+
+  // One instantiated kernel per candidate bandwidth.
+  std::vector<KernelType> kernels;
+  kernels.reserve(bandwidths.n_elem);
+  for (size_t b = 0; b < bandwidths.n_elem; ++b)
+    kernels.push_back(KernelType(bandwidths[b]));
+
+  // Get estimations matrix ready.
+  estimations.zeros(bandwidths.n_elem, querySet.n_cols);
+
+  Timer::Start("computing_kde");
+
+  // A single traversal per query point evaluates every candidate bandwidth;
+  // the distances are computed once and shared by all the kernels.
+  for (size_t i = 0; i < querySet.n_cols; ++i)
+  {
+    const arma::vec queryPoint = querySet.col(i);
+    MultiBandwidthRecursion(queryPoint, i, *referenceTree, kernels,
+        estimations);
+  }
+
+  estimations /= referenceTree->Dataset().n_cols;
+  Timer::Stop("computing_kde");
+}
+
+template<typename KernelType,
+         typename MetricType,
+         typename MatType,
+         template<typename TreeMetricType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType,
+         template<typename> class DualTreeTraversalType,
+         template<typename> class SingleTreeTraversalType>
+void KDE<KernelType,
+         MetricType,
+         MatType,
+         TreeType,
+         DualTreeTraversalType,
+         SingleTreeTraversalType>::
+MultiBandwidthRecursion(const arma::vec& queryPoint,
+                        const size_t queryIndex,
+                        Tree& referenceNode,
+                        std::vector<KernelType>& kernels,
+                        arma::mat& estimations)
+{
+  // Compute the distance range to this node once; it is valid for every
+  // candidate bandwidth.
+  const math::Range r = referenceNode.RangeDistance(queryPoint);
+  const size_t refNumDesc = referenceNode.NumDescendants();
+  const double absErrorTol = absError / referenceTree->Dataset().n_cols;
+
+  // The node may only be approximated when the pruning bound of every
+  // candidate bandwidth holds; this is the same per-bandwidth bound that
+  // KDERules uses for single-tree scoring.
+  bool prunable = true;
+  for (size_t b = 0; b < kernels.size(); ++b)
+  {
+    const double maxKernel = kernels[b].Evaluate(r.Lo());
+    const double minKernel = kernels[b].Evaluate(r.Hi());
+    if (maxKernel - minKernel > 2 * (absErrorTol + relError * minKernel))
+    {
+      prunable = false;
+      break;
+    }
+  }
+
+  if (prunable)
+  {
+    for (size_t b = 0; b < kernels.size(); ++b)
+    {
+      const double kernelValue = (kernels[b].Evaluate(r.Lo()) +
+          kernels[b].Evaluate(r.Hi())) / 2.0;
+      estimations(b, queryIndex) += refNumDesc * kernelValue;
+    }
+    return;
+  }
+
+  // Base cases: each distance is computed once and evaluated with every
+  // candidate kernel.
+  for (size_t i = 0; i < referenceNode.NumPoints(); ++i)
+  {
+    const double distance = metric.Evaluate(queryPoint,
+        referenceTree->Dataset().col(referenceNode.Point(i)));
+    for (size_t b = 0; b < kernels.size(); ++b)
+      estimations(b, queryIndex) += kernels[b].Evaluate(distance);
+  }
+
+  for (size_t c = 0; c < referenceNode.NumChildren(); ++c)
+  {
+    MultiBandwidthRecursion(queryPoint, queryIndex, referenceNode.Child(c),
+        kernels, estimations);
+  }
+}
+
+template<typename KernelType,
+         typename MetricType,
+         typename MatType,
+         template<typename TreeMetricType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType,
+         template<typename> class DualTreeTraversalType,
+         template<typename> class SingleTreeTraversalType>
+void KDE<KernelType,
+         MetricType,
+         MatType,
+         TreeType,
+         DualTreeTraversalType,
+         SingleTreeTraversalType>::
+ClearQueryTreeCache()
+{
+  delete cachedQueryTree;
+  delete oldFromNewCachedQueries;
+  cachedQueryTree = nullptr;
+  oldFromNewCachedQueries = nullptr;
+}
+
 template<typename KernelType,
          typename MetricType,
          typename MatType,
@@ -749,6 +940,10 @@ serialize(Archive& ar, const unsigned int version)
     }
     // After loading tree, we own it.
     ownsReferenceTree = true;
+
+    // The query tree cache is a runtime preference and is not serialized.
+    ClearQueryTreeCache();
+    cacheQueryTree = false;
   }
 
   // Serialize the rest of values.
@@ -13,6 +13,10 @@
 #include <mlpack/core/util/cli.hpp>
 #include <mlpack/core/util/mlpack_main.hpp>
 #include <mlpack/core.hpp>
+#include <mlpack/core/data/save_async.hpp>
+
+#include <fstream>
+#include <sstream>
 
 #include "kde.hpp"
 #include "kde_model.hpp"
@@ -70,6 +74,15 @@ PROGRAM_INFO("Kernel Density Estimation",
     "already been computed. This fraction is set using " +
     PRINT_PARAM_STRING("mc_break_coef") + "."
     "\n\n"
+    "As an alternative to the tree-based engines, the " +
+    PRINT_PARAM_STRING("sketch") + " flag replaces the reference set with a "
+    "random Fourier feature sketch (Gaussian kernel only).  After training, "
+    "each query is evaluated against the sketch in constant time with respect "
+    "to the size of the reference set; in exchange, the error guarantee is "
+    "only approximate, and is controlled by " +
+    PRINT_PARAM_STRING("rel_error") + " (a smaller tolerance produces a "
+    "larger, more accurate sketch)."
+    "\n\n"
     "For example, the following will run KDE using the data in " +
     PRINT_DATASET("ref_data") + " for training and the data in " +
     PRINT_DATASET("qu_data") + " as query data. It will apply an Epanechnikov "
@@ -87,6 +100,14 @@ PROGRAM_INFO("Kernel Density Estimation",
     "If no " + PRINT_PARAM_STRING("query") + " is provided, then KDE will be "
     "computed on the " + PRINT_PARAM_STRING("reference") + " dataset."
     "\n"
+    "A whole sweep of query files can be processed in one invocation by "
+    "passing a manifest with " + PRINT_PARAM_STRING("query_manifest") + ".  "
+    "Each line of the manifest holds a query file name, optionally followed "
+    "by the predictions output file name; when the output name is omitted, it "
+    "defaults to the query file name with '.predictions.csv' appended.  Every "
+    "file is evaluated against the same model, so the model load (or tree "
+    "build) cost is paid only once for the whole sweep."
+    "\n"
     "It is possible to select either a reference dataset or an input model "
     "but not both at the same time. If an input model is selected and "
     "parameter values are not set (e.g. " + PRINT_PARAM_STRING("bandwidth") +
@@ -125,6 +146,9 @@ PROGRAM_INFO("Kernel Density Estimation",
 // Required options.
 PARAM_MATRIX_IN("reference", "Input reference dataset use for KDE.", "r");
 PARAM_MATRIX_IN("query", "Query dataset to KDE on.", "q");
+PARAM_STRING_IN("query_manifest", "File containing a list of query files to "
+    "evaluate against the same model in one invocation; see the description "
+    "for the line format.", "Q", "");
 PARAM_DOUBLE_IN("bandwidth", "Bandwidth of the kernel.", "b", 1.0);
 
 // Load or save models.
@@ -178,6 +202,10 @@ PARAM_DOUBLE_IN("mc_break_coef",
                 "the limit for the sample size before it recurses.",
                 "c",
                 KDEDefaultParams::mcBreakCoef);
+PARAM_FLAG("sketch",
+           "Whether to use a random Fourier feature sketch of the reference "
+           "set instead of a tree (Gaussian kernel only).",
+           "K");
 
 // Output predictions options.
 PARAM_COL_OUT("predictions", "Vector to store density predictions.",
@@ -205,6 +233,14 @@ static void mlpackMain()
 
   // You can only specify reference data or a pre-trained model.
   RequireOnlyOnePassed({ "reference", "input_model" }, true);
+
+  // There is only one way to specify query data.
+  if (CLI::HasParam("query") && CLI::HasParam("query_manifest"))
+  {
+    Log::Fatal << "Can only pass one of " << PRINT_PARAM_STRING("query")
+        << " or " << PRINT_PARAM_STRING("query_manifest") << "!" << endl;
+  }
+  ReportIgnoredParam({{ "query_manifest", true }}, "predictions");
   ReportIgnoredParam({{ "input_model", true }}, "tree");
   ReportIgnoredParam({{ "input_model", true }}, "kernel");
 
@@ -219,6 +255,14 @@ static void mlpackMain()
                        "Monte Carlo only works with Gaussian kernel");
   }
 
+  // The sketch engine replaces the trees entirely.
+  const bool sketch = CLI::GetParam<bool>("sketch");
+  if (sketch && kernelStr != "gaussian")
+    Log::Fatal << "Sketched KDE only works with the Gaussian kernel!" << endl;
+  ReportIgnoredParam({{ "sketch", true }}, "tree");
+  ReportIgnoredParam({{ "sketch", true }}, "algorithm");
+  ReportIgnoredParam({{ "sketch", true }}, "monte_carlo");
+
   // Requirements for parameter values.
   RequireParamInSet<string>("kernel", { "gaussian", "epanechnikov",
       "laplacian", "spherical", "triangular" }, true, "unknown kernel type");
@@ -249,7 +293,9 @@ static void mlpackMain()
   {
     arma::mat reference = std::move(CLI::GetParam<arma::mat>("reference"));
 
-    kde = new KDEModel();
+    // The bandwidth and error tolerances are also set after training, but the
+    // sketch engine consumes them at training time, so they must be set here.
+    kde = new KDEModel(bandwidth, relError, absError);
 
     // Set KernelType.
     if (kernelStr == "gaussian")
@@ -275,14 +321,20 @@ static void mlpackMain()
     else if (treeStr == "r-tree")
       kde->TreeType() = KDEModel::R_TREE;
 
+    // Set whether to use the sketch engine.
+    kde->Sketch() = sketch;
+
     // Build model.
     kde->BuildModel(std::move(reference));
 
-    // Set Mode.
-    if (modeStr == "dual-tree")
-      kde->Mode() = KDEMode::DUAL_TREE_MODE;
-    else if (modeStr == "single-tree")
-      kde->Mode() = KDEMode::SINGLE_TREE_MODE;
+    // Set Mode.  The sketch engine has no traversal mode.
+    if (!sketch)
+    {
+      if (modeStr == "dual-tree")
+        kde->Mode() = KDEMode::DUAL_TREE_MODE;
+      else if (modeStr == "single-tree")
+        kde->Mode() = KDEMode::SINGLE_TREE_MODE;
+    }
   }
   else
   {
@@ -301,7 +353,63 @@ static void mlpackMain()
   kde->MCBreakCoefficient(mcBreakCoef);
 
   // Evaluation.
-  if (CLI::HasParam("query"))
+  if (CLI::HasParam("query_manifest"))
+  {
+    const string manifestFile = CLI::GetParam<string>("query_manifest");
+    ifstream manifest(manifestFile.c_str());
+    if (!manifest.is_open())
+    {
+      // Clean memory if needed before crashing.
+      if (CLI::HasParam("reference"))
+        delete kde;
+      Log::Fatal << "Cannot open query manifest file '" << manifestFile
+          << "'!" << endl;
+    }
+
+    // Each line of the manifest holds a query file, optionally followed by
+    // the predictions output file.  Results are written as soon as each file
+    // finishes, so the model load and tree build costs are paid only once for
+    // the whole sweep.
+    string line;
+    size_t processed = 0;
+    while (getline(manifest, line))
+    {
+      istringstream lineStream(line);
+      string queryFile;
+      // Skip blank lines and comments.
+      if (!(lineStream >> queryFile) || queryFile[0] == '#')
+        continue;
+
+      string predictionsFile;
+      lineStream >> predictionsFile;
+      if (predictionsFile.empty())
+        predictionsFile = queryFile + ".predictions.csv";
+
+      // A bad entry skips to the next file instead of ending the sweep.
+      arma::mat query;
+      if (!data::Load(queryFile, query, false))
+      {
+        Log::Warn << "Unable to load query file '" << queryFile << "'; "
+            << "skipping!" << endl;
+        continue;
+      }
+
+      Log::Info << "Evaluating query file '" << queryFile << "' ("
+          << query.n_rows << "x" << query.n_cols << ")." << endl;
+
+      kde->Evaluate(std::move(query), estimations);
+
+      // Hand the results to the background writer, so this file's
+      // predictions are written while the next file is being evaluated.
+      data::SaveAsync(predictionsFile, std::move(estimations));
+      ++processed;
+    }
+
+    data::WaitForSaves();
+    Log::Info << "Processed " << processed << " query files from '"
+        << manifestFile << "'." << endl;
+  }
+  else if (CLI::HasParam("query"))
   {
     arma::mat query = std::move(CLI::GetParam<arma::mat>("query"));
     kde->Evaluate(std::move(query), estimations);
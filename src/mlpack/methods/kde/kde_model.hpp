@@ -24,6 +24,7 @@
 // Remaining includes.
 #include <boost/variant.hpp>
 #include "kde.hpp"
+#include "random_fourier_kde.hpp"
 
 namespace mlpack {
 namespace kde {
@@ -351,6 +352,17 @@ class ModeVisitor : public boost::static_visitor<KDEMode&>
   KDEMode& operator()(KDEType* kde) const;
 };
 
+/**
+ * QueryTreeCacheVisitor exposes the CacheQueryTree() method of the KDEType.
+ */
+class QueryTreeCacheVisitor : public boost::static_visitor<bool&>
+{
+ public:
+  //! Return reference to the query tree caching flag of the KDEType instance.
+  template<typename KDEType>
+  bool& operator()(KDEType* kde) const;
+};
+
 class DeleteVisitor : public boost::static_visitor<void>
 {
  public:
@@ -412,6 +424,13 @@ class KDEModel
   //! Break coefficient for Monte Carlo estimations.
   double mcBreakCoef;
 
+  //! Whether to use the random Fourier feature sketch engine instead of a
+  //! tree-based engine (only valid for the Gaussian kernel).
+  bool sketch;
+
+  //! Sketch engine; only non-NULL when the model was built in sketch mode.
+  RandomFourierKDE<kernel::GaussianKernel>* sketchKDE;
+
   /**
    * kdeModel holds an instance of each possible combination of KernelType and
    * TreeType. It is initialized using BuildModel.
@@ -466,6 +485,8 @@ class KDEModel
    * @param mcBreakCoef Coefficient to control what fraction of the node's
    *                    descendants evaluated is the limit before Monte Carlo
    *                    estimation recurses.
+   * @param sketch Whether to use the random Fourier feature sketch engine
+   *               instead of a tree-based engine (Gaussian kernel only).
    */
   KDEModel(const double bandwidth = 1.0,
            const double relError = KDEDefaultParams::relError,
@@ -476,7 +497,8 @@ class KDEModel
            const double mcProb = KDEDefaultParams::mcProb,
            const size_t initialSampleSize = KDEDefaultParams::initialSampleSize,
            const double mcEntryCoef = KDEDefaultParams::mcEntryCoef,
-           const double mcBreakCoef = KDEDefaultParams::mcBreakCoef);
+           const double mcBreakCoef = KDEDefaultParams::mcBreakCoef,
+           const bool sketch = false);
 
   //! Copy constructor of the given model.
   KDEModel(const KDEModel& other);
@@ -560,12 +582,28 @@ class KDEModel
   //! Modify Monte Carlo break coefficient.
   void MCBreakCoefficient(const double newBreakCoef);
 
+  //! Get whether the model uses the random Fourier feature sketch engine.
+  bool Sketch() const { return sketch; }
+
+  //! Modify whether the model uses the random Fourier feature sketch engine
+  //! (takes effect at the next BuildModel()).
+  bool& Sketch() { return sketch; }
+
   //! Get the mode of the model.
   KDEMode Mode() const;
 
   //! Modify the mode of the model.
   KDEMode& Mode();
 
+  //! Get whether the model caches the query tree between evaluations.
+  bool QueryTreeCache() const;
+
+  //! Modify whether the model caches the query tree between evaluations.
+  //! When enabled, dual-tree evaluations over the same query set reuse the
+  //! query tree, so bandwidth sweeps only pay the tree-build cost once. This
+  //! is a runtime preference and is not serialized.
+  bool& QueryTreeCache();
+
   /**
    * Build the KDE model with the given parameters and then trains it with the
    * given reference data.
@@ -609,7 +647,7 @@ class KDEModel
 } // namespace mlpack
 
 //! Set the serialization version of the KDEModel class.
-BOOST_TEMPLATE_CLASS_VERSION(template<>, mlpack::kde::KDEModel, 1);
+BOOST_TEMPLATE_CLASS_VERSION(template<>, mlpack::kde::KDEModel, 2);
 
 #include "kde_model_impl.hpp"
 
@@ -30,7 +30,8 @@ inline KDEModel::KDEModel(const double bandwidth,
                           const double mcProb,
                           const size_t initialSampleSize,
                           const double mcEntryCoef,
-                          const double mcBreakCoef) :
+                          const double mcBreakCoef,
+                          const bool sketch) :
   bandwidth(bandwidth),
   relError(relError),
   absError(absError),
@@ -40,7 +41,9 @@ inline KDEModel::KDEModel(const double bandwidth,
   mcProb(mcProb),
   initialSampleSize(initialSampleSize),
   mcEntryCoef(mcEntryCoef),
-  mcBreakCoef(mcBreakCoef)
+  mcBreakCoef(mcBreakCoef),
+  sketch(sketch),
+  sketchKDE(NULL)
 {
   // Nothing to do.
 }
@@ -56,7 +59,10 @@ inline KDEModel::KDEModel(const KDEModel& other) :
   mcProb(other.mcProb),
   initialSampleSize(other.initialSampleSize),
   mcEntryCoef(other.mcEntryCoef),
-  mcBreakCoef(other.mcBreakCoef)
+  mcBreakCoef(other.mcBreakCoef),
+  sketch(other.sketch),
+  sketchKDE(other.sketchKDE ?
+      new RandomFourierKDE<kernel::GaussianKernel>(*other.sketchKDE) : NULL)
 {
   // Nothing to do.
 }
@@ -73,6 +79,8 @@ inline KDEModel::KDEModel(KDEModel&& other) :
   initialSampleSize(other.initialSampleSize),
   mcEntryCoef(other.mcEntryCoef),
   mcBreakCoef(other.mcBreakCoef),
+  sketch(other.sketch),
+  sketchKDE(other.sketchKDE),
   kdeModel(std::move(other.kdeModel))
 {
   // Reset other model.
@@ -86,12 +94,18 @@ inline KDEModel::KDEModel(KDEModel&& other) :
   other.initialSampleSize = KDEDefaultParams::initialSampleSize;
   other.mcEntryCoef = KDEDefaultParams::mcEntryCoef;
   other.mcBreakCoef = KDEDefaultParams::mcBreakCoef;
+  other.sketch = false;
+  other.sketchKDE = NULL;
   other.kdeModel = decltype(other.kdeModel)();
 }
 
 inline KDEModel& KDEModel::operator=(KDEModel other)
 {
   boost::apply_visitor(DeleteVisitor(), kdeModel);
+  delete sketchKDE;
+  sketch = other.sketch;
+  sketchKDE = other.sketchKDE;
+  other.sketchKDE = NULL;
   bandwidth = other.bandwidth;
   relError = other.relError;
   absError = other.absError;
@@ -110,12 +124,32 @@ inline KDEModel& KDEModel::operator=(KDEModel other)
 inline KDEModel::~KDEModel()
 {
   boost::apply_visitor(DeleteVisitor(), kdeModel);
+  delete sketchKDE;
 }
 
 inline void KDEModel::BuildModel(arma::mat&& referenceSet)
 {
   // Clean memory, if necessary.
   boost::apply_visitor(DeleteVisitor(), kdeModel);
+  delete sketchKDE;
+  sketchKDE = NULL;
+
+  // The sketch engine replaces the tree-based engines entirely.
+  if (sketch)
+  {
+    if (kernelType != GAUSSIAN_KERNEL)
+    {
+      throw std::invalid_argument("KDEModel::BuildModel(): the sketch engine "
+          "is only available for the Gaussian kernel");
+    }
+
+    sketchKDE = new RandomFourierKDE<kernel::GaussianKernel>(relError,
+        kernel::GaussianKernel(bandwidth));
+    Log::Info << "Training sketched KDE model ("
+        << sketchKDE->NumProjections() << " random features)..." << std::endl;
+    sketchKDE->Train(std::move(referenceSet));
+    return;
+  }
 
   // Build the actual model.
   if (kernelType == GAUSSIAN_KERNEL && treeType == KD_TREE)
@@ -273,6 +307,14 @@ inline void KDEModel::BuildModel(arma::mat&& referenceSet)
 inline void KDEModel::Evaluate(arma::mat&& querySet, arma::vec& estimations)
 {
   Log::Info << "Evaluating KDE..." << std::endl;
+  if (sketchKDE)
+  {
+    const size_t dimension = querySet.n_rows;
+    sketchKDE->Evaluate(querySet, estimations);
+    KernelNormalizer::ApplyNormalizer<kernel::GaussianKernel>(
+        sketchKDE->Kernel(), dimension, estimations);
+    return;
+  }
   DualBiKDE eval(std::move(querySet), estimations);
   boost::apply_visitor(eval, kdeModel);
 }
@@ -281,6 +323,14 @@ inline void KDEModel::Evaluate(arma::mat&& querySet, arma::vec& estimations)
 inline void KDEModel::Evaluate(arma::vec& estimations)
 {
   Log::Info << "Evaluating KDE..." << std::endl;
+  if (sketchKDE)
+  {
+    const size_t dimension = sketchKDE->ReferenceSet().n_rows;
+    sketchKDE->Evaluate(estimations);
+    KernelNormalizer::ApplyNormalizer<kernel::GaussianKernel>(
+        sketchKDE->Kernel(), dimension, estimations);
+    return;
+  }
   DualMonoKDE eval(estimations);
   boost::apply_visitor(eval, kdeModel);
 }
@@ -289,10 +339,12 @@ inline void KDEModel::Evaluate(arma::vec& estimations)
 inline void KDEModel::CleanMemory()
 {
   boost::apply_visitor(DeleteVisitor(), kdeModel);
+  delete sketchKDE;
+  sketchKDE = NULL;
 }
 
 // Parameters for KDE evaluation.
-DualMonoKDE::DualMonoKDE(arma::vec& estimations):
+inline DualMonoKDE::DualMonoKDE(arma::vec& estimations):
     estimations(estimations)
 {}
 
@@ -318,7 +370,7 @@ void DualMonoKDE::operator()(KDETypeT<KernelType, TreeType>* kde) const
 }
 
 // Parameters for KDE evaluation.
-DualBiKDE::DualBiKDE(arma::mat&& querySet, arma::vec& estimations):
+inline DualBiKDE::DualBiKDE(arma::mat&& querySet, arma::vec& estimations):
     dimension(querySet.n_rows),
     querySet(std::move(querySet)),
     estimations(estimations)
@@ -345,7 +397,7 @@ void DualBiKDE::operator()(KDETypeT<KernelType, TreeType>* kde) const
 }
 
 // Parameters for Train.
-TrainVisitor::TrainVisitor(arma::mat&& referenceSet) :
+inline TrainVisitor::TrainVisitor(arma::mat&& referenceSet) :
     referenceSet(std::move(referenceSet))
 {}
 
@@ -364,7 +416,7 @@ void TrainVisitor::operator()(KDEType<KernelType, TreeType>* kde) const
 }
 
 // Modify kernel bandwidth.
-BandwidthVisitor::BandwidthVisitor(const double bandwidth) :
+inline BandwidthVisitor::BandwidthVisitor(const double bandwidth) :
     bandwidth(bandwidth)
 {}
 
@@ -382,7 +434,7 @@ void BandwidthVisitor::operator()(KDEType<KernelType, TreeType>* kde) const
 }
 
 // Modify relative error tolerance.
-RelErrorVisitor::RelErrorVisitor(const double relError) :
+inline RelErrorVisitor::RelErrorVisitor(const double relError) :
     relError(relError)
 {}
 
@@ -400,7 +452,7 @@ void RelErrorVisitor::operator()(KDEType<KernelType, TreeType>* kde) const
 }
 
 // Modify absolute error tolerance.
-AbsErrorVisitor::AbsErrorVisitor(const double absError) :
+inline AbsErrorVisitor::AbsErrorVisitor(const double absError) :
     absError(absError)
 {}
 
@@ -418,7 +470,7 @@ void AbsErrorVisitor::operator()(KDEType<KernelType, TreeType>* kde) const
 }
 
 // Activate or deactivate Monte Carlo.
-MonteCarloVisitor::MonteCarloVisitor(const bool monteCarlo) :
+inline MonteCarloVisitor::MonteCarloVisitor(const bool monteCarlo) :
     monteCarlo(monteCarlo)
 {}
 
@@ -436,7 +488,7 @@ void MonteCarloVisitor::operator()(KDEType<KernelType, TreeType>* kde) const
 }
 
 // Set Monte Carlo probability.
-MCProbabilityVisitor::MCProbabilityVisitor(const double probability) :
+inline MCProbabilityVisitor::MCProbabilityVisitor(const double probability) :
     probability(probability)
 {}
 
@@ -454,7 +506,7 @@ void MCProbabilityVisitor::operator()(KDEType<KernelType, TreeType>* kde) const
 }
 
 // Set Monte Carlo sample size.
-MCSampleSizeVisitor::MCSampleSizeVisitor(const size_t sampleSize) :
+inline MCSampleSizeVisitor::MCSampleSizeVisitor(const size_t sampleSize) :
     sampleSize(sampleSize)
 {}
 
@@ -472,7 +524,7 @@ void MCSampleSizeVisitor::operator()(KDEType<KernelType, TreeType>* kde) const
 }
 
 // Set Monte Carlo entry coefficient.
-MCEntryCoefVisitor::MCEntryCoefVisitor(const double entryCoef) :
+inline MCEntryCoefVisitor::MCEntryCoefVisitor(const double entryCoef) :
     entryCoef(entryCoef)
 {}
 
@@ -490,7 +542,7 @@ void MCEntryCoefVisitor::operator()(KDEType<KernelType, TreeType>* kde) const
 }
 
 // Set Monte Carlo break coefficient.
-MCBreakCoefVisitor::MCBreakCoefVisitor(const double breakCoef) :
+inline MCBreakCoefVisitor::MCBreakCoefVisitor(const double breakCoef) :
     breakCoef(breakCoef)
 {}
 
@@ -525,18 +577,40 @@ KDEMode& ModeVisitor::operator()(KDEType* kde) const
     throw std::runtime_error("no KDE model initialized");
 }
 
+// Query tree caching flag of model.
+template<typename KDEType>
+bool& QueryTreeCacheVisitor::operator()(KDEType* kde) const
+{
+  if (kde)
+    return kde->CacheQueryTree();
+  else
+    throw std::runtime_error("no KDE model initialized");
+}
+
 // Get mode of model.
-KDEMode KDEModel::Mode() const
+inline KDEMode KDEModel::Mode() const
 {
   return boost::apply_visitor(ModeVisitor(), kdeModel);
 }
 
 // Modify mode of model.
-KDEMode& KDEModel::Mode()
+inline KDEMode& KDEModel::Mode()
 {
   return boost::apply_visitor(ModeVisitor(), kdeModel);
 }
 
+// Get query tree caching flag of model.
+inline bool KDEModel::QueryTreeCache() const
+{
+  return boost::apply_visitor(QueryTreeCacheVisitor(), kdeModel);
+}
+
+// Modify query tree caching flag of model.
+inline bool& KDEModel::QueryTreeCache()
+{
+  return boost::apply_visitor(QueryTreeCacheVisitor(), kdeModel);
+}
+
 // Serialize the model.
 template<typename Archive>
 void KDEModel::serialize(Archive& ar, const unsigned int version)
@@ -567,7 +641,23 @@ void KDEModel::serialize(Archive& ar, const unsigned int version)
   }
 
   if (Archive::is_loading::value)
+  {
     boost::apply_visitor(DeleteVisitor(), kdeModel);
+    delete sketchKDE;
+    sketchKDE = NULL;
+  }
+
+  // Backward compatibility: Old versions of KDEModel did not have a sketch
+  // engine.
+  if (version > 1)
+  {
+    ar & BOOST_SERIALIZATION_NVP(sketch);
+    ar & BOOST_SERIALIZATION_NVP(sketchKDE);
+  }
+  else if (Archive::is_loading::value)
+  {
+    sketch = false;
+  }
 
   ar & BOOST_SERIALIZATION_NVP(kdeModel);
 }
@@ -576,6 +666,11 @@ void KDEModel::serialize(Archive& ar, const unsigned int version)
 void KDEModel::Bandwidth(const double newBandwidth)
 {
   bandwidth = newBandwidth;
+  if (sketchKDE)
+  {
+    sketchKDE->Kernel() = kernel::GaussianKernel(newBandwidth);
+    return;
+  }
   BandwidthVisitor bandwidthVisitor(newBandwidth);
   boost::apply_visitor(bandwidthVisitor, kdeModel);
 }
@@ -584,6 +679,11 @@ void KDEModel::Bandwidth(const double newBandwidth)
 void KDEModel::RelativeError(const double newRelError)
 {
   relError = newRelError;
+  if (sketchKDE)
+  {
+    sketchKDE->RelativeError(newRelError);
+    return;
+  }
   RelErrorVisitor relErrorVisitor(newRelError);
   boost::apply_visitor(relErrorVisitor, kdeModel);
 }
@@ -592,6 +692,9 @@ void KDEModel::RelativeError(const double newRelError)
 void KDEModel::AbsoluteError(const double newAbsError)
 {
   absError = newAbsError;
+  // The sketch engine has no use for this parameter.
+  if (sketchKDE)
+    return;
   AbsErrorVisitor absErrorVisitor(newAbsError);
   boost::apply_visitor(absErrorVisitor, kdeModel);
 }
@@ -600,6 +703,9 @@ void KDEModel::AbsoluteError(const double newAbsError)
 void KDEModel::MonteCarlo(const bool newMonteCarlo)
 {
   monteCarlo = newMonteCarlo;
+  // The sketch engine has no use for this parameter.
+  if (sketchKDE)
+    return;
   MonteCarloVisitor monteCarloVisitor(newMonteCarlo);
   boost::apply_visitor(monteCarloVisitor, kdeModel);
 }
@@ -608,6 +714,9 @@ void KDEModel::MonteCarlo(const bool newMonteCarlo)
 void KDEModel::MCProbability(const double newMCProb)
 {
   mcProb = newMCProb;
+  // The sketch engine has no use for this parameter.
+  if (sketchKDE)
+    return;
   MCProbabilityVisitor mcProbVisitor(newMCProb);
   boost::apply_visitor(mcProbVisitor, kdeModel);
 }
@@ -616,6 +725,9 @@ void KDEModel::MCProbability(const double newMCProb)
 void KDEModel::MCInitialSampleSize(const size_t newSampleSize)
 {
   initialSampleSize = newSampleSize;
+  // The sketch engine has no use for this parameter.
+  if (sketchKDE)
+    return;
   MCSampleSizeVisitor mcSampleSizeVisitor(newSampleSize);
   boost::apply_visitor(mcSampleSizeVisitor, kdeModel);
 }
@@ -624,6 +736,9 @@ void KDEModel::MCInitialSampleSize(const size_t newSampleSize)
 void KDEModel::MCEntryCoefficient(const double newEntryCoef)
 {
   mcEntryCoef = newEntryCoef;
+  // The sketch engine has no use for this parameter.
+  if (sketchKDE)
+    return;
   MCEntryCoefVisitor mcEntryCoefVisitor(newEntryCoef);
   boost::apply_visitor(mcEntryCoefVisitor, kdeModel);
 }
@@ -632,6 +747,9 @@ void KDEModel::MCEntryCoefficient(const double newEntryCoef)
 void KDEModel::MCBreakCoefficient(const double newBreakCoef)
 {
   mcBreakCoef = newBreakCoef;
+  // The sketch engine has no use for this parameter.
+  if (sketchKDE)
+    return;
   MCBreakCoefVisitor mcBreakCoefVisitor(newBreakCoef);
   boost::apply_visitor(mcBreakCoefVisitor, kdeModel);
 }
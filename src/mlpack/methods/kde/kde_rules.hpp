@@ -154,6 +154,13 @@ class KDERules
   //! Whether reference and query sets are the same.
   const bool sameSet;
 
+  //! Scratch space for distances of sampled points, kept as a member to avoid
+  //! reallocations in the Monte Carlo sampling loop.
+  arma::vec scratchDistances;
+
+  //! Scratch space for batched kernel evaluations of sampled points.
+  arma::vec scratchKernelValues;
+
   //! Whether the kernel used for the rule is the Gaussian Kernel.
   constexpr static bool kernelIsGaussian =
       std::is_same<KernelType, kernel::GaussianKernel>::value;
@@ -217,18 +217,25 @@ Score(const size_t queryIndex, TreeType& referenceNode)
 
       // Increase the sample size.
       sample.resize(newSize);
+      scratchDistances.set_size(m);
       for (size_t i = 0; i < m; ++i)
       {
-        // Sample and evaluate random points from the reference node.
+        // Sample random points from the reference node.
         size_t randomPoint;
         if (alreadyDidRefPoint0)
           randomPoint = math::RandInt(1, refNumDesc);
         else
           randomPoint = math::RandInt(0, refNumDesc);
 
-        sample(oldSize + i) =
-            EvaluateKernel(queryIndex, referenceNode.Descendant(randomPoint));
+        scratchDistances(i) = metric.Evaluate(
+            querySet.unsafe_col(queryIndex),
+            referenceSet.unsafe_col(referenceNode.Descendant(randomPoint)));
       }
+
+      // Evaluate the kernel on all sampled distances at once.
+      kernel.Evaluate(scratchDistances, scratchKernelValues);
+      sample.subvec(oldSize, newSize - 1) = scratchKernelValues;
+
       meanSample = arma::mean(sample);
       const double stddev = arma::stddev(sample);
       const double mThreshBase =
@@ -434,18 +441,25 @@ Score(TreeType& queryNode, TreeType& referenceNode)
 
         // Increase the sample size.
         sample.resize(newSize);
+        scratchDistances.set_size(m);
         for (size_t i = 0; i < m; ++i)
         {
-          // Sample and evaluate random points from the reference node.
+          // Sample random points from the reference node.
           size_t randomPoint;
           if (alreadyDidRefPoint0)
             randomPoint = math::RandInt(1, refNumDesc);
           else
             randomPoint = math::RandInt(0, refNumDesc);
 
-          sample(oldSize + i) =
-              EvaluateKernel(queryIndex, referenceNode.Descendant(randomPoint));
+          scratchDistances(i) = metric.Evaluate(
+              querySet.unsafe_col(queryIndex),
+              referenceSet.unsafe_col(referenceNode.Descendant(randomPoint)));
         }
+
+        // Evaluate the kernel on all sampled distances at once.
+        kernel.Evaluate(scratchDistances, scratchKernelValues);
+        sample.subvec(oldSize, newSize - 1) = scratchKernelValues;
+
         meanSample = arma::mean(sample);
         const double stddev = arma::stddev(sample);
         const double mThreshBase =
@@ -0,0 +1,182 @@
+/**
+ * @file methods/kde/random_fourier_kde.hpp
+ * @author Roberto Hueso
+ *
+ * Kernel Density Estimation using a random Fourier feature sketch.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_KDE_RANDOM_FOURIER_KDE_HPP
+#define MLPACK_METHODS_KDE_RANDOM_FOURIER_KDE_HPP
+
+#include <mlpack/prereqs.hpp>
+#include <mlpack/core/kernels/gaussian_kernel.hpp>
+
+namespace mlpack {
+namespace kde {
+
+/**
+ * The RandomFourierKDE class estimates kernel densities using a random
+ * Fourier feature sketch (Rahimi & Recht, 2007) instead of a tree traversal.
+ * The Gaussian kernel is approximated as the inner product of two
+ * m-dimensional feature vectors:
+ *
+ *   k(x, y) ~= z(x)' z(y),   z(x) = sqrt(2 / m) * cos(W' x + b),
+ *
+ * where the columns of W are drawn from the Fourier transform of the kernel
+ * and b is drawn uniformly from [0, 2 * pi).  The density estimate at a query
+ * q is then z(q)' * S / n, where S is the sum of the feature vectors of all n
+ * reference points.  S is computed once during training, so each query costs
+ * O(dm) regardless of the size of the reference set.
+ *
+ * The approximation error decreases as O(1 / sqrt(m)); the relError
+ * constructor parameter is the error knob, and the number of features is
+ * chosen as m = ceil(2 / relError^2).  Unlike the tree-based KDE, the error
+ * is not a per-query guarantee, but a high-probability uniform bound on the
+ * kernel approximation.
+ *
+ * This estimator is only valid for shift-invariant kernels with a known
+ * Fourier transform; only kernel::GaussianKernel is supported.
+ *
+ * @code
+ * @inproceedings{rahimi2007random,
+ *   title={Random features for large-scale kernel machines},
+ *   author={Rahimi, A. and Recht, B.},
+ *   booktitle={Advances in Neural Information Processing Systems 20
+ *       (NIPS 2007)},
+ *   pages={1177--1184},
+ *   year={2007}
+ * }
+ * @endcode
+ *
+ * @tparam KernelType Kernel to approximate (must be kernel::GaussianKernel).
+ */
+template<typename KernelType = kernel::GaussianKernel>
+class RandomFourierKDE
+{
+  static_assert(std::is_same<KernelType, kernel::GaussianKernel>::value,
+      "RandomFourierKDE requires a kernel with a known Fourier transform; "
+      "only kernel::GaussianKernel is supported.");
+
+ public:
+  /**
+   * Initialize the RandomFourierKDE object.  The number of random features is
+   * derived from the relative error tolerance as ceil(2 / relError^2), and
+   * may be overridden afterwards through NumProjections().
+   *
+   * @param relError Approximate error tolerance of the sketch.
+   * @param kernel Instantiated kernel object.
+   */
+  RandomFourierKDE(const double relError = 0.05,
+                   KernelType kernel = KernelType());
+
+  /**
+   * Train the model: draw the random features and compute the summed sketch
+   * of the reference set.  The reference set is kept (as a copy) so that
+   * monochromatic evaluation is possible.
+   *
+   * Use std::move if the reference set is no longer needed.
+   *
+   * @param referenceSet Set of reference data.
+   */
+  void Train(arma::mat referenceSet);
+
+  /**
+   * Estimate the density of each point in the query set.  Estimations are not
+   * normalized by the kernel normalizer.
+   *
+   * @pre The model has to be previously trained.
+   * @param querySet Set of query points to get the density of.
+   * @param estimations Object which will hold the density of each query point.
+   */
+  void Evaluate(const arma::mat& querySet, arma::vec& estimations) const;
+
+  /**
+   * Estimate the density of each point in the reference set, excluding the
+   * contribution of each point to its own estimate.  Estimations are not
+   * normalized by the kernel normalizer.
+   *
+   * @pre The model has to be previously trained.
+   * @param estimations Object which will hold the density of each reference
+   *                    point.
+   */
+  void Evaluate(arma::vec& estimations) const;
+
+  //! Get the kernel.
+  const KernelType& Kernel() const { return kernel; }
+
+  //! Modify the kernel (takes effect at the next Train()).
+  KernelType& Kernel() { return kernel; }
+
+  //! Get the number of random features of the sketch.
+  size_t NumProjections() const { return numProjections; }
+
+  //! Modify the number of random features (takes effect at the next Train()).
+  size_t& NumProjections() { return numProjections; }
+
+  //! Get relative error tolerance.
+  double RelativeError() const { return relError; }
+
+  //! Modify relative error tolerance; this re-derives the number of random
+  //! features, and takes effect at the next Train() (0 < newError <= 1).
+  void RelativeError(const double newError);
+
+  //! Check whether the model is trained or not.
+  bool IsTrained() const { return trained; }
+
+  //! Get the reference set.
+  const arma::mat& ReferenceSet() const { return referenceSet; }
+
+  //! Serialize the model.
+  template<typename Archive>
+  void serialize(Archive& ar, const unsigned int /* version */);
+
+ private:
+  //! Kernel.
+  KernelType kernel;
+
+  //! Relative error tolerance.
+  double relError;
+
+  //! Number of random features of the sketch.
+  size_t numProjections;
+
+  //! Copy of the reference set (needed for monochromatic evaluation).
+  arma::mat referenceSet;
+
+  //! Random projection directions (one column per feature), drawn from the
+  //! Fourier transform of the kernel.
+  arma::mat projections;
+
+  //! Random phase offsets, drawn uniformly from [0, 2 * pi).
+  arma::vec offsets;
+
+  //! Summed feature vector of the reference set.
+  arma::vec referenceSketch;
+
+  //! If true, the model is trained.
+  bool trained;
+
+  //! Number of points evaluated at once when computing feature matrices.
+  static const size_t blockSize = 1024;
+
+  /**
+   * Compute the feature matrix z(x) for each column x of the given block of
+   * points.
+   *
+   * @param block Block of points (each column is a point).
+   * @return Feature matrix (numProjections x block.n_cols).
+   */
+  arma::mat Features(const arma::mat& block) const;
+};
+
+} // namespace kde
+} // namespace mlpack
+
+// Include implementation.
+#include "random_fourier_kde_impl.hpp"
+
+#endif
@@ -0,0 +1,147 @@
+/**
+ * @file methods/kde/random_fourier_kde_impl.hpp
+ * @author Roberto Hueso
+ *
+ * Implementation of Kernel Density Estimation using a random Fourier feature
+ * sketch.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_KDE_RANDOM_FOURIER_KDE_IMPL_HPP
+#define MLPACK_METHODS_KDE_RANDOM_FOURIER_KDE_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "random_fourier_kde.hpp"
+
+namespace mlpack {
+namespace kde {
+
+template<typename KernelType>
+RandomFourierKDE<KernelType>::RandomFourierKDE(const double relError,
+                                               KernelType kernel) :
+    kernel(kernel),
+    relError(relError),
+    trained(false)
+{
+  RelativeError(relError);
+}
+
+template<typename KernelType>
+void RandomFourierKDE<KernelType>::RelativeError(const double newError)
+{
+  if (newError <= 0 || newError > 1)
+  {
+    throw std::invalid_argument("RandomFourierKDE::RelativeError(): relative "
+        "error tolerance must be a value between 0 and 1");
+  }
+
+  relError = newError;
+
+  // The uniform kernel approximation error of a random Fourier sketch decays
+  // as O(sqrt(1 / m)), so invert that rate to choose the number of features.
+  numProjections = (size_t) std::ceil(2.0 / (newError * newError));
+}
+
+template<typename KernelType>
+void RandomFourierKDE<KernelType>::Train(arma::mat referenceSet)
+{
+  Timer::Start("sketch_kde_training");
+
+  this->referenceSet = std::move(referenceSet);
+  const size_t dims = this->referenceSet.n_rows;
+
+  // For the Gaussian kernel exp(-||x - y||^2 / (2 * bw^2)), the Fourier
+  // transform is a Gaussian with covariance (1 / bw^2) * I.
+  projections = arma::randn(dims, numProjections) / kernel.Bandwidth();
+  offsets = 2.0 * M_PI * arma::randu<arma::vec>(numProjections);
+
+  // Accumulate the summed feature vector of the reference set, in blocks to
+  // bound the size of the feature matrix held in memory.
+  referenceSketch.zeros(numProjections);
+  for (size_t begin = 0; begin < this->referenceSet.n_cols;
+      begin += blockSize)
+  {
+    const size_t end = std::min(begin + blockSize,
+        (size_t) this->referenceSet.n_cols);
+    referenceSketch += arma::sum(
+        Features(this->referenceSet.cols(begin, end - 1)), 1);
+  }
+
+  trained = true;
+  Timer::Stop("sketch_kde_training");
+}
+
+template<typename KernelType>
+void RandomFourierKDE<KernelType>::Evaluate(const arma::mat& querySet,
+                                            arma::vec& estimations) const
+{
+  if (!trained)
+  {
+    throw std::runtime_error("RandomFourierKDE::Evaluate(): cannot evaluate "
+        "an untrained model");
+  }
+  if (querySet.n_rows != referenceSet.n_rows)
+  {
+    throw std::invalid_argument("RandomFourierKDE::Evaluate(): query set "
+        "dimensionality does not match reference set dimensionality");
+  }
+
+  Timer::Start("computing_kde");
+
+  estimations.set_size(querySet.n_cols);
+  for (size_t begin = 0; begin < querySet.n_cols; begin += blockSize)
+  {
+    const size_t end = std::min(begin + blockSize, (size_t) querySet.n_cols);
+    estimations.subvec(begin, end - 1) =
+        Features(querySet.cols(begin, end - 1)).t() * referenceSketch;
+  }
+  estimations /= referenceSet.n_cols;
+
+  // The sketch is an unbiased estimator but individual estimates may come out
+  // slightly negative; densities cannot be negative, so clamp.
+  estimations.transform([](double v) { return std::max(v, 0.0); });
+
+  Timer::Stop("computing_kde");
+}
+
+template<typename KernelType>
+void RandomFourierKDE<KernelType>::Evaluate(arma::vec& estimations) const
+{
+  Evaluate(referenceSet, estimations);
+
+  // Remove the contribution of each reference point to its own estimate (the
+  // evaluation above already divided by the reference set size).
+  estimations -= kernel.Evaluate(0.0) / referenceSet.n_cols;
+  estimations.transform([](double v) { return std::max(v, 0.0); });
+}
+
+template<typename KernelType>
+arma::mat RandomFourierKDE<KernelType>::Features(const arma::mat& block) const
+{
+  arma::mat features = projections.t() * block;
+  features.each_col() += offsets;
+  return std::sqrt(2.0 / numProjections) * arma::cos(features);
+}
+
+template<typename KernelType>
+template<typename Archive>
+void RandomFourierKDE<KernelType>::serialize(Archive& ar,
+                                             const unsigned int /* version */)
+{
+  ar & BOOST_SERIALIZATION_NVP(kernel);
+  ar & BOOST_SERIALIZATION_NVP(relError);
+  ar & BOOST_SERIALIZATION_NVP(numProjections);
+  ar & BOOST_SERIALIZATION_NVP(referenceSet);
+  ar & BOOST_SERIALIZATION_NVP(projections);
+  ar & BOOST_SERIALIZATION_NVP(offsets);
+  ar & BOOST_SERIALIZATION_NVP(referenceSketch);
+  ar & BOOST_SERIALIZATION_NVP(trained);
+}
+
+} // namespace kde
+} // namespace mlpack
+
+#endif
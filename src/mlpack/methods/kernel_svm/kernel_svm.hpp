@@ -0,0 +1,248 @@
+/**
+ * @file methods/kernel_svm/kernel_svm.hpp
+ *
+ * An implementation of kernel support vector machine training with SMO
+ * (sequential minimal optimization), an LRU kernel-row cache, and active-set
+ * shrinking.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_KERNEL_SVM_KERNEL_SVM_HPP
+#define MLPACK_METHODS_KERNEL_SVM_KERNEL_SVM_HPP
+
+#include <mlpack/prereqs.hpp>
+#include <mlpack/core/kernels/kernel_traits.hpp>
+#include <mlpack/core/kernels/gaussian_kernel.hpp>
+
+#include <list>
+#include <unordered_map>
+
+namespace mlpack {
+namespace svm {
+
+/**
+ * The KernelSVM class implements an L1-regularized binary kernel support
+ * vector machine, trained with SMO (sequential minimal optimization) using
+ * maximal-violating-pair working set selection.
+ *
+ * Two techniques keep training feasible when the kernel matrix does not fit
+ * in memory:
+ *
+ *  - Kernel rows are computed lazily and held in an LRU cache whose size is
+ *    bounded by CacheSize() megabytes, so the full kernel matrix is never
+ *    materialized.
+ *  - An active-set shrinking heuristic periodically removes bounded points
+ *    that cannot participate in any violating pair, so most SMO iterations
+ *    touch only a shrinking subset of the data.  When the shrunk problem
+ *    converges, the full gradient is reconstructed and optimization continues
+ *    on the whole set until the KKT conditions hold everywhere, so shrinking
+ *    never changes the solution.
+ *
+ * The kernel is a template parameter; any kernel with an
+ * @c Evaluate(const arma::vec&, const arma::vec&) method can be used, and
+ * KernelTraits is consulted to skip diagonal kernel evaluations for
+ * normalized kernels.
+ *
+ * Only binary classification is supported; labels must be 0 or 1.
+ *
+ * @code
+ * arma::mat data;
+ * arma::Row<size_t> labels;
+ *
+ * KernelSVM<kernel::GaussianKernel> svm(data, labels, 1.0);
+ *
+ * arma::Row<size_t> predictions;
+ * svm.Classify(testData, predictions);
+ * @endcode
+ *
+ * @tparam KernelType Type of kernel used to evaluate point similarities.
+ */
+template<typename KernelType = kernel::GaussianKernel>
+class KernelSVM
+{
+ public:
+  /**
+   * Construct the KernelSVM and train it on the given data.
+   *
+   * @param data Input training features; each column is a point.
+   * @param labels Labels associated with the training data (0 or 1).
+   * @param C Soft-margin penalty parameter.
+   * @param kernel Initialized kernel to use for evaluations.
+   * @param cacheSize Size of the kernel row cache, in megabytes.
+   * @param tolerance Termination tolerance on the KKT violation.
+   * @param maxIterations Maximum number of SMO iterations (0 means no limit).
+   */
+  KernelSVM(const arma::mat& data,
+            const arma::Row<size_t>& labels,
+            const double C = 1.0,
+            const KernelType& kernel = KernelType(),
+            const size_t cacheSize = 256,
+            const double tolerance = 1e-3,
+            const size_t maxIterations = 0);
+
+  /**
+   * Construct an untrained KernelSVM with the given parameters.  Call Train()
+   * before classifying anything.
+   *
+   * @param C Soft-margin penalty parameter.
+   * @param kernel Initialized kernel to use for evaluations.
+   * @param cacheSize Size of the kernel row cache, in megabytes.
+   * @param tolerance Termination tolerance on the KKT violation.
+   * @param maxIterations Maximum number of SMO iterations (0 means no limit).
+   */
+  KernelSVM(const double C = 1.0,
+            const KernelType& kernel = KernelType(),
+            const size_t cacheSize = 256,
+            const double tolerance = 1e-3,
+            const size_t maxIterations = 0);
+
+  /**
+   * Train the model on the given data, replacing any existing solution.  The
+   * dual objective value at the solution is returned.
+   *
+   * @param data Input training features; each column is a point.
+   * @param labels Labels associated with the training data (0 or 1).
+   * @return The dual objective value at the solution.
+   */
+  double Train(const arma::mat& data, const arma::Row<size_t>& labels);
+
+  /**
+   * Classify the given points, storing class 0 or 1 for each point into
+   * predictedLabels.
+   *
+   * @param test Data to classify; each column is a point.
+   * @param predictedLabels Row to store the predicted classes into.
+   */
+  void Classify(const arma::mat& test,
+                arma::Row<size_t>& predictedLabels) const;
+
+  /**
+   * Evaluate the decision function for the given points.  A point with a
+   * positive decision value is classified as class 1.
+   *
+   * @param test Data to evaluate the decision function on.
+   * @param decisions Row to store the decision values into.
+   */
+  void DecisionFunction(const arma::mat& test, arma::rowvec& decisions) const;
+
+  //! Get the support vectors (one per column).
+  const arma::mat& SupportVectors() const { return supportVectors; }
+  //! Get the dual coefficients (alpha * y) of the support vectors.
+  const arma::vec& Coefficients() const { return coefficients; }
+  //! Get the bias of the decision function.
+  double Bias() const { return bias; }
+
+  //! Get the soft-margin penalty parameter.
+  double C() const { return c; }
+  //! Modify the soft-margin penalty parameter (for the next Train() call).
+  double& C() { return c; }
+
+  //! Get the kernel.
+  const KernelType& Kernel() const { return kernel; }
+  //! Modify the kernel.
+  KernelType& Kernel() { return kernel; }
+
+  //! Get the kernel cache size, in megabytes.
+  size_t CacheSize() const { return cacheSize; }
+  //! Modify the kernel cache size, in megabytes.
+  size_t& CacheSize() { return cacheSize; }
+
+  //! Get the termination tolerance.
+  double Tolerance() const { return tolerance; }
+  //! Modify the termination tolerance.
+  double& Tolerance() { return tolerance; }
+
+  //! Get the maximum number of SMO iterations (0 means no limit).
+  size_t MaxIterations() const { return maxIterations; }
+  //! Modify the maximum number of SMO iterations.
+  size_t& MaxIterations() { return maxIterations; }
+
+  //! Serialize the model.
+  template<typename Archive>
+  void serialize(Archive& ar, const unsigned int /* version */);
+
+ private:
+  /**
+   * An LRU cache of kernel rows.  Rows are computed on demand against the
+   * full dataset and evicted least-recently-used once the configured memory
+   * budget is reached.
+   */
+  class KernelCache
+  {
+   public:
+    /**
+     * Construct the cache for the given dataset.
+     *
+     * @param data Dataset the kernel rows are computed against.
+     * @param kernel Kernel used for the evaluations.
+     * @param cacheSize Memory budget for cached rows, in megabytes.
+     */
+    KernelCache(const arma::mat& data,
+                KernelType& kernel,
+                const size_t cacheSize);
+
+    /**
+     * Get the kernel row of the given point, computing and caching it if
+     * necessary.  At least two rows are always resident, so the returned
+     * reference stays valid through one subsequent Row() call (enough for a
+     * pairwise SMO step).
+     */
+    const arma::vec& Row(const size_t i);
+
+   private:
+    //! The dataset the rows are computed against.
+    const arma::mat& data;
+    //! The kernel used for the evaluations.
+    KernelType& kernel;
+    //! Maximum number of rows held, derived from the memory budget.
+    size_t maxRows;
+    //! Cached rows, most recently used first.
+    std::list<std::pair<size_t, arma::vec>> rows;
+    //! Index of each cached row in the list.
+    std::unordered_map<size_t, std::list<std::pair<size_t,
+        arma::vec>>::iterator> lookup;
+  };
+
+  /**
+   * Extract the support vectors and their coefficients from the dual
+   * solution and compute the bias.
+   *
+   * @param data Training data the model was optimized on.
+   * @param y Labels converted to +1/-1.
+   * @param alpha Dual variables at the solution.
+   * @param gradient Dual gradient at the solution (used for the bias).
+   */
+  void ExtractModel(const arma::mat& data,
+                    const arma::vec& y,
+                    const arma::vec& alpha,
+                    const arma::vec& gradient);
+
+  //! The support vectors (one per column).
+  arma::mat supportVectors;
+  //! The dual coefficients (alpha * y) of the support vectors.
+  arma::vec coefficients;
+  //! The bias of the decision function.
+  double bias;
+
+  //! The soft-margin penalty parameter.
+  double c;
+  //! The kernel.
+  KernelType kernel;
+  //! The kernel cache size, in megabytes.
+  size_t cacheSize;
+  //! The termination tolerance.
+  double tolerance;
+  //! The maximum number of SMO iterations (0 means no limit).
+  size_t maxIterations;
+};
+
+} // namespace svm
+} // namespace mlpack
+
+// Include implementation.
+#include "kernel_svm_impl.hpp"
+
+#endif
@@ -0,0 +1,381 @@
+/**
+ * @file methods/kernel_svm/kernel_svm_impl.hpp
+ *
+ * Implementation of the KernelSVM class (SMO with an LRU kernel cache and
+ * active-set shrinking).
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_KERNEL_SVM_KERNEL_SVM_IMPL_HPP
+#define MLPACK_METHODS_KERNEL_SVM_KERNEL_SVM_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "kernel_svm.hpp"
+
+namespace mlpack {
+namespace svm {
+
+template<typename KernelType>
+KernelSVM<KernelType>::KernelSVM(const arma::mat& data,
+                                 const arma::Row<size_t>& labels,
+                                 const double C,
+                                 const KernelType& kernel,
+                                 const size_t cacheSize,
+                                 const double tolerance,
+                                 const size_t maxIterations) :
+    bias(0.0),
+    c(C),
+    kernel(kernel),
+    cacheSize(cacheSize),
+    tolerance(tolerance),
+    maxIterations(maxIterations)
+{
+  Train(data, labels);
+}
+
+template<typename KernelType>
+KernelSVM<KernelType>::KernelSVM(const double C,
+                                 const KernelType& kernel,
+                                 const size_t cacheSize,
+                                 const double tolerance,
+                                 const size_t maxIterations) :
+    bias(0.0),
+    c(C),
+    kernel(kernel),
+    cacheSize(cacheSize),
+    tolerance(tolerance),
+    maxIterations(maxIterations)
+{
+  // Nothing to do.
+}
+
+template<typename KernelType>
+KernelSVM<KernelType>::KernelCache::KernelCache(const arma::mat& data,
+                                                KernelType& kernel,
+                                                const size_t cacheSize) :
+    data(data),
+    kernel(kernel)
+{
+  // Two rows must always be resident, since every SMO step works on a pair.
+  maxRows = std::max((size_t) 2,
+      (cacheSize * 1048576) / (sizeof(double) * data.n_cols));
+}
+
+template<typename KernelType>
+const arma::vec& KernelSVM<KernelType>::KernelCache::Row(const size_t i)
+{
+  typename std::unordered_map<size_t, std::list<std::pair<size_t,
+      arma::vec>>::iterator>::iterator it = lookup.find(i);
+  if (it != lookup.end())
+  {
+    // Cache hit; move the row to the front of the LRU list.  Splicing does
+    // not invalidate references to other rows.
+    rows.splice(rows.begin(), rows, it->second);
+    return rows.front().second;
+  }
+
+  // Cache miss; evict the least recently used row if we are at capacity.
+  // Since maxRows >= 2, the previously returned row survives the eviction.
+  if (rows.size() >= maxRows)
+  {
+    lookup.erase(rows.back().first);
+    rows.pop_back();
+  }
+
+  rows.emplace_front(i, arma::vec(data.n_cols));
+  arma::vec& row = rows.front().second;
+  for (size_t t = 0; t < data.n_cols; ++t)
+    row[t] = kernel.Evaluate(data.col(i), data.col(t));
+
+  lookup[i] = rows.begin();
+  return row;
+}
+
+template<typename KernelType>
+double KernelSVM<KernelType>::Train(const arma::mat& data,
+                                    const arma::Row<size_t>& labels)
+{
+  const size_t numPoints = data.n_cols;
+  if (labels.n_elem != numPoints)
+  {
+    throw std::invalid_argument("KernelSVM::Train(): number of labels does "
+        "not match number of points!");
+  }
+  if (numPoints < 2)
+  {
+    throw std::invalid_argument("KernelSVM::Train(): at least two training "
+        "points are required!");
+  }
+  if (arma::max(labels) > 1)
+  {
+    throw std::invalid_argument("KernelSVM::Train(): only binary "
+        "classification is supported; labels must be 0 or 1!");
+  }
+
+  Timer::Start("kernel_svm_training");
+
+  // Convert the labels to +1/-1.
+  arma::vec y(numPoints);
+  for (size_t i = 0; i < numPoints; ++i)
+    y[i] = (labels[i] == 1) ? 1.0 : -1.0;
+
+  // The diagonal of the kernel matrix is needed in every pair update; for
+  // normalized kernels it is known without any evaluations.
+  arma::vec diagonal(numPoints);
+  if (kernel::KernelTraits<KernelType>::IsNormalized)
+    diagonal.ones();
+  else
+    for (size_t i = 0; i < numPoints; ++i)
+      diagonal[i] = kernel.Evaluate(data.col(i), data.col(i));
+
+  KernelCache cache(data, kernel, cacheSize);
+
+  // We minimize the dual f(alpha) = 0.5 * alpha' Q alpha - e' alpha with
+  // Q_ij = y_i y_j K_ij, subject to 0 <= alpha <= C and y' alpha = 0.
+  // 'gradient' holds (Q alpha - e); at alpha = 0 that is just -e.
+  arma::vec alpha(numPoints, arma::fill::zeros);
+  arma::vec gradient(numPoints, arma::fill::ones);
+  gradient *= -1.0;
+
+  // The active set initially holds every point; the shrinking heuristic
+  // removes bounded points that cannot participate in a violating pair.
+  std::vector<size_t> activeSet(numPoints);
+  for (size_t i = 0; i < numPoints; ++i)
+    activeSet[i] = i;
+
+  const size_t shrinkInterval = std::min(numPoints, (size_t) 1000);
+  const double boundEps = 1e-12;
+
+  size_t iteration = 0;
+  while (true)
+  {
+    // Maximal-violating-pair selection over the active set.  A point can
+    // move "up" (increase y * alpha) if it is not at the corresponding
+    // bound, and similarly for "down"; -y_t * gradient_t measures how much
+    // the objective improves by moving point t up.
+    double maxUp = -DBL_MAX, minLow = DBL_MAX;
+    size_t up = numPoints, low = numPoints;
+    for (size_t index = 0; index < activeSet.size(); ++index)
+    {
+      const size_t t = activeSet[index];
+      const double violation = -y[t] * gradient[t];
+      const bool inUp = (y[t] > 0.0) ? (alpha[t] < c - boundEps) :
+          (alpha[t] > boundEps);
+      const bool inLow = (y[t] > 0.0) ? (alpha[t] > boundEps) :
+          (alpha[t] < c - boundEps);
+
+      if (inUp && violation > maxUp)
+      {
+        maxUp = violation;
+        up = t;
+      }
+      if (inLow && violation < minLow)
+      {
+        minLow = violation;
+        low = t;
+      }
+    }
+
+    if (up == numPoints || low == numPoints || maxUp - minLow < tolerance)
+    {
+      if (activeSet.size() < numPoints)
+      {
+        // The shrunk problem has converged.  Reconstruct the gradient over
+        // all points from the support vectors and optimize on the full set,
+        // so the shrinking heuristic cannot change the solution.
+        gradient.fill(-1.0);
+        for (size_t s = 0; s < numPoints; ++s)
+        {
+          if (alpha[s] <= boundEps)
+            continue;
+
+          const arma::vec& row = cache.Row(s);
+          for (size_t t = 0; t < numPoints; ++t)
+            gradient[t] += alpha[s] * y[s] * y[t] * row[t];
+        }
+
+        activeSet.resize(numPoints);
+        for (size_t i = 0; i < numPoints; ++i)
+          activeSet[i] = i;
+        continue;
+      }
+
+      break;
+    }
+
+    if (maxIterations != 0 && iteration >= maxIterations)
+    {
+      Log::Warn << "KernelSVM::Train(): maximum iterations reached ("
+          << maxIterations << "); terminating before convergence." << std::endl;
+      break;
+    }
+    ++iteration;
+
+    // Analytic two-variable update.  Parameterize the feasible direction as
+    // alpha_up += y_up * d, alpha_low -= y_low * d; the unconstrained
+    // optimum is the violation gap over the curvature.
+    const arma::vec& rowUp = cache.Row(up);
+    const arma::vec& rowLow = cache.Row(low);
+
+    double curvature = diagonal[up] + diagonal[low] - 2.0 * rowUp[low];
+    if (curvature <= 0.0)
+      curvature = 1e-12;
+
+    double d = (maxUp - minLow) / curvature;
+
+    // Clip to the box constraints of both variables.
+    double dMin = (y[up] > 0.0) ? -alpha[up] : alpha[up] - c;
+    double dMax = (y[up] > 0.0) ? c - alpha[up] : alpha[up];
+    dMin = std::max(dMin, (y[low] > 0.0) ? alpha[low] - c : -alpha[low]);
+    dMax = std::min(dMax, (y[low] > 0.0) ? alpha[low] : c - alpha[low]);
+    d = std::max(dMin, std::min(d, dMax));
+
+    const double deltaUp = y[up] * d;
+    const double deltaLow = -y[low] * d;
+    alpha[up] += deltaUp;
+    alpha[low] += deltaLow;
+
+    // Update the gradient of the active points with the two cached rows.
+    for (size_t index = 0; index < activeSet.size(); ++index)
+    {
+      const size_t t = activeSet[index];
+      gradient[t] += y[t] * (deltaUp * y[up] * rowUp[t] +
+          deltaLow * y[low] * rowLow[t]);
+    }
+
+    // Periodically shrink the active set: a bounded point that sits on one
+    // side only and does not violate against the other side's extreme cannot
+    // be selected into a violating pair, so it is removed until the final
+    // full-set check.
+    if ((iteration % shrinkInterval) == 0)
+    {
+      std::vector<size_t> newActiveSet;
+      newActiveSet.reserve(activeSet.size());
+      for (size_t index = 0; index < activeSet.size(); ++index)
+      {
+        const size_t t = activeSet[index];
+        const double violation = -y[t] * gradient[t];
+        const bool inUp = (y[t] > 0.0) ? (alpha[t] < c - boundEps) :
+            (alpha[t] > boundEps);
+        const bool inLow = (y[t] > 0.0) ? (alpha[t] > boundEps) :
+            (alpha[t] < c - boundEps);
+
+        const bool shrink = (inUp && !inLow && violation < minLow) ||
+            (inLow && !inUp && violation > maxUp);
+        if (!shrink)
+          newActiveSet.push_back(t);
+      }
+
+      if (newActiveSet.size() >= 2)
+        activeSet.swap(newActiveSet);
+    }
+  }
+
+  ExtractModel(data, y, alpha, gradient);
+
+  Timer::Stop("kernel_svm_training");
+
+  // The dual objective at the solution, using Q alpha = gradient + e:
+  // 0.5 * alpha' Q alpha - e' alpha = 0.5 * alpha' (gradient - e).
+  const double objective = 0.5 * arma::dot(alpha, gradient -
+      arma::ones<arma::vec>(numPoints));
+  Log::Info << "KernelSVM::Train(): converged after " << iteration
+      << " iterations; " << supportVectors.n_cols << " support vectors; "
+      << "dual objective " << objective << "." << std::endl;
+
+  return objective;
+}
+
+template<typename KernelType>
+void KernelSVM<KernelType>::ExtractModel(const arma::mat& data,
+                                         const arma::vec& y,
+                                         const arma::vec& alpha,
+                                         const arma::vec& gradient)
+{
+  const double boundEps = 1e-12;
+
+  // The bias is the average of (y_t - u_t) over the free support vectors,
+  // where u_t is the unbiased decision value; -y_t * gradient_t equals
+  // exactly that quantity.  If no support vector is free, fall back to the
+  // midpoint of the feasible interval.
+  double biasSum = 0.0;
+  size_t freeCount = 0;
+  double maxUp = -DBL_MAX, minLow = DBL_MAX;
+  for (size_t t = 0; t < alpha.n_elem; ++t)
+  {
+    const double violation = -y[t] * gradient[t];
+    if (alpha[t] > boundEps && alpha[t] < c - boundEps)
+    {
+      biasSum += violation;
+      ++freeCount;
+    }
+
+    const bool inUp = (y[t] > 0.0) ? (alpha[t] < c - boundEps) :
+        (alpha[t] > boundEps);
+    const bool inLow = (y[t] > 0.0) ? (alpha[t] > boundEps) :
+        (alpha[t] < c - boundEps);
+    if (inUp)
+      maxUp = std::max(maxUp, violation);
+    if (inLow)
+      minLow = std::min(minLow, violation);
+  }
+
+  if (freeCount > 0)
+    bias = biasSum / freeCount;
+  else
+    bias = (maxUp + minLow) / 2.0;
+
+  // Gather the support vectors and their coefficients.
+  const arma::uvec indices = arma::find(alpha > boundEps);
+  supportVectors = data.cols(indices);
+  coefficients.set_size(indices.n_elem);
+  for (size_t i = 0; i < indices.n_elem; ++i)
+    coefficients[i] = alpha[indices[i]] * y[indices[i]];
+}
+
+template<typename KernelType>
+void KernelSVM<KernelType>::DecisionFunction(const arma::mat& test,
+                                             arma::rowvec& decisions) const
+{
+  decisions.set_size(test.n_cols);
+  decisions.fill(bias);
+  for (size_t i = 0; i < test.n_cols; ++i)
+    for (size_t s = 0; s < supportVectors.n_cols; ++s)
+      decisions[i] += coefficients[s] *
+          kernel.Evaluate(supportVectors.col(s), test.col(i));
+}
+
+template<typename KernelType>
+void KernelSVM<KernelType>::Classify(const arma::mat& test,
+                                     arma::Row<size_t>& predictedLabels) const
+{
+  arma::rowvec decisions;
+  DecisionFunction(test, decisions);
+
+  predictedLabels.set_size(test.n_cols);
+  for (size_t i = 0; i < test.n_cols; ++i)
+    predictedLabels[i] = (decisions[i] > 0.0) ? 1 : 0;
+}
+
+template<typename KernelType>
+template<typename Archive>
+void KernelSVM<KernelType>::serialize(Archive& ar,
+                                      const unsigned int /* version */)
+{
+  ar & BOOST_SERIALIZATION_NVP(supportVectors);
+  ar & BOOST_SERIALIZATION_NVP(coefficients);
+  ar & BOOST_SERIALIZATION_NVP(bias);
+  ar & BOOST_SERIALIZATION_NVP(c);
+  ar & BOOST_SERIALIZATION_NVP(kernel);
+  ar & BOOST_SERIALIZATION_NVP(cacheSize);
+  ar & BOOST_SERIALIZATION_NVP(tolerance);
+  ar & BOOST_SERIALIZATION_NVP(maxIterations);
+}
+
+} // namespace svm
+} // namespace mlpack
+
+#endif
@@ -0,0 +1,95 @@
+/**
+ * @file methods/kmeans/blocked_gemm_kmeans.hpp
+ *
+ * An implementation of a single step of the Lloyd algorithm for k-means
+ * clustering that computes all point-to-centroid distances with blocked
+ * matrix multiplication instead of per-point metric evaluations.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_KMEANS_BLOCKED_GEMM_KMEANS_HPP
+#define MLPACK_METHODS_KMEANS_BLOCKED_GEMM_KMEANS_HPP
+
+#include <mlpack/prereqs.hpp>
+#include <mlpack/core/metrics/lmetric.hpp>
+
+namespace mlpack {
+namespace kmeans {
+
+/**
+ * This is an implementation of a single iteration of Lloyd's algorithm for
+ * k-means that expands the squared Euclidean distance as
+ * ||x||^2 + ||c||^2 - 2 x.c and computes the cross terms for a whole block of
+ * points at once with a matrix multiplication.  This routes the dominant cost
+ * of the iteration through BLAS, which is typically several times faster than
+ * evaluating the metric point-by-point once the number of clusters is large
+ * (k >= 64 or so); for small k the simpler NaiveKMeans may still win.  The
+ * assignments and resulting centroids are identical to NaiveKMeans up to
+ * floating-point rounding.
+ *
+ * Because the expansion is specific to the (squared) Euclidean distance, this
+ * class only accepts EuclideanDistance or SquaredEuclideanDistance as the
+ * metric; both give the same assignments.  If your intention is to run the
+ * full k-means algorithm, use the mlpack::kmeans::KMeans class with this
+ * class as the LloydStepType policy.
+ *
+ * @param MetricType Type of metric; must be the (squared) Euclidean distance.
+ * @param MatType Matrix type (arma::mat or arma::sp_mat).
+ */
+template<typename MetricType, typename MatType>
+class BlockedGEMMKMeans
+{
+ public:
+  /**
+   * Construct the BlockedGEMMKMeans object with the given dataset and metric.
+   *
+   * @param dataset Dataset.
+   * @param metric Instantiated metric.
+   */
+  BlockedGEMMKMeans(const MatType& dataset, MetricType& metric);
+
+  /**
+   * Run a single iteration of the Lloyd algorithm, updating the given centroids
+   * into the newCentroids matrix.  If any cluster is empty (that is, if any
+   * cluster has no points assigned to it), then the centroid associated with
+   * that cluster may be filled with invalid data (it will be corrected later).
+   *
+   * @param centroids Current cluster centroids.
+   * @param newCentroids New cluster centroids.
+   * @param counts Number of points in each cluster at the end of the iteration.
+   */
+  double Iterate(const arma::mat& centroids,
+                 arma::mat& newCentroids,
+                 arma::Col<size_t>& counts);
+
+  size_t DistanceCalculations() const { return distanceCalculations; }
+
+ private:
+  //! The dataset.
+  const MatType& dataset;
+  //! The instantiated metric.
+  MetricType& metric;
+
+  //! Number of points handled by one matrix multiplication; a block of this
+  //! size keeps the k x blockSize distance tile in cache.
+  static const size_t blockSize = 1024;
+
+  //! Number of distance calculations.
+  size_t distanceCalculations;
+
+  static_assert(std::is_same<MetricType, metric::EuclideanDistance>::value ||
+      std::is_same<MetricType, metric::SquaredEuclideanDistance>::value,
+      "BlockedGEMMKMeans requires the (squared) Euclidean distance; use "
+      "NaiveKMeans for other metrics.");
+};
+
+} // namespace kmeans
+} // namespace mlpack
+
+// Include implementation.
+#include "blocked_gemm_kmeans_impl.hpp"
+
+#endif
@@ -0,0 +1,109 @@
+/**
+ * @file methods/kmeans/blocked_gemm_kmeans_impl.hpp
+ *
+ * An implementation of a single step of the Lloyd algorithm for k-means
+ * clustering that computes all point-to-centroid distances with blocked
+ * matrix multiplication instead of per-point metric evaluations.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_KMEANS_BLOCKED_GEMM_KMEANS_IMPL_HPP
+#define MLPACK_METHODS_KMEANS_BLOCKED_GEMM_KMEANS_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "blocked_gemm_kmeans.hpp"
+
+namespace mlpack {
+namespace kmeans {
+
+template<typename MetricType, typename MatType>
+BlockedGEMMKMeans<MetricType, MatType>::BlockedGEMMKMeans(
+    const MatType& dataset,
+    MetricType& metric) :
+    dataset(dataset),
+    metric(metric),
+    distanceCalculations(0)
+{ /* Nothing to do. */ }
+
+// Run a single iteration.
+template<typename MetricType, typename MatType>
+double BlockedGEMMKMeans<MetricType, MatType>::Iterate(
+    const arma::mat& centroids,
+    arma::mat& newCentroids,
+    arma::Col<size_t>& counts)
+{
+  newCentroids.zeros(centroids.n_rows, centroids.n_cols);
+  counts.zeros(centroids.n_cols);
+
+  // The point norms are constant across the argmin over centroids, so only
+  // the centroid norms and the cross terms are needed.
+  const arma::vec centroidNorms =
+      arma::sum(arma::square(centroids), 0).t();
+
+  const size_t numBlocks = (dataset.n_cols + blockSize - 1) / blockSize;
+
+  // Process the blocks in parallel; the accumulated centroid sums and counts
+  // are private to each thread and merged at the end.
+  #pragma omp parallel
+  {
+    arma::mat localCentroids(centroids.n_rows, centroids.n_cols,
+        arma::fill::zeros);
+    arma::Col<size_t> localCounts(centroids.n_cols, arma::fill::zeros);
+
+    #pragma omp for schedule(dynamic)
+    for (omp_size_t block = 0; block < (omp_size_t) numBlocks; ++block)
+    {
+      const size_t begin = block * blockSize;
+      const size_t end = std::min(begin + blockSize, (size_t) dataset.n_cols);
+
+      // One GEMM gives the cross terms for every (point, centroid) pair in
+      // the block; adding the centroid norms completes the distances up to
+      // the constant point norm.
+      arma::mat distances = (-2.0) *
+          (centroids.t() * dataset.cols(begin, end - 1));
+      distances.each_col() += centroidNorms;
+
+      for (size_t i = begin; i < end; ++i)
+      {
+        const arma::uword closestCluster = distances.col(i - begin)
+            .index_min();
+
+        localCentroids.unsafe_col(closestCluster) += dataset.col(i);
+        localCounts(closestCluster)++;
+      }
+    }
+
+    // Combine calculated state from each thread.
+    #pragma omp critical (blockedGEMMKMeansMerge)
+    {
+      newCentroids += localCentroids;
+      counts += localCounts;
+    }
+  }
+
+  // Now normalize the centroid.
+  for (size_t i = 0; i < centroids.n_cols; ++i)
+    if (counts(i) != 0)
+      newCentroids.col(i) /= counts(i);
+
+  distanceCalculations += centroids.n_cols * dataset.n_cols;
+
+  // Calculate cluster distortion for this iteration.
+  double cNorm = 0.0;
+  for (size_t i = 0; i < centroids.n_cols; ++i)
+  {
+    cNorm += std::pow(metric.Evaluate(centroids.col(i), newCentroids.col(i)),
+        2.0);
+  }
+  distanceCalculations += centroids.n_cols;
+
+  return std::sqrt(cNorm);
+}
+
+} // namespace kmeans
+} // namespace mlpack
+
+#endif
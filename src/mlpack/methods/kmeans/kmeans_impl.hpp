@@ -78,6 +78,50 @@ bool GetInitialAssignmentsOrCentroids(
   return false;
 }
 
+/**
+ * This gives us a SupportsScreening object that we can use to tell whether or
+ * not a LloydStepType maintains per-point assignment-stability bounds across
+ * iterations.
+ */
+HAS_MEM_FUNC(UpdateScreeningBounds, SupportsScreeningCheck);
+
+/**
+ * 'value' is true if the LloydStepType class has a member
+ * UpdateScreeningBounds(const arma::mat& oldCentroids,
+ *                       const arma::mat& newCentroids).
+ */
+template<typename LloydStepType>
+struct SupportsScreening
+{
+  static const bool value =
+    SupportsScreeningCheck<LloydStepType,
+        void(LloydStepType::*)(const arma::mat&, const arma::mat&)>::value;
+};
+
+//! Update the screening bounds of the Lloyd step, if it maintains any.
+template<typename LloydStepType>
+void UpdateScreeningBounds(
+    LloydStepType& lloydStep,
+    const arma::mat& oldCentroids,
+    const arma::mat& newCentroids,
+    const typename std::enable_if_t<
+        SupportsScreening<LloydStepType>::value>* = 0)
+{
+  lloydStep.UpdateScreeningBounds(oldCentroids, newCentroids);
+}
+
+//! Do nothing; the Lloyd step does not maintain screening bounds.
+template<typename LloydStepType>
+void UpdateScreeningBounds(
+    LloydStepType& /* lloydStep */,
+    const arma::mat& /* oldCentroids */,
+    const arma::mat& /* newCentroids */,
+    const typename std::enable_if_t<
+        !SupportsScreening<LloydStepType>::value>* = 0)
+{
+  // Nothing to do.
+}
+
 /**
  * Construct the K-Means object.
  */
@@ -236,6 +280,14 @@ Cluster(const MatType& data,
       }
     }
 
+    // If the Lloyd step maintains per-point screening bounds, update them with
+    // the centroid movements of this iteration.  This has to happen after the
+    // empty-cluster handling, since that may also move centroids.
+    if (iteration % 2 == 0)
+      UpdateScreeningBounds(lloydStep, centroids, centroidsOther);
+    else
+      UpdateScreeningBounds(lloydStep, centroidsOther, centroids);
+
     iteration++;
     Log::Info << "KMeans::Cluster(): iteration " << iteration << ", residual "
         << cNorm << ".\n";
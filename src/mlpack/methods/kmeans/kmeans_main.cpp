@@ -10,6 +10,7 @@
  * http://www.opensource.org/licenses/BSD-3-Clause for more information.
  */
 #include <mlpack/prereqs.hpp>
+#include <mlpack/core/data/assignment_writer.hpp>
 #include <mlpack/core/util/cli.hpp>
 #include <mlpack/core/util/mlpack_main.hpp>
 
@@ -17,8 +18,11 @@
 #include "allow_empty_clusters.hpp"
 #include "kill_empty_clusters.hpp"
 #include "refined_start.hpp"
+#include "parallel_seeding.hpp"
+#include "blocked_gemm_kmeans.hpp"
 #include "elkan_kmeans.hpp"
 #include "hamerly_kmeans.hpp"
+#include "mini_batch_kmeans.hpp"
 #include "pelleg_moore_kmeans.hpp"
 #include "dual_tree_kmeans.hpp"
 
@@ -49,14 +53,31 @@ PROGRAM_INFO("K-Means Clustering",
     "used in each sample, the " + PRINT_PARAM_STRING("percentage") +
     " parameter is used (it should be a value between 0.0 and 1.0)."
     "\n\n"
+    "Alternately, the k-means|| oversampling strategy (\"Scalable k-means++\", "
+    "Bahmani et al., 2012) can be used to select initial points by specifying "
+    "the " + PRINT_PARAM_STRING("parallel_seeding") + " parameter.  This "
+    "approach performs a fixed number of passes over the dataset, sampling a "
+    "set of candidate centroids proportionally to their distance to already-"
+    "chosen candidates, and parallelizes well; the number of passes is "
+    "specified with the " + PRINT_PARAM_STRING("seeding_rounds") + " parameter"
+    " and the expected number of candidates sampled per pass with the " +
+    PRINT_PARAM_STRING("oversampling") + " parameter (0 means twice the "
+    "number of clusters)."
+    "\n\n"
     "There are several options available for the algorithm used for each Lloyd "
     "iteration, specified with the " + PRINT_PARAM_STRING("algorithm") + " "
     " option.  The standard O(kN) approach can be used ('naive').  Other "
     "options include the Pelleg-Moore tree-based algorithm ('pelleg-moore'), "
     "Elkan's triangle-inequality based algorithm ('elkan'), Hamerly's "
     "modification to Elkan's algorithm ('hamerly'), the dual-tree k-means "
-    "algorithm ('dualtree'), and the dual-tree k-means algorithm using the "
-    "cover tree ('dualtree-covertree')."
+    "algorithm ('dualtree'), the dual-tree k-means algorithm using the "
+    "cover tree ('dualtree-covertree'), and a variant of the standard "
+    "approach that computes all distances with blocked matrix multiplication "
+    "('blocked-gemm'), which is often much faster for large numbers of "
+    "clusters.  The approximate mini-batch algorithm ('minibatch') samples a "
+    "batch of points per iteration instead of making a full pass, which can "
+    "converge in a small fraction of the time of the exact algorithms on very "
+    "large datasets."
     "\n\n"
     "The behavior for when an empty cluster is encountered can be modified with"
     " the " + PRINT_PARAM_STRING("allow_empty_clusters") + " option.  When "
@@ -76,6 +97,11 @@ PROGRAM_INFO("K-Means Clustering",
     "number of iterations may be specified with the " +
     PRINT_PARAM_STRING("max_iterations") + " parameter."
     "\n\n"
+    "For very large datasets, the " + PRINT_PARAM_STRING("streaming_output") +
+    " parameter streams the cluster assignments to a file chunk-wise (one "
+    "assignment per line) instead of materializing them as a full output "
+    "matrix, keeping result memory constant."
+    "\n\n"
     "As an example, to use Hamerly's algorithm to perform k-means clustering "
     "with k=10 on the dataset " + PRINT_DATASET("data") + ", saving the "
     "centroids to " + PRINT_DATASET("centroids") + " and the assignments for "
@@ -120,6 +146,10 @@ PARAM_MATRIX_OUT("output", "Matrix to store output labels or labeled data to.",
     "o");
 PARAM_MATRIX_OUT("centroid", "If specified, the centroids of each cluster will "
     " be written to the given file.", "C");
+PARAM_STRING_IN("streaming_output", "If specified, cluster assignments are "
+    "streamed to this file chunk-wise (one assignment per line) instead of "
+    "being materialized as a full output matrix, so result memory stays "
+    "constant regardless of the number of points.", "u", "");
 
 // k-means configuration options.
 PARAM_FLAG("allow_empty_clusters", "Allow empty clusters to be persist.", "e");
@@ -140,9 +170,18 @@ PARAM_INT_IN("samplings", "Number of samplings to perform for refined start "
 PARAM_DOUBLE_IN("percentage", "Percentage of dataset to use for each refined "
     "start sampling (use when --refined_start is specified).", "p", 0.02);
 
+// Parameters for k-means|| ("parallel seeding") initialization.
+PARAM_FLAG("parallel_seeding", "Use the k-means|| oversampling strategy by "
+    "Bahmani et al. to choose initial points.", "q");
+PARAM_INT_IN("seeding_rounds", "Number of sampling passes to perform for "
+    "parallel seeding (use when --parallel_seeding is specified).", "R", 5);
+PARAM_DOUBLE_IN("oversampling", "Expected number of candidate centroids to "
+    "sample in each parallel seeding pass; 0 means twice the number of "
+    "clusters (use when --parallel_seeding is specified).", "O", 0.0);
+
 PARAM_STRING_IN("algorithm", "Algorithm to use for the Lloyd iteration "
-    "('naive', 'pelleg-moore', 'elkan', 'hamerly', 'dualtree', or "
-    "'dualtree-covertree').", "a", "naive");
+    "('naive', 'blocked-gemm', 'minibatch', 'pelleg-moore', 'elkan', "
+    "'hamerly', 'dualtree', or 'dualtree-covertree').", "a", "naive");
 
 // Given the type of initial partition policy, figure out the empty cluster
 // policy and run k-means.
@@ -171,6 +210,7 @@ static void mlpackMain()
   // Now, start building the KMeans type that we'll be using.  Start with the
   // initial partition policy.  The call to FindEmptyClusterPolicy<> results in
   // a call to RunKMeans<> and the algorithm is completed.
+  ReportIgnoredParam({{ "refined_start", true }}, "parallel_seeding");
   if (CLI::HasParam("refined_start"))
   {
     RequireParamValue<int>("samplings", [](int x) { return x > 0; }, true,
@@ -183,6 +223,19 @@ static void mlpackMain()
 
     FindEmptyClusterPolicy<RefinedStart>(RefinedStart(samplings, percentage));
   }
+  else if (CLI::HasParam("parallel_seeding"))
+  {
+    RequireParamValue<int>("seeding_rounds", [](int x) { return x > 0; }, true,
+        "number of seeding rounds must be positive");
+    const int rounds = CLI::GetParam<int>("seeding_rounds");
+    RequireParamValue<double>("oversampling",
+        [](double x) { return x >= 0.0; }, true, "oversampling factor must be "
+        "non-negative");
+    const double oversampling = CLI::GetParam<double>("oversampling");
+
+    FindEmptyClusterPolicy<ParallelSeeding>(ParallelSeeding((size_t) rounds,
+        oversampling));
+  }
   else
   {
     FindEmptyClusterPolicy<SampleInitialization>(SampleInitialization());
@@ -213,8 +266,8 @@ template<typename InitialPartitionPolicy, typename EmptyClusterPolicy>
 void FindLloydStepType(const InitialPartitionPolicy& ipp)
 {
   RequireParamInSet<string>("algorithm", { "elkan", "hamerly", "pelleg-moore",
-      "dualtree", "dualtree-covertree", "naive" }, true, "unknown k-means "
-      "algorithm");
+      "dualtree", "dualtree-covertree", "naive", "blocked-gemm", "minibatch" },
+      true, "unknown k-means algorithm");
 
   const string algorithm = CLI::GetParam<string>("algorithm");
   if (algorithm == "elkan")
@@ -232,6 +285,12 @@ void FindLloydStepType(const InitialPartitionPolicy& ipp)
         CoverTreeDualTreeKMeans>(ipp);
   else if (algorithm == "naive")
     RunKMeans<InitialPartitionPolicy, EmptyClusterPolicy, NaiveKMeans>(ipp);
+  else if (algorithm == "blocked-gemm")
+    RunKMeans<InitialPartitionPolicy, EmptyClusterPolicy,
+        BlockedGEMMKMeans>(ipp);
+  else if (algorithm == "minibatch")
+    RunKMeans<InitialPartitionPolicy, EmptyClusterPolicy,
+        MiniBatchKMeans>(ipp);
 }
 
 // Given the template parameters, sanitize/load input and run k-means.
@@ -263,8 +322,8 @@ void RunKMeans(const InitialPartitionPolicy& ipp)
   const int maxIterations = CLI::GetParam<int>("max_iterations");
 
   // Make sure we have an output file if we're not doing the work in-place.
-  RequireAtLeastOnePassed({ "in_place", "output", "centroid" }, false,
-      "no results will be saved");
+  RequireAtLeastOnePassed({ "in_place", "output", "centroid",
+      "streaming_output" }, false, "no results will be saved");
 
   arma::mat dataset = CLI::GetParam<arma::mat>("input");  // Load our dataset.
   arma::mat centroids;
@@ -297,6 +356,15 @@ void RunKMeans(const InitialPartitionPolicy& ipp)
         false, initialCentroidGuess);
     Timer::Stop("clustering");
 
+    // Stream the assignments out chunk-wise if the user asked for it; this
+    // happens before the output handling below moves the dataset away.
+    if (CLI::HasParam("streaming_output"))
+    {
+      data::AssignmentWriter writer(
+          CLI::GetParam<string>("streaming_output"));
+      writer.Write(assignments);
+    }
+
     // Now figure out what to do with our results.
     if (CLI::HasParam("in_place"))
     {
@@ -337,9 +405,35 @@ void RunKMeans(const InitialPartitionPolicy& ipp)
   }
   else
   {
-    // Just save the centroids.
+    // Just compute the centroids; the dense assignments row is never
+    // materialized.
     kmeans.Cluster(dataset, clusters, centroids, initialCentroidGuess);
     Timer::Stop("clustering");
+
+    // If the user wants streamed assignments, make one block-wise pass over
+    // the dataset, assigning each block to its nearest centroids and flushing
+    // the results, so only one block of distances is in memory at a time.
+    if (CLI::HasParam("streaming_output"))
+    {
+      Timer::Start("streaming_assignments");
+      data::AssignmentWriter writer(
+          CLI::GetParam<string>("streaming_output"));
+
+      metric::SquaredEuclideanDistance metric;
+      const size_t blockSize = 4096;
+      arma::mat blockDistances;
+      for (size_t begin = 0; begin < dataset.n_cols; begin += blockSize)
+      {
+        const size_t end =
+            std::min(begin + blockSize, (size_t) dataset.n_cols) - 1;
+        metric::PairwiseDistances(dataset.cols(begin, end), centroids,
+            blockDistances, metric);
+
+        for (size_t i = 0; i < blockDistances.n_rows; ++i)
+          writer.Write((size_t) blockDistances.row(i).index_min());
+      }
+      Timer::Stop("streaming_assignments");
+    }
   }
 
   // Should we write the centroids to a file?
@@ -0,0 +1,133 @@
+/**
+ * @file methods/kmeans/mini_batch_kmeans.hpp
+ *
+ * An implementation of mini-batch k-means: each Lloyd step samples a batch of
+ * points and moves only the affected centroids, with a per-centroid learning
+ * rate that decays as the centroid accumulates points.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_KMEANS_MINI_BATCH_KMEANS_HPP
+#define MLPACK_METHODS_KMEANS_MINI_BATCH_KMEANS_HPP
+
+#include <mlpack/prereqs.hpp>
+
+namespace mlpack {
+namespace kmeans {
+
+/**
+ * This is an implementation of a single iteration of the mini-batch k-means
+ * algorithm of Sculley (2010).  Instead of a full pass over the dataset, each
+ * iteration samples a batch of points, assigns them to their nearest
+ * centroids, and moves each assigned centroid towards the mean of its batch
+ * points with a learning rate of 1 / (number of points the centroid has ever
+ * been assigned).  The per-centroid learning rate decays automatically as a
+ * centroid accumulates points, so the centroids settle and the residual
+ * reported to KMeans shrinks towards its convergence tolerance.
+ *
+ * Centroids that go unassigned for many consecutive batches ("dead" centers)
+ * are reseeded to a randomly chosen point of the dataset, so a bad initial
+ * centroid does not stay useless forever.
+ *
+ * The result is an approximation of full-batch Lloyd iterations: each
+ * iteration costs O(batchSize * k) distances instead of O(n * k), which is
+ * the difference between minutes and hours on datasets whose size makes even
+ * one full-batch pass expensive.  The counts reported to KMeans are the
+ * cumulative per-centroid assignment counts, not per-batch counts, so the
+ * empty cluster policy only acts on centroids that have never received any
+ * point.  If your intention is to run the full k-means algorithm, use the
+ * mlpack::kmeans::KMeans class with this class as the LloydStepType policy.
+ *
+ * For more information, see the following.
+ *
+ * @code
+ * @inproceedings{sculley2010web,
+ *   title={Web-scale k-means clustering},
+ *   author={Sculley, David},
+ *   booktitle={Proceedings of the 19th International Conference on World
+ *       Wide Web (WWW 2010)},
+ *   pages={1177--1178},
+ *   year={2010}
+ * }
+ * @endcode
+ *
+ * @param MetricType Type of metric used with this implementation.
+ * @param MatType Matrix type (arma::mat or arma::sp_mat).
+ */
+template<typename MetricType, typename MatType>
+class MiniBatchKMeans
+{
+ public:
+  /**
+   * Construct the MiniBatchKMeans object with the given dataset and metric.
+   *
+   * @param dataset Dataset.
+   * @param metric Instantiated metric.
+   * @param batchSize Number of points to sample per iteration (clamped to the
+   *      size of the dataset).
+   * @param deadBatchLimit Number of consecutive batches a centroid may go
+   *      unassigned before it is reseeded to a random point.
+   */
+  MiniBatchKMeans(const MatType& dataset,
+                  MetricType& metric,
+                  const size_t batchSize = 1000,
+                  const size_t deadBatchLimit = 50);
+
+  /**
+   * Run a single iteration of mini-batch k-means, updating the given
+   * centroids into the newCentroids matrix.  Only the centroids that batch
+   * points were assigned to move; all others are copied unchanged.
+   *
+   * @param centroids Current cluster centroids.
+   * @param newCentroids New cluster centroids.
+   * @param counts Cumulative number of points assigned to each cluster over
+   *      all iterations so far.
+   */
+  double Iterate(const arma::mat& centroids,
+                 arma::mat& newCentroids,
+                 arma::Col<size_t>& counts);
+
+  size_t DistanceCalculations() const { return distanceCalculations; }
+
+  //! Get the batch size.
+  size_t BatchSize() const { return batchSize; }
+  //! Modify the batch size.
+  size_t& BatchSize() { return batchSize; }
+
+  //! Get the number of unassigned batches after which a centroid is reseeded.
+  size_t DeadBatchLimit() const { return deadBatchLimit; }
+  //! Modify the number of unassigned batches after which a centroid is
+  //! reseeded.
+  size_t& DeadBatchLimit() { return deadBatchLimit; }
+
+ private:
+  //! The dataset.
+  const MatType& dataset;
+  //! The instantiated metric.
+  MetricType& metric;
+
+  //! Number of points sampled per iteration.
+  size_t batchSize;
+  //! Number of consecutive unassigned batches before a centroid is reseeded.
+  size_t deadBatchLimit;
+
+  //! Cumulative number of points assigned to each centroid; the learning rate
+  //! of a centroid is the reciprocal of its count.
+  arma::Col<size_t> clusterCounts;
+  //! Number of consecutive batches each centroid has gone unassigned.
+  arma::Col<size_t> staleBatches;
+
+  //! Number of distance calculations.
+  size_t distanceCalculations;
+};
+
+} // namespace kmeans
+} // namespace mlpack
+
+// Include implementation.
+#include "mini_batch_kmeans_impl.hpp"
+
+#endif
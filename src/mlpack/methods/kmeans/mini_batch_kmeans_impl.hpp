@@ -0,0 +1,135 @@
+/**
+ * @file methods/kmeans/mini_batch_kmeans_impl.hpp
+ *
+ * An implementation of mini-batch k-means: each Lloyd step samples a batch of
+ * points and moves only the affected centroids, with a per-centroid learning
+ * rate that decays as the centroid accumulates points.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_KMEANS_MINI_BATCH_KMEANS_IMPL_HPP
+#define MLPACK_METHODS_KMEANS_MINI_BATCH_KMEANS_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "mini_batch_kmeans.hpp"
+
+namespace mlpack {
+namespace kmeans {
+
+template<typename MetricType, typename MatType>
+MiniBatchKMeans<MetricType, MatType>::MiniBatchKMeans(
+    const MatType& dataset,
+    MetricType& metric,
+    const size_t batchSize,
+    const size_t deadBatchLimit) :
+    dataset(dataset),
+    metric(metric),
+    batchSize(batchSize),
+    deadBatchLimit(deadBatchLimit),
+    distanceCalculations(0)
+{ /* Nothing to do. */ }
+
+// Run a single iteration.
+template<typename MetricType, typename MatType>
+double MiniBatchKMeans<MetricType, MatType>::Iterate(
+    const arma::mat& centroids,
+    arma::mat& newCentroids,
+    arma::Col<size_t>& counts)
+{
+  // Initialize the per-centroid state on the first iteration (or if the
+  // number of clusters has changed).
+  if (clusterCounts.n_elem != centroids.n_cols)
+  {
+    clusterCounts.zeros(centroids.n_cols);
+    staleBatches.zeros(centroids.n_cols);
+  }
+
+  // Centroids that receive no batch points stay where they are.
+  newCentroids = centroids;
+
+  // Sample the batch.
+  const size_t effectiveBatchSize = std::min(batchSize,
+      (size_t) dataset.n_cols);
+  arma::uvec batch;
+  math::ObtainDistinctSamples(0, dataset.n_cols, effectiveBatchSize, batch);
+
+  // Assign every batch point to its nearest centroid first; the updates below
+  // use these cached assignments, so the order of the updates does not affect
+  // the assignments (Sculley 2010, Algorithm 1).
+  arma::uvec assignments(batch.n_elem);
+  for (size_t i = 0; i < batch.n_elem; ++i)
+  {
+    double minDistance = std::numeric_limits<double>::infinity();
+    size_t closestCluster = centroids.n_cols; // Invalid value.
+
+    for (size_t j = 0; j < centroids.n_cols; ++j)
+    {
+      const double distance = metric.Evaluate(dataset.col(batch[i]),
+          centroids.unsafe_col(j));
+      if (distance < minDistance)
+      {
+        minDistance = distance;
+        closestCluster = j;
+      }
+    }
+
+    Log::Assert(closestCluster != centroids.n_cols);
+    assignments[i] = closestCluster;
+  }
+
+  distanceCalculations += batch.n_elem * centroids.n_cols;
+
+  // Every centroid ages by one batch; the ones assigned below are reset.
+  staleBatches += 1;
+
+  // Apply the updates: move each assigned centroid towards its point with a
+  // learning rate that decays as the centroid accumulates points.
+  for (size_t i = 0; i < batch.n_elem; ++i)
+  {
+    const size_t cluster = assignments[i];
+    clusterCounts(cluster)++;
+    const double eta = 1.0 / (double) clusterCounts(cluster);
+
+    newCentroids.col(cluster) = (1.0 - eta) * newCentroids.col(cluster) +
+        eta * arma::vec(dataset.col(batch[i]));
+    staleBatches(cluster) = 0;
+  }
+
+  // Reseed centroids that have gone unassigned for too many batches; a dead
+  // centroid would otherwise never move again.
+  for (size_t i = 0; i < centroids.n_cols; ++i)
+  {
+    if (clusterCounts(i) > 0 && staleBatches(i) > deadBatchLimit)
+    {
+      const size_t point = (size_t) math::RandInt(dataset.n_cols);
+      newCentroids.col(i) = arma::vec(dataset.col(point));
+
+      // Let the reseeded centroid adapt quickly again.
+      clusterCounts(i) = 1;
+      staleBatches(i) = 0;
+    }
+  }
+
+  // Report the cumulative counts, so that the empty cluster policy only acts
+  // on centroids that have never received a point.
+  counts = clusterCounts;
+
+  // Calculate how far the centroids moved in this iteration.
+  double cNorm = 0.0;
+  for (size_t i = 0; i < centroids.n_cols; ++i)
+  {
+    cNorm += std::pow(metric.Evaluate(centroids.col(i), newCentroids.col(i)),
+        2.0);
+  }
+  distanceCalculations += centroids.n_cols;
+
+  return std::sqrt(cNorm);
+}
+
+} // namespace kmeans
+} // namespace mlpack
+
+#endif
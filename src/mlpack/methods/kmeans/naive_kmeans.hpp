@@ -15,6 +15,7 @@
 #ifndef MLPACK_METHODS_KMEANS_NAIVE_KMEANS_HPP
 #define MLPACK_METHODS_KMEANS_NAIVE_KMEANS_HPP
 #include <mlpack/prereqs.hpp>
+#include <mlpack/core/metrics/pairwise_distances.hpp>
 
 namespace mlpack {
 namespace kmeans {
@@ -25,6 +26,15 @@ namespace kmeans {
  * looking for the mlpack::kmeans::KMeans class instead of this one.  This class
  * is used by KMeans as the actual implementation of the Lloyd iteration.
  *
+ * Between iterations, per-point screening bounds are maintained in the style
+ * of Hamerly: an upper bound on the distance of each point to its assigned
+ * centroid and a lower bound on its distance to every other centroid.  When
+ * the driver keeps the bounds up to date via UpdateScreeningBounds(), points
+ * whose assignment provably cannot change are skipped without any distance
+ * computation, which removes most of the work in the long convergence tail
+ * where few points still move.  The screening relies on the triangle
+ * inequality, as ElkanKMeans and HamerlyKMeans do.
+ *
  * @param MetricType Type of metric used with this implementation.
  * @param MatType Matrix type (arma::mat or arma::sp_mat).
  */
@@ -54,6 +64,55 @@ class NaiveKMeans
                  arma::mat& newCentroids,
                  arma::Col<size_t>& counts);
 
+  /**
+   * Run the assignment pass of one Lloyd iteration, but leave the result as
+   * unnormalized sufficient statistics: the per-cluster sums of the assigned
+   * points and the per-cluster counts.  This is the per-worker step of
+   * data-parallel k-means: each worker holds a column shard of the dataset
+   * (see data::ShardColumns()), computes its shard's statistics, the sums and
+   * counts are reduced across workers by element-wise addition, and every
+   * worker obtains the identical new centroids from NormalizeStatistics().
+   *
+   * Iterate() is exactly IterateStatistics() followed by
+   * NormalizeStatistics() on this worker's own statistics.
+   *
+   * @param centroids Current cluster centroids.
+   * @param sums Per-cluster sums of assigned points (unnormalized centroids).
+   * @param counts Number of points assigned to each cluster.
+   */
+  void IterateStatistics(const arma::mat& centroids,
+                         arma::mat& sums,
+                         arma::Col<size_t>& counts);
+
+  /**
+   * Turn (possibly reduced) sufficient statistics into new centroids,
+   * normalizing the sums by the counts in place, and return the residual
+   * (the norm of the centroid movement) with respect to the given old
+   * centroids.  Clusters with no points are left untouched for the driver's
+   * empty-cluster handling, as in Iterate().
+   *
+   * @param centroids Centroids that produced the statistics.
+   * @param sums Per-cluster sums; overwritten with the new centroids.
+   * @param counts Number of points assigned to each cluster.
+   * @return Norm of the centroid movement.
+   */
+  double NormalizeStatistics(const arma::mat& centroids,
+                             arma::mat& sums,
+                             const arma::Col<size_t>& counts);
+
+  /**
+   * Update the per-point screening bounds with the centroid movements of the
+   * last iteration.  This must be called with the centroids that were passed
+   * to the last Iterate() call and the centroids that will be passed to the
+   * next one (that is, after any empty-cluster handling has modified them);
+   * if it is not called, the next Iterate() call falls back to a full pass.
+   *
+   * @param oldCentroids Centroids used by the last Iterate() call.
+   * @param newCentroids Centroids that the next Iterate() call will use.
+   */
+  void UpdateScreeningBounds(const arma::mat& oldCentroids,
+                             const arma::mat& newCentroids);
+
   size_t DistanceCalculations() const { return distanceCalculations; }
 
  private:
@@ -62,6 +121,15 @@ class NaiveKMeans
   //! The instantiated metric.
   MetricType& metric;
 
+  //! Current assignment of each point, valid after the first iteration.
+  arma::Row<size_t> assignments;
+  //! Upper bound on the distance of each point to its assigned centroid.
+  arma::vec upperBounds;
+  //! Lower bound on the distance of each point to every other centroid.
+  arma::vec lowerBounds;
+  //! Whether the bounds account for the movements of the last iteration.
+  bool boundsUpdated;
+
   //! Number of distance calculations.
   size_t distanceCalculations;
 };
@@ -18,6 +18,7 @@
 
 // In case it hasn't been included yet.
 #include "naive_kmeans.hpp"
+#include <mlpack/core/util/parallelism.hpp>
 
 namespace mlpack {
 namespace kmeans {
@@ -27,6 +28,7 @@ NaiveKMeans<MetricType, MatType>::NaiveKMeans(const MatType& dataset,
                                               MetricType& metric) :
     dataset(dataset),
     metric(metric),
+    boundsUpdated(false),
     distanceCalculations(0)
 { /* Nothing to do. */ }
 
@@ -35,39 +37,92 @@ template<typename MetricType, typename MatType>
 double NaiveKMeans<MetricType, MatType>::Iterate(const arma::mat& centroids,
                                                  arma::mat& newCentroids,
                                                  arma::Col<size_t>& counts)
+{
+  IterateStatistics(centroids, newCentroids, counts);
+  return NormalizeStatistics(centroids, newCentroids, counts);
+}
+
+// Run the assignment pass, leaving unnormalized sufficient statistics.
+template<typename MetricType, typename MatType>
+void NaiveKMeans<MetricType, MatType>::IterateStatistics(
+    const arma::mat& centroids,
+    arma::mat& newCentroids,
+    arma::Col<size_t>& counts)
 {
   newCentroids.zeros(centroids.n_rows, centroids.n_cols);
   counts.zeros(centroids.n_cols);
 
+  // Screening is only valid if the bounds were brought up to date with the
+  // centroid movements of the last iteration via UpdateScreeningBounds().
+  const bool screen = boundsUpdated && (assignments.n_elem == dataset.n_cols);
+  if (!screen)
+  {
+    assignments.set_size(dataset.n_cols);
+    upperBounds.set_size(dataset.n_cols);
+    lowerBounds.set_size(dataset.n_cols);
+  }
+
   // Find the closest centroid to each point and update the new centroids.
   // Computed in parallel over the complete dataset
-  #pragma omp parallel
+  #pragma omp parallel num_threads((int) Parallelism::Threads("kmeans"))
   {
     // The current state of the K-means is private for each thread
     arma::mat localCentroids(centroids.n_rows, centroids.n_cols,
         arma::fill::zeros);
     arma::Col<size_t> localCounts(centroids.n_cols, arma::fill::zeros);
+    size_t localDistanceCalculations = 0;
+    arma::vec centroidDistances;
 
-    #pragma omp for
+    // Static scheduling keeps each thread on the same contiguous column
+    // shard every iteration, which pairs with data::FirstTouchPlacement() on
+    // NUMA machines.
+    #pragma omp for schedule(static)
     for (omp_size_t i = 0; i < (omp_size_t) dataset.n_cols; ++i)
     {
-      // Find the closest centroid to this point.
+      // If the point is provably closer to its assigned centroid than to any
+      // other centroid, its assignment cannot change and no distances need to
+      // be computed ("sticky point").
+      if (screen && upperBounds[i] < lowerBounds[i])
+      {
+        localCentroids.unsafe_col(assignments[i]) += dataset.col(i);
+        localCounts(assignments[i])++;
+        continue;
+      }
+
+      // Find the closest centroid to this point, also keeping the distance to
+      // the second closest centroid for the screening bounds.
       double minDistance = std::numeric_limits<double>::infinity();
+      double secondDistance = std::numeric_limits<double>::infinity();
       size_t closestCluster = centroids.n_cols; // Invalid value.
 
+      // Compute the distances from this point to all centroids at once.
+      metric::PairwiseDistances(dataset.col(i), centroids, centroidDistances,
+          metric);
+
       for (size_t j = 0; j < centroids.n_cols; j++)
       {
-        const double distance = metric.Evaluate(dataset.col(i),
-            centroids.unsafe_col(j));
+        const double distance = centroidDistances[j];
         if (distance < minDistance)
         {
+          secondDistance = minDistance;
           minDistance = distance;
           closestCluster = j;
         }
+        else if (distance < secondDistance)
+        {
+          secondDistance = distance;
+        }
       }
+      localDistanceCalculations += centroids.n_cols;
 
       Log::Assert(closestCluster != centroids.n_cols);
 
+      // The bounds are exact for this point now; each point only writes its
+      // own entries, so no synchronization is needed.
+      assignments[i] = closestCluster;
+      upperBounds[i] = minDistance;
+      lowerBounds[i] = secondDistance;
+
       // We now have the minimum distance centroid index.  Update that centroid.
       localCentroids.unsafe_col(closestCluster) += dataset.col(i);
       localCounts(closestCluster)++;
@@ -77,28 +132,73 @@ double NaiveKMeans<MetricType, MatType>::Iterate(const arma::mat& centroids,
     {
       newCentroids += localCentroids;
       counts += localCounts;
+      distanceCalculations += localDistanceCalculations;
     }
   }
 
+  // The bounds now refer to the centroids that were just scanned; they are not
+  // valid for the next iteration until UpdateScreeningBounds() accounts for
+  // the centroid movements.
+  boundsUpdated = false;
+}
+
+// Normalize (possibly reduced) statistics into new centroids.
+template<typename MetricType, typename MatType>
+double NaiveKMeans<MetricType, MatType>::NormalizeStatistics(
+    const arma::mat& centroids,
+    arma::mat& sums,
+    const arma::Col<size_t>& counts)
+{
   // Now normalize the centroid.
   for (size_t i = 0; i < centroids.n_cols; ++i)
     if (counts(i) != 0)
-      newCentroids.col(i) /= counts(i);
-
-  distanceCalculations += centroids.n_cols * dataset.n_cols;
+      sums.col(i) /= counts(i);
 
   // Calculate cluster distortion for this iteration.
   double cNorm = 0.0;
   for (size_t i = 0; i < centroids.n_cols; ++i)
   {
-    cNorm += std::pow(metric.Evaluate(centroids.col(i), newCentroids.col(i)),
-        2.0);
+    cNorm += std::pow(metric.Evaluate(centroids.col(i), sums.col(i)), 2.0);
   }
   distanceCalculations += centroids.n_cols;
 
   return std::sqrt(cNorm);
 }
 
+// Adjust the screening bounds by the movement of each centroid.
+template<typename MetricType, typename MatType>
+void NaiveKMeans<MetricType, MatType>::UpdateScreeningBounds(
+    const arma::mat& oldCentroids,
+    const arma::mat& newCentroids)
+{
+  // If no full pass has happened yet, there is nothing to update.
+  if (assignments.n_elem != dataset.n_cols ||
+      oldCentroids.n_cols != newCentroids.n_cols)
+    return;
+
+  // Each point's upper bound grows by the movement of its own centroid, and
+  // its lower bound shrinks by the largest movement of any centroid.
+  arma::vec movements(oldCentroids.n_cols);
+  double maxMovement = 0.0;
+  for (size_t j = 0; j < oldCentroids.n_cols; ++j)
+  {
+    movements[j] = metric.Evaluate(oldCentroids.col(j), newCentroids.col(j));
+    if (movements[j] > maxMovement)
+      maxMovement = movements[j];
+  }
+  distanceCalculations += oldCentroids.n_cols;
+
+  #pragma omp parallel for schedule(static) \
+      num_threads((int) Parallelism::Threads("kmeans"))
+  for (omp_size_t i = 0; i < (omp_size_t) dataset.n_cols; ++i)
+  {
+    upperBounds[i] += movements[assignments[i]];
+    lowerBounds[i] -= maxMovement;
+  }
+
+  boundsUpdated = true;
+}
+
 } // namespace kmeans
 } // namespace mlpack
 
@@ -0,0 +1,127 @@
+/**
+ * @file methods/kmeans/parallel_seeding.hpp
+ * @author Ryan Curtin
+ *
+ * An implementation of the k-means|| initialization strategy.  This class is
+ * meant to provide better initial points for the k-means algorithm while
+ * remaining cheap to compute on multicore machines.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_KMEANS_PARALLEL_SEEDING_HPP
+#define MLPACK_METHODS_KMEANS_PARALLEL_SEEDING_HPP
+
+#include <mlpack/prereqs.hpp>
+#include <mlpack/core/math/random.hpp>
+#include <mlpack/core/metrics/lmetric.hpp>
+
+namespace mlpack {
+namespace kmeans {
+
+/**
+ * The k-means|| ("k-means parallel") approach for choosing initial points for
+ * k-means clustering.  Instead of picking centers one at a time like
+ * k-means++, this approach performs a constant number of passes over the full
+ * dataset; in each pass, every point is independently sampled as a candidate
+ * center with probability proportional to its squared distance to the current
+ * candidate set.  The oversampled candidate set (typically a small multiple of
+ * the number of clusters) is then weighted by the number of points each
+ * candidate is closest to, and reclustered with weighted k-means++ to obtain
+ * the final centroids.  Because each pass is a distance computation over the
+ * whole dataset, the expensive parts parallelize trivially with OpenMP, which
+ * makes this a much faster alternative to RefinedStart for large k.
+ *
+ * It is an implementation of the following paper:
+ *
+ * @code
+ * @article{bahmani2012scalable,
+ *   title={Scalable k-means++},
+ *   author={Bahmani, Bahman and Moseley, Benjamin and Vattani, Andrea and
+ *       Kumar, Ravi and Vassilvitskii, Sergei},
+ *   journal={Proceedings of the VLDB Endowment},
+ *   volume={5},
+ *   number={7},
+ *   pages={622--633},
+ *   year={2012}
+ * }
+ * @endcode
+ */
+class ParallelSeeding
+{
+ public:
+  /**
+   * Create the ParallelSeeding object, optionally specifying the number of
+   * sampling rounds to perform and the oversampling factor.
+   *
+   * @param rounds Number of passes over the dataset.
+   * @param oversampling Expected number of candidates sampled in each round;
+   *      if 0, twice the number of clusters will be used.
+   */
+  ParallelSeeding(const size_t rounds = 5,
+                  const double oversampling = 0.0) :
+      rounds(rounds), oversampling(oversampling) { }
+
+  /**
+   * Partition the given dataset into the given number of clusters according to
+   * the k-means|| oversampling scheme outlined in the paper of Bahmani et al.,
+   * and return centroids.
+   *
+   * @tparam MatType Type of data (arma::mat or arma::sp_mat).
+   * @param data Dataset to partition.
+   * @param clusters Number of clusters to split dataset into.
+   * @param centroids Matrix to store centroids into.
+   */
+  template<typename MatType>
+  void Cluster(const MatType& data,
+               const size_t clusters,
+               arma::mat& centroids) const;
+
+  //! Get the number of sampling rounds that will be performed.
+  size_t Rounds() const { return rounds; }
+  //! Modify the number of sampling rounds that will be performed.
+  size_t& Rounds() { return rounds; }
+
+  //! Get the oversampling factor (0 means twice the number of clusters).
+  double Oversampling() const { return oversampling; }
+  //! Modify the oversampling factor (0 means twice the number of clusters).
+  double& Oversampling() { return oversampling; }
+
+  //! Serialize the object.
+  template<typename Archive>
+  void serialize(Archive& ar, const unsigned int /* version */)
+  {
+    ar & BOOST_SERIALIZATION_NVP(rounds);
+    ar & BOOST_SERIALIZATION_NVP(oversampling);
+  }
+
+ private:
+  /**
+   * Recluster the weighted candidate set into the given number of centroids
+   * using weighted k-means++ selection.
+   *
+   * @param candidates Candidate centers (one per column).
+   * @param weights Number of points closest to each candidate.
+   * @param clusters Number of centroids to select.
+   * @param centroids Matrix to store centroids into.
+   */
+  static void SelectCentroids(const arma::mat& candidates,
+                              const arma::vec& weights,
+                              const size_t clusters,
+                              arma::mat& centroids);
+
+  //! The number of passes over the dataset.
+  size_t rounds;
+  //! The expected number of candidates sampled per round (0 means 2k).
+  double oversampling;
+};
+
+} // namespace kmeans
+} // namespace mlpack
+
+// Include implementation.
+#include "parallel_seeding_impl.hpp"
+
+#endif
@@ -0,0 +1,170 @@
+/**
+ * @file methods/kmeans/parallel_seeding_impl.hpp
+ * @author Ryan Curtin
+ *
+ * An implementation of the k-means|| initialization strategy.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_KMEANS_PARALLEL_SEEDING_IMPL_HPP
+#define MLPACK_METHODS_KMEANS_PARALLEL_SEEDING_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "parallel_seeding.hpp"
+
+namespace mlpack {
+namespace kmeans {
+
+//! Perform k-means|| oversampling and return centroids.
+template<typename MatType>
+void ParallelSeeding::Cluster(const MatType& data,
+                              const size_t clusters,
+                              arma::mat& centroids) const
+{
+  const double l = (oversampling > 0.0) ? oversampling : 2.0 * clusters;
+
+  // Candidate centers, starting from one uniformly random point.
+  std::vector<size_t> candidates;
+  candidates.push_back((size_t) math::RandInt(0, (int) data.n_cols));
+
+  // distances(i) holds the squared distance of point i to its closest
+  // candidate; closest(i) holds the index (into the candidate list) of that
+  // candidate.
+  arma::vec distances(data.n_cols);
+  arma::Col<size_t> closest(data.n_cols, arma::fill::zeros);
+  #pragma omp parallel for
+  for (omp_size_t i = 0; i < (omp_size_t) data.n_cols; ++i)
+  {
+    distances[i] = metric::SquaredEuclideanDistance::Evaluate(data.col(i),
+        data.col(candidates[0]));
+  }
+
+  for (size_t r = 0; r < rounds; ++r)
+  {
+    const double cost = arma::accu(distances);
+    if (cost == 0.0)
+      break; // Every point coincides with some candidate already.
+
+    // Sample new candidates, each point independently with probability
+    // proportional to its squared distance to the current candidate set.  The
+    // sampling itself is done serially because the global random number
+    // generator is not thread-safe; the expensive part---updating the
+    // distances---is parallel.
+    const size_t oldSize = candidates.size();
+    for (size_t i = 0; i < data.n_cols; ++i)
+    {
+      if (math::Random() < l * distances[i] / cost)
+        candidates.push_back(i);
+    }
+
+    if (candidates.size() == oldSize)
+      continue; // No candidates were sampled this round.
+
+    // Update each point's closest candidate with the newly sampled ones.
+    #pragma omp parallel for
+    for (omp_size_t i = 0; i < (omp_size_t) data.n_cols; ++i)
+    {
+      for (size_t j = oldSize; j < candidates.size(); ++j)
+      {
+        const double dist = metric::SquaredEuclideanDistance::Evaluate(
+            data.col(i), data.col(candidates[j]));
+        if (dist < distances[i])
+        {
+          distances[i] = dist;
+          closest[i] = j;
+        }
+      }
+    }
+  }
+
+  // Weight each candidate by the number of points that are closest to it, and
+  // copy the candidates into a dense matrix (the dataset may be sparse).
+  arma::vec weights(candidates.size(), arma::fill::zeros);
+  for (size_t i = 0; i < data.n_cols; ++i)
+    weights[closest[i]] += 1.0;
+
+  arma::mat candidateSet(data.n_rows, candidates.size());
+  for (size_t i = 0; i < candidates.size(); ++i)
+    candidateSet.col(i) = arma::vec(data.col(candidates[i]));
+
+  // If oversampling did not produce enough candidates, use them all and fill
+  // the remaining centroids with uniformly random points.
+  if (candidates.size() <= clusters)
+  {
+    centroids.set_size(data.n_rows, clusters);
+    centroids.cols(0, candidates.size() - 1) = candidateSet;
+    for (size_t i = candidates.size(); i < clusters; ++i)
+    {
+      const size_t index = math::RandInt(0, (int) data.n_cols);
+      centroids.col(i) = arma::vec(data.col(index));
+    }
+    return;
+  }
+
+  // Recluster the weighted candidate set into the final centroids.
+  SelectCentroids(candidateSet, weights, clusters, centroids);
+}
+
+//! Weighted k-means++ selection over the candidate set.
+inline void ParallelSeeding::SelectCentroids(const arma::mat& candidates,
+                                             const arma::vec& weights,
+                                             const size_t clusters,
+                                             arma::mat& centroids)
+{
+  centroids.set_size(candidates.n_rows, clusters);
+
+  // Squared distance of each candidate to the closest selected centroid.
+  arma::vec candidateDistances(candidates.n_cols);
+  candidateDistances.fill(DBL_MAX);
+
+  // The first centroid is sampled with probability proportional to its weight.
+  arma::vec probabilities = weights;
+  for (size_t c = 0; c < clusters; ++c)
+  {
+    if (c > 0)
+    {
+      // Update candidate distances with the centroid chosen last iteration.
+      #pragma omp parallel for
+      for (omp_size_t i = 0; i < (omp_size_t) candidates.n_cols; ++i)
+      {
+        const double dist = metric::SquaredEuclideanDistance::Evaluate(
+            candidates.col(i), centroids.col(c - 1));
+        if (dist < candidateDistances[i])
+          candidateDistances[i] = dist;
+      }
+      probabilities = weights % candidateDistances;
+    }
+
+    const double total = arma::accu(probabilities);
+    size_t index = candidates.n_cols - 1;
+    if (total > 0.0)
+    {
+      double target = math::Random() * total;
+      for (size_t i = 0; i < candidates.n_cols; ++i)
+      {
+        target -= probabilities[i];
+        if (target <= 0.0)
+        {
+          index = i;
+          break;
+        }
+      }
+    }
+    else
+    {
+      // All remaining candidates coincide with selected centroids; fall back
+      // to a uniformly random candidate.
+      index = (size_t) math::RandInt(0, (int) candidates.n_cols);
+    }
+
+    centroids.col(c) = candidates.col(index);
+  }
+}
+
+} // namespace kmeans
+} // namespace mlpack
+
+#endif
@@ -26,7 +26,9 @@ LARS::LARS(const bool useCholesky,
     lambda1(lambda1),
     elasticNet((lambda1 != 0) && (lambda2 != 0)),
     lambda2(lambda2),
-    tolerance(tolerance)
+    tolerance(tolerance),
+    useCoordinateDescent(false),
+    maxIterations(1000)
 { /* Nothing left to do. */ }
 
 LARS::LARS(const bool useCholesky,
@@ -40,7 +42,9 @@ LARS::LARS(const bool useCholesky,
     lambda1(lambda1),
     elasticNet((lambda1 != 0) && (lambda2 != 0)),
     lambda2(lambda2),
-    tolerance(tolerance)
+    tolerance(tolerance),
+    useCoordinateDescent(false),
+    maxIterations(1000)
 { /* Nothing left to do */ }
 
 LARS::LARS(const arma::mat& data,
@@ -80,6 +84,8 @@ LARS::LARS(const LARS& other) :
     elasticNet(other.elasticNet),
     lambda2(other.lambda2),
     tolerance(other.tolerance),
+    useCoordinateDescent(other.useCoordinateDescent),
+    maxIterations(other.maxIterations),
     betaPath(other.betaPath),
     lambdaPath(other.lambdaPath),
     activeSet(other.activeSet),
@@ -102,6 +108,8 @@ LARS::LARS(LARS&& other) :
     elasticNet(other.elasticNet),
     lambda2(other.lambda2),
     tolerance(other.tolerance),
+    useCoordinateDescent(other.useCoordinateDescent),
+    maxIterations(other.maxIterations),
     betaPath(std::move(other.betaPath)),
     lambdaPath(std::move(other.lambdaPath)),
     activeSet(std::move(other.activeSet)),
@@ -128,6 +136,8 @@ LARS& LARS::operator=(const LARS& other)
   elasticNet = other.elasticNet;
   lambda2 = other.lambda2;
   tolerance = other.tolerance;
+  useCoordinateDescent = other.useCoordinateDescent;
+  maxIterations = other.maxIterations;
   betaPath = other.betaPath;
   lambdaPath = other.lambdaPath;
   activeSet = other.activeSet;
@@ -153,6 +163,8 @@ LARS& LARS::operator=(LARS&& other)
   elasticNet = other.elasticNet;
   lambda2 = other.lambda2;
   tolerance = other.tolerance;
+  useCoordinateDescent = other.useCoordinateDescent;
+  maxIterations = other.maxIterations;
   betaPath = std::move(other.betaPath);
   lambdaPath = std::move(other.lambdaPath);
   activeSet = std::move(other.activeSet);
@@ -185,6 +197,16 @@ double LARS::Train(const arma::mat& matX,
   if (transposeData)
     dataTrans = trans(matX);
 
+  // If requested, use the covariance-free coordinate descent solver; it never
+  // forms the Gram matrix, so it is preferred for very wide data.
+  if (useCoordinateDescent)
+  {
+    TrainCoordinateDescent(dataRef, trans(y), beta);
+
+    Timer::Stop("lars_regression");
+    return ComputeError(matX, y, !transposeData);
+  }
+
   // Compute X' * y.
   arma::vec vecXTy = trans(y * dataRef);
 
@@ -477,6 +499,138 @@ void LARS::Predict(const arma::mat& points,
     predictions = betaPath.back().t() * points;
 }
 
+void LARS::TrainCoordinateDescent(const arma::mat& dataRef,
+                                  const arma::vec& y,
+                                  arma::vec& beta)
+{
+  const size_t dims = dataRef.n_cols;
+
+  beta = arma::zeros(dims);
+  isActive.resize(dims, false);
+  isIgnored.resize(dims, false);
+
+  // The solver maintains only the residual of the current solution.
+  arma::vec r = y;
+
+  // Squared column norms, used as the per-coordinate curvature.
+  arma::vec colNorms(dims);
+  #pragma omp parallel for
+  for (omp_size_t j = 0; j < (omp_size_t) dims; ++j)
+    colNorms[j] = arma::dot(dataRef.col(j), dataRef.col(j));
+
+  // The path starts at the smallest lambda with an all-zero solution.
+  arma::vec corr = trans(dataRef) * r;
+  const double lambdaMax = arma::abs(corr).max();
+
+  betaPath.push_back(beta);
+  lambdaPath.push_back(std::max(lambdaMax, lambda1));
+
+  if (lambdaMax <= lambda1)
+    return; // All coefficients are zero at this regularization level.
+
+  // Geometric sequence of lambda values ending at lambda1; each solve is
+  // warm-started from the previous one.  If lambda1 is zero (no l1 penalty),
+  // the path still eases the solver down before the final unpenalized solve.
+  const size_t pathLength = 20;
+  const double lambdaMin = (lambda1 > 0.0) ? lambda1 : 1e-3 * lambdaMax;
+  std::vector<double> lambdas;
+  for (size_t k = 1; k <= pathLength; ++k)
+  {
+    lambdas.push_back(lambdaMax *
+        std::pow(lambdaMin / lambdaMax, (double) k / pathLength));
+  }
+  if (lambda1 == 0.0)
+    lambdas.push_back(0.0);
+
+  // Sweep convergence threshold, relative to the scale of the responses.
+  const double sweepTolerance = tolerance * std::max(arma::dot(y, y), 1.0);
+
+  double prevLambda = lambdaMax;
+  for (size_t k = 0; k < lambdas.size(); ++k)
+  {
+    const double lambda = lambdas[k];
+
+    // Sequential strong rule: restrict the solve to coordinates whose current
+    // correlation is at least 2 * lambda - prevLambda.  This screening is a
+    // heuristic, so the KKT check below catches any coordinate it wrongly
+    // discards.
+    corr = trans(dataRef) * r;
+    const double strongThreshold = 2.0 * lambda - prevLambda;
+    std::vector<size_t> working;
+    std::vector<bool> inWorking(dims, false);
+    for (size_t j = 0; j < dims; ++j)
+    {
+      if (beta[j] != 0.0 || std::abs(corr[j]) >= strongThreshold)
+      {
+        working.push_back(j);
+        inWorking[j] = true;
+      }
+    }
+
+    bool kktSatisfied = false;
+    while (!kktSatisfied)
+    {
+      // Cyclic coordinate descent over the working set.
+      for (size_t sweep = 0; sweep < maxIterations; ++sweep)
+      {
+        double maxChange = 0.0;
+        for (size_t i = 0; i < working.size(); ++i)
+        {
+          const size_t j = working[i];
+          if (colNorms[j] == 0.0)
+            continue;
+
+          // Partial residual correlation for coordinate j, followed by the
+          // soft-thresholding update.
+          const double betaOld = beta[j];
+          const double rho = arma::dot(dataRef.unsafe_col(j), r) +
+              colNorms[j] * betaOld;
+
+          double betaNew = 0.0;
+          if (rho > lambda)
+            betaNew = (rho - lambda) / (colNorms[j] + lambda2);
+          else if (rho < -lambda)
+            betaNew = (rho + lambda) / (colNorms[j] + lambda2);
+
+          if (betaNew != betaOld)
+          {
+            r += dataRef.unsafe_col(j) * (betaOld - betaNew);
+            beta[j] = betaNew;
+            maxChange = std::max(maxChange,
+                colNorms[j] * std::pow(betaNew - betaOld, 2));
+          }
+        }
+
+        if (maxChange <= sweepTolerance)
+          break;
+      }
+
+      // Check the KKT conditions on the screened-out coordinates; any
+      // violators join the working set and the solve repeats.
+      corr = trans(dataRef) * r;
+      kktSatisfied = true;
+      for (size_t j = 0; j < dims; ++j)
+      {
+        if (!inWorking[j] && std::abs(corr[j]) > lambda + 1e-12)
+        {
+          working.push_back(j);
+          inWorking[j] = true;
+          kktSatisfied = false;
+        }
+      }
+    }
+
+    prevLambda = lambda;
+    betaPath.push_back(beta);
+    lambdaPath.push_back(lambda);
+  }
+
+  // Record the active set of the final solution.
+  for (size_t j = 0; j < dims; ++j)
+    if (beta[j] != 0.0)
+      Activate(j);
+}
+
 // Private functions.
 void LARS::Deactivate(const size_t activeVarInd)
 {
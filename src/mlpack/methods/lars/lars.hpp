@@ -266,6 +266,18 @@ class LARS
   //! Access the upper triangular cholesky factor.
   const arma::mat& MatUtriCholFactor() const { return matUtriCholFactor; }
 
+  //! Whether the cyclic coordinate descent solver is used instead of LARS.
+  bool UseCoordinateDescent() const { return useCoordinateDescent; }
+  //! Modify whether the cyclic coordinate descent solver is used instead of
+  //! LARS.  The coordinate descent solver never forms the Gram matrix, so it
+  //! is the better choice for very wide (high-dimensional) data.
+  bool& UseCoordinateDescent() { return useCoordinateDescent; }
+
+  //! Get the maximum number of coordinate descent sweeps per lambda value.
+  size_t MaxIterations() const { return maxIterations; }
+  //! Modify the maximum number of coordinate descent sweeps per lambda value.
+  size_t& MaxIterations() { return maxIterations; }
+
   /**
    * Serialize the LARS model.
    */
@@ -314,6 +326,12 @@ class LARS
   //! Tolerance for main loop.
   double tolerance;
 
+  //! Whether to use the cyclic coordinate descent solver instead of LARS.
+  bool useCoordinateDescent;
+
+  //! Maximum number of coordinate descent sweeps per lambda value.
+  size_t maxIterations;
+
   //! Solution path.
   std::vector<arma::vec> betaPath;
 
@@ -372,6 +390,25 @@ class LARS
                     arma::mat& G);
 
   void CholeskyDelete(const size_t colToKill);
+
+  /**
+   * Solve the elastic net problem with cyclic coordinate descent instead of
+   * the LARS homotopy.  This solver is covariance-free: it maintains only the
+   * residual vector and never forms the Gram matrix, so it stays
+   * memory-feasible on very wide data.  A geometric sequence of lambda values
+   * from the smallest all-zero-solution lambda down to lambda1 is solved, each
+   * solve warm-started from the previous one, with the sequential strong rule
+   * used to screen coordinates (followed by a KKT check that catches any
+   * screening mistakes).  On completion betaPath, lambdaPath, and the active
+   * set hold the solutions along the path.
+   *
+   * @param dataRef Row-major data matrix (each column is a dimension).
+   * @param y Vector of responses.
+   * @param beta Vector to store the solution (the coefficients) in.
+   */
+  void TrainCoordinateDescent(const arma::mat& dataRef,
+                              const arma::vec& y,
+                              arma::vec& beta);
 };
 
 } // namespace regression
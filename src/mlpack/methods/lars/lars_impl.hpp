@@ -43,6 +43,8 @@ void LARS::serialize(Archive& ar, const unsigned int /* version */)
   ar & BOOST_SERIALIZATION_NVP(elasticNet);
   ar & BOOST_SERIALIZATION_NVP(lambda2);
   ar & BOOST_SERIALIZATION_NVP(tolerance);
+  ar & BOOST_SERIALIZATION_NVP(useCoordinateDescent);
+  ar & BOOST_SERIALIZATION_NVP(maxIterations);
   ar & BOOST_SERIALIZATION_NVP(betaPath);
   ar & BOOST_SERIALIZATION_NVP(lambdaPath);
   ar & BOOST_SERIALIZATION_NVP(activeSet);
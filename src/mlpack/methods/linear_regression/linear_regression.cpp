@@ -54,38 +54,120 @@ double LinearRegression::Train(const arma::mat& predictors,
    * In order to get the intercept value, we will add a row of ones.
    */
 
-  // We store the number of rows and columns of the predictors.
-  // Reminder: Armadillo stores the data transposed from how we think of it,
-  //           that is, columns are actually rows (see: column major order).
-  const size_t nCols = predictors.n_cols;
+  if (weights.n_elem > 0)
+  {
+    // We store the number of rows and columns of the predictors.
+    // Reminder: Armadillo stores the data transposed from how we think of it,
+    //           that is, columns are actually rows (see: column major order).
+    const size_t nCols = predictors.n_cols;
+
+    arma::mat p = predictors;
+    arma::rowvec r = responses;
+
+    // Here we add the row of ones to the predictors.
+    // The intercept is not penalized. Add an "all ones" row to design and set
+    // intercept = false to get a penalized intercept.
+    if (intercept)
+    {
+      p.insert_rows(0, arma::ones<arma::mat>(1, nCols));
+    }
 
-  arma::mat p = predictors;
-  arma::rowvec r = responses;
+    p = p * diagmat(sqrt(weights));
+    r = sqrt(weights) % responses;
 
-  // Here we add the row of ones to the predictors.
-  // The intercept is not penalized. Add an "all ones" row to design and set
-  // intercept = false to get a penalized intercept.
-  if (intercept)
+    // Convert to this form:
+    // a * (X X^T) = y X^T.
+    // Then we'll use Armadillo to solve it.
+    // The total runtime of this should be O(d^2 N) + O(d^3) + O(dN).
+    // (assuming the SVD is used to solve it)
+    arma::mat cov = p * p.t() +
+        lambda * arma::eye<arma::mat>(p.n_rows, p.n_rows);
+
+    parameters = arma::solve(cov, p * r.t());
+  }
+  else
   {
-    p.insert_rows(0, arma::ones<arma::mat>(1, nCols));
+    // In the unweighted case we can accumulate the normal equations in
+    // parallel chunks, which avoids copying the dataset and keeps the Gram
+    // matrix accumulation running at full memory bandwidth on tall data.
+    arma::mat xtx;
+    arma::vec xty;
+    AccumulateStatistics(predictors, responses, xtx, xty, intercept);
+    TrainFromStatistics(xtx, xty, intercept);
   }
 
-  if (weights.n_elem > 0)
+  return ComputeError(predictors, responses);
+}
+
+void LinearRegression::AccumulateStatistics(const arma::mat& predictors,
+                                            const arma::rowvec& responses,
+                                            arma::mat& xtx,
+                                            arma::vec& xty,
+                                            const bool intercept)
+{
+  const size_t dims = predictors.n_rows + (intercept ? 1 : 0);
+  if (xtx.n_rows != dims || xtx.n_cols != dims)
+    xtx.zeros(dims, dims);
+  if (xty.n_elem != dims)
+    xty.zeros(dims);
+
+  // One rank-k update per chunk of points; each thread accumulates into its
+  // own local statistics, which are merged when all chunks are done.
+  const size_t chunkSize = 8192;
+  const size_t numChunks = (predictors.n_cols + chunkSize - 1) / chunkSize;
+
+  #pragma omp parallel
   {
-    p = p * diagmat(sqrt(weights));
-    r = sqrt(weights) % responses;
+    arma::mat localXtx(dims, dims, arma::fill::zeros);
+    arma::vec localXty(dims, arma::fill::zeros);
+
+    #pragma omp for schedule(dynamic) nowait
+    for (omp_size_t chunk = 0; chunk < (omp_size_t) numChunks; ++chunk)
+    {
+      const size_t begin = chunk * chunkSize;
+      const size_t end = std::min(begin + chunkSize,
+          (size_t) predictors.n_cols) - 1;
+
+      if (intercept)
+      {
+        // Augment the chunk with the row of ones for the intercept term.
+        arma::mat p(dims, end - begin + 1);
+        p.row(0).ones();
+        p.rows(1, dims - 1) = predictors.cols(begin, end);
+
+        localXtx += p * p.t();
+        localXty += p * responses.subvec(begin, end).t();
+      }
+      else
+      {
+        localXtx += predictors.cols(begin, end) *
+            predictors.cols(begin, end).t();
+        localXty += predictors.cols(begin, end) *
+            responses.subvec(begin, end).t();
+      }
+    }
+
+    #pragma omp critical (linearRegressionStatistics)
+    {
+      xtx += localXtx;
+      xty += localXty;
+    }
   }
+}
 
-  // Convert to this form:
-  // a * (X X^T) = y X^T.
-  // Then we'll use Armadillo to solve it.
-  // The total runtime of this should be O(d^2 N) + O(d^3) + O(dN).
-  // (assuming the SVD is used to solve it)
-  arma::mat cov = p * p.t() +
-      lambda * arma::eye<arma::mat>(p.n_rows, p.n_rows);
+void LinearRegression::TrainFromStatistics(const arma::mat& xtx,
+                                           const arma::vec& xty,
+                                           const bool intercept)
+{
+  this->intercept = intercept;
 
-  parameters = arma::solve(cov, p * r.t());
-  return ComputeError(predictors, responses);
+  // Solve the (ridge-regularized) normal equations.  The Gram matrix is
+  // symmetric positive (semi-)definite, so the Cholesky-based solver is
+  // preferred; Armadillo falls back to a standard solver if the factorization
+  // fails.
+  arma::mat cov = xtx + lambda * arma::eye<arma::mat>(xtx.n_rows, xtx.n_rows);
+
+  parameters = arma::solve(cov, xty, arma::solve_opts::likely_sympd);
 }
 
 void LinearRegression::Predict(const arma::mat& points,
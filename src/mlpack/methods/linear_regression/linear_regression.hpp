@@ -95,6 +95,47 @@ class LinearRegression
                const arma::rowvec& weights,
                const bool intercept = true);
 
+  /**
+   * Accumulate the sufficient statistics of the normal equations---the Gram
+   * matrix X X^T and the moment vector X y^T---for the given data, adding to
+   * any statistics already held in xtx and xty (they are reset if their sizes
+   * do not match the data).  The data is processed in chunks of points, one
+   * rank-k update per chunk, and the chunks are distributed across threads
+   * when OpenMP is enabled.  Calling this repeatedly on successive pieces of a
+   * dataset and then calling TrainFromStatistics() performs out-of-core
+   * ordinary least squares.
+   *
+   * If intercept is true, the statistics are computed for the design matrix
+   * augmented with a row of ones, so xtx and xty have one more dimension than
+   * the data.
+   *
+   * @param predictors X, the matrix of data points.
+   * @param responses y, the responses to the data points.
+   * @param xtx Accumulated Gram matrix X X^T.
+   * @param xty Accumulated moment vector X y^T.
+   * @param intercept Whether or not an intercept term will be fit.
+   */
+  static void AccumulateStatistics(const arma::mat& predictors,
+                                   const arma::rowvec& responses,
+                                   arma::mat& xtx,
+                                   arma::vec& xty,
+                                   const bool intercept = true);
+
+  /**
+   * Train the LinearRegression model from precomputed sufficient statistics,
+   * as produced by AccumulateStatistics().  The ridge penalty lambda is added
+   * here, so xtx should be the plain (unregularized) Gram matrix.  Since no
+   * data is available, no training error can be computed; use ComputeError()
+   * if one is needed.
+   *
+   * @param xtx Gram matrix X X^T of the (augmented) design matrix.
+   * @param xty Moment vector X y^T.
+   * @param intercept Whether the statistics include an intercept row.
+   */
+  void TrainFromStatistics(const arma::mat& xtx,
+                           const arma::vec& xty,
+                           const bool intercept = true);
+
   /**
    * Calculate y_i for each data point in points.
    *
@@ -225,6 +225,12 @@ class LinearSVM
   /**
    * Train the Linear SVM with the given training data.
    *
+   * If the model has already been trained on data of the same dimensionality
+   * and number of classes, the optimization warm-starts from the current
+   * parameters instead of a fresh initial point; otherwise the parameters are
+   * reinitialized.  The convergence tolerance can be adjusted by configuring
+   * the given optimizer before passing it in.
+   *
    * @tparam OptimizerType Desired optimizer.
    * @tparam CallbackTypes Types of Callback Functions.
    * @param data Input training features. Each column associate with one sample.
@@ -258,6 +264,30 @@ class LinearSVM
                const size_t numClasses = 2,
                OptimizerType optimizer = OptimizerType());
 
+  /**
+   * Incrementally update an already-trained model using only the points that
+   * have changed since the last training run.  The optimization warm-starts
+   * from the current parameters and runs SGD over the given points, so a
+   * scheduled retrain on a small delta converges in a handful of epochs
+   * instead of from scratch.  The model must already have parameters of the
+   * size implied by the given data and number of classes, or a
+   * std::invalid_argument exception is thrown.
+   *
+   * @param data Changed or new training points.  Each column associate with
+   *     one sample.
+   * @param labels Labels associated with the feature data.
+   * @param numClasses Number of classes for classification.
+   * @param stepSize Step size of the SGD update.
+   * @param maxEpochs Maximum number of passes over the given points.
+   * @param tolerance Convergence tolerance of the optimization.
+   * @return Objective value of the final point on the given points.
+   */
+  double IncrementalTrain(const MatType& data,
+                          const arma::Row<size_t>& labels,
+                          const size_t numClasses = 2,
+                          const double stepSize = 0.01,
+                          const size_t maxEpochs = 50,
+                          const double tolerance = 1e-5);
 
   //! Sets the number of classes.
   size_t& NumClasses() { return numClasses; }
@@ -101,7 +101,10 @@ double LinearSVM<MatType>::Train(
 
   LinearSVMFunction<MatType> svm(data, labels, numClasses, lambda, delta,
       fitIntercept);
-  if (parameters.is_empty())
+  // Warm-start from the current parameters if they match the given problem;
+  // otherwise start the optimization from a fresh initial point.
+  if (parameters.n_rows != svm.InitialPoint().n_rows ||
+      parameters.n_cols != svm.InitialPoint().n_cols)
     parameters = svm.InitialPoint();
 
   // Train the model.
@@ -130,7 +133,10 @@ double LinearSVM<MatType>::Train(
 
   LinearSVMFunction<MatType> svm(data, labels, numClasses, lambda, delta,
       fitIntercept);
-  if (parameters.is_empty())
+  // Warm-start from the current parameters if they match the given problem;
+  // otherwise start the optimization from a fresh initial point.
+  if (parameters.n_rows != svm.InitialPoint().n_rows ||
+      parameters.n_cols != svm.InitialPoint().n_cols)
     parameters = svm.InitialPoint();
 
   // Train the model.
@@ -144,6 +150,52 @@ double LinearSVM<MatType>::Train(
   return out;
 }
 
+template <typename MatType>
+double LinearSVM<MatType>::IncrementalTrain(
+    const MatType& data,
+    const arma::Row<size_t>& labels,
+    const size_t numClasses,
+    const double stepSize,
+    const size_t maxEpochs,
+    const double tolerance)
+{
+  if (numClasses <= 1)
+  {
+    throw std::invalid_argument("LinearSVM dataset has 0 number of classes!");
+  }
+
+  // Incremental training only makes sense as an update of an existing model,
+  // so the current parameters must match the given problem.
+  const size_t expectedRows = data.n_rows + (fitIntercept ? 1 : 0);
+  if (parameters.n_rows != expectedRows || parameters.n_cols != numClasses)
+  {
+    std::ostringstream oss;
+    oss << "LinearSVM::IncrementalTrain(): model parameters have size "
+        << parameters.n_rows << "x" << parameters.n_cols << ", but the given "
+        << "data requires " << expectedRows << "x" << numClasses << "; train "
+        << "the model with Train() first!";
+    throw std::invalid_argument(oss.str());
+  }
+
+  LinearSVMFunction<MatType> svm(data, labels, numClasses, lambda, delta,
+      fitIntercept);
+
+  // A few SGD epochs over the changed points are enough when warm-starting
+  // from a previously trained model.
+  const size_t batchSize = std::min((size_t) 32, (size_t) data.n_cols);
+  ens::StandardSGD optimizer(stepSize, batchSize, maxEpochs * data.n_cols,
+      tolerance);
+
+  Timer::Start("linear_svm_incremental_optimization");
+  const double out = optimizer.Optimize(svm, parameters);
+  Timer::Stop("linear_svm_incremental_optimization");
+
+  Log::Info << "LinearSVM::IncrementalTrain(): final objective of updated "
+            << "model is " << out << "." << std::endl;
+
+  return out;
+}
+
 template <typename MatType>
 void LinearSVM<MatType>::Classify(
     const MatType& data,
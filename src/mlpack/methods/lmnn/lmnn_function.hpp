@@ -236,6 +236,16 @@ class LMNNFunction
   arma::uvec points;
   //! Flag for controlling use of bounds over impostors.
   bool impBounds;
+  //! Holds transformation matrix at the time of the last impostor search.
+  arma::mat transformationLastSearch;
+  /**
+  * Holds, for each point, the part of the margin between its last and second
+  * to last impostor which has not yet been used up by movement of the
+  * transformation since the impostors of that point were last searched. Only
+  * points whose slack has run out can have a flipped impostor and need to be
+  * re-searched.
+  */
+  arma::vec impostorSlack;
   /**
   * Precalculate the gradient part due to target neighbors and stores
   * the result as a matrix. Used for L-BFGS like optimizers which does not
@@ -251,6 +261,12 @@ class LMNNFunction
                         const arma::mat& transformation,
                         const size_t begin,
                         const size_t batchSize);
+  /**
+  * Re-initialize the impostor margin slack of every point from the current
+  * distance cache and remember the transformation it was computed with.
+  * Called after a full impostor search; a no-op if bounds are not in use.
+  */
+  inline void UpdateSearchCache(const arma::mat& transformation);
 };
 
 } // namespace lmnn
@@ -82,6 +82,8 @@ LMNNFunction<MetricType>::LMNNFunction(const arma::mat& dataset,
     targetNeighbors.set_size(k + 1, dataset.n_cols);
     impostors.set_size(k + 1, dataset.n_cols);
     distance.set_size(k + 1, dataset.n_cols);
+    // Zero slack forces a re-search of every point at the first recheck.
+    impostorSlack.zeros(dataset.n_cols);
   }
 
   constraint.TargetNeighbors(targetNeighbors, dataset, labels, norm);
@@ -101,6 +103,7 @@ void LMNNFunction<MetricType>::Shuffle()
   arma::vec newlastTransformationIndices = lastTransformationIndices;
   arma::mat newMaxImpNorm = maxImpNorm;
   arma::vec newNorm = norm;
+  arma::vec newImpostorSlack = impostorSlack;
 
   // Generate ordering.
   arma::uvec ordering = arma::shuffle(arma::linspace<arma::uvec>(0,
@@ -114,6 +117,8 @@ void LMNNFunction<MetricType>::Shuffle()
   maxImpNorm = newMaxImpNorm.cols(ordering);
   lastTransformationIndices = newlastTransformationIndices.elem(ordering);
   norm = newNorm.elem(ordering);
+  if (impBounds)
+    impostorSlack = newImpostorSlack.elem(ordering);
 
   for (size_t i = 0; i < ordering.n_elem; i++)
   {
@@ -208,6 +213,19 @@ inline void LMNNFunction<MetricType>::TransDiff(
   }
 }
 
+// Refresh impostor margin slack after a full impostor search.
+template<typename MetricType>
+inline void LMNNFunction<MetricType>::UpdateSearchCache(
+                                          const arma::mat& transformation)
+{
+  if (!impBounds)
+    return;
+
+  transformationLastSearch = transformation;
+  for (size_t i = 0; i < dataset.n_cols; ++i)
+    impostorSlack(i) = distance(k, i) - distance(k - 1, i);
+}
+
 //! Evaluate cost over whole dataset.
 template<typename MetricType>
 double LMNNFunction<MetricType>::Evaluate(const arma::mat& transformation)
@@ -228,21 +246,47 @@ double LMNNFunction<MetricType>::Evaluate(const arma::mat& transformation)
   {
     if (impBounds)
     {
+      // Movement of the transformation since the last impostor search; when
+      // range > 1 it can span several calls, so transformationDiff alone
+      // would underestimate it.
+      const double searchDiff = transformationLastSearch.is_empty() ?
+          transformationDiff :
+          arma::norm(transformation - transformationLastSearch);
+
       // Track number of data points to use for impostors calculatiom.
       size_t numPoints = 0;
 
       for (size_t i = 0; i < dataset.n_cols; i++)
       {
-        if (transformationDiff * (2 * norm(i) + norm(impostors(k - 1, i)) +
-            norm(impostors(k, i))) > distance(k, i) - distance(k - 1, i))
+        const double movement = searchDiff * (2 * norm(i) +
+            norm(impostors(k - 1, i)) + norm(impostors(k, i)));
+        if (movement > impostorSlack(i))
         {
           points(numPoints++) = i;
         }
+        else
+        {
+          // The margin shrank but could not have flipped; use up the slack so
+          // that the next recheck only needs to measure movement from here.
+          impostorSlack(i) -= movement;
+        }
       }
 
-      // Re-calculate impostors on transformed dataset.
-      constraint.Impostors(impostors, distance,
-          transformedDataset, labels, norm, points, numPoints);
+      if (numPoints > 0)
+      {
+        // Re-calculate impostors on transformed dataset.
+        constraint.Impostors(impostors, distance,
+            transformedDataset, labels, norm, points, numPoints);
+
+        // Store fresh margins for the re-searched points.
+        for (size_t j = 0; j < numPoints; j++)
+        {
+          impostorSlack(points(j)) = distance(k, points(j)) -
+              distance(k - 1, points(j));
+        }
+      }
+
+      transformationLastSearch = transformation;
     }
     else
     {
@@ -255,6 +299,7 @@ double LMNNFunction<MetricType>::Evaluate(const arma::mat& transformation)
   {
     // Re-calculate impostors on transformed dataset.
     constraint.Impostors(impostors, distance, transformedDataset, labels, norm);
+    UpdateSearchCache(transformation);
   }
 
   for (size_t i = 0; i < dataset.n_cols; i++)
@@ -348,6 +393,21 @@ double LMNNFunction<MetricType>::Evaluate(const arma::mat& transformation,
   std::map<size_t, double> transformationDiffs;
   TransDiff(transformationDiffs, transformation, begin, batchSize);
 
+  if (impBounds)
+  {
+    // Use up margin slack for the movement since each point last saw the
+    // transformation, so that the periodic recheck measures the movement
+    // accumulated since the last impostor search rather than a single step.
+    for (size_t i = begin; i < begin + batchSize; i++)
+    {
+      if (lastTransformationIndices(i))
+      {
+        impostorSlack(i) -= transformationDiffs[lastTransformationIndices[i]] *
+            (2 * norm(i) + norm(impostors(k - 1, i)) + norm(impostors(k, i)));
+      }
+    }
+  }
+
   // Apply metric over dataset.
   transformedDataset = transformation * dataset;
 
@@ -360,9 +420,10 @@ double LMNNFunction<MetricType>::Evaluate(const arma::mat& transformation,
     {
       if (lastTransformationIndices(i))
       {
-        if (transformationDiffs[lastTransformationIndices[i]] *
-            (2 * norm(i) + norm(impostors(k - 1, i)) +
-            norm(impostors(k, i))) > distance(k, i) - distance(k - 1, i))
+        // The slack has absorbed the movement of every visit since the
+        // impostors of this point were last searched; only if it has run out
+        // can the margin have flipped.
+        if (impostorSlack(i) < 0)
         {
           points(numPoints++)  = i;
         }
@@ -373,15 +434,32 @@ double LMNNFunction<MetricType>::Evaluate(const arma::mat& transformation,
       }
     }
 
-    // Re-calculate impostors on transformed dataset.
-    constraint.Impostors(impostors, distance,
-        transformedDataset, labels, norm, points, numPoints);
+    if (numPoints > 0)
+    {
+      // Re-calculate impostors on transformed dataset.
+      constraint.Impostors(impostors, distance,
+          transformedDataset, labels, norm, points, numPoints);
+
+      // Store fresh margins for the re-searched points.
+      for (size_t j = 0; j < numPoints; j++)
+      {
+        impostorSlack(points(j)) = distance(k, points(j)) -
+            distance(k - 1, points(j));
+      }
+    }
   }
   else if (iteration++ % range == 0)
   {
     // Re-calculate impostors on transformed dataset.
     constraint.Impostors(impostors, distance, transformedDataset, labels,
         norm, begin, batchSize);
+
+    if (impBounds)
+    {
+      // Store fresh margins for the re-searched batch.
+      for (size_t i = begin; i < begin + batchSize; i++)
+        impostorSlack(i) = distance(k, i) - distance(k - 1, i);
+    }
   }
 
   for (size_t i = begin; i < begin + batchSize; i++)
@@ -482,21 +560,44 @@ void LMNNFunction<MetricType>::Gradient(const arma::mat& transformation,
 
     if (impBounds)
     {
+      // Movement of the transformation since the last impostor search (see
+      // Evaluate() above).
+      const double searchDiff = transformationLastSearch.is_empty() ?
+          transformationDiff :
+          arma::norm(transformation - transformationLastSearch);
+
       // Track number of data points to use for impostors calculatiom.
       size_t numPoints = 0;
 
       for (size_t i = 0; i < dataset.n_cols; i++)
       {
-        if (transformationDiff * (2 * norm(i) + norm(impostors(k - 1, i)) +
-            norm(impostors(k, i))) > distance(k, i) - distance(k - 1, i))
+        const double movement = searchDiff * (2 * norm(i) +
+            norm(impostors(k - 1, i)) + norm(impostors(k, i)));
+        if (movement > impostorSlack(i))
         {
           points(numPoints++) = i;
         }
+        else
+        {
+          impostorSlack(i) -= movement;
+        }
       }
 
-      // Re-calculate impostors on transformed dataset.
-      constraint.Impostors(impostors, distance,
-          transformedDataset, labels, norm, points, numPoints);
+      if (numPoints > 0)
+      {
+        // Re-calculate impostors on transformed dataset.
+        constraint.Impostors(impostors, distance,
+            transformedDataset, labels, norm, points, numPoints);
+
+        // Store fresh margins for the re-searched points.
+        for (size_t j = 0; j < numPoints; j++)
+        {
+          impostorSlack(points(j)) = distance(k, points(j)) -
+              distance(k - 1, points(j));
+        }
+      }
+
+      transformationLastSearch = transformation;
     }
     else
     {
@@ -510,6 +611,7 @@ void LMNNFunction<MetricType>::Gradient(const arma::mat& transformation,
       // Re-calculate impostors on transformed dataset.
       constraint.Impostors(impostors, distance, transformedDataset, labels,
           norm);
+      UpdateSearchCache(transformation);
   }
 
   gradient.zeros(transformation.n_rows, transformation.n_cols);
@@ -611,6 +713,21 @@ void LMNNFunction<MetricType>::Gradient(const arma::mat& transformation,
   std::map<size_t, double> transformationDiffs;
   TransDiff(transformationDiffs, transformation, begin, batchSize);
 
+  if (impBounds)
+  {
+    // Use up margin slack for the movement since each point last saw the
+    // transformation, so that the periodic recheck measures the movement
+    // accumulated since the last impostor search rather than a single step.
+    for (size_t i = begin; i < begin + batchSize; i++)
+    {
+      if (lastTransformationIndices(i))
+      {
+        impostorSlack(i) -= transformationDiffs[lastTransformationIndices[i]] *
+            (2 * norm(i) + norm(impostors(k - 1, i)) + norm(impostors(k, i)));
+      }
+    }
+  }
+
   if (impBounds && iteration++ % range == 0)
   {
     // Track number of data points to use for impostors calculatiom.
@@ -620,9 +737,10 @@ void LMNNFunction<MetricType>::Gradient(const arma::mat& transformation,
     {
       if (lastTransformationIndices(i))
       {
-        if (transformationDiffs[lastTransformationIndices[i]] *
-            (2 * norm(i) + norm(impostors(k - 1, i)) +
-            norm(impostors(k, i))) > distance(k, i) - distance(k - 1, i))
+        // The slack has absorbed the movement of every visit since the
+        // impostors of this point were last searched; only if it has run out
+        // can the margin have flipped.
+        if (impostorSlack(i) < 0)
         {
           points(numPoints++)  = i;
         }
@@ -633,15 +751,32 @@ void LMNNFunction<MetricType>::Gradient(const arma::mat& transformation,
       }
     }
 
-    // Re-calculate impostors on transformed dataset.
-    constraint.Impostors(impostors, distance,
-        transformedDataset, labels, norm, points, numPoints);
+    if (numPoints > 0)
+    {
+      // Re-calculate impostors on transformed dataset.
+      constraint.Impostors(impostors, distance,
+          transformedDataset, labels, norm, points, numPoints);
+
+      // Store fresh margins for the re-searched points.
+      for (size_t j = 0; j < numPoints; j++)
+      {
+        impostorSlack(points(j)) = distance(k, points(j)) -
+            distance(k - 1, points(j));
+      }
+    }
   }
   else if (iteration++ % range == 0)
   {
     // Re-calculate impostors on transformed dataset.
     constraint.Impostors(impostors, distance, transformedDataset, labels,
         norm, begin, batchSize);
+
+    if (impBounds)
+    {
+      // Store fresh margins for the re-searched batch.
+      for (size_t i = begin; i < begin + batchSize; i++)
+        impostorSlack(i) = distance(k, i) - distance(k - 1, i);
+    }
   }
 
   gradient.zeros(transformation.n_rows, transformation.n_cols);
@@ -757,21 +892,44 @@ double LMNNFunction<MetricType>::EvaluateWithGradient(
   {
     if (impBounds)
     {
+      // Movement of the transformation since the last impostor search (see
+      // Evaluate() above).
+      const double searchDiff = transformationLastSearch.is_empty() ?
+          transformationDiff :
+          arma::norm(transformation - transformationLastSearch);
+
       // Track number of data points to use for impostors calculatiom.
       size_t numPoints = 0;
 
       for (size_t i = 0; i < dataset.n_cols; i++)
       {
-        if (transformationDiff * (2 * norm(i) + norm(impostors(k - 1, i)) +
-            norm(impostors(k, i))) > distance(k, i) - distance(k - 1, i))
+        const double movement = searchDiff * (2 * norm(i) +
+            norm(impostors(k - 1, i)) + norm(impostors(k, i)));
+        if (movement > impostorSlack(i))
         {
           points(numPoints++) = i;
         }
+        else
+        {
+          impostorSlack(i) -= movement;
+        }
       }
 
-      // Re-calculate impostors on transformed dataset.
-      constraint.Impostors(impostors, distance,
-          transformedDataset, labels, norm, points, numPoints);
+      if (numPoints > 0)
+      {
+        // Re-calculate impostors on transformed dataset.
+        constraint.Impostors(impostors, distance,
+            transformedDataset, labels, norm, points, numPoints);
+
+        // Store fresh margins for the re-searched points.
+        for (size_t j = 0; j < numPoints; j++)
+        {
+          impostorSlack(points(j)) = distance(k, points(j)) -
+              distance(k - 1, points(j));
+        }
+      }
+
+      transformationLastSearch = transformation;
     }
     else
     {
@@ -785,6 +943,7 @@ double LMNNFunction<MetricType>::EvaluateWithGradient(
       // Re-calculate impostors on transformed dataset.
       constraint.Impostors(impostors, distance, transformedDataset, labels,
           norm);
+      UpdateSearchCache(transformation);
   }
 
   gradient.zeros(transformation.n_rows, transformation.n_cols);
@@ -890,6 +1049,21 @@ double LMNNFunction<MetricType>::EvaluateWithGradient(
   std::map<size_t, double> transformationDiffs;
   TransDiff(transformationDiffs, transformation, begin, batchSize);
 
+  if (impBounds)
+  {
+    // Use up margin slack for the movement since each point last saw the
+    // transformation, so that the periodic recheck measures the movement
+    // accumulated since the last impostor search rather than a single step.
+    for (size_t i = begin; i < begin + batchSize; i++)
+    {
+      if (lastTransformationIndices(i))
+      {
+        impostorSlack(i) -= transformationDiffs[lastTransformationIndices[i]] *
+            (2 * norm(i) + norm(impostors(k - 1, i)) + norm(impostors(k, i)));
+      }
+    }
+  }
+
   // Apply metric over dataset.
   transformedDataset = transformation * dataset;
 
@@ -902,9 +1076,10 @@ double LMNNFunction<MetricType>::EvaluateWithGradient(
     {
       if (lastTransformationIndices(i))
       {
-        if (transformationDiffs[lastTransformationIndices[i]] *
-            (2 * norm(i) + norm(impostors(k - 1, i)) +
-            norm(impostors(k, i))) > distance(k, i) - distance(k - 1, i))
+        // The slack has absorbed the movement of every visit since the
+        // impostors of this point were last searched; only if it has run out
+        // can the margin have flipped.
+        if (impostorSlack(i) < 0)
         {
           points(numPoints++)  = i;
         }
@@ -915,15 +1090,32 @@ double LMNNFunction<MetricType>::EvaluateWithGradient(
       }
     }
 
-    // Re-calculate impostors on transformed dataset.
-    constraint.Impostors(impostors, distance,
-        transformedDataset, labels, norm, points, numPoints);
+    if (numPoints > 0)
+    {
+      // Re-calculate impostors on transformed dataset.
+      constraint.Impostors(impostors, distance,
+          transformedDataset, labels, norm, points, numPoints);
+
+      // Store fresh margins for the re-searched points.
+      for (size_t j = 0; j < numPoints; j++)
+      {
+        impostorSlack(points(j)) = distance(k, points(j)) -
+            distance(k - 1, points(j));
+      }
+    }
   }
   else if (iteration++ % range == 0)
   {
     // Re-calculate impostors on transformed dataset.
     constraint.Impostors(impostors, distance, transformedDataset, labels,
         norm, begin, batchSize);
+
+    if (impBounds)
+    {
+      // Store fresh margins for the re-searched batch.
+      for (size_t i = begin; i < begin + batchSize; i++)
+        impostorSlack(i) = distance(k, i) - distance(k - 1, i);
+    }
   }
 
   gradient.zeros(transformation.n_rows, transformation.n_cols);
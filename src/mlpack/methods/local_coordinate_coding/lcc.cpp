@@ -63,6 +63,39 @@ void LocalCoordinateCoding::Encode(const arma::mat& data, arma::mat& codes)
   }
 }
 
+double LocalCoordinateCoding::OnlineStep(const arma::mat& batch)
+{
+  // Encode the mini-batch with the current dictionary.
+  arma::mat codes;
+  Encode(batch, codes);
+
+  // Fold the mini-batch into the running sufficient statistics.
+  codeCovariance += codes * trans(codes);
+  dataCodeProducts += batch * trans(codes);
+
+  // Block coordinate descent sweep over the atoms, following the online
+  // dictionary learning update of Mairal et al. (2009).  Atoms that no batch
+  // has used yet have a zero diagonal entry and are left untouched.
+  for (size_t j = 0; j < atoms; ++j)
+  {
+    if (codeCovariance(j, j) < 1e-12)
+      continue;
+
+    arma::vec u = dictionary.col(j) + (dataCodeProducts.col(j) -
+        dictionary * codeCovariance.col(j)) / codeCovariance(j, j);
+
+    // Project onto the unit ball to keep the atom norms bounded.
+    const double uNorm = norm(u, 2);
+    if (uNorm > 1.0)
+      u /= uNorm;
+
+    dictionary.col(j) = u;
+  }
+
+  arma::uvec adjacencies = find(codes);
+  return Objective(batch, codes, adjacencies);
+}
+
 void LocalCoordinateCoding::OptimizeDictionary(const arma::mat& data,
                                                const arma::mat& codes,
                                                const arma::uvec& adjacencies)
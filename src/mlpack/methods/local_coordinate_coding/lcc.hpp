@@ -144,6 +144,36 @@ class LocalCoordinateCoding
                const DictionaryInitializer& initializer =
                    DictionaryInitializer());
 
+  /**
+   * Run online local coordinate coding with mini-batch dictionary updates.
+   * Instead of alternating full-batch coding and dictionary steps, each
+   * mini-batch is encoded with the current dictionary and the dictionary is
+   * then refined by block coordinate descent on running sufficient statistics
+   * (the accumulated code covariance and data-code products), in the style of
+   * the online dictionary learning algorithm of Mairal et al. (2009).
+   *
+   * The given data may be only a chunk of a larger stream: the dictionary is
+   * initialized only if the model has not been trained yet, and the
+   * sufficient statistics persist across calls, so repeated calls with
+   * successive chunks incrementally refine the same dictionary.  This allows
+   * training on datasets far larger than RAM.
+   *
+   * @param data Data matrix (or chunk of a larger dataset).
+   * @param batchSize Number of points per mini-batch.
+   * @param epochs Number of passes over the given data.
+   * @param initializer Initializer to use (only if the model is untrained).
+   * @return The objective value of the last processed mini-batch.
+   */
+  template<
+      typename DictionaryInitializer =
+          sparse_coding::DataDependentRandomInitializer
+  >
+  double TrainOnline(const arma::mat& data,
+                     const size_t batchSize,
+                     const size_t epochs = 1,
+                     const DictionaryInitializer& initializer =
+                         DictionaryInitializer());
+
   /**
    * Code each point via distance-weighted LARS.
    *
@@ -152,6 +182,17 @@ class LocalCoordinateCoding
    */
   void Encode(const arma::mat& data, arma::mat& codes);
 
+  /**
+   * Perform one online dictionary update: encode the given mini-batch with
+   * the current dictionary, fold the resulting codes into the running
+   * sufficient statistics, and take a block coordinate descent sweep over the
+   * atoms.  Used by TrainOnline().
+   *
+   * @param batch Mini-batch of points.
+   * @return The objective value of the mini-batch.
+   */
+  double OnlineStep(const arma::mat& batch);
+
   /**
    * Learn dictionary by solving linear system.
    *
@@ -221,11 +262,29 @@ class LocalCoordinateCoding
   size_t maxIterations;
   //! Tolerance for main objective.
   double tolerance;
+
+  //! Running sum of code outer products (A = sum z z^T) for online training.
+  arma::mat codeCovariance;
+  //! Running sum of data-code products (B = sum x z^T) for online training.
+  arma::mat dataCodeProducts;
 };
 
 } // namespace lcc
 } // namespace mlpack
 
+//! Set the serialization version of the LocalCoordinateCoding class.
+namespace boost {
+namespace serialization {
+
+template<>
+struct version<mlpack::lcc::LocalCoordinateCoding>
+{
+  BOOST_STATIC_CONSTANT(int, value = 1);
+};
+
+} // namespace serialization
+} // namespace boost
+
 // Include implementation.
 #include "lcc_impl.hpp"
 
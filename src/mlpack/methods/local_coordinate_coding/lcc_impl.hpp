@@ -106,15 +106,77 @@ double LocalCoordinateCoding::Train(
   return lastObjVal;
 }
 
+template<typename DictionaryInitializer>
+double LocalCoordinateCoding::TrainOnline(
+    const arma::mat& data,
+    const size_t batchSize,
+    const size_t epochs,
+    const DictionaryInitializer& initializer)
+{
+  Timer::Start("local_coordinate_coding");
+
+  // Initialize the dictionary only if the model is untrained; otherwise this
+  // call continues refining the existing dictionary with the new data.
+  if (dictionary.n_elem == 0)
+    initializer.Initialize(data, atoms, dictionary);
+
+  // Initialize the running sufficient statistics if they are not yet the
+  // right size (i.e. this is the first chunk of the stream).
+  if (codeCovariance.n_rows != atoms)
+  {
+    codeCovariance.zeros(atoms, atoms);
+    dataCodeProducts.zeros(data.n_rows, atoms);
+  }
+
+  double lastObjVal = DBL_MAX;
+  for (size_t epoch = 0; epoch < epochs; ++epoch)
+  {
+    Log::Info << "Online epoch " << (epoch + 1) << " of " << epochs << "."
+        << std::endl;
+
+    // Visit the points in a random order each epoch.
+    const arma::uvec order = arma::shuffle(
+        arma::regspace<arma::uvec>(0, data.n_cols - 1));
+
+    for (size_t start = 0; start < data.n_cols; start += batchSize)
+    {
+      const size_t end = (start + batchSize > data.n_cols) ?
+          (data.n_cols - 1) : (start + batchSize - 1);
+      const arma::mat batch = data.cols(order.subvec(start, end));
+
+      lastObjVal = OnlineStep(batch);
+    }
+
+    Log::Info << "  Last mini-batch objective value: " << lastObjVal << "."
+        << std::endl;
+  }
+
+  Timer::Stop("local_coordinate_coding");
+  return lastObjVal;
+}
+
 template<typename Archive>
 void LocalCoordinateCoding::serialize(Archive& ar,
-                                      const unsigned int /* version */)
+                                      const unsigned int version)
 {
   ar & BOOST_SERIALIZATION_NVP(atoms);
   ar & BOOST_SERIALIZATION_NVP(dictionary);
   ar & BOOST_SERIALIZATION_NVP(lambda);
   ar & BOOST_SERIALIZATION_NVP(maxIterations);
   ar & BOOST_SERIALIZATION_NVP(tolerance);
+
+  // The online training statistics were added in version 1; older models can
+  // be loaded, but any online training state is reset.
+  if (version > 0)
+  {
+    ar & BOOST_SERIALIZATION_NVP(codeCovariance);
+    ar & BOOST_SERIALIZATION_NVP(dataCodeProducts);
+  }
+  else if (Archive::is_loading::value)
+  {
+    codeCovariance.clear();
+    dataCodeProducts.clear();
+  }
 }
 
 } // namespace lcc
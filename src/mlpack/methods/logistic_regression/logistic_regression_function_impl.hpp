@@ -15,6 +15,8 @@
 // In case it hasn't been included yet.
 #include "logistic_regression_function.hpp"
 
+#include <map>
+
 #include <mlpack/core.hpp>
 
 namespace mlpack {
@@ -299,6 +301,211 @@ double LogisticRegressionFunction<MatType>::EvaluateWithGradient(
   return objectiveRegularization - result;
 }
 
+/**
+ * Compute the margin (w'x + b) of a single column of a sparse predictor
+ * matrix, iterating only its nonzero entries.
+ */
+inline double SparseLogisticMargin(const arma::sp_mat& predictors,
+                                   const arma::mat& parameters,
+                                   const size_t col)
+{
+  double margin = parameters(0, 0);
+  for (arma::sp_mat::const_iterator it = predictors.begin_col(col);
+       it != predictors.end_col(col); ++it)
+    margin += parameters(0, it.row() + 1) * (*it);
+  return margin;
+}
+
+/**
+ * Accumulate the gradient of the logistic regression objective for a batch of
+ * columns of a sparse predictor matrix into a dense gradient, iterating only
+ * the nonzero entries of each column.  The batch-scaled L2 term is applied to
+ * every feature, exactly as in the generic dense implementation.  The sigmoid
+ * values for the batch are also returned, so that EvaluateWithGradient() can
+ * reuse them for the objective.
+ */
+inline void SparseLogisticGradient(const arma::sp_mat& predictors,
+                                   const arma::Row<size_t>& responses,
+                                   const arma::mat& parameters,
+                                   const size_t begin,
+                                   const size_t batchSize,
+                                   const double regScale,
+                                   arma::mat& gradient,
+                                   arma::rowvec& sigmoids)
+{
+  gradient.zeros(parameters.n_rows, parameters.n_cols);
+  sigmoids.set_size(batchSize);
+
+  for (size_t i = 0; i < batchSize; ++i)
+  {
+    const size_t col = begin + i;
+    sigmoids[i] = 1.0 /
+        (1.0 + std::exp(-SparseLogisticMargin(predictors, parameters, col)));
+    const double diff = sigmoids[i] - responses[col];
+
+    gradient[0] += diff;
+    for (arma::sp_mat::const_iterator it = predictors.begin_col(col);
+         it != predictors.end_col(col); ++it)
+      gradient(0, it.row() + 1) += diff * (*it);
+  }
+
+  gradient.tail_cols(parameters.n_elem - 1) += regScale *
+      parameters.tail_cols(parameters.n_elem - 1);
+}
+
+/**
+ * Accumulate the gradient of the logistic regression objective for a batch of
+ * columns of a sparse predictor matrix into a sparse gradient.  Here the L2
+ * term is applied lazily---only to the features that actually appear in the
+ * batch---so that the gradient stays sparse for optimizers that exploit sparse
+ * updates (e.g. parallel SGD).  The regularization schedule therefore differs
+ * slightly from the dense path for features absent from the batch, but in
+ * expectation each feature is still shrunk in proportion to how often it is
+ * seen.
+ */
+inline void SparseLogisticGradient(const arma::sp_mat& predictors,
+                                   const arma::Row<size_t>& responses,
+                                   const arma::mat& parameters,
+                                   const size_t begin,
+                                   const size_t batchSize,
+                                   const double regScale,
+                                   arma::sp_mat& gradient,
+                                   arma::rowvec& sigmoids)
+{
+  sigmoids.set_size(batchSize);
+
+  // Accumulate the data term per touched feature; a std::map keeps the
+  // locations sorted for the batch-insertion constructor below.
+  std::map<arma::uword, double> sums;
+  double interceptGradient = 0.0;
+
+  for (size_t i = 0; i < batchSize; ++i)
+  {
+    const size_t col = begin + i;
+    sigmoids[i] = 1.0 /
+        (1.0 + std::exp(-SparseLogisticMargin(predictors, parameters, col)));
+    const double diff = sigmoids[i] - responses[col];
+
+    interceptGradient += diff;
+    for (arma::sp_mat::const_iterator it = predictors.begin_col(col);
+         it != predictors.end_col(col); ++it)
+      sums[it.row() + 1] += diff * (*it);
+  }
+
+  // Lazy L2 regularization: only the touched features are shrunk.
+  for (std::map<arma::uword, double>::iterator it = sums.begin();
+       it != sums.end(); ++it)
+    it->second += regScale * parameters(0, it->first);
+
+  // Assemble the sparse gradient in one batch insertion; the intercept term
+  // always occupies the first position.
+  arma::umat locations(2, sums.size() + 1);
+  arma::vec values(sums.size() + 1);
+  locations(0, 0) = 0;
+  locations(1, 0) = 0;
+  values[0] = interceptGradient;
+  size_t pos = 1;
+  for (std::map<arma::uword, double>::const_iterator it = sums.begin();
+       it != sums.end(); ++it, ++pos)
+  {
+    locations(0, pos) = 0;
+    locations(1, pos) = it->first;
+    values[pos] = it->second;
+  }
+
+  gradient = arma::sp_mat(locations, values, parameters.n_rows,
+      parameters.n_cols);
+}
+
+/**
+ * Specialization of Gradient() for sparse predictors: iterate only the nonzero
+ * entries of each column instead of forming dense products against the whole
+ * matrix.
+ */
+template<>
+inline void LogisticRegressionFunction<arma::sp_mat>::Gradient(
+    const arma::mat& parameters,
+    arma::mat& gradient) const
+{
+  arma::rowvec sigmoids;
+  SparseLogisticGradient(predictors, responses, parameters, 0,
+      predictors.n_cols, lambda, gradient, sigmoids);
+}
+
+/**
+ * Specialization of the separable Gradient() for sparse predictors.  Only the
+ * nonzero entries of the batch are visited, and if the gradient itself is
+ * sparse, the L2 term is applied lazily to keep it that way.
+ */
+template<>
+template<typename GradType>
+void LogisticRegressionFunction<arma::sp_mat>::Gradient(
+    const arma::mat& parameters,
+    const size_t begin,
+    GradType& gradient,
+    const size_t batchSize) const
+{
+  arma::rowvec sigmoids;
+  SparseLogisticGradient(predictors, responses, parameters, begin, batchSize,
+      lambda * batchSize / predictors.n_cols, gradient, sigmoids);
+}
+
+/**
+ * Specialization of EvaluateWithGradient() for sparse predictors; the sigmoid
+ * values computed during the gradient pass are reused for the objective.
+ */
+template<>
+template<typename GradType>
+double LogisticRegressionFunction<arma::sp_mat>::EvaluateWithGradient(
+    const arma::mat& parameters,
+    GradType& gradient) const
+{
+  arma::rowvec sigmoids;
+  SparseLogisticGradient(predictors, responses, parameters, 0,
+      predictors.n_cols, lambda, gradient, sigmoids);
+
+  const double objectiveRegularization = lambda / 2.0 *
+      arma::dot(parameters.tail_cols(parameters.n_elem - 1),
+                parameters.tail_cols(parameters.n_elem - 1));
+
+  const arma::rowvec respD = arma::conv_to<arma::rowvec>::from(responses);
+  const double result = arma::accu(arma::log(1.0 - respD + sigmoids %
+      (2 * respD - 1.0)));
+
+  // Invert the result, because it's a minimization.
+  return objectiveRegularization - result;
+}
+
+/**
+ * Specialization of the separable EvaluateWithGradient() for sparse
+ * predictors.
+ */
+template<>
+template<typename GradType>
+double LogisticRegressionFunction<arma::sp_mat>::EvaluateWithGradient(
+    const arma::mat& parameters,
+    const size_t begin,
+    GradType& gradient,
+    const size_t batchSize) const
+{
+  arma::rowvec sigmoids;
+  SparseLogisticGradient(predictors, responses, parameters, begin, batchSize,
+      lambda * batchSize / predictors.n_cols, gradient, sigmoids);
+
+  const double objectiveRegularization = lambda *
+      (batchSize / (2.0 * predictors.n_cols)) *
+      arma::dot(parameters.tail_cols(parameters.n_elem - 1),
+                parameters.tail_cols(parameters.n_elem - 1));
+
+  const arma::rowvec respD = arma::conv_to<arma::rowvec>::from(responses.subvec(
+      begin, begin + batchSize - 1));
+  const double result = arma::accu(arma::log(1.0 - respD + sigmoids %
+      (2 * respD - 1.0)));
+
+  // Invert the result, because it's a minimization.
+  return objectiveRegularization - result;
+}
+
 } // namespace regression
 } // namespace mlpack
 
@@ -196,6 +196,42 @@ class LSHSearch
              const size_t bucketSize = 500,
              const arma::cube& projection = arma::cube());
 
+  /**
+   * Insert the given points into the index without rebuilding it.  The points
+   * are appended to the reference set and hashed into the existing tables;
+   * bucket rows are grown (up to the bucket size limit) as needed.  The new
+   * points receive the reference indices following the current last point.
+   *
+   * Since the hash width, projections, and second hash table size stay fixed,
+   * the quality of the index can degrade if the distribution of the data
+   * shifts substantially; in that case, retrain with Train().
+   *
+   * @param points Points to insert into the index.
+   */
+  void Insert(const MatType& points);
+
+  /**
+   * Delete the points with the given reference indices from the index.  Their
+   * entries are removed from the hash tables, so they can no longer be
+   * returned as neighbors, but their columns remain in the reference set (and
+   * keep their indices) until Compact() is called.  Indices that are out of
+   * range or already deleted are ignored.
+   *
+   * @param indices Reference indices of the points to delete.
+   */
+  void Delete(const arma::uvec& indices);
+
+  /**
+   * Reclaim the memory of deleted points and of bucket slack left behind by
+   * Insert().  The columns of deleted points are removed from the reference
+   * set, the surviving indices in the hash tables are remapped, and each
+   * bucket row is shrunk to its exact length.  Note that this renumbers the
+   * reference indices returned by Search(), so any externally held indices
+   * must be re-derived.  Calling this periodically (rather than per delete)
+   * keeps streaming updates cheap.
+   */
+  void Compact();
+
   /**
    * Compute the nearest neighbors of the points in the given query set and
    * store the output in the given matrices.  The matrices will be set to the
@@ -415,14 +451,27 @@ class LSHSearch
    */
   bool PerturbationExpand(std::vector<bool>& A) const;
 
+  /**
+   * Hash the given point into its bucket of the second hash table for the
+   * given table, using the same two-level hashing scheme as Train().
+   *
+   * @param point Point to hash.
+   * @param table Index of the hash table.
+   */
+  template<typename VecType>
+  size_t HashPointToBucket(const VecType& point, const size_t table) const;
+
   /**
    * Return true if perturbation set A is valid. A perturbation set is invalid
    * if it contains two (or more) actions for the same dimension or dimensions
    * that are larger than the queryCode's dimensions.
    *
    * @param A perturbation set to validate.
+   * @param positions maps each (score-sorted) slot of A to the dimension its
+   *    action applies to.
    */
-  bool PerturbationValid(const std::vector<bool>& A) const;
+  bool PerturbationValid(const std::vector<bool>& A,
+                         const arma::Col<size_t>& positions) const;
 
   //! Reference dataset.
   MatType referenceSet;
@@ -462,6 +511,10 @@ class LSHSearch
   //! corresponding to this value. Length secondHashSize.
   arma::Col<size_t> bucketRowInHashTable;
 
+  //! Marks points that were removed with Delete() but whose columns are still
+  //! present in the reference set (until the next Compact()).
+  std::vector<bool> deletedPoints;
+
   //! The number of distance evaluations.
   size_t distanceEvaluations;
 
@@ -486,7 +539,7 @@ class LSHSearch
 
 //! Set the serialization version of the LSHSearch class.
 BOOST_TEMPLATE_CLASS_VERSION(template<typename SortPolicy>,
-    mlpack::neighbor::LSHSearch<SortPolicy>, 1);
+    mlpack::neighbor::LSHSearch<SortPolicy>, 2);
 
 // Include implementation.
 #include "lsh_search_impl.hpp"
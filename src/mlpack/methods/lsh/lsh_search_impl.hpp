@@ -14,6 +14,7 @@
 
 #include <mlpack/prereqs.hpp>
 #include <mlpack/core/math/random.hpp>
+#include <mlpack/core/util/parallelism.hpp>
 
 namespace mlpack {
 namespace neighbor {
@@ -86,6 +87,7 @@ LSHSearch<SortPolicy, MatType>::LSHSearch(const LSHSearch& other) :
     secondHashTable(other.secondHashTable),
     bucketContentSize(other.bucketContentSize),
     bucketRowInHashTable(other.bucketRowInHashTable),
+    deletedPoints(other.deletedPoints),
     distanceEvaluations(other.distanceEvaluations)
 {
   // Nothing to do.
@@ -106,6 +108,7 @@ LSHSearch<SortPolicy, MatType>::LSHSearch(LSHSearch&& other) :
     secondHashTable(std::move(other.secondHashTable)),
     bucketContentSize(std::move(other.bucketContentSize)),
     bucketRowInHashTable(std::move(other.bucketRowInHashTable)),
+    deletedPoints(std::move(other.deletedPoints)),
     distanceEvaluations(other.distanceEvaluations)
 {
   // Reset other model to defaults.
@@ -134,6 +137,7 @@ LSHSearch<SortPolicy, MatType>& LSHSearch<SortPolicy, MatType>::operator=(
   secondHashTable = other.secondHashTable;
   bucketContentSize = other.bucketContentSize;
   bucketRowInHashTable = other.bucketRowInHashTable;
+  deletedPoints = other.deletedPoints;
   distanceEvaluations = other.distanceEvaluations;
 
   return *this;
@@ -156,6 +160,7 @@ LSHSearch<SortPolicy, MatType>& LSHSearch<SortPolicy, MatType>::operator=(
   secondHashTable = std::move(other.secondHashTable);
   bucketContentSize = std::move(other.bucketContentSize);
   bucketRowInHashTable = std::move(other.bucketRowInHashTable);
+  deletedPoints = std::move(other.deletedPoints);
   distanceEvaluations = other.distanceEvaluations;
 
   // Reset other model to defaults.
@@ -164,6 +169,7 @@ LSHSearch<SortPolicy, MatType>& LSHSearch<SortPolicy, MatType>::operator=(
   other.hashWidth = 0;
   other.secondHashSize = 99901;
   other.bucketSize = 500;
+  other.deletedPoints.clear();
   other.distanceEvaluations = 0;
 
   return *this;
@@ -258,7 +264,11 @@ void LSHSearch<SortPolicy, MatType>::Train(MatType referenceSet,
   // size_t, otherwise negative numbers are cast to 0.
   arma::Mat<size_t> secondHashVectors(numTables, this->referenceSet.n_cols);
 
-  for (size_t i = 0; i < numTables; i++)
+  // The tables are completely independent: each iteration reads only shared
+  // immutable state and writes only row i of secondHashVectors.
+  #pragma omp parallel for schedule(dynamic) \
+      num_threads((int) Parallelism::Threads("lsh"))
+  for (omp_size_t i = 0; i < (omp_size_t) numTables; i++)
   {
     // Step IV: create the 'numProj'-dimensional key for each point in each
     // table.
@@ -299,10 +309,20 @@ void LSHSearch<SortPolicy, MatType>::Train(MatType referenceSet,
   }
 
   // Now, using the hash vectors for each table, count the number of rows we
-  // have in the second hash table.
+  // have in the second hash table.  Each thread accumulates into its own
+  // buffer; the buffers are then merged.
   arma::Row<size_t> secondHashBinCounts(secondHashSize, arma::fill::zeros);
-  for (size_t i = 0; i < secondHashVectors.n_elem; ++i)
-    secondHashBinCounts[secondHashVectors[i]]++;
+  #pragma omp parallel num_threads((int) Parallelism::Threads("lsh"))
+  {
+    arma::Row<size_t> localBinCounts(secondHashSize, arma::fill::zeros);
+
+    #pragma omp for nowait
+    for (omp_size_t i = 0; i < (omp_size_t) secondHashVectors.n_elem; ++i)
+      localBinCounts[secondHashVectors[i]]++;
+
+    #pragma omp critical (lshSecondHashBinCounts)
+    secondHashBinCounts += localBinCounts;
+  }
 
   // Enforce the maximum bucket size.
   const size_t effectiveBucketSize = (bucketSize == 0) ? SIZE_MAX : bucketSize;
@@ -347,6 +367,161 @@ void LSHSearch<SortPolicy, MatType>::Train(MatType referenceSet,
             << "maximum length of " << arma::max(secondHashBinCounts) << ", "
             << "totaling " << arma::accu(secondHashBinCounts) << " elements."
             << std::endl;
+
+  // A fresh index contains no deleted points.
+  deletedPoints.clear();
+  deletedPoints.resize(this->referenceSet.n_cols, false);
+}
+
+// Hash a point to its bucket of the second hash table for one table.
+template<typename SortPolicy, typename MatType>
+template<typename VecType>
+size_t LSHSearch<SortPolicy, MatType>::HashPointToBucket(
+    const VecType& point,
+    const size_t table) const
+{
+  // First-level hash: the numProj-dimensional integer key of the point.
+  arma::vec key = projections.slice(table).t() * point;
+  key += offsets.col(table);
+  key /= hashWidth;
+
+  // Second-level hash: map the key to a bucket, normalizing the hash to the
+  // range [0, secondHashSize) in the same way as Train().
+  const double unmod = arma::dot(secondHashWeights, arma::floor(key));
+  const double shs = (double) secondHashSize; // Convenience cast.
+  if (unmod >= 0.0)
+    return size_t(fmod(unmod, shs));
+
+  const double mod = fmod(-unmod, shs);
+  return (mod < 1.0) ? 0 : secondHashSize - size_t(mod);
+}
+
+// Insert new points into the index without rebuilding it.
+template<typename SortPolicy, typename MatType>
+void LSHSearch<SortPolicy, MatType>::Insert(const MatType& points)
+{
+  if (projections.n_slices == 0)
+    throw std::invalid_argument("LSHSearch::Insert(): index has not been "
+        "trained!");
+  if (points.n_rows != referenceSet.n_rows)
+  {
+    std::ostringstream oss;
+    oss << "LSHSearch::Insert(): dimensionality of new points ("
+        << points.n_rows << ") is not equal to the dimensionality the model "
+        << "was trained on (" << referenceSet.n_rows << ")!" << std::endl;
+    throw std::invalid_argument(oss.str());
+  }
+
+  const size_t oldSize = referenceSet.n_cols;
+  referenceSet.insert_cols(oldSize, points);
+  deletedPoints.resize(referenceSet.n_cols, false);
+
+  const size_t effectiveBucketSize = (bucketSize == 0) ? SIZE_MAX : bucketSize;
+
+  for (size_t j = 0; j < points.n_cols; ++j)
+  {
+    const size_t index = oldSize + j;
+    for (size_t i = 0; i < numTables; ++i)
+    {
+      const size_t hashInd = HashPointToBucket(referenceSet.col(index), i);
+
+      // Start a new row for a bucket we have not seen before.
+      if (bucketRowInHashTable[hashInd] == secondHashSize)
+      {
+        secondHashTable.push_back(arma::Col<size_t>(4));
+        bucketContentSize.resize(secondHashTable.size());
+        bucketContentSize[secondHashTable.size() - 1] = 0;
+        bucketRowInHashTable[hashInd] = secondHashTable.size() - 1;
+      }
+
+      const size_t tableRow = bucketRowInHashTable[hashInd];
+      arma::Col<size_t>& bucket = secondHashTable[tableRow];
+
+      // Grow the row geometrically if it is full; the slack is reclaimed by
+      // Compact().  If the row has hit the bucket size limit, the point is
+      // dropped from this table, exactly as during training.
+      if (bucketContentSize[tableRow] == bucket.n_elem &&
+          bucket.n_elem < effectiveBucketSize)
+      {
+        bucket.resize(std::min(std::max<size_t>(4, 2 * bucket.n_elem),
+            effectiveBucketSize));
+      }
+
+      if (bucketContentSize[tableRow] < bucket.n_elem)
+        bucket(bucketContentSize[tableRow]++) = index;
+    }
+  }
+}
+
+// Delete points from the index.
+template<typename SortPolicy, typename MatType>
+void LSHSearch<SortPolicy, MatType>::Delete(const arma::uvec& indices)
+{
+  for (size_t d = 0; d < indices.n_elem; ++d)
+  {
+    const size_t index = indices[d];
+    if (index >= referenceSet.n_cols || deletedPoints[index])
+      continue; // Out of range or already deleted.
+
+    // Remove the point's entry from its bucket in every table.  The point may
+    // be missing from some tables if its bucket was already full when it was
+    // hashed; that is fine.
+    for (size_t i = 0; i < numTables; ++i)
+    {
+      const size_t hashInd = HashPointToBucket(referenceSet.col(index), i);
+      const size_t tableRow = bucketRowInHashTable[hashInd];
+      if (tableRow >= secondHashSize)
+        continue;
+
+      arma::Col<size_t>& bucket = secondHashTable[tableRow];
+      for (size_t j = 0; j < bucketContentSize[tableRow]; ++j)
+      {
+        if (bucket[j] == index)
+        {
+          // Swap with the last filled entry and shrink the bucket.
+          bucket[j] = bucket[bucketContentSize[tableRow] - 1];
+          --bucketContentSize[tableRow];
+          break;
+        }
+      }
+    }
+
+    deletedPoints[index] = true;
+  }
+}
+
+// Reclaim the memory of deleted points and bucket slack.
+template<typename SortPolicy, typename MatType>
+void LSHSearch<SortPolicy, MatType>::Compact()
+{
+  // Build the old-to-new index mapping, if any points were deleted.
+  size_t numKept = 0;
+  arma::Col<size_t> oldToNew(referenceSet.n_cols);
+  for (size_t i = 0; i < referenceSet.n_cols; ++i)
+    oldToNew[i] = deletedPoints[i] ? referenceSet.n_cols : numKept++;
+
+  // Remap the surviving indices and shrink each bucket row to its exact
+  // length (deleted indices were already removed by Delete()).
+  for (size_t r = 0; r < secondHashTable.size(); ++r)
+  {
+    arma::Col<size_t>& bucket = secondHashTable[r];
+    for (size_t j = 0; j < bucketContentSize[r]; ++j)
+      bucket[j] = oldToNew[bucket[j]];
+    bucket.resize(bucketContentSize[r]);
+  }
+
+  // Remove the columns of deleted points from the reference set.
+  if (numKept < referenceSet.n_cols)
+  {
+    MatType compacted(referenceSet.n_rows, numKept);
+    for (size_t i = 0; i < referenceSet.n_cols; ++i)
+      if (!deletedPoints[i])
+        compacted.col(oldToNew[i]) = referenceSet.col(i);
+    referenceSet = std::move(compacted);
+  }
+
+  deletedPoints.clear();
+  deletedPoints.resize(referenceSet.n_cols, false);
 }
 
 // Base case where the query set is the reference set.  (So, we can't return
@@ -493,7 +668,8 @@ bool LSHSearch<SortPolicy, MatType>::PerturbationExpand(
 template<typename SortPolicy, typename MatType>
 inline force_inline
 bool LSHSearch<SortPolicy, MatType>::PerturbationValid(
-    const std::vector<bool>& A) const
+    const std::vector<bool>& A,
+    const arma::Col<size_t>& positions) const
 {
   // Use check to mark dimensions we have seen before in A. If a dimension is
   // seen twice (or more), A is not a valid perturbation.
@@ -503,15 +679,17 @@ bool LSHSearch<SortPolicy, MatType>::PerturbationValid(
     return false; // This should never happen.
 
   // Check that we only see each dimension once. If not, vector is not valid.
+  // A is indexed by score-sorted slots, so the dimension an entry acts on is
+  // given by the positions vector, which was sorted alongside the scores.
   for (size_t i = 0; i < A.size(); ++i)
   {
     // Only check dimensions that were included.
     if (!A[i])
       continue;
 
-    // If dimesnion is unseen thus far, mark it as seen.
-    if (check[i % numProj] == false)
-      check[i % numProj] = true;
+    // If dimension is unseen thus far, mark it as seen.
+    if (check[positions[i]] == false)
+      check[positions[i]] = true;
     else
       return false; // If dimension was seen before, set is not valid.
   }
@@ -672,7 +850,7 @@ void LSHSearch<SortPolicy, MatType>::GetAdditionalProbingBins(
       std::vector<bool> As = Ai;
 
       // Don't add invalid sets.
-      if (PerturbationShift(As) && PerturbationValid(As))
+      if (PerturbationShift(As) && PerturbationValid(As, positions))
       {
         perturbationSets.push_back(As); // add shifted set to sets
         minHeap.push(
@@ -684,14 +862,14 @@ void LSHSearch<SortPolicy, MatType>::GetAdditionalProbingBins(
       std::vector<bool> Ae = Ai;
 
       // Don't add invalid sets.
-      if (PerturbationExpand(Ae) && PerturbationValid(Ae))
+      if (PerturbationExpand(Ae) && PerturbationValid(Ae, positions))
       {
         perturbationSets.push_back(Ae); // add expanded set to sets
         minHeap.push(
             std::make_pair(PerturbationScore(Ae, scores),
             perturbationSets.size() - 1));
       }
-    } while (!PerturbationValid(Ai)); // Discard invalid perturbations
+    } while (!PerturbationValid(Ai, positions)); // Discard invalid perturbations
 
     // Found valid perturbation set Ai. Construct perturbation vector from set.
     for (size_t pos = 0; pos < Ai.size(); ++pos)
@@ -915,6 +1093,7 @@ void LSHSearch<SortPolicy, MatType>::Search(
   #pragma omp parallel for \
       shared(resultingNeighbors, distances) \
       schedule(dynamic)\
+      num_threads((int) Parallelism::Threads("lsh")) \
       reduction(+:avgIndicesReturned)
   for (omp_size_t i = 0; i < (omp_size_t) querySet.n_cols; ++i)
   {
@@ -981,6 +1160,7 @@ Search(const size_t k,
   #pragma omp parallel for \
       shared(resultingNeighbors, distances) \
       schedule(dynamic)\
+      num_threads((int) Parallelism::Threads("lsh")) \
       reduction(+:avgIndicesReturned)
   for (omp_size_t i = 0; i < (omp_size_t) referenceSet.n_cols; ++i)
   {
@@ -1143,6 +1323,18 @@ void LSHSearch<SortPolicy, MatType>::serialize(Archive& ar,
     ar & BOOST_SERIALIZATION_NVP(bucketRowInHashTable);
   }
 
+  // Backward compatibility: older versions of LSHSearch did not support
+  // incremental deletion, so no points are marked deleted.
+  if (version > 1)
+  {
+    ar & BOOST_SERIALIZATION_NVP(deletedPoints);
+  }
+  else if (Archive::is_loading::value)
+  {
+    deletedPoints.clear();
+    deletedPoints.resize(referenceSet.n_cols, false);
+  }
+
   ar & BOOST_SERIALIZATION_NVP(distanceEvaluations);
 }
 
@@ -0,0 +1,153 @@
+/**
+ * @file methods/matrix_completion/als_matrix_completion.cpp
+ * @author Stephen Tu
+ *
+ * Implementation of the ALSMatrixCompletion class.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+
+#include "als_matrix_completion.hpp"
+
+namespace mlpack {
+namespace matrix_completion {
+
+ALSMatrixCompletion::ALSMatrixCompletion(const size_t m,
+                                         const size_t n,
+                                         const arma::umat& indices,
+                                         const arma::vec& values,
+                                         const size_t r,
+                                         const double lambda,
+                                         const size_t maxIterations,
+                                         const double tolerance) :
+    m(m), n(n), indices(indices), values(values), rank(r), lambda(lambda),
+    maxIterations(maxIterations), tolerance(tolerance)
+{
+  CheckValues();
+}
+
+void ALSMatrixCompletion::CheckValues()
+{
+  if (indices.n_rows != 2)
+  {
+    Log::Fatal << "ALSMatrixCompletion::CheckValues(): matrix of constraint "
+        << "indices does not have 2 rows!" << std::endl;
+  }
+
+  if (indices.n_cols != values.n_elem)
+  {
+    Log::Fatal << "ALSMatrixCompletion::CheckValues(): the number of "
+        << "constraint indices (columns of constraint indices matrix) does "
+        << "not match the number of constraint values (length of constraint "
+        << "value vector)!" << std::endl;
+  }
+
+  for (size_t i = 0; i < values.n_elem; i++)
+  {
+    if (indices(0, i) >= m || indices(1, i) >= n)
+      Log::Fatal << "ALSMatrixCompletion::CheckValues(): indices ("
+          << indices(0, i) << ", " << indices(1, i)
+          << ") are out of bounds for matrix of size " << m << " x n!"
+          << std::endl;
+  }
+}
+
+void ALSMatrixCompletion::Recover(arma::mat& recovered)
+{
+  Timer::Start("als_matrix_completion");
+
+  // Group the observed entries by row and by column, so each row (column)
+  // solve can walk only its own observations.
+  std::vector<std::vector<size_t>> rowEntries(m), colEntries(n);
+  for (size_t i = 0; i < values.n_elem; ++i)
+  {
+    rowEntries[indices(0, i)].push_back(i);
+    colEntries[indices(1, i)].push_back(i);
+  }
+
+  // Initialize factors with small random values; the scaling keeps initial
+  // predictions on the order of the mean observed value.
+  const double scale = std::sqrt(
+      std::abs(arma::mean(values)) / (double) rank);
+  arma::mat w = scale * arma::randu<arma::mat>(m, rank);
+  arma::mat h = scale * arma::randu<arma::mat>(rank, n);
+
+  double lastResidual = DBL_MAX;
+  for (size_t iteration = 0; iteration < maxIterations; ++iteration)
+  {
+    // With H fixed, every row of W has an independent r x r normal-equations
+    // solve over that row's observed entries; solve the rows in parallel.
+    #pragma omp parallel for schedule(dynamic, 64)
+    for (omp_size_t i = 0; i < (omp_size_t) m; ++i)
+    {
+      const std::vector<size_t>& observed = rowEntries[i];
+      if (observed.empty())
+        continue;
+
+      arma::mat lhs(rank, rank, arma::fill::zeros);
+      arma::vec rhs(rank, arma::fill::zeros);
+      for (size_t index : observed)
+      {
+        const arma::vec hj = h.col(indices(1, index));
+        lhs += hj * hj.t();
+        rhs += values(index) * hj;
+      }
+      lhs.diag() += lambda * observed.size();
+
+      w.row(i) = arma::solve(lhs, rhs).t();
+    }
+
+    // Symmetric update for the columns of H with W fixed.
+    #pragma omp parallel for schedule(dynamic, 64)
+    for (omp_size_t j = 0; j < (omp_size_t) n; ++j)
+    {
+      const std::vector<size_t>& observed = colEntries[j];
+      if (observed.empty())
+        continue;
+
+      arma::mat lhs(rank, rank, arma::fill::zeros);
+      arma::vec rhs(rank, arma::fill::zeros);
+      for (size_t index : observed)
+      {
+        const arma::vec wi = w.row(indices(0, index)).t();
+        lhs += wi * wi.t();
+        rhs += values(index) * wi;
+      }
+      lhs.diag() += lambda * observed.size();
+
+      h.col(j) = arma::solve(lhs, rhs);
+    }
+
+    // Compute the RMSE over the observed entries for convergence checking.
+    double squaredError = 0.0;
+    #pragma omp parallel for reduction(+:squaredError)
+    for (omp_size_t i = 0; i < (omp_size_t) values.n_elem; ++i)
+    {
+      const double diff = arma::dot(w.row(indices(0, i)),
+          h.col(indices(1, i))) - values(i);
+      squaredError += diff * diff;
+    }
+    const double residual = std::sqrt(squaredError / values.n_elem);
+
+    Log::Info << "ALSMatrixCompletion::Recover(): iteration " << iteration
+        << ", observed RMSE " << residual << "." << std::endl;
+
+    if (lastResidual - residual < tolerance)
+    {
+      Log::Info << "ALSMatrixCompletion::Recover(): converged within "
+          << "tolerance " << tolerance << "." << std::endl;
+      break;
+    }
+    lastResidual = residual;
+  }
+
+  recovered = w * h;
+
+  Timer::Stop("als_matrix_completion");
+}
+
+} // namespace matrix_completion
+} // namespace mlpack
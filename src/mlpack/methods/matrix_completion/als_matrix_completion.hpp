@@ -0,0 +1,134 @@
+/**
+ * @file methods/matrix_completion/als_matrix_completion.hpp
+ * @author Stephen Tu
+ *
+ * A factorization-based matrix completion solver using alternating least
+ * squares over the observed entries.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_MATRIX_COMPLETION_ALS_MATRIX_COMPLETION_HPP
+#define MLPACK_METHODS_MATRIX_COMPLETION_ALS_MATRIX_COMPLETION_HPP
+
+#include <mlpack/prereqs.hpp>
+
+namespace mlpack {
+namespace matrix_completion {
+
+/**
+ * This class implements matrix completion by regularized low-rank
+ * factorization.  Given known values M_ij, it seeks factors W (m x r) and
+ * H (r x n) minimizing
+ *
+ *   sum_{(i,j) observed} (M_ij - (W H)_ij)^2
+ *       + lambda * (||W||_F^2 + ||H||_F^2)
+ *
+ * by alternating least squares: with H fixed, every row of W has a closed
+ * form r x r solve that depends only on that row's observed entries, so all
+ * rows are solved in parallel; likewise for the columns of H.
+ *
+ * Unlike the semidefinite programming approach of MatrixCompletion, this
+ * solver only touches the observed entries and r x r systems, so it scales to
+ * problems far beyond the reach of the SDP at the price of a non-convex
+ * formulation and approximate (rather than exactly interpolated) observed
+ * entries.  The interface mirrors MatrixCompletion: construct with the known
+ * entries, then call Recover().
+ *
+ * An example of how to use this class is shown below:
+ *
+ * @code
+ * size_t m, n;         // size of unknown matrix
+ * arma::umat indices;  // contains the known indices [2 x n_entries]
+ * arma::vec values;    // contains the known values [n_entries]
+ * arma::mat recovered; // will contain the completed matrix
+ *
+ * ALSMatrixCompletion mc(m, n, indices, values, 5);
+ * mc.Recover(recovered);
+ * @endcode
+ *
+ * @see MatrixCompletion
+ */
+class ALSMatrixCompletion
+{
+ public:
+  /**
+   * Construct a factorization-based matrix completion problem.
+   *
+   * @param m Number of rows of original matrix.
+   * @param n Number of columns of original matrix.
+   * @param indices Matrix containing the indices of the known entries (must be
+   *    [2 x p]).
+   * @param values Vector containing the values of the known entries (must be
+   *    length p).
+   * @param r Rank of the factorization.
+   * @param lambda Regularization parameter for the factor norms.
+   * @param maxIterations Maximum number of ALS sweeps.
+   * @param tolerance Terminate when the observed-entry RMSE improves by less
+   *    than this between sweeps.
+   */
+  ALSMatrixCompletion(const size_t m,
+                      const size_t n,
+                      const arma::umat& indices,
+                      const arma::vec& values,
+                      const size_t r,
+                      const double lambda = 0.1,
+                      const size_t maxIterations = 50,
+                      const double tolerance = 1e-6);
+
+  /**
+   * Run the alternating least squares optimization and fill in the remaining
+   * values.
+   *
+   * @param recovered Will contain the completed matrix.
+   */
+  void Recover(arma::mat& recovered);
+
+  //! Get the rank of the factorization.
+  size_t Rank() const { return rank; }
+  //! Modify the rank of the factorization.
+  size_t& Rank() { return rank; }
+
+  //! Get the regularization parameter.
+  double Lambda() const { return lambda; }
+  //! Modify the regularization parameter.
+  double& Lambda() { return lambda; }
+
+  //! Get the maximum number of ALS sweeps.
+  size_t MaxIterations() const { return maxIterations; }
+  //! Modify the maximum number of ALS sweeps.
+  size_t& MaxIterations() { return maxIterations; }
+
+  //! Get the convergence tolerance.
+  double Tolerance() const { return tolerance; }
+  //! Modify the convergence tolerance.
+  double& Tolerance() { return tolerance; }
+
+ private:
+  //! Number of rows in original matrix.
+  size_t m;
+  //! Number of columns in original matrix.
+  size_t n;
+  //! Matrix containing the indices of the known entries (has two rows).
+  arma::umat indices;
+  //! Vector containing the values of the known entries.
+  arma::vec values;
+  //! Rank of the factorization.
+  size_t rank;
+  //! Regularization parameter for the factor norms.
+  double lambda;
+  //! Maximum number of ALS sweeps.
+  size_t maxIterations;
+  //! Convergence tolerance on the observed-entry RMSE.
+  double tolerance;
+
+  //! Validate the input matrices.
+  void CheckValues();
+};
+
+} // namespace matrix_completion
+} // namespace mlpack
+
+#endif
@@ -212,53 +212,97 @@ inline void MeanShift<UseKernel, KernelType, MatType>::Cluster(
   std::vector<std::vector<size_t> > neighbors;
   std::vector<std::vector<double> > distances;
 
-  // For each seed, perform mean shift algorithm.
+  // Initial centroids are the seeds themselves.
   for (size_t i = 0; i < pSeeds->n_cols; ++i)
-  {
-    // Initial centroid is the seed itself.
     allCentroids.col(i) = pSeeds->unsafe_col(i);
-    for (size_t completedIterations = 0; completedIterations < maxIterations
-        || forceConvergence; completedIterations++)
+
+  // All seeds are shifted in lockstep: every iteration performs one batched
+  // dual-tree range search with the still-active seeds as the query set, so a
+  // single query tree (and one traversal of the shared reference tree) is
+  // amortized over every seed instead of one search per seed per iteration.
+  // Converged and empty seeds drop out of the query set as iterations go on.
+  std::vector<size_t> activeSeeds(pSeeds->n_cols);
+  for (size_t i = 0; i < pSeeds->n_cols; ++i)
+    activeSeeds[i] = i;
+  // std::vector<bool> is bit-packed and cannot be written concurrently.
+  std::vector<char> converged(pSeeds->n_cols, 0);
+
+  size_t completedIterations = 0;
+  while (!activeSeeds.empty() &&
+      (completedIterations < maxIterations || forceConvergence))
+  {
+    // Gather the active seed centroids into a single query set.
+    arma::mat querySet(pSeeds->n_rows, activeSeeds.size());
+    for (size_t j = 0; j < activeSeeds.size(); ++j)
+      querySet.col(j) = allCentroids.unsafe_col(activeSeeds[j]);
+
+    rangeSearcher.Search(querySet, validRadius, neighbors, distances);
+
+    // Shift each active seed towards its kernel-weighted mean.  Each seed only
+    // touches its own column of allCentroids, so this parallelizes cleanly.
+    std::vector<char> stillActive(activeSeeds.size(), 1);
+    #pragma omp parallel for schedule(dynamic, 64)
+    for (omp_size_t j = 0; j < (omp_size_t) activeSeeds.size(); ++j)
     {
-      // Store new centroid in this.
-      arma::colvec newCentroid = arma::zeros<arma::colvec>(pSeeds->n_rows);
+      const size_t i = activeSeeds[j];
 
-      rangeSearcher.Search(allCentroids.unsafe_col(i), validRadius,
-          neighbors, distances);
-      if (neighbors[0].size() == 0) // There are no points in the cluster.
-        break;
+      if (neighbors[j].size() == 0) // There are no points in the cluster.
+      {
+        stillActive[j] = 0;
+        continue;
+      }
 
       // Calculate new centroid.
-      if (!CalculateCentroid(data, neighbors[0], distances[0], newCentroid))
+      arma::colvec newCentroid = arma::zeros<arma::colvec>(pSeeds->n_rows);
+      if (!CalculateCentroid(data, neighbors[j], distances[j], newCentroid))
         newCentroid = allCentroids.unsafe_col(i);
 
       // If the mean shift vector is small enough, it has converged.
       if (metric::EuclideanDistance::Evaluate(newCentroid,
           allCentroids.unsafe_col(i)) < 1e-3 * radius)
       {
-        // Determine if the new centroid is duplicate with old ones.
-        bool isDuplicated = false;
-        for (size_t k = 0; k < centroids.n_cols; ++k)
-        {
-          const double distance = metric::EuclideanDistance::Evaluate(
-              allCentroids.unsafe_col(i), centroids.unsafe_col(k));
-          if (distance < radius)
-          {
-            isDuplicated = true;
-            break;
-          }
-        }
-
-        if (!isDuplicated)
-          centroids.insert_cols(centroids.n_cols, allCentroids.unsafe_col(i));
-
-        // Get out of the loop.
-        break;
+        converged[i] = 1;
+        stillActive[j] = 0;
+      }
+      else
+      {
+        // Update the centroid.
+        allCentroids.col(i) = newCentroid;
       }
+    }
 
-      // Update the centroid.
-      allCentroids.col(i) = newCentroid;
+    // Compact the active seed list.
+    size_t kept = 0;
+    for (size_t j = 0; j < activeSeeds.size(); ++j)
+      if (stillActive[j])
+        activeSeeds[kept++] = activeSeeds[j];
+    activeSeeds.resize(kept);
+
+    ++completedIterations;
+  }
+
+  // Collect the converged centroids in seed order, discarding those that
+  // duplicate an already-kept centroid.
+  for (size_t i = 0; i < pSeeds->n_cols; ++i)
+  {
+    if (!converged[i])
+      continue;
+
+    // Determine if the new centroid is duplicate with old ones.
+    bool isDuplicated = false;
+    for (size_t k = 0; k < centroids.n_cols; ++k)
+    {
+      const double distance = metric::EuclideanDistance::Evaluate(
+          allCentroids.unsafe_col(i), centroids.unsafe_col(k));
+      if (distance < radius)
+      {
+        isDuplicated = true;
+        break;
+      }
     }
+
+    if (!isDuplicated)
+      centroids.insert_cols(centroids.n_cols, allCentroids.unsafe_col(i));
   }
 
   // If no centroid has converged due to too little iterations and without
@@ -113,6 +113,18 @@ void NaiveBayesClassifier<ModelMatType>::Train(
     // Fist, de-normalize probabilities.
     probabilities *= trainingPoints;
 
+    // If the model has already seen points, de-normalize the variances back
+    // to unnormalized second moments (and remove the epsilon that was added
+    // after the previous call), so that this batch updates the sufficient
+    // statistics without revisiting the old data.
+    if (trainingPoints > 0)
+    {
+      variances -= epsilon;
+      for (size_t i = 0; i < probabilities.n_elem; ++i)
+        if (probabilities[i] > 2)
+          variances.col(i) *= (probabilities[i] - 1);
+    }
+
     for (size_t j = 0; j < data.n_cols; ++j)
     {
       const size_t label = labels[j];
@@ -171,8 +183,18 @@ void NaiveBayesClassifier<ModelMatType>::Train(
   // Add epsilon to prevent log of zero.
   variances += epsilon;
 
-  probabilities /= data.n_cols;
-  trainingPoints += data.n_cols;
+  // For incremental training the class counts cover every point seen so far,
+  // not just this batch; non-incremental training overwrites the model.
+  if (incremental)
+  {
+    probabilities /= (trainingPoints + data.n_cols);
+    trainingPoints += data.n_cols;
+  }
+  else
+  {
+    probabilities /= data.n_cols;
+    trainingPoints = data.n_cols;
+  }
 }
 
 template<typename ModelMatType>
@@ -210,24 +232,23 @@ void NaiveBayesClassifier<ModelMatType>::LogLikelihood(
       "NaiveBayesClassifier: element type of given data must match the element "
       "type of the model!");
 
-  logLikelihoods = arma::log(arma::repmat(probabilities, 1, data.n_cols));
-  ModelMatType invVar = 1.0 / variances;
-
-  // Calculate the joint log likelihood of point for each of the
-  // means.n_cols.
-
-  // Loop over every class.
-  for (size_t i = 0; i < means.n_cols; i++)
-  {
-    // This is an adaptation of gmm::phi() for the case where the covariance is
-    // a diagonal matrix.
-    ModelMatType diffs = data - arma::repmat(means.col(i), 1, data.n_cols);
-    ModelMatType rhs = -0.5 * arma::diagmat(invVar.col(i)) * diffs;
-    arma::Mat<ElemType> exponents = arma::sum(diffs % rhs, 0);
-
-    logLikelihoods.row(i) += (data.n_rows / -2.0 * log(2 * M_PI) - 0.5 *
-        arma::accu(arma::log(variances.col(i))) + exponents);
-  }
+  // The joint log likelihood of a point x for class i is
+  //   log P(i) - (d / 2) log(2 pi) - 0.5 sum_j log v_ij
+  //       - 0.5 sum_j (x_j - m_ij)^2 / v_ij,
+  // and expanding the square turns the calculation for the whole batch into
+  // two dense matrix products plus a per-class constant:
+  //   (m_i / v_i)^T x - 0.5 (1 / v_i)^T x^2 + const_i.
+  const ModelMatType invVar = 1.0 / variances;
+
+  // Per-class constant term (everything that does not depend on the point).
+  const arma::Col<ElemType> classConsts = arma::log(probabilities) -
+      (means.n_rows / 2.0) * std::log(2 * M_PI) -
+      0.5 * arma::sum(arma::log(variances), 0).t() -
+      0.5 * arma::sum(arma::square(means) % invVar, 0).t();
+
+  logLikelihoods = (means % invVar).t() * data -
+      0.5 * (invVar.t() * arma::square(data));
+  logLikelihoods.each_col() += classConsts;
 }
 
 template<typename ModelMatType>
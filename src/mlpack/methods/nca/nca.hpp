@@ -86,6 +86,18 @@ class NCA
   const OptimizerType& Optimizer() const { return optimizer; }
   OptimizerType& Optimizer() { return optimizer; }
 
+  //! Get the number of neighbors scanned by each stochastic evaluation of the
+  //! objective (0 means all points are scanned, giving the exact objective).
+  size_t NeighborhoodSize() const { return errorFunction.NeighborhoodSize(); }
+  //! Modify the number of neighbors scanned by each stochastic evaluation.
+  size_t& NeighborhoodSize() { return errorFunction.NeighborhoodSize(); }
+
+  //! Get the number of stochastic evaluations between neighborhood refreshes.
+  size_t UpdateInterval() const { return errorFunction.UpdateInterval(); }
+  //! Modify the number of stochastic evaluations between neighborhood
+  //! refreshes.
+  size_t& UpdateInterval() { return errorFunction.UpdateInterval(); }
+
  private:
   //! Dataset reference.
   const arma::mat& dataset;
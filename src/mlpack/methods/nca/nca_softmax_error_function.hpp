@@ -17,6 +17,7 @@
 #include <mlpack/core/metrics/lmetric.hpp>
 #include <mlpack/core/math/make_alias.hpp>
 #include <mlpack/core/math/shuffle_data.hpp>
+#include <mlpack/methods/neighbor_search/neighbor_search.hpp>
 
 namespace mlpack {
 namespace nca {
@@ -40,6 +41,15 @@ namespace nca {
  * optimizers use, overloads of Evaluate() and Gradient() are given which only
  * operate on one point in the dataset.  This is useful for optimizers like
  * stochastic gradient descent (see mlpack::optimization::SGD).
+ *
+ * For large datasets the O(n) scan over all points that each separable
+ * evaluation performs can be restricted to an approximate neighborhood: if
+ * NeighborhoodSize() is set to a nonzero value, only that many nearest
+ * neighbors of each point (found in the current projection, and refreshed
+ * every UpdateInterval() separable evaluations) are scanned.  Because the
+ * softmax weights decay exponentially with distance, far-away points
+ * contribute negligibly to p_i, and the approximation is typically very good
+ * for moderate neighborhood sizes.
  */
 template<typename MetricType = metric::SquaredEuclideanDistance>
 class SoftmaxErrorFunction
@@ -131,6 +141,18 @@ class SoftmaxErrorFunction
    */
   size_t NumFunctions() const { return dataset.n_cols; }
 
+  //! Get the number of neighbors scanned by each separable evaluation (0 means
+  //! all points are scanned, giving the exact objective).
+  size_t NeighborhoodSize() const { return neighborhoodSize; }
+  //! Modify the number of neighbors scanned by each separable evaluation.
+  size_t& NeighborhoodSize() { return neighborhoodSize; }
+
+  //! Get the number of separable evaluations between neighborhood refreshes.
+  size_t UpdateInterval() const { return updateInterval; }
+  //! Modify the number of separable evaluations between neighborhood
+  //! refreshes.
+  size_t& UpdateInterval() { return updateInterval; }
+
  private:
   //! The dataset.  This is an alias until Shuffle() is called.
   arma::mat dataset;
@@ -154,6 +176,29 @@ class SoftmaxErrorFunction
   //! False if nothing has ever been precalculated (only at construction time).
   bool precalculated;
 
+  //! Number of nearest neighbors each separable evaluation scans; if 0, all
+  //! points are scanned and the objective is exact.
+  size_t neighborhoodSize;
+  //! Number of separable evaluations between neighborhood refreshes.
+  size_t updateInterval;
+  //! Number of separable evaluations since the last neighborhood refresh.
+  size_t iteration;
+  //! Approximate nearest neighbors of each point (one column per point).
+  arma::Mat<size_t> neighbors;
+
+  //! Convenience typedef for the neighbor search type used for refreshes.
+  typedef neighbor::NeighborSearch<neighbor::NearestNeighborSort, MetricType>
+      KNN;
+
+  /**
+   * Rebuild the nearest neighbor lists in the projection given by the current
+   * coordinates.  Only called by the separable Evaluate() and Gradient() when
+   * NeighborhoodSize() is nonzero.
+   *
+   * @param coordinates Coordinates matrix defining the current projection.
+   */
+  void UpdateNeighborhood(const arma::mat& coordinates);
+
   /**
    * Precalculate the denominators and numerators that will make up the p_ij,
    * but only if the coordinates matrix is different than the last coordinates
@@ -29,7 +29,10 @@ SoftmaxErrorFunction<MetricType>::SoftmaxErrorFunction(
     dataset(math::MakeAlias(const_cast<arma::mat&>(dataset), false)),
     labels(math::MakeAlias(const_cast<arma::Row<size_t>&>(labels), false)),
     metric(metric),
-    precalculated(false)
+    precalculated(false),
+    neighborhoodSize(0),
+    updateInterval(100),
+    iteration(0)
 { /* nothing to do */ }
 
 //! Shuffle the dataset.
@@ -46,6 +49,10 @@ void SoftmaxErrorFunction<MetricType>::Shuffle()
 
   dataset = std::move(newDataset);
   labels = std::move(newLabels);
+
+  // The stored neighbor indices refer to the old point ordering; force a
+  // refresh on the next separable evaluation.
+  iteration = 0;
 }
 
 //! The non-separable implementation, which uses Precalculate() to save time.
@@ -66,18 +73,28 @@ double SoftmaxErrorFunction<MetricType>::Evaluate(const arma::mat& coordinates,
                                                   const size_t begin,
                                                   const size_t batchSize)
 {
-  // Unfortunately each evaluation will take O(N) time because it requires a
-  // scan over all points in the dataset.  Our objective is to compute p_i.
+  // Each evaluation takes O(N) time because it requires a scan over all
+  // points in the dataset, unless the neighborhood approximation is enabled,
+  // in which case only the stored nearest neighbors are scanned.  Our
+  // objective is to compute p_i.
   double denominator = 0;
   double numerator = 0;
   double result = 0;
 
+  const bool sampled = (neighborhoodSize > 0) &&
+      (neighborhoodSize < dataset.n_cols - 1);
+  if (sampled && ((iteration++ % updateInterval) == 0))
+    UpdateNeighborhood(coordinates);
+
   // It's quicker to do this now than one point at a time later.
   stretchedDataset = coordinates * dataset;
+  const size_t scanSize = sampled ? neighborhoodSize : dataset.n_cols;
   for (size_t i = begin; i < begin + batchSize; i++)
   {
-    for (size_t k = 0; k < dataset.n_cols; ++k)
+    for (size_t index = 0; index < scanSize; ++index)
     {
+      const size_t k = sampled ? neighbors(index, i) : index;
+
       // Don't consider the case where the points are the same.
       if (k == i)
         continue;
@@ -172,8 +189,14 @@ void SoftmaxErrorFunction<MetricType>::Gradient(const arma::mat& coordinates,
 
   gradient.zeros(coordinates.n_rows, coordinates.n_rows);
 
+  const bool sampled = (neighborhoodSize > 0) &&
+      (neighborhoodSize < dataset.n_cols - 1);
+  if (sampled && ((iteration++ % updateInterval) == 0))
+    UpdateNeighborhood(coordinates);
+
   // Compute the stretched dataset.
   stretchedDataset = coordinates * dataset;
+  const size_t scanSize = sampled ? neighborhoodSize : dataset.n_cols;
   for (size_t i = begin; i < begin + batchSize; i++)
   {
     numerator = 0;
@@ -182,8 +205,10 @@ void SoftmaxErrorFunction<MetricType>::Gradient(const arma::mat& coordinates,
     firstTerm.zeros(coordinates.n_rows, coordinates.n_cols);
     secondTerm.zeros(coordinates.n_rows, coordinates.n_cols);
 
-    for (size_t k = 0; k < dataset.n_cols; ++k)
+    for (size_t index = 0; index < scanSize; ++index)
     {
+      const size_t k = sampled ? neighbors(index, i) : index;
+
       // Don't consider the case where the points are the same.
       if (i == k)
         continue;
@@ -237,6 +262,20 @@ const arma::mat SoftmaxErrorFunction<MetricType>::GetInitialPoint() const
   return arma::eye<arma::mat>(dataset.n_rows, dataset.n_rows);
 }
 
+template<typename MetricType>
+void SoftmaxErrorFunction<MetricType>::UpdateNeighborhood(
+    const arma::mat& coordinates)
+{
+  // Build a nearest neighbor index on the current projection.  The projection
+  // drifts slowly between stochastic steps, so the lists remain a good
+  // approximation until the next refresh.
+  stretchedDataset = coordinates * dataset;
+
+  KNN knn(stretchedDataset);
+  arma::mat distances;
+  knn.Search(neighborhoodSize, neighbors, distances);
+}
+
 template<typename MetricType>
 void SoftmaxErrorFunction<MetricType>::Precalculate(
     const arma::mat& coordinates)
@@ -0,0 +1,184 @@
+/**
+ * @file methods/neighbor_search/flat_ns_model.hpp
+ *
+ * A flat, memory-mappable on-disk format for kd-tree nearest neighbor search
+ * models.  Unlike the boost::serialization format used by NSModel, a flat
+ * model is written as a handful of plain arrays (node topology, bounds,
+ * point permutation, dataset), so loading it is a single mmap() call: no
+ * deserialization pass, no peak-memory doubling, and the page cache shares
+ * the mapping across processes.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_NEIGHBOR_SEARCH_FLAT_NS_MODEL_HPP
+#define MLPACK_METHODS_NEIGHBOR_SEARCH_FLAT_NS_MODEL_HPP
+
+#include <mlpack/prereqs.hpp>
+#include <mlpack/core/tree/binary_space_tree.hpp>
+
+namespace mlpack {
+namespace neighbor {
+
+/**
+ * FlatKNNModel is a read-only k-nearest-neighbor search structure backed by a
+ * flat on-disk file.  A model is written once with Save(), from a kd-tree
+ * that has already been built (typically the reference tree of a
+ * NeighborSearch object), and can then be loaded with Load(), which maps the
+ * file read-only instead of deserializing it.  Queries can be issued
+ * immediately after Load() returns; the kernel pages in node and point data
+ * on demand.
+ *
+ * The format is host-endian and host-layout; it is intended as a fast
+ * serving format, not as a portable interchange format.  Only kd-trees
+ * (BinarySpaceTree with HRectBound) over dense double matrices are
+ * supported.
+ *
+ * Example:
+ *
+ * @code
+ * // Offline: build and save.
+ * std::vector<size_t> oldFromNew;
+ * KDTree<EuclideanDistance, NeighborSearchStat<NearestNeighborSort>,
+ *     arma::mat> tree(referenceSet, oldFromNew);
+ * FlatKNNModel::Save("model.flat", tree, oldFromNew);
+ *
+ * // Online: map and query.
+ * FlatKNNModel model;
+ * model.Load("model.flat");
+ * model.Search(querySet, 5, neighbors, distances);
+ * @endcode
+ */
+class FlatKNNModel
+{
+ public:
+  //! Create an empty model; call Load() before searching.
+  FlatKNNModel();
+
+  //! Unmap the file (if one is mapped).
+  ~FlatKNNModel();
+
+  //! A flat model wraps a file mapping, so it cannot be copied.
+  FlatKNNModel(const FlatKNNModel&) = delete;
+  FlatKNNModel& operator=(const FlatKNNModel&) = delete;
+
+  /**
+   * Write the given kd-tree to the given file in the flat format.  The tree
+   * must be the root of its tree, and oldFromNew must be the permutation
+   * that was filled when the tree was built, so that Search() can report
+   * neighbor indices in the original dataset ordering.
+   *
+   * @param filename File to write the model to.
+   * @param tree Built kd-tree (root node).
+   * @param oldFromNew Mapping from tree point indices to original indices.
+   */
+  template<typename TreeType>
+  static void Save(const std::string& filename,
+                   const TreeType& tree,
+                   const std::vector<size_t>& oldFromNew);
+
+  /**
+   * Map the given flat model file read-only.  This replaces any model that
+   * is currently loaded.  Throws std::runtime_error if the file cannot be
+   * opened or is not a valid flat model.
+   *
+   * @param filename File to map.
+   */
+  void Load(const std::string& filename);
+
+  /**
+   * Search for the k nearest neighbors of every point in the query set.
+   * Neighbor indices refer to the original (pre-build) ordering of the
+   * reference set.
+   *
+   * @param querySet Query points (one point per column).
+   * @param k Number of neighbors to find.
+   * @param neighbors Matrix to store neighbor indices into.
+   * @param distances Matrix to store neighbor distances into.
+   */
+  void Search(const arma::mat& querySet,
+              const size_t k,
+              arma::Mat<size_t>& neighbors,
+              arma::mat& distances) const;
+
+  //! Get the dimensionality of the mapped reference set.
+  size_t Dimensionality() const { return dims; }
+  //! Get the number of points in the mapped reference set.
+  size_t ReferenceSetSize() const { return numPoints; }
+  //! Get the number of tree nodes in the mapped model.
+  size_t NumNodes() const { return numNodes; }
+
+ private:
+  //! On-disk per-node record; nodes are stored in preorder.
+  struct FlatNode
+  {
+    //! Index of the left child, or numNodes if this is a leaf.
+    uint64_t left;
+    //! Index of the right child, or numNodes if this is a leaf.
+    uint64_t right;
+    //! First point held by this node.
+    uint64_t begin;
+    //! Number of points held by this node.
+    uint64_t count;
+  };
+
+  //! On-disk file header.
+  struct FlatHeader
+  {
+    //! Magic bytes identifying the format ("mlpkFKD1").
+    char magic[8];
+    //! Size of one dataset element, in bytes (must be sizeof(double)).
+    uint64_t elemSize;
+    //! Dimensionality of the dataset.
+    uint64_t dims;
+    //! Number of points in the dataset.
+    uint64_t numPoints;
+    //! Number of tree nodes.
+    uint64_t numNodes;
+  };
+
+  //! Compute the squared minimum distance between a query point and a node's
+  //! bound.
+  double MinDistance(const double* query, const size_t node) const;
+
+  //! Recursively search the subtree rooted at the given node.
+  void SearchNode(const double* query,
+                  const size_t node,
+                  const size_t k,
+                  std::vector<std::pair<double, size_t>>& heap) const;
+
+  //! Unmap the currently mapped file, if any.
+  void Unmap();
+
+  //! Base address of the mapping (NULL if no model is loaded).
+  void* mapping;
+  //! Length of the mapping, in bytes.
+  size_t mappingLength;
+
+  //! Pointer to the node array inside the mapping.
+  const FlatNode* nodes;
+  //! Pointer to the bound array inside the mapping; each node has dims
+  //! (lo, hi) pairs.
+  const double* bounds;
+  //! Pointer to the point permutation inside the mapping.
+  const uint64_t* oldFromNew;
+  //! Pointer to the column-major dataset inside the mapping.
+  const double* dataset;
+
+  //! Dimensionality of the dataset.
+  size_t dims;
+  //! Number of points in the dataset.
+  size_t numPoints;
+  //! Number of tree nodes.
+  size_t numNodes;
+};
+
+} // namespace neighbor
+} // namespace mlpack
+
+// Include implementation.
+#include "flat_ns_model_impl.hpp"
+
+#endif
@@ -0,0 +1,345 @@
+/**
+ * @file methods/neighbor_search/flat_ns_model_impl.hpp
+ *
+ * Implementation of the flat, memory-mappable kd-tree model format.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_NEIGHBOR_SEARCH_FLAT_NS_MODEL_IMPL_HPP
+#define MLPACK_METHODS_NEIGHBOR_SEARCH_FLAT_NS_MODEL_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "flat_ns_model.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <functional>
+
+#ifndef _WIN32
+  #include <fcntl.h>
+  #include <sys/mman.h>
+  #include <sys/stat.h>
+  #include <unistd.h>
+#endif
+
+namespace mlpack {
+namespace neighbor {
+
+inline FlatKNNModel::FlatKNNModel() :
+    mapping(NULL),
+    mappingLength(0),
+    nodes(NULL),
+    bounds(NULL),
+    oldFromNew(NULL),
+    dataset(NULL),
+    dims(0),
+    numPoints(0),
+    numNodes(0)
+{
+  // Nothing to do.
+}
+
+inline FlatKNNModel::~FlatKNNModel()
+{
+  Unmap();
+}
+
+template<typename TreeType>
+void FlatKNNModel::Save(const std::string& filename,
+                        const TreeType& tree,
+                        const std::vector<size_t>& oldFromNew)
+{
+  const arma::mat& data = tree.Dataset();
+  if (oldFromNew.size() != data.n_cols)
+    throw std::invalid_argument("FlatKNNModel::Save(): oldFromNew size does "
+        "not match the number of points in the tree's dataset!");
+
+  // Collect the nodes in preorder; a worklist of (node, parent record slot)
+  // is not needed because the preorder index of each child can be computed
+  // as the nodes are visited.
+  std::vector<FlatNode> flatNodes;
+  std::vector<double> flatBounds;
+  const size_t treeDims = data.n_rows;
+
+  // Recursive preorder flattening; returns the index of the flattened node.
+  std::function<uint64_t(const TreeType&)> flatten =
+      [&](const TreeType& node) -> uint64_t
+  {
+    const uint64_t index = flatNodes.size();
+    flatNodes.push_back(FlatNode());
+    flatNodes[index].begin = node.Begin();
+    flatNodes[index].count = node.Count();
+
+    for (size_t d = 0; d < treeDims; ++d)
+    {
+      flatBounds.push_back(node.Bound()[d].Lo());
+      flatBounds.push_back(node.Bound()[d].Hi());
+    }
+
+    // These are filled after the children are flattened, since the vector
+    // may reallocate during recursion.
+    const uint64_t left = (node.Left() != NULL) ? flatten(*node.Left()) :
+        uint64_t(-1);
+    const uint64_t right = (node.Right() != NULL) ? flatten(*node.Right()) :
+        uint64_t(-1);
+    flatNodes[index].left = left;
+    flatNodes[index].right = right;
+    return index;
+  };
+  flatten(tree);
+
+  // Use the node count as the "no child" sentinel.
+  for (size_t i = 0; i < flatNodes.size(); ++i)
+  {
+    if (flatNodes[i].left == uint64_t(-1))
+      flatNodes[i].left = flatNodes.size();
+    if (flatNodes[i].right == uint64_t(-1))
+      flatNodes[i].right = flatNodes.size();
+  }
+
+  FlatHeader header;
+  std::memcpy(header.magic, "mlpkFKD1", 8);
+  header.elemSize = sizeof(double);
+  header.dims = treeDims;
+  header.numPoints = data.n_cols;
+  header.numNodes = flatNodes.size();
+
+  std::ofstream f(filename, std::ios::binary);
+  if (!f.is_open())
+    throw std::runtime_error("FlatKNNModel::Save(): cannot open file '" +
+        filename + "' for writing!");
+
+  std::vector<uint64_t> permutation(oldFromNew.begin(), oldFromNew.end());
+
+  f.write((const char*) &header, sizeof(header));
+  f.write((const char*) flatNodes.data(),
+      flatNodes.size() * sizeof(FlatNode));
+  f.write((const char*) flatBounds.data(),
+      flatBounds.size() * sizeof(double));
+  f.write((const char*) permutation.data(),
+      permutation.size() * sizeof(uint64_t));
+  f.write((const char*) data.memptr(),
+      data.n_elem * sizeof(double));
+
+  if (!f.good())
+    throw std::runtime_error("FlatKNNModel::Save(): error writing to file '" +
+        filename + "'!");
+}
+
+inline void FlatKNNModel::Load(const std::string& filename)
+{
+  Unmap();
+
+#ifndef _WIN32
+  const int fd = open(filename.c_str(), O_RDONLY);
+  if (fd < 0)
+    throw std::runtime_error("FlatKNNModel::Load(): cannot open file '" +
+        filename + "'!");
+
+  struct stat st;
+  if (fstat(fd, &st) != 0)
+  {
+    close(fd);
+    throw std::runtime_error("FlatKNNModel::Load(): cannot stat file '" +
+        filename + "'!");
+  }
+  mappingLength = (size_t) st.st_size;
+
+  // A read-only shared mapping: pages are backed by the file and shared with
+  // any other process that maps the same model.
+  mapping = mmap(NULL, mappingLength, PROT_READ, MAP_SHARED, fd, 0);
+  close(fd); // The mapping keeps its own reference to the file.
+  if (mapping == MAP_FAILED)
+  {
+    mapping = NULL;
+    throw std::runtime_error("FlatKNNModel::Load(): mmap() of file '" +
+        filename + "' failed!");
+  }
+#else
+  // Windows fallback: read the whole file into memory.  Still a single
+  // sequential read with no deserialization pass.
+  std::ifstream f(filename, std::ios::binary | std::ios::ate);
+  if (!f.is_open())
+    throw std::runtime_error("FlatKNNModel::Load(): cannot open file '" +
+        filename + "'!");
+  mappingLength = (size_t) f.tellg();
+  f.seekg(0);
+  mapping = new char[mappingLength];
+  f.read((char*) mapping, mappingLength);
+#endif
+
+  if (mappingLength < sizeof(FlatHeader))
+  {
+    Unmap();
+    throw std::runtime_error("FlatKNNModel::Load(): file '" + filename +
+        "' is too short to be a flat model!");
+  }
+
+  const FlatHeader* header = (const FlatHeader*) mapping;
+  if (std::memcmp(header->magic, "mlpkFKD1", 8) != 0 ||
+      header->elemSize != sizeof(double))
+  {
+    Unmap();
+    throw std::runtime_error("FlatKNNModel::Load(): file '" + filename +
+        "' is not a valid flat model!");
+  }
+
+  dims = header->dims;
+  numPoints = header->numPoints;
+  numNodes = header->numNodes;
+
+  const size_t expectedLength = sizeof(FlatHeader) +
+      numNodes * sizeof(FlatNode) +
+      numNodes * dims * 2 * sizeof(double) +
+      numPoints * sizeof(uint64_t) +
+      numPoints * dims * sizeof(double);
+  if (mappingLength < expectedLength)
+  {
+    Unmap();
+    throw std::runtime_error("FlatKNNModel::Load(): file '" + filename +
+        "' is truncated!");
+  }
+
+  const char* base = (const char*) mapping + sizeof(FlatHeader);
+  nodes = (const FlatNode*) base;
+  base += numNodes * sizeof(FlatNode);
+  bounds = (const double*) base;
+  base += numNodes * dims * 2 * sizeof(double);
+  oldFromNew = (const uint64_t*) base;
+  base += numPoints * sizeof(uint64_t);
+  dataset = (const double*) base;
+}
+
+inline void FlatKNNModel::Unmap()
+{
+  if (mapping != NULL)
+  {
+#ifndef _WIN32
+    munmap(mapping, mappingLength);
+#else
+    delete[] (char*) mapping;
+#endif
+  }
+  mapping = NULL;
+  mappingLength = 0;
+  nodes = NULL;
+  bounds = NULL;
+  oldFromNew = NULL;
+  dataset = NULL;
+  dims = 0;
+  numPoints = 0;
+  numNodes = 0;
+}
+
+inline double FlatKNNModel::MinDistance(const double* query,
+                                        const size_t node) const
+{
+  // Squared minimum distance between the query point and the node's
+  // hyperrectangle bound.
+  const double* b = bounds + node * dims * 2;
+  double sum = 0.0;
+  for (size_t d = 0; d < dims; ++d)
+  {
+    const double lo = b[2 * d];
+    const double hi = b[2 * d + 1];
+    double diff = 0.0;
+    if (query[d] < lo)
+      diff = lo - query[d];
+    else if (query[d] > hi)
+      diff = query[d] - hi;
+    sum += diff * diff;
+  }
+  return sum;
+}
+
+inline void FlatKNNModel::SearchNode(
+    const double* query,
+    const size_t node,
+    const size_t k,
+    std::vector<std::pair<double, size_t>>& heap) const
+{
+  const FlatNode& n = nodes[node];
+  if (n.left == numNodes)
+  {
+    // Leaf: scan the points held by this node.
+    for (uint64_t i = n.begin; i < n.begin + n.count; ++i)
+    {
+      const double* point = dataset + i * dims;
+      double dist = 0.0;
+      for (size_t d = 0; d < dims; ++d)
+      {
+        const double diff = query[d] - point[d];
+        dist += diff * diff;
+      }
+
+      if (heap.size() < k)
+      {
+        heap.push_back(std::make_pair(dist, (size_t) i));
+        std::push_heap(heap.begin(), heap.end());
+      }
+      else if (dist < heap.front().first)
+      {
+        std::pop_heap(heap.begin(), heap.end());
+        heap.back() = std::make_pair(dist, (size_t) i);
+        std::push_heap(heap.begin(), heap.end());
+      }
+    }
+    return;
+  }
+
+  // Descend into the nearer child first; the farther child can then often be
+  // pruned against the current k-th best distance.
+  const double leftDist = MinDistance(query, n.left);
+  const double rightDist = MinDistance(query, n.right);
+  const size_t first = (leftDist <= rightDist) ? n.left : n.right;
+  const size_t second = (leftDist <= rightDist) ? n.right : n.left;
+  const double secondDist = std::max(leftDist, rightDist);
+
+  SearchNode(query, first, k, heap);
+  if (heap.size() < k || secondDist < heap.front().first)
+    SearchNode(query, second, k, heap);
+}
+
+inline void FlatKNNModel::Search(const arma::mat& querySet,
+                                 const size_t k,
+                                 arma::Mat<size_t>& neighbors,
+                                 arma::mat& distances) const
+{
+  if (mapping == NULL)
+    throw std::runtime_error("FlatKNNModel::Search(): no model is loaded!");
+  if (querySet.n_rows != dims)
+    throw std::invalid_argument("FlatKNNModel::Search(): query set "
+        "dimensionality does not match the reference set!");
+  if (k > numPoints)
+    throw std::invalid_argument("FlatKNNModel::Search(): requested more "
+        "neighbors than there are reference points!");
+
+  neighbors.set_size(k, querySet.n_cols);
+  distances.set_size(k, querySet.n_cols);
+
+  #pragma omp parallel for schedule(dynamic)
+  for (omp_size_t q = 0; q < (omp_size_t) querySet.n_cols; ++q)
+  {
+    std::vector<std::pair<double, size_t>> heap;
+    heap.reserve(k);
+    SearchNode(querySet.colptr(q), 0, k, heap);
+
+    // Extract the results in ascending order of distance, mapping point
+    // indices back to the original dataset ordering.
+    std::sort_heap(heap.begin(), heap.end());
+    for (size_t j = 0; j < k; ++j)
+    {
+      neighbors(j, q) = (size_t) oldFromNew[heap[j].second];
+      distances(j, q) = std::sqrt(heap[j].first);
+    }
+  }
+}
+
+} // namespace neighbor
+} // namespace mlpack
+
+#endif
@@ -99,13 +99,16 @@ PARAM_INT_IN("seed", "Random seed (if 0, std::time(NULL) is used).", "s", 0);
 
 // Search settings.
 PARAM_STRING_IN("algorithm", "Type of neighbor search: 'naive', 'single_tree', "
-    "'dual_tree', 'greedy'.", "a", "dual_tree");
+    "'dual_tree', 'greedy', 'best_first'.", "a", "dual_tree");
 PARAM_DOUBLE_IN("epsilon", "If specified, will do approximate furthest neighbor"
     " search with given relative error. Must be in the range [0,1).", "e", 0);
 PARAM_DOUBLE_IN("percentage", "If specified, will do approximate furthest "
     "neighbor search. Must be in the range (0,1] (decimal form). Resultant "
     "neighbors will be at least (p*100) % of the distance as the true furthest "
     "neighbor.", "p", 1);
+PARAM_INT_IN("leaf_visit_budget", "Maximum number of leaves to visit per query "
+    "point (only valid for the 'best_first' algorithm; 0 means no limit).",
+    "L", 0);
 
 static void mlpackMain()
 {
@@ -169,12 +172,21 @@ static void mlpackMain()
   if (CLI::HasParam("percentage"))
     epsilon = 1 - percentage;
 
+  // Sanity check on the leaf visit budget.
+  RequireParamValue<int>("leaf_visit_budget", [](int x) { return x >= 0; },
+      true, "leaf visit budget must be non-negative");
+  const size_t leafVisitBudget =
+      (size_t) CLI::GetParam<int>("leaf_visit_budget");
+  if (CLI::GetParam<string>("algorithm") != "best_first")
+    ReportIgnoredParam("leaf_visit_budget", "best-first search is not being "
+        "used");
+
   // We either have to load the reference data, or we have to load the model.
   NSModel<FurthestNS>* kfn;
 
   const string algorithm = CLI::GetParam<string>("algorithm");
   RequireParamInSet<string>("algorithm", { "naive", "single_tree", "dual_tree",
-      "greedy" }, true, "unknown neighbor search algorithm");
+      "greedy", "best_first" }, true, "unknown neighbor search algorithm");
   NeighborSearchMode searchMode = DUAL_TREE_MODE;
 
   if (algorithm == "naive")
@@ -185,6 +197,8 @@ static void mlpackMain()
     searchMode = DUAL_TREE_MODE;
   else if (algorithm == "greedy")
     searchMode = GREEDY_SINGLE_TREE_MODE;
+  else if (algorithm == "best_first")
+    searchMode = BEST_FIRST_SINGLE_TREE_MODE;
 
   if (CLI::HasParam("reference"))
   {
@@ -237,6 +251,7 @@ static void mlpackMain()
 
     kfn->BuildModel(std::move(referenceSet), size_t(lsInt), searchMode,
         epsilon);
+    kfn->LeafVisitBudget() = leafVisitBudget;
   }
   else
   {
@@ -246,6 +261,7 @@ static void mlpackMain()
     // Adjust search mode.
     kfn->SearchMode() = searchMode;
     kfn->Epsilon() = epsilon;
+    kfn->LeafVisitBudget() = leafVisitBudget;
 
     // If leaf_size wasn't provided, let's consider the current value in the
     // loaded model.  Else, update it (only considered when building the query
@@ -12,12 +12,16 @@
  */
 #include <mlpack/prereqs.hpp>
 #include <mlpack/core/util/cli.hpp>
+#include <mlpack/core/data/load.hpp>
+#include <mlpack/core/data/save.hpp>
+#include <mlpack/core/data/save_async.hpp>
 #include <mlpack/core/metrics/lmetric.hpp>
 #include <mlpack/core/tree/cover_tree.hpp>
 #include <mlpack/core/util/mlpack_main.hpp>
 
 #include <string>
 #include <fstream>
+#include <sstream>
 #include <iostream>
 
 #include "neighbor_search.hpp"
@@ -60,7 +64,23 @@ PROGRAM_INFO("k-Nearest-Neighbors Search",
     "output matrix corresponds to the index of the point in the reference set "
     "which is the j'th nearest neighbor from the point in the query set with "
     "index i.  Row j and column i in the distances output matrix corresponds to"
-    " the distance between those two points.",
+    " the distance between those two points."
+    "\n\n"
+    "A whole sweep of query files can be processed in one invocation by "
+    "passing a manifest with " + PRINT_PARAM_STRING("query_manifest") + ".  "
+    "Each line of the manifest holds a query file name, optionally followed "
+    "by the neighbors and distances output file names; when the output names "
+    "are omitted, they default to the query file name with '.neighbors.csv' "
+    "and '.distances.csv' appended.  Every file is searched against the same "
+    "model, so the model load (or tree build) cost is paid only once for the "
+    "whole sweep, and each file's results are written as soon as it is done."
+    "\n\n"
+    "If the " + PRINT_PARAM_STRING("calibrate") + " parameter is set, the "
+    "tree type, leaf size and search algorithm are chosen automatically: "
+    "candidate configurations are timed on a sample of the reference set and "
+    "the fastest one is used for the full build.  The chosen configuration is "
+    "saved with the model if " + PRINT_PARAM_STRING("output_model") + " is "
+    "given.",
     SEE_ALSO("@lsh", "#lsh"),
     SEE_ALSO("@krann", "#krann"),
     SEE_ALSO("@kfn", "#kfn"),
@@ -89,6 +109,9 @@ PARAM_MODEL_OUT(KNNModel, "output_model", "If specified, the kNN model will be "
 // The user may specify a query file of query points and a number of nearest
 // neighbors to search for.
 PARAM_MATRIX_IN("query", "Matrix containing query points (optional).", "q");
+PARAM_STRING_IN("query_manifest", "File containing a list of query files to "
+    "process against the same model in one invocation; see the description "
+    "for the line format.", "Q", "");
 PARAM_INT_IN("k", "Number of nearest neighbors to find.", "k", 0);
 
 // The user may specify the type of tree to use, and a few parameters for tree
@@ -111,9 +134,16 @@ PARAM_INT_IN("seed", "Random seed (if 0, std::time(NULL) is used).", "s", 0);
 
 // Search settings.
 PARAM_STRING_IN("algorithm", "Type of neighbor search: 'naive', 'single_tree', "
-    "'dual_tree', 'greedy'.", "a", "dual_tree");
+    "'dual_tree', 'greedy', 'best_first'.", "a", "dual_tree");
 PARAM_DOUBLE_IN("epsilon", "If specified, will do approximate nearest neighbor "
     "search with given relative error.", "e", 0);
+PARAM_INT_IN("leaf_visit_budget", "Maximum number of leaves to visit per query "
+    "point (only valid for the 'best_first' algorithm; 0 means no limit).",
+    "L", 0);
+PARAM_FLAG("calibrate", "If set, the tree type, leaf size, and search mode "
+    "are chosen automatically by timing candidate configurations on a sample "
+    "of the reference set; the tree_type, leaf_size, and algorithm parameters "
+    "are then ignored.", "c");
 
 static void mlpackMain()
 {
@@ -127,6 +157,10 @@ static void mlpackMain()
 
   ReportIgnoredParam({{ "input_model", true }}, "tree_type");
   ReportIgnoredParam({{ "input_model", true }}, "random_basis");
+  ReportIgnoredParam({{ "input_model", true }}, "calibrate");
+  ReportIgnoredParam({{ "calibrate", true }}, "tree_type");
+  ReportIgnoredParam({{ "calibrate", true }}, "leaf_size");
+  ReportIgnoredParam({{ "calibrate", true }}, "algorithm");
   ReportIgnoredParam({{ "input_model", true }}, "tau");
   ReportIgnoredParam({{ "input_model", true }}, "rho");
   if (CLI::HasParam("input_model") && CLI::HasParam("leaf_size"))
@@ -153,6 +187,14 @@ static void mlpackMain()
   ReportIgnoredParam({{ "k", false }}, "true_neighbors");
   ReportIgnoredParam({{ "k", false }}, "true_distances");
   ReportIgnoredParam({{ "k", false }}, "query");
+  ReportIgnoredParam({{ "k", false }}, "query_manifest");
+
+  // There is only one way to specify query data.
+  if (CLI::HasParam("query") && CLI::HasParam("query_manifest"))
+  {
+    Log::Fatal << "Can only pass one of " << PRINT_PARAM_STRING("query")
+        << " or " << PRINT_PARAM_STRING("query_manifest") << "!" << endl;
+  }
 
   // Sanity check on leaf size.
   RequireParamValue<int>("leaf_size", [](int x) { return x > 0; },
@@ -181,12 +223,21 @@ static void mlpackMain()
   RequireParamValue<double>("epsilon", [](double x) { return x >= 0.0; }, true,
       "epsilon must be positive");
 
+  // Sanity check on the leaf visit budget.
+  RequireParamValue<int>("leaf_visit_budget", [](int x) { return x >= 0; },
+      true, "leaf visit budget must be non-negative");
+  const size_t leafVisitBudget =
+      (size_t) CLI::GetParam<int>("leaf_visit_budget");
+  if (CLI::GetParam<string>("algorithm") != "best_first")
+    ReportIgnoredParam("leaf_visit_budget", "best-first search is not being "
+        "used");
+
   // We either have to load the reference data, or we have to load the model.
   KNNModel* knn;
 
   const string algorithm = CLI::GetParam<string>("algorithm");
   RequireParamInSet<string>("algorithm", { "naive", "single_tree", "dual_tree",
-      "greedy" }, true, "unknown neighbor search algorithm");
+      "greedy", "best_first" }, true, "unknown neighbor search algorithm");
   NeighborSearchMode searchMode = DUAL_TREE_MODE;
 
   if (algorithm == "naive")
@@ -197,6 +248,8 @@ static void mlpackMain()
     searchMode = DUAL_TREE_MODE;
   else if (algorithm == "greedy")
     searchMode = GREEDY_SINGLE_TREE_MODE;
+  else if (algorithm == "best_first")
+    searchMode = BEST_FIRST_SINGLE_TREE_MODE;
 
   if (CLI::HasParam("reference"))
   {
@@ -253,8 +306,20 @@ static void mlpackMain()
 
     arma::mat referenceSet = std::move(CLI::GetParam<arma::mat>("reference"));
 
-    knn->BuildModel(std::move(referenceSet), size_t(lsInt), searchMode,
-        epsilon);
+    if (CLI::HasParam("calibrate"))
+    {
+      // The probe searches should reflect the real workload; if no k was
+      // given (only a model is being built), calibrate for a single neighbor.
+      const size_t calibrationK = CLI::HasParam("k") ?
+          (size_t) CLI::GetParam<int>("k") : 1;
+      knn->BuildModelAutoTuned(std::move(referenceSet), calibrationK, epsilon);
+    }
+    else
+    {
+      knn->BuildModel(std::move(referenceSet), size_t(lsInt), searchMode,
+          epsilon);
+    }
+    knn->LeafVisitBudget() = leafVisitBudget;
   }
   else
   {
@@ -264,6 +329,7 @@ static void mlpackMain()
     // Adjust search mode.
     knn->SearchMode() = searchMode;
     knn->Epsilon() = epsilon;
+    knn->LeafVisitBudget() = leafVisitBudget;
 
     // If leaf_size wasn't provided, let's consider the current value in the
     // loaded model.  Else, update it (only considered when building the query
@@ -277,8 +343,96 @@ static void mlpackMain()
         << " dataset)." << endl;
   }
 
-  // Perform search, if desired.
-  if (CLI::HasParam("k"))
+  // Perform search over a manifest of query files, if desired.
+  if (CLI::HasParam("k") && CLI::HasParam("query_manifest"))
+  {
+    const size_t k = (size_t) CLI::GetParam<int>("k");
+
+    // Sanity check on k value: must be greater than 0, must be less than or
+    // equal to the number of reference points.  Since it is unsigned, we only
+    // test the upper bound.
+    if (k > knn->Dataset().n_cols)
+    {
+      // Clean memory if needed before crashing.
+      const size_t referencePoints = knn->Dataset().n_cols;
+      if (CLI::HasParam("reference"))
+        delete knn;
+      Log::Fatal << "Invalid k: " << k << "; must be greater than 0 and less "
+          << "than or equal to the number of reference points ("
+          << referencePoints << ")." << endl;
+    }
+
+    const string manifestFile = CLI::GetParam<string>("query_manifest");
+    ifstream manifest(manifestFile.c_str());
+    if (!manifest.is_open())
+    {
+      // Clean memory if needed before crashing.
+      if (CLI::HasParam("reference"))
+        delete knn;
+      Log::Fatal << "Cannot open query manifest file '" << manifestFile
+          << "'!" << endl;
+    }
+
+    // Each line of the manifest holds a query file, optionally followed by
+    // the neighbors and distances output files.  Results are written as soon
+    // as each file finishes, so the model load and tree build costs are paid
+    // only once for the whole sweep.  The files are processed one at a time:
+    // the search itself already runs the traversals in parallel, and the
+    // loaded model's search state is shared, so per-file parallelism would
+    // only add contention.
+    string line;
+    size_t processed = 0;
+    while (getline(manifest, line))
+    {
+      istringstream lineStream(line);
+      string queryFile;
+      // Skip blank lines and comments.
+      if (!(lineStream >> queryFile) || queryFile[0] == '#')
+        continue;
+
+      string neighborsFile, distancesFile;
+      lineStream >> neighborsFile >> distancesFile;
+      if (neighborsFile.empty())
+        neighborsFile = queryFile + ".neighbors.csv";
+      if (distancesFile.empty())
+        distancesFile = queryFile + ".distances.csv";
+
+      // A bad entry skips to the next file instead of ending the sweep.
+      arma::mat queryData;
+      if (!data::Load(queryFile, queryData, false))
+      {
+        Log::Warn << "Unable to load query file '" << queryFile << "'; "
+            << "skipping!" << endl;
+        continue;
+      }
+
+      if (queryData.n_rows != knn->Dataset().n_rows)
+      {
+        Log::Warn << "Query file '" << queryFile << "' has invalid dimensions "
+            << "(" << queryData.n_rows << ", should be "
+            << knn->Dataset().n_rows << "); skipping!" << endl;
+        continue;
+      }
+
+      Log::Info << "Searching query file '" << queryFile << "' ("
+          << queryData.n_rows << "x" << queryData.n_cols << ")." << endl;
+
+      arma::Mat<size_t> neighbors;
+      arma::mat distances;
+      knn->Search(std::move(queryData), k, neighbors, distances);
+
+      // Hand the results to the background writer, so this file's outputs
+      // are written while the next file is being searched.
+      data::SaveAsync(neighborsFile, std::move(neighbors), false);
+      data::SaveAsync(distancesFile, std::move(distances), false);
+      ++processed;
+    }
+
+    data::WaitForSaves();
+    Log::Info << "Processed " << processed << " query files from '"
+        << manifestFile << "'." << endl;
+  }
+  else if (CLI::HasParam("k"))
   {
     const size_t k = (size_t) CLI::GetParam<int>("k");
 
@@ -40,7 +40,8 @@ enum NeighborSearchMode
   NAIVE_MODE,
   SINGLE_TREE_MODE,
   DUAL_TREE_MODE,
-  GREEDY_SINGLE_TREE_MODE
+  GREEDY_SINGLE_TREE_MODE,
+  BEST_FIRST_SINGLE_TREE_MODE
 };
 
 /**
@@ -217,6 +218,10 @@ class NeighborSearch
    * worthwhile to set singleMode = false (either in the constructor or with
    * SingleMode()).
    *
+   * When OpenMP is enabled and more than one thread is available, single-tree
+   * and dual-tree searches shard the query set across the threads; the
+   * results are identical to the serial search.
+   *
    * @param querySet Set of query points (can be just one point).
    * @param k Number of neighbors to search for.
    * @param neighbors Matrix storing lists of neighbors for each query point.
@@ -321,6 +326,13 @@ class NeighborSearch
   //! Modify the relative error to be considered in approximate search.
   double& Epsilon() { return epsilon; }
 
+  //! Access the maximum number of leaves visited per query in best-first
+  //! search (0 means no limit).
+  size_t LeafVisitBudget() const { return leafVisitBudget; }
+  //! Modify the maximum number of leaves visited per query in best-first
+  //! search (0 means no limit).
+  size_t& LeafVisitBudget() { return leafVisitBudget; }
+
   //! Access the reference dataset.
   const MatType& ReferenceSet() const { return *referenceSet; }
 
@@ -345,6 +357,9 @@ class NeighborSearch
   NeighborSearchMode searchMode;
   //! Indicates the relative error to be considered in approximate search.
   double epsilon;
+  //! The maximum number of leaves visited per query in best-first search; 0
+  //! means no limit.
+  size_t leafVisitBudget;
 
   //! Instantiation of metric.
   MetricType metric;
@@ -361,6 +376,17 @@ class NeighborSearch
   //! The NSModel class should have access to internal members.
   template<typename SortPol>
   friend class TrainVisitor;
+
+  //! Search sessions reuse our tree, metric, and mappings directly.
+  template<typename SessionSortPolicy,
+           typename SessionMetricType,
+           typename SessionMatType,
+           template<typename TreeMetricType,
+                    typename TreeStatType,
+                    typename TreeMatType> class SessionTreeType,
+           template<typename> class SessionDualTreeTraversalType,
+           template<typename> class SessionSingleTreeTraversalType>
+  friend class NeighborSearchSession;
 }; // class NeighborSearch
 
 } // namespace neighbor
@@ -14,10 +14,16 @@
 #define MLPACK_METHODS_NEIGHBOR_SEARCH_NEIGHBOR_SEARCH_IMPL_HPP
 
 #include <mlpack/prereqs.hpp>
+#include <mlpack/core/tree/batch_greedy_single_tree_traverser.hpp>
 #include <mlpack/core/tree/greedy_single_tree_traverser.hpp>
+#include <mlpack/core/tree/best_first_single_tree_traverser.hpp>
 #include "neighbor_search_rules.hpp"
 #include <mlpack/core/tree/spill_tree/is_spill_tree.hpp>
 
+#ifdef HAS_OPENMP
+  #include <omp.h>
+#endif
+
 namespace mlpack {
 namespace neighbor {
 
@@ -65,6 +71,7 @@ SingleTreeTraversalType>::NeighborSearch(MatType referenceSetIn,
         &referenceTree->Dataset()),
     searchMode(mode),
     epsilon(epsilon),
+    leafVisitBudget(0),
     metric(metric),
     baseCases(0),
     scores(0),
@@ -92,6 +99,7 @@ SingleTreeTraversalType>::NeighborSearch(Tree referenceTree,
     referenceSet(&this->referenceTree->Dataset()),
     searchMode(mode),
     epsilon(epsilon),
+    leafVisitBudget(0),
     metric(metric),
     baseCases(0),
     scores(0),
@@ -118,6 +126,7 @@ SingleTreeTraversalType>::NeighborSearch(const NeighborSearchMode mode,
     referenceSet(mode == NAIVE_MODE ? new MatType() : NULL), // Empty matrix.
     searchMode(mode),
     epsilon(epsilon),
+    leafVisitBudget(0),
     metric(metric),
     baseCases(0),
     scores(0),
@@ -152,6 +161,7 @@ SingleTreeTraversalType>::NeighborSearch(const NeighborSearch& other) :
         new MatType(*other.referenceSet)),
     searchMode(other.searchMode),
     epsilon(other.epsilon),
+    leafVisitBudget(other.leafVisitBudget),
     metric(other.metric),
     baseCases(other.baseCases),
     scores(other.scores),
@@ -176,6 +186,7 @@ SingleTreeTraversalType>::NeighborSearch(NeighborSearch&& other) :
     referenceSet(other.referenceSet),
     searchMode(other.searchMode),
     epsilon(other.epsilon),
+    leafVisitBudget(other.leafVisitBudget),
     metric(std::move(other.metric)),
     baseCases(other.baseCases),
     scores(other.scores),
@@ -187,6 +198,7 @@ SingleTreeTraversalType>::NeighborSearch(NeighborSearch&& other) :
   other.referenceSet = &other.referenceTree->Dataset();
   other.searchMode = DUAL_TREE_MODE,
   other.epsilon = 0.0;
+  other.leafVisitBudget = 0;
   other.baseCases = 0;
   other.scores = 0;
   other.treeNeedsReset = false;
@@ -229,6 +241,7 @@ NeighborSearch<SortPolicy,
       new MatType(*other.referenceSet);
   searchMode = other.searchMode;
   epsilon = other.epsilon;
+  leafVisitBudget = other.leafVisitBudget;
   metric = other.metric;
   baseCases = other.baseCases;
   scores = other.scores;
@@ -271,6 +284,7 @@ NeighborSearch<SortPolicy,
   referenceSet = other.referenceSet;
   searchMode = other.searchMode;
   epsilon = other.epsilon;
+  leafVisitBudget = other.leafVisitBudget;
   metric = other.metric;
   baseCases = other.baseCases;
   scores = other.scores;
@@ -285,6 +299,7 @@ NeighborSearch<SortPolicy,
   other.referenceSet = &other.referenceTree->Dataset();
   other.searchMode = DUAL_TREE_MODE,
   other.epsilon = 0.0;
+  other.leafVisitBudget = 0;
   other.baseCases = 0;
   other.scores = 0;
   other.treeNeedsReset = false;
@@ -440,10 +455,10 @@ DualTreeTraversalType, SingleTreeTraversalType>::Search(
       // Create the helper object for the tree traversal.
       RuleType rules(*referenceSet, querySet, k, metric, epsilon);
 
-      // The naive brute-force traversal.
+      // The naive brute-force traversal, with batched distance computations
+      // for each query point.
       for (size_t i = 0; i < querySet.n_cols; ++i)
-        for (size_t j = 0; j < referenceSet->n_cols; ++j)
-          rules.BaseCase(i, j);
+        rules.AllBaseCases(i);
 
       baseCases += querySet.n_cols * referenceSet->n_cols;
 
@@ -455,6 +470,60 @@ DualTreeTraversalType, SingleTreeTraversalType>::Search(
       // Create the helper object for the tree traversal.
       RuleType rules(*referenceSet, querySet, k, metric, epsilon);
 
+      // If more than one thread is available, shard the query set across the
+      // threads, giving each its own copy of the rules (the per-query
+      // candidate lists are independent, but the base case cache and the
+      // counters are not).  Each thread extracts and stores the results for
+      // its own shard, so the shared output matrices are written without
+      // contention.
+#ifdef HAS_OPENMP
+      const size_t numThreads = (size_t) omp_get_max_threads();
+      if (numThreads > 1 && querySet.n_cols > 1)
+      {
+        size_t parallelScores = 0;
+        size_t parallelBaseCases = 0;
+
+        #pragma omp parallel reduction(+: parallelScores, parallelBaseCases)
+        {
+          const size_t thread = (size_t) omp_get_thread_num();
+          const size_t actualThreads = (size_t) omp_get_num_threads();
+          const size_t shardBegin = (thread * querySet.n_cols) / actualThreads;
+          const size_t shardEnd =
+              ((thread + 1) * querySet.n_cols) / actualThreads;
+
+          if (shardEnd > shardBegin)
+          {
+            RuleType localRules(rules);
+            SingleTreeTraversalType<RuleType> traverser(localRules);
+
+            for (size_t i = shardBegin; i < shardEnd; ++i)
+              traverser.Traverse(i, *referenceTree);
+
+            parallelScores += localRules.Scores();
+            parallelBaseCases += localRules.BaseCases();
+
+            arma::Mat<size_t> shardNeighbors;
+            arma::mat shardDistances;
+            localRules.GetResults(shardNeighbors, shardDistances);
+
+            neighborPtr->cols(shardBegin, shardEnd - 1) =
+                shardNeighbors.cols(shardBegin, shardEnd - 1);
+            distancePtr->cols(shardBegin, shardEnd - 1) =
+                shardDistances.cols(shardBegin, shardEnd - 1);
+          }
+        }
+
+        scores += parallelScores;
+        baseCases += parallelBaseCases;
+
+        Log::Info << parallelScores << " node combinations were scored."
+            << std::endl;
+        Log::Info << parallelBaseCases << " base cases were calculated."
+            << std::endl;
+        break;
+      }
+#endif
+
       // Create the traverser.
       SingleTreeTraversalType<RuleType> traverser(rules);
 
@@ -475,6 +544,77 @@ DualTreeTraversalType, SingleTreeTraversalType>::Search(
     }
     case DUAL_TREE_MODE:
     {
+      // If more than one thread is available and the query set is large
+      // enough, shard the query set across the threads.  Each thread builds a
+      // query tree on its own shard and runs an independent dual-tree
+      // traversal against the shared reference tree; the shard mappings are
+      // applied inline, so oldFromNewQueries is left as the identity for the
+      // mapping code below.
+#ifdef HAS_OPENMP
+      const size_t numThreads = (size_t) omp_get_max_threads();
+      if (numThreads > 1 && querySet.n_cols >= 2 * numThreads)
+      {
+        size_t parallelScores = 0;
+        size_t parallelBaseCases = 0;
+
+        #pragma omp parallel reduction(+: parallelScores, parallelBaseCases)
+        {
+          const size_t thread = (size_t) omp_get_thread_num();
+          const size_t actualThreads = (size_t) omp_get_num_threads();
+          const size_t shardBegin = (thread * querySet.n_cols) / actualThreads;
+          const size_t shardEnd =
+              ((thread + 1) * querySet.n_cols) / actualThreads;
+
+          if (shardEnd > shardBegin)
+          {
+            std::vector<size_t> shardOldFromNew;
+            MatType shardQueries(querySet.cols(shardBegin, shardEnd - 1));
+            Tree* shardTree = BuildTree<Tree>(std::move(shardQueries),
+                shardOldFromNew);
+
+            RuleType localRules(*referenceSet, shardTree->Dataset(), k, metric,
+                epsilon);
+            DualTreeTraversalType<RuleType> traverser(localRules);
+            traverser.Traverse(*shardTree, *referenceTree);
+
+            parallelScores += localRules.Scores();
+            parallelBaseCases += localRules.BaseCases();
+
+            arma::Mat<size_t> shardNeighbors;
+            arma::mat shardDistances;
+            localRules.GetResults(shardNeighbors, shardDistances);
+
+            // Map the shard-local query indices back to global columns; the
+            // shards are disjoint, so there is no write contention.
+            for (size_t i = 0; i < shardNeighbors.n_cols; ++i)
+            {
+              const size_t globalCol = shardBegin +
+                  (tree::TreeTraits<Tree>::RearrangesDataset ?
+                      shardOldFromNew[i] : i);
+              neighborPtr->col(globalCol) = shardNeighbors.col(i);
+              distancePtr->col(globalCol) = shardDistances.col(i);
+            }
+
+            delete shardTree;
+          }
+        }
+
+        scores += parallelScores;
+        baseCases += parallelBaseCases;
+
+        Log::Info << parallelScores << " node combinations were scored."
+            << std::endl;
+        Log::Info << parallelBaseCases << " base cases were calculated."
+            << std::endl;
+
+        // The query mapping was applied inline above.
+        oldFromNewQueries.resize(querySet.n_cols);
+        for (size_t i = 0; i < querySet.n_cols; ++i)
+          oldFromNewQueries[i] = i;
+        break;
+      }
+#endif
+
       // Build the query tree.
       Timer::Stop("computing_neighbors");
       Timer::Start("tree_building");
@@ -508,12 +648,42 @@ DualTreeTraversalType, SingleTreeTraversalType>::Search(
       // Create the helper object for the tree traversal.
       RuleType rules(*referenceSet, querySet, k, metric);
 
-      // Create the traverser.
-      tree::GreedySingleTreeTraverser<Tree, RuleType> traverser(rules);
+      // Create the traverser.  The batched traverser pushes all of the query
+      // points down the tree together, so the top levels of the tree are only
+      // touched once instead of once per query.
+      tree::BatchGreedySingleTreeTraverser<Tree, RuleType> traverser(rules);
 
       // Set the value of minBaseCases.
       traverser.MinBaseCases() = k;
 
+      // Now have it traverse with the whole query set.
+      std::vector<size_t> queryIndices(querySet.n_cols);
+      for (size_t i = 0; i < querySet.n_cols; ++i)
+        queryIndices[i] = i;
+      traverser.Traverse(queryIndices, *referenceTree);
+
+      scores += rules.Scores();
+      baseCases += rules.BaseCases();
+
+      Log::Info << rules.Scores() << " node combinations were scored."
+          << std::endl;
+      Log::Info << rules.BaseCases() << " base cases were calculated."
+          << std::endl;
+
+      rules.GetResults(*neighborPtr, *distancePtr);
+      break;
+    }
+    case BEST_FIRST_SINGLE_TREE_MODE:
+    {
+      // Create the helper object for the tree traversal.
+      RuleType rules(*referenceSet, querySet, k, metric, epsilon);
+
+      // Create the traverser.
+      tree::BestFirstSingleTreeTraverser<Tree, RuleType> traverser(rules);
+
+      // Set the leaf visit budget (0 means no limit).
+      traverser.MaxLeafVisits() = leafVisitBudget;
+
       // Now have it traverse for each point.
       for (size_t i = 0; i < querySet.n_cols; ++i)
         traverser.Traverse(i, *referenceTree);
@@ -737,10 +907,10 @@ DualTreeTraversalType, SingleTreeTraversalType>::Search(
   {
     case NAIVE_MODE:
     {
-      // The naive brute-force solution.
+      // The naive brute-force solution, with batched distance computations
+      // for each query point.
       for (size_t i = 0; i < referenceSet->n_cols; ++i)
-        for (size_t j = 0; j < referenceSet->n_cols; ++j)
-          rules.BaseCase(i, j);
+        rules.AllBaseCases(i);
 
       baseCases += referenceSet->n_cols * referenceSet->n_cols;
       break;
@@ -816,12 +986,37 @@ DualTreeTraversalType, SingleTreeTraversalType>::Search(
     }
     case GREEDY_SINGLE_TREE_MODE:
     {
-      // Create the traverser.
-      tree::GreedySingleTreeTraverser<Tree, RuleType> traverser(rules);
+      // Create the traverser.  The batched traverser pushes all of the query
+      // points down the tree together, so the top levels of the tree are only
+      // touched once instead of once per query.
+      tree::BatchGreedySingleTreeTraverser<Tree, RuleType> traverser(rules);
 
       // Set the value of minBaseCases.
       traverser.MinBaseCases() = k;
 
+      // Now have it traverse with the whole query set.
+      std::vector<size_t> queryIndices(referenceSet->n_cols);
+      for (size_t i = 0; i < referenceSet->n_cols; ++i)
+        queryIndices[i] = i;
+      traverser.Traverse(queryIndices, *referenceTree);
+
+      scores += rules.Scores();
+      baseCases += rules.BaseCases();
+
+      Log::Info << rules.Scores() << " node combinations were scored."
+          << std::endl;
+      Log::Info << rules.BaseCases() << " base cases were calculated."
+          << std::endl;
+      break;
+    }
+    case BEST_FIRST_SINGLE_TREE_MODE:
+    {
+      // Create the traverser.
+      tree::BestFirstSingleTreeTraverser<Tree, RuleType> traverser(rules);
+
+      // Set the leaf visit budget (0 means no limit).
+      traverser.MaxLeafVisits() = leafVisitBudget;
+
       // Now have it traverse for each point.
       for (size_t i = 0; i < referenceSet->n_cols; ++i)
         traverser.Traverse(i, *referenceTree);
@@ -13,7 +13,9 @@
 #ifndef MLPACK_METHODS_NEIGHBOR_SEARCH_NEIGHBOR_SEARCH_RULES_HPP
 #define MLPACK_METHODS_NEIGHBOR_SEARCH_NEIGHBOR_SEARCH_RULES_HPP
 
+#include <mlpack/core/metrics/pairwise_distances.hpp>
 #include <mlpack/core/tree/traversal_info.hpp>
+#include <mlpack/core/util/arena.hpp>
 
 #include <queue>
 
@@ -35,6 +37,9 @@ template<typename SortPolicy, typename MetricType, typename TreeType>
 class NeighborSearchRules
 {
  public:
+  //! Convenience typedef.
+  typedef typename tree::TraversalInfo<TreeType> TraversalInfoType;
+
   /**
    * Construct the NeighborSearchRules object.  This is usually done from within
    * the NeighborSearch class at search time.
@@ -54,6 +59,16 @@ class NeighborSearchRules
                       const double epsilon = 0,
                       const bool sameSet = false);
 
+  /**
+   * Copy the given NeighborSearchRules object.  The copy opens a fresh scope
+   * on the copying thread's arena and deep-copies the candidate heaps into
+   * it, so the parallel traversals can hand each worker thread its own copy
+   * of the rules.
+   *
+   * @param other Rules object to copy.
+   */
+  NeighborSearchRules(const NeighborSearchRules& other);
+
   /**
    * Store the list of candidates for each query point in the given matrices.
    *
@@ -63,6 +78,28 @@ class NeighborSearchRules
    */
   void GetResults(arma::Mat<size_t>& neighbors, arma::mat& distances);
 
+  /**
+   * Reset the rules to the state they were in just after construction, so
+   * that the object can be reused for another traversal over the same query
+   * and reference sets.  This refills the candidate lists (which GetResults()
+   * empties) and clears the base case cache and the counters.
+   */
+  void Reset();
+
+  /**
+   * Merge the results accumulated by another rules object over a disjoint
+   * set of query points into this one.  Every candidate held by the other
+   * object is offered to the matching candidate heap of this one (draining
+   * the other object's heaps), and the other object's base case and score
+   * counters are folded in.  This is how parallel traversals that give each
+   * thread its own copy of the rules combine the per-thread results; the
+   * query points the copies produced results for must be disjoint, since
+   * candidates appearing in several copies would be inserted repeatedly.
+   *
+   * @param other Rules object whose results will be merged into this one.
+   */
+  void MergeResults(NeighborSearchRules& other);
+
   /**
    * Get the distance from the query point to the reference point.
    * This will update the list of candidates with the new point if appropriate
@@ -73,6 +110,35 @@ class NeighborSearchRules
    */
   double BaseCase(const size_t queryIndex, const size_t referenceIndex);
 
+  /**
+   * Perform the base case for the given query point against every reference
+   * point at once, using batched distance computations.  This is used by the
+   * brute-force (naive) search mode, where every pair is evaluated anyway and
+   * the per-pair metric calls would dominate the runtime.
+   *
+   * @param queryIndex Index of query point.
+   */
+  void AllBaseCases(const size_t queryIndex);
+
+  /**
+   * Perform the base cases between all pairs of points of two leaves at
+   * once: the whole leaf-vs-leaf distance block is computed with one batched
+   * call (for the L2 family, a single matrix product selected at compile
+   * time by PairwiseDistanceRule), and the candidate heaps are updated from
+   * the block.  The per-query prune that the pairwise traversal performs is
+   * preserved.  This is picked up by dual-tree traversers over trees whose
+   * leaves are contiguous column ranges of the dataset (see the
+   * BinarySpaceTree dual-tree traverser).
+   *
+   * @param queryNode Query leaf node.
+   * @param referenceNode Reference leaf node.
+   * @param parentInfo Traversal info of the parent node combination.
+   * @return The number of base cases performed.
+   */
+  size_t LeafBaseCases(TreeType& queryNode,
+                       TreeType& referenceNode,
+                       const TraversalInfoType& parentInfo);
+
   /**
    * Get the score for recursion order.  A low score indicates priority for
    * recursion, while DBL_MAX indicates that the node should not be recursed
@@ -149,9 +215,6 @@ class NeighborSearchRules
   //! Modify the number of scores that have been performed.
   size_t& Scores() { return scores; }
 
-  //! Convenience typedef.
-  typedef typename tree::TraversalInfo<TreeType> TraversalInfoType;
-
   //! Get the traversal info.
   const TraversalInfoType& TraversalInfo() const { return traversalInfo; }
   //! Modify the traversal info.
@@ -175,10 +238,18 @@ class NeighborSearchRules
     };
   };
 
-  //! Use a priority queue to represent the list of candidate neighbors.
-  typedef std::priority_queue<Candidate, std::vector<Candidate>, CandidateCmp>
+  //! Use a priority queue to represent the list of candidate neighbors.  The
+  //! heaps are traversal scratch, so their storage comes from the per-thread
+  //! arena instead of the general-purpose allocator.
+  typedef std::priority_queue<Candidate,
+      std::vector<Candidate, util::ArenaAllocator<Candidate>>, CandidateCmp>
       CandidateList;
 
+  //! Reclaims the arena storage of the candidate heaps when the rules object
+  //! is destroyed.  This must be declared before the candidates themselves so
+  //! that it is destroyed after them.
+  util::Arena::Scope arenaScope;
+
   //! Set of candidate neighbors for each point.
   std::vector<CandidateList> candidates;
 
@@ -194,6 +265,14 @@ class NeighborSearchRules
   //! Relative error to be considered in approximate search.
   const double epsilon;
 
+  //! Scratch space for the batched distances computed by AllBaseCases(),
+  //! kept as a member to avoid reallocations.
+  arma::vec batchDistances;
+
+  //! Scratch space for the leaf-vs-leaf distance blocks computed by
+  //! LeafBaseCases(), kept as a member to avoid reallocations.
+  arma::mat blockDistances;
+
   //! The last query point BaseCase() was called with.
   size_t lastQueryIndex;
   //! The last reference point BaseCase() was called with.
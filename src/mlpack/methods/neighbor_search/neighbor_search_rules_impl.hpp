@@ -51,7 +51,7 @@ NeighborSearchRules<SortPolicy, MetricType, TreeType>::NeighborSearchRules(
   const Candidate def = std::make_pair(SortPolicy::WorstDistance(),
       size_t() - 1);
 
-  std::vector<Candidate> vect(k, def);
+  std::vector<Candidate, util::ArenaAllocator<Candidate>> vect(k, def);
   CandidateList pqueue(CandidateCmp(), std::move(vect));
 
   candidates.reserve(querySet.n_cols);
@@ -59,6 +59,34 @@ NeighborSearchRules<SortPolicy, MetricType, TreeType>::NeighborSearchRules(
     candidates.push_back(pqueue);
 }
 
+template<typename SortPolicy, typename MetricType, typename TreeType>
+NeighborSearchRules<SortPolicy, MetricType, TreeType>::NeighborSearchRules(
+    const NeighborSearchRules& other) :
+    referenceSet(other.referenceSet),
+    querySet(other.querySet),
+    candidates(other.candidates),
+    k(other.k),
+    metric(other.metric),
+    sameSet(other.sameSet),
+    epsilon(other.epsilon),
+    batchDistances(other.batchDistances),
+    blockDistances(other.blockDistances),
+    lastQueryIndex(other.lastQueryIndex),
+    lastReferenceIndex(other.lastReferenceIndex),
+    baseCases(other.baseCases),
+    scores(other.scores),
+    traversalInfo(other.traversalInfo)
+{
+  // The arena scope member is declared (and thus default-constructed) before
+  // the candidate heaps, so their copies are carved out of the copying
+  // thread's arena and reclaimed when this object is destroyed.
+
+  // Only copy the cached base case if the cache is valid; otherwise it is
+  // uninitialized.
+  if (other.lastQueryIndex < querySet.n_cols)
+    lastBaseCase = other.lastBaseCase;
+}
+
 template<typename SortPolicy, typename MetricType, typename TreeType>
 void NeighborSearchRules<SortPolicy, MetricType, TreeType>::GetResults(
     arma::Mat<size_t>& neighbors,
@@ -79,6 +107,48 @@ void NeighborSearchRules<SortPolicy, MetricType, TreeType>::GetResults(
   }
 };
 
+template<typename SortPolicy, typename MetricType, typename TreeType>
+void NeighborSearchRules<SortPolicy, MetricType, TreeType>::Reset()
+{
+  traversalInfo = TraversalInfoType();
+  traversalInfo.LastQueryNode() = (TreeType*) this;
+  traversalInfo.LastReferenceNode() = (TreeType*) this;
+
+  lastQueryIndex = querySet.n_cols;
+  lastReferenceIndex = referenceSet.n_cols;
+  baseCases = 0;
+  scores = 0;
+
+  // Refill the candidate lists, exactly as the constructor does.
+  const Candidate def = std::make_pair(SortPolicy::WorstDistance(),
+      size_t() - 1);
+
+  std::vector<Candidate, util::ArenaAllocator<Candidate>> vect(k, def);
+  CandidateList pqueue(CandidateCmp(), std::move(vect));
+
+  candidates.assign(querySet.n_cols, pqueue);
+}
+
+template<typename SortPolicy, typename MetricType, typename TreeType>
+void NeighborSearchRules<SortPolicy, MetricType, TreeType>::MergeResults(
+    NeighborSearchRules& other)
+{
+  for (size_t i = 0; i < querySet.n_cols; ++i)
+  {
+    CandidateList& pqueue = other.candidates[i];
+    while (!pqueue.empty())
+    {
+      // Sentinel candidates left over from the initial fill never beat a
+      // heap top, so untouched query points are no-ops here.
+      InsertNeighbor(i, pqueue.top().second, pqueue.top().first);
+      pqueue.pop();
+    }
+  }
+
+  baseCases += other.baseCases;
+  scores += other.scores;
+}
+
 template<typename SortPolicy, typename MetricType, typename TreeType>
 inline force_inline // Absolutely MUST be inline so optimizations can happen.
 double NeighborSearchRules<SortPolicy, MetricType, TreeType>::
@@ -107,6 +177,89 @@ BaseCase(const size_t queryIndex, const size_t referenceIndex)
   return distance;
 }
 
+template<typename SortPolicy, typename MetricType, typename TreeType>
+inline void NeighborSearchRules<SortPolicy, MetricType, TreeType>::
+AllBaseCases(const size_t queryIndex)
+{
+  // Compute the distances to all reference points with one batched call; for
+  // the LMetric family this is vectorized instead of one call per pair.
+  metric::PairwiseDistances(querySet.col(queryIndex), referenceSet,
+      batchDistances, metric);
+
+  CandidateList& pqueue = candidates[queryIndex];
+  for (size_t j = 0; j < referenceSet.n_cols; ++j)
+  {
+    // If the datasets are the same, then this search is only using one dataset
+    // and we should not return identical points.
+    if (sameSet && (queryIndex == j))
+      continue;
+
+    const Candidate c = std::make_pair(batchDistances[j], j);
+    if (CandidateCmp()(c, pqueue.top()))
+    {
+      pqueue.pop();
+      pqueue.push(c);
+    }
+  }
+
+  baseCases += referenceSet.n_cols - (sameSet ? 1 : 0);
+}
+
+template<typename SortPolicy, typename MetricType, typename TreeType>
+inline size_t NeighborSearchRules<SortPolicy, MetricType, TreeType>::
+LeafBaseCases(TreeType& queryNode,
+              TreeType& referenceNode,
+              const TraversalInfoType& parentInfo)
+{
+  const size_t queryBegin = queryNode.Begin();
+  const size_t queryCount = queryNode.Count();
+  const size_t refBegin = referenceNode.Begin();
+  const size_t refCount = referenceNode.Count();
+
+  // Compute the whole leaf-vs-leaf block in one batched call.  For the L2
+  // family PairwiseDistanceRule turns this into a single matrix product, so
+  // it is cheaper than the per-pair path even when the per-query prune below
+  // discards a few rows of the block.
+  metric::PairwiseDistances(
+      querySet.cols(queryBegin, queryBegin + queryCount - 1),
+      referenceSet.cols(refBegin, refBegin + refCount - 1),
+      blockDistances, metric);
+
+  size_t numBaseCases = 0;
+  for (size_t q = 0; q < queryCount; ++q)
+  {
+    const size_t queryIndex = queryBegin + q;
+
+    // Keep the per-query prune the pairwise traversal performs; Score() uses
+    // the traversal info of the parent combination.
+    traversalInfo = parentInfo;
+    if (Score(queryIndex, referenceNode) == DBL_MAX)
+      continue;
+
+    // Fused heap update from the precomputed block.
+    CandidateList& pqueue = candidates[queryIndex];
+    for (size_t r = 0; r < refCount; ++r)
+    {
+      const size_t referenceIndex = refBegin + r;
+      if (sameSet && (queryIndex == referenceIndex))
+        continue;
+
+      const Candidate c = std::make_pair(blockDistances(q, r),
+          referenceIndex);
+      if (CandidateCmp()(c, pqueue.top()))
+      {
+        pqueue.pop();
+        pqueue.push(c);
+      }
+    }
+
+    numBaseCases += refCount;
+  }
+
+  baseCases += numBaseCases;
+  return numBaseCases;
+}
+
 template<typename SortPolicy, typename MetricType, typename TreeType>
 inline double NeighborSearchRules<SortPolicy, MetricType, TreeType>::Score(
     const size_t queryIndex,
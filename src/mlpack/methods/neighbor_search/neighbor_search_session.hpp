@@ -0,0 +1,154 @@
+/**
+ * @file methods/neighbor_search/neighbor_search_session.hpp
+ *
+ * Defines the NeighborSearchSession class, a persistent search session that
+ * amortizes per-call setup of NeighborSearch::Search() across many small
+ * query batches.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_NEIGHBOR_SEARCH_NEIGHBOR_SEARCH_SESSION_HPP
+#define MLPACK_METHODS_NEIGHBOR_SEARCH_NEIGHBOR_SEARCH_SESSION_HPP
+
+#include <mlpack/prereqs.hpp>
+
+#include "neighbor_search.hpp"
+
+namespace mlpack {
+namespace neighbor {
+
+/**
+ * A persistent search session over a trained NeighborSearch object.  Where
+ * NeighborSearch::Search() constructs a fresh NeighborSearchRules object and
+ * allocates fresh result matrices on every call, a session builds them once,
+ * for a fixed k and a fixed maximum batch size, and reuses them; this cuts
+ * the per-call overhead substantially when queries arrive in small batches
+ * (say, tens to hundreds of points at a time).
+ *
+ * A session always uses single-point traversals: for batches this small, the
+ * cost of building a query tree for a dual-tree traversal is not amortized.
+ * The traversal used follows the search mode of the underlying NeighborSearch
+ * object: NAIVE_MODE gives brute-force search, GREEDY_SINGLE_TREE_MODE gives
+ * the greedy (defeatist) traversal, and any other mode gives the standard
+ * single-tree traversal.  Batches larger than the maximum batch size are
+ * handled correctly by processing them in chunks.
+ *
+ * The session holds a reference to the NeighborSearch object, which must
+ * therefore outlive it and must not be re-trained while the session is in
+ * use.
+ *
+ * @tparam SortPolicy The sort policy for distances; see NearestNeighborSort.
+ * @tparam MetricType The metric to use for computation.
+ * @tparam MatType The type of data matrix.
+ * @tparam TreeType The tree type to use; must adhere to the TreeType API.
+ * @tparam DualTreeTraversalType The type of dual tree traversal used by the
+ *     underlying NeighborSearch object.
+ * @tparam SingleTreeTraversalType The type of single tree traversal to use.
+ */
+template<typename SortPolicy = NearestNeighborSort,
+         typename MetricType = mlpack::metric::EuclideanDistance,
+         typename MatType = arma::mat,
+         template<typename TreeMetricType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType = tree::KDTree,
+         template<typename RuleType> class DualTreeTraversalType =
+             TreeType<MetricType,
+                      NeighborSearchStat<SortPolicy>,
+                      MatType>::template DualTreeTraverser,
+         template<typename RuleType> class SingleTreeTraversalType =
+             TreeType<MetricType,
+                      NeighborSearchStat<SortPolicy>,
+                      MatType>::template SingleTreeTraverser>
+class NeighborSearchSession
+{
+ public:
+  //! Convenience typedef for the underlying search object.
+  typedef NeighborSearch<SortPolicy, MetricType, MatType, TreeType,
+      DualTreeTraversalType, SingleTreeTraversalType> SearchType;
+  //! Convenience typedef for the tree.
+  typedef typename SearchType::Tree Tree;
+  //! Convenience typedef for the traversal rules.
+  typedef NeighborSearchRules<SortPolicy, MetricType, Tree> RuleType;
+
+  /**
+   * Construct a session over the given (trained) NeighborSearch object.  The
+   * rules object, the query staging buffer, and the result buffers are
+   * allocated here, so that Search() calls do not need to allocate.
+   *
+   * @param search Trained NeighborSearch object; must outlive the session.
+   * @param k Number of neighbors every Search() call will look for.
+   * @param maxBatchSize Size of the pre-allocated batch buffers; larger
+   *     batches are processed in chunks of this size.
+   */
+  NeighborSearchSession(SearchType& search,
+                        const size_t k,
+                        const size_t maxBatchSize = 500);
+
+  //! Release the rules and traverser.
+  ~NeighborSearchSession();
+
+  /**
+   * Search for the k nearest neighbors of every point in the given batch,
+   * storing the results in the given matrices, which will be set to size
+   * k x batch.n_cols.  Indices refer to the original reference set, exactly
+   * as with NeighborSearch::Search().
+   *
+   * @param batch Batch of query points.
+   * @param neighbors Matrix storing lists of neighbors for each query point.
+   * @param distances Matrix storing distances of neighbors for each query
+   *     point.
+   */
+  void Search(const MatType& batch,
+              arma::Mat<size_t>& neighbors,
+              arma::mat& distances);
+
+  //! Get the number of neighbors searched for.
+  size_t K() const { return k; }
+  //! Get the maximum batch size.
+  size_t MaxBatchSize() const { return maxBatchSize; }
+
+  //! Return the total number of base case evaluations performed during the
+  //! last Search() call.
+  size_t BaseCases() const { return baseCases; }
+  //! Return the number of node combination scores during the last Search()
+  //! call.
+  size_t Scores() const { return scores; }
+
+ private:
+  //! The underlying search object (not owned).
+  SearchType& search;
+
+  //! Number of neighbors to search for.
+  const size_t k;
+  //! Size of the pre-allocated batch buffers.
+  const size_t maxBatchSize;
+
+  //! Staging buffer that incoming query batches are copied into; the rules
+  //! hold a reference to this, so its address must never change.
+  MatType queryBuffer;
+
+  //! The rules object, built once over the staging buffer.
+  RuleType* rules;
+  //! The single-tree traverser, built once over the rules.
+  SingleTreeTraversalType<RuleType>* traverser;
+
+  //! Pre-allocated result buffers, in tree coordinates.
+  arma::Mat<size_t> rawNeighbors;
+  arma::mat rawDistances;
+
+  //! The number of base cases during the last search.
+  size_t baseCases;
+  //! The number of scores during the last search.
+  size_t scores;
+};
+
+} // namespace neighbor
+} // namespace mlpack
+
+// Include implementation.
+#include "neighbor_search_session_impl.hpp"
+
+#endif
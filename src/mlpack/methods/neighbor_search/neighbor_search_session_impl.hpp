@@ -0,0 +1,182 @@
+/**
+ * @file methods/neighbor_search/neighbor_search_session_impl.hpp
+ *
+ * Implementation of the NeighborSearchSession class.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_NEIGHBOR_SEARCH_NEIGHBOR_SEARCH_SESSION_IMPL_HPP
+#define MLPACK_METHODS_NEIGHBOR_SEARCH_NEIGHBOR_SEARCH_SESSION_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "neighbor_search_session.hpp"
+
+#include <mlpack/core/tree/batch_greedy_single_tree_traverser.hpp>
+
+namespace mlpack {
+namespace neighbor {
+
+template<typename SortPolicy,
+         typename MetricType,
+         typename MatType,
+         template<typename TreeMetricType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType,
+         template<typename> class DualTreeTraversalType,
+         template<typename> class SingleTreeTraversalType>
+NeighborSearchSession<SortPolicy, MetricType, MatType, TreeType,
+DualTreeTraversalType, SingleTreeTraversalType>::NeighborSearchSession(
+    SearchType& search,
+    const size_t k,
+    const size_t maxBatchSize) :
+    search(search),
+    k(k),
+    maxBatchSize(maxBatchSize),
+    baseCases(0),
+    scores(0)
+{
+  if (k == 0 || k > search.referenceSet->n_cols)
+  {
+    std::stringstream ss;
+    ss << "Requested value of k (" << k << ") must be positive and no greater "
+        << "than the number of points in the reference set ("
+        << search.referenceSet->n_cols << ")";
+    throw std::invalid_argument(ss.str());
+  }
+  if (maxBatchSize == 0)
+    throw std::invalid_argument("maxBatchSize must be positive");
+
+  // Allocate everything once; Search() only reuses these.
+  queryBuffer.zeros(search.referenceSet->n_rows, maxBatchSize);
+  rules = new RuleType(*search.referenceSet, queryBuffer, k, search.metric,
+      search.epsilon);
+  traverser = new SingleTreeTraversalType<RuleType>(*rules);
+  rawNeighbors.set_size(k, maxBatchSize);
+  rawDistances.set_size(k, maxBatchSize);
+}
+
+template<typename SortPolicy,
+         typename MetricType,
+         typename MatType,
+         template<typename TreeMetricType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType,
+         template<typename> class DualTreeTraversalType,
+         template<typename> class SingleTreeTraversalType>
+NeighborSearchSession<SortPolicy, MetricType, MatType, TreeType,
+DualTreeTraversalType, SingleTreeTraversalType>::~NeighborSearchSession()
+{
+  delete traverser;
+  delete rules;
+}
+
+template<typename SortPolicy,
+         typename MetricType,
+         typename MatType,
+         template<typename TreeMetricType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType,
+         template<typename> class DualTreeTraversalType,
+         template<typename> class SingleTreeTraversalType>
+void NeighborSearchSession<SortPolicy, MetricType, MatType, TreeType,
+DualTreeTraversalType, SingleTreeTraversalType>::Search(
+    const MatType& batch,
+    arma::Mat<size_t>& neighbors,
+    arma::mat& distances)
+{
+  if (batch.n_rows != queryBuffer.n_rows)
+  {
+    std::stringstream ss;
+    ss << "Dimensionality of batch (" << batch.n_rows << ") does not match "
+        << "dimensionality of reference set (" << queryBuffer.n_rows << ")";
+    throw std::invalid_argument(ss.str());
+  }
+
+  Timer::Start("computing_neighbors");
+
+  const size_t numQueries = batch.n_cols;
+  neighbors.set_size(k, numQueries);
+  distances.set_size(k, numQueries);
+
+  baseCases = 0;
+  scores = 0;
+
+  // Indices need mapping back to the original reference set only if the tree
+  // rearranged the points during building.
+  const bool mapReferences = tree::TreeTraits<Tree>::RearrangesDataset &&
+      !search.oldFromNewReferences.empty();
+
+  for (size_t start = 0; start < numQueries; start += maxBatchSize)
+  {
+    const size_t chunkSize = std::min(maxBatchSize, numQueries - start);
+
+    // Stage the chunk into the pre-allocated buffer the rules refer to, and
+    // restore the candidate lists that the last GetResults() call emptied.
+    rules->Reset();
+    queryBuffer.cols(0, chunkSize - 1) =
+        batch.cols(start, start + chunkSize - 1);
+
+    switch (search.searchMode)
+    {
+      case NAIVE_MODE:
+      {
+        for (size_t i = 0; i < chunkSize; ++i)
+          for (size_t j = 0; j < search.referenceSet->n_cols; ++j)
+            rules->BaseCase(i, j);
+        break;
+      }
+      case GREEDY_SINGLE_TREE_MODE:
+      {
+        tree::BatchGreedySingleTreeTraverser<Tree, RuleType> greedy(*rules);
+        greedy.MinBaseCases() = k;
+        std::vector<size_t> queryIndices(chunkSize);
+        for (size_t i = 0; i < chunkSize; ++i)
+          queryIndices[i] = i;
+        greedy.Traverse(queryIndices, *search.referenceTree);
+        break;
+      }
+      default:
+      {
+        // Batches this small do not amortize building a query tree, so the
+        // single-tree traversal is also used in dual-tree mode.
+        for (size_t i = 0; i < chunkSize; ++i)
+          traverser->Traverse(i, *search.referenceTree);
+        break;
+      }
+    }
+
+    baseCases += rules->BaseCases();
+    scores += rules->Scores();
+
+    rules->GetResults(rawNeighbors, rawDistances);
+
+    // Copy the chunk's results out, mapping indices if necessary.  Columns of
+    // the raw buffers past chunkSize belong to stale queries and are ignored.
+    for (size_t i = 0; i < chunkSize; ++i)
+    {
+      distances.col(start + i) = rawDistances.col(i);
+      if (mapReferences)
+      {
+        for (size_t j = 0; j < k; ++j)
+        {
+          neighbors(j, start + i) =
+              search.oldFromNewReferences[rawNeighbors(j, i)];
+        }
+      }
+      else
+      {
+        neighbors.col(start + i) = rawNeighbors.col(i);
+      }
+    }
+  }
+
+  Timer::Stop("computing_neighbors");
+}
+
+} // namespace neighbor
+} // namespace mlpack
+
+#endif
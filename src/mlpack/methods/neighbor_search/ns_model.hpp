@@ -22,6 +22,7 @@
 #include <mlpack/core/tree/octree.hpp>
 #include <boost/variant.hpp>
 #include "neighbor_search.hpp"
+#include "query_result_cache.hpp"
 
 namespace mlpack {
 namespace neighbor {
@@ -212,6 +213,18 @@ class EpsilonVisitor : public boost::static_visitor<double&>
   double& operator()(NSType *ns) const;
 };
 
+/**
+ * LeafVisitBudgetVisitor exposes the LeafVisitBudget method of the given
+ * NSType.
+ */
+class LeafVisitBudgetVisitor : public boost::static_visitor<size_t&>
+{
+ public:
+  //! Return the leaf visit budget for best-first search.
+  template<typename NSType>
+  size_t& operator()(NSType *ns) const;
+};
+
 /**
  * ReferenceSetVisitor exposes the referenceSet of the given NSType.
  */
@@ -285,6 +298,10 @@ class NSModel
   //! This is the random projection matrix; only used if randomBasis is true.
   arma::mat q;
 
+  //! Cache of results for previously seen query points; disabled until its
+  //! capacity is set.  It is not serialized with the model.
+  QueryResultCache resultCache;
+
   /**
    * nSearch holds an instance of the NeigborSearch class for the current
    * treeType. It is initialized every time BuildModel is executed.
@@ -306,6 +323,15 @@ class NSModel
                  NSType<SortPolicy, tree::UBTree>*,
                  NSType<SortPolicy, tree::Octree>*> nSearch;
 
+  /**
+   * Perform the actual bichromatic neighbor search, bypassing the result
+   * cache.  The query set will be reordered.
+   */
+  void SearchInternal(arma::mat&& querySet,
+                      const size_t k,
+                      arma::Mat<size_t>& neighbors,
+                      arma::mat& distances);
+
  public:
   /**
    * Initialize the NSModel with the given type and whether or not a random
@@ -363,6 +389,10 @@ class NSModel
   double Epsilon() const;
   double& Epsilon();
 
+  //! Expose LeafVisitBudget (for best-first search; 0 means no limit).
+  size_t LeafVisitBudget() const;
+  size_t& LeafVisitBudget();
+
   //! Expose leafSize.
   size_t LeafSize() const { return leafSize; }
   size_t& LeafSize() { return leafSize; }
@@ -383,13 +413,40 @@ class NSModel
   bool RandomBasis() const { return randomBasis; }
   bool& RandomBasis() { return randomBasis; }
 
+  //! Expose the query result cache.  Set its capacity to enable it; repeated
+  //! bichromatic queries are then served from the cache without a traversal.
+  const QueryResultCache& ResultCache() const { return resultCache; }
+  //! Modify the query result cache.
+  QueryResultCache& ResultCache() { return resultCache; }
+
   //! Build the reference tree.
   void BuildModel(arma::mat&& referenceSet,
                   const size_t leafSize,
                   const NeighborSearchMode searchMode,
                   const double epsilon = 0);
 
-  //! Perform neighbor search.  The query set will be reordered.
+  /**
+   * Build the reference tree, choosing the tree type, leaf size and search
+   * mode automatically.  A sample of the reference set is indexed with each
+   * candidate configuration and timed on a probe query set drawn from the
+   * rest of the reference set; the fastest configuration is then used for the
+   * full build.  The selected tree type and leaf size are stored in the model
+   * (and thus serialized with it), so a loaded model keeps the calibrated
+   * configuration.
+   *
+   * @param referenceSet Set of reference points.
+   * @param k Number of neighbors the model will be queried for; the probe
+   *      searches use the same value so that the calibration reflects the
+   *      real workload.
+   * @param epsilon Relative approximation error (non-negative).
+   */
+  void BuildModelAutoTuned(arma::mat&& referenceSet,
+                           const size_t k,
+                           const double epsilon = 0);
+
+  //! Perform neighbor search.  The query set will be reordered.  If the
+  //! result cache is enabled, queries with cached results are served from the
+  //! cache and only the remaining queries are searched.
   void Search(arma::mat&& querySet,
               const size_t k,
               arma::Mat<size_t>& neighbors,
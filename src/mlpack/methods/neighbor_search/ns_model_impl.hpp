@@ -243,6 +243,15 @@ double& EpsilonVisitor::operator()(NSType* ns) const
   throw std::runtime_error("no neighbor search model initialized");
 }
 
+//! Expose the LeafVisitBudget method of the given NSType.
+template<typename NSType>
+size_t& LeafVisitBudgetVisitor::operator()(NSType* ns) const
+{
+  if (ns)
+    return ns->LeafVisitBudget();
+  throw std::runtime_error("no neighbor search model initialized");
+}
+
 //! Expose the referenceSet of the given NSType.
 template<typename NSType>
 const arma::mat& ReferenceSetVisitor::operator()(NSType* ns) const
@@ -283,6 +292,7 @@ NSModel<SortPolicy>::NSModel(const NSModel& other) :
     rho(other.rho),
     randomBasis(other.randomBasis),
     q(other.q),
+    resultCache(other.resultCache),
     nSearch(other.nSearch)
 {
   // Nothing to do.
@@ -296,6 +306,7 @@ NSModel<SortPolicy>::NSModel(NSModel&& other) :
     rho(other.rho),
     randomBasis(other.randomBasis),
     q(std::move(other.q)),
+    resultCache(std::move(other.resultCache)),
     nSearch(other.nSearch)
 {
   // Reset parameters of the other model.
@@ -304,6 +315,7 @@ NSModel<SortPolicy>::NSModel(NSModel&& other) :
   other.tau = 0;
   other.rho = 0.7;
   other.randomBasis = false;
+  other.resultCache = QueryResultCache();
   other.nSearch = decltype(other.nSearch)();
 }
 
@@ -318,6 +330,7 @@ NSModel<SortPolicy>& NSModel<SortPolicy>::operator=(const NSModel& other)
   rho = other.rho;
   randomBasis = other.randomBasis;
   q = other.q;
+  resultCache = other.resultCache;
   nSearch = other.nSearch;
 
   return *this;
@@ -334,6 +347,7 @@ NSModel<SortPolicy>& NSModel<SortPolicy>::operator=(NSModel&& other)
   rho = other.rho;
   randomBasis = other.randomBasis;
   q = std::move(other.q);
+  resultCache = std::move(other.resultCache);
   // Copy the pointer and type.
   nSearch = other.nSearch;
 
@@ -343,6 +357,7 @@ NSModel<SortPolicy>& NSModel<SortPolicy>::operator=(NSModel&& other)
   other.tau = 0;
   other.rho = 0.7;
   other.randomBasis = false;
+  other.resultCache = QueryResultCache();
   other.nSearch = decltype(other.nSearch)();
 
   return *this;
@@ -374,8 +389,14 @@ void NSModel<SortPolicy>::serialize(Archive& ar, const unsigned int version)
 
   // This should never happen, but just in case, be clean with memory.
   if (Archive::is_loading::value)
+  {
     boost::apply_visitor(DeleteVisitor(), nSearch);
 
+    // The result cache is not serialized; any stored results refer to the
+    // model being replaced.
+    resultCache.Clear();
+  }
+
   ar & BOOST_SERIALIZATION_NVP(nSearch);
 }
 
@@ -412,6 +433,18 @@ double& NSModel<SortPolicy>::Epsilon()
   return boost::apply_visitor(EpsilonVisitor(), nSearch);
 }
 
+template<typename SortPolicy>
+size_t NSModel<SortPolicy>::LeafVisitBudget() const
+{
+  return boost::apply_visitor(LeafVisitBudgetVisitor(), nSearch);
+}
+
+template<typename SortPolicy>
+size_t& NSModel<SortPolicy>::LeafVisitBudget()
+{
+  return boost::apply_visitor(LeafVisitBudgetVisitor(), nSearch);
+}
+
 //! Build the reference tree.
 template<typename SortPolicy>
 void NSModel<SortPolicy>::BuildModel(arma::mat&& referenceSet,
@@ -420,6 +453,10 @@ void NSModel<SortPolicy>::BuildModel(arma::mat&& referenceSet,
                                      const double epsilon)
 {
   this->leafSize = leafSize;
+
+  // Any cached query results refer to the old reference set.
+  resultCache.Clear();
+
   // Initialize random basis if necessary.
   if (randomBasis)
   {
@@ -526,12 +563,163 @@ void NSModel<SortPolicy>::BuildModel(arma::mat&& referenceSet,
   }
 }
 
+//! Build the reference tree with an auto-tuned configuration.
+template<typename SortPolicy>
+void NSModel<SortPolicy>::BuildModelAutoTuned(arma::mat&& referenceSet,
+                                              const size_t k,
+                                              const double epsilon)
+{
+  // For very small datasets the calibration overhead is not worth it; fall
+  // back to the default configuration.
+  if (referenceSet.n_cols < 100)
+  {
+    BuildModel(std::move(referenceSet), leafSize, DUAL_TREE_MODE, epsilon);
+    return;
+  }
+
+  // Candidate configurations.  Only tree types that are cheap to build and
+  // accept a leaf size parameter are considered; the probe searches on the
+  // sample dominate the calibration cost, not the sample builds.
+  const TreeTypes candidateTrees[] = { KD_TREE, BALL_TREE };
+  const size_t candidateLeafSizes[] = { 10, 20, 40 };
+  const NeighborSearchMode candidateModes[] =
+      { SINGLE_TREE_MODE, DUAL_TREE_MODE };
+
+  // Draw a sample of the reference set to index and a disjoint probe set of
+  // queries to time each configuration with.
+  const size_t sampleSize = std::min((size_t) 2000, referenceSet.n_cols / 2);
+  const size_t probeSize = std::min((size_t) 200, referenceSet.n_cols / 2);
+  const size_t probeK = std::min(k, sampleSize - 1);
+
+  const arma::uvec ordering = arma::shuffle(arma::linspace<arma::uvec>(0,
+      referenceSet.n_cols - 1, referenceSet.n_cols));
+  const arma::mat sampleSet = referenceSet.cols(ordering.head(sampleSize));
+  const arma::mat probeSet = referenceSet.cols(ordering.tail(probeSize));
+
+  TreeTypes bestTree = treeType;
+  size_t bestLeafSize = leafSize;
+  NeighborSearchMode bestMode = DUAL_TREE_MODE;
+  double bestTime = DBL_MAX;
+
+  Timer::Start("auto_tuning");
+  arma::wall_clock clock;
+  for (const TreeTypes candidateTree : candidateTrees)
+  {
+    for (const size_t candidateLeafSize : candidateLeafSizes)
+    {
+      for (const NeighborSearchMode candidateMode : candidateModes)
+      {
+        // Build a scratch model on the sample and time the probe search.
+        NSModel<SortPolicy> candidate(candidateTree, false);
+        arma::mat sampleCopy(sampleSet);
+        candidate.BuildModel(std::move(sampleCopy), candidateLeafSize,
+            candidateMode, epsilon);
+
+        arma::mat probeCopy(probeSet);
+        arma::Mat<size_t> probeNeighbors;
+        arma::mat probeDistances;
+        clock.tic();
+        candidate.Search(std::move(probeCopy), probeK, probeNeighbors,
+            probeDistances);
+        const double probeTime = clock.toc();
+
+        Log::Info << "Auto-tuning: " << candidate.TreeName() << ", leaf size "
+            << candidateLeafSize << ", "
+            << ((candidateMode == DUAL_TREE_MODE) ? "dual" : "single")
+            << "-tree mode: " << probeTime << "s." << std::endl;
+
+        if (probeTime < bestTime)
+        {
+          bestTime = probeTime;
+          bestTree = candidateTree;
+          bestLeafSize = candidateLeafSize;
+          bestMode = candidateMode;
+        }
+      }
+    }
+  }
+  Timer::Stop("auto_tuning");
+
+  // Persist the winning configuration and do the full build with it.  The
+  // tree type and leaf size are serialized with the model, and the search
+  // mode is serialized with the contained NeighborSearch object.
+  treeType = bestTree;
+  Log::Info << "Auto-tuning selected " << TreeName() << " with leaf size "
+      << bestLeafSize << " and "
+      << ((bestMode == DUAL_TREE_MODE) ? "dual" : "single")
+      << "-tree search." << std::endl;
+
+  BuildModel(std::move(referenceSet), bestLeafSize, bestMode, epsilon);
+}
+
 //! Perform neighbor search.  The query set will be reordered.
 template<typename SortPolicy>
 void NSModel<SortPolicy>::Search(arma::mat&& querySet,
                                  const size_t k,
                                  arma::Mat<size_t>& neighbors,
                                  arma::mat& distances)
+{
+  if (resultCache.Capacity() == 0)
+  {
+    // The cache is disabled; go straight to the search.
+    SearchInternal(std::move(querySet), k, neighbors, distances);
+    return;
+  }
+
+  // Probe the cache with the original (unprojected) query vectors, then
+  // search only the queries that missed.
+  neighbors.set_size(k, querySet.n_cols);
+  distances.set_size(k, querySet.n_cols);
+
+  std::vector<size_t> missing;
+  arma::Col<size_t> hitNeighbors;
+  arma::vec hitDistances;
+  for (size_t i = 0; i < querySet.n_cols; ++i)
+  {
+    if (resultCache.Lookup(querySet.col(i), k, hitNeighbors, hitDistances))
+    {
+      neighbors.col(i) = hitNeighbors;
+      distances.col(i) = hitDistances;
+    }
+    else
+    {
+      missing.push_back(i);
+    }
+  }
+
+  Log::Info << "Result cache: " << (querySet.n_cols - missing.size()) << " of "
+      << querySet.n_cols << " queries served from cache." << std::endl;
+
+  if (missing.empty())
+    return;
+
+  // Copy the missing queries out twice: one copy is consumed by the search
+  // (it may be projected and reordered), and the other keeps the original
+  // vectors to use as cache keys afterwards.
+  arma::mat missSet(querySet.n_rows, missing.size());
+  for (size_t i = 0; i < missing.size(); ++i)
+    missSet.col(i) = querySet.col(missing[i]);
+  const arma::mat missKeys(missSet);
+
+  arma::Mat<size_t> missNeighbors;
+  arma::mat missDistances;
+  SearchInternal(std::move(missSet), k, missNeighbors, missDistances);
+
+  for (size_t i = 0; i < missing.size(); ++i)
+  {
+    neighbors.col(missing[i]) = missNeighbors.col(i);
+    distances.col(missing[i]) = missDistances.col(i);
+    resultCache.Insert(missKeys.col(i), missNeighbors.col(i),
+        missDistances.col(i));
+  }
+}
+
+//! Perform the actual neighbor search, bypassing the result cache.
+template<typename SortPolicy>
+void NSModel<SortPolicy>::SearchInternal(arma::mat&& querySet,
+                                         const size_t k,
+                                         arma::Mat<size_t>& neighbors,
+                                         arma::mat& distances)
 {
   // We may need to map the query set randomly.
   if (randomBasis)
@@ -554,6 +742,10 @@ void NSModel<SortPolicy>::Search(arma::mat&& querySet,
       Log::Info << "greedy single-tree " << TreeName() << " search..."
           << std::endl;
       break;
+    case BEST_FIRST_SINGLE_TREE_MODE:
+      Log::Info << "best-first single-tree " << TreeName() << " search..."
+          << std::endl;
+      break;
   }
 
   BiSearchVisitor<SortPolicy> search(querySet, k, neighbors, distances,
@@ -584,6 +776,10 @@ void NSModel<SortPolicy>::Search(const size_t k,
       Log::Info << "greedy single-tree " << TreeName() << " search..."
           << std::endl;
       break;
+    case BEST_FIRST_SINGLE_TREE_MODE:
+      Log::Info << "best-first single-tree " << TreeName() << " search..."
+          << std::endl;
+      break;
   }
 
   if (Epsilon() != 0 && SearchMode() != NAIVE_MODE)
@@ -0,0 +1,174 @@
+/**
+ * @file methods/neighbor_search/product_quantization.hpp
+ *
+ * Product quantization of a reference set for approximate nearest neighbor
+ * search with a heavily compressed in-memory representation.  The dimensions
+ * of the reference set are split into contiguous subspaces, each subspace is
+ * vector-quantized with k-means, and every reference point is stored as one
+ * codeword index per subspace.  Queries are scored against the codes with
+ * asymmetric distance computation (ADC): the query stays uncompressed, and
+ * per-subspace distances to every codeword are precomputed in a lookup table
+ * so that the approximate distance to a reference point is just a sum of
+ * table entries.
+ *
+ * With the default parameters (8 subquantizers, 256 codewords) each point
+ * takes 8 bytes instead of 8 * dimensionality, so reference sets that do not
+ * fit in memory next to a tree can still be searched from their codes alone.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_NEIGHBOR_SEARCH_PRODUCT_QUANTIZATION_HPP
+#define MLPACK_METHODS_NEIGHBOR_SEARCH_PRODUCT_QUANTIZATION_HPP
+
+#include <mlpack/prereqs.hpp>
+
+namespace mlpack {
+namespace neighbor {
+
+/**
+ * The ProductQuantization class compresses a reference set into per-subspace
+ * codeword indices and answers approximate k-nearest-neighbor queries against
+ * the compressed codes.  The results are approximate because every reference
+ * point is replaced by its nearest codeword in each subspace; optionally, the
+ * best candidates found with the compressed codes can be re-ranked with exact
+ * distances against the original reference set.
+ *
+ * @tparam MatType Type of the reference and query matrices.
+ */
+template<typename MatType = arma::mat>
+class ProductQuantization
+{
+ public:
+  /**
+   * Construct the ProductQuantization object but do not train it.  Be sure to
+   * call Train() before calling Search().
+   *
+   * @param numSubquantizers Number of subspaces the dimensions are split into.
+   * @param numCodewords Number of codewords per subspace (at most 256, so
+   *     that each code fits into a single byte).
+   */
+  ProductQuantization(const size_t numSubquantizers = 8,
+                      const size_t numCodewords = 256);
+
+  /**
+   * Construct the ProductQuantization object and train it on the given
+   * reference set.
+   *
+   * @param referenceSet Set of reference data.
+   * @param numSubquantizers Number of subspaces the dimensions are split into.
+   * @param numCodewords Number of codewords per subspace (at most 256).
+   */
+  ProductQuantization(const MatType& referenceSet,
+                      const size_t numSubquantizers = 8,
+                      const size_t numCodewords = 256);
+
+  /**
+   * Train the codebooks on the given reference set and encode every reference
+   * point.  The reference set itself is not retained: searches afterwards only
+   * need the codebooks and the codes.  Optionally, new values for the number
+   * of subquantizers and codewords may be given (a value of 0 keeps the
+   * current setting).
+   *
+   * @param referenceSet Reference set to train on.
+   * @param numSubquantizers Number of subspaces the dimensions are split into.
+   * @param numCodewords Number of codewords per subspace (at most 256).
+   */
+  void Train(const MatType& referenceSet,
+             const size_t numSubquantizers = 0,
+             const size_t numCodewords = 0);
+
+  /**
+   * Search for the k approximate nearest neighbors of the given query set
+   * using asymmetric distance computation against the compressed codes.  The
+   * results are stored in the given neighbors and distances matrices, in the
+   * same format as the NeighborSearch and LSHSearch classes; the reported
+   * distances are the quantized approximations, not exact distances.
+   *
+   * @param querySet Set of query points.
+   * @param k Number of neighbors to search for.
+   * @param neighbors Matrix to store neighbor indices in.
+   * @param distances Matrix to store approximate neighbor distances in.
+   */
+  void Search(const MatType& querySet,
+              const size_t k,
+              arma::Mat<size_t>& neighbors,
+              arma::mat& distances) const;
+
+  /**
+   * Search for the k nearest neighbors of the given query set, selecting
+   * numCandidates candidates per query with asymmetric distance computation
+   * and then re-ranking those candidates with exact distances against the
+   * given reference set.  The reference set must be the same one the model
+   * was trained on.  The reported distances are exact, and with numCandidates
+   * equal to the size of the reference set the results match exhaustive
+   * search exactly.
+   *
+   * @param querySet Set of query points.
+   * @param k Number of neighbors to search for.
+   * @param neighbors Matrix to store neighbor indices in.
+   * @param distances Matrix to store exact neighbor distances in.
+   * @param referenceSet The original (uncompressed) reference set.
+   * @param numCandidates Number of candidates to re-rank per query; clamped
+   *     to at least k and at most the number of reference points.
+   */
+  void Search(const MatType& querySet,
+              const size_t k,
+              arma::Mat<size_t>& neighbors,
+              arma::mat& distances,
+              const MatType& referenceSet,
+              const size_t numCandidates) const;
+
+  //! Serialize the model.
+  template<typename Archive>
+  void serialize(Archive& ar, const unsigned int /* version */);
+
+  //! Get the number of subquantizers.
+  size_t NumSubquantizers() const { return numSubquantizers; }
+
+  //! Get the number of codewords per subspace.
+  size_t NumCodewords() const { return numCodewords; }
+
+  //! Get the number of encoded reference points.
+  size_t NumPoints() const { return codes.n_cols; }
+
+  //! Get the codebook of the given subspace (one codeword per column).
+  const arma::mat& Codebook(const size_t s) const { return codebooks[s]; }
+
+  //! Get the codes of the reference points (one column per point).
+  const arma::Mat<unsigned char>& Codes() const { return codes; }
+
+ private:
+  /**
+   * Fill the ADC lookup table for the given query point: table(c, s) holds
+   * the squared distance between the query's subvector in subspace s and
+   * codeword c of that subspace.
+   *
+   * @param querySet Set of query points.
+   * @param queryIndex Index of the query point.
+   * @param table Matrix to store the lookup table in.
+   */
+  void QueryTable(const MatType& querySet,
+                  const size_t queryIndex,
+                  arma::mat& table) const;
+
+  //! The number of subspaces the dimensions are split into.
+  size_t numSubquantizers;
+  //! The number of codewords per subspace.
+  size_t numCodewords;
+
+  //! One codebook per subspace; each column is a codeword.
+  std::vector<arma::mat> codebooks;
+  //! Codeword indices of the reference points; one column per point.
+  arma::Mat<unsigned char> codes;
+};
+
+} // namespace neighbor
+} // namespace mlpack
+
+// Include implementation.
+#include "product_quantization_impl.hpp"
+
+#endif
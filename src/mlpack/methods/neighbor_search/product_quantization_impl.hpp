@@ -0,0 +1,275 @@
+/**
+ * @file methods/neighbor_search/product_quantization_impl.hpp
+ *
+ * Implementation of product quantization for approximate nearest neighbor
+ * search against a compressed reference set.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_NEIGHBOR_SEARCH_PRODUCT_QUANTIZATION_IMPL_HPP
+#define MLPACK_METHODS_NEIGHBOR_SEARCH_PRODUCT_QUANTIZATION_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "product_quantization.hpp"
+
+#include <mlpack/core/metrics/lmetric.hpp>
+#include <mlpack/methods/kmeans/kmeans.hpp>
+
+namespace mlpack {
+namespace neighbor {
+
+// Empty constructor.
+template<typename MatType>
+ProductQuantization<MatType>::ProductQuantization(
+    const size_t numSubquantizers,
+    const size_t numCodewords) :
+    numSubquantizers(numSubquantizers),
+    numCodewords(numCodewords)
+{
+  // Nothing to do.
+}
+
+// Construct and train.
+template<typename MatType>
+ProductQuantization<MatType>::ProductQuantization(
+    const MatType& referenceSet,
+    const size_t numSubquantizers,
+    const size_t numCodewords) :
+    numSubquantizers(numSubquantizers),
+    numCodewords(numCodewords)
+{
+  Train(referenceSet);
+}
+
+// Train the codebooks and encode the reference set.
+template<typename MatType>
+void ProductQuantization<MatType>::Train(const MatType& referenceSet,
+                                         const size_t numSubquantizersIn,
+                                         const size_t numCodewordsIn)
+{
+  if (numSubquantizersIn > 0)
+    numSubquantizers = numSubquantizersIn;
+  if (numCodewordsIn > 0)
+    numCodewords = numCodewordsIn;
+
+  if (numSubquantizers == 0 || numSubquantizers > referenceSet.n_rows)
+  {
+    std::stringstream ss;
+    ss << "ProductQuantization::Train(): number of subquantizers ("
+        << numSubquantizers << ") must be positive and no larger than the "
+        << "dimensionality of the data (" << referenceSet.n_rows << ")!";
+    throw std::invalid_argument(ss.str());
+  }
+
+  if (numCodewords == 0 || numCodewords > 256)
+  {
+    std::stringstream ss;
+    ss << "ProductQuantization::Train(): number of codewords ("
+        << numCodewords << ") must be between 1 and 256 so that codes fit "
+        << "into a single byte!";
+    throw std::invalid_argument(ss.str());
+  }
+
+  if (referenceSet.n_cols < numCodewords)
+  {
+    std::stringstream ss;
+    ss << "ProductQuantization::Train(): the reference set has fewer points ("
+        << referenceSet.n_cols << ") than codewords per subspace ("
+        << numCodewords << ")!";
+    throw std::invalid_argument(ss.str());
+  }
+
+  codebooks.clear();
+  codebooks.resize(numSubquantizers);
+  codes.set_size(numSubquantizers, referenceSet.n_cols);
+
+  // Split the dimensions into contiguous subspaces; when the dimensionality
+  // does not divide evenly, the first subspaces get one extra dimension.
+  size_t startRow = 0;
+  for (size_t s = 0; s < numSubquantizers; ++s)
+  {
+    const size_t subDim = referenceSet.n_rows / numSubquantizers +
+        ((s < referenceSet.n_rows % numSubquantizers) ? 1 : 0);
+
+    const arma::mat subData = arma::conv_to<arma::mat>::from(
+        referenceSet.rows(startRow, startRow + subDim - 1));
+
+    // Quantize this subspace with k-means; the centroids are the codewords.
+    arma::Row<size_t> assignments;
+    kmeans::KMeans<> kmeans;
+    kmeans.Cluster(subData, numCodewords, assignments, codebooks[s]);
+
+    for (size_t j = 0; j < referenceSet.n_cols; ++j)
+      codes(s, j) = (unsigned char) assignments[j];
+
+    startRow += subDim;
+  }
+}
+
+// Fill the ADC lookup table for one query point.
+template<typename MatType>
+void ProductQuantization<MatType>::QueryTable(const MatType& querySet,
+                                              const size_t queryIndex,
+                                              arma::mat& table) const
+{
+  table.set_size(numCodewords, numSubquantizers);
+
+  size_t startRow = 0;
+  for (size_t s = 0; s < numSubquantizers; ++s)
+  {
+    const arma::vec sub = arma::conv_to<arma::vec>::from(
+        querySet.col(queryIndex).rows(startRow,
+            startRow + codebooks[s].n_rows - 1));
+
+    for (size_t c = 0; c < numCodewords; ++c)
+    {
+      const arma::vec diff = codebooks[s].col(c) - sub;
+      table(c, s) = arma::dot(diff, diff);
+    }
+
+    startRow += codebooks[s].n_rows;
+  }
+}
+
+// Approximate search against the compressed codes only.
+template<typename MatType>
+void ProductQuantization<MatType>::Search(const MatType& querySet,
+                                          const size_t k,
+                                          arma::Mat<size_t>& neighbors,
+                                          arma::mat& distances) const
+{
+  if (codebooks.empty())
+    throw std::invalid_argument("ProductQuantization::Search(): the model "
+        "has not been trained!");
+
+  if (k > codes.n_cols)
+  {
+    std::stringstream ss;
+    ss << "ProductQuantization::Search(): requested value of k (" << k
+        << ") is greater than the number of reference points ("
+        << codes.n_cols << ")!";
+    throw std::invalid_argument(ss.str());
+  }
+
+  neighbors.set_size(k, querySet.n_cols);
+  distances.set_size(k, querySet.n_cols);
+
+  // Each query is independent, so process them in parallel.
+  #pragma omp parallel for schedule(dynamic)
+  for (omp_size_t i = 0; i < (omp_size_t) querySet.n_cols; ++i)
+  {
+    arma::mat table;
+    QueryTable(querySet, i, table);
+
+    // The approximate squared distance to a reference point is the sum of
+    // its codewords' table entries.
+    arma::vec approx(codes.n_cols);
+    for (size_t j = 0; j < codes.n_cols; ++j)
+    {
+      double sum = 0.0;
+      for (size_t s = 0; s < numSubquantizers; ++s)
+        sum += table(codes(s, j), s);
+      approx[j] = sum;
+    }
+
+    const arma::uvec order = arma::sort_index(approx);
+    for (size_t r = 0; r < k; ++r)
+    {
+      neighbors(r, i) = order[r];
+      distances(r, i) = std::sqrt(approx[order[r]]);
+    }
+  }
+}
+
+// Approximate candidate selection with exact re-ranking.
+template<typename MatType>
+void ProductQuantization<MatType>::Search(const MatType& querySet,
+                                          const size_t k,
+                                          arma::Mat<size_t>& neighbors,
+                                          arma::mat& distances,
+                                          const MatType& referenceSet,
+                                          const size_t numCandidates) const
+{
+  if (codebooks.empty())
+    throw std::invalid_argument("ProductQuantization::Search(): the model "
+        "has not been trained!");
+
+  if (referenceSet.n_cols != codes.n_cols)
+  {
+    std::stringstream ss;
+    ss << "ProductQuantization::Search(): the given reference set has "
+        << referenceSet.n_cols << " points, but " << codes.n_cols
+        << " points were encoded during training!";
+    throw std::invalid_argument(ss.str());
+  }
+
+  if (k > codes.n_cols)
+  {
+    std::stringstream ss;
+    ss << "ProductQuantization::Search(): requested value of k (" << k
+        << ") is greater than the number of reference points ("
+        << codes.n_cols << ")!";
+    throw std::invalid_argument(ss.str());
+  }
+
+  const size_t numCand = std::min((size_t) codes.n_cols,
+      std::max(k, numCandidates));
+
+  neighbors.set_size(k, querySet.n_cols);
+  distances.set_size(k, querySet.n_cols);
+
+  // Each query is independent, so process them in parallel.
+  #pragma omp parallel for schedule(dynamic)
+  for (omp_size_t i = 0; i < (omp_size_t) querySet.n_cols; ++i)
+  {
+    arma::mat table;
+    QueryTable(querySet, i, table);
+
+    arma::vec approx(codes.n_cols);
+    for (size_t j = 0; j < codes.n_cols; ++j)
+    {
+      double sum = 0.0;
+      for (size_t s = 0; s < numSubquantizers; ++s)
+        sum += table(codes(s, j), s);
+      approx[j] = sum;
+    }
+
+    // Select the best candidates by approximate distance, then re-rank them
+    // with exact distances against the original reference set.
+    const arma::uvec order = arma::sort_index(approx);
+
+    arma::vec exact(numCand);
+    for (size_t c = 0; c < numCand; ++c)
+    {
+      exact[c] = metric::EuclideanDistance::Evaluate(querySet.col(i),
+          referenceSet.col(order[c]));
+    }
+
+    const arma::uvec rerank = arma::sort_index(exact);
+    for (size_t r = 0; r < k; ++r)
+    {
+      neighbors(r, i) = order[rerank[r]];
+      distances(r, i) = exact[rerank[r]];
+    }
+  }
+}
+
+// Serialize the model.
+template<typename MatType>
+template<typename Archive>
+void ProductQuantization<MatType>::serialize(Archive& ar,
+                                             const unsigned int /* version */)
+{
+  ar & BOOST_SERIALIZATION_NVP(numSubquantizers);
+  ar & BOOST_SERIALIZATION_NVP(numCodewords);
+  ar & BOOST_SERIALIZATION_NVP(codebooks);
+  ar & BOOST_SERIALIZATION_NVP(codes);
+}
+
+} // namespace neighbor
+} // namespace mlpack
+
+#endif
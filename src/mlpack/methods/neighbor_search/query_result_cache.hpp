@@ -0,0 +1,172 @@
+/**
+ * @file methods/neighbor_search/query_result_cache.hpp
+ *
+ * Defines the QueryResultCache class, a least-recently-used cache of neighbor
+ * search results keyed by query vector.  It allows repeated queries to be
+ * answered without a traversal.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_NEIGHBOR_SEARCH_QUERY_RESULT_CACHE_HPP
+#define MLPACK_METHODS_NEIGHBOR_SEARCH_QUERY_RESULT_CACHE_HPP
+
+#include <mlpack/prereqs.hpp>
+
+#include <list>
+#include <unordered_map>
+
+namespace mlpack {
+namespace neighbor {
+
+/**
+ * The QueryResultCache holds the neighbors and distances computed for
+ * previously seen query points, keyed by a hash of the query vector, with
+ * least-recently-used eviction once a configurable capacity is reached.  It is
+ * intended for serving workloads where the same query points recur: a cache
+ * hit returns the stored results directly, skipping the traversal entirely.
+ *
+ * Matching can be exact or approximate.  With a tolerance of zero, only
+ * bitwise-identical query vectors hit.  With a positive tolerance, each
+ * coordinate is quantized to cells of that width before hashing, and a stored
+ * entry matches if every coordinate of the stored query is within the
+ * tolerance of the incoming query.  Matching is best-effort: two queries
+ * within the tolerance of each other may still quantize to different cells
+ * and miss, but a hit never returns results for a query farther away than the
+ * tolerance in any coordinate.
+ *
+ * The number of neighbors k is part of the key, so results stored for one k
+ * are not returned for another.  The cache knows nothing about the model that
+ * produced the results; it must be cleared when the reference set or any
+ * search parameter (mode, epsilon) changes, and after changing the tolerance.
+ */
+class QueryResultCache
+{
+ public:
+  /**
+   * Create the cache.  A capacity of zero disables caching entirely.
+   *
+   * @param capacity Maximum number of query results to hold.
+   * @param tolerance Per-coordinate matching tolerance (0 means exact).
+   */
+  QueryResultCache(const size_t capacity = 0, const double tolerance = 0.0);
+
+  /**
+   * Copy the given cache, including its stored results.
+   *
+   * @param other Cache to copy.
+   */
+  QueryResultCache(const QueryResultCache& other);
+
+  /**
+   * Copy the given cache, including its stored results.
+   *
+   * @param other Cache to copy.
+   */
+  QueryResultCache& operator=(const QueryResultCache& other);
+
+  //! Take ownership of the given cache.
+  QueryResultCache(QueryResultCache&& other) = default;
+
+  //! Take ownership of the given cache.
+  QueryResultCache& operator=(QueryResultCache&& other) = default;
+
+  /**
+   * Look up the results stored for the given query point, with the given
+   * number of neighbors.  On a hit, the stored neighbors and distances are
+   * copied into the output parameters, the entry becomes the most recently
+   * used, and true is returned; on a miss the outputs are left untouched and
+   * false is returned.
+   *
+   * @param query Query point to look up.
+   * @param k Number of neighbors the stored results must have.
+   * @param neighbors Vector to store the cached neighbor indices in.
+   * @param distances Vector to store the cached distances in.
+   */
+  bool Lookup(const arma::vec& query,
+              const size_t k,
+              arma::Col<size_t>& neighbors,
+              arma::vec& distances);
+
+  /**
+   * Store the results computed for the given query point as the most recently
+   * used entry, evicting the least recently used entry if the cache is at
+   * capacity.  If the cache is disabled (zero capacity), nothing is stored.
+   *
+   * @param query Query point the results were computed for.
+   * @param neighbors Neighbor indices computed for the query point.
+   * @param distances Distances computed for the query point.
+   */
+  void Insert(const arma::vec& query,
+              const arma::Col<size_t>& neighbors,
+              const arma::vec& distances);
+
+  //! Remove all stored results (the capacity and tolerance are kept).
+  void Clear();
+
+  //! Get the maximum number of stored query results (0 means disabled).
+  size_t Capacity() const { return capacity; }
+  //! Modify the maximum number of stored query results.  Shrinking the
+  //! capacity takes effect through eviction on the next insertion.
+  size_t& Capacity() { return capacity; }
+
+  //! Get the per-coordinate matching tolerance (0 means exact matching).
+  double Tolerance() const { return tolerance; }
+  //! Modify the per-coordinate matching tolerance.  Call Clear() afterwards;
+  //! entries stored under the old tolerance hash to the wrong cells.
+  double& Tolerance() { return tolerance; }
+
+  //! Get the number of query results currently stored.
+  size_t Size() const { return entries.size(); }
+
+  //! Get the number of lookups that were served from the cache.
+  size_t Hits() const { return hits; }
+  //! Get the number of lookups that missed.
+  size_t Misses() const { return misses; }
+
+ private:
+  //! A stored query result: the query vector it was computed for, its hash
+  //! key, and the computed neighbors and distances.
+  struct Entry
+  {
+    arma::vec query;
+    size_t key;
+    arma::Col<size_t> neighbors;
+    arma::vec distances;
+  };
+
+  //! Hash the given query point (quantized by the tolerance, if any) together
+  //! with the number of neighbors.
+  size_t HashQuery(const arma::vec& query, const size_t k) const;
+
+  //! Return true if the stored query matches the incoming query within the
+  //! tolerance.
+  bool Matches(const arma::vec& stored, const arma::vec& query) const;
+
+  //! Maximum number of stored query results; 0 disables the cache.
+  size_t capacity;
+
+  //! Per-coordinate matching tolerance; 0 means exact matching.
+  double tolerance;
+
+  //! Stored results, most recently used first.
+  std::list<Entry> entries;
+
+  //! Index from hash key to the entry holding that key.
+  std::unordered_map<size_t, std::list<Entry>::iterator> index;
+
+  //! The number of lookups served from the cache.
+  size_t hits;
+  //! The number of lookups that missed.
+  size_t misses;
+};
+
+} // namespace neighbor
+} // namespace mlpack
+
+// Include implementation.
+#include "query_result_cache_impl.hpp"
+
+#endif
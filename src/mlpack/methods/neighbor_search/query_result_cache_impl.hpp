@@ -0,0 +1,164 @@
+/**
+ * @file methods/neighbor_search/query_result_cache_impl.hpp
+ *
+ * Implementation of the QueryResultCache class.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_NEIGHBOR_SEARCH_QUERY_RESULT_CACHE_IMPL_HPP
+#define MLPACK_METHODS_NEIGHBOR_SEARCH_QUERY_RESULT_CACHE_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "query_result_cache.hpp"
+
+namespace mlpack {
+namespace neighbor {
+
+inline QueryResultCache::QueryResultCache(const size_t capacity,
+                                          const double tolerance) :
+    capacity(capacity),
+    tolerance(tolerance),
+    hits(0),
+    misses(0)
+{
+  // Nothing to do.
+}
+
+inline QueryResultCache::QueryResultCache(const QueryResultCache& other) :
+    capacity(other.capacity),
+    tolerance(other.tolerance),
+    entries(other.entries),
+    hits(other.hits),
+    misses(other.misses)
+{
+  // The index holds iterators into the entry list, so it must be rebuilt to
+  // point into our own copy.
+  for (std::list<Entry>::iterator it = entries.begin(); it != entries.end();
+      ++it)
+    index[it->key] = it;
+}
+
+inline QueryResultCache& QueryResultCache::operator=(
+    const QueryResultCache& other)
+{
+  if (this != &other)
+  {
+    capacity = other.capacity;
+    tolerance = other.tolerance;
+    entries = other.entries;
+    hits = other.hits;
+    misses = other.misses;
+
+    // Rebuild the index to point into our own copy of the entry list.
+    index.clear();
+    for (std::list<Entry>::iterator it = entries.begin(); it != entries.end();
+        ++it)
+      index[it->key] = it;
+  }
+
+  return *this;
+}
+
+inline bool QueryResultCache::Lookup(const arma::vec& query,
+                                     const size_t k,
+                                     arma::Col<size_t>& neighbors,
+                                     arma::vec& distances)
+{
+  const size_t key = HashQuery(query, k);
+
+  std::unordered_map<size_t, std::list<Entry>::iterator>::iterator it =
+      index.find(key);
+  if (it == index.end() || it->second->neighbors.n_elem != k ||
+      !Matches(it->second->query, query))
+  {
+    // Either nothing is stored under this key, or the stored entry is for a
+    // different query that happens to share the hash.
+    ++misses;
+    return false;
+  }
+
+  // Move the entry to the front of the list (most recently used).
+  entries.splice(entries.begin(), entries, it->second);
+
+  neighbors = entries.front().neighbors;
+  distances = entries.front().distances;
+  ++hits;
+  return true;
+}
+
+inline void QueryResultCache::Insert(const arma::vec& query,
+                                     const arma::Col<size_t>& neighbors,
+                                     const arma::vec& distances)
+{
+  if (capacity == 0)
+    return;
+
+  const size_t key = HashQuery(query, neighbors.n_elem);
+
+  // If an entry already exists under this key (the same query again, or a
+  // hash collision), drop it; the new results take its place.
+  std::unordered_map<size_t, std::list<Entry>::iterator>::iterator it =
+      index.find(key);
+  if (it != index.end())
+  {
+    entries.erase(it->second);
+    index.erase(it);
+  }
+
+  entries.push_front(Entry{ query, key, neighbors, distances });
+  index[key] = entries.begin();
+
+  // Evict the least recently used entries if we are over capacity.
+  while (entries.size() > capacity)
+  {
+    index.erase(entries.back().key);
+    entries.pop_back();
+  }
+}
+
+inline void QueryResultCache::Clear()
+{
+  entries.clear();
+  index.clear();
+  hits = 0;
+  misses = 0;
+}
+
+inline size_t QueryResultCache::HashQuery(const arma::vec& query,
+                                          const size_t k) const
+{
+  // Combine the coordinate hashes in the style of boost::hash_combine.
+  size_t seed = std::hash<size_t>()(k);
+  for (size_t i = 0; i < query.n_elem; ++i)
+  {
+    size_t h;
+    if (tolerance > 0.0)
+      h = std::hash<long long>()((long long) std::floor(query[i] / tolerance));
+    else
+      h = std::hash<double>()(query[i]);
+
+    seed ^= h + 0x9e3779b97f4a7c15 + (seed << 6) + (seed >> 2);
+  }
+
+  return seed;
+}
+
+inline bool QueryResultCache::Matches(const arma::vec& stored,
+                                      const arma::vec& query) const
+{
+  if (stored.n_elem != query.n_elem)
+    return false;
+
+  if (tolerance == 0.0)
+    return arma::all(stored == query);
+
+  return arma::abs(stored - query).max() <= tolerance;
+}
+
+} // namespace neighbor
+} // namespace mlpack
+
+#endif
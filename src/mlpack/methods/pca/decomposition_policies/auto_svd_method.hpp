@@ -0,0 +1,118 @@
+/**
+ * @file methods/pca/decomposition_policies/auto_svd_method.hpp
+ *
+ * Implementation of a decomposition policy that automatically selects between
+ * the exact and truncated SVD methods based on the requested rank, for use in
+ * the Principal Components Analysis method.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+
+#ifndef MLPACK_METHODS_PCA_DECOMPOSITION_POLICIES_AUTO_SVD_METHOD_HPP
+#define MLPACK_METHODS_PCA_DECOMPOSITION_POLICIES_AUTO_SVD_METHOD_HPP
+
+#include <mlpack/prereqs.hpp>
+#include "exact_svd_method.hpp"
+#include "randomized_svd_method.hpp"
+#include "randomized_block_krylov_method.hpp"
+
+namespace mlpack {
+namespace pca {
+
+/**
+ * Implementation of the automatic SVD policy.  A full SVD is wasteful when
+ * only a few principal components of a large matrix are requested, but the
+ * randomized truncated methods are no faster (and less accurate) when the
+ * requested rank is close to the full rank.  This policy inspects the
+ * requested rank and dispatches to the exact SVD, the randomized SVD, or the
+ * randomized block Krylov SVD, whichever is expected to be cheapest:
+ *
+ *  - exact SVD, when the matrix is small or the requested rank is a large
+ *    fraction of the full rank;
+ *  - randomized block Krylov SVD, for very small ranks, where the extra
+ *    Krylov iterations are cheap and give better accuracy on slowly decaying
+ *    spectra;
+ *  - randomized SVD, for everything in between.
+ *
+ * The randomized methods make only a constant number of passes over the data,
+ * so they also apply when the matrix is too large to want extra copies of.
+ */
+class AutoSVDPolicy
+{
+ public:
+  /**
+   * Use the automatically selected SVD method to perform the principal
+   * components analysis (PCA).
+   *
+   * @param maxIterations Number of iterations for the power method of the
+   *        truncated decompositions (Default: 2).
+   */
+  AutoSVDPolicy(const size_t maxIterations = 2) :
+      maxIterations(maxIterations)
+  {
+    /* Nothing to do here */
+  }
+
+  /**
+   * Apply Principal Component Analysis to the provided data set using
+   * whichever SVD method fits the requested rank best.
+   *
+   * @param data Data matrix.
+   * @param centeredData Centered data matrix.
+   * @param transformedData Matrix to put results of PCA into.
+   * @param eigVal Vector to put eigenvalues into.
+   * @param eigvec Matrix to put eigenvectors (loadings) into.
+   * @param rank Rank of the decomposition.
+   */
+  void Apply(const arma::mat& data,
+             const arma::mat& centeredData,
+             arma::mat& transformedData,
+             arma::vec& eigVal,
+             arma::mat& eigvec,
+             const size_t rank)
+  {
+    const size_t smallestDimension = std::min(data.n_rows, data.n_cols);
+
+    if (smallestDimension <= exactThreshold ||
+        3 * rank >= smallestDimension)
+    {
+      // The truncated methods save nothing here; fall back to the full
+      // decomposition.
+      ExactSVDPolicy().Apply(data, centeredData, transformedData, eigVal,
+          eigvec, rank);
+    }
+    else if (16 * rank <= smallestDimension)
+    {
+      // The rank is a tiny fraction of the matrix; the block Krylov method
+      // gives better accuracy for the same small number of passes.
+      RandomizedBlockKrylovSVDPolicy(maxIterations).Apply(data, centeredData,
+          transformedData, eigVal, eigvec, rank);
+    }
+    else
+    {
+      RandomizedSVDPolicy(0, maxIterations).Apply(data, centeredData,
+          transformedData, eigVal, eigvec, rank);
+    }
+  }
+
+  //! Get the number of iterations for the power method.
+  size_t MaxIterations() const { return maxIterations; }
+  //! Modify the number of iterations for the power method.
+  size_t& MaxIterations() { return maxIterations; }
+
+ private:
+  //! Matrices with a smaller dimension at or below this size always use the
+  //! exact SVD.
+  static const size_t exactThreshold = 100;
+
+  //! Locally stored number of iterations for the power method.
+  size_t maxIterations;
+};
+
+} // namespace pca
+} // namespace mlpack
+
+#endif
@@ -0,0 +1,120 @@
+/**
+ * @file methods/pca/incremental_pca.hpp
+ * @author Ryan Curtin
+ *
+ * Defines the IncrementalPCA class, which computes a principal components
+ * basis from data that arrives in chunks.  Partial states built on different
+ * shards of a dataset can be merged, so the full analysis can run as a
+ * map-reduce over data that does not fit in memory.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_PCA_INCREMENTAL_PCA_HPP
+#define MLPACK_METHODS_PCA_INCREMENTAL_PCA_HPP
+
+#include <mlpack/prereqs.hpp>
+
+namespace mlpack {
+namespace pca {
+
+/**
+ * This class computes principal components analysis incrementally.  Instead
+ * of decomposing the full data matrix, it accumulates the sufficient
+ * statistics of the covariance matrix---the point count, the sum of the
+ * points, and the sum of their outer products---so each chunk of data can be
+ * processed and discarded.  The memory footprint is O(d^2) for
+ * d-dimensional data, independent of the number of points.
+ *
+ * Because the sufficient statistics are additive, two IncrementalPCA objects
+ * built on different shards of a dataset can be combined with Merge(), and
+ * the result is exactly the state that a single pass over the concatenated
+ * shards would have produced.  The state can also be serialized, so partial
+ * results may be written out and combined in a later job.
+ *
+ * The eigendecomposition itself is only performed when Apply() is called, on
+ * the d x d covariance matrix assembled from the statistics; the resulting
+ * basis matches batch PCA on the full dataset (up to the sign of each
+ * eigenvector).
+ */
+class IncrementalPCA
+{
+ public:
+  /**
+   * Create an empty IncrementalPCA object.  The dimensionality of the state
+   * is fixed by the first call to Update() or Merge().
+   */
+  IncrementalPCA();
+
+  /**
+   * Accumulate a chunk of data into the sufficient statistics.  The chunk may
+   * be freed by the caller afterwards.
+   *
+   * @param data Chunk of data; each column is a point.
+   */
+  void Update(const arma::mat& data);
+
+  /**
+   * Merge the sufficient statistics of another IncrementalPCA object into
+   * this one.  The result is identical to having passed the other object's
+   * data through Update() on this object.
+   *
+   * @param other Partial state computed on another shard of the data.
+   */
+  void Merge(const IncrementalPCA& other);
+
+  /**
+   * Compute the principal components basis from the accumulated statistics.
+   * The eigenvalues and eigenvectors are sorted in descending order of
+   * eigenvalue.  At least two points must have been accumulated.
+   *
+   * @param eigVal Vector to put eigenvalues into.
+   * @param eigvec Matrix to put eigenvectors (loadings) into.
+   */
+  void Apply(arma::vec& eigVal, arma::mat& eigvec) const;
+
+  /**
+   * Center the given data with the accumulated mean and project it onto the
+   * principal components basis.  It is safe to pass the same matrix reference
+   * for both data and transformedData.
+   *
+   * @param data Data matrix.
+   * @param transformedData Matrix to put the projected data into.
+   */
+  void Transform(const arma::mat& data, arma::mat& transformedData) const;
+
+  //! Get the number of points accumulated so far.
+  size_t Count() const { return count; }
+
+  //! Get the mean of the points accumulated so far.
+  arma::vec Mean() const;
+
+  //! Serialize the accumulated statistics.
+  template<typename Archive>
+  void serialize(Archive& ar, const unsigned int /* version */)
+  {
+    ar & BOOST_SERIALIZATION_NVP(count);
+    ar & BOOST_SERIALIZATION_NVP(sum);
+    ar & BOOST_SERIALIZATION_NVP(outerProductSum);
+  }
+
+ private:
+  //! The number of points accumulated.
+  size_t count;
+
+  //! The sum of the accumulated points.
+  arma::vec sum;
+
+  //! The sum of the outer products of the accumulated points.
+  arma::mat outerProductSum;
+}; // class IncrementalPCA
+
+} // namespace pca
+} // namespace mlpack
+
+// Include implementation.
+#include "incremental_pca_impl.hpp"
+
+#endif
@@ -0,0 +1,118 @@
+/**
+ * @file methods/pca/incremental_pca_impl.hpp
+ * @author Ryan Curtin
+ *
+ * Implementation of the IncrementalPCA class.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_PCA_INCREMENTAL_PCA_IMPL_HPP
+#define MLPACK_METHODS_PCA_INCREMENTAL_PCA_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "incremental_pca.hpp"
+
+namespace mlpack {
+namespace pca {
+
+inline IncrementalPCA::IncrementalPCA() : count(0)
+{
+  // Nothing to do.
+}
+
+inline void IncrementalPCA::Update(const arma::mat& data)
+{
+  if (data.n_cols == 0)
+    return;
+
+  if (count == 0)
+  {
+    sum.zeros(data.n_rows);
+    outerProductSum.zeros(data.n_rows, data.n_rows);
+  }
+  else if (data.n_rows != sum.n_elem)
+  {
+    std::ostringstream oss;
+    oss << "IncrementalPCA::Update(): chunk dimensionality (" << data.n_rows
+        << ") does not match the accumulated state (" << sum.n_elem << ")!";
+    throw std::invalid_argument(oss.str());
+  }
+
+  count += data.n_cols;
+  sum += arma::sum(data, 1);
+  outerProductSum += data * data.t();
+}
+
+inline void IncrementalPCA::Merge(const IncrementalPCA& other)
+{
+  if (other.count == 0)
+    return;
+
+  if (count == 0)
+  {
+    count = other.count;
+    sum = other.sum;
+    outerProductSum = other.outerProductSum;
+    return;
+  }
+
+  if (other.sum.n_elem != sum.n_elem)
+  {
+    std::ostringstream oss;
+    oss << "IncrementalPCA::Merge(): other state dimensionality ("
+        << other.sum.n_elem << ") does not match the accumulated state ("
+        << sum.n_elem << ")!";
+    throw std::invalid_argument(oss.str());
+  }
+
+  count += other.count;
+  sum += other.sum;
+  outerProductSum += other.outerProductSum;
+}
+
+inline void IncrementalPCA::Apply(arma::vec& eigVal, arma::mat& eigvec) const
+{
+  if (count < 2)
+  {
+    throw std::runtime_error("IncrementalPCA::Apply(): at least two points "
+        "must be accumulated before computing a basis!");
+  }
+
+  // Assemble the covariance matrix from the sufficient statistics:
+  //   C = (sum_i x_i x_i^T - n * mean * mean^T) / (n - 1).
+  const arma::vec mean = sum / count;
+  const arma::mat covariance = (outerProductSum -
+      ((double) count) * (mean * mean.t())) / (count - 1);
+
+  // eig_sym() returns the eigenvalues in ascending order; flip them to match
+  // the descending order used by PCA.
+  arma::eig_sym(eigVal, eigvec, covariance);
+  eigVal = arma::reverse(eigVal);
+  eigvec = arma::fliplr(eigvec);
+}
+
+inline void IncrementalPCA::Transform(const arma::mat& data,
+                                      arma::mat& transformedData) const
+{
+  arma::vec eigVal;
+  arma::mat eigvec;
+  Apply(eigVal, eigvec);
+
+  const arma::vec mean = sum / count;
+  transformedData = eigvec.t() * (data.each_col() - mean);
+}
+
+inline arma::vec IncrementalPCA::Mean() const
+{
+  if (count == 0)
+    return arma::vec();
+  return sum / count;
+}
+
+} // namespace pca
+} // namespace mlpack
+
+#endif
@@ -15,6 +15,7 @@
 #include <mlpack/core/util/mlpack_main.hpp>
 
 #include "pca.hpp"
+#include <mlpack/methods/pca/decomposition_policies/auto_svd_method.hpp>
 #include <mlpack/methods/pca/decomposition_policies/exact_svd_method.hpp>
 #include <mlpack/methods/pca/decomposition_policies/quic_svd_method.hpp>
 #include <mlpack/methods/pca/decomposition_policies/randomized_svd_method.hpp>
@@ -50,7 +51,9 @@ PROGRAM_INFO("Principal Components Analysis",
     "Multiple different decomposition techniques can be used.  The method to "
     "use can be specified with the " +
     PRINT_PARAM_STRING("decomposition_method") + " parameter, and it may take "
-    "the values 'exact', 'randomized', or 'quic'."
+    "the values 'auto', 'exact', 'randomized', or 'quic'.  The 'auto' method "
+    "selects between the exact and truncated decompositions based on the "
+    "requested dimensionality."
     "\n\n"
     "For example, to reduce the dimensionality of the matrix " +
     PRINT_DATASET("data") + " to 5 dimensions using randomized SVD for the "
@@ -76,8 +79,8 @@ PARAM_FLAG("scale", "If set, the data will be scaled before running PCA, such "
     "that the variance of each feature is 1.", "s");
 
 PARAM_STRING_IN("decomposition_method", "Method used for the principal "
-    "components analysis: 'exact', 'randomized', 'randomized-block-krylov', "
-    "'quic'.", "c", "exact");
+    "components analysis: 'auto', 'exact', 'randomized', "
+    "'randomized-block-krylov', 'quic'.", "c", "exact");
 
 
 //! Run RunPCA on the specified dataset with the given decomposition method.
@@ -118,8 +121,8 @@ static void mlpackMain()
   RequireAtLeastOnePassed({ "output" }, false, "no output will be saved");
 
   // Check decomposition method validity.
-  RequireParamInSet<string>("decomposition_method", { "exact", "randomized",
-      "randomized-block-krylov", "quic" }, true,
+  RequireParamInSet<string>("decomposition_method", { "auto", "exact",
+      "randomized", "randomized-block-krylov", "quic" }, true,
       "unknown decomposition method");
 
   // Find out what dimension we want.
@@ -145,7 +148,11 @@ static void mlpackMain()
       "decomposition_method");
 
   // Perform PCA.
-  if (decompositionMethod == "exact")
+  if (decompositionMethod == "auto")
+  {
+    RunPCA<AutoSVDPolicy>(dataset, newDimension, scale, varToRetain);
+  }
+  else if (decompositionMethod == "exact")
   {
     RunPCA<ExactSVDPolicy>(dataset, newDimension, scale, varToRetain);
   }
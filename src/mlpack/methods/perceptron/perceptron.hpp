@@ -106,6 +106,30 @@ class Perceptron
              const size_t numClasses,
              const arma::rowvec& instanceWeights = arma::rowvec());
 
+  /**
+   * Train the perceptron on the given data, evaluating each pass through the
+   * data as a batch.  The margins of every point for an epoch are computed
+   * with a single matrix product, updates are applied only for the points
+   * that are misclassified, and training terminates as soon as an epoch has
+   * no violations.  Because updates within an epoch are applied against the
+   * weights the epoch started with, this may take a different (usually much
+   * shorter in wall time) path to convergence than Train(), but it still
+   * converges when the data is linearly separable.
+   *
+   * Like Train(), this does not reset the model weights, so it can be called
+   * on multiple datasets sequentially.
+   *
+   * @param data Dataset on which training should be performed.
+   * @param labels Labels of the dataset.
+   * @param numClasses Number of classes in the data.
+   * @param instanceWeights Cost matrix. Stores the cost of mispredicting
+   *      instances.  This is useful for boosting.
+   */
+  void TrainBatch(const MatType& data,
+                  const arma::Row<size_t>& labels,
+                  const size_t numClasses,
+                  const arma::rowvec& instanceWeights = arma::rowvec());
+
   /**
    * Classification function. After training, use the weights matrix to
    * classify test, and put the predicted classes in predictedLabels.
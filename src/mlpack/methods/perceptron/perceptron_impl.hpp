@@ -192,6 +192,75 @@ void Perceptron<LearnPolicy, WeightInitializationPolicy, MatType>::Train(
   }
 }
 
+/**
+ * Batched training function.  One matrix product gives the scores of every
+ * point for the epoch; only the violators receive updates, and training stops
+ * as soon as an epoch is violation-free.
+ *
+ * @param data Data to train on.
+ * @param labels Labels of data.
+ * @param instanceWeights Cost matrix. Stores the cost of mispredicting
+ *      instances.  This is useful for boosting.
+ */
+template<
+    typename LearnPolicy,
+    typename WeightInitializationPolicy,
+    typename MatType
+>
+void Perceptron<LearnPolicy, WeightInitializationPolicy, MatType>::TrainBatch(
+    const MatType& data,
+    const arma::Row<size_t>& labels,
+    const size_t numClasses,
+    const arma::rowvec& instanceWeights)
+{
+  // Do we need to resize the weights?
+  if (weights.n_elem != numClasses)
+  {
+    WeightInitializationPolicy wip;
+    wip.Initialize(weights, biases, data.n_rows, numClasses);
+  }
+
+  LearnPolicy LP;
+
+  const bool hasWeights = (instanceWeights.n_elem > 0);
+
+  arma::mat scores;
+  for (size_t i = 0; i < maxIterations; ++i)
+  {
+    // Compute the scores of every point for this epoch in one matrix product.
+    scores = weights.t() * data;
+    scores.each_col() += biases;
+
+    // The predicted label of each point is the row holding its highest score.
+    const arma::urowvec predictions = arma::index_max(scores, 0);
+
+    // Apply updates for the violators only.  Note that each update is made
+    // against the weights this epoch started with, since the predictions were
+    // all computed up front.
+    bool converged = true;
+    for (size_t j = 0; j < data.n_cols; j++)
+    {
+      if (predictions[j] == labels(0, j))
+        continue;
+
+      // Due to incorrect prediction, convergence set to false.
+      converged = false;
+
+      if (hasWeights)
+        LP.UpdateWeights(data.col(j), weights, biases, predictions[j],
+            labels(0, j), instanceWeights(j));
+      else
+        LP.UpdateWeights(data.col(j), weights, biases, predictions[j],
+            labels(0, j));
+    }
+
+    // The epoch had no violations, so the data is perfectly classified and no
+    // further passes can change the weights.
+    if (converged)
+      break;
+  }
+}
+
 //! Serialize the perceptron.
 template<typename LearnPolicy,
          typename WeightInitializationPolicy,
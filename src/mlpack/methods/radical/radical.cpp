@@ -70,24 +70,21 @@ double Radical::DoRadical2D(const mat& matX)
 {
   CopyAndPerturb(perturbed, matX);
 
-  mat::fixed<2, 2> matJacobi;
-
   vec values(angles);
 
-  for (size_t i = 0; i < angles; i++)
+  // The two perturbed coordinates are fixed across all candidate angles, and
+  // each candidate rotation only mixes them with two vector combinations, so
+  // there is no need to form and copy a full projected matrix per angle.  The
+  // candidates are independent, so they are distributed across threads.
+  #pragma omp parallel for schedule(static)
+  for (omp_size_t i = 0; i < (omp_size_t) angles; i++)
   {
     const double theta = (i / (double) angles) * M_PI / 2.0;
     const double cosTheta = cos(theta);
     const double sinTheta = sin(theta);
 
-    matJacobi(0, 0) = cosTheta;
-    matJacobi(1, 0) = -sinTheta;
-    matJacobi(0, 1) = sinTheta;
-    matJacobi(1, 1) = cosTheta;
-
-    candidate = perturbed * matJacobi;
-    vec candidateY1 = candidate.unsafe_col(0);
-    vec candidateY2 = candidate.unsafe_col(1);
+    vec candidateY1 = cosTheta * perturbed.col(0) - sinTheta * perturbed.col(1);
+    vec candidateY2 = sinTheta * perturbed.col(0) + cosTheta * perturbed.col(1);
 
     values(i) = Vasicek(candidateY1) + Vasicek(candidateY2);
   }
@@ -134,8 +131,6 @@ void Radical::DoRadical(const mat& matXT, mat& matY, mat& matW)
 
   mat matYSubspace(nPoints, 2);
 
-  mat matJ = eye(nDims, nDims);
-
   for (size_t sweepNum = 0; sweepNum < sweeps; sweepNum++)
   {
     Log::Info << "RADICAL: sweep " << sweepNum << "." << std::endl;
@@ -155,19 +150,13 @@ void Radical::DoRadical(const mat& matXT, mat& matY, mat& matW)
         const double cosThetaOpt = cos(thetaOpt);
         const double sinThetaOpt = sin(thetaOpt);
 
-        // Set elements of transformation matrix.
-        matJ(i, i) = cosThetaOpt;
-        matJ(j, i) = -sinThetaOpt;
-        matJ(i, j) = sinThetaOpt;
-        matJ(j, j) = cosThetaOpt;
-
-        matY *= matJ;
-
-        // Unset elements of transformation matrix, so matJ = eye() again.
-        matJ(i, i) = 1;
-        matJ(j, i) = 0;
-        matJ(i, j) = 0;
-        matJ(j, j) = 1;
+        // The Jacobi rotation only touches columns i and j, so update them
+        // directly instead of multiplying matY by a full rotation matrix; the
+        // unrotated columns are still held in matYSubspace.
+        matY.col(i) = cosThetaOpt * matYSubspace.col(0) -
+            sinThetaOpt * matYSubspace.col(1);
+        matY.col(j) = sinThetaOpt * matYSubspace.col(0) +
+            cosThetaOpt * matYSubspace.col(1);
       }
     }
   }
@@ -47,6 +47,31 @@ void Bootstrap(const MatType& dataset,
   }
 }
 
+/**
+ * Sample point indices with replacement for a bootstrap of the given size, and
+ * collect the out-of-bag indices (the points that were never sampled).  This
+ * lets the caller build the bootstrap sample with a single submatrix
+ * extraction from the original dataset instead of copying columns one at a
+ * time, and use the untouched points for out-of-bag validation.
+ *
+ * @param count Number of points in the dataset (and in the bootstrap sample).
+ * @param indices Output indices of the sampled points (with repetitions).
+ * @param oobIndices Output indices of the points that were not sampled.
+ */
+inline void BootstrapIndices(const size_t count,
+                             arma::uvec& indices,
+                             arma::uvec& oobIndices)
+{
+  // Random sampling with replacement.
+  indices = arma::randi<arma::uvec>(count, arma::distr_param(0, count - 1));
+
+  // Any point that was never sampled is out-of-bag.
+  arma::uvec inBag(count, arma::fill::zeros);
+  for (size_t i = 0; i < count; ++i)
+    inBag[indices[i]] = 1;
+  oobIndices = arma::find(inBag == 0);
+}
+
 } // namespace tree
 } // namespace mlpack
 
@@ -0,0 +1,126 @@
+/**
+ * @file methods/random_forest/flat_forest.hpp
+ *
+ * Definition of the FlatForest class, a cache-friendly batch prediction engine
+ * for trained random forests.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_RANDOM_FOREST_FLAT_FOREST_HPP
+#define MLPACK_METHODS_RANDOM_FOREST_FLAT_FOREST_HPP
+
+#include "random_forest.hpp"
+
+namespace mlpack {
+namespace tree {
+
+/**
+ * The FlatForest class converts a trained RandomForest (or any forest-like
+ * object exposing NumTrees() and Tree()) into a flat structure-of-arrays node
+ * layout: split dimensions, thresholds, child offsets and leaf probabilities
+ * all live in contiguous arrays, with the two children of each node stored
+ * adjacently.  Classification then runs through the flat arrays in
+ * cache-blocked batches of points, parallelized over batches with OpenMP,
+ * which avoids the pointer-chasing node traversal of DecisionTree::Classify()
+ * and gives much higher prediction throughput for large query sets.
+ *
+ * Only forests whose internal nodes are binary numeric splits (for instance
+ * BestBinaryNumericSplit or HistogramBinaryNumericSplit, the splits used for
+ * purely numeric data) can be flattened; the constructor will throw
+ * std::invalid_argument if the forest contains a categorical or non-binary
+ * split.  The flattened model gives exactly the same predictions as the
+ * forest it was built from.
+ *
+ * @tparam ForestType The type of the forest to flatten (i.e. RandomForest<>).
+ */
+template<typename ForestType>
+class FlatForest
+{
+ public:
+  /**
+   * Flatten the given trained forest.  The forest is not modified, and is not
+   * needed after construction.
+   *
+   * @param forest Trained forest to flatten.
+   */
+  FlatForest(const ForestType& forest);
+
+  /**
+   * Predict the classes of each point in the given dataset.
+   *
+   * @param data Dataset to be classified.
+   * @param predictions Output predictions for each point in the dataset.
+   */
+  template<typename MatType>
+  void Classify(const MatType& data, arma::Row<size_t>& predictions) const;
+
+  /**
+   * Predict the classes of each point in the given dataset, also returning
+   * the averaged class probabilities for each point.
+   *
+   * @param data Dataset to be classified.
+   * @param predictions Output predictions for each point in the dataset.
+   * @param probabilities Output matrix of class probabilities for each point.
+   */
+  template<typename MatType>
+  void Classify(const MatType& data,
+                arma::Row<size_t>& predictions,
+                arma::mat& probabilities) const;
+
+  //! Get the number of trees in the flattened forest.
+  size_t NumTrees() const { return treeRoots.n_elem; }
+  //! Get the total number of nodes across all trees.
+  size_t NumNodes() const { return splitDimensions.n_elem; }
+  //! Get the number of classes in the model.
+  size_t NumClasses() const { return leafProbabilities.n_rows; }
+
+  /**
+   * Serialize the flattened forest.
+   */
+  template<typename Archive>
+  void serialize(Archive& ar, const unsigned int /* version */);
+
+ private:
+  //! Number of points processed per cache block during classification.
+  static const size_t BatchSize = 256;
+
+  /**
+   * Run all points in the given column range through all trees, accumulating
+   * the summed class probabilities of the reached leaves into the
+   * corresponding columns of probabilities (which must be zeroed by the
+   * caller).
+   */
+  template<typename MatType>
+  void ClassifyBatch(const MatType& data,
+                     const size_t begin,
+                     const size_t count,
+                     arma::mat& probabilities) const;
+
+  //! Index of the root node of each tree.
+  arma::Col<size_t> treeRoots;
+  //! The dimension each node splits on (unused for leaves).
+  arma::Col<size_t> splitDimensions;
+  //! The split threshold of each node; points with values less than or equal
+  //! to the threshold go to the left child (unused for leaves).
+  arma::vec thresholds;
+  //! Index of the left child of each node, or 0 if the node is a leaf (the
+  //! root of a tree is never a child, so 0 is unambiguous).  The right child
+  //! is stored at leftChildren[i] + 1.
+  arma::Col<size_t> leftChildren;
+  //! For each leaf, the column in leafProbabilities holding its class
+  //! probabilities (unused for internal nodes).
+  arma::Col<size_t> probabilityColumns;
+  //! Class probabilities of each leaf, one leaf per column.
+  arma::mat leafProbabilities;
+};
+
+} // namespace tree
+} // namespace mlpack
+
+// Include implementation.
+#include "flat_forest_impl.hpp"
+
+#endif
@@ -0,0 +1,187 @@
+/**
+ * @file methods/random_forest/flat_forest_impl.hpp
+ *
+ * Implementation of the FlatForest class.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_RANDOM_FOREST_FLAT_FOREST_IMPL_HPP
+#define MLPACK_METHODS_RANDOM_FOREST_FLAT_FOREST_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "flat_forest.hpp"
+
+#include <queue>
+
+namespace mlpack {
+namespace tree {
+
+template<typename ForestType>
+FlatForest<ForestType>::FlatForest(const ForestType& forest)
+{
+  typedef typename ForestType::DecisionTreeType TreeType;
+
+  if (forest.NumTrees() == 0)
+  {
+    throw std::invalid_argument("FlatForest::FlatForest(): the given forest "
+        "is not trained!");
+  }
+
+  const size_t numClasses = forest.Tree(0).NumClasses();
+
+  // Build into growable buffers first; the arrays are assigned once the total
+  // number of nodes is known.
+  std::vector<size_t> roots;
+  std::vector<size_t> dims;
+  std::vector<double> splits;
+  std::vector<size_t> lefts;
+  std::vector<size_t> probCols;
+  std::vector<const TreeType*> leaves;
+
+  for (size_t t = 0; t < forest.NumTrees(); ++t)
+  {
+    // Lay the tree out in breadth-first order; both children of a node are
+    // appended together, so they are always adjacent.
+    roots.push_back(dims.size());
+    dims.push_back(0);
+    splits.push_back(0.0);
+    lefts.push_back(0);
+    probCols.push_back(0);
+
+    std::queue<std::pair<const TreeType*, size_t>> frontier;
+    frontier.push(std::make_pair(&forest.Tree(t), roots.back()));
+    while (!frontier.empty())
+    {
+      const TreeType* node = frontier.front().first;
+      const size_t index = frontier.front().second;
+      frontier.pop();
+
+      if (node->NumChildren() == 0)
+      {
+        // A leaf: record where its class probabilities will be stored.  The
+        // left child index stays 0, which marks the node as a leaf.
+        probCols[index] = leaves.size();
+        leaves.push_back(node);
+        continue;
+      }
+
+      // Only binary numeric splits fit the flat threshold layout.
+      if (node->NumChildren() != 2 ||
+          node->DimensionTypeOrMajorityClass() !=
+              (size_t) data::Datatype::numeric)
+      {
+        throw std::invalid_argument("FlatForest::FlatForest(): only forests "
+            "with binary numeric splits can be flattened!");
+      }
+
+      dims[index] = node->SplitDimension();
+      splits[index] = node->ClassProbabilities()[0];
+      lefts[index] = dims.size();
+      for (size_t c = 0; c < 2; ++c)
+      {
+        frontier.push(std::make_pair(&node->Child(c), dims.size()));
+        dims.push_back(0);
+        splits.push_back(0.0);
+        lefts.push_back(0);
+        probCols.push_back(0);
+      }
+    }
+  }
+
+  treeRoots = arma::Col<size_t>(roots);
+  splitDimensions = arma::Col<size_t>(dims);
+  thresholds = arma::vec(splits);
+  leftChildren = arma::Col<size_t>(lefts);
+  probabilityColumns = arma::Col<size_t>(probCols);
+
+  leafProbabilities.set_size(numClasses, leaves.size());
+  for (size_t i = 0; i < leaves.size(); ++i)
+    leafProbabilities.col(i) = leaves[i]->ClassProbabilities();
+}
+
+template<typename ForestType>
+template<typename MatType>
+void FlatForest<ForestType>::Classify(const MatType& data,
+                                      arma::Row<size_t>& predictions) const
+{
+  arma::mat probabilities;
+  Classify(data, predictions, probabilities);
+}
+
+template<typename ForestType>
+template<typename MatType>
+void FlatForest<ForestType>::Classify(const MatType& data,
+                                      arma::Row<size_t>& predictions,
+                                      arma::mat& probabilities) const
+{
+  probabilities.zeros(NumClasses(), data.n_cols);
+  predictions.set_size(data.n_cols);
+
+  // Process the points in cache-sized blocks: each block streams through the
+  // flat node arrays of every tree while its columns of the output are still
+  // hot, and the blocks are independent, so they parallelize trivially.
+  const size_t numBatches = (data.n_cols + BatchSize - 1) / BatchSize;
+
+  #pragma omp parallel for
+  for (omp_size_t b = 0; b < numBatches; ++b)
+  {
+    const size_t begin = b * BatchSize;
+    const size_t count = std::min((size_t) BatchSize, data.n_cols - begin);
+
+    ClassifyBatch(data, begin, count, probabilities);
+
+    // Normalize the summed leaf probabilities and extract predictions.
+    for (size_t j = begin; j < begin + count; ++j)
+    {
+      probabilities.col(j) /= (double) treeRoots.n_elem;
+      predictions[j] = (size_t) probabilities.col(j).index_max();
+    }
+  }
+}
+
+template<typename ForestType>
+template<typename MatType>
+void FlatForest<ForestType>::ClassifyBatch(const MatType& data,
+                                           const size_t begin,
+                                           const size_t count,
+                                           arma::mat& probabilities) const
+{
+  for (size_t t = 0; t < treeRoots.n_elem; ++t)
+  {
+    for (size_t j = begin; j < begin + count; ++j)
+    {
+      // Walk the flat arrays; a left child index of 0 marks a leaf.
+      size_t node = treeRoots[t];
+      while (leftChildren[node] != 0)
+      {
+        node = leftChildren[node] +
+            (((double) data(splitDimensions[node], j) <= thresholds[node]) ?
+                0 : 1);
+      }
+
+      probabilities.col(j) +=
+          leafProbabilities.col(probabilityColumns[node]);
+    }
+  }
+}
+
+template<typename ForestType>
+template<typename Archive>
+void FlatForest<ForestType>::serialize(Archive& ar,
+                                       const unsigned int /* version */)
+{
+  ar & BOOST_SERIALIZATION_NVP(treeRoots);
+  ar & BOOST_SERIALIZATION_NVP(splitDimensions);
+  ar & BOOST_SERIALIZATION_NVP(thresholds);
+  ar & BOOST_SERIALIZATION_NVP(leftChildren);
+  ar & BOOST_SERIALIZATION_NVP(probabilityColumns);
+  ar & BOOST_SERIALIZATION_NVP(leafProbabilities);
+}
+
+} // namespace tree
+} // namespace mlpack
+
+#endif
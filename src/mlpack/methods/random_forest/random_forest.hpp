@@ -35,7 +35,7 @@ class RandomForest
    * Construct the random forest without any training or specifying the number
    * of trees.  Predict() will throw an exception until Train() is called.
    */
-  RandomForest() { }
+  RandomForest() : oobAccuracy(0.0) { }
 
   /**
    * Create a random forest, training on the given labeled training data with
@@ -276,6 +276,22 @@ class RandomForest
                DimensionSelectionType dimensionSelector =
                    DimensionSelectionType());
 
+  /**
+   * Merge another random forest into this one, taking ownership of its trees.
+   * This is the reduction step of data-parallel training: each worker trains
+   * a forest on its own shard of the data (see data::ShardColumns()), and the
+   * per-shard forests are merged into the final ensemble.  Since every tree
+   * votes independently at prediction time, the merged forest is a valid
+   * random forest over the union of the shards.
+   *
+   * The out-of-bag accuracy of the merged forest is the tree-count-weighted
+   * average of the two estimates; each estimate only covers its own shard, so
+   * this is an approximation.
+   *
+   * @param other Forest to merge in; its trees are moved out of it.
+   */
+  void Merge(RandomForest&& other);
+
   /**
    * Predict the class of the given point.  If the random forest has not been
    * trained, this will throw an exception.
@@ -332,6 +348,15 @@ class RandomForest
   //! Get the number of trees in the forest.
   size_t NumTrees() const { return trees.size(); }
 
+  /**
+   * Get the out-of-bag accuracy computed during the last call to Train().
+   * Each point is classified by majority vote of the trees whose bootstrap
+   * sample did not contain it, giving an unbiased estimate of generalization
+   * accuracy at no extra training cost.  Returns 0 if the forest has not been
+   * trained.
+   */
+  double OOBAccuracy() const { return oobAccuracy; }
+
   /**
    * Serialize the random forest.
    */
@@ -373,6 +398,9 @@ class RandomForest
 
   //! The trees in the forest.
   std::vector<DecisionTreeType> trees;
+
+  //! The out-of-bag accuracy from the last call to Train().
+  double oobAccuracy;
 };
 
 } // namespace tree
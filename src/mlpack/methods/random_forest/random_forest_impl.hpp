@@ -14,6 +14,7 @@
 
 // In case it hasn't been included yet.
 #include "random_forest.hpp"
+#include <mlpack/core/util/parallelism.hpp>
 
 namespace mlpack {
 namespace tree {
@@ -263,6 +264,36 @@ double RandomForest<
       dimensionSelector);
 }
 
+template<
+    typename FitnessFunction,
+    typename DimensionSelectionType,
+    template<typename> class NumericSplitType,
+    template<typename> class CategoricalSplitType,
+    typename ElemType
+>
+void RandomForest<
+    FitnessFunction,
+    DimensionSelectionType,
+    NumericSplitType,
+    CategoricalSplitType,
+    ElemType
+>::Merge(RandomForest&& other)
+{
+  // Combine the out-of-bag estimates before the tree counts change.
+  const size_t totalTrees = trees.size() + other.trees.size();
+  if (totalTrees > 0)
+  {
+    oobAccuracy = (oobAccuracy * trees.size() +
+        other.oobAccuracy * other.trees.size()) / totalTrees;
+  }
+
+  trees.reserve(totalTrees);
+  for (size_t i = 0; i < other.trees.size(); ++i)
+    trees.push_back(std::move(other.trees[i]));
+  other.trees.clear();
+  other.oobAccuracy = 0.0;
+}
+
 template<
     typename FitnessFunction,
     typename DimensionSelectionType,
@@ -362,7 +393,8 @@ void RandomForest<
 
   predictions.set_size(data.n_cols);
 
-  #pragma omp parallel for
+  #pragma omp parallel for \
+      num_threads((int) Parallelism::Threads("random_forest"))
   for (omp_size_t i = 0; i < data.n_cols; ++i)
   {
     predictions[i] = Classify(data.col(i));
@@ -399,7 +431,8 @@ void RandomForest<
 
   probabilities.set_size(trees[0].NumClasses(), data.n_cols);
   predictions.set_size(data.n_cols);
-  #pragma omp parallel for
+  #pragma omp parallel for \
+      num_threads((int) Parallelism::Threads("random_forest"))
   for (omp_size_t i = 0; i < data.n_cols; ++i)
   {
     arma::vec probs = probabilities.unsafe_col(i);
@@ -436,6 +469,7 @@ void RandomForest<
     trees.resize(numTrees);
 
   ar & BOOST_SERIALIZATION_NVP(trees);
+  ar & BOOST_SERIALIZATION_NVP(oobAccuracy);
 }
 
 template<
@@ -467,15 +501,24 @@ double RandomForest<
   trees.resize(numTrees); // This will fill the vector with untrained trees.
   double avgGain = 0.0;
 
-  #pragma omp parallel for reduction( + : avgGain)
+  // Out-of-bag class votes for each point, accumulated across all trees.
+  arma::Mat<size_t> oobVotes(numClasses, dataset.n_cols, arma::fill::zeros);
+
+  #pragma omp parallel for reduction( + : avgGain) \
+      num_threads((int) Parallelism::Threads("random_forest"))
   for (omp_size_t i = 0; i < numTrees; ++i)
   {
     Timer::Start("bootstrap");
-    MatType bootstrapDataset;
-    arma::Row<size_t> bootstrapLabels;
+    arma::uvec indices, oobIndices;
+    BootstrapIndices(dataset.n_cols, indices, oobIndices);
+
+    // Build the bootstrap sample as a single submatrix extraction; the tree
+    // takes ownership of it, so no second copy is made inside Train().
+    MatType bootstrapDataset = dataset.cols(indices);
+    arma::Row<size_t> bootstrapLabels = labels.cols(indices);
     arma::rowvec bootstrapWeights;
-    Bootstrap<UseWeights>(dataset, labels, weights, bootstrapDataset,
-        bootstrapLabels, bootstrapWeights);
+    if (UseWeights)
+      bootstrapWeights = weights.cols(indices);
     Timer::Stop("bootstrap");
 
     // Now build the decision tree.
@@ -484,33 +527,63 @@ double RandomForest<
     {
       if (UseDatasetInfo)
       {
-        avgGain += trees[i].Train(bootstrapDataset, datasetInfo,
-            bootstrapLabels, numClasses, bootstrapWeights, minimumLeafSize,
-            minimumGainSplit, maximumDepth, dimensionSelector);
+        avgGain += trees[i].Train(std::move(bootstrapDataset), datasetInfo,
+            std::move(bootstrapLabels), numClasses, std::move(bootstrapWeights),
+            minimumLeafSize, minimumGainSplit, maximumDepth, dimensionSelector);
       }
       else
       {
-        avgGain += trees[i].Train(bootstrapDataset, bootstrapLabels, numClasses,
-            bootstrapWeights, minimumLeafSize, minimumGainSplit, maximumDepth,
-            dimensionSelector);
+        avgGain += trees[i].Train(std::move(bootstrapDataset),
+            std::move(bootstrapLabels), numClasses, std::move(bootstrapWeights),
+            minimumLeafSize, minimumGainSplit, maximumDepth, dimensionSelector);
       }
     }
     else
     {
       if (UseDatasetInfo)
       {
-        avgGain += trees[i].Train(bootstrapDataset, datasetInfo,
-            bootstrapLabels, numClasses, minimumLeafSize, minimumGainSplit,
-            maximumDepth, dimensionSelector);
+        avgGain += trees[i].Train(std::move(bootstrapDataset), datasetInfo,
+            std::move(bootstrapLabels), numClasses, minimumLeafSize,
+            minimumGainSplit, maximumDepth, dimensionSelector);
       }
       else
       {
-        avgGain += trees[i].Train(bootstrapDataset, bootstrapLabels, numClasses,
-            minimumLeafSize, minimumGainSplit, maximumDepth, dimensionSelector);
+        avgGain += trees[i].Train(std::move(bootstrapDataset),
+            std::move(bootstrapLabels), numClasses, minimumLeafSize,
+            minimumGainSplit, maximumDepth, dimensionSelector);
       }
     }
     Timer::Stop("train_tree");
+
+    // Score the points this tree never saw, for the out-of-bag estimate.
+    if (oobIndices.n_elem > 0)
+    {
+      const MatType oobDataset = dataset.cols(oobIndices);
+      arma::Row<size_t> oobPredictions;
+      trees[i].Classify(oobDataset, oobPredictions);
+
+      #pragma omp critical (randomForestOOBVotes)
+      for (size_t j = 0; j < oobIndices.n_elem; ++j)
+        ++oobVotes(oobPredictions[j], oobIndices[j]);
+    }
   }
+
+  // The out-of-bag accuracy is the majority-vote accuracy over all points that
+  // were out-of-bag for at least one tree.
+  size_t oobCorrect = 0;
+  size_t oobTotal = 0;
+  for (size_t i = 0; i < dataset.n_cols; ++i)
+  {
+    if (arma::accu(oobVotes.col(i)) == 0)
+      continue; // The point was in every tree's bootstrap sample.
+
+    ++oobTotal;
+    if (oobVotes.col(i).index_max() == labels[i])
+      ++oobCorrect;
+  }
+  oobAccuracy = (oobTotal > 0) ? ((double) oobCorrect / (double) oobTotal) :
+      0.0;
+
   return avgGain / numTrees;
 }
 
@@ -22,10 +22,14 @@ RandomizedSVD::RandomizedSVD(const arma::mat& data,
                              const size_t iteratedPower,
                              const size_t maxIterations,
                              const size_t rank,
-                             const double eps) :
+                             const double eps,
+                             const size_t blockSize,
+                             const size_t reorthInterval) :
     iteratedPower(iteratedPower),
     maxIterations(maxIterations),
-    eps(eps)
+    eps(eps),
+    blockSize(blockSize),
+    reorthInterval(reorthInterval)
 {
   if (rank == 0)
   {
@@ -39,10 +43,14 @@ RandomizedSVD::RandomizedSVD(const arma::mat& data,
 
 RandomizedSVD::RandomizedSVD(const size_t iteratedPower,
                              const size_t maxIterations,
-                             const double eps) :
+                             const double eps,
+                             const size_t blockSize,
+                             const size_t reorthInterval) :
     iteratedPower(iteratedPower),
     maxIterations(maxIterations),
-    eps(eps)
+    eps(eps),
+    blockSize(blockSize),
+    reorthInterval(reorthInterval)
 {
   /* Nothing to do here */
 }
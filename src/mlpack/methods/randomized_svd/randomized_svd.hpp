@@ -80,6 +80,13 @@ class RandomizedSVD
    * @param rank Rank of the approximation (Default: number of rows.)
    * @param eps The eps coefficient to avoid division by zero (numerical
    *        stability).
+   * @param blockSize Number of data columns processed per chunk when the
+   *        random sketch is applied.  If set to 0, the sketch is applied as
+   *        one in-memory product (Default: 0).
+   * @param reorthInterval Re-orthonormalize the basis with a QR decomposition
+   *        every reorthInterval power iterations instead of the cheaper LU
+   *        normalization.  If set to 0, QR is only used for the final
+   *        iteration (Default: 0).
    */
   RandomizedSVD(const arma::mat& data,
                 arma::mat& u,
@@ -88,7 +95,9 @@ class RandomizedSVD
                 const size_t iteratedPower = 0,
                 const size_t maxIterations = 2,
                 const size_t rank = 0,
-                const double eps = 1e-7);
+                const double eps = 1e-7,
+                const size_t blockSize = 0,
+                const size_t reorthInterval = 0);
 
   /**
    * Create object for the randomized SVD method.
@@ -99,10 +108,19 @@ class RandomizedSVD
    *        (Default: 2).
    * @param eps The eps coefficient to avoid division by zero (numerical
    *        stability).
+   * @param blockSize Number of data columns processed per chunk when the
+   *        random sketch is applied.  If set to 0, the sketch is applied as
+   *        one in-memory product (Default: 0).
+   * @param reorthInterval Re-orthonormalize the basis with a QR decomposition
+   *        every reorthInterval power iterations instead of the cheaper LU
+   *        normalization.  If set to 0, QR is only used for the final
+   *        iteration (Default: 0).
    */
   RandomizedSVD(const size_t iteratedPower = 0,
                 const size_t maxIterations = 2,
-                const double eps = 1e-7);
+                const double eps = 1e-7,
+                const size_t blockSize = 0,
+                const size_t reorthInterval = 0);
 
 /**
    * Center the data to apply Principal Component Analysis on given sparse
@@ -158,19 +176,20 @@ class RandomizedSVD
     if (iteratedPower == 0)
       iteratedPower = rank + 2;
 
-    arma::mat R, Q, Qdata;
+    arma::mat R, Q, Qdata, tmp;
 
     // Apply the centered data matrix to a random matrix, obtaining Q.
     if (data.n_cols >= data.n_rows)
     {
       R = arma::randn<arma::mat>(data.n_rows, iteratedPower);
-      Q = (data.t() * R) - arma::repmat(arma::trans(R.t() * rowMean),
-          data.n_cols, 1);
+      MultiplyTranspose(data, R, Q);
+      Q -= arma::repmat(arma::trans(R.t() * rowMean), data.n_cols, 1);
     }
     else
     {
       R = arma::randn<arma::mat>(data.n_cols, iteratedPower);
-      Q = (data * R) - (rowMean * (arma::ones(1, data.n_cols) * R));
+      Multiply(data, R, Q);
+      Q -= rowMean * (arma::ones(1, data.n_cols) * R);
     }
 
     // Form a matrix Q whose columns constitute a
@@ -189,28 +208,35 @@ class RandomizedSVD
     {
       if (data.n_cols >= data.n_rows)
       {
-        Q = (data * Q) - rowMean * (arma::ones(1, data.n_cols) * Q);
+        Multiply(data, Q, tmp);
+        Q = tmp - rowMean * (arma::ones(1, data.n_cols) * Q);
         arma::lu(Q, v, Q);
-        Q = (data.t() * Q) - arma::repmat(rowMean.t() * Q, data.n_cols, 1);
+        MultiplyTranspose(data, Q, tmp);
+        Q = tmp - arma::repmat(rowMean.t() * Q, data.n_cols, 1);
       }
       else
       {
-        Q = (data.t() * Q) - arma::repmat(rowMean.t() * Q, data.n_cols, 1);
-        arma::lu(Q, v, Q);
-        Q = (data * Q) - (rowMean * (arma::ones(1, data.n_cols) * Q));
+        MultiplyTranspose(data, Q, tmp);
+        tmp -= arma::repmat(rowMean.t() * Q, data.n_cols, 1);
+        arma::lu(tmp, v, tmp);
+        Multiply(data, tmp, Q);
+        Q -= rowMean * (arma::ones(1, data.n_cols) * tmp);
       }
 
       // Computing the LU decomposition is more efficient than computing the QR
-      // decomposition, so we only use it in the last iteration, a pivoted QR
-      // decomposition which renormalizes Q, ensuring that the columns of Q are
-      // orthonormal.
-      if (i < (maxIterations - 1))
+      // decomposition, so by default we only use QR in the last iteration, a
+      // pivoted QR decomposition which renormalizes Q, ensuring that the
+      // columns of Q are orthonormal.  If a re-orthonormalization interval is
+      // set, QR is also used every reorthInterval iterations to keep the basis
+      // well-conditioned during long power iterations.
+      if (i == (maxIterations - 1) ||
+          (reorthInterval > 0 && ((i + 1) % reorthInterval == 0)))
       {
-        arma::lu(Q, v, Q);
+        arma::qr_econ(Q, v, Q);
       }
       else
       {
-        arma::qr_econ(Q, v, Q);
+        arma::lu(Q, v, Q);
       }
     }
 
@@ -219,7 +245,8 @@ class RandomizedSVD
     // applied to Q.
     if (data.n_cols >= data.n_rows)
     {
-      Qdata = (data * Q) - rowMean * (arma::ones(1, data.n_cols) * Q);
+      Multiply(data, Q, Qdata);
+      Qdata -= rowMean * (arma::ones(1, data.n_cols) * Q);
       arma::svd_econ(u, s, v, Qdata);
       v = Q * v;
     }
@@ -246,7 +273,79 @@ class RandomizedSVD
   //! Modify the value used for decomposition stability.
   double& Epsilon() { return eps; }
 
+  //! Get the number of data columns processed per sketch chunk.
+  size_t BlockSize() const { return blockSize; }
+  //! Modify the number of data columns processed per sketch chunk.
+  size_t& BlockSize() { return blockSize; }
+
+  //! Get the QR re-orthonormalization interval.
+  size_t ReorthInterval() const { return reorthInterval; }
+  //! Modify the QR re-orthonormalization interval.
+  size_t& ReorthInterval() { return reorthInterval; }
+
  private:
+  /**
+   * Compute out = data * x.  If a block size is set, the product is
+   * accumulated over chunks of blockSize data columns in a single pass, with
+   * the chunks processed in parallel; each chunk only touches a blockSize
+   * wide slice of the data, so this is the access pattern needed when the
+   * data matrix is memory-mapped rather than resident.
+   */
+  template<typename MatType>
+  void Multiply(const MatType& data, const arma::mat& x, arma::mat& out)
+  {
+    if (blockSize == 0 || blockSize >= data.n_cols)
+    {
+      out = data * x;
+      return;
+    }
+
+    out.zeros(data.n_rows, x.n_cols);
+    const size_t numChunks = (data.n_cols + blockSize - 1) / blockSize;
+    #pragma omp parallel
+    {
+      arma::mat partial(data.n_rows, x.n_cols, arma::fill::zeros);
+      #pragma omp for schedule(static) nowait
+      for (omp_size_t c = 0; c < (omp_size_t) numChunks; ++c)
+      {
+        const size_t begin = c * blockSize;
+        const size_t end = (begin + blockSize > data.n_cols) ?
+            (data.n_cols - 1) : (begin + blockSize - 1);
+        partial += data.cols(begin, end) * x.rows(begin, end);
+      }
+      #pragma omp critical
+      out += partial;
+    }
+  }
+
+  /**
+   * Compute out = data.t() * x.  If a block size is set, the chunks of
+   * blockSize data columns each produce a disjoint block of output rows, so
+   * they are processed in parallel without any reduction.
+   */
+  template<typename MatType>
+  void MultiplyTranspose(const MatType& data,
+                         const arma::mat& x,
+                         arma::mat& out)
+  {
+    if (blockSize == 0 || blockSize >= data.n_cols)
+    {
+      out = data.t() * x;
+      return;
+    }
+
+    out.set_size(data.n_cols, x.n_cols);
+    const size_t numChunks = (data.n_cols + blockSize - 1) / blockSize;
+    #pragma omp parallel for schedule(static)
+    for (omp_size_t c = 0; c < (omp_size_t) numChunks; ++c)
+    {
+      const size_t begin = c * blockSize;
+      const size_t end = (begin + blockSize > data.n_cols) ?
+          (data.n_cols - 1) : (begin + blockSize - 1);
+      out.rows(begin, end) = data.cols(begin, end).t() * x;
+    }
+  }
+
   //! Locally stored size of the normalized power iterations.
   size_t iteratedPower;
 
@@ -255,6 +354,13 @@ class RandomizedSVD
 
   //! The value used for numerical stability.
   double eps;
+
+  //! Number of data columns processed per sketch chunk (0 means no chunking).
+  size_t blockSize;
+
+  //! Re-orthonormalize with QR every reorthInterval power iterations (0 means
+  //! only in the final iteration).
+  size_t reorthInterval;
 };
 
 } // namespace svd
@@ -0,0 +1,144 @@
+/**
+ * @file methods/range_search/streaming_range_search.hpp
+ *
+ * Defines the StreamingRangeSearch class, which performs range search over a
+ * reference set that is processed one chunk at a time, so the full set never
+ * needs to be resident in memory as a single matrix with a single tree.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_RANGE_SEARCH_STREAMING_RANGE_SEARCH_HPP
+#define MLPACK_METHODS_RANGE_SEARCH_STREAMING_RANGE_SEARCH_HPP
+
+#include <mlpack/prereqs.hpp>
+#include "range_search.hpp"
+
+namespace mlpack {
+namespace range {
+
+/**
+ * The StreamingRangeSearch class performs range search against a reference
+ * set that is delivered in chunks, building a temporary tree over each chunk
+ * and appending the chunk's results to the caller's result vectors.  Because
+ * range search results are simple unions over disjoint reference subsets,
+ * searching chunk-by-chunk produces exactly the same results as searching the
+ * concatenated set with a single tree, while keeping only one chunk (and its
+ * tree) in memory at a time.
+ *
+ * The intended use is reference archives far larger than RAM: the caller
+ * reads (or memory-maps) one segment of the archive at a time and passes it
+ * to SearchChunk().  Chunk indices are offset by the number of reference
+ * points already processed, so when the chunks are fed in archive order the
+ * reported neighbor indices refer to the full archive.  For a reference set
+ * that is already addressable in memory, the convenience Search() overload
+ * performs the chunking internally.
+ *
+ * @tparam MetricType Metric to use for range search calculations.
+ * @tparam MatType Type of data to use.
+ * @tparam TreeType Type of tree to use; must satisfy the TreeType policy API.
+ */
+template<typename MetricType = metric::EuclideanDistance,
+         typename MatType = arma::mat,
+         template<typename TreeMetricType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType = tree::KDTree>
+class StreamingRangeSearch
+{
+ public:
+  /**
+   * Create the StreamingRangeSearch object.
+   *
+   * @param singleMode Whether single-tree computation should be used within
+   *      each chunk (as opposed to dual-tree computation).
+   * @param metric Instantiated distance metric.
+   */
+  StreamingRangeSearch(const bool singleMode = false,
+                       const MetricType metric = MetricType());
+
+  /**
+   * Search one chunk of the reference set: a temporary tree is built over an
+   * internal copy of the chunk (the caller's chunk memory, e.g. a
+   * memory-mapped segment, is left untouched), and every reference point of
+   * the chunk whose distance to a query point lies in the given range is
+   * appended to that query point's entries in the neighbors and distances
+   * vectors.  Reported indices are offset by the number of reference points
+   * processed by earlier calls, so feeding the chunks in order yields indices
+   * into the full reference set.
+   *
+   * On the first call of a stream the result vectors are cleared and resized
+   * to the number of query points; subsequent calls append to them.  The
+   * query set and range must stay the same for the lifetime of a stream; call
+   * Reset() to begin a new one.
+   *
+   * @param chunk Chunk of reference points to search.
+   * @param querySet Set of query points to search with.
+   * @param range Range of distances in which to search.
+   * @param neighbors Object which accumulates the list of in-range reference
+   *      indices for each query point.
+   * @param distances Object which accumulates the corresponding distances.
+   */
+  void SearchChunk(const MatType& chunk,
+                   const MatType& querySet,
+                   const math::Range& range,
+                   std::vector<std::vector<size_t>>& neighbors,
+                   std::vector<std::vector<double>>& distances);
+
+  /**
+   * Search an entire reference set, processing it in chunks of the given
+   * number of columns so that only one chunk's tree is in memory at a time.
+   * This gives exactly the same results as RangeSearch on the whole set.
+   * The reference set may be backed by memory-mapped storage (for example an
+   * Armadillo matrix constructed over a mapped file), in which case only the
+   * pages of the current chunk need to be resident.
+   *
+   * @param referenceSet Set of reference points to search.
+   * @param querySet Set of query points to search with.
+   * @param range Range of distances in which to search.
+   * @param chunkSize Number of reference points to process per chunk.
+   * @param neighbors Object which will hold the list of in-range reference
+   *      indices for each query point.
+   * @param distances Object which will hold the corresponding distances.
+   */
+  void Search(const MatType& referenceSet,
+              const MatType& querySet,
+              const math::Range& range,
+              const size_t chunkSize,
+              std::vector<std::vector<size_t>>& neighbors,
+              std::vector<std::vector<double>>& distances);
+
+  /**
+   * Reset the stream, so that the next call to SearchChunk() starts a new
+   * search with reference indices beginning at zero.
+   */
+  void Reset() { numPointsProcessed = 0; }
+
+  //! Get the number of reference points processed in the current stream.
+  size_t NumPointsProcessed() const { return numPointsProcessed; }
+
+  //! Get whether single-tree search is being used within each chunk.
+  bool SingleMode() const { return singleMode; }
+  //! Modify whether single-tree search is being used within each chunk.
+  bool& SingleMode() { return singleMode; }
+
+ private:
+  //! If true, single-tree computation is used within each chunk.
+  bool singleMode;
+
+  //! Instantiated distance metric.
+  MetricType metric;
+
+  //! The number of reference points processed so far in the current stream;
+  //! used to offset the indices reported for each chunk.
+  size_t numPointsProcessed;
+};
+
+} // namespace range
+} // namespace mlpack
+
+// Include implementation.
+#include "streaming_range_search_impl.hpp"
+
+#endif
@@ -0,0 +1,114 @@
+/**
+ * @file methods/range_search/streaming_range_search_impl.hpp
+ *
+ * Implementation of the StreamingRangeSearch class, which performs range
+ * search over a reference set delivered one chunk at a time.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_RANGE_SEARCH_STREAMING_RANGE_SEARCH_IMPL_HPP
+#define MLPACK_METHODS_RANGE_SEARCH_STREAMING_RANGE_SEARCH_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "streaming_range_search.hpp"
+
+namespace mlpack {
+namespace range {
+
+template<typename MetricType,
+         typename MatType,
+         template<typename TreeMetricType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType>
+StreamingRangeSearch<MetricType, MatType, TreeType>::StreamingRangeSearch(
+    const bool singleMode,
+    const MetricType metric) :
+    singleMode(singleMode),
+    metric(metric),
+    numPointsProcessed(0)
+{
+  // Nothing to do.
+}
+
+template<typename MetricType,
+         typename MatType,
+         template<typename TreeMetricType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType>
+void StreamingRangeSearch<MetricType, MatType, TreeType>::SearchChunk(
+    const MatType& chunk,
+    const MatType& querySet,
+    const math::Range& range,
+    std::vector<std::vector<size_t>>& neighbors,
+    std::vector<std::vector<double>>& distances)
+{
+  // On the first chunk of a stream, prepare the result vectors.
+  if (numPointsProcessed == 0)
+  {
+    neighbors.clear();
+    neighbors.resize(querySet.n_cols);
+    distances.clear();
+    distances.resize(querySet.n_cols);
+  }
+
+  // Search the chunk with an ordinary RangeSearch; the chunk is copied, so
+  // the caller's memory (e.g. a memory-mapped segment) is not rearranged
+  // during tree building.  RangeSearch maps the chunk-local indices back to
+  // the order the chunk was given in.
+  RangeSearch<MetricType, MatType, TreeType> search(chunk, false, singleMode,
+      metric);
+
+  std::vector<std::vector<size_t>> chunkNeighbors;
+  std::vector<std::vector<double>> chunkDistances;
+  search.Search(querySet, range, chunkNeighbors, chunkDistances);
+
+  // Append the chunk's results, offsetting the indices so that they refer to
+  // the full reference set.
+  for (size_t i = 0; i < querySet.n_cols; ++i)
+  {
+    for (size_t j = 0; j < chunkNeighbors[i].size(); ++j)
+    {
+      neighbors[i].push_back(chunkNeighbors[i][j] + numPointsProcessed);
+      distances[i].push_back(chunkDistances[i][j]);
+    }
+  }
+
+  numPointsProcessed += chunk.n_cols;
+}
+
+template<typename MetricType,
+         typename MatType,
+         template<typename TreeMetricType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType>
+void StreamingRangeSearch<MetricType, MatType, TreeType>::Search(
+    const MatType& referenceSet,
+    const MatType& querySet,
+    const math::Range& range,
+    const size_t chunkSize,
+    std::vector<std::vector<size_t>>& neighbors,
+    std::vector<std::vector<double>>& distances)
+{
+  if (chunkSize == 0)
+    throw std::invalid_argument("StreamingRangeSearch::Search(): chunk size "
+        "must be greater than 0!");
+
+  Reset();
+
+  for (size_t start = 0; start < referenceSet.n_cols; start += chunkSize)
+  {
+    const size_t end = std::min(start + chunkSize, (size_t)
+        referenceSet.n_cols);
+    const MatType chunk = referenceSet.cols(start, end - 1);
+
+    SearchChunk(chunk, querySet, range, neighbors, distances);
+  }
+}
+
+} // namespace range
+} // namespace mlpack
+
+#endif
@@ -17,6 +17,10 @@
 
 #include "ra_search_rules.hpp"
 
+#ifdef HAS_OPENMP
+  #include <omp.h>
+#endif
+
 namespace mlpack {
 namespace neighbor {
 
@@ -319,7 +323,61 @@ Search(const MatType& querySet,
 
     // If the reference root node is a leaf, then the sampling has already been
     // done in the RASearchRules constructor.  This happens when naive = true.
-    if (!referenceTree->IsLeaf())
+    //
+    // If more than one thread is available, shard the query set across the
+    // threads, giving each its own copy of the rules (the per-query candidate
+    // lists and sample counts are independent, but the sampling buffers and
+    // counters are not).  Each thread extracts and stores the results for its
+    // own shard, so the shared output matrices are written without
+    // contention.
+    bool searchedInParallel = false;
+#ifdef HAS_OPENMP
+    const size_t numThreads = (size_t) omp_get_max_threads();
+    if (!referenceTree->IsLeaf() && numThreads > 1 && querySet.n_cols > 1)
+    {
+      Log::Info << "Performing single-tree traversal..." << std::endl;
+
+      size_t parallelDistComputations = 0;
+
+      #pragma omp parallel reduction(+: parallelDistComputations)
+      {
+        const size_t thread = (size_t) omp_get_thread_num();
+        const size_t actualThreads = (size_t) omp_get_num_threads();
+        const size_t shardBegin = (thread * querySet.n_cols) / actualThreads;
+        const size_t shardEnd =
+            ((thread + 1) * querySet.n_cols) / actualThreads;
+
+        if (shardEnd > shardBegin)
+        {
+          RuleType localRules(rules);
+          typename Tree::template SingleTreeTraverser<RuleType>
+              traverser(localRules);
+
+          for (size_t i = shardBegin; i < shardEnd; ++i)
+            traverser.Traverse(i, *referenceTree);
+
+          parallelDistComputations += localRules.NumDistComputations();
+
+          arma::Mat<size_t> shardNeighbors;
+          arma::mat shardDistances;
+          localRules.GetResults(shardNeighbors, shardDistances);
+
+          neighborPtr->cols(shardBegin, shardEnd - 1) =
+              shardNeighbors.cols(shardBegin, shardEnd - 1);
+          distancePtr->cols(shardBegin, shardEnd - 1) =
+              shardDistances.cols(shardBegin, shardEnd - 1);
+        }
+      }
+
+      Log::Info << "Single-tree traversal complete." << std::endl;
+      Log::Info << "Average number of distance calculations per query point: "
+          << (parallelDistComputations / querySet.n_cols) << "." << std::endl;
+
+      searchedInParallel = true;
+    }
+#endif
+
+    if (!searchedInParallel && !referenceTree->IsLeaf())
     {
       Log::Info << "Performing single-tree traversal..." << std::endl;
 
@@ -336,7 +394,8 @@ Search(const MatType& querySet,
           << std::endl;
     }
 
-    rules.GetResults(*neighborPtr, *distancePtr);
+    if (!searchedInParallel)
+      rules.GetResults(*neighborPtr, *distancePtr);
   }
   else // Dual-tree recursion.
   {
@@ -296,8 +296,29 @@ class RASearchRules
   //! If the query and reference set are identical, this is true.
   bool sameSet;
 
+  //! Preallocated buffer holding the distinct sample indices produced by the
+  //! most recent call to DistinctSamples().
+  arma::uvec sampleBuffer;
+
+  //! Preallocated deduplication flags for DistinctSamples(); always all-false
+  //! between calls (only the touched bits are reset).
+  std::vector<bool> sampledBits;
+
   TraversalInfoType traversalInfo;
 
+  /**
+   * Sample up to maxNumSamples distinct indices from [0, rangeSize), storing
+   * them in the first entries of sampleBuffer and returning how many distinct
+   * indices were obtained.  If the range is no larger than the number of
+   * samples requested, the whole range is enumerated instead.  This reuses
+   * the preallocated sampleBuffer and sampledBits members, so no allocation
+   * happens in the sampling hot path.
+   *
+   * @param rangeSize Size of the range to sample from.
+   * @param maxNumSamples Number of samples to draw (with replacement).
+   */
+  size_t DistinctSamples(const size_t rangeSize, const size_t maxNumSamples);
+
   /**
    * Helper function to insert a point into the list of candidate points.
    *
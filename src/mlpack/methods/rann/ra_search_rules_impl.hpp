@@ -84,17 +84,55 @@ RASearchRules(const arma::mat& referenceSet,
   for (size_t i = 0; i < querySet.n_cols; i++)
     candidates.push_back(pqueue);
 
+  // Preallocate the sampling buffers; DistinctSamples() reuses them so that
+  // no allocation happens in the sampling hot path.
+  sampleBuffer.set_size(n);
+  sampledBits.resize(n, false);
+
   if (naive) // No tree traversal; just do naive sampling here.
   {
     // Sample enough points.
-    arma::uvec distinctSamples;
     for (size_t i = 0; i < querySet.n_cols; ++i)
     {
-      math::ObtainDistinctSamples(0, n, numSamplesReqd, distinctSamples);
-      for (size_t j = 0; j < distinctSamples.n_elem; j++)
-        BaseCase(i, (size_t) distinctSamples[j]);
+      const size_t numSamples = DistinctSamples(n, numSamplesReqd);
+      for (size_t j = 0; j < numSamples; j++)
+        BaseCase(i, sampleBuffer[j]);
+    }
+  }
+}
+
+template<typename SortPolicy, typename MetricType, typename TreeType>
+size_t RASearchRules<SortPolicy, MetricType, TreeType>::DistinctSamples(
+    const size_t rangeSize,
+    const size_t maxNumSamples)
+{
+  if (rangeSize <= maxNumSamples)
+  {
+    // We would sample the whole range anyway, so just enumerate it.
+    for (size_t i = 0; i < rangeSize; ++i)
+      sampleBuffer[i] = i;
+    return rangeSize;
+  }
+
+  // Draw with replacement and deduplicate with the bit flags, collecting each
+  // distinct index into the sample buffer.
+  size_t numDistinct = 0;
+  for (size_t i = 0; i < maxNumSamples; ++i)
+  {
+    const size_t sample = (size_t) math::RandInt(rangeSize);
+    if (!sampledBits[sample])
+    {
+      sampledBits[sample] = true;
+      sampleBuffer[numDistinct++] = sample;
     }
   }
+
+  // Reset only the bits we touched, so the next call starts clean without an
+  // O(rangeSize) clear.
+  for (size_t i = 0; i < numDistinct; ++i)
+    sampledBits[sampleBuffer[i]] = false;
+
+  return numDistinct;
 }
 
 template<typename SortPolicy, typename MetricType, typename TreeType>
@@ -203,13 +241,12 @@ inline double RASearchRules<SortPolicy, MetricType, TreeType>::Score(
         {
           // Then samplesReqd <= singleSampleLimit.
           // Hence, approximate the node by sampling enough number of points.
-          arma::uvec distinctSamples;
-          math::ObtainDistinctSamples(0, referenceNode.NumDescendants(),
-              samplesReqd, distinctSamples);
-          for (size_t i = 0; i < distinctSamples.n_elem; i++)
+          const size_t numSamples = DistinctSamples(
+              referenceNode.NumDescendants(), samplesReqd);
+          for (size_t i = 0; i < numSamples; i++)
             // The counting of the samples are done in the 'BaseCase' function
             // so no book-keeping is required here.
-            BaseCase(queryIndex, referenceNode.Descendant(distinctSamples[i]));
+            BaseCase(queryIndex, referenceNode.Descendant(sampleBuffer[i]));
 
           // Node approximated, so we can prune it.
           return DBL_MAX;
@@ -219,14 +256,12 @@ inline double RASearchRules<SortPolicy, MetricType, TreeType>::Score(
           if (sampleAtLeaves) // If allowed to sample at leaves.
           {
             // Approximate node by sampling enough number of points.
-            arma::uvec distinctSamples;
-            math::ObtainDistinctSamples(0, referenceNode.NumDescendants(),
-                samplesReqd, distinctSamples);
-            for (size_t i = 0; i < distinctSamples.n_elem; i++)
+            const size_t numSamples = DistinctSamples(
+                referenceNode.NumDescendants(), samplesReqd);
+            for (size_t i = 0; i < numSamples; i++)
               // The counting of the samples are done in the 'BaseCase' function
               // so no book-keeping is required here.
-              BaseCase(queryIndex,
-                  referenceNode.Descendant(distinctSamples[i]));
+              BaseCase(queryIndex, referenceNode.Descendant(sampleBuffer[i]));
 
             // (Leaf) node approximated, so we can prune it.
             return DBL_MAX;
@@ -307,13 +342,12 @@ Rescore(const size_t queryIndex,
       {
         // Then, samplesReqd <= singleSampleLimit.  Hence, approximate the node
         // by sampling enough number of points.
-        arma::uvec distinctSamples;
-        math::ObtainDistinctSamples(0, referenceNode.NumDescendants(),
-            samplesReqd, distinctSamples);
-        for (size_t i = 0; i < distinctSamples.n_elem; i++)
+        const size_t numSamples = DistinctSamples(
+            referenceNode.NumDescendants(), samplesReqd);
+        for (size_t i = 0; i < numSamples; i++)
           // The counting of the samples are done in the 'BaseCase' function so
           // no book-keeping is required here.
-          BaseCase(queryIndex, referenceNode.Descendant(distinctSamples[i]));
+          BaseCase(queryIndex, referenceNode.Descendant(sampleBuffer[i]));
 
         // Node approximated, so we can prune it.
         return DBL_MAX;
@@ -323,13 +357,12 @@ Rescore(const size_t queryIndex,
         if (sampleAtLeaves)
         {
           // Approximate node by sampling enough points.
-          arma::uvec distinctSamples;
-          math::ObtainDistinctSamples(0, referenceNode.NumDescendants(),
-              samplesReqd, distinctSamples);
-          for (size_t i = 0; i < distinctSamples.n_elem; i++)
+          const size_t numSamples = DistinctSamples(
+              referenceNode.NumDescendants(), samplesReqd);
+          for (size_t i = 0; i < numSamples; i++)
             // The counting of the samples are done in the 'BaseCase' function
             // so no book-keeping is required here.
-            BaseCase(queryIndex, referenceNode.Descendant(distinctSamples[i]));
+            BaseCase(queryIndex, referenceNode.Descendant(sampleBuffer[i]));
 
           // (Leaf) node approximated, so we can prune it.
           return DBL_MAX;
@@ -507,17 +540,15 @@ inline double RASearchRules<SortPolicy, MetricType, TreeType>::Score(
         {
           // Then samplesReqd <= singleSampleLimit.  Hence, approximate node by
           // sampling enough number of points for every query in the query node.
-          arma::uvec distinctSamples;
           for (size_t i = 0; i < queryNode.NumDescendants(); ++i)
           {
             const size_t queryIndex = queryNode.Descendant(i);
-            math::ObtainDistinctSamples(0, referenceNode.NumDescendants(),
-                samplesReqd, distinctSamples);
-            for (size_t j = 0; j < distinctSamples.n_elem; j++)
+            const size_t numSamples = DistinctSamples(
+                referenceNode.NumDescendants(), samplesReqd);
+            for (size_t j = 0; j < numSamples; j++)
               // The counting of the samples are done in the 'BaseCase' function
               // so no book-keeping is required here.
-              BaseCase(queryIndex,
-                  referenceNode.Descendant(distinctSamples[j]));
+              BaseCase(queryIndex, referenceNode.Descendant(sampleBuffer[j]));
           }
 
           // Update the number of samples made for the queryNode and also update
@@ -537,17 +568,15 @@ inline double RASearchRules<SortPolicy, MetricType, TreeType>::Score(
           {
             // Approximate node by sampling enough number of points for every
             // query in the query node.
-            arma::uvec distinctSamples;
             for (size_t i = 0; i < queryNode.NumDescendants(); ++i)
             {
               const size_t queryIndex = queryNode.Descendant(i);
-              math::ObtainDistinctSamples(0, referenceNode.NumDescendants(),
-                  samplesReqd, distinctSamples);
-              for (size_t j = 0; j < distinctSamples.n_elem; j++)
+              const size_t numSamples = DistinctSamples(
+                  referenceNode.NumDescendants(), samplesReqd);
+              for (size_t j = 0; j < numSamples; j++)
                 // The counting of the samples are done in the 'BaseCase'
                 // function so no book-keeping is required here.
-                BaseCase(queryIndex,
-                    referenceNode.Descendant(distinctSamples[j]));
+                BaseCase(queryIndex, referenceNode.Descendant(sampleBuffer[j]));
             }
 
             // Update the number of samples made for the queryNode and also
@@ -712,16 +741,15 @@ Rescore(TreeType& queryNode,
       {
         // then samplesReqd <= singleSampleLimit.  Hence, approximate the node
         // by sampling enough points for every query in the query node.
-        arma::uvec distinctSamples;
         for (size_t i = 0; i < queryNode.NumDescendants(); ++i)
         {
           const size_t queryIndex = queryNode.Descendant(i);
-          math::ObtainDistinctSamples(0, referenceNode.NumDescendants(),
-              samplesReqd, distinctSamples);
-          for (size_t j = 0; j < distinctSamples.n_elem; j++)
+          const size_t numSamples = DistinctSamples(
+              referenceNode.NumDescendants(), samplesReqd);
+          for (size_t j = 0; j < numSamples; j++)
             // The counting of the samples are done in the 'BaseCase'
             // function so no book-keeping is required here.
-            BaseCase(queryIndex, referenceNode.Descendant(distinctSamples[j]));
+            BaseCase(queryIndex, referenceNode.Descendant(sampleBuffer[j]));
         }
 
         // Update the number of samples made for the query node and also update
@@ -741,17 +769,15 @@ Rescore(TreeType& queryNode,
         {
           // Approximate node by sampling enough points for every query in the
           // query node.
-          arma::uvec distinctSamples;
           for (size_t i = 0; i < queryNode.NumDescendants(); ++i)
           {
             const size_t queryIndex = queryNode.Descendant(i);
-            math::ObtainDistinctSamples(0, referenceNode.NumDescendants(),
-                samplesReqd, distinctSamples);
-            for (size_t j = 0; j < distinctSamples.n_elem; j++)
+            const size_t numSamples = DistinctSamples(
+                referenceNode.NumDescendants(), samplesReqd);
+            for (size_t j = 0; j < numSamples; j++)
               // The counting of the samples are done in BaseCase() so no
               // book-keeping is required here.
-              BaseCase(queryIndex,
-                  referenceNode.Descendant(distinctSamples[j]));
+              BaseCase(queryIndex, referenceNode.Descendant(sampleBuffer[j]));
           }
 
           // Update the number of samples made for the query node and also
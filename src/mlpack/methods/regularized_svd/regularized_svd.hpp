@@ -94,6 +94,19 @@ class RegularizedSVD
   double lambda;
 };
 
+/**
+ * Hogwild-style parallel training mode.  When RegularizedSVD is instantiated
+ * with ens::ParallelSGD<ens::ConstantStep>, Apply() shards the ratings evenly
+ * across the OpenMP threads and applies unsynchronized SGD updates to the
+ * factors.
+ */
+template<>
+void RegularizedSVD<ens::ParallelSGD<ens::ConstantStep>>::Apply(
+    const arma::mat& data,
+    const size_t rank,
+    arma::mat& u,
+    arma::mat& v);
+
 } // namespace svd
 } // namespace mlpack
 
@@ -57,6 +57,49 @@ void RegularizedSVD<OptimizerType>::Apply(const arma::mat& data,
   v = parameters.submat(0, 0, rank - 1, numUsers - 1);
 }
 
+/**
+ * Hogwild-style parallel training.  A rating only touches the factor columns
+ * of its own user and item, so unsynchronized updates from different threads
+ * collide rarely and the factorization converges as in the serial case.
+ */
+template<>
+inline void RegularizedSVD<ens::ParallelSGD<ens::ConstantStep>>::Apply(
+    const arma::mat& data,
+    const size_t rank,
+    arma::mat& u,
+    arma::mat& v)
+{
+  // Make the optimizer object using a RegularizedSVDFunction object.
+  RegularizedSVDFunction<arma::mat> rSVDFunc(data, rank, lambda);
+
+  #ifdef HAS_OPENMP
+  const size_t threads = omp_get_max_threads();
+  #else
+  const size_t threads = 1;
+  Log::Warn << "Using parallel SGD, but OpenMP support is not available!"
+      << std::endl;
+  #endif
+
+  // Shard the ratings evenly across the threads; each iteration is one epoch
+  // over the whole dataset.
+  ens::ConstantStep decayPolicy(alpha);
+  ens::ParallelSGD<ens::ConstantStep> optimizer(iterations,
+      std::ceil((double) rSVDFunc.NumFunctions() / threads), 1e-5, true,
+      decayPolicy);
+
+  // Get optimized parameters.
+  arma::mat parameters = rSVDFunc.GetInitialPoint();
+  optimizer.Optimize(rSVDFunc, parameters);
+
+  // Constants for extracting user and item matrices.
+  const size_t numUsers = max(data.row(0)) + 1;
+  const size_t numItems = max(data.row(1)) + 1;
+
+  // Extract user and item matrices from the optimized parameters.
+  u = parameters.submat(0, numUsers, rank - 1, numUsers + numItems - 1).t();
+  v = parameters.submat(0, 0, rank - 1, numUsers - 1);
+}
+
 } // namespace svd
 } // namespace mlpack
 
@@ -15,6 +15,7 @@
 
 #include <mlpack/prereqs.hpp>
 
+#include "replay/concurrent_random_replay.hpp"
 #include "replay/random_replay.hpp"
 #include "replay/prioritized_replay.hpp"
 #include "training_config.hpp"
@@ -101,6 +102,19 @@ class QLearning
    */
   double Episode();
 
+  /**
+   * Execute one episode in each of the given number of independent
+   * environment instances, stepping them together.  The action-value forward
+   * pass is batched over all still-running environments, and the instances
+   * are stepped in parallel when mlpack is built with OpenMP; the collected
+   * transitions share the replay buffer and drive the same learning updates
+   * as Episode().
+   *
+   * @param numEnvironments Number of environment instances to roll out.
+   * @return Average return of the episodes.
+   */
+  double ParallelEpisodes(const size_t numEnvironments);
+
   /**
    * @return Total steps from beginning.
    */
@@ -137,6 +151,11 @@ class QLearning
    */
   arma::Col<size_t> BestAction(const arma::mat& actionValues);
 
+  /**
+   * Perform one learning update from replayed experience.
+   */
+  void TrainStep();
+
   //! Locally-stored hyper-parameters.
   TrainingConfig& config;
 
@@ -148,7 +148,26 @@ double QLearning<
     return reward;
 
   // Start experience replay.
+  TrainStep();
 
+  return reward;
+}
+
+template <
+  typename EnvironmentType,
+  typename NetworkType,
+  typename UpdaterType,
+  typename BehaviorPolicyType,
+  typename ReplayType
+>
+void QLearning<
+  EnvironmentType,
+  NetworkType,
+  UpdaterType,
+  BehaviorPolicyType,
+  ReplayType
+>::TrainStep()
+{
   // Sample from previous experience.
   arma::mat sampledStates;
   arma::icolvec sampledActions;
@@ -216,8 +235,6 @@ double QLearning<
     learningNetwork.ResetNoise();
     targetNetwork.ResetNoise();
   }
-
-  return reward;
 }
 
 template <
@@ -269,6 +286,111 @@ double QLearning<
   return totalReturn;
 }
 
+template <
+  typename EnvironmentType,
+  typename NetworkType,
+  typename UpdaterType,
+  typename BehaviorPolicyType,
+  typename ReplayType
+>
+double QLearning<
+  EnvironmentType,
+  NetworkType,
+  UpdaterType,
+  BehaviorPolicyType,
+  ReplayType
+>::ParallelEpisodes(const size_t numEnvironments)
+{
+  // Create independent environment instances and get their initial states.
+  std::vector<EnvironmentType> environments(numEnvironments, environment);
+  std::vector<StateType> states(numEnvironments);
+  std::vector<ActionType> actions(numEnvironments);
+  std::vector<StateType> nextStates(numEnvironments);
+  std::vector<double> rewards(numEnvironments, 0.0);
+  std::vector<size_t> steps(numEnvironments, 0);
+  std::vector<bool> terminated(numEnvironments, false);
+  for (size_t i = 0; i < numEnvironments; ++i)
+    states[i] = environments[i].InitialSample();
+
+  double totalReturn = 0.0;
+  size_t activeCount = numEnvironments;
+
+  while (activeCount > 0)
+  {
+    // Collect the environments that are still running and batch their
+    // encoded states into a single forward pass.
+    std::vector<size_t> active;
+    active.reserve(activeCount);
+    for (size_t i = 0; i < numEnvironments; ++i)
+    {
+      if (!terminated[i])
+        active.push_back(i);
+    }
+
+    arma::mat stateBatch(states[active.front()].Encode().n_elem,
+        active.size());
+    for (size_t j = 0; j < active.size(); ++j)
+      stateBatch.col(j) = states[active[j]].Encode();
+
+    arma::mat actionValues;
+    learningNetwork.Predict(stateBatch, actionValues);
+
+    // Select an action for each environment according to the behavior policy.
+    for (size_t j = 0; j < active.size(); ++j)
+    {
+      actions[active[j]] = policy.Sample(actionValues.col(j), deterministic,
+          config.NoisyQLearning());
+    }
+
+    // Step the environments; each instance is independent, so this part can
+    // run in parallel.
+    #pragma omp parallel for
+    for (omp_size_t j = 0; j < (omp_size_t) active.size(); ++j)
+    {
+      const size_t i = active[j];
+      rewards[i] = environments[i].Sample(states[i], actions[i],
+          nextStates[i]);
+    }
+
+    // Store the collected transitions and learn from them; the replay buffer
+    // and the network are shared, so this part stays serial.
+    for (size_t j = 0; j < active.size(); ++j)
+    {
+      const size_t i = active[j];
+      replayMethod.Store(states[i], actions[i], rewards[i], nextStates[i],
+          environments[i].IsTerminal(nextStates[i]));
+
+      totalReturn += rewards[i];
+      states[i] = nextStates[i];
+      ++steps[i];
+
+      if (environments[i].IsTerminal(states[i]) ||
+          (config.StepLimit() && steps[i] >= config.StepLimit()))
+      {
+        terminated[i] = true;
+        --activeCount;
+      }
+
+      if (deterministic)
+        continue;
+
+      if (totalSteps >= config.ExplorationSteps())
+        TrainStep();
+
+      totalSteps++;
+
+      // Update target network.
+      if (totalSteps % config.TargetNetworkSyncInterval() == 0)
+        targetNetwork = learningNetwork;
+
+      if (totalSteps > config.ExplorationSteps())
+        policy.Anneal();
+    }
+  }
+
+  return totalReturn / numEnvironments;
+}
+
 } // namespace rl
 } // namespace mlpack
 
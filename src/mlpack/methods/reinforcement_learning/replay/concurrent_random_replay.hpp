@@ -0,0 +1,257 @@
+/**
+ * @file methods/reinforcement_learning/replay/concurrent_random_replay.hpp
+ * @author Marcus Edel
+ *
+ * This file is an implementation of sharded random experience replay for
+ * concurrent actors.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_RL_REPLAY_CONCURRENT_RANDOM_REPLAY_HPP
+#define MLPACK_METHODS_RL_REPLAY_CONCURRENT_RANDOM_REPLAY_HPP
+
+#include <mlpack/prereqs.hpp>
+
+#include <atomic>
+
+#ifdef HAS_OPENMP
+  #include <omp.h>
+#endif
+
+namespace mlpack {
+namespace rl {
+
+/**
+ * Implementation of sharded random experience replay for concurrent actors.
+ *
+ * The buffer is split into independent shards, each a fixed-size ring with
+ * its own write position.  An actor thread always writes into the shard
+ * assigned to it, so inserts from different actors never touch the same
+ * memory and need no locking; each shard publishes its fill level through an
+ * atomic counter.  Sampling is wait-free: it reads the published fill levels
+ * and gathers random transitions across all shards without blocking writers.
+ *
+ * Because writers are never blocked, a sampled transition can in rare cases
+ * be overwritten concurrently while it is read, yielding a mixed (but
+ * well-formed) transition.  For experience replay this noise is harmless -
+ * the same tradeoff the Hogwild-style updates in the async learning code
+ * already make - and it is the price of contention-free inserts.
+ *
+ * The interface matches RandomReplay, so this class can be passed to
+ * QLearning as the ReplayType.
+ *
+ * @tparam EnvironmentType Desired task.
+ */
+template <typename EnvironmentType>
+class ConcurrentRandomReplay
+{
+ public:
+  //! Convenient typedef for action.
+  using ActionType = typename EnvironmentType::Action;
+
+  //! Convenient typedef for state.
+  using StateType = typename EnvironmentType::State;
+
+  ConcurrentRandomReplay():
+      batchSize(0),
+      shardCapacity(0),
+      size(0)
+  { /* Nothing to do here. */ }
+
+  /**
+   * Construct an instance of sharded random experience replay class.
+   *
+   * @param batchSize Number of examples returned at each sample.
+   * @param capacity Total memory size in terms of number of examples.
+   * @param numShards Number of write shards; use (at least) one per actor
+   *     thread.
+   * @param dimension The dimension of an encoded state.
+   */
+  ConcurrentRandomReplay(const size_t batchSize,
+                         const size_t capacity,
+                         const size_t numShards = 1,
+                         const size_t dimension = StateType::dimension) :
+      batchSize(batchSize),
+      shardCapacity(std::max((size_t) 1,
+          capacity / std::max((size_t) 1, numShards))),
+      shards(std::max((size_t) 1, numShards)),
+      size(0)
+  {
+    for (size_t i = 0; i < shards.size(); ++i)
+    {
+      shards[i].states.set_size(dimension, shardCapacity);
+      shards[i].actions.set_size(shardCapacity);
+      shards[i].rewards.set_size(shardCapacity);
+      shards[i].nextStates.set_size(dimension, shardCapacity);
+      shards[i].isTerminal.set_size(shardCapacity);
+    }
+  }
+
+  /**
+   * Store the given experience into the shard of the calling thread.
+   *
+   * @param state Given state.
+   * @param action Given action.
+   * @param reward Given reward.
+   * @param nextState Given next state.
+   * @param isEnd Whether next state is terminal state.
+   */
+  void Store(const StateType& state,
+             ActionType action,
+             double reward,
+             const StateType& nextState,
+             bool isEnd)
+  {
+    #ifdef HAS_OPENMP
+    Shard& shard = shards[omp_get_thread_num() % shards.size()];
+    #else
+    Shard& shard = shards[0];
+    #endif
+
+    const size_t position = shard.position;
+    shard.states.col(position) = state.Encode();
+    shard.actions(position) = action;
+    shard.rewards(position) = reward;
+    shard.nextStates.col(position) = nextState.Encode();
+    shard.isTerminal(position) = isEnd;
+    shard.position = (position + 1) % shardCapacity;
+
+    // Publish the transition; the release order makes the writes above
+    // visible to any sampler that observes the new fill level.
+    const size_t fill = shard.fill.load(std::memory_order_relaxed);
+    if (fill < shardCapacity)
+    {
+      shard.fill.store(fill + 1, std::memory_order_release);
+      size.fetch_add(1, std::memory_order_relaxed);
+    }
+  }
+
+  /**
+   * Sample some experiences across all shards.
+   *
+   * @param sampledStates Sampled encoded states.
+   * @param sampledActions Sampled actions.
+   * @param sampledRewards Sampled rewards.
+   * @param sampledNextStates Sampled encoded next states.
+   * @param isTerminal Indicate whether corresponding next state is terminal
+   *        state.
+   */
+  void Sample(arma::mat& sampledStates,
+              arma::icolvec& sampledActions,
+              arma::colvec& sampledRewards,
+              arma::mat& sampledNextStates,
+              arma::icolvec& isTerminal)
+  {
+    // Snapshot the published fill level of each shard.
+    arma::uvec fills(shards.size());
+    size_t total = 0;
+    for (size_t i = 0; i < shards.size(); ++i)
+    {
+      fills(i) = shards[i].fill.load(std::memory_order_acquire);
+      total += fills(i);
+    }
+
+    sampledStates.set_size(shards[0].states.n_rows, batchSize);
+    sampledActions.set_size(batchSize);
+    sampledRewards.set_size(batchSize);
+    sampledNextStates.set_size(shards[0].nextStates.n_rows, batchSize);
+    isTerminal.set_size(batchSize);
+
+    arma::uvec sampledIndices = arma::randi<arma::uvec>(
+        batchSize, arma::distr_param(0, total - 1));
+
+    for (size_t k = 0; k < batchSize; ++k)
+    {
+      // Map the global index to a shard and a slot within it.
+      size_t index = sampledIndices(k);
+      size_t shardIndex = 0;
+      while (index >= fills(shardIndex))
+      {
+        index -= fills(shardIndex);
+        ++shardIndex;
+      }
+
+      const Shard& shard = shards[shardIndex];
+      sampledStates.col(k) = shard.states.col(index);
+      sampledActions(k) = shard.actions(index);
+      sampledRewards(k) = shard.rewards(index);
+      sampledNextStates.col(k) = shard.nextStates.col(index);
+      isTerminal(k) = shard.isTerminal(index);
+    }
+  }
+
+  /**
+   * Get the number of transitions in the memory.
+   *
+   * @return Actual used memory size
+   */
+  size_t Size()
+  {
+    return size.load(std::memory_order_relaxed);
+  }
+
+  /**
+   * Update the priorities of transitions and Update the gradients.
+   *
+   * @param * (target) The learned value
+   * @param * (sampledActions) Agent's sampled action
+   * @param * (nextActionValues) Agent's next action
+   * @param * (gradients) The model's gradients
+   */
+  void Update(arma::mat /* target */,
+              arma::icolvec /* sampledActions */,
+              arma::mat /* nextActionValues */,
+              arma::mat& /* gradients */)
+  {
+    /* Do nothing for random replay. */
+  }
+
+ private:
+  //! A per-actor write ring with its own published fill level.
+  struct Shard
+  {
+    Shard() : position(0), fill(0) { /* Nothing to do here. */ }
+
+    //! Indicate the position to store new transition; written only by the
+    //! owning actor thread.
+    size_t position;
+
+    //! Number of valid transitions in this shard.
+    std::atomic<size_t> fill;
+
+    //! Locally-stored encoded previous states.
+    arma::mat states;
+
+    //! Locally-stored previous actions.
+    arma::icolvec actions;
+
+    //! Locally-stored previous rewards.
+    arma::colvec rewards;
+
+    //! Locally-stored encoded previous next states.
+    arma::mat nextStates;
+
+    //! Locally-stored termination information of previous experience.
+    arma::icolvec isTerminal;
+  };
+
+  //! Locally-stored number of examples of each sample.
+  size_t batchSize;
+
+  //! Memory limit of a single shard.
+  size_t shardCapacity;
+
+  //! The per-actor write rings.
+  std::vector<Shard> shards;
+
+  //! Total number of transitions across all shards.
+  std::atomic<size_t> size;
+};
+
+} // namespace rl
+} // namespace mlpack
+
+#endif
@@ -24,7 +24,8 @@ SoftmaxRegressionFunction::SoftmaxRegressionFunction(
     data(math::MakeAlias(const_cast<arma::mat&>(data), false)),
     numClasses(numClasses),
     lambda(lambda),
-    fitIntercept(fitIntercept)
+    fitIntercept(fitIntercept),
+    evaluationChunkSize(0)
 {
   // Initialize the parameters to suitable values.
   initialPoint = InitializeWeights();
@@ -153,8 +154,9 @@ void SoftmaxRegressionFunction::GetProbabilitiesMatrix(
     const size_t start,
     const size_t batchSize) const
 {
-  arma::mat hypothesis;
-
+  // The hypothesis is computed directly in the output matrix, so that when
+  // the caller passes the same matrix across evaluations with the same batch
+  // size, no reallocation happens at all.
   if (fitIntercept)
   {
     // In order to add the intercept term, we should compute following matrix:
@@ -163,19 +165,17 @@ void SoftmaxRegressionFunction::GetProbabilitiesMatrix(
     //
     // Since the cost of join may be high due to the copy of original data,
     // split the hypothesis computation to two components.
-    hypothesis = arma::exp(
-        arma::repmat(parameters.col(0), 1, batchSize) +
-        parameters.cols(1, parameters.n_cols - 1) *
-        data.cols(start, start + batchSize - 1));
+    probabilities = parameters.cols(1, parameters.n_cols - 1) *
+        data.cols(start, start + batchSize - 1);
+    probabilities.each_col() += parameters.col(0);
   }
   else
   {
-    hypothesis = arma::exp(parameters *
-        data.cols(start, start + batchSize - 1));
+    probabilities = parameters * data.cols(start, start + batchSize - 1);
   }
 
-  probabilities = hypothesis / arma::repmat(arma::sum(hypothesis, 0),
-                                            numClasses, 1);
+  probabilities = arma::exp(probabilities);
+  probabilities.each_row() /= arma::sum(probabilities, 0);
 }
 
 /**
@@ -199,21 +199,31 @@ double SoftmaxRegressionFunction::Evaluate(const arma::mat& parameters) const
   // The sum is calculated over all the classes.
   // x_i is the input vector for a particular training example.
   // theta_j is the parameter vector associated with a particular class.
-  arma::mat probabilities;
-  GetProbabilitiesMatrix(parameters, probabilities, 0, data.n_cols);
+  //
+  // The points are streamed through the persistent probability workspace in
+  // chunks, so the memory footprint is bounded by numClasses x chunk size
+  // (or numClasses x numExamples when chunking is disabled) and does not grow
+  // with repeated evaluations.
+  const size_t chunkSize = (evaluationChunkSize == 0) ? data.n_cols :
+      evaluationChunkSize;
+
+  double logLikelihood = 0.0;
+  for (size_t start = 0; start < data.n_cols; start += chunkSize)
+  {
+    const size_t size = std::min(chunkSize, data.n_cols - start);
+    GetProbabilitiesMatrix(parameters, probabilitiesWorkspace, start, size);
 
-  // Calculate the log likelihood and regularization terms.
-  double logLikelihood, weightDecay, cost;
+    logLikelihood += arma::accu(groundTruth.cols(start, start + size - 1) %
+        arma::log(probabilitiesWorkspace));
+  }
+  logLikelihood /= data.n_cols;
 
-  logLikelihood = arma::accu(groundTruth % arma::log(probabilities)) /
-                  data.n_cols;
-  weightDecay = 0.5 * lambda * arma::accu(parameters % parameters);
+  const double weightDecay = 0.5 * lambda *
+      arma::accu(parameters % parameters);
 
   // The cost is the sum of the negative log likelihood and the regularization
   // terms.
-  cost = -logLikelihood + weightDecay;
-
-  return cost;
+  return -logLikelihood + weightDecay;
 }
 
 /**
@@ -223,15 +233,14 @@ double SoftmaxRegressionFunction::Evaluate(const arma::mat& parameters,
                                            const size_t start,
                                            const size_t batchSize) const
 {
-  arma::mat probabilities;
-  GetProbabilitiesMatrix(parameters, probabilities, start, batchSize);
+  GetProbabilitiesMatrix(parameters, probabilitiesWorkspace, start, batchSize);
 
   // Calculate the log likelihood and regularization terms.
   double logLikelihood, weightDecay;
 
   logLikelihood = arma::accu(groundTruth.cols(start, start + batchSize - 1) %
-      arma::log(probabilities)) / batchSize;
-  weightDecay = 0.5 * lambda * arma::accu(parameters * parameters);
+      arma::log(probabilitiesWorkspace)) / batchSize;
+  weightDecay = 0.5 * lambda * arma::accu(parameters % parameters);
 
   return -logLikelihood + weightDecay;
 }
@@ -248,27 +257,37 @@ void SoftmaxRegressionFunction::Gradient(const arma::mat& parameters,
   // The sum is calculated over all the classes.
   // x_i is the input vector for a particular training example.
   // theta_j is the parameter vector associated with a particular class.
-  arma::mat probabilities;
-  GetProbabilitiesMatrix(parameters, probabilities, 0, data.n_cols);
-
-  // Calculate the parameter gradients.
-  gradient.set_size(parameters.n_rows, parameters.n_cols);
-  if (fitIntercept)
+  //
+  // As in Evaluate(), the points are streamed through the persistent
+  // probability workspace in chunks; the gradient contribution of each chunk
+  // is accumulated on top of the regularization term.
+  const size_t chunkSize = (evaluationChunkSize == 0) ? data.n_cols :
+      evaluationChunkSize;
+
+  gradient = lambda * parameters;
+  for (size_t start = 0; start < data.n_cols; start += chunkSize)
   {
-    // Treating the intercept term parameters.col(0) seperately to avoid
-    // the cost of building matrix [1; data].
-    arma::mat inner = probabilities - groundTruth;
-    gradient.col(0) =
-      inner * arma::ones<arma::mat>(data.n_cols, 1) / data.n_cols +
-      lambda * parameters.col(0);
-    gradient.cols(1, parameters.n_cols - 1) =
-      inner * data.t() / data.n_cols +
-      lambda * parameters.cols(1, parameters.n_cols - 1);
-  }
-  else
-  {
-    gradient = (probabilities - groundTruth) * data.t() / data.n_cols +
-               lambda * parameters;
+    const size_t size = std::min(chunkSize, data.n_cols - start);
+    GetProbabilitiesMatrix(parameters, probabilitiesWorkspace, start, size);
+
+    // Turn the workspace into the inner term (probabilities - groundTruth)
+    // without allocating another classes x points matrix.
+    probabilitiesWorkspace -= groundTruth.cols(start, start + size - 1);
+
+    if (fitIntercept)
+    {
+      // Treating the intercept term parameters.col(0) seperately to avoid
+      // the cost of building matrix [1; data].
+      gradient.col(0) +=
+          arma::sum(probabilitiesWorkspace, 1) / data.n_cols;
+      gradient.cols(1, parameters.n_cols - 1) += probabilitiesWorkspace *
+          data.cols(start, start + size - 1).t() / data.n_cols;
+    }
+    else
+    {
+      gradient += probabilitiesWorkspace *
+          data.cols(start, start + size - 1).t() / data.n_cols;
+    }
   }
 }
 
@@ -277,26 +296,27 @@ void SoftmaxRegressionFunction::Gradient(const arma::mat& parameters,
                                          arma::mat& gradient,
                                          const size_t batchSize) const
 {
-  arma::mat probabilities;
-  GetProbabilitiesMatrix(parameters, probabilities, start, batchSize);
+  GetProbabilitiesMatrix(parameters, probabilitiesWorkspace, start, batchSize);
+
+  // Turn the workspace into the inner term (probabilities - groundTruth).
+  probabilitiesWorkspace -= groundTruth.cols(start, start + batchSize - 1);
 
   // Calculate the parameter gradients.
   gradient.set_size(parameters.n_rows, parameters.n_cols);
   if (fitIntercept)
   {
-    arma::mat inner = probabilities - groundTruth.cols(start, start +
-        batchSize - 1);
     gradient.col(0) =
-        inner * arma::ones<arma::mat>(batchSize, 1) / batchSize +
+        arma::sum(probabilitiesWorkspace, 1) / batchSize +
         lambda * parameters.col(0);
     gradient.cols(1, parameters.n_cols - 1) =
-        inner * data.cols(start, start + batchSize - 1).t() / batchSize +
+        probabilitiesWorkspace *
+        data.cols(start, start + batchSize - 1).t() / batchSize +
         lambda * parameters.cols(1, parameters.n_cols - 1);
   }
   else
   {
-    gradient = (probabilities - groundTruth.cols(start, start + batchSize - 1))
-        * data.cols(start, start + batchSize - 1).t() / batchSize
+    gradient = probabilitiesWorkspace *
+        data.cols(start, start + batchSize - 1).t() / batchSize
         + lambda * parameters;
   }
 }
@@ -307,11 +327,11 @@ void SoftmaxRegressionFunction::PartialGradient(const arma::mat& parameters,
 {
   gradient.zeros(arma::size(parameters));
 
-  arma::mat probabilities;
-  GetProbabilitiesMatrix(parameters, probabilities, 0, data.n_cols);
+  GetProbabilitiesMatrix(parameters, probabilitiesWorkspace, 0, data.n_cols);
 
   // Calculate the required part of the gradient.
-  arma::mat inner = probabilities - groundTruth;
+  probabilitiesWorkspace -= groundTruth;
+  arma::mat& inner = probabilitiesWorkspace;
   if (fitIntercept)
   {
     if (j == 0)
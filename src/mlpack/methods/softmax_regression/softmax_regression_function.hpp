@@ -187,6 +187,14 @@ class SoftmaxRegressionFunction
   //! Gets the intercept flag.
   bool FitIntercept() const { return fitIntercept; }
 
+  //! Gets the number of points streamed through the probability workspace at
+  //! once during full-dataset evaluations (0 means all points at once).
+  size_t EvaluationChunkSize() const { return evaluationChunkSize; }
+  //! Modifies the evaluation chunk size.  Setting this to a nonzero value
+  //! caps the size of the probabilities matrix at numClasses x chunk size,
+  //! which keeps memory use bounded when the number of classes is very large.
+  size_t& EvaluationChunkSize() { return evaluationChunkSize; }
+
  private:
   //! Training data matrix.  This is an alias until the data is shuffled.
   arma::mat data;
@@ -200,6 +208,14 @@ class SoftmaxRegressionFunction
   double lambda;
   //! Intercept term flag.
   bool fitIntercept;
+  //! Number of points to stream through the probability workspace at once
+  //! during full-dataset evaluations; 0 means all points at once.
+  size_t evaluationChunkSize;
+  //! Workspace for the probabilities matrix.  Keeping it as a member lets
+  //! successive optimizer iterations reuse the same allocation.  Note that
+  //! this makes concurrent Evaluate()/Gradient() calls on the same object
+  //! unsafe.
+  mutable arma::mat probabilitiesWorkspace;
 };
 
 } // namespace regression
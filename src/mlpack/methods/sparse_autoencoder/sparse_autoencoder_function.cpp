@@ -11,6 +11,12 @@
  */
 #include "sparse_autoencoder_function.hpp"
 
+#include <algorithm>
+
+#ifdef HAS_OPENMP
+  #include <omp.h>
+#endif
+
 using namespace mlpack;
 using namespace mlpack::nn;
 using namespace std;
@@ -30,6 +36,11 @@ SparseAutoencoderFunction::SparseAutoencoderFunction(const arma::mat& data,
 {
   // Initialize the parameters to suitable values.
   initialPoint = InitializeWeights();
+
+  // The initial visitation order of the points is the identity; Shuffle()
+  // reshuffles it for the mini-batch overloads.
+  if (data.n_cols > 0)
+    ordering = arma::linspace<arma::uvec>(0, data.n_cols - 1, data.n_cols);
 }
 
 /** Initializes the parameter weights if the initial point is not passed to the
@@ -208,3 +219,277 @@ void SparseAutoencoderFunction::Gradient(const arma::mat& parameters,
   gradient.submat(0, l2, l1 - 1, l2) = arma::sum(delHid, 1) / data.n_cols;
   gradient.submat(l3, 0, l3, l2 - 1) = (arma::sum(delOut, 1) / data.n_cols).t();
 }
+
+/** Evaluates the objective function and its gradient in one fused,
+  * thread-parallel pass over the data.
+  */
+double SparseAutoencoderFunction::EvaluateWithGradient(
+    const arma::mat& parameters,
+    arma::mat& gradient) const
+{
+  // The objective and the gradient are computed in one pass, sharded by
+  // columns with one contiguous shard per thread.  The KL divergence term
+  // couples every point through the average hidden activations, so the pass
+  // has two phases: every shard first feeds its columns forward and the
+  // hidden activation sums are reduced across shards; only then can each
+  // shard backpropagate its columns.  The activations stay in the per-thread
+  // workspaces between the phases and across optimizer iterations.
+
+  // Compute the limits for the parameters w1, w2, b1 and b2.
+  const size_t l1 = hiddenSize;
+  const size_t l2 = visibleSize;
+  const size_t l3 = 2 * hiddenSize;
+
+  const size_t points = data.n_cols;
+
+#ifdef HAS_OPENMP
+  const size_t numShards = std::min((size_t) omp_get_max_threads(), points);
+#else
+  const size_t numShards = 1;
+#endif
+
+  // The workspaces persist across calls; after the first iteration this is a
+  // no-op and the matrices inside are simply overwritten in place.
+  workspaces.resize(numShards);
+
+  arma::vec hiddenSums(hiddenSize, arma::fill::zeros);
+  double sumOfSquares = 0.0;
+
+  // Phase one: feedforward pass of every shard.
+  #pragma omp parallel for schedule(static)
+  for (omp_size_t shard = 0; shard < (omp_size_t) numShards; ++shard)
+  {
+    const size_t shardBegin = (shard * points) / numShards;
+    const size_t shardEnd = ((shard + 1) * points) / numShards;
+    const size_t shardSize = shardEnd - shardBegin;
+    Workspace& w = workspaces[shard];
+
+    // Compute activations of the hidden and output layers for the shard.
+    Sigmoid(parameters.submat(0, 0, l1 - 1, l2 - 1) *
+        data.cols(shardBegin, shardEnd - 1) +
+        arma::repmat(parameters.submat(0, l2, l1 - 1, l2), 1, shardSize),
+        w.hiddenLayer);
+
+    Sigmoid(parameters.submat(l1, 0, l3 - 1, l2 - 1).t() * w.hiddenLayer +
+        arma::repmat(parameters.submat(l3, 0, l3, l2 - 1).t(), 1, shardSize),
+        w.outputLayer);
+
+    // Store the reconstruction difference of the shard in the delta
+    // workspace; the backward phase turns it into the actual delta values.
+    w.delOut = w.outputLayer - data.cols(shardBegin, shardEnd - 1);
+
+    const arma::vec shardHiddenSums = arma::sum(w.hiddenLayer, 1);
+    const double shardSumOfSquares = arma::accu(w.delOut % w.delOut);
+
+    #pragma omp critical
+    {
+      hiddenSums += shardHiddenSums;
+      sumOfSquares += shardSumOfSquares;
+    }
+  }
+
+  // Average activations of the hidden layer.
+  const arma::vec rhoCap = hiddenSums / points;
+
+  // Adjustment to the hidden layer deltas for the KL divergence term; see
+  // Gradient() for details on the formulas below.
+  const arma::vec klDivGrad = beta * (-(rho / rhoCap) +
+      (1 - rho) / (1 - rhoCap));
+
+  gradient.zeros(2 * hiddenSize + 1, visibleSize + 1);
+
+  // Phase two: backpropagation of every shard, accumulating the partial
+  // gradients.
+  #pragma omp parallel for schedule(static)
+  for (omp_size_t shard = 0; shard < (omp_size_t) numShards; ++shard)
+  {
+    const size_t shardBegin = (shard * points) / numShards;
+    const size_t shardEnd = ((shard + 1) * points) / numShards;
+    const size_t shardSize = shardEnd - shardBegin;
+    Workspace& w = workspaces[shard];
+
+    // w.delOut still holds the reconstruction difference of the shard.
+    w.delOut = w.delOut % w.outputLayer % (1 - w.outputLayer);
+    w.delHid = (parameters.submat(l1, 0, l3 - 1, l2 - 1) * w.delOut +
+        arma::repmat(klDivGrad, 1, shardSize)) % w.hiddenLayer %
+        (1 - w.hiddenLayer);
+
+    const arma::mat w1Grad = w.delHid *
+        data.cols(shardBegin, shardEnd - 1).t();
+    const arma::mat w2Grad = w.delOut * w.hiddenLayer.t();
+    const arma::vec b1Grad = arma::sum(w.delHid, 1);
+    const arma::vec b2Grad = arma::sum(w.delOut, 1);
+
+    #pragma omp critical
+    {
+      gradient.submat(0, 0, l1 - 1, l2 - 1) += w1Grad;
+      gradient.submat(l1, 0, l3 - 1, l2 - 1) += w2Grad.t();
+      gradient.submat(0, l2, l1 - 1, l2) += b1Grad;
+      gradient.submat(l3, 0, l3, l2 - 1) += b2Grad.t();
+    }
+  }
+
+  // Average the accumulated gradients and add the regularization terms.
+  gradient /= points;
+  gradient.submat(0, 0, l3 - 1, l2 - 1) += lambda *
+      parameters.submat(0, 0, l3 - 1, l2 - 1);
+
+  // Assemble the objective the same way Evaluate() does.
+  const double wL2SquaredNorm =
+      arma::accu(parameters.submat(0, 0, l3 - 1, l2 - 1) %
+      parameters.submat(0, 0, l3 - 1, l2 - 1));
+
+  const double sumOfSquaresError = 0.5 * sumOfSquares / points;
+  const double weightDecay = 0.5 * lambda * wL2SquaredNorm;
+  const double klDivergence = beta * arma::accu(rho *
+      arma::log(rho / rhoCap) + (1 - rho) * arma::log((1 - rho) /
+      (1 - rhoCap)));
+
+  return sumOfSquaresError + weightDecay + klDivergence;
+}
+
+/** Evaluates the objective function on a mini-batch of points.
+  */
+double SparseAutoencoderFunction::Evaluate(const arma::mat& parameters,
+                                           const size_t begin,
+                                           const size_t batchSize) const
+{
+  // Compute the limits for the parameters w1, w2, b1 and b2.
+  const size_t l1 = hiddenSize;
+  const size_t l2 = visibleSize;
+  const size_t l3 = 2 * hiddenSize;
+
+  // Gather the batch columns through the visitation order.
+  const arma::mat batch = data.cols(ordering.subvec(begin,
+      begin + batchSize - 1));
+
+  arma::mat hiddenLayer, outputLayer;
+
+  // Compute activations of the hidden and output layers for the batch.
+  Sigmoid(parameters.submat(0, 0, l1 - 1, l2 - 1) * batch +
+      arma::repmat(parameters.submat(0, l2, l1 - 1, l2), 1, batchSize),
+      hiddenLayer);
+
+  Sigmoid(parameters.submat(l1, 0, l3 - 1, l2 - 1).t() * hiddenLayer +
+      arma::repmat(parameters.submat(l3, 0, l3, l2 - 1).t(), 1, batchSize),
+      outputLayer);
+
+  // Average activations of the hidden layer, estimated from the batch.
+  const arma::vec rhoCap = arma::sum(hiddenLayer, 1) / batchSize;
+  // Difference between the reconstructed batch and the original batch.
+  const arma::mat diff = outputLayer - batch;
+
+  // The fraction of the dataset the batch represents; the regularization and
+  // sparsity terms are scaled by it so that the batch objectives of an epoch
+  // sum to (approximately) the full objective.
+  const double batchFraction = (double) batchSize / data.n_cols;
+
+  const double wL2SquaredNorm =
+      arma::accu(parameters.submat(0, 0, l3 - 1, l2 - 1) %
+      parameters.submat(0, 0, l3 - 1, l2 - 1));
+
+  const double sumOfSquaresError =
+      0.5 * arma::accu(diff % diff) / data.n_cols;
+  const double weightDecay = batchFraction * 0.5 * lambda * wL2SquaredNorm;
+  const double klDivergence = batchFraction * beta * arma::accu(rho *
+      arma::log(rho / rhoCap) + (1 - rho) * arma::log((1 - rho) /
+      (1 - rhoCap)));
+
+  return sumOfSquaresError + weightDecay + klDivergence;
+}
+
+/** Evaluates the gradient of the objective function on a mini-batch of
+  * points.
+  */
+void SparseAutoencoderFunction::Gradient(const arma::mat& parameters,
+                                         const size_t begin,
+                                         arma::mat& gradient,
+                                         const size_t batchSize) const
+{
+  // The feedforward pass dominates the cost either way, so simply reuse the
+  // fused implementation.
+  EvaluateWithGradient(parameters, begin, gradient, batchSize);
+}
+
+/** Evaluates the objective function and its gradient on a mini-batch of
+  * points, sharing the feedforward pass between the two.
+  */
+double SparseAutoencoderFunction::EvaluateWithGradient(
+    const arma::mat& parameters,
+    const size_t begin,
+    arma::mat& gradient,
+    const size_t batchSize) const
+{
+  // Compute the limits for the parameters w1, w2, b1 and b2.
+  const size_t l1 = hiddenSize;
+  const size_t l2 = visibleSize;
+  const size_t l3 = 2 * hiddenSize;
+
+  // Gather the batch columns through the visitation order.
+  const arma::mat batch = data.cols(ordering.subvec(begin,
+      begin + batchSize - 1));
+
+  arma::mat hiddenLayer, outputLayer;
+
+  // Compute activations of the hidden and output layers for the batch.
+  Sigmoid(parameters.submat(0, 0, l1 - 1, l2 - 1) * batch +
+      arma::repmat(parameters.submat(0, l2, l1 - 1, l2), 1, batchSize),
+      hiddenLayer);
+
+  Sigmoid(parameters.submat(l1, 0, l3 - 1, l2 - 1).t() * hiddenLayer +
+      arma::repmat(parameters.submat(l3, 0, l3, l2 - 1).t(), 1, batchSize),
+      outputLayer);
+
+  // Average activations of the hidden layer, estimated from the batch.
+  const arma::vec rhoCap = arma::sum(hiddenLayer, 1) / batchSize;
+  // Difference between the reconstructed batch and the original batch.
+  const arma::mat diff = outputLayer - batch;
+
+  // Delta values of the output and hidden layers; see Gradient() for details
+  // on the formulas.  Since rhoCap averages over the batch and the sparsity
+  // term is scaled by the batch fraction, the per-column KL adjustment works
+  // out to the same klDivGrad term divided by the total number of points, so
+  // the division below by data.n_cols covers it.
+  const arma::vec klDivGrad = beta * (-(rho / rhoCap) +
+      (1 - rho) / (1 - rhoCap));
+  const arma::mat delOut = diff % outputLayer % (1 - outputLayer);
+  const arma::mat delHid = (parameters.submat(l1, 0, l3 - 1, l2 - 1) * delOut
+      + arma::repmat(klDivGrad, 1, batchSize)) % hiddenLayer %
+      (1 - hiddenLayer);
+
+  // The fraction of the dataset the batch represents.
+  const double batchFraction = (double) batchSize / data.n_cols;
+
+  gradient.zeros(2 * hiddenSize + 1, visibleSize + 1);
+
+  gradient.submat(0, 0, l1 - 1, l2 - 1) = delHid * batch.t() / data.n_cols +
+      batchFraction * lambda * parameters.submat(0, 0, l1 - 1, l2 - 1);
+  gradient.submat(l1, 0, l3 - 1, l2 - 1) =
+      (delOut * hiddenLayer.t() / data.n_cols +
+      batchFraction * lambda *
+      parameters.submat(l1, 0, l3 - 1, l2 - 1).t()).t();
+  gradient.submat(0, l2, l1 - 1, l2) = arma::sum(delHid, 1) / data.n_cols;
+  gradient.submat(l3, 0, l3, l2 - 1) =
+      (arma::sum(delOut, 1) / data.n_cols).t();
+
+  // Assemble the batch objective the same way the mini-batch Evaluate() does.
+  const double wL2SquaredNorm =
+      arma::accu(parameters.submat(0, 0, l3 - 1, l2 - 1) %
+      parameters.submat(0, 0, l3 - 1, l2 - 1));
+
+  const double sumOfSquaresError =
+      0.5 * arma::accu(diff % diff) / data.n_cols;
+  const double weightDecay = batchFraction * 0.5 * lambda * wL2SquaredNorm;
+  const double klDivergence = batchFraction * beta * arma::accu(rho *
+      arma::log(rho / rhoCap) + (1 - rho) * arma::log((1 - rho) /
+      (1 - rhoCap)));
+
+  return sumOfSquaresError + weightDecay + klDivergence;
+}
+
+/** Reshuffles the visitation order of the data points.
+  */
+void SparseAutoencoderFunction::Shuffle()
+{
+  ordering = arma::shuffle(ordering);
+}
@@ -70,6 +70,82 @@ class SparseAutoencoderFunction
    */
   void Gradient(const arma::mat& parameters, arma::mat& gradient) const;
 
+  /**
+   * Evaluates the objective function and its gradient in one fused pass over
+   * the data.  The data is split into one contiguous shard of columns per
+   * thread; each shard performs its own feedforward pass into a persistent
+   * per-thread activation workspace, the average hidden activations are then
+   * reduced across shards, and finally each shard backpropagates its own
+   * columns and its partial gradients are accumulated.  The activation
+   * workspaces are reused across optimizer iterations, so no large matrices
+   * are reallocated after the first call.  The returned objective and
+   * gradient are identical to those of Evaluate() and Gradient().
+   *
+   * @param parameters Current values of the model parameters.
+   * @param gradient Matrix where gradient values will be stored.
+   */
+  double EvaluateWithGradient(const arma::mat& parameters,
+                              arma::mat& gradient) const;
+
+  /**
+   * Evaluates the objective function on a mini-batch of batchSize points
+   * starting at index begin of the current visitation order (see Shuffle()).
+   * The reconstruction error is computed over the batch only, and the
+   * regularization and sparsity terms are scaled by the fraction of the
+   * dataset the batch represents, so that the batch objectives of one epoch
+   * sum to (approximately) the full objective.  Note that the average hidden
+   * activations used by the KL divergence term are estimated from the batch,
+   * which is the usual mini-batch approximation of the sparsity penalty.
+   *
+   * @param parameters Current values of the model parameters.
+   * @param begin Index of the starting point in the visitation order.
+   * @param batchSize Number of points in the batch.
+   */
+  double Evaluate(const arma::mat& parameters,
+                  const size_t begin,
+                  const size_t batchSize) const;
+
+  /**
+   * Evaluates the gradient of the objective function on a mini-batch of
+   * batchSize points starting at index begin of the current visitation order.
+   * The same scaling and batch approximation of the sparsity term as in the
+   * mini-batch Evaluate() applies.
+   *
+   * @param parameters Current values of the model parameters.
+   * @param begin Index of the starting point in the visitation order.
+   * @param gradient Matrix where gradient values will be stored.
+   * @param batchSize Number of points in the batch.
+   */
+  void Gradient(const arma::mat& parameters,
+                const size_t begin,
+                arma::mat& gradient,
+                const size_t batchSize) const;
+
+  /**
+   * Evaluates the objective function and its gradient on a mini-batch of
+   * batchSize points starting at index begin of the current visitation order.
+   * The feedforward pass is shared between the objective and the gradient.
+   *
+   * @param parameters Current values of the model parameters.
+   * @param begin Index of the starting point in the visitation order.
+   * @param gradient Matrix where gradient values will be stored.
+   * @param batchSize Number of points in the batch.
+   */
+  double EvaluateWithGradient(const arma::mat& parameters,
+                              const size_t begin,
+                              arma::mat& gradient,
+                              const size_t batchSize) const;
+
+  /**
+   * Shuffle the visitation order of the data points.  The data matrix itself
+   * is held by reference and is not modified; instead an index permutation is
+   * reshuffled, and the mini-batch overloads gather their columns through it.
+   */
+  void Shuffle();
+
+  //! Return the number of separable functions (the number of data points).
+  size_t NumFunctions() const { return data.n_cols; }
+
   /**
    * Returns the elementwise sigmoid of the passed matrix, where the sigmoid
    * function of a real number 'x' is [1 / (1 + exp(-x))].
@@ -146,10 +222,31 @@ class SparseAutoencoderFunction
   }
 
  private:
+  /**
+   * Per-thread activation workspace for EvaluateWithGradient().  Holding the
+   * activation and delta matrices here keeps them allocated between optimizer
+   * iterations, so each fused pass only overwrites them in place.
+   */
+  struct Workspace
+  {
+    //! Activations of the hidden layer for this thread's shard.
+    arma::mat hiddenLayer;
+    //! Activations of the output layer for this thread's shard.
+    arma::mat outputLayer;
+    //! Delta values of the output layer for this thread's shard.
+    arma::mat delOut;
+    //! Delta values of the hidden layer for this thread's shard.
+    arma::mat delHid;
+  };
+
   //! The matrix of data points.
   const arma::mat& data;
   //! Initial parameter vector.
   arma::mat initialPoint;
+  //! Visitation order of the data points, used by the mini-batch overloads.
+  arma::uvec ordering;
+  //! Persistent per-thread activation workspaces.
+  mutable std::vector<Workspace> workspaces;
   //! Size of the visible layer.
   size_t visibleSize;
   //! Size of the hidden layer.
@@ -148,6 +148,23 @@ class SVDPlusPlus
   double lambda;
 };
 
+/**
+ * Hogwild-style parallel training mode.  When SVDPlusPlus is instantiated
+ * with ens::ParallelSGD<ens::ConstantStep>, Apply() shards the ratings evenly
+ * across the OpenMP threads and applies unsynchronized SGD updates to the
+ * factors, biases, and item implicit vectors.
+ */
+template<>
+void SVDPlusPlus<ens::ParallelSGD<ens::ConstantStep>>::Apply(
+    const arma::mat& data,
+    const arma::mat& implicitData,
+    const size_t rank,
+    arma::mat& u,
+    arma::mat& v,
+    arma::vec& p,
+    arma::vec& q,
+    arma::mat& y);
+
 } // namespace svd
 } // namespace mlpack
 
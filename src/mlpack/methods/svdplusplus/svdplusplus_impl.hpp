@@ -111,6 +111,63 @@ void SVDPlusPlus<OptimizerType>::CleanData(const arma::mat& implicitData,
   cleanedData = arma::sp_mat(locations, values, maxItemID, maxUserID);
 }
 
+/**
+ * Hogwild-style parallel training.  A rating only touches the factor columns
+ * and biases of its own user and item (plus the implicit vectors of the items
+ * the user interacted with), so unsynchronized updates from different threads
+ * collide rarely and the factorization converges as in the serial case.
+ */
+template<>
+inline void SVDPlusPlus<ens::ParallelSGD<ens::ConstantStep>>::Apply(
+    const arma::mat& data,
+    const arma::mat& implicitData,
+    const size_t rank,
+    arma::mat& u,
+    arma::mat& v,
+    arma::vec& p,
+    arma::vec& q,
+    arma::mat& y)
+{
+  // Converts implicitData to the form of sparse matrix.
+  arma::sp_mat cleanedData;
+  CleanData(implicitData, cleanedData, data);
+
+  // Make the optimizer object using a SVDPlusPlusFunction object.
+  SVDPlusPlusFunction<arma::mat> svdPPFunc(data, cleanedData, rank, lambda);
+
+  #ifdef HAS_OPENMP
+  const size_t threads = omp_get_max_threads();
+  #else
+  const size_t threads = 1;
+  Log::Warn << "Using parallel SGD, but OpenMP support is not available!"
+      << std::endl;
+  #endif
+
+  // Shard the ratings evenly across the threads; each iteration is one epoch
+  // over the whole dataset.
+  ens::ConstantStep decayPolicy(alpha);
+  ens::ParallelSGD<ens::ConstantStep> optimizer(iterations,
+      std::ceil((double) svdPPFunc.NumFunctions() / threads), 1e-5, true,
+      decayPolicy);
+
+  // Get optimized parameters.
+  arma::mat parameters = svdPPFunc.GetInitialPoint();
+  optimizer.Optimize(svdPPFunc, parameters);
+
+  // Constants for extracting user and item matrices.
+  const size_t numUsers = max(data.row(0)) + 1;
+  const size_t numItems = max(data.row(1)) + 1;
+
+  // Extract user and item matrices, user and item bias, item implicit matrix
+  // from the optimized parameters.
+  u = parameters.submat(0, numUsers, rank - 1, numUsers + numItems - 1).t();
+  v = parameters.submat(0, 0, rank - 1, numUsers - 1);
+  p = parameters.row(rank).subvec(numUsers, numUsers + numItems - 1).t();
+  q = parameters.row(rank).subvec(0, numUsers - 1).t();
+  y = parameters.submat(0, numUsers + numItems, rank - 1,
+      numUsers + 2 * numItems - 1);
+}
+
 } // namespace svd
 } // namespace mlpack
 
@@ -32,6 +32,9 @@
 #include <mlpack/methods/ann/activation_functions/spline_function.hpp>
 #include <mlpack/methods/ann/activation_functions/poisson1_function.hpp>
 #include <mlpack/methods/ann/activation_functions/gaussian_function.hpp>
+#include <mlpack/methods/ann/activation_functions/fast_logistic_function.hpp>
+#include <mlpack/methods/ann/activation_functions/fast_tanh_function.hpp>
+#include <mlpack/methods/ann/activation_functions/fast_softplus_function.hpp>
 
 #include <boost/test/unit_test.hpp>
 #include "test_tools.hpp"
@@ -597,6 +600,45 @@ BOOST_AUTO_TEST_CASE(LogisticFunctionTest)
   CheckInverseCorrect<LogisticFunction>(activationData);
 }
 
+/**
+ * Test that the approximated activation functions stay close to their exact
+ * counterparts, and that additional squarings tighten the approximation.
+ */
+BOOST_AUTO_TEST_CASE(FastActivationFunctionTest)
+{
+  const arma::colvec input = arma::linspace<arma::colvec>(-10, 10, 201);
+
+  arma::colvec exact, fast, tighter;
+
+  // Sigmoid: the default of 8 squarings keeps the error below 1e-3.
+  LogisticFunction::Fn(input, exact);
+  FastLogisticFunction<>::Fn(input, fast);
+  BOOST_REQUIRE_LT(arma::abs(exact - fast).max(), 1e-3);
+
+  FastLogisticFunction<12>::Fn(input, tighter);
+  BOOST_REQUIRE_LT(arma::abs(exact - tighter).max(),
+      arma::abs(exact - fast).max());
+
+  // Tanh.
+  TanhFunction::Fn(input, exact);
+  FastTanhFunction<>::Fn(input, fast);
+  BOOST_REQUIRE_LT(arma::abs(exact - fast).max(), 2e-3);
+
+  // Softplus.  The error of the exponential approximation grows with x^2, so
+  // check the relative error here.
+  SoftplusFunction::Fn(input, exact);
+  FastSoftplusFunction<>::Fn(input, fast);
+  BOOST_REQUIRE_LT((arma::abs(exact - fast) / (1.0 + arma::abs(exact))).max(),
+      2.5e-2);
+
+  // The derivatives are exact, since they are computed from the activations.
+  const arma::colvec activations("0.1 0.25 0.5 0.75 0.9");
+  arma::colvec exactDeriv, fastDeriv;
+  LogisticFunction::Deriv(activations, exactDeriv);
+  FastLogisticFunction<>::Deriv(activations, fastDeriv);
+  CheckMatrices(exactDeriv, fastDeriv);
+}
+
 /**
  * Basic test of the softsign function.
  */
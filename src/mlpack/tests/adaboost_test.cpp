@@ -600,6 +600,44 @@ BOOST_AUTO_TEST_CASE(ClassifyTest_VERTEBRALCOL)
   BOOST_REQUIRE_LE(lError, 0.30);
 }
 
+/**
+ * The early-exit cascade must give exactly the same predictions as the full
+ * evaluation in Classify().
+ */
+BOOST_AUTO_TEST_CASE(ClassifyCascadeTest)
+{
+  arma::mat inputData;
+  if (!data::Load("vc2.csv", inputData))
+    BOOST_FAIL("Cannot load test dataset vc2.csv!");
+
+  arma::Mat<size_t> labels;
+  if (!data::Load("vc2_labels.txt", labels))
+    BOOST_FAIL("Cannot load labels for vc2_labels.txt");
+
+  arma::mat testData;
+  if (!data::Load("vc2_test.csv", testData))
+    BOOST_FAIL("Cannot load test dataset vc2_test.csv!");
+
+  const size_t numClasses = max(labels.row(0)) + 1;
+
+  // Define your own weak learner, perceptron in this case.
+  size_t perceptronIter = 800;
+  Perceptron<> p(inputData, labels.row(0), numClasses, perceptronIter);
+
+  // Define parameters for AdaBoost.
+  size_t iterations = 100;
+  double tolerance = 1e-10;
+  AdaBoost<> a(inputData, labels.row(0), numClasses, p, iterations, tolerance);
+
+  arma::Row<size_t> fullPredictions, cascadePredictions;
+  a.Classify(testData, fullPredictions);
+  a.ClassifyCascade(testData, cascadePredictions);
+
+  BOOST_REQUIRE_EQUAL(cascadePredictions.n_elem, testData.n_cols);
+  for (size_t i = 0; i < fullPredictions.n_cols; ++i)
+    BOOST_REQUIRE_EQUAL(fullPredictions[i], cascadePredictions[i]);
+}
+
 /**
  * This test case runs the AdaBoost.mh algorithm on a non linearly separable
  * dataset.  It tests the Classify function and checks for a satisfactory error
@@ -390,6 +390,164 @@ BOOST_AUTO_TEST_CASE(SimpleLinearLayerTest)
   BOOST_REQUIRE_EQUAL(arma::accu(delta), 0);
 }
 
+/**
+ * Test int8 quantization of a trained linear module: the quantized layer
+ * must approximate the float layer on inputs covered by the calibration data.
+ */
+BOOST_AUTO_TEST_CASE(QuantizedLinearLayerTest)
+{
+  arma::mat calibrationData = arma::randu(10, 50);
+  arma::mat input = arma::randu(10, 8);
+  arma::mat referenceOutput, quantizedOutput, delta;
+
+  Linear<> module(10, 5);
+  module.Parameters().randu();
+  module.Reset();
+  module.Forward(input, referenceOutput);
+
+  // Quantize the trained layer, calibrating the input scale on sample data.
+  QuantizedLinear<> quantized(module, calibrationData);
+  BOOST_REQUIRE_EQUAL(quantized.InputSize(), 10);
+  BOOST_REQUIRE_EQUAL(quantized.OutputSize(), 5);
+  BOOST_REQUIRE_EQUAL(quantized.QuantizedWeight().n_rows, 5);
+  BOOST_REQUIRE_EQUAL(quantized.QuantizedWeight().n_cols, 10);
+
+  // Test the Forward function; the int8 grid has 127 steps per tensor, so
+  // the accumulated rounding error stays well below 0.1 for 10 inputs.
+  quantized.Forward(input, quantizedOutput);
+  BOOST_REQUIRE_EQUAL(quantizedOutput.n_rows, referenceOutput.n_rows);
+  BOOST_REQUIRE_EQUAL(quantizedOutput.n_cols, referenceOutput.n_cols);
+  BOOST_REQUIRE_LT(arma::abs(quantizedOutput - referenceOutput).max(), 0.1);
+
+  // Test the Backward function against the float layer.
+  arma::mat error = arma::randu(5, 8), referenceDelta;
+  module.Backward(input, error, referenceDelta);
+  quantized.Backward(input, error, delta);
+  BOOST_REQUIRE_LT(arma::abs(delta - referenceDelta).max(), 0.1);
+}
+
+/**
+ * Test the sparse-input overloads of the Linear layer: forward pass and
+ * gradient must match the dense computation on a densified copy.
+ */
+BOOST_AUTO_TEST_CASE(SparseLinearLayerTest)
+{
+  // Build a multi-hot sparse input batch.
+  arma::sp_mat input(10, 6);
+  input(0, 0) = 1;
+  input(3, 0) = 1;
+  input(7, 1) = 1;
+  input(2, 3) = 0.5;
+  input(9, 3) = 2;
+  input(5, 5) = 1;
+  arma::mat denseInput(input);
+
+  Linear<> module(10, 5);
+  module.Parameters().randu();
+  module.Reset();
+
+  // The sparse forward pass must match the dense one.
+  arma::mat denseOutput, sparseOutput;
+  module.Forward(denseInput, denseOutput);
+  module.Forward(input, sparseOutput);
+  CheckMatrices(denseOutput, sparseOutput);
+
+  // The sparse gradient must match the dense one.
+  arma::mat error = arma::randu(5, 6);
+  arma::mat denseGradient = arma::zeros(module.Parameters().n_elem, 1);
+  arma::mat sparseGradient = arma::zeros(module.Parameters().n_elem, 1);
+  module.Gradient(denseInput, error, denseGradient);
+  module.Gradient(input, error, sparseGradient);
+  CheckMatrices(denseGradient, sparseGradient);
+
+  // Empty columns (no active features) must yield the bias only.
+  arma::sp_mat emptyInput(10, 2);
+  module.Forward(emptyInput, sparseOutput);
+  BOOST_REQUIRE_EQUAL(sparseOutput.n_cols, 2);
+  CheckMatrices(arma::mat(sparseOutput.col(0)), arma::mat(module.Bias()));
+}
+
+/**
+ * Test the SparseEmbedding layer: the forward pass must gather the embedding
+ * columns, the backward pass must accumulate one summed update per touched
+ * embedding, and ApplyGradient() must only write the touched columns.
+ */
+BOOST_AUTO_TEST_CASE(SparseEmbeddingLayerTest)
+{
+  SparseEmbedding<> module(10, 4);
+  module.Weights().randu();
+  const arma::mat weightsBefore = module.Weights();
+
+  // One-based indices with a duplicate.
+  arma::mat input("3 7 3 1");
+  arma::mat output;
+  module.Forward(input, output);
+  BOOST_REQUIRE_EQUAL(output.n_rows, 4);
+  BOOST_REQUIRE_EQUAL(output.n_cols, 4);
+  CheckMatrices(output, arma::mat(weightsBefore.cols(arma::uvec("2 6 2 0"))));
+
+  // The backward pass must record the three touched embeddings, with the
+  // error columns of the duplicated index summed into one update.
+  arma::mat error = arma::randu(4, 4), delta;
+  module.Backward(input, error, delta);
+  BOOST_REQUIRE_EQUAL(module.TouchedIndices().n_elem, 3);
+  BOOST_REQUIRE_EQUAL(module.TouchedIndices()(0), 0);
+  BOOST_REQUIRE_EQUAL(module.TouchedIndices()(1), 2);
+  BOOST_REQUIRE_EQUAL(module.TouchedIndices()(2), 6);
+  CheckMatrices(arma::mat(module.TouchedGradients().col(0)),
+      arma::mat(error.col(3)));
+  CheckMatrices(arma::mat(module.TouchedGradients().col(1)),
+      arma::mat(error.col(0) + error.col(2)));
+  CheckMatrices(arma::mat(module.TouchedGradients().col(2)),
+      arma::mat(error.col(1)));
+
+  // Applying the update must only write the touched columns and clear the
+  // accumulated updates.
+  module.ApplyGradient(0.5);
+  arma::mat expectedWeights = weightsBefore;
+  expectedWeights.col(0) -= 0.5 * error.col(3);
+  expectedWeights.col(2) -= 0.5 * (error.col(0) + error.col(2));
+  expectedWeights.col(6) -= 0.5 * error.col(1);
+  CheckMatrices(module.Weights(), expectedWeights);
+  BOOST_REQUIRE_EQUAL(module.TouchedIndices().n_elem, 0);
+}
+
+/**
+ * Test that the core layers can be instantiated and run in single precision
+ * (arma::fmat) through their matrix-type template parameters.
+ */
+BOOST_AUTO_TEST_CASE(SinglePrecisionLayerTest)
+{
+  arma::fmat input = arma::randu<arma::fmat>(10, 4);
+  arma::fmat output, activation, softmax, delta;
+
+  Linear<arma::fmat, arma::fmat> linear(10, 5);
+  linear.Parameters().randu();
+  linear.Reset();
+  linear.Forward(input, output);
+  BOOST_REQUIRE_EQUAL(output.n_rows, 5);
+  BOOST_REQUIRE_EQUAL(output.n_cols, 4);
+
+  BaseLayer<LogisticFunction, arma::fmat, arma::fmat> sigmoid;
+  sigmoid.Forward(output, activation);
+  BOOST_REQUIRE(activation.min() >= 0.0f && activation.max() <= 1.0f);
+
+  LogSoftMax<arma::fmat, arma::fmat> logSoftMax;
+  logSoftMax.Forward(activation, softmax);
+  // Each column of the softmax output must sum to one.
+  for (size_t i = 0; i < softmax.n_cols; ++i)
+    BOOST_REQUIRE_CLOSE(arma::accu(arma::exp(softmax.col(i))), 1.0, 1e-2);
+
+  // The backward passes must run in single precision as well.
+  arma::fmat error = arma::randu<arma::fmat>(5, 4), softmaxDelta,
+      sigmoidDelta;
+  logSoftMax.Backward(softmax, error, softmaxDelta);
+  sigmoid.Backward(activation, softmaxDelta, sigmoidDelta);
+  linear.Backward(input, sigmoidDelta, delta);
+  BOOST_REQUIRE_EQUAL(delta.n_rows, 10);
+  BOOST_REQUIRE(delta.is_finite());
+}
+
 /**
  * Jacobian linear module test.
  */
@@ -0,0 +1,70 @@
+/**
+ * @file tests/arena_test.cpp
+ *
+ * Test for the arena allocator.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#include <mlpack/core.hpp>
+#include <mlpack/core/util/arena.hpp>
+
+#include <boost/test/unit_test.hpp>
+#include "test_tools.hpp"
+
+using namespace mlpack;
+using namespace mlpack::util;
+
+BOOST_AUTO_TEST_SUITE(ArenaTest);
+
+/**
+ * Containers backed by the arena must behave like normal containers, and a
+ * scope must not invalidate allocations made before it was opened.
+ */
+BOOST_AUTO_TEST_CASE(ArenaAllocatorTest)
+{
+  Arena::Scope scope;
+
+  std::vector<int, ArenaAllocator<int>> values;
+  for (int i = 0; i < 1000; ++i)
+    values.push_back(i);
+
+  {
+    // Allocations inside this scope are reclaimed when it ends; the vector
+    // built outside of it must stay intact.
+    Arena::Scope inner;
+    std::vector<double, ArenaAllocator<double>> scratch(5000, 1.5);
+    BOOST_REQUIRE_CLOSE(scratch[4999], 1.5, 1e-10);
+  }
+
+  for (int i = 0; i < 1000; ++i)
+    BOOST_REQUIRE_EQUAL(values[i], i);
+}
+
+/**
+ * Allocations larger than the default block size must work.
+ */
+BOOST_AUTO_TEST_CASE(ArenaLargeAllocationTest)
+{
+  Arena::Scope scope;
+
+  std::vector<char, ArenaAllocator<char>> big(3 * 1048576, 'x');
+  BOOST_REQUIRE_EQUAL(big[big.size() - 1], 'x');
+}
+
+/**
+ * Alignment requests must be honored.
+ */
+BOOST_AUTO_TEST_CASE(ArenaAlignmentTest)
+{
+  Arena::Scope scope;
+  Arena& arena = Arena::ThreadLocal();
+
+  (void) arena.Allocate(1, 1);
+  void* aligned = arena.Allocate(64, 64);
+  BOOST_REQUIRE_EQUAL(((uintptr_t) aligned) % 64, 0);
+}
+
+BOOST_AUTO_TEST_SUITE_END();
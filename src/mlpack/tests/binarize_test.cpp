@@ -68,4 +68,34 @@ BOOST_AUTO_TEST_CASE(BinerizeAll)
   BOOST_REQUIRE_CLOSE(output(2, 2), 1.0, 1e-5); // 9
 }
 
+BOOST_AUTO_TEST_CASE(BinerizeSparse)
+{
+  arma::sp_mat input(3, 3);
+  input(0, 1) = 2;
+  input(1, 0) = 4;
+  input(1, 2) = 6;
+  input(2, 0) = 7;
+
+  const double threshold = 5.0;
+
+  // Binarize the whole matrix; only the entries above the threshold survive.
+  arma::sp_mat output;
+  Binarize(input, output, threshold);
+
+  BOOST_REQUIRE_EQUAL(output.n_nonzero, 2);
+  BOOST_REQUIRE_CLOSE((double) output(1, 2), 1.0, 1e-5); // 6
+  BOOST_REQUIRE_CLOSE((double) output(2, 0), 1.0, 1e-5); // 7
+
+  // Binarize only the second dimension.
+  Binarize(input, output, threshold, 1);
+
+  BOOST_REQUIRE_CLOSE((double) output(0, 1), 2.0, 1e-5); // 2
+  BOOST_REQUIRE_SMALL((double) output(1, 0), 1e-5); // 4
+  BOOST_REQUIRE_CLOSE((double) output(1, 2), 1.0, 1e-5); // 6
+  BOOST_REQUIRE_CLOSE((double) output(2, 0), 7.0, 1e-5); // 7
+
+  // A negative threshold would densify the matrix and must be rejected.
+  BOOST_REQUIRE_THROW(Binarize(input, output, -1.0), std::invalid_argument);
+}
+
 BOOST_AUTO_TEST_SUITE_END();
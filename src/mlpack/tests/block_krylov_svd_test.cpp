@@ -109,4 +109,69 @@ BOOST_AUTO_TEST_CASE(RandomizedBlockKrylovSVDNoisyLowRankTest)
   BOOST_REQUIRE_SMALL(error, 1e-2);
 }
 
+/**
+ * A matrix-free operand that computes its products by streaming column chunks
+ * of the underlying matrix, as an out-of-core operator would.
+ */
+class ChunkedOperand
+{
+ public:
+  ChunkedOperand(const arma::mat& data, const size_t chunkSize) :
+      data(data), chunkSize(chunkSize) { }
+
+  size_t NumRows() const { return data.n_rows; }
+  size_t NumCols() const { return data.n_cols; }
+
+  void Multiply(const arma::mat& x, arma::mat& out) const
+  {
+    out.zeros(data.n_rows, x.n_cols);
+    for (size_t begin = 0; begin < data.n_cols; begin += chunkSize)
+    {
+      const size_t end = std::min(begin + chunkSize,
+          (size_t) data.n_cols) - 1;
+      out += data.cols(begin, end) * x.rows(begin, end);
+    }
+  }
+
+  void MultiplyTranspose(const arma::mat& x, arma::mat& out) const
+  {
+    out.set_size(data.n_cols, x.n_cols);
+    for (size_t begin = 0; begin < data.n_cols; begin += chunkSize)
+    {
+      const size_t end = std::min(begin + chunkSize,
+          (size_t) data.n_cols) - 1;
+      out.rows(begin, end) = data.cols(begin, end).t() * x;
+    }
+  }
+
+ private:
+  const arma::mat& data;
+  const size_t chunkSize;
+};
+
+/**
+ * The restarted, matrix-free variant should recover the singular values as
+ * accurately as the in-memory path.
+ */
+BOOST_AUTO_TEST_CASE(RandomizedBlockKrylovSVDRestartedOperandTest)
+{
+  arma::mat data;
+  CreateNoisyLowRankMatrix(data, 200, 1000, 5, 0.5);
+
+  const size_t rank = 5;
+
+  arma::mat U1, U2, V1, V2;
+  arma::vec s1, s2;
+
+  arma::svd_econ(U1, s1, V1, data);
+
+  // Hold at most three Krylov blocks in memory and stream the matrix in
+  // chunks of 64 columns.
+  svd::RandomizedBlockKrylovSVD rSVDB(10, 20, 3);
+  rSVDB.Apply(ChunkedOperand(data, 64), U2, s2, V2, rank);
+
+  double error = arma::max(arma::abs(s1.subvec(0, rank) - s2.subvec(0, rank)));
+  BOOST_REQUIRE_SMALL(error, 1e-2);
+}
+
 BOOST_AUTO_TEST_SUITE_END();
@@ -652,6 +652,49 @@ BOOST_AUTO_TEST_CASE(CFGetRecommendationsQueriedUserSVDPPTest)
   GetRecommendationsQueriedUser<SVDPlusPlusPolicy>();
 }
 
+/**
+ * Make sure that recommendations served from the precomputed neighborhood
+ * cache match the ones computed with a fresh neighbor search, and that
+ * retraining invalidates the cache.
+ */
+BOOST_AUTO_TEST_CASE(CFCachedNeighborhoodTest)
+{
+  // Load GroupLens data.
+  arma::mat dataset;
+  data::Load("GroupLensSmall.csv", dataset);
+
+  NMFPolicy decomposition;
+  CFType<NMFPolicy> c(dataset, decomposition, 5, 5, 30);
+  BOOST_REQUIRE_EQUAL(c.NeighborhoodCached(), false);
+
+  // Create dummy query set.
+  arma::Col<size_t> users = arma::zeros<arma::Col<size_t> >(10, 1);
+  for (size_t i = 0; i < 10; i++)
+    users(i) = i;
+
+  // Generate recommendations with a fresh neighbor search.
+  arma::Mat<size_t> freshRecommendations;
+  c.GetRecommendations(5, freshRecommendations, users);
+
+  // Precompute the neighborhoods and serve the same query from the cache.
+  c.CacheNeighborhoods();
+  BOOST_REQUIRE_EQUAL(c.NeighborhoodCached(), true);
+
+  arma::Mat<size_t> cachedRecommendations;
+  c.GetRecommendations(5, cachedRecommendations, users);
+
+  BOOST_REQUIRE_EQUAL(cachedRecommendations.n_rows,
+      freshRecommendations.n_rows);
+  BOOST_REQUIRE_EQUAL(cachedRecommendations.n_cols,
+      freshRecommendations.n_cols);
+  for (size_t i = 0; i < freshRecommendations.n_elem; ++i)
+    BOOST_REQUIRE_EQUAL(cachedRecommendations[i], freshRecommendations[i]);
+
+  // Retraining with new ratings must invalidate the cache.
+  c.Train(dataset, decomposition, 30);
+  BOOST_REQUIRE_EQUAL(c.NeighborhoodCached(), false);
+}
+
 /**
  * Make sure recommendations that are generated are reasonably accurate
  * for randomized SVD.
@@ -20,6 +20,7 @@
 #include <mlpack/core/cv/metrics/r2_score.hpp>
 #include <mlpack/core/cv/simple_cv.hpp>
 #include <mlpack/core/cv/k_fold_cv.hpp>
+#include <mlpack/core/cv/prequential_evaluation.hpp>
 #include <mlpack/methods/ann/ffn.hpp>
 #include <mlpack/methods/ann/init_rules/const_init.hpp>
 #include <mlpack/methods/ann/layer/layer.hpp>
@@ -33,6 +34,8 @@
 #include <mlpack/methods/naive_bayes/naive_bayes_classifier.hpp>
 #include <mlpack/methods/softmax_regression/softmax_regression.hpp>
 #include <mlpack/core/data/confusion_matrix.hpp>
+#include <mlpack/core/data/incremental_confusion_matrix.hpp>
+#include <mlpack/core/cv/metrics/incremental_mse.hpp>
 #include <ensmallen.hpp>
 
 #include <boost/test/unit_test.hpp>
@@ -94,6 +97,66 @@ BOOST_AUTO_TEST_CASE(ConfusionMatrixTest)
   BOOST_REQUIRE_EQUAL(output(1, 1), 3);
 }
 
+/**
+ * Test that the incrementally updated confusion matrix agrees with
+ * data::ConfusionMatrix() and yields the right derived metrics, including
+ * after batched updates and merging.
+ */
+BOOST_AUTO_TEST_CASE(IncrementalConfusionMatrixTest)
+{
+  // Labels that will be considered as "ground truth".
+  arma::Row<size_t> labels("0 0 1 0 0  1 0 1 0 1");
+
+  // Predicted labels.
+  arma::Row<size_t> predictedLabels("0 0 0 0 0  1 1 1 1 1");
+
+  // Accumulate the same predictions in two batches and merge a second
+  // accumulator, as per-thread accumulators would be merged.
+  data::IncrementalConfusionMatrix cm(2), other(2);
+  cm.Update(predictedLabels.cols(0, 4), labels.cols(0, 4));
+  other.Update(predictedLabels.cols(5, 9), labels.cols(5, 9));
+  cm.Merge(other);
+
+  BOOST_REQUIRE_EQUAL(cm.NumPoints(), 10);
+  BOOST_REQUIRE_EQUAL(cm.Matrix()(0, 0), 4);
+  BOOST_REQUIRE_EQUAL(cm.Matrix()(0, 1), 1);
+  BOOST_REQUIRE_EQUAL(cm.Matrix()(1, 0), 2);
+  BOOST_REQUIRE_EQUAL(cm.Matrix()(1, 1), 3);
+
+  BOOST_REQUIRE_CLOSE(cm.Accuracy(), 0.7, 1e-5);
+  BOOST_REQUIRE_CLOSE(cm.Precision(1), 3.0 / 5.0, 1e-5);
+  BOOST_REQUIRE_CLOSE(cm.Recall(1), 3.0 / 4.0, 1e-5);
+  BOOST_REQUIRE_CLOSE(cm.F1(1),
+      2.0 * 0.6 * 0.75 / (0.6 + 0.75), 1e-5);
+
+  cm.Reset();
+  BOOST_REQUIRE_EQUAL(cm.NumPoints(), 0);
+  BOOST_REQUIRE_THROW(cm.Accuracy(), std::logic_error);
+}
+
+/**
+ * Test that the incrementally updated mean squared error agrees with the
+ * directly computed one, including after batched updates and merging.
+ */
+BOOST_AUTO_TEST_CASE(IncrementalMSETest)
+{
+  arma::rowvec responses = arma::randn<arma::rowvec>(100);
+  arma::rowvec predictions = responses + 0.1 * arma::randn<arma::rowvec>(100);
+
+  IncrementalMSE mse, other;
+  mse.Update(predictions.cols(0, 59), responses.cols(0, 59));
+  other.Update(predictions.cols(60, 99), responses.cols(60, 99));
+  mse.Merge(other);
+
+  const double expected =
+      arma::accu(arma::square(predictions - responses)) / 100.0;
+  BOOST_REQUIRE_EQUAL(mse.NumPoints(), 100);
+  BOOST_REQUIRE_CLOSE(mse.Value(), expected, 1e-5);
+
+  mse.Reset();
+  BOOST_REQUIRE_THROW(mse.Value(), std::logic_error);
+}
+
 /**
  * Test metrics for multiclass classification.
  */
@@ -719,4 +782,66 @@ BOOST_AUTO_TEST_CASE(KFoldCVWithDTTestUnevenBinsWeighted)
   BOOST_REQUIRE_GT(accuracy, 0.7);
 }
 
+/**
+ * Test prequential (test-then-train) evaluation of a Hoeffding tree over a
+ * replayed stream.
+ */
+BOOST_AUTO_TEST_CASE(PrequentialEvaluationTest)
+{
+  // An easily separable two-class stream.
+  arma::mat data = arma::join_rows(
+      arma::randn(3, 1000) - 5.0, arma::randn(3, 1000) + 5.0);
+  arma::Row<size_t> labels = arma::join_rows(
+      arma::zeros<arma::Row<size_t>>(1000), arma::ones<arma::Row<size_t>>(1000));
+  math::ShuffleData(data, labels, data, labels);
+
+  data::DatasetInfo info(data.n_rows);
+  HoeffdingTree<> tree(info, 2);
+
+  PrequentialEvaluation<HoeffdingTree<>, Accuracy> eval;
+  const double overallAccuracy =
+      eval.Evaluate(tree, data, labels, 100, false /* streaming mode */);
+
+  BOOST_REQUIRE_EQUAL(eval.NumPoints(), 2000);
+  // The first chunk is only trained on, so 1900 points are assessed.
+  BOOST_REQUIRE_GT(overallAccuracy, 0.9);
+  BOOST_REQUIRE_GT(eval.WindowedObjective(), 0.9);
+  BOOST_REQUIRE_CLOSE(overallAccuracy, eval.OverallObjective(), 1e-10);
+
+  eval.Reset();
+  BOOST_REQUIRE_EQUAL(eval.NumPoints(), 0);
+  BOOST_REQUIRE_THROW(eval.OverallObjective(), std::logic_error);
+}
+
+/**
+ * Test that feeding chunks one at a time with Process() agrees with replaying
+ * the stream with Evaluate(), and that the window tracks only recent chunks.
+ */
+BOOST_AUTO_TEST_CASE(PrequentialProcessTest)
+{
+  arma::mat data = arma::join_rows(
+      arma::randn(3, 500) - 5.0, arma::randn(3, 500) + 5.0);
+  arma::Row<size_t> labels = arma::join_rows(
+      arma::zeros<arma::Row<size_t>>(500), arma::ones<arma::Row<size_t>>(500));
+  math::ShuffleData(data, labels, data, labels);
+
+  data::DatasetInfo info(data.n_rows);
+  HoeffdingTree<> replayedTree(info, 2), fedTree(info, 2);
+
+  PrequentialEvaluation<HoeffdingTree<>, Accuracy> replayed(3), fed(3);
+  replayed.Evaluate(replayedTree, data, labels, 100, false);
+
+  for (size_t begin = 0; begin < data.n_cols; begin += 100)
+  {
+    fed.Process(fedTree, data.cols(begin, begin + 99),
+        labels.cols(begin, begin + 99), false);
+  }
+
+  BOOST_REQUIRE_CLOSE(replayed.OverallObjective(), fed.OverallObjective(),
+      1e-10);
+  BOOST_REQUIRE_CLOSE(replayed.WindowedObjective(), fed.WindowedObjective(),
+      1e-10);
+  BOOST_REQUIRE_EQUAL(fed.NumPoints(), 1000);
+}
+
 BOOST_AUTO_TEST_SUITE_END();
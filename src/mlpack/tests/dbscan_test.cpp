@@ -309,4 +309,50 @@ BOOST_AUTO_TEST_CASE(RandomPointSelectionTest)
   BOOST_REQUIRE_EQUAL(assignments.n_elem, points.n_cols);
 }
 
+/**
+ * Check that the grid-based range search gives exactly the same clustering as
+ * the default tree-based range search on low-dimensional data.
+ */
+BOOST_AUTO_TEST_CASE(GridRangeSearchTest)
+{
+  arma::mat points(3, 500, arma::fill::randu);
+
+  DBSCAN<> d(0.1, 3);
+  DBSCAN<GridRangeSearch> gridD(0.1, 3);
+
+  arma::Row<size_t> assignments;
+  arma::Row<size_t> gridAssignments;
+  const size_t clusters = d.Cluster(points, assignments);
+  const size_t gridClusters = gridD.Cluster(points, gridAssignments);
+
+  // Both searches are exact, and the union-find representative of each
+  // component is deterministic, so the results should be identical.
+  BOOST_REQUIRE_EQUAL(clusters, gridClusters);
+  BOOST_REQUIRE_EQUAL(assignments.n_elem, gridAssignments.n_elem);
+  for (size_t i = 0; i < assignments.n_elem; ++i)
+    BOOST_REQUIRE_EQUAL(assignments[i], gridAssignments[i]);
+}
+
+/**
+ * Check that the grid-based range search also works in pointwise (non-batch)
+ * mode.
+ */
+BOOST_AUTO_TEST_CASE(GridRangeSearchPointwiseTest)
+{
+  arma::mat points(3, 500, arma::fill::randu);
+
+  DBSCAN<GridRangeSearch> batchD(0.1, 3, true);
+  DBSCAN<GridRangeSearch> pointwiseD(0.1, 3, false);
+
+  arma::Row<size_t> batchAssignments;
+  arma::Row<size_t> pointwiseAssignments;
+  const size_t batchClusters = batchD.Cluster(points, batchAssignments);
+  const size_t pointwiseClusters = pointwiseD.Cluster(points,
+      pointwiseAssignments);
+
+  BOOST_REQUIRE_EQUAL(batchClusters, pointwiseClusters);
+  for (size_t i = 0; i < batchAssignments.n_elem; ++i)
+    BOOST_REQUIRE_EQUAL(batchAssignments[i], pointwiseAssignments[i]);
+}
+
 BOOST_AUTO_TEST_SUITE_END();
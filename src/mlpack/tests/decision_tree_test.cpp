@@ -370,6 +370,134 @@ BOOST_AUTO_TEST_CASE(BestBinaryNumericSplitNoGainTest)
   BOOST_REQUIRE_EQUAL(classProbabilities.n_elem, 0);
 }
 
+/**
+ * Check that the HistogramBinaryNumericSplit will split on an obviously
+ * splittable dimension, with a threshold quantized to a bin boundary.
+ */
+BOOST_AUTO_TEST_CASE(HistogramBinaryNumericSplitSimpleSplitTest)
+{
+  arma::vec values("0.0 0.1 0.2 0.3 0.4 0.5 0.6 0.7 0.8 0.9 1.0");
+  arma::Row<size_t> labels("0 0 0 0 0 1 1 1 1 1 1");
+  arma::rowvec weights(labels.n_elem);
+  weights.ones();
+
+  arma::vec classProbabilities;
+  HistogramBinaryNumericSplit<GiniGain>::template
+      AuxiliarySplitInfo<double> aux;
+
+  // Call the method to do the splitting.
+  const double bestGain = GiniGain::Evaluate<false>(labels, 2, weights);
+  const double gain =
+      HistogramBinaryNumericSplit<GiniGain>::SplitIfBetter<false>(bestGain,
+      values, labels, 2, weights, 3, 1e-7, classProbabilities, aux);
+  const double weightedGain =
+      HistogramBinaryNumericSplit<GiniGain>::SplitIfBetter<true>(bestGain,
+      values, labels, 2, weights, 3, 1e-7, classProbabilities, aux);
+
+  // Make sure that a split was made.
+  BOOST_REQUIRE_GT(gain, bestGain);
+
+  // Make sure weight works and is not different than the unweighted one.
+  BOOST_REQUIRE_EQUAL(gain, weightedGain);
+
+  // The split is perfect, so we should be able to accomplish a gain of 0.
+  BOOST_REQUIRE_SMALL(gain, 1e-5);
+
+  // The threshold is a bin boundary strictly between the two classes.
+  BOOST_REQUIRE_EQUAL(classProbabilities.n_elem, 1);
+  BOOST_REQUIRE_GT(classProbabilities[0], 0.4);
+  BOOST_REQUIRE_LT(classProbabilities[0], 0.5);
+}
+
+/**
+ * Check that the HistogramBinaryNumericSplit won't split if not enough points
+ * are given.
+ */
+BOOST_AUTO_TEST_CASE(HistogramBinaryNumericSplitMinSamplesTest)
+{
+  arma::vec values("0.0 0.1 0.2 0.3 0.4 0.5 0.6 0.7 0.8 0.9 1.0");
+  arma::Row<size_t> labels("0 0 0 0 0 1 1 1 1 1 1");
+  arma::rowvec weights(labels.n_elem);
+
+  arma::vec classProbabilities;
+  HistogramBinaryNumericSplit<GiniGain>::template
+      AuxiliarySplitInfo<double> aux;
+
+  // Call the method to do the splitting.
+  const double bestGain = GiniGain::Evaluate<false>(labels, 2, weights);
+  const double gain =
+      HistogramBinaryNumericSplit<GiniGain>::SplitIfBetter<false>(bestGain,
+      values, labels, 2, weights, 8, 1e-7, classProbabilities, aux);
+
+  // Make sure that no split was made.
+  BOOST_REQUIRE_EQUAL(gain, DBL_MAX);
+  BOOST_REQUIRE_EQUAL(classProbabilities.n_elem, 0);
+}
+
+/**
+ * Check that the HistogramBinaryNumericSplit doesn't split a dimension that
+ * gives no gain.
+ */
+BOOST_AUTO_TEST_CASE(HistogramBinaryNumericSplitNoGainTest)
+{
+  arma::vec values(100);
+  arma::Row<size_t> labels(100);
+  arma::rowvec weights;
+  for (size_t i = 0; i < 100; i += 2)
+  {
+    values[i] = i;
+    labels[i] = 0;
+    values[i + 1] = i;
+    labels[i + 1] = 1;
+  }
+
+  arma::vec classProbabilities;
+  HistogramBinaryNumericSplit<GiniGain>::template
+      AuxiliarySplitInfo<double> aux;
+
+  // Call the method to do the splitting.
+  const double bestGain = GiniGain::Evaluate<false>(labels, 2, weights);
+  const double gain =
+      HistogramBinaryNumericSplit<GiniGain>::SplitIfBetter<false>(bestGain,
+      values, labels, 2, weights, 10, 1e-7, classProbabilities, aux);
+
+  // Make sure there was no split.
+  BOOST_REQUIRE_EQUAL(gain, DBL_MAX);
+  BOOST_REQUIRE_EQUAL(classProbabilities.n_elem, 0);
+}
+
+/**
+ * A decision tree built with the histogram split should learn a simple
+ * Gaussian classification task about as well as the exhaustive split.
+ */
+BOOST_AUTO_TEST_CASE(HistogramSplitBuildTest)
+{
+  const size_t points = 600;
+
+  arma::mat data(2, points);
+  arma::Row<size_t> labels(points);
+  for (size_t i = 0; i < points; ++i)
+  {
+    const size_t cls = i % 3;
+    data(0, i) = 4.0 * cls + mlpack::math::RandNormal();
+    data(1, i) = 4.0 * cls + mlpack::math::RandNormal();
+    labels[i] = cls;
+  }
+
+  DecisionTree<GiniGain, HistogramBinaryNumericSplit> tree(data, labels, 3,
+      5 /* minimumLeafSize */);
+
+  arma::Row<size_t> predictions;
+  tree.Classify(data, predictions);
+
+  size_t correct = 0;
+  for (size_t i = 0; i < points; ++i)
+    if (predictions[i] == labels[i])
+      ++correct;
+
+  BOOST_REQUIRE_GE((double) correct / points, 0.9);
+}
+
 /**
  * Check that the AllCategoricalSplit will split when the split is obviously
  * better.
@@ -468,6 +596,124 @@ BOOST_AUTO_TEST_CASE(AllCategoricalSplitNoGainTest)
   BOOST_REQUIRE_EQUAL(classProbabilities.n_elem, 0);
 }
 
+/**
+ * Check that the BestBinaryCategoricalSplit will split on a perfectly
+ * separable binary partition of the categories, and that points are routed to
+ * the correct side of the split.
+ */
+BOOST_AUTO_TEST_CASE(BestBinaryCategoricalSplitSimpleSplitTest)
+{
+  // Categories 0 and 2 belong to class 0; categories 1 and 3 to class 1.
+  arma::vec values("0 0 0 1 1 1 2 2 2 3 3 3");
+  arma::Row<size_t> labels("0 0 0 1 1 1 0 0 0 1 1 1");
+  arma::rowvec weights(labels.n_elem);
+  weights.ones();
+
+  arma::vec classProbabilities;
+  BestBinaryCategoricalSplit<GiniGain>::template AuxiliarySplitInfo<double> aux;
+
+  // Call the method to do the splitting.
+  const double bestGain = GiniGain::Evaluate<false>(labels, 2, weights);
+  const double gain =
+      BestBinaryCategoricalSplit<GiniGain>::SplitIfBetter<false>(bestGain,
+      values, 4, labels, 2, weights, 3, 1e-7, classProbabilities, aux);
+
+  // Make sure that a split was made, and that it is perfect.
+  BOOST_REQUIRE_GT(gain, bestGain);
+  BOOST_REQUIRE_SMALL(gain, 1e-5);
+
+  // The weighted gain should be identical with unit weights.
+  arma::vec weightedClassProbabilities;
+  const double weightedGain =
+      BestBinaryCategoricalSplit<GiniGain>::SplitIfBetter<true>(bestGain,
+      values, 4, labels, 2, weights, 3, 1e-7, weightedClassProbabilities, aux);
+  BOOST_REQUIRE_EQUAL(gain, weightedGain);
+
+  // The split has two children, the number of categories is stored, and the
+  // classes are routed to opposite sides.
+  BOOST_REQUIRE_EQUAL(
+      (BestBinaryCategoricalSplit<GiniGain>::NumChildren(classProbabilities,
+      aux)), 2);
+  BOOST_REQUIRE_EQUAL((size_t) classProbabilities[0], 4);
+
+  const size_t d0 = BestBinaryCategoricalSplit<GiniGain>::CalculateDirection(
+      0.0, classProbabilities, aux);
+  const size_t d1 = BestBinaryCategoricalSplit<GiniGain>::CalculateDirection(
+      1.0, classProbabilities, aux);
+  const size_t d2 = BestBinaryCategoricalSplit<GiniGain>::CalculateDirection(
+      2.0, classProbabilities, aux);
+  const size_t d3 = BestBinaryCategoricalSplit<GiniGain>::CalculateDirection(
+      3.0, classProbabilities, aux);
+
+  BOOST_REQUIRE_EQUAL(d0, d2);
+  BOOST_REQUIRE_EQUAL(d1, d3);
+  BOOST_REQUIRE_NE(d0, d1);
+}
+
+/**
+ * Make sure that BestBinaryCategoricalSplit respects the minimum number of
+ * samples required to split.
+ */
+BOOST_AUTO_TEST_CASE(BestBinaryCategoricalSplitMinSamplesTest)
+{
+  arma::vec values("0 0 1 1");
+  arma::Row<size_t> labels("0 0 1 1");
+  arma::rowvec weights(labels.n_elem);
+  weights.ones();
+
+  arma::vec classProbabilities;
+  BestBinaryCategoricalSplit<GiniGain>::template AuxiliarySplitInfo<double> aux;
+
+  // Call the method to do the splitting.
+  const double bestGain = GiniGain::Evaluate<false>(labels, 2, weights);
+  const double gain =
+      BestBinaryCategoricalSplit<GiniGain>::SplitIfBetter<false>(bestGain,
+      values, 2, labels, 2, weights, 3, 1e-7, classProbabilities, aux);
+
+  // Make sure that no split was made.
+  BOOST_REQUIRE_EQUAL(gain, DBL_MAX);
+  BOOST_REQUIRE_EQUAL(classProbabilities.n_elem, 0);
+}
+
+/**
+ * Make sure that BestBinaryCategoricalSplit does not split when no binary
+ * partition of the categories gives any gain.
+ */
+BOOST_AUTO_TEST_CASE(BestBinaryCategoricalSplitNoGainTest)
+{
+  // Every category has the same class distribution.
+  arma::vec values(300);
+  arma::Row<size_t> labels(300);
+  arma::rowvec weights = arma::ones<arma::rowvec>(300);
+
+  for (size_t i = 0; i < 300; i += 3)
+  {
+    values[i] = int(i / 3) % 10;
+    labels[i] = 0;
+    values[i + 1] = int(i / 3) % 10;
+    labels[i + 1] = 1;
+    values[i + 2] = int(i / 3) % 10;
+    labels[i + 2] = 2;
+  }
+
+  arma::vec classProbabilities;
+  BestBinaryCategoricalSplit<GiniGain>::template AuxiliarySplitInfo<double> aux;
+
+  // Call the method to do the splitting.
+  const double bestGain = GiniGain::Evaluate<false>(labels, 3, weights);
+  const double gain =
+      BestBinaryCategoricalSplit<GiniGain>::SplitIfBetter<false>(bestGain,
+      values, 10, labels, 3, weights, 10, 1e-7, classProbabilities, aux);
+  const double weightedGain =
+      BestBinaryCategoricalSplit<GiniGain>::SplitIfBetter<true>(bestGain,
+      values, 10, labels, 3, weights, 10, 1e-7, classProbabilities, aux);
+
+  // Make sure that there was no split.
+  BOOST_REQUIRE_EQUAL(gain, DBL_MAX);
+  BOOST_REQUIRE_EQUAL(gain, weightedGain);
+  BOOST_REQUIRE_EQUAL(classProbabilities.n_elem, 0);
+}
+
 /**
  * A basic construction of the decision tree---ensure that we can create the
  * tree and that it split at least once.
@@ -729,6 +975,42 @@ BOOST_AUTO_TEST_CASE(CategoricalBuildTest)
   BOOST_REQUIRE_GT(correctPct, 0.70);
 }
 
+/**
+ * Test that we can build a decision tree using binary categorical splits on a
+ * simple categorical dataset, without one-hot encoding.
+ */
+BOOST_AUTO_TEST_CASE(BinaryCategoricalBuildTest)
+{
+  arma::mat d;
+  arma::Row<size_t> l;
+  data::DatasetInfo di;
+  MockCategoricalData(d, l, di);
+
+  // Split into a training set and a test set.
+  arma::mat trainingData = d.cols(0, 1999);
+  arma::mat testData = d.cols(2000, 3999);
+  arma::Row<size_t> trainingLabels = l.subvec(0, 1999);
+  arma::Row<size_t> testLabels = l.subvec(2000, 3999);
+
+  // Build the tree with binary categorical splits.
+  DecisionTree<GiniGain, BestBinaryNumericSplit, BestBinaryCategoricalSplit>
+      tree(trainingData, di, trainingLabels, 5, 10);
+
+  // Now evaluate the accuracy of the tree.
+  arma::Row<size_t> predictions;
+  tree.Classify(testData, predictions);
+
+  BOOST_REQUIRE_EQUAL(predictions.n_elem, testData.n_cols);
+  size_t correct = 0;
+  for (size_t i = 0; i < testData.n_cols; ++i)
+    if (testLabels[i] == predictions[i])
+      ++correct;
+
+  // Make sure we got at least 70% accuracy.
+  const double correctPct = double(correct) / double(testData.n_cols);
+  BOOST_REQUIRE_GT(correctPct, 0.70);
+}
+
 /**
  * Test that we can build a decision tree with weights on a simple categorical
  * dataset.
@@ -349,6 +349,42 @@ BOOST_AUTO_TEST_CASE(TestComputeValue)
   BOOST_REQUIRE_CLOSE(0.0, testDTree.ComputeValue(q4), 1e-10);
 }
 
+BOOST_AUTO_TEST_CASE(TestBatchComputeValue)
+{
+  arma::mat testData(3, 5);
+
+  testData << 4 << 5 << 7 << 3 << 5 << arma::endr
+           << 5 << 0 << 1 << 7 << 1 << arma::endr
+           << 5 << 6 << 7 << 1 << 8 << arma::endr;
+
+  arma::Col<size_t> oTest(5);
+  oTest << 0 << 1 << 2 << 3 << 4;
+
+  DTree<arma::mat> testDTree(testData);
+  testDTree.Grow(testData, oTest, false, 2, 1);
+
+  // Generate a batch of queries, some of which fall outside the tree's range,
+  // and check that the batch API agrees with the per-point API.
+  arma::mat queries(3, 500);
+  queries.row(0) = arma::randu<arma::rowvec>(500) * 8.0;
+  queries.row(1) = arma::randu<arma::rowvec>(500) * 10.0 - 1.0;
+  queries.row(2) = arma::randu<arma::rowvec>(500) * 10.0;
+
+  arma::rowvec batchDensities;
+  testDTree.ComputeValue(queries, batchDensities);
+
+  BOOST_REQUIRE_EQUAL(batchDensities.n_elem, queries.n_cols);
+  for (size_t i = 0; i < queries.n_cols; ++i)
+  {
+    const double density = testDTree.ComputeValue(
+        (arma::vec) queries.unsafe_col(i));
+    if (std::abs(density) < 1e-10)
+      BOOST_REQUIRE_SMALL(batchDensities[i], 1e-10);
+    else
+      BOOST_REQUIRE_CLOSE(density, batchDensities[i], 1e-10);
+  }
+}
+
 BOOST_AUTO_TEST_CASE(TestVariableImportance)
 {
   arma::mat testData(3, 5);
@@ -652,7 +652,7 @@ BOOST_AUTO_TEST_CASE(GammaDistributionTrainTest)
   // Random generation of gamma-like points.
   for (size_t j = 0; j < d; ++j)
     for (size_t i = 0; i < N; ++i)
-      rdata(j, i) = dist(math::randGen);
+      rdata(j, i) = dist(math::RandGen());
 
   // Create Gamma object and call Train() on reference set.
   GammaDistribution gDist;
@@ -670,7 +670,7 @@ BOOST_AUTO_TEST_CASE(GammaDistributionTrainTest)
   // Random generation of gamma-like points.
   for (size_t j = 0; j < d2; ++j)
     for (size_t i = 0; i < N2; ++i)
-      rdata2(j, i) = dist(math::randGen);
+      rdata2(j, i) = dist(math::RandGen());
 
   // Fit results using old object.
   gDist.Train(rdata2);
@@ -698,7 +698,7 @@ BOOST_AUTO_TEST_CASE(GammaDistributionTrainWithProbabilitiesTest)
 
   for (size_t j = 0; j < d; j++)
     for (size_t i = 0; i < N; i++)
-      rdata(j, i) = dist(math::randGen);
+      rdata(j, i) = dist(math::RandGen());
 
   // Fill the probabilities randomly.
   arma::vec probabilities(N, arma::fill::randu);
@@ -742,7 +742,7 @@ BOOST_AUTO_TEST_CASE(GammaDistributionTrainAllProbabilities1Test)
 
   for (size_t j = 0; j < d; j++)
     for (size_t i = 0; i < N; i++)
-      rdata(j, i) = dist(math::randGen);
+      rdata(j, i) = dist(math::RandGen());
 
   // Fit results with only data.
   GammaDistribution gDist;
@@ -790,9 +790,9 @@ BOOST_AUTO_TEST_CASE(GammaDistributionTrainTwoDistProbabilities1Test)
     for (size_t i = 0; i < N; i++)
     {
       if (i % 2 == 0)
-        rdata(j, i) = dist(math::randGen);
+        rdata(j, i) = dist(math::RandGen());
       else
-        rdata(j, i) = dist2(math::randGen);
+        rdata(j, i) = dist2(math::RandGen());
     }
   }
 
@@ -841,7 +841,7 @@ BOOST_AUTO_TEST_CASE(GammaDistributionFittingTest)
   arma::mat rdata(d, N);
   for (size_t j = 0; j < d; ++j)
     for (size_t i = 0; i < N; ++i)
-      rdata(j, i) = dist(math::randGen);
+      rdata(j, i) = dist(math::RandGen());
 
   // Create Gamma object and call Train() on reference set.
   GammaDistribution gDist;
@@ -862,7 +862,7 @@ BOOST_AUTO_TEST_CASE(GammaDistributionFittingTest)
   arma::mat rdata2(d, N);
   for (size_t j = 0; j < d; ++j)
     for (size_t i = 0; i < N; ++i)
-      rdata2(j, i) = dist2(math::randGen);
+      rdata2(j, i) = dist2(math::RandGen());
 
   // Create Gamma object and call Train() on reference set.
   GammaDistribution gDist2;
@@ -1176,6 +1176,37 @@ BOOST_AUTO_TEST_CASE(LaplaceDistributionLogProbabilityTest)
     1e-5);
 }
 
+/**
+ * The batched RegressionDistribution evaluation overloads must agree with the
+ * single-observation ones.
+ */
+BOOST_AUTO_TEST_CASE(RegressionDistributionBatchedProbabilityTest)
+{
+  // Generate some random data and fit a regression distribution.
+  arma::mat data;
+  data.randn(5, 300);
+  arma::rowvec responses;
+  responses.randn(300);
+
+  RegressionDistribution rd(data, responses);
+
+  arma::mat observations = arma::join_cols(responses, data);
+
+  arma::vec probabilities, logProbabilities;
+  rd.Probability(observations, probabilities);
+  rd.LogProbability(observations, logProbabilities);
+
+  BOOST_REQUIRE_EQUAL(probabilities.n_elem, observations.n_cols);
+  BOOST_REQUIRE_EQUAL(logProbabilities.n_elem, observations.n_cols);
+  for (size_t i = 0; i < observations.n_cols; ++i)
+  {
+    BOOST_REQUIRE_CLOSE(probabilities(i),
+        rd.Probability(observations.unsafe_col(i)), 1e-5);
+    BOOST_REQUIRE_CLOSE(logProbabilities(i),
+        rd.LogProbability(observations.unsafe_col(i)), 1e-5);
+  }
+}
+
 /**
  * Mahalanobis Distance serialization test.
  */
@@ -445,6 +445,375 @@ BOOST_AUTO_TEST_CASE(SerializationTest)
       binaryPredictions);
 }
 
+/**
+ * Test that a compiled inference plan produces the same predictions as the
+ * regular dispatch path.
+ */
+BOOST_AUTO_TEST_CASE(CompiledPredictTest)
+{
+  // Load the dataset.
+  arma::mat trainData;
+  data::Load("thyroid_train.csv", trainData, true);
+
+  arma::mat trainLabels = trainData.row(trainData.n_rows - 1);
+  trainData.shed_row(trainData.n_rows - 1);
+
+  arma::mat testData;
+  data::Load("thyroid_test.csv", testData, true);
+  testData.shed_row(testData.n_rows - 1);
+
+  FFN<NegativeLogLikelihood<> > model;
+  model.Add<Linear<> >(trainData.n_rows, 8);
+  model.Add<SigmoidLayer<> >();
+  model.Add<Linear<> >(8, 3);
+  model.Add<LogSoftMax<> >();
+
+  ens::RMSProp opt(0.01, 32, 0.88, 1e-8, trainData.n_cols /* 1 epoch */, -1);
+  model.Train(trainData, trainLabels, opt);
+
+  arma::mat predictions;
+  model.Predict(testData, predictions);
+
+  // Compiling must not change the predictions, only how they are computed.
+  model.Compile();
+  BOOST_REQUIRE(model.Compiled());
+
+  arma::mat compiledPredictions;
+  model.Predict(testData, compiledPredictions);
+  CheckMatrices(predictions, compiledPredictions);
+
+  // Adding a layer invalidates the plan.
+  model.Add<LogSoftMax<> >();
+  BOOST_REQUIRE(!model.Compiled());
+}
+
+/**
+ * Test that finalizing a model for inference repacks the weights without
+ * changing the predictions, and that the repacked layout is a snapshot of the
+ * weights at finalization time.
+ */
+BOOST_AUTO_TEST_CASE(OptimizeForInferenceTest)
+{
+  arma::mat input = arma::randu(10, 16);
+
+  FFN<NegativeLogLikelihood<> > model;
+  model.Add<Linear<> >(10, 8);
+  model.Add<SigmoidLayer<> >();
+  model.Add<LinearNoBias<> >(8, 2);
+  model.Add<LogSoftMax<> >();
+  model.ResetParameters();
+
+  arma::mat predictions;
+  model.Predict(input, predictions);
+
+  // Repacking must not change the predictions, only the weight layout.
+  model.OptimizeForInference();
+  BOOST_REQUIRE(model.Compiled());
+
+  arma::mat packedPredictions;
+  model.Predict(input, packedPredictions);
+  CheckMatrices(predictions, packedPredictions);
+
+  // The repacked layout is a snapshot: overwriting the shared parameter
+  // matrix must not reach the packed weights.
+  model.Parameters().zeros();
+  model.Predict(input, packedPredictions);
+  CheckMatrices(predictions, packedPredictions);
+
+  // Finalizing again picks up the new parameter values.
+  model.OptimizeForInference();
+  arma::mat zeroPredictions;
+  model.Predict(input, zeroPredictions);
+  BOOST_REQUIRE_GT(arma::abs(predictions - zeroPredictions).max(), 1e-8);
+}
+
+/**
+ * Test that laying the activations out in a shared arena does not change the
+ * network output.
+ */
+BOOST_AUTO_TEST_CASE(MemoryPlanTest)
+{
+  // Load the dataset.
+  arma::mat trainData;
+  data::Load("thyroid_train.csv", trainData, true);
+
+  arma::mat trainLabels = trainData.row(trainData.n_rows - 1);
+  trainData.shed_row(trainData.n_rows - 1);
+
+  arma::mat testData;
+  data::Load("thyroid_test.csv", testData, true);
+  testData.shed_row(testData.n_rows - 1);
+
+  FFN<NegativeLogLikelihood<> > model;
+  model.Add<Linear<> >(trainData.n_rows, 8);
+  model.Add<SigmoidLayer<> >();
+  model.Add<Linear<> >(8, 3);
+  model.Add<LogSoftMax<> >();
+
+  ens::RMSProp opt(0.01, 32, 0.88, 1e-8, trainData.n_cols /* 1 epoch */, -1);
+  model.Train(trainData, trainLabels, opt);
+
+  arma::mat predictions;
+  model.Predict(testData, predictions);
+
+  // The training-mode plan keeps all buffers distinct, so training must still
+  // produce valid results afterwards.
+  model.PlanMemory(trainData.cols(0, 31));
+  model.Train(trainData, trainLabels, opt);
+
+  // The inference-only plan shares activation slots between non-overlapping
+  // layers; the predictions must not change.
+  arma::mat plannedPredictions;
+  model.Predict(testData, plannedPredictions);
+
+  // Predict() forwards one column at a time, so plan for a single point.
+  model.PlanMemory(testData.col(0), true /* inferenceOnly */);
+  arma::mat arenaPredictions;
+  model.Predict(testData, arenaPredictions);
+  CheckMatrices(plannedPredictions, arenaPredictions);
+}
+
+/**
+ * Test that the automatically planned training workspace is reused across
+ * optimizer steps, survives batch-shape changes, and can be released with
+ * ResetWorkspace() without changing any results.
+ */
+BOOST_AUTO_TEST_CASE(WorkspaceReuseTest)
+{
+  arma::mat input = arma::randu(10, 64);
+  arma::mat target = arma::floor(2 * arma::randu(1, 64)) + 1;
+
+  FFN<NegativeLogLikelihood<> > model;
+  model.Predictors() = input;
+  model.Responses() = target;
+  model.Add<Linear<> >(10, 8);
+  model.Add<SigmoidLayer<> >();
+  model.Add<Linear<> >(8, 2);
+  model.Add<LogSoftMax<> >();
+  model.ResetParameters();
+
+  // The first step plans the workspace for this batch shape; the second step
+  // reuses the planned buffers and must produce identical results.
+  arma::mat firstGradient, secondGradient;
+  const double firstLoss = model.EvaluateWithGradient(model.Parameters(), 0,
+      firstGradient, 32);
+  const double secondLoss = model.EvaluateWithGradient(model.Parameters(), 0,
+      secondGradient, 32);
+  BOOST_REQUIRE_CLOSE(firstLoss, secondLoss, 1e-10);
+  CheckMatrices(firstGradient, secondGradient);
+
+  // A different batch shape triggers a transparent re-plan; two evaluations
+  // of the new shape must agree with each other.
+  arma::mat smallGradientA, smallGradientB;
+  const double smallLossA = model.EvaluateWithGradient(model.Parameters(), 0,
+      smallGradientA, 16);
+  const double smallLossB = model.EvaluateWithGradient(model.Parameters(), 0,
+      smallGradientB, 16);
+  BOOST_REQUIRE_CLOSE(smallLossA, smallLossB, 1e-10);
+  CheckMatrices(smallGradientA, smallGradientB);
+
+  // Releasing the workspace and evaluating again must reproduce the original
+  // results exactly.
+  model.ResetWorkspace();
+  arma::mat resetGradient;
+  const double resetLoss = model.EvaluateWithGradient(model.Parameters(), 0,
+      resetGradient, 32);
+  BOOST_REQUIRE_CLOSE(firstLoss, resetLoss, 1e-10);
+  CheckMatrices(firstGradient, resetGradient);
+}
+
+/**
+ * Test that splitting a mini-batch across worker networks produces the same
+ * loss and gradient as the serial evaluation.
+ */
+BOOST_AUTO_TEST_CASE(ParallelGradientTest)
+{
+  arma::mat input = arma::randu(10, 32);
+  arma::mat target = arma::floor(2 * arma::randu(1, 32)) + 1;
+
+  FFN<NegativeLogLikelihood<> > model;
+  model.Predictors() = input;
+  model.Responses() = target;
+  model.Add<Linear<> >(10, 8);
+  model.Add<SigmoidLayer<> >();
+  model.Add<Linear<> >(8, 2);
+  model.Add<LogSoftMax<> >();
+  model.ResetParameters();
+
+  arma::mat serialGradient, parallelGradient;
+  const double serialLoss = model.EvaluateWithGradient(model.Parameters(), 0,
+      serialGradient, 32);
+
+  // The partial losses and gradients are summed over the chunks, so up to
+  // floating-point reordering the results must match the serial path.
+  model.Parallelism() = 4;
+  const double parallelLoss = model.EvaluateWithGradient(model.Parameters(), 0,
+      parallelGradient, 32);
+
+  BOOST_REQUIRE_CLOSE(serialLoss, parallelLoss, 1e-5);
+  CheckMatrices(serialGradient, parallelGradient);
+
+  // Training through the optimizer must work with the parallel path as well.
+  ens::RMSProp opt(0.01, 32, 0.88, 1e-8, 5 * input.n_cols, -1);
+  model.Train(input, target, opt);
+  BOOST_REQUIRE(model.Parameters().is_finite());
+}
+
+/**
+ * Test that a sparse input batch run through the Forward()/Backward() pair
+ * and through Predict() produces the same results as its densified copy.
+ */
+BOOST_AUTO_TEST_CASE(SparseInputTest)
+{
+  // Build a multi-hot sparse input batch.
+  arma::sp_mat input = arma::sprandu(10, 16, 0.2);
+  arma::mat denseInput(input);
+  arma::mat target = arma::floor(2 * arma::randu(1, 16)) + 1;
+
+  FFN<NegativeLogLikelihood<> > model;
+  model.Add<Linear<> >(10, 8);
+  model.Add<SigmoidLayer<> >();
+  model.Add<Linear<> >(8, 2);
+  model.Add<LogSoftMax<> >();
+  model.ResetParameters();
+
+  // The forward pass must match the dense path; only the first layer sees
+  // the sparse input, so the remaining activations are identical.
+  arma::mat denseOutput, sparseOutput;
+  model.Forward(denseInput, denseOutput);
+  model.Forward(input, sparseOutput);
+  CheckMatrices(denseOutput, sparseOutput);
+
+  // The backward pass must produce the same loss and gradient.
+  arma::mat denseGradient, sparseGradient;
+  model.Forward(denseInput, denseOutput);
+  const double denseLoss = model.Backward(denseInput, target, denseGradient);
+  model.Forward(input, sparseOutput);
+  const double sparseLoss = model.Backward(input, target, sparseGradient);
+  BOOST_REQUIRE_CLOSE(denseLoss, sparseLoss, 1e-5);
+  CheckMatrices(denseGradient, sparseGradient);
+
+  // Predict() must accept the sparse batch directly.
+  arma::mat densePredictions, sparsePredictions;
+  model.Predict(denseInput, densePredictions);
+  model.Predict(input, sparsePredictions);
+  CheckMatrices(densePredictions, sparsePredictions);
+}
+
+/**
+ * Test that the opt-in per-layer profiler records forward/backward times and
+ * forward statistics for every layer, and that the summary table lists one
+ * row per layer.
+ */
+BOOST_AUTO_TEST_CASE(LayerProfilerTest)
+{
+  arma::mat input = arma::randu(10, 16);
+  arma::mat target = arma::floor(2 * arma::randu(1, 16)) + 1;
+
+  FFN<NegativeLogLikelihood<> > model;
+  model.Add<Linear<> >(10, 8);
+  model.Add<SigmoidLayer<> >();
+  model.Add<Linear<> >(8, 2);
+  model.Add<LogSoftMax<> >();
+  model.ResetParameters();
+
+  // The per-layer timers only accumulate while timing is enabled.
+  Timer::EnableTiming();
+  model.Profiler().Enabled() = true;
+
+  arma::mat output, gradient;
+  model.Forward(input, output);
+  model.Backward(input, target, gradient);
+
+  model.Profiler().Enabled() = false;
+  Timer::DisableTiming();
+
+  // Every layer must have a forward timer; the dispatch itself may be faster
+  // than the timer resolution, so only check that the timers exist by name.
+  for (size_t i = 0; i < 4; ++i)
+  {
+    BOOST_REQUIRE_EQUAL(model.Profiler().TimerName(i, "forward"),
+        "ffn_layer_" + std::to_string(i) + "_forward");
+  }
+
+  // The summary table lists one row per layer.
+  std::ostringstream summary;
+  model.ProfileSummary(summary);
+  const std::string table = summary.str();
+  BOOST_REQUIRE(table.find("linear") != std::string::npos);
+  BOOST_REQUIRE(table.find("logsoftmax") != std::string::npos);
+
+  // When disabled, the instrumentation must not record anything further.
+  const std::string before = table;
+  model.Forward(input, output);
+  std::ostringstream summaryAfter;
+  model.ProfileSummary(summaryAfter);
+  BOOST_REQUIRE_EQUAL(before, summaryAfter.str());
+
+  Timer::ResetAll();
+}
+
+/**
+ * Test that the prefetching data loader delivers every chunk exactly once and
+ * that the network can train on the streamed chunks.
+ */
+BOOST_AUTO_TEST_CASE(PrefetchingDataLoaderTest)
+{
+  // With a single worker the chunks must arrive in production order.
+  size_t produced = 0;
+  PrefetchingDataLoader<> loader([&produced](arma::mat& predictors,
+      arma::mat& responses)
+  {
+    if (produced >= 4)
+      return false;
+
+    predictors = arma::mat(1, 1);
+    predictors.fill((double) produced);
+    responses = predictors;
+    ++produced;
+    return true;
+  });
+
+  arma::mat chunkPredictors, chunkResponses;
+  for (size_t i = 0; i < 4; ++i)
+  {
+    BOOST_REQUIRE(loader.Next(chunkPredictors, chunkResponses));
+    BOOST_REQUIRE_EQUAL((size_t) chunkPredictors(0, 0), i);
+    BOOST_REQUIRE_EQUAL((size_t) chunkResponses(0, 0), i);
+  }
+
+  BOOST_REQUIRE(!loader.Next(chunkPredictors, chunkResponses));
+  BOOST_REQUIRE(loader.Exhausted());
+
+  // Train on streamed chunks; the chunk function is called serially by the
+  // single worker, so a plain counter is safe.
+  size_t trainChunks = 0;
+  PrefetchingDataLoader<> trainLoader([&trainChunks](arma::mat& predictors,
+      arma::mat& responses)
+  {
+    if (trainChunks >= 4)
+      return false;
+
+    predictors = arma::randu(10, 32);
+    responses = arma::floor(2 * arma::randu(1, 32)) + 1;
+    ++trainChunks;
+    return true;
+  });
+
+  FFN<NegativeLogLikelihood<> > model;
+  model.Add<Linear<> >(10, 8);
+  model.Add<SigmoidLayer<> >();
+  model.Add<Linear<> >(8, 2);
+  model.Add<LogSoftMax<> >();
+
+  ens::RMSProp opt(0.01, 32, 0.88, 1e-8, 32 /* one pass per chunk */, -1);
+  model.Train(trainLoader, opt);
+
+  BOOST_REQUIRE_EQUAL(trainChunks, 4);
+  BOOST_REQUIRE(trainLoader.Exhausted());
+  BOOST_REQUIRE(model.Parameters().is_finite());
+}
+
 /**
  * Test if the custom layers work. The target is to see if the code compiles
  * when the Train and Prediction are called.
@@ -14,8 +14,10 @@
 
 #include <mlpack/methods/gmm/gmm.hpp>
 #include <mlpack/methods/gmm/diagonal_gmm.hpp>
+#include <mlpack/methods/gmm/tree_em_fit.hpp>
 
 #include <mlpack/methods/gmm/no_constraint.hpp>
+#include <mlpack/methods/gmm/online_gmm_fit.hpp>
 #include <mlpack/methods/gmm/positive_definite_constraint.hpp>
 #include <mlpack/methods/gmm/diagonal_constraint.hpp>
 #include <mlpack/methods/gmm/eigenvalue_ratio_constraint.hpp>
@@ -47,6 +49,36 @@ BOOST_AUTO_TEST_CASE(GMMProbabilityTest)
   BOOST_REQUIRE_CLOSE(gmm.Probability("1.4 0"), 0.024676682176, 1e-5);
 }
 
+/**
+ * Test that the batched GMM::Probability() overload agrees with the
+ * single-observation overload.
+ */
+BOOST_AUTO_TEST_CASE(GMMBatchedProbabilityTest)
+{
+  // Create a GMM.
+  GMM gmm(2, 2);
+  gmm.Component(0) = distribution::GaussianDistribution("0 0", "1 0; 0 1");
+  gmm.Component(1) = distribution::GaussianDistribution("3 3", "2 1; 1 2");
+  gmm.Weights() = "0.3 0.7";
+
+  arma::mat observations = "0 1 2 3 -1 1.4;"
+                           "0 1 2 3 5.3 0";
+
+  arma::vec probabilities, logProbabilities;
+  gmm.Probability(observations, probabilities);
+  gmm.LogProbability(observations, logProbabilities);
+
+  BOOST_REQUIRE_EQUAL(probabilities.n_elem, observations.n_cols);
+  BOOST_REQUIRE_EQUAL(logProbabilities.n_elem, observations.n_cols);
+  for (size_t i = 0; i < observations.n_cols; ++i)
+  {
+    BOOST_REQUIRE_CLOSE(probabilities(i),
+        gmm.Probability(observations.unsafe_col(i)), 1e-5);
+    BOOST_REQUIRE_CLOSE(logProbabilities(i),
+        gmm.LogProbability(observations.unsafe_col(i)), 1e-5);
+  }
+}
+
 /**
  * Test GMM::Probability() for a single observation being from a particular
  * component.
@@ -284,6 +316,60 @@ BOOST_AUTO_TEST_CASE(GMMTrainEMSingleGaussianWithProbability)
   BOOST_REQUIRE_CLOSE(g.Weights()[0], 1.0, 1e-5);
 }
 
+/**
+ * Train a low-dimensional multi-Gaussian mixture with the tree-accelerated
+ * fitter and make sure the components are recovered.
+ */
+BOOST_AUTO_TEST_CASE(GMMTrainTreeEMMultipleGaussians)
+{
+  // Low dimensionality, well-separated components: the regime the tree-based
+  // E-step is designed for.
+  const size_t dims = 3;
+  const size_t gaussians = 3;
+
+  // We'll run three trials, and it needs to pass during at least one trial.
+  bool success = false;
+  for (size_t trial = 0; trial < 3; ++trial)
+  {
+    std::vector<arma::vec> means(gaussians);
+    means[0] = arma::vec("0 0 0");
+    means[1] = arma::vec("10 10 10");
+    means[2] = arma::vec("-10 5 -5");
+
+    arma::mat data(dims, 1500);
+    for (size_t i = 0; i < data.n_cols; ++i)
+    {
+      data.col(i) = means[i % gaussians] +
+          arma::randn<arma::vec>(dims);
+    }
+
+    GMM gmm(gaussians, dims);
+    gmm.Train(data, 1, false, TreeEMFit<>());
+
+    // Every true mean should be close to some estimated component mean.
+    success = true;
+    for (size_t i = 0; i < gaussians; ++i)
+    {
+      double best = DBL_MAX;
+      for (size_t j = 0; j < gaussians; ++j)
+      {
+        best = std::min(best,
+            arma::norm(gmm.Component(j).Mean() - means[i]));
+      }
+      success &= (best < 0.5);
+    }
+
+    // All weights should be near 1/3.
+    for (size_t j = 0; j < gaussians; ++j)
+      success &= (std::abs(gmm.Weights()[j] - (1.0 / gaussians)) < 0.1);
+
+    if (success)
+      break;
+  }
+
+  BOOST_REQUIRE_EQUAL(success, true);
+}
+
 /**
  * Train a multi-Gaussian mixture, using the overload of Train() where
  * probabilities of the observation are given.
@@ -1181,4 +1267,107 @@ BOOST_AUTO_TEST_CASE(DiagonalGMMLoadSaveTest)
   }
 }
 
+/**
+ * Make sure that streaming mini-batches from a stationary mixture through
+ * OnlineGMMFit recovers the mixture.
+ */
+BOOST_AUTO_TEST_CASE(OnlineGMMFitStationaryTest)
+{
+  // Two well-separated Gaussians.
+  distribution::GaussianDistribution d1("0.0 0.0", "1.0 0.3; 0.3 1.0");
+  distribution::GaussianDistribution d2("8.0 8.0", "1.5 0.0; 0.0 0.5");
+  const double weight1 = 0.4;
+
+  GMM gmm(2, 2);
+  OnlineGMMFit<> fit(0.1);
+
+  // Stream mini-batches drawn from the mixture; the first batch seeds the
+  // model with batch EM and the rest perform stepwise EM updates.
+  for (size_t batchIndex = 0; batchIndex < 50; ++batchIndex)
+  {
+    arma::mat batch(2, 200);
+    for (size_t i = 0; i < batch.n_cols; ++i)
+    {
+      if (math::Random() < weight1)
+        batch.col(i) = d1.Random();
+      else
+        batch.col(i) = d2.Random();
+    }
+
+    fit.Update(batch, gmm);
+  }
+
+  BOOST_REQUIRE_EQUAL(fit.Initialized(), true);
+
+  // Identify which component landed on which true Gaussian.
+  const size_t first =
+      (arma::norm(gmm.Component(0).Mean() - d1.Mean()) <
+       arma::norm(gmm.Component(1).Mean() - d1.Mean())) ? 0 : 1;
+  const size_t second = 1 - first;
+
+  BOOST_REQUIRE_LT(arma::norm(gmm.Component(first).Mean() - d1.Mean()), 0.35);
+  BOOST_REQUIRE_LT(arma::norm(gmm.Component(second).Mean() - d2.Mean()), 0.35);
+  BOOST_REQUIRE_LT(std::abs(gmm.Weights()[first] - weight1), 0.1);
+  BOOST_REQUIRE_LT(arma::norm(gmm.Component(first).Covariance() -
+      d1.Covariance(), "fro"), 0.6);
+  BOOST_REQUIRE_LT(arma::norm(gmm.Component(second).Covariance() -
+      d2.Covariance(), "fro"), 0.6);
+}
+
+/**
+ * When the underlying distribution drifts, the exponentially-forgotten
+ * statistics should track it: after enough batches from the new distribution,
+ * the old one is forgotten.
+ */
+BOOST_AUTO_TEST_CASE(OnlineGMMFitDriftTest)
+{
+  distribution::GaussianDistribution oldDist("0.0 0.0", "1.0 0.0; 0.0 1.0");
+  distribution::GaussianDistribution newDist("5.0 5.0", "1.0 0.0; 0.0 1.0");
+
+  GMM gmm(1, 2);
+  OnlineGMMFit<> fit(0.2);
+
+  // Seed and settle on the old distribution.
+  for (size_t batchIndex = 0; batchIndex < 10; ++batchIndex)
+  {
+    arma::mat batch(2, 200);
+    for (size_t i = 0; i < batch.n_cols; ++i)
+      batch.col(i) = oldDist.Random();
+    fit.Update(batch, gmm);
+  }
+
+  BOOST_REQUIRE_LT(arma::norm(gmm.Component(0).Mean() - oldDist.Mean()), 0.5);
+
+  // Now drift: stream batches from the new distribution.  The average batch
+  // log-likelihood should drop sharply on the first drifted batch.
+  double settledLikelihood = 0.0;
+  {
+    arma::mat batch(2, 200);
+    for (size_t i = 0; i < batch.n_cols; ++i)
+      batch.col(i) = oldDist.Random();
+    settledLikelihood = fit.Update(batch, gmm);
+  }
+
+  arma::mat driftBatch(2, 200);
+  for (size_t i = 0; i < driftBatch.n_cols; ++i)
+    driftBatch.col(i) = newDist.Random();
+  const double driftedLikelihood = fit.Update(driftBatch, gmm);
+  BOOST_REQUIRE_LT(driftedLikelihood, settledLikelihood - 1.0);
+
+  for (size_t batchIndex = 0; batchIndex < 40; ++batchIndex)
+  {
+    arma::mat batch(2, 200);
+    for (size_t i = 0; i < batch.n_cols; ++i)
+      batch.col(i) = newDist.Random();
+    fit.Update(batch, gmm);
+  }
+
+  // The old distribution should be forgotten by now.
+  BOOST_REQUIRE_LT(arma::norm(gmm.Component(0).Mean() - newDist.Mean()), 0.5);
+
+  // After a reset, the statistics are gone and the next batch re-seeds.
+  fit.Reset();
+  BOOST_REQUIRE_EQUAL(fit.Initialized(), false);
+}
+
 BOOST_AUTO_TEST_SUITE_END();
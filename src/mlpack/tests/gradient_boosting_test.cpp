@@ -0,0 +1,161 @@
+/**
+ * @file tests/gradient_boosting_test.cpp
+ *
+ * Tests for the GradientBoosting class and the pieces it is built on.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#include <mlpack/core.hpp>
+#include <mlpack/methods/gradient_boosting/gradient_boosting.hpp>
+
+#include <boost/test/unit_test.hpp>
+#include "test_tools.hpp"
+#include "serialization.hpp"
+
+using namespace mlpack;
+using namespace mlpack::tree;
+
+BOOST_AUTO_TEST_SUITE(GradientBoostingTest);
+
+/**
+ * Make sure an untrained model refuses to classify.
+ */
+BOOST_AUTO_TEST_CASE(GradientBoostingUntrainedClassifyTest)
+{
+  GradientBoosting gb;
+
+  arma::mat points(10, 100, arma::fill::randu);
+  arma::Row<size_t> predictions;
+  BOOST_REQUIRE_THROW(gb.Classify(points, predictions),
+      std::invalid_argument);
+}
+
+/**
+ * Make sure a model trained on the vc2 dataset generalizes to a held-out test
+ * set, and that the probabilities it returns are valid.
+ */
+BOOST_AUTO_TEST_CASE(GradientBoostingVC2Test)
+{
+  // Load the vc2 dataset.
+  arma::mat dataset;
+  data::Load("vc2.csv", dataset);
+  arma::Row<size_t> labels;
+  data::Load("vc2_labels.txt", labels);
+
+  GradientBoosting gb(dataset, labels, 3, 50, 0.2, 4, 5);
+
+  // Get performance statistics on test data.
+  arma::mat testDataset;
+  data::Load("vc2_test.csv", testDataset);
+  arma::Row<size_t> testLabels;
+  data::Load("vc2_test_labels.txt", testLabels);
+
+  arma::Row<size_t> predictions;
+  arma::mat probabilities;
+  gb.Classify(testDataset, predictions, probabilities);
+
+  BOOST_REQUIRE_EQUAL(predictions.n_elem, testDataset.n_cols);
+  BOOST_REQUIRE_EQUAL(probabilities.n_rows, 3);
+  BOOST_REQUIRE_EQUAL(probabilities.n_cols, testDataset.n_cols);
+
+  size_t correct = 0;
+  for (size_t i = 0; i < testDataset.n_cols; ++i)
+  {
+    if (predictions[i] == testLabels[i])
+      ++correct;
+
+    // The probabilities of each point must sum to one, and the prediction
+    // must be the most probable class.
+    BOOST_REQUIRE_CLOSE(arma::accu(probabilities.col(i)), 1.0, 1e-5);
+    BOOST_REQUIRE_EQUAL(predictions[i],
+        (size_t) probabilities.col(i).index_max());
+  }
+
+  // The model should achieve at least 75% accuracy on the test set.
+  BOOST_REQUIRE_GT(double(correct) / double(testDataset.n_cols), 0.75);
+}
+
+/**
+ * Make sure more boosting rounds do not increase the training loss, and that
+ * Train() reports a decreasing log-loss as capacity grows.
+ */
+BOOST_AUTO_TEST_CASE(GradientBoostingTrainingLossTest)
+{
+  // Load the vc2 dataset.
+  arma::mat dataset;
+  data::Load("vc2.csv", dataset);
+  arma::Row<size_t> labels;
+  data::Load("vc2_labels.txt", labels);
+
+  GradientBoosting gb;
+  const double lossSmall = gb.Train(dataset, labels, 3, 5, 0.2, 4, 5);
+  const double lossLarge = gb.Train(dataset, labels, 3, 50, 0.2, 4, 5);
+
+  BOOST_REQUIRE_GT(lossSmall, 0.0);
+  BOOST_REQUIRE_GT(lossLarge, 0.0);
+  BOOST_REQUIRE_LT(lossLarge, lossSmall);
+}
+
+/**
+ * Make sure row and column subsampling still produce a usable model.
+ */
+BOOST_AUTO_TEST_CASE(GradientBoostingSubsamplingTest)
+{
+  // Load the vc2 dataset.
+  arma::mat dataset;
+  data::Load("vc2.csv", dataset);
+  arma::Row<size_t> labels;
+  data::Load("vc2_labels.txt", labels);
+
+  GradientBoosting gb(dataset, labels, 3, 50, 0.2, 4, 5, 1e-7, 0.7, 0.7);
+
+  arma::Row<size_t> predictions;
+  gb.Classify(dataset, predictions);
+
+  size_t correct = 0;
+  for (size_t i = 0; i < dataset.n_cols; ++i)
+    if (predictions[i] == labels[i])
+      ++correct;
+
+  BOOST_REQUIRE_GT(double(correct) / double(dataset.n_cols), 0.7);
+}
+
+/**
+ * Make sure we can serialize a gradient boosting model.
+ */
+BOOST_AUTO_TEST_CASE(GradientBoostingSerializationTest)
+{
+  // Load the vc2 dataset.
+  arma::mat dataset;
+  data::Load("vc2.csv", dataset);
+  arma::Row<size_t> labels;
+  data::Load("vc2_labels.txt", labels);
+
+  GradientBoosting gb(dataset, labels, 3, 10, 0.2, 4, 5);
+
+  arma::Row<size_t> beforePredictions;
+  arma::mat beforeProbabilities;
+  gb.Classify(dataset, beforePredictions, beforeProbabilities);
+
+  GradientBoosting xmlGb, textGb, binaryGb;
+  binaryGb.Train(dataset, labels, 3, 3, 0.5, 3, 5);
+  SerializeObjectAll(gb, xmlGb, textGb, binaryGb);
+
+  // Now check that we get the same results serializing other things.
+  arma::Row<size_t> xmlPredictions, textPredictions, binaryPredictions;
+  arma::mat xmlProbabilities, textProbabilities, binaryProbabilities;
+
+  xmlGb.Classify(dataset, xmlPredictions, xmlProbabilities);
+  textGb.Classify(dataset, textPredictions, textProbabilities);
+  binaryGb.Classify(dataset, binaryPredictions, binaryProbabilities);
+
+  CheckMatrices(beforePredictions, xmlPredictions, textPredictions,
+      binaryPredictions);
+  CheckMatrices(beforeProbabilities, xmlProbabilities, textProbabilities,
+      binaryProbabilities);
+}
+
+BOOST_AUTO_TEST_SUITE_END();
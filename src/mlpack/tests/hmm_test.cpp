@@ -107,6 +107,51 @@ BOOST_AUTO_TEST_CASE(BorodovskyHMMTestViterbi)
   BOOST_REQUIRE_EQUAL(states[8], 2);
 }
 
+/**
+ * Beam-pruned Viterbi decoding should agree with exact decoding whenever the
+ * beam is wide enough, and a full-width beam must be exactly equivalent.
+ */
+BOOST_AUTO_TEST_CASE(BeamPredictTest)
+{
+  // A chain of five states where each state strongly prefers its own emission
+  // symbol and transitions to itself or its successor; the exact Viterbi path
+  // survives even a narrow beam.
+  const size_t states = 5;
+  arma::vec initial("1 0 0 0 0");
+  arma::mat transition("0.7 0.0 0.0 0.0 0.0;"
+                       "0.3 0.7 0.0 0.0 0.0;"
+                       "0.0 0.3 0.7 0.0 0.0;"
+                       "0.0 0.0 0.3 0.7 0.0;"
+                       "0.0 0.0 0.0 0.3 1.0");
+  std::vector<DiscreteDistribution> emission(states);
+  for (size_t i = 0; i < states; ++i)
+  {
+    arma::vec probs(states);
+    probs.fill(0.05);
+    probs[i] = 0.8;
+    emission[i] = DiscreteDistribution(std::vector<arma::vec>{probs});
+  }
+
+  HMM<DiscreteDistribution> hmm(initial, transition, emission);
+
+  arma::mat observation("0 0 0 1 1 2 2 2 3 3 4 4 4 4");
+
+  arma::Row<size_t> exactSeq, beamSeq, fullBeamSeq;
+  const double exactLogLik = hmm.Predict(observation, exactSeq);
+  const double beamLogLik = hmm.Predict(observation, beamSeq, 2);
+  const double fullBeamLogLik = hmm.Predict(observation, fullBeamSeq, states);
+
+  // A beam covering every state must reduce to exact Viterbi.
+  BOOST_REQUIRE_CLOSE(exactLogLik, fullBeamLogLik, 1e-10);
+  for (size_t t = 0; t < observation.n_cols; ++t)
+    BOOST_REQUIRE_EQUAL(exactSeq[t], fullBeamSeq[t]);
+
+  // A narrow beam recovers the same path on this well-separated model.
+  BOOST_REQUIRE_CLOSE(exactLogLik, beamLogLik, 1e-10);
+  for (size_t t = 0; t < observation.n_cols; ++t)
+    BOOST_REQUIRE_EQUAL(exactSeq[t], beamSeq[t]);
+}
+
 /**
  * Ensure that the forward-backward algorithm is correct.
  */
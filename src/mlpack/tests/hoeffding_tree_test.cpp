@@ -935,6 +935,89 @@ BOOST_AUTO_TEST_CASE(BinaryNumericHoeffdingTreeTest)
 /**
  * Test majority probabilities.
  */
+/**
+ * Make sure ResetSubtree() reverts a split node to a trainable leaf.
+ */
+BOOST_AUTO_TEST_CASE(ResetSubtreeTest)
+{
+  // Generate simple two-class separable data.
+  arma::mat dataset(2, 4000);
+  arma::Row<size_t> labels(4000);
+  data::DatasetInfo info(2); // All features are numeric.
+  for (size_t i = 0; i < 4000; i += 2)
+  {
+    dataset(0, i) = mlpack::math::Random();
+    dataset(1, i) = mlpack::math::Random() - 1.0;
+    labels[i] = 0;
+
+    dataset(0, i + 1) = mlpack::math::Random();
+    dataset(1, i + 1) = mlpack::math::Random() + 1.0;
+    labels[i + 1] = 1;
+  }
+
+  HoeffdingTree<> tree(info, 2);
+  for (size_t i = 0; i < 4000; ++i)
+    tree.Train(dataset.col(i), labels[i]);
+
+  BOOST_REQUIRE_GT(tree.NumChildren(), 0);
+
+  // Now retire the subtree; the tree should be an untrained leaf again.
+  tree.ResetSubtree();
+  BOOST_REQUIRE_EQUAL(tree.NumChildren(), 0);
+  BOOST_REQUIRE_EQUAL(tree.SplitDimension(), size_t(-1));
+
+  // The tree must be able to train back to a split from the stream.
+  for (size_t i = 0; i < 4000; ++i)
+    tree.Train(dataset.col(i), labels[i]);
+  BOOST_REQUIRE_GT(tree.NumChildren(), 0);
+}
+
+/**
+ * Test that the sliding-window drift detection mode recovers from a concept
+ * change in the stream, where a tree without drift detection stays stale.
+ */
+BOOST_AUTO_TEST_CASE(DriftDetectionTest)
+{
+  // Two-class data; the feature distributions never change, but halfway
+  // through the stream the class assignments are swapped.
+  data::DatasetInfo info(2); // All features are numeric.
+
+  arma::mat dataset(2, 4000);
+  arma::Row<size_t> labels(4000);
+  for (size_t i = 0; i < 4000; i += 2)
+  {
+    dataset(0, i) = mlpack::math::Random();
+    dataset(1, i) = mlpack::math::Random() - 1.0;
+    labels[i] = 0;
+
+    dataset(0, i + 1) = mlpack::math::Random();
+    dataset(1, i + 1) = mlpack::math::Random() + 1.0;
+    labels[i + 1] = 1;
+  }
+  const arma::Row<size_t> swappedLabels = 1 - labels;
+
+  HoeffdingTree<> tree(info, 2);
+  tree.DriftWindowSize(200);
+
+  // Stream the first concept, then the swapped concept.
+  for (size_t i = 0; i < 4000; ++i)
+    tree.Train(dataset.col(i), labels[i]);
+  for (size_t i = 0; i < 4000; ++i)
+    tree.Train(dataset.col(i), swappedLabels[i]);
+
+  // The tree should have retired the stale subtree and relearned the new
+  // concept.
+  arma::Row<size_t> predictions;
+  tree.Classify(dataset, predictions);
+
+  size_t correct = 0;
+  for (size_t i = 0; i < 4000; ++i)
+    if (predictions[i] == swappedLabels[i])
+      ++correct;
+
+  BOOST_REQUIRE_GT(correct, 3200);
+}
+
 BOOST_AUTO_TEST_CASE(MajorityProbabilityTest)
 {
   data::DatasetInfo info(1);
@@ -15,6 +15,7 @@
 #include <mlpack/core/hpt/cv_function.hpp>
 #include <mlpack/core/hpt/fixed.hpp>
 #include <mlpack/core/hpt/hpt.hpp>
+#include <mlpack/core/hpt/successive_halving.hpp>
 #include <mlpack/methods/lars/lars.hpp>
 #include <mlpack/methods/logistic_regression/logistic_regression.hpp>
 
@@ -402,4 +403,65 @@ BOOST_AUTO_TEST_CASE(HPTGradientDescentTest)
   BOOST_REQUIRE_CLOSE(zOptimized, zMin, 1e-4);
 }
 
+/**
+ * Test SuccessiveHalvingTuner finds the best configuration of a small grid
+ * (with only two candidates a single full-data round is run, so the result
+ * should agree with an exhaustive search).
+ */
+BOOST_AUTO_TEST_CASE(SuccessiveHalvingTest)
+{
+  arma::mat xs;
+  arma::rowvec ys;
+  double validationSize;
+  InitProneToOverfittingData(xs, ys, validationSize);
+
+  std::vector<bool> transposeDataSet{true};
+  std::vector<bool> useCholeskySet{false};
+  arma::vec lambda1Set("0.0 1e12");
+  arma::vec lambda2Set("0.0");
+
+  SuccessiveHalvingTuner<LARS, MSE> tuner(validationSize, xs, ys);
+
+  bool transposeData, useCholesky;
+  double lambda1, lambda2;
+  std::tie(transposeData, useCholesky, lambda1, lambda2) =
+      tuner.Optimize(transposeDataSet, useCholeskySet, lambda1Set, lambda2Set);
+
+  // The huge lambda1 should lose on this dataset.
+  BOOST_REQUIRE_CLOSE(lambda1, 0.0, 1e-5);
+  BOOST_REQUIRE_EQUAL(transposeData, true);
+  BOOST_REQUIRE_EQUAL(useCholesky, false);
+}
+
+/**
+ * Test SuccessiveHalvingTuner runs multiple elimination rounds, maximizes
+ * Accuracy rather than minimizes it, and exposes the winning model.
+ */
+BOOST_AUTO_TEST_CASE(SuccessiveHalvingMaximizationTest)
+{
+  // Initializing a linearly separable dataset that is large enough for the
+  // subsampled rounds to be informative.
+  arma::mat xs = arma::join_rows(
+      arma::randn(1, 500) - 5.0, arma::randn(1, 500) + 5.0);
+  arma::Row<size_t> ys = arma::join_rows(arma::zeros<arma::Row<size_t>>(500),
+      arma::ones<arma::Row<size_t>>(500));
+
+  // Nine candidates with eta = 3 give two rounds: a subsampled one and a full
+  // one.  Zero should be preferred since big lambdas are likely to restrict
+  // capabilities of logistic regression.
+  arma::vec lambdas("0 1 2 3 4 5 1e12 1e12 1e12");
+
+  SuccessiveHalvingTuner<LogisticRegression<>, Accuracy> tuner(0.2, xs, ys);
+
+  double actualLambda;
+  std::tie(actualLambda) = tuner.Optimize(lambdas);
+
+  BOOST_REQUIRE_LT(actualLambda, 1e12);
+  BOOST_REQUIRE_CLOSE(tuner.BestObjective(), 1.0, 1e-5);
+
+  // The exposed model should show the same performance on the separable data.
+  BOOST_REQUIRE_CLOSE(Accuracy::Evaluate(tuner.BestModel(), xs, ys), 1.0,
+      1e-5);
+}
+
 BOOST_AUTO_TEST_SUITE_END();
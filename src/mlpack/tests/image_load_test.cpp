@@ -110,6 +110,50 @@ BOOST_AUTO_TEST_CASE(LoadVectorImageAPITest)
   BOOST_REQUIRE_EQUAL(matrix.n_cols, 2);
 }
 
+/**
+ * Test that the batched loader can resize the images during decode.
+ */
+BOOST_AUTO_TEST_CASE(LoadImagesResizeTest)
+{
+  arma::Mat<unsigned char> matrix;
+  data::ImageInfo info;
+  std::vector<std::string> files = {"test_image.png", "test_image.png",
+      "test_image.png"};
+  BOOST_REQUIRE(data::LoadImages(files, matrix, info, false, 25, 20) == true);
+  // target width * target height * channels.
+  BOOST_REQUIRE_EQUAL(matrix.n_rows, 25 * 20 * 3);
+  BOOST_REQUIRE_EQUAL(matrix.n_cols, 3);
+  BOOST_REQUIRE_EQUAL(info.Width(), 25);
+  BOOST_REQUIRE_EQUAL(info.Height(), 20);
+  BOOST_REQUIRE_EQUAL(info.Channels(), 3);
+}
+
+/**
+ * Test that the batched loader writes and reuses the binary columnar decode
+ * cache.
+ */
+BOOST_AUTO_TEST_CASE(LoadImagesCacheTest)
+{
+  arma::Mat<unsigned char> matrix;
+  data::ImageInfo info;
+  std::vector<std::string> files = {"test_image.png", "test_image.png"};
+  BOOST_REQUIRE(data::LoadImages(files, matrix, info, false, 0, 0,
+      "image_cache.mbin") == true);
+
+  // The second load must come out of the cache with the same contents.
+  arma::Mat<unsigned char> cached;
+  data::ImageInfo cachedInfo;
+  BOOST_REQUIRE(data::LoadImages(files, cached, cachedInfo, false, 0, 0,
+      "image_cache.mbin") == true);
+
+  BOOST_REQUIRE_EQUAL(matrix.n_rows, cached.n_rows);
+  BOOST_REQUIRE_EQUAL(matrix.n_cols, cached.n_cols);
+  for (size_t i = 0; i < matrix.n_elem; ++i)
+    BOOST_REQUIRE_EQUAL(matrix[i], cached[i]);
+
+  remove("image_cache.mbin");
+}
+
 /**
  * Test if the image is saved correctly using API for arma mat.
  */
@@ -10,6 +10,8 @@
 #include <mlpack/core.hpp>
 
 #include <mlpack/methods/kde/kde.hpp>
+#include <mlpack/methods/kde/kde_model.hpp>
+#include <mlpack/methods/kde/random_fourier_kde.hpp>
 #include <mlpack/core/tree/binary_space_tree.hpp>
 #include <mlpack/core/tree/octree.hpp>
 #include <mlpack/core/tree/cover_tree.hpp>
@@ -164,6 +166,47 @@ BOOST_AUTO_TEST_CASE(GaussianKDEBruteForceTest)
     BOOST_REQUIRE_CLOSE(bfEstimations[i], treeEstimations[i], relError * 100);
 }
 
+/**
+ * Test that a multi-bandwidth evaluation matches brute force results for
+ * every candidate bandwidth.
+ */
+BOOST_AUTO_TEST_CASE(MultipleBandwidthsKDETest)
+{
+  arma::mat reference = arma::randu(2, 300);
+  arma::mat query = arma::randu(2, 80);
+  const arma::vec bandwidths = {0.08, 0.12, 0.35, 0.8};
+  const double relError = 0.05;
+
+  // One traversal for all candidate bandwidths.
+  metric::EuclideanDistance metric;
+  KDE<GaussianKernel,
+      metric::EuclideanDistance,
+      arma::mat,
+      tree::KDTree>
+      kde(relError, 0.0, GaussianKernel(), KDEMode::SINGLE_TREE_MODE, metric);
+  kde.Train(reference);
+  arma::mat sweepEstimations;
+  kde.EvaluateMultipleBandwidths(query, bandwidths, sweepEstimations);
+
+  BOOST_REQUIRE_EQUAL(sweepEstimations.n_rows, bandwidths.n_elem);
+  BOOST_REQUIRE_EQUAL(sweepEstimations.n_cols, query.n_cols);
+
+  // Each row must satisfy the error tolerance against brute force with that
+  // bandwidth.
+  for (size_t b = 0; b < bandwidths.n_elem; ++b)
+  {
+    arma::vec bfEstimations = arma::vec(query.n_cols, arma::fill::zeros);
+    GaussianKernel kernel(bandwidths[b]);
+    BruteForceKDE<GaussianKernel>(reference, query, bfEstimations, kernel);
+
+    for (size_t i = 0; i < query.n_cols; ++i)
+    {
+      BOOST_REQUIRE_CLOSE(bfEstimations[i], sweepEstimations(b, i),
+          relError * 100);
+    }
+  }
+}
+
 /**
  * Test single-tree implementation results against brute force results.
  */
@@ -198,6 +241,113 @@ BOOST_AUTO_TEST_CASE(GaussianSingleKDEBruteForceTest)
     BOOST_REQUIRE_CLOSE(bfEstimations[i], treeEstimations[i], relError * 100);
 }
 
+/**
+ * Test the random Fourier feature sketch against brute force results.  The
+ * sketch gives an approximate bound on the error of each kernel value, so the
+ * comparison uses an absolute tolerance a few times larger than the
+ * requested tolerance.
+ */
+BOOST_AUTO_TEST_CASE(RandomFourierKDETest)
+{
+  arma::mat reference = arma::randu(2, 300);
+  arma::mat query = arma::randu(2, 100);
+  arma::vec bfEstimations = arma::vec(query.n_cols, arma::fill::zeros);
+  arma::vec sketchEstimations = arma::vec(query.n_cols, arma::fill::zeros);
+  const double kernelBandwidth = 0.3;
+  const double relError = 0.015;
+
+  // Brute force KDE.
+  GaussianKernel kernel(kernelBandwidth);
+  BruteForceKDE<GaussianKernel>(reference,
+                                query,
+                                bfEstimations,
+                                kernel);
+
+  // Sketched KDE.
+  RandomFourierKDE<GaussianKernel> kde(relError, kernel);
+  kde.Train(reference);
+  kde.Evaluate(query, sketchEstimations);
+
+  for (size_t i = 0; i < query.n_cols; ++i)
+    BOOST_REQUIRE_SMALL(bfEstimations[i] - sketchEstimations[i], 0.05);
+}
+
+/**
+ * Test that a KDEModel built in sketch mode gives normalized estimations that
+ * match brute force results.
+ */
+BOOST_AUTO_TEST_CASE(SketchKDEModelTest)
+{
+  arma::mat reference = arma::randu(2, 300);
+  arma::mat query = arma::randu(2, 100);
+  arma::vec bfEstimations = arma::vec(query.n_cols, arma::fill::zeros);
+  arma::vec modelEstimations;
+  const double kernelBandwidth = 0.3;
+  const double relError = 0.015;
+
+  // Brute force KDE, with the kernel normalizer applied.
+  GaussianKernel kernel(kernelBandwidth);
+  BruteForceKDE<GaussianKernel>(reference,
+                                query,
+                                bfEstimations,
+                                kernel);
+  bfEstimations /= kernel.Normalizer(reference.n_rows);
+
+  // Sketched KDE model.
+  KDEModel model(kernelBandwidth, relError, 0.0,
+      KDEModel::GAUSSIAN_KERNEL, KDEModel::KD_TREE);
+  model.Sketch() = true;
+  model.BuildModel(std::move(arma::mat(reference)));
+  model.Evaluate(std::move(arma::mat(query)), modelEstimations);
+
+  for (size_t i = 0; i < query.n_cols; ++i)
+    BOOST_REQUIRE_SMALL(bfEstimations[i] - modelEstimations[i], 0.1);
+}
+
+/**
+ * Test that caching the query tree across evaluations gives the same results
+ * as rebuilding it every time, over a bandwidth sweep.
+ */
+BOOST_AUTO_TEST_CASE(QueryTreeCacheTest)
+{
+  arma::mat reference = arma::randu(2, 300);
+  arma::mat query = arma::randu(2, 100);
+  const double relError = 0.05;
+  const std::vector<double> bandwidths = { 0.1, 0.25, 0.6 };
+
+  // KDE model that caches the query tree between evaluations.
+  KDE<GaussianKernel,
+      metric::EuclideanDistance,
+      arma::mat,
+      tree::KDTree>
+      cachedKDE(relError, 0.0, GaussianKernel(bandwidths[0]));
+  cachedKDE.CacheQueryTree() = true;
+  cachedKDE.Train(reference);
+
+  for (const double bandwidth : bandwidths)
+  {
+    arma::vec cachedEstimations;
+    arma::vec freshEstimations;
+
+    // Evaluate reusing the cached query tree.
+    cachedKDE.Kernel() = GaussianKernel(bandwidth);
+    cachedKDE.Evaluate(arma::mat(query), cachedEstimations);
+
+    // Evaluate with a freshly built model.
+    KDE<GaussianKernel,
+        metric::EuclideanDistance,
+        arma::mat,
+        tree::KDTree>
+        freshKDE(relError, 0.0, GaussianKernel(bandwidth));
+    freshKDE.Train(reference);
+    freshKDE.Evaluate(arma::mat(query), freshEstimations);
+
+    for (size_t i = 0; i < query.n_cols; ++i)
+      BOOST_REQUIRE_CLOSE(cachedEstimations[i], freshEstimations[i],
+                          relError * 100);
+  }
+}
+
 /**
  * Test single-tree implementation results against brute force results using
  * a cover-tree and Epanechnikov kernel.
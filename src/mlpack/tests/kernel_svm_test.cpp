@@ -0,0 +1,246 @@
+/**
+ * @file tests/kernel_svm_test.cpp
+ *
+ * Test the KernelSVM class.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#include <mlpack/core.hpp>
+#include <mlpack/core/kernels/gaussian_kernel.hpp>
+#include <mlpack/core/kernels/linear_kernel.hpp>
+#include <mlpack/methods/kernel_svm/kernel_svm.hpp>
+
+#include <boost/test/unit_test.hpp>
+#include "test_tools.hpp"
+#include "serialization.hpp"
+
+using namespace mlpack;
+using namespace mlpack::svm;
+using namespace mlpack::kernel;
+using namespace mlpack::distribution;
+
+BOOST_AUTO_TEST_SUITE(KernelSVMTest);
+
+/**
+ * A linear kernel SVM should separate two well-separated Gaussians.
+ */
+BOOST_AUTO_TEST_CASE(KernelSVMLinearSeparableTest)
+{
+  const size_t points = 500;
+
+  GaussianDistribution g1(arma::vec("1.0 9.0 1.0"), arma::eye<arma::mat>(3, 3));
+  GaussianDistribution g2(arma::vec("4.0 3.0 4.0"), arma::eye<arma::mat>(3, 3));
+
+  arma::mat data(3, points);
+  arma::Row<size_t> labels(points);
+  for (size_t i = 0; i < points / 2; ++i)
+  {
+    data.col(i) = g1.Random();
+    labels[i] = 0;
+  }
+  for (size_t i = points / 2; i < points; ++i)
+  {
+    data.col(i) = g2.Random();
+    labels[i] = 1;
+  }
+
+  KernelSVM<LinearKernel> svm(data, labels, 1.0);
+
+  arma::Row<size_t> predictions;
+  svm.Classify(data, predictions);
+
+  size_t correct = 0;
+  for (size_t i = 0; i < points; ++i)
+    if (predictions[i] == labels[i])
+      ++correct;
+
+  BOOST_REQUIRE_GE((double) correct / points, 0.98);
+}
+
+/**
+ * A Gaussian kernel SVM should solve a problem no linear classifier can:
+ * points inside a circle against points on a ring around it.
+ */
+BOOST_AUTO_TEST_CASE(KernelSVMNonlinearTest)
+{
+  const size_t points = 400;
+
+  arma::mat data(2, points);
+  arma::Row<size_t> labels(points);
+  for (size_t i = 0; i < points / 2; ++i)
+  {
+    // Inner cluster, radius in [0, 1).
+    const double angle = math::Random(0, 2 * M_PI);
+    const double radius = math::Random(0.0, 1.0);
+    data(0, i) = radius * std::cos(angle);
+    data(1, i) = radius * std::sin(angle);
+    labels[i] = 0;
+  }
+  for (size_t i = points / 2; i < points; ++i)
+  {
+    // Surrounding ring, radius in [2, 3).
+    const double angle = math::Random(0, 2 * M_PI);
+    const double radius = math::Random(2.0, 3.0);
+    data(0, i) = radius * std::cos(angle);
+    data(1, i) = radius * std::sin(angle);
+    labels[i] = 1;
+  }
+
+  KernelSVM<GaussianKernel> svm(data, labels, 10.0, GaussianKernel(1.0));
+
+  arma::Row<size_t> predictions;
+  svm.Classify(data, predictions);
+
+  size_t correct = 0;
+  for (size_t i = 0; i < points; ++i)
+    if (predictions[i] == labels[i])
+      ++correct;
+
+  BOOST_REQUIRE_GE((double) correct / points, 0.98);
+}
+
+/**
+ * The solution must not depend on the cache size: a cache that can only hold
+ * a handful of kernel rows has to produce the same model as one holding the
+ * whole kernel matrix.
+ */
+BOOST_AUTO_TEST_CASE(KernelSVMCacheSizeTest)
+{
+  const size_t points = 200;
+
+  GaussianDistribution g1(arma::vec("0.0 0.0"), arma::eye<arma::mat>(2, 2));
+  GaussianDistribution g2(arma::vec("3.0 3.0"), arma::eye<arma::mat>(2, 2));
+
+  arma::mat data(2, points);
+  arma::Row<size_t> labels(points);
+  for (size_t i = 0; i < points / 2; ++i)
+  {
+    data.col(i) = g1.Random();
+    labels[i] = 0;
+  }
+  for (size_t i = points / 2; i < points; ++i)
+  {
+    data.col(i) = g2.Random();
+    labels[i] = 1;
+  }
+
+  // A 256 MB cache easily holds all 200 rows; a cache sized to 0 MB is
+  // clamped to the two-row minimum, so nearly every row is recomputed.
+  KernelSVM<GaussianKernel> bigCache(1.0, GaussianKernel(0.5), 256);
+  KernelSVM<GaussianKernel> tinyCache(1.0, GaussianKernel(0.5), 0);
+
+  const double bigObjective = bigCache.Train(data, labels);
+  const double tinyObjective = tinyCache.Train(data, labels);
+
+  BOOST_REQUIRE_CLOSE(bigObjective, tinyObjective, 1e-5);
+  BOOST_REQUIRE_EQUAL(bigCache.SupportVectors().n_cols,
+      tinyCache.SupportVectors().n_cols);
+  BOOST_REQUIRE_CLOSE(bigCache.Bias(), tinyCache.Bias(), 1e-5);
+}
+
+/**
+ * The trained decision function must satisfy the KKT conditions: free
+ * support vectors sit on the margin, and every dual coefficient lies in
+ * [-C, C].
+ */
+BOOST_AUTO_TEST_CASE(KernelSVMKKTTest)
+{
+  const size_t points = 200;
+  const double C = 1.0;
+
+  GaussianDistribution g1(arma::vec("0.0 0.0"), arma::eye<arma::mat>(2, 2));
+  GaussianDistribution g2(arma::vec("2.5 2.5"), arma::eye<arma::mat>(2, 2));
+
+  arma::mat data(2, points);
+  arma::Row<size_t> labels(points);
+  for (size_t i = 0; i < points / 2; ++i)
+  {
+    data.col(i) = g1.Random();
+    labels[i] = 0;
+  }
+  for (size_t i = points / 2; i < points; ++i)
+  {
+    data.col(i) = g2.Random();
+    labels[i] = 1;
+  }
+
+  KernelSVM<GaussianKernel> svm(data, labels, C, GaussianKernel(0.7));
+
+  for (size_t s = 0; s < svm.SupportVectors().n_cols; ++s)
+  {
+    BOOST_REQUIRE_LE(std::abs(svm.Coefficients()[s]), C + 1e-10);
+    BOOST_REQUIRE_GT(std::abs(svm.Coefficients()[s]), 0.0);
+  }
+
+  // Free support vectors (|coefficient| strictly inside (0, C)) must have a
+  // decision value of +/-1 up to the optimization tolerance.
+  arma::rowvec decisions;
+  svm.DecisionFunction(svm.SupportVectors(), decisions);
+  for (size_t s = 0; s < svm.SupportVectors().n_cols; ++s)
+  {
+    const double absCoef = std::abs(svm.Coefficients()[s]);
+    if (absCoef > 1e-6 && absCoef < C - 1e-6)
+      BOOST_REQUIRE_SMALL(std::abs(decisions[s]) - 1.0, 1e-2);
+  }
+}
+
+/**
+ * Invalid inputs must be rejected.
+ */
+BOOST_AUTO_TEST_CASE(KernelSVMValidationTest)
+{
+  arma::mat data(2, 10, arma::fill::randu);
+  arma::Row<size_t> badLabels(10);
+  badLabels.fill(2);
+
+  KernelSVM<LinearKernel> svm;
+  BOOST_REQUIRE_THROW(svm.Train(data, badLabels), std::invalid_argument);
+
+  arma::Row<size_t> shortLabels(5, arma::fill::zeros);
+  BOOST_REQUIRE_THROW(svm.Train(data, shortLabels), std::invalid_argument);
+}
+
+/**
+ * Test that the model can be serialized and gives identical predictions
+ * afterwards.
+ */
+BOOST_AUTO_TEST_CASE(KernelSVMSerializationTest)
+{
+  const size_t points = 100;
+
+  GaussianDistribution g1(arma::vec("0.0 0.0"), arma::eye<arma::mat>(2, 2));
+  GaussianDistribution g2(arma::vec("3.0 3.0"), arma::eye<arma::mat>(2, 2));
+
+  arma::mat data(2, points);
+  arma::Row<size_t> labels(points);
+  for (size_t i = 0; i < points / 2; ++i)
+  {
+    data.col(i) = g1.Random();
+    labels[i] = 0;
+  }
+  for (size_t i = points / 2; i < points; ++i)
+  {
+    data.col(i) = g2.Random();
+    labels[i] = 1;
+  }
+
+  KernelSVM<GaussianKernel> svm(data, labels, 1.0, GaussianKernel(0.5));
+
+  KernelSVM<GaussianKernel> xmlSvm, textSvm, binarySvm;
+  SerializeObjectAll(svm, xmlSvm, textSvm, binarySvm);
+
+  arma::Row<size_t> predictions, xmlPredictions, textPredictions,
+      binaryPredictions;
+  svm.Classify(data, predictions);
+  xmlSvm.Classify(data, xmlPredictions);
+  textSvm.Classify(data, textPredictions);
+  binarySvm.Classify(data, binaryPredictions);
+
+  CheckMatrices(predictions, xmlPredictions, textPredictions,
+      binaryPredictions);
+}
+
+BOOST_AUTO_TEST_SUITE_END();
@@ -8,12 +8,16 @@
  * http://www.opensource.org/licenses/BSD-3-Clause for more information.
  */
 #include <mlpack/core.hpp>
+#include <mlpack/core/data/shard.hpp>
 
 #include <mlpack/methods/kmeans/kmeans.hpp>
 #include <mlpack/methods/kmeans/allow_empty_clusters.hpp>
 #include <mlpack/methods/kmeans/refined_start.hpp>
+#include <mlpack/methods/kmeans/parallel_seeding.hpp>
+#include <mlpack/methods/kmeans/blocked_gemm_kmeans.hpp>
 #include <mlpack/methods/kmeans/elkan_kmeans.hpp>
 #include <mlpack/methods/kmeans/hamerly_kmeans.hpp>
+#include <mlpack/methods/kmeans/mini_batch_kmeans.hpp>
 #include <mlpack/methods/kmeans/pelleg_moore_kmeans.hpp>
 #include <mlpack/methods/kmeans/dual_tree_kmeans.hpp>
 #include <mlpack/methods/kmeans/sample_initialization.hpp>
@@ -489,6 +493,46 @@ BOOST_AUTO_TEST_CASE(RefinedStartTest)
   BOOST_REQUIRE_LT(distortion, 14000.0);
 }
 
+/**
+ * Test that the parallel seeding (k-means||) policy gives decent initial
+ * cluster estimates.
+ */
+BOOST_AUTO_TEST_CASE(ParallelSeedingTest)
+{
+  // The same five-Gaussian dataset as in the RefinedStartTest.
+  arma::mat data(3, 3000);
+  data.randn();
+
+  arma::mat centroids(" 0  5 -2 -6  1;"
+                      " 0  0 -2  8  6;"
+                      " 0 -2 -2  8  1");
+
+  for (size_t i = 1000; i < 1200; ++i)
+    data.col(i) += centroids.col(1);
+  for (size_t i = 1200; i < 1700; ++i)
+    data.col(i) += centroids.col(2);
+  for (size_t i = 1700; i < 1800; ++i)
+    data.col(i) += centroids.col(3);
+  for (size_t i = 1800; i < 3000; ++i)
+    data.col(i) += centroids.col(4);
+
+  // Run k-means with parallel seeding for the initial centroids.
+  KMeans<metric::EuclideanDistance, ParallelSeeding> kmeans;
+  arma::Row<size_t> assignments;
+  arma::mat resultingCentroids;
+  kmeans.Cluster(data, 5, assignments, resultingCentroids);
+
+  // Calculate sum of distances from centroids.
+  double distortion = 0;
+  for (size_t i = 0; i < 3000; ++i)
+    distortion += metric::EuclideanDistance::Evaluate(data.col(i),
+        resultingCentroids.col(assignments[i]));
+
+  // With a good initialization, full k-means on this dataset converges to a
+  // distortion of around 13500 (see the bound used by the RefinedStartTest).
+  BOOST_REQUIRE_LT(distortion, 14000.0);
+}
+
 #ifdef ARMA_HAS_SPMAT
 /**
  * Make sure sparse k-means works okay.
@@ -570,6 +614,70 @@ BOOST_AUTO_TEST_CASE(ElkanTest)
   }
 }
 
+BOOST_AUTO_TEST_CASE(BlockedGEMMTest)
+{
+  const size_t trials = 5;
+
+  for (size_t t = 0; t < trials; ++t)
+  {
+    arma::mat dataset(10, 1000);
+    dataset.randu();
+
+    const size_t k = 5 * (t + 1);
+    arma::mat centroids(10, k);
+    centroids.randu();
+
+    // Make sure the GEMM-based step and the naive method return the same
+    // clusters.
+    arma::mat naiveCentroids(centroids);
+    KMeans<> km;
+    arma::Row<size_t> assignments;
+    km.Cluster(dataset, k, assignments, naiveCentroids, false, true);
+
+    KMeans<metric::EuclideanDistance, RandomPartition, MaxVarianceNewCluster,
+        BlockedGEMMKMeans> gemm;
+    arma::Row<size_t> gemmAssignments;
+    arma::mat gemmCentroids(centroids);
+    gemm.Cluster(dataset, k, gemmAssignments, gemmCentroids, false, true);
+
+    for (size_t i = 0; i < dataset.n_cols; ++i)
+      BOOST_REQUIRE_EQUAL(assignments[i], gemmAssignments[i]);
+
+    for (size_t i = 0; i < centroids.n_elem; ++i)
+      BOOST_REQUIRE_CLOSE(naiveCentroids[i], gemmCentroids[i], 1e-5);
+  }
+}
+
+/**
+ * Mini-batch k-means is approximate, but on well-separated clusters it must
+ * still put every point of a natural cluster into the same cluster.
+ */
+BOOST_AUTO_TEST_CASE(MiniBatchKMeansTest)
+{
+  // The 30-point dataset has three widely separated classes, so even the
+  // sampled updates cannot confuse them.
+  KMeans<EuclideanDistance, RandomPartition, MaxVarianceNewCluster,
+      MiniBatchKMeans> kmeans;
+
+  arma::Row<size_t> assignments;
+  kmeans.Cluster((arma::mat) trans(kMeansData), 3, assignments);
+
+  size_t firstClass = assignments(0);
+  for (size_t i = 1; i < 13; i++)
+    BOOST_REQUIRE_EQUAL(assignments(i), firstClass);
+
+  size_t secondClass = assignments(13);
+  BOOST_REQUIRE_NE(firstClass, secondClass);
+  for (size_t i = 13; i < 20; i++)
+    BOOST_REQUIRE_EQUAL(assignments(i), secondClass);
+
+  size_t thirdClass = assignments(20);
+  BOOST_REQUIRE_NE(firstClass, thirdClass);
+  BOOST_REQUIRE_NE(secondClass, thirdClass);
+  for (size_t i = 20; i < 30; i++)
+    BOOST_REQUIRE_EQUAL(assignments(i), thirdClass);
+}
+
 BOOST_AUTO_TEST_CASE(HamerlyTest)
 {
   const size_t trials = 5;
@@ -703,6 +811,52 @@ BOOST_AUTO_TEST_CASE(DTNNCoverTreeTest)
   }
 }
 
+/**
+ * Make sure that reducing per-shard sufficient statistics gives exactly the
+ * same new centroids as a single Lloyd iteration over the full dataset.
+ */
+BOOST_AUTO_TEST_CASE(NaiveKMeansShardReductionTest)
+{
+  arma::mat dataset = arma::randu<arma::mat>(8, 500);
+  const size_t k = 6;
+  arma::mat centroids = arma::randu<arma::mat>(8, k);
+
+  // One iteration over the full dataset.
+  metric::EuclideanDistance metric;
+  NaiveKMeans<metric::EuclideanDistance, arma::mat> full(dataset, metric);
+  arma::mat fullCentroids;
+  arma::Col<size_t> fullCounts;
+  full.Iterate(centroids, fullCentroids, fullCounts);
+
+  // One iteration split over three shards, reducing the statistics by
+  // element-wise addition like an all-reduce would.
+  const size_t numWorkers = 3;
+  arma::mat sums(8, k, arma::fill::zeros);
+  arma::Col<size_t> counts(k, arma::fill::zeros);
+  std::vector<arma::mat> shards(numWorkers);
+  for (size_t worker = 0; worker < numWorkers; ++worker)
+  {
+    data::ShardColumns(dataset, worker, numWorkers, shards[worker]);
+    NaiveKMeans<metric::EuclideanDistance, arma::mat> shardKMeans(
+        shards[worker], metric);
+
+    arma::mat shardSums;
+    arma::Col<size_t> shardCounts;
+    shardKMeans.IterateStatistics(centroids, shardSums, shardCounts);
+
+    sums += shardSums;
+    counts += shardCounts;
+  }
+
+  NaiveKMeans<metric::EuclideanDistance, arma::mat> reducer(dataset, metric);
+  reducer.NormalizeStatistics(centroids, sums, counts);
+
+  for (size_t i = 0; i < k; ++i)
+    BOOST_REQUIRE_EQUAL(fullCounts[i], counts[i]);
+  for (size_t i = 0; i < centroids.n_elem; ++i)
+    BOOST_REQUIRE_CLOSE(fullCentroids[i], sums[i], 1e-10);
+}
+
 /**
  * Make sure that the sample initialization strategy successfully samples points
  * from the dataset.
@@ -12,6 +12,9 @@
 #include <mlpack/methods/neighbor_search/neighbor_search.hpp>
 #include <mlpack/methods/neighbor_search/unmap.hpp>
 #include <mlpack/methods/neighbor_search/ns_model.hpp>
+#include <mlpack/methods/neighbor_search/flat_ns_model.hpp>
+#include <mlpack/methods/neighbor_search/neighbor_search_session.hpp>
+#include <mlpack/methods/neighbor_search/product_quantization.hpp>
 #include <mlpack/core/tree/cover_tree.hpp>
 #include <mlpack/core/tree/example_tree.hpp>
 #include <boost/test/unit_test.hpp>
@@ -1144,6 +1147,34 @@ BOOST_AUTO_TEST_CASE(KNNModelTest)
   }
 }
 
+BOOST_AUTO_TEST_CASE(KNNModelAutoTuneTest)
+{
+  // Ensure that an auto-tuned model gives correct results, whatever
+  // configuration the calibration ends up selecting (all candidate
+  // configurations are exact).
+  typedef NSModel<NearestNeighborSort> KNNModel;
+
+  arma::mat referenceData = arma::randu<arma::mat>(5, 600);
+  arma::mat queryData = arma::randu<arma::mat>(5, 100);
+
+  KNN naive(referenceData, NAIVE_MODE);
+  arma::Mat<size_t> baselineNeighbors;
+  arma::mat baselineDistances;
+  naive.Search(queryData, 3, baselineNeighbors, baselineDistances);
+
+  KNNModel model;
+  arma::mat referenceCopy(referenceData);
+  model.BuildModelAutoTuned(std::move(referenceCopy), 3);
+
+  arma::Mat<size_t> neighbors;
+  arma::mat distances;
+  arma::mat queryCopy(queryData);
+  model.Search(std::move(queryCopy), 3, neighbors, distances);
+
+  CheckMatrices(neighbors, baselineNeighbors);
+  CheckMatrices(distances, baselineDistances);
+}
+
 BOOST_AUTO_TEST_CASE(KNNModelMonochromaticTest)
 {
   // Ensure that we can build an NSModel<NearestNeighborSearch> and get correct
@@ -1226,6 +1257,96 @@ BOOST_AUTO_TEST_CASE(KNNModelMonochromaticTest)
   }
 }
 
+/**
+ * Test that the NSModel result cache serves repeated queries with the same
+ * results the search produced, and that partial hits still give correct
+ * results for the remaining queries.
+ */
+BOOST_AUTO_TEST_CASE(KNNModelResultCacheTest)
+{
+  typedef NSModel<NearestNeighborSort> KNNModel;
+
+  arma::mat queryData = arma::randu<arma::mat>(10, 50);
+  arma::mat referenceData = arma::randu<arma::mat>(10, 200);
+
+  KNNModel model(KNNModel::TreeTypes::KD_TREE, false);
+  arma::mat referenceCopy(referenceData);
+  model.BuildModel(std::move(referenceCopy), 20, DUAL_TREE_MODE);
+  model.ResultCache().Capacity() = 100;
+
+  // The first search misses for every query and fills the cache.
+  arma::Mat<size_t> neighbors;
+  arma::mat distances;
+  arma::mat queryCopy(queryData);
+  model.Search(std::move(queryCopy), 3, neighbors, distances);
+
+  BOOST_REQUIRE_EQUAL(model.ResultCache().Size(), queryData.n_cols);
+  BOOST_REQUIRE_EQUAL(model.ResultCache().Hits(), 0);
+
+  // The second search with the same queries must be served entirely from the
+  // cache, with identical results.
+  arma::Mat<size_t> cachedNeighbors;
+  arma::mat cachedDistances;
+  queryCopy = queryData;
+  model.Search(std::move(queryCopy), 3, cachedNeighbors, cachedDistances);
+
+  BOOST_REQUIRE_EQUAL(model.ResultCache().Hits(), queryData.n_cols);
+  CheckMatrices(neighbors, cachedNeighbors);
+  CheckMatrices(distances, cachedDistances);
+
+  // A mixed query set (half repeated, half new) must also give the same
+  // results as an uncached search.
+  arma::mat mixedData(10, 20);
+  mixedData.cols(0, 9) = queryData.cols(0, 9);
+  mixedData.cols(10, 19) = arma::randu<arma::mat>(10, 10);
+
+  arma::Mat<size_t> mixedNeighbors;
+  arma::mat mixedDistances;
+  queryCopy = mixedData;
+  model.Search(std::move(queryCopy), 3, mixedNeighbors, mixedDistances);
+
+  KNN knn(referenceData);
+  arma::Mat<size_t> baselineNeighbors;
+  arma::mat baselineDistances;
+  knn.Search(mixedData, 3, baselineNeighbors, baselineDistances);
+
+  CheckMatrices(mixedNeighbors, baselineNeighbors);
+  CheckMatrices(mixedDistances, baselineDistances);
+
+  // Retraining must invalidate the cache.
+  referenceCopy = referenceData;
+  model.BuildModel(std::move(referenceCopy), 20, DUAL_TREE_MODE);
+  BOOST_REQUIRE_EQUAL(model.ResultCache().Size(), 0);
+
+  // With an approximate tolerance, a slightly perturbed repeat of a cached
+  // query may be served from the cache; the results it returns must be the
+  // ones stored for the original query.
+  model.ResultCache().Capacity() = 100;
+  model.ResultCache().Tolerance() = 0.1;
+
+  queryCopy = queryData;
+  model.Search(std::move(queryCopy), 3, neighbors, distances);
+
+  arma::mat perturbedData(queryData);
+  perturbedData += 1e-9 * arma::randu<arma::mat>(perturbedData.n_rows,
+      perturbedData.n_cols);
+
+  arma::Mat<size_t> perturbedNeighbors;
+  arma::mat perturbedDistances;
+  queryCopy = perturbedData;
+  model.Search(std::move(queryCopy), 3, perturbedNeighbors,
+      perturbedDistances);
+
+  for (size_t i = 0; i < perturbedNeighbors.n_cols; ++i)
+  {
+    // Whether each query hit depends on how it quantized, but either way the
+    // results must match the exact search (the perturbation is far smaller
+    // than any distance gap in random data).
+    for (size_t j = 0; j < perturbedNeighbors.n_rows; ++j)
+      BOOST_REQUIRE_EQUAL(perturbedNeighbors(j, i), neighbors(j, i));
+  }
+}
+
 /**
  * If we search twice with the same reference tree, the bounds need to be reset
  * before the second search.  This test ensures that that happens, by making
@@ -1773,4 +1894,249 @@ BOOST_AUTO_TEST_CASE(GreedyTreeSearch)
       0);
 }
 
+/**
+ * Test that the batched greedy traverser gives exactly the same results as
+ * running the per-query greedy traverser for each query point.
+ */
+BOOST_AUTO_TEST_CASE(BatchGreedyTreeSearchEquivalenceTest)
+{
+  arma::mat dataset = arma::randu<arma::mat>(5, 500);
+  arma::mat querySet = arma::randu<arma::mat>(5, 100);
+
+  typedef KDTree<EuclideanDistance, NeighborSearchStat<NearestNeighborSort>,
+      arma::mat> TreeType;
+  TreeType tree(dataset);
+
+  typedef NeighborSearchRules<NearestNeighborSort, EuclideanDistance, TreeType>
+      RuleType;
+  EuclideanDistance metric;
+
+  // Per-query greedy traversal.
+  RuleType rules(tree.Dataset(), querySet, 3, metric);
+  GreedySingleTreeTraverser<TreeType, RuleType> traverser(rules);
+  traverser.MinBaseCases() = 3;
+  for (size_t i = 0; i < querySet.n_cols; ++i)
+    traverser.Traverse(i, tree);
+
+  arma::Mat<size_t> neighbors;
+  arma::mat distances;
+  rules.GetResults(neighbors, distances);
+
+  // Batched greedy traversal over the whole query set at once.
+  RuleType batchRules(tree.Dataset(), querySet, 3, metric);
+  BatchGreedySingleTreeTraverser<TreeType, RuleType> batchTraverser(batchRules);
+  batchTraverser.MinBaseCases() = 3;
+  std::vector<size_t> queryIndices(querySet.n_cols);
+  for (size_t i = 0; i < querySet.n_cols; ++i)
+    queryIndices[i] = i;
+  batchTraverser.Traverse(queryIndices, tree);
+
+  arma::Mat<size_t> batchNeighbors;
+  arma::mat batchDistances;
+  batchRules.GetResults(batchNeighbors, batchDistances);
+
+  CheckMatrices(neighbors, batchNeighbors);
+  CheckMatrices(distances, batchDistances);
+}
+
+/**
+ * Test that best-first traversal with no leaf visit budget gives exactly the
+ * results of brute-force search, and that a small budget still gives valid
+ * (if approximate) results.
+ */
+BOOST_AUTO_TEST_CASE(BestFirstTreeSearch)
+{
+  arma::mat dataset = arma::randu<arma::mat>(5, 1000);
+  arma::mat querySet = arma::randu<arma::mat>(5, 200);
+
+  KNN naive(dataset, NAIVE_MODE);
+  arma::Mat<size_t> neighbors;
+  arma::mat distances;
+  naive.Search(querySet, 5, neighbors, distances);
+
+  KNN bestFirst(dataset, BEST_FIRST_SINGLE_TREE_MODE);
+  arma::Mat<size_t> bfNeighbors;
+  arma::mat bfDistances;
+  bestFirst.Search(querySet, 5, bfNeighbors, bfDistances);
+
+  // With no budget the traversal is exact.
+  CheckMatrices(neighbors, bfNeighbors);
+  CheckMatrices(distances, bfDistances);
+
+  // With a budget of three leaf visits per query the results are approximate,
+  // but no reported distance can beat the true nearest neighbor distance.
+  bestFirst.LeafVisitBudget() = 3;
+  bestFirst.Search(querySet, 5, bfNeighbors, bfDistances);
+
+  for (size_t i = 0; i < bfNeighbors.n_cols; ++i)
+  {
+    for (size_t j = 0; j < bfNeighbors.n_rows; ++j)
+    {
+      // The budget may be too small to fill every candidate slot.
+      if (bfDistances(j, i) == DBL_MAX)
+        continue;
+
+      BOOST_REQUIRE_LT(bfNeighbors(j, i), dataset.n_cols);
+      BOOST_REQUIRE_GE(bfDistances(j, i) + 1e-10, distances(j, i));
+    }
+  }
+}
+
+/**
+ * Test that product quantization returns valid approximate results, and that
+ * exact re-ranking over every reference point reproduces brute-force search.
+ */
+BOOST_AUTO_TEST_CASE(ProductQuantizationTest)
+{
+  arma::mat dataset = arma::randu<arma::mat>(8, 1000);
+  arma::mat querySet = arma::randu<arma::mat>(8, 100);
+
+  ProductQuantization<> pq(dataset, 4, 64);
+
+  BOOST_REQUIRE_EQUAL(pq.NumPoints(), 1000);
+  BOOST_REQUIRE_EQUAL(pq.Codes().n_rows, 4);
+
+  // Approximate (code-only) search: the indices must be valid and the
+  // approximate distances sorted.
+  arma::Mat<size_t> neighbors;
+  arma::mat distances;
+  pq.Search(querySet, 5, neighbors, distances);
+
+  BOOST_REQUIRE_EQUAL(neighbors.n_rows, 5);
+  BOOST_REQUIRE_EQUAL(neighbors.n_cols, 100);
+  for (size_t i = 0; i < neighbors.n_cols; ++i)
+  {
+    for (size_t j = 0; j < neighbors.n_rows; ++j)
+    {
+      BOOST_REQUIRE_LT(neighbors(j, i), dataset.n_cols);
+      if (j > 0)
+        BOOST_REQUIRE_GE(distances(j, i), distances(j - 1, i));
+    }
+  }
+
+  // Re-ranking every reference point with exact distances must reproduce
+  // brute-force search exactly.
+  KNN naive(dataset, NAIVE_MODE);
+  arma::Mat<size_t> exactNeighbors;
+  arma::mat exactDistances;
+  naive.Search(querySet, 5, exactNeighbors, exactDistances);
+
+  arma::Mat<size_t> rerankNeighbors;
+  arma::mat rerankDistances;
+  pq.Search(querySet, 5, rerankNeighbors, rerankDistances, dataset,
+      dataset.n_cols);
+
+  CheckMatrices(exactNeighbors, rerankNeighbors);
+  CheckMatrices(exactDistances, rerankDistances);
+}
+
+/**
+ * Test that the ParallelDualTreeTraverser gives exactly the same results as
+ * the ordinary depth-first dual-tree traversal.
+ */
+BOOST_AUTO_TEST_CASE(ParallelDualTreeTraverserTest)
+{
+  arma::mat dataset = arma::randu<arma::mat>(5, 2500);
+  arma::mat querySet = arma::randu<arma::mat>(5, 800);
+
+  typedef KDTree<EuclideanDistance, NeighborSearchStat<NearestNeighborSort>,
+      arma::mat> TreeType;
+
+  KNN knn(dataset);
+  arma::Mat<size_t> neighbors;
+  arma::mat distances;
+  knn.Search(querySet, 7, neighbors, distances);
+
+  NeighborSearch<NearestNeighborSort, EuclideanDistance, arma::mat, KDTree,
+      TreeType::template ParallelDualTreeTraverser> parallelKnn(dataset);
+  arma::Mat<size_t> parallelNeighbors;
+  arma::mat parallelDistances;
+  parallelKnn.Search(querySet, 7, parallelNeighbors, parallelDistances);
+
+  CheckMatrices(neighbors, parallelNeighbors);
+  CheckMatrices(distances, parallelDistances);
+}
+
+/**
+ * Test that a saved-and-loaded FlatKNNModel returns exactly the same
+ * neighbors and distances as the NeighborSearch it was built from.
+ */
+BOOST_AUTO_TEST_CASE(FlatKNNModelTest)
+{
+  arma::mat referenceSet = arma::randu<arma::mat>(6, 500);
+  arma::mat querySet = arma::randu<arma::mat>(6, 100);
+
+  // Get exact results from the standard dual-tree search.
+  KNN knn(referenceSet);
+  arma::Mat<size_t> neighbors;
+  arma::mat distances;
+  knn.Search(querySet, 3, neighbors, distances);
+
+  // Build a kd-tree with mappings, save it flat, and map it back in.
+  std::vector<size_t> oldFromNew;
+  KDTree<EuclideanDistance, NeighborSearchStat<NearestNeighborSort>,
+      arma::mat> tree(referenceSet, oldFromNew);
+  FlatKNNModel::Save("flat_knn_model_test.bin", tree, oldFromNew);
+
+  FlatKNNModel model;
+  model.Load("flat_knn_model_test.bin");
+  remove("flat_knn_model_test.bin");
+
+  BOOST_REQUIRE_EQUAL(model.ReferenceSetSize(), referenceSet.n_cols);
+  BOOST_REQUIRE_EQUAL(model.Dimensionality(), referenceSet.n_rows);
+
+  arma::Mat<size_t> flatNeighbors;
+  arma::mat flatDistances;
+  model.Search(querySet, 3, flatNeighbors, flatDistances);
+
+  CheckMatrices(neighbors, flatNeighbors);
+  CheckMatrices(distances, flatDistances);
+}
+
+/**
+ * Test that a persistent search session returns exactly the same results as
+ * NeighborSearch::Search() across a stream of micro-batches, including
+ * batches larger than the session's buffer and repeated calls.
+ */
+BOOST_AUTO_TEST_CASE(NeighborSearchSessionTest)
+{
+  arma::mat referenceSet = arma::randu<arma::mat>(5, 800);
+
+  KNN knn(referenceSet, SINGLE_TREE_MODE);
+  NeighborSearchSession<> session(knn, 5, 64);
+
+  BOOST_REQUIRE_EQUAL(session.K(), 5);
+  BOOST_REQUIRE_EQUAL(session.MaxBatchSize(), 64);
+
+  // Batch sizes around and beyond the buffer size; 150 exercises chunking.
+  const size_t batchSizes[4] = { 1, 10, 64, 150 };
+  for (size_t trial = 0; trial < 4; ++trial)
+  {
+    arma::mat batch = arma::randu<arma::mat>(5, batchSizes[trial]);
+
+    arma::Mat<size_t> neighbors, sessionNeighbors;
+    arma::mat distances, sessionDistances;
+
+    knn.Search(batch, 5, neighbors, distances);
+    session.Search(batch, sessionNeighbors, sessionDistances);
+
+    CheckMatrices(neighbors, sessionNeighbors);
+    CheckMatrices(distances, sessionDistances);
+  }
+
+  // The session must also work in brute-force mode.
+  KNN naive(referenceSet, NAIVE_MODE);
+  NeighborSearchSession<> naiveSession(naive, 5, 64);
+
+  arma::mat batch = arma::randu<arma::mat>(5, 30);
+  arma::Mat<size_t> neighbors, sessionNeighbors;
+  arma::mat distances, sessionDistances;
+
+  naive.Search(batch, 5, neighbors, distances);
+  naiveSession.Search(batch, sessionNeighbors, sessionDistances);
+
+  CheckMatrices(neighbors, sessionNeighbors);
+  CheckMatrices(distances, sessionDistances);
+}
+
 BOOST_AUTO_TEST_SUITE_END();
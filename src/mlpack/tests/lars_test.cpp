@@ -106,6 +106,87 @@ BOOST_AUTO_TEST_CASE(LARSTestElasticNetGram)
   LassoTest(100, 10, true, false);
 }
 
+// The coordinate descent solver converges to first-order precision rather
+// than the near-exact KKT conditions the homotopy path produces, so its
+// solutions are verified with a tolerance proportional to lambda.
+void CoordinateDescentVerifyCorrectness(const arma::vec& beta,
+                                        const arma::vec& errCorr,
+                                        const double lambda)
+{
+  const double tol = 1e-4 * (1.0 + lambda);
+  for (size_t j = 0; j < beta.n_elem; ++j)
+  {
+    if (beta(j) == 0)
+      BOOST_REQUIRE_SMALL(std::max(fabs(errCorr(j)) - lambda, 0.0), tol);
+    else if (beta(j) < 0)
+      BOOST_REQUIRE_SMALL(errCorr(j) - lambda, tol);
+    else // beta(j) > 0
+      BOOST_REQUIRE_SMALL(errCorr(j) + lambda, tol);
+  }
+}
+
+void CoordinateDescentTest(size_t nPoints, size_t nDims, bool elasticNet)
+{
+  arma::mat X;
+  arma::rowvec y;
+
+  for (size_t i = 0; i < 10; ++i)
+  {
+    GenerateProblem(X, y, nPoints, nDims);
+
+    // Armadillo's median is broken, so...
+    arma::vec sortedAbsCorr = sort(abs(X * y.t()));
+    double lambda1 = sortedAbsCorr(nDims / 2);
+    double lambda2;
+    if (elasticNet)
+      lambda2 = lambda1 / 2;
+    else
+      lambda2 = 0;
+
+    LARS lars(false, lambda1, lambda2);
+    lars.UseCoordinateDescent() = true;
+    arma::vec betaOpt;
+    lars.Train(X, y, betaOpt);
+
+    arma::vec errCorr = (X * trans(X) + lambda2 *
+        arma::eye(nDims, nDims)) * betaOpt - X * y.t();
+
+    CoordinateDescentVerifyCorrectness(betaOpt, errCorr, lambda1);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(LARSTestLassoCoordinateDescent)
+{
+  CoordinateDescentTest(100, 10, false);
+}
+
+BOOST_AUTO_TEST_CASE(LARSTestElasticNetCoordinateDescent)
+{
+  CoordinateDescentTest(100, 10, true);
+}
+
+/**
+ * Test that the coordinate descent solver also handles wide data, where the
+ * number of dimensions exceeds the number of points.
+ */
+BOOST_AUTO_TEST_CASE(LARSTestWideCoordinateDescent)
+{
+  arma::mat X;
+  arma::rowvec y;
+  GenerateProblem(X, y, 50, 200);
+
+  arma::vec sortedAbsCorr = sort(abs(X * y.t()));
+  const double lambda1 = sortedAbsCorr(100);
+
+  LARS lars(false, lambda1, 0.0);
+  lars.UseCoordinateDescent() = true;
+  arma::vec betaOpt;
+  lars.Train(X, y, betaOpt);
+
+  arma::vec errCorr = (X * trans(X)) * betaOpt - X * y.t();
+  CoordinateDescentVerifyCorrectness(betaOpt, errCorr, lambda1);
+}
+
 // Ensure that LARS doesn't crash when the data has linearly dependent features
 // (meaning that there is a singularity).  This test uses the Cholesky
 // factorization.
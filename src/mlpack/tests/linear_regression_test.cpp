@@ -200,6 +200,55 @@ BOOST_AUTO_TEST_CASE(LinearRegressionTrainTest)
     BOOST_REQUIRE_CLOSE(lr.Parameters()[i], lrTrain.Parameters()[i], 1e-5);
 }
 
+/**
+ * Test that training from sufficient statistics accumulated in pieces gives
+ * the same model as training on the full dataset at once.
+ */
+BOOST_AUTO_TEST_CASE(LinearRegressionTrainFromStatisticsTest)
+{
+  // Random dataset.
+  arma::mat dataset = arma::randu<arma::mat>(10, 2000);
+  arma::rowvec responses = arma::randu<arma::rowvec>(2000);
+
+  LinearRegression lr(dataset, responses, 0.3);
+
+  // Accumulate the normal equations over two halves of the dataset, as an
+  // out-of-core training run would.
+  arma::mat xtx;
+  arma::vec xty;
+  LinearRegression::AccumulateStatistics(dataset.cols(0, 999),
+      responses.subvec(0, 999), xtx, xty);
+  LinearRegression::AccumulateStatistics(dataset.cols(1000, 1999),
+      responses.subvec(1000, 1999), xtx, xty);
+
+  LinearRegression lrStats;
+  lrStats.Lambda() = 0.3;
+  lrStats.TrainFromStatistics(xtx, xty);
+
+  BOOST_REQUIRE_EQUAL(lrStats.Parameters().n_elem, lr.Parameters().n_elem);
+  for (size_t i = 0; i < lr.Parameters().n_elem; ++i)
+    BOOST_REQUIRE_CLOSE(lrStats.Parameters()[i], lr.Parameters()[i], 1e-5);
+
+  // The same must hold without an intercept term.
+  LinearRegression lrNoIntercept;
+  lrNoIntercept.Train(dataset, responses, false);
+
+  xtx.reset();
+  xty.reset();
+  LinearRegression::AccumulateStatistics(dataset, responses, xtx, xty, false);
+
+  LinearRegression lrStatsNoIntercept;
+  lrStatsNoIntercept.TrainFromStatistics(xtx, xty, false);
+
+  BOOST_REQUIRE_EQUAL(lrStatsNoIntercept.Parameters().n_elem,
+      lrNoIntercept.Parameters().n_elem);
+  for (size_t i = 0; i < lrNoIntercept.Parameters().n_elem; ++i)
+  {
+    BOOST_REQUIRE_CLOSE(lrStatsNoIntercept.Parameters()[i],
+        lrNoIntercept.Parameters()[i], 1e-5);
+  }
+}
+
 /*
  * Linear regression serialization test.
  */
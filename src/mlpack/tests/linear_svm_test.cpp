@@ -597,6 +597,100 @@ BOOST_AUTO_TEST_CASE(LinearSVMLBFGSTwoClasses)
   BOOST_REQUIRE_EQUAL(success, true);
 }
 
+/**
+ * Test warm-started and incremental retraining of linear svm on a
+ * two-Gaussian dataset.
+ */
+BOOST_AUTO_TEST_CASE(LinearSVMIncrementalTrainTest)
+{
+  const size_t points = 1000;
+  const size_t inputSize = 3;
+  const size_t numClasses = 2;
+  const double lambda = 0.5;
+
+  // Generate two-Gaussian dataset.
+  GaussianDistribution g1(arma::vec("1.0 9.0 1.0"), arma::eye<arma::mat>(3, 3));
+  GaussianDistribution g2(arma::vec("4.0 3.0 4.0"), arma::eye<arma::mat>(3, 3));
+
+  arma::mat data(inputSize, points);
+  arma::Row<size_t> labels(points);
+
+  bool success = false;
+  for (size_t trial = 0; trial < 5; ++trial)
+  {
+    for (size_t i = 0; i < points / 2; i++)
+    {
+      data.col(i) = g1.Random();
+      labels(i) = 0;
+    }
+    for (size_t i = points / 2; i < points; i++)
+    {
+      data.col(i) = g2.Random();
+      labels(i) = 1;
+    }
+
+    LinearSVM<arma::mat> lsvm(data, labels, numClasses, lambda);
+
+    if (lsvm.ComputeAccuracy(data, labels) < 0.99)
+      continue; // This trial has failed.
+
+    // Replace 2% of the points with freshly drawn ones and update the model
+    // on the changed points only.
+    const size_t deltaPoints = points / 50;
+    arma::mat deltaData(inputSize, deltaPoints);
+    arma::Row<size_t> deltaLabels(deltaPoints);
+    for (size_t i = 0; i < deltaPoints / 2; i++)
+    {
+      deltaData.col(i) = g1.Random();
+      deltaLabels(i) = 0;
+    }
+    for (size_t i = deltaPoints / 2; i < deltaPoints; i++)
+    {
+      deltaData.col(i) = g2.Random();
+      deltaLabels(i) = 1;
+    }
+    data.cols(0, deltaPoints - 1) = deltaData;
+    labels.subvec(0, deltaPoints - 1) = deltaLabels;
+
+    lsvm.IncrementalTrain(deltaData, deltaLabels, numClasses);
+
+    // The updated model must still classify the full dataset well.
+    if (lsvm.ComputeAccuracy(data, labels) >= 0.99)
+    {
+      success = true;
+      break;
+    }
+  }
+
+  BOOST_REQUIRE_EQUAL(success, true);
+
+  // Incremental training of an untrained or mismatched model must throw.
+  LinearSVM<arma::mat> untrained(numClasses, lambda);
+  BOOST_REQUIRE_THROW(untrained.IncrementalTrain(data, labels, numClasses),
+      std::invalid_argument);
+}
+
+/**
+ * Test that retraining on data of a different dimensionality reinitializes
+ * the parameters instead of failing.
+ */
+BOOST_AUTO_TEST_CASE(LinearSVMWarmStartResetTest)
+{
+  arma::mat data = arma::randu<arma::mat>(3, 100);
+  arma::Row<size_t> labels(100);
+  for (size_t i = 0; i < 100; ++i)
+    labels(i) = (data(0, i) > 0.5) ? 1 : 0;
+
+  LinearSVM<arma::mat> lsvm(data, labels, 2, 0.0001);
+  BOOST_REQUIRE_EQUAL(lsvm.Parameters().n_rows, 3);
+
+  // Retraining on wider data must resize the parameters.
+  arma::mat newData = arma::randu<arma::mat>(5, 100);
+  lsvm.Train(newData, labels, 2);
+  BOOST_REQUIRE_EQUAL(lsvm.Parameters().n_rows, 5);
+  BOOST_REQUIRE_EQUAL(lsvm.Parameters().n_cols, 2);
+}
+
 /**
  * Test training of linear svm for two classes on a complex gaussian dataset
  * using L-BFGS optimizer which can't be separated without adding
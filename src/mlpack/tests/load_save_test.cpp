@@ -12,7 +12,11 @@
 #include <sstream>
 
 #include <mlpack/core.hpp>
+#include <mlpack/core/data/assignment_writer.hpp>
+#include <mlpack/core/data/checkpoint.hpp>
+#include <mlpack/core/data/first_touch.hpp>
 #include <mlpack/core/data/load_arff.hpp>
+#include <mlpack/core/data/save_async.hpp>
 #include <mlpack/core/data/map_policies/missing_policy.hpp>
 #include <boost/test/unit_test.hpp>
 #include "test_tools.hpp"
@@ -338,6 +342,261 @@ BOOST_AUTO_TEST_CASE(SaveSparseBinaryTest)
   remove("test_sparse_file.bin");
 }
 
+/**
+ * Make sure the binary columnar format round-trips a matrix exactly and
+ * refuses files of the wrong element type.
+ */
+BOOST_AUTO_TEST_CASE(BinaryColumnarRoundTripTest)
+{
+  arma::mat test = arma::randu<arma::mat>(10, 20);
+
+  BOOST_REQUIRE(data::Save("test_file.mbin", test) == true);
+
+  // The format stores the in-memory layout, so no transpose is applied on
+  // either side of the round trip.
+  arma::mat test2;
+  BOOST_REQUIRE(data::Load("test_file.mbin", test2) == true);
+
+  BOOST_REQUIRE_EQUAL(test2.n_rows, 10);
+  BOOST_REQUIRE_EQUAL(test2.n_cols, 20);
+  CheckMatrices(test, test2);
+
+  // Loading with a different element type must fail.
+  arma::fmat wrongType;
+  BOOST_REQUIRE(data::Load("test_file.mbin", wrongType) == false);
+
+  // Remove the file.
+  remove("test_file.mbin");
+}
+
+/**
+ * Make sure a memory-mapped binary columnar file exposes the same matrix
+ * without copying.
+ */
+BOOST_AUTO_TEST_CASE(MappedMatrixTest)
+{
+  arma::mat test = arma::randu<arma::mat>(10, 20);
+  BOOST_REQUIRE(data::Save("test_file.mbin", test) == true);
+
+  {
+    data::MappedMatrix<double> mapped("test_file.mbin");
+
+    BOOST_REQUIRE_EQUAL(mapped.Matrix().n_rows, 10);
+    BOOST_REQUIRE_EQUAL(mapped.Matrix().n_cols, 20);
+    CheckMatrices(test, arma::mat(mapped.Matrix()));
+  }
+
+  // Mapping with the wrong element type must throw.
+  BOOST_REQUIRE_THROW(data::MappedMatrix<float> mapped("test_file.mbin"),
+      std::runtime_error);
+
+  // Remove the file.
+  remove("test_file.mbin");
+}
+
+#ifndef _WIN32
+/**
+ * Make sure a published shared memory dataset round-trips through the
+ * 'shm://' URI and refuses the wrong element type.
+ */
+BOOST_AUTO_TEST_CASE(SharedMemoryRoundTripTest)
+{
+  arma::mat test = arma::randu<arma::mat>(10, 20);
+
+  BOOST_REQUIRE(data::Save("shm://mlpack_test_segment", test) == true);
+
+  // Attaching is zero-copy and preserves the in-memory layout, so no
+  // transpose is applied on either side of the round trip.
+  arma::mat test2;
+  BOOST_REQUIRE(data::Load("shm://mlpack_test_segment", test2) == true);
+
+  BOOST_REQUIRE_EQUAL(test2.n_rows, 10);
+  BOOST_REQUIRE_EQUAL(test2.n_cols, 20);
+  CheckMatrices(test, test2);
+
+  // Attaching with a different element type must fail.
+  arma::fmat wrongType;
+  BOOST_REQUIRE(data::Load("shm://mlpack_test_segment", wrongType) == false);
+
+  // Remove the segment; new attachments must then fail.
+  BOOST_REQUIRE(data::RemoveSharedMemory("mlpack_test_segment") == true);
+  arma::mat test3;
+  BOOST_REQUIRE(data::Load("shm://mlpack_test_segment", test3) == false);
+}
+#endif
+
+/**
+ * Make sure an asynchronous save writes the same file a synchronous one
+ * would, and that failures are reported by WaitForSaves().
+ */
+BOOST_AUTO_TEST_CASE(SaveAsyncTest)
+{
+  arma::mat test = arma::randu<arma::mat>(10, 20);
+  arma::mat copy = test;
+
+  // The matrix is consumed by the call.
+  data::SaveAsync("test_async_file.csv", std::move(test));
+  BOOST_REQUIRE(data::WaitForSaves() == true);
+
+  arma::mat test2;
+  BOOST_REQUIRE(data::Load("test_async_file.csv", test2) == true);
+  CheckMatrices(copy, test2);
+
+  // A save to an unwritable location must be reported as a failure.
+  data::SaveAsync("nonexistent_dir/test_async_file.csv", std::move(copy));
+  BOOST_REQUIRE(data::WaitForSaves() == false);
+
+  // Remove the file.
+  remove("test_async_file.csv");
+}
+
+/**
+ * Make sure first-touch placement preserves the contents of the matrix (the
+ * placement itself is not observable from a test, only the copy).
+ */
+BOOST_AUTO_TEST_CASE(FirstTouchPlacementTest)
+{
+  arma::mat test = arma::randu<arma::mat>(17, 203);
+  arma::mat copy = test;
+
+  data::FirstTouchPlacement(test);
+
+  CheckMatrices(copy, test);
+}
+
+/**
+ * Make sure a checkpoint round-trips state, only writes on the configured
+ * interval, and removes its file when the job finishes.
+ */
+BOOST_AUTO_TEST_CASE(CheckpointTest)
+{
+  data::Checkpoint checkpoint("checkpoint_test.bin", 5);
+
+  // Nothing has been saved, so there is nothing to restore.
+  arma::mat state;
+  BOOST_REQUIRE(checkpoint.Restore(state) == false);
+
+  // Iteration 3 is off the interval, so no file should appear.
+  arma::mat saved = arma::randu<arma::mat>(11, 13);
+  checkpoint.Save(3, saved);
+  BOOST_REQUIRE(checkpoint.Restore(state) == false);
+
+  // Iteration 5 falls on the interval and must round-trip exactly.
+  checkpoint.Save(5, saved);
+  BOOST_REQUIRE(checkpoint.Restore(state) == true);
+  CheckMatrices(saved, state);
+
+  // Finishing removes the file, so a later restore finds nothing.
+  checkpoint.Finish();
+  BOOST_REQUIRE(checkpoint.Restore(state) == false);
+
+  // A checkpoint with no filename is disabled entirely.
+  data::Checkpoint disabled;
+  BOOST_REQUIRE(disabled.Enabled() == false);
+  disabled.Save(5, saved);
+  BOOST_REQUIRE(disabled.Restore(state) == false);
+}
+
+/**
+ * Make sure the assignment writer streams assignments chunk-wise, in order,
+ * one per line, and flushes the remainder on destruction.
+ */
+BOOST_AUTO_TEST_CASE(AssignmentWriterTest)
+{
+  std::ostringstream output;
+  {
+    // Use a tiny chunk size so several flushes happen mid-stream.
+    data::AssignmentWriter writer(output, 4);
+
+    arma::Row<size_t> assignments(10);
+    for (size_t i = 0; i < assignments.n_elem; ++i)
+      assignments[i] = i % 3;
+    writer.Write(assignments);
+    writer.Write((size_t) 7);
+
+    BOOST_REQUIRE_EQUAL(writer.Written(), 11);
+  }
+
+  // Read back one assignment per line.
+  std::istringstream input(output.str());
+  std::string line;
+  size_t count = 0;
+  while (std::getline(input, line))
+  {
+    const size_t value = (size_t) std::stoul(line);
+    if (count < 10)
+      BOOST_REQUIRE_EQUAL(value, count % 3);
+    else
+      BOOST_REQUIRE_EQUAL(value, 7);
+    ++count;
+  }
+  BOOST_REQUIRE_EQUAL(count, 11);
+}
+
+/**
+ * Make sure the chunked loader streams a text file in fixed-size column
+ * blocks that reassemble to the fully-loaded matrix, and that Reset()
+ * restarts the stream.
+ */
+BOOST_AUTO_TEST_CASE(ChunkedLoaderCSVTest)
+{
+  fstream f;
+  f.open("test_file.csv", fstream::out);
+  for (size_t i = 0; i < 7; ++i)
+    f << i << "," << (i + 10) << "," << (i + 20) << endl;
+  f.close();
+
+  arma::mat full;
+  BOOST_REQUIRE(data::Load("test_file.csv", full) == true);
+
+  data::ChunkedLoader<> loader("test_file.csv", 3);
+  BOOST_REQUIRE_EQUAL(loader.Dimensionality(), 3);
+
+  // The chunks must come out as 3, 3 and 1 columns and reassemble to the
+  // full matrix.
+  arma::mat chunk, reassembled;
+  std::vector<size_t> sizes;
+  while (loader.Next(chunk))
+  {
+    sizes.push_back(chunk.n_cols);
+    reassembled = arma::join_rows(reassembled, chunk);
+  }
+
+  BOOST_REQUIRE_EQUAL(sizes.size(), 3);
+  BOOST_REQUIRE_EQUAL(sizes[0], 3);
+  BOOST_REQUIRE_EQUAL(sizes[1], 3);
+  BOOST_REQUIRE_EQUAL(sizes[2], 1);
+  CheckMatrices(full, reassembled);
+
+  // After a reset the stream starts over.
+  loader.Reset();
+  BOOST_REQUIRE(loader.Next(chunk) == true);
+  BOOST_REQUIRE_EQUAL(chunk.n_cols, 3);
+  CheckMatrices(arma::mat(full.cols(0, 2)), chunk);
+
+  remove("test_file.csv");
+}
+
+/**
+ * Make sure the chunked loader streams binary columnar files too.
+ */
+BOOST_AUTO_TEST_CASE(ChunkedLoaderBinaryColumnarTest)
+{
+  arma::mat test = arma::randu<arma::mat>(5, 11);
+  BOOST_REQUIRE(data::Save("test_file.mbin", test) == true);
+
+  data::ChunkedLoader<> loader("test_file.mbin", 4);
+  BOOST_REQUIRE_EQUAL(loader.Dimensionality(), 5);
+
+  arma::mat chunk, reassembled;
+  while (loader.Next(chunk))
+    reassembled = arma::join_rows(reassembled, chunk);
+
+  CheckMatrices(test, reassembled);
+
+  remove("test_file.mbin");
+}
+
 /**
  * Make sure CSVs can be loaded in transposed form.
  */
@@ -364,6 +623,50 @@ BOOST_AUTO_TEST_CASE(LoadTransposedCSVTest)
   remove("test_file.csv");
 }
 
+/**
+ * Make sure the parallel numeric CSV fast path handles empty fields, CRLF
+ * line endings, blank lines and scientific notation, both transposed and
+ * untransposed.
+ */
+BOOST_AUTO_TEST_CASE(LoadNumericCSVFastPathTest)
+{
+  fstream f;
+  f.open("test_file.csv", fstream::out);
+
+  f << "1,,-3,4e1\r" << endl;
+  f << endl;
+  f << " 5 , 6.5 ,7, 8 " << endl;
+
+  f.close();
+
+  arma::mat test;
+  BOOST_REQUIRE(data::Load("test_file.csv", test) == true);
+
+  BOOST_REQUIRE_EQUAL(test.n_rows, 4);
+  BOOST_REQUIRE_EQUAL(test.n_cols, 2);
+
+  BOOST_REQUIRE_CLOSE(test(0, 0), 1.0, 1e-5);
+  BOOST_REQUIRE_SMALL(test(1, 0), 1e-12);
+  BOOST_REQUIRE_CLOSE(test(2, 0), -3.0, 1e-5);
+  BOOST_REQUIRE_CLOSE(test(3, 0), 40.0, 1e-5);
+  BOOST_REQUIRE_CLOSE(test(0, 1), 5.0, 1e-5);
+  BOOST_REQUIRE_CLOSE(test(1, 1), 6.5, 1e-5);
+  BOOST_REQUIRE_CLOSE(test(2, 1), 7.0, 1e-5);
+  BOOST_REQUIRE_CLOSE(test(3, 1), 8.0, 1e-5);
+
+  // The untransposed load must match the file layout.
+  arma::mat untransposed;
+  BOOST_REQUIRE(data::Load("test_file.csv", untransposed, false, false)
+      == true);
+
+  BOOST_REQUIRE_EQUAL(untransposed.n_rows, 2);
+  BOOST_REQUIRE_EQUAL(untransposed.n_cols, 4);
+  CheckMatrices(test, arma::mat(untransposed.t()));
+
+  // Remove the file.
+  remove("test_file.csv");
+}
+
 /**
  * Make sure ColVec can be loaded.
  */
@@ -1113,6 +1416,27 @@ BOOST_AUTO_TEST_CASE(OneHotEncodingTest)
   CheckMatrices(output, matrix);
 }
 
+/**
+ * Test that the sparse one hot encoding overload matches the dense one.
+ */
+BOOST_AUTO_TEST_CASE(SparseOneHotEncodingTest)
+{
+  arma::irowvec labels("-1 1 -1 -1 2 -1 1 -1");
+
+  arma::mat dense;
+  arma::sp_mat sparse;
+  data::OneHotEncoding(labels, dense);
+  data::OneHotEncoding(labels, sparse);
+
+  BOOST_REQUIRE_EQUAL(sparse.n_rows, dense.n_rows);
+  BOOST_REQUIRE_EQUAL(sparse.n_cols, dense.n_cols);
+  // Exactly one nonzero element per point.
+  BOOST_REQUIRE_EQUAL(sparse.n_nonzero, labels.n_elem);
+  for (size_t i = 0; i < dense.n_rows; ++i)
+    for (size_t j = 0; j < dense.n_cols; ++j)
+      BOOST_REQUIRE_CLOSE(sparse(i, j) + 1.0, dense(i, j) + 1.0, 1e-5);
+}
+
 /**
  * Test normalization of labels.
  */
@@ -1272,6 +1596,73 @@ BOOST_AUTO_TEST_CASE(LoadTextTest)
   BOOST_REQUIRE_EQUAL(y.inb.s, x.inb.s);
 }
 
+/**
+ * Make sure we can load and save in the compressed binary format.
+ */
+BOOST_AUTO_TEST_CASE(LoadCompressedBinaryTest)
+{
+  Test x(10, 12);
+
+  BOOST_REQUIRE_EQUAL(data::Save("test.zbin", "x", x, false), true);
+
+  // Now reload.
+  Test y(11, 14);
+
+  BOOST_REQUIRE_EQUAL(data::Load("test.zbin", "x", y, false), true);
+
+  BOOST_REQUIRE_EQUAL(y.x, x.x);
+  BOOST_REQUIRE_EQUAL(y.y, x.y);
+  BOOST_REQUIRE_EQUAL(y.ina.c, x.ina.c);
+  BOOST_REQUIRE_EQUAL(y.ina.s, x.ina.s);
+  BOOST_REQUIRE_EQUAL(y.inb.c, x.inb.c);
+  BOOST_REQUIRE_EQUAL(y.inb.s, x.inb.s);
+
+  // A file that is not a compressed frame must be rejected cleanly.
+  BOOST_REQUIRE_EQUAL(data::Save("test.bin", "x", x, false), true);
+  BOOST_REQUIRE_EQUAL(data::Load("test.bin", "x", y, false,
+      data::format::compressed_binary), false);
+
+  remove("test.zbin");
+}
+
+/**
+ * Test the compression codec itself on data of different shapes, including
+ * payloads spanning several blocks.
+ */
+BOOST_AUTO_TEST_CASE(CompressedFrameRoundTripTest)
+{
+  std::vector<std::string> payloads;
+  // Empty, tiny, highly compressible, incompressible, and multi-block.
+  payloads.push_back("");
+  payloads.push_back("abc");
+  payloads.push_back(std::string(100000, 'z'));
+
+  std::string random(100000, '\0');
+  for (size_t i = 0; i < random.size(); ++i)
+    random[i] = (char) math::RandInt(0, 256);
+  payloads.push_back(random);
+
+  std::string multiBlock;
+  for (size_t i = 0; i < (3 << 20) / 16; ++i)
+    multiBlock += "0123456789abcdef";
+  payloads.push_back(multiBlock);
+
+  for (size_t i = 0; i < payloads.size(); ++i)
+  {
+    std::stringstream stream(std::ios::in | std::ios::out | std::ios::binary);
+    BOOST_REQUIRE(data::WriteCompressedFrame(stream, payloads[i]));
+
+    std::string decompressed;
+    BOOST_REQUIRE(data::ReadCompressedFrame(stream, decompressed));
+    BOOST_REQUIRE(decompressed == payloads[i]);
+  }
+
+  // The repetitive payloads must actually shrink.
+  std::stringstream stream(std::ios::in | std::ios::out | std::ios::binary);
+  BOOST_REQUIRE(data::WriteCompressedFrame(stream, multiBlock));
+  BOOST_REQUIRE_LT(stream.str().size(), multiBlock.size() / 2);
+}
+
 /**
  * Test DatasetInfo by making a map for a dimension.
  */
@@ -1320,6 +1711,76 @@ BOOST_AUTO_TEST_CASE(DatasetInfoTest)
   BOOST_REQUIRE_EQUAL(strThird, "test_mapping_3");
 }
 
+/**
+ * Test that the fast numeric token check in IncrementPolicy agrees with the
+ * stringstream behavior it replaced.
+ */
+BOOST_AUTO_TEST_CASE(DatasetInfoNumericTokenTest)
+{
+  DatasetInfo di(8);
+
+  // These tokens are numbers, so the dimensions must stay numeric.
+  BOOST_REQUIRE_CLOSE(di.MapString<double>("3.5", 0), 3.5, 1e-10);
+  BOOST_REQUIRE_CLOSE(di.MapString<double>("-1e-3", 1), -1e-3, 1e-10);
+  BOOST_REQUIRE_CLOSE(di.MapString<double>("7", 2), 7.0, 1e-10);
+  BOOST_REQUIRE(di.Type(0) == Datatype::numeric);
+  BOOST_REQUIRE(di.Type(1) == Datatype::numeric);
+  BOOST_REQUIRE(di.Type(2) == Datatype::numeric);
+
+  // These tokens are not numbers, even though strtod() would accept some of
+  // them; they must be mapped, exactly as stringstream extraction mapped them.
+  BOOST_REQUIRE_EQUAL(di.MapString<double>("nan", 3), 0.0);
+  BOOST_REQUIRE_EQUAL(di.MapString<double>("inf", 4), 0.0);
+  BOOST_REQUIRE_EQUAL(di.MapString<double>("0x1p3", 5), 0.0);
+  BOOST_REQUIRE_EQUAL(di.MapString<double>("3.5 ", 6), 0.0);
+  BOOST_REQUIRE_EQUAL(di.MapString<double>("", 7), 0.0);
+  for (size_t i = 3; i < 8; ++i)
+    BOOST_REQUIRE(di.Type(i) == Datatype::categorical);
+}
+
+/**
+ * Test that a dataset can be encoded in two passes: a serial MapString() pass
+ * to build the mappings, then a parallel read-only TryMapString() pass.
+ */
+BOOST_AUTO_TEST_CASE(DatasetInfoTryMapStringTest)
+{
+  std::vector<std::string> tokens = { "red", "green", "2.5", "blue", "red",
+      "green" };
+
+  // First pass: build the mappings serially.
+  DatasetInfo di(1);
+  arma::vec serial(tokens.size());
+  for (size_t i = 0; i < tokens.size(); ++i)
+    serial[i] = di.MapString<double>(tokens[i], 0);
+
+  // Second pass: encode in parallel through the const lookup.
+  arma::vec parallel(tokens.size());
+  size_t failures = 0;
+  #pragma omp parallel for reduction(+:failures)
+  for (omp_size_t i = 0; i < (omp_size_t) tokens.size(); ++i)
+  {
+    double value;
+    if (di.TryMapString(tokens[i], 0, value))
+      parallel[i] = value;
+    else
+      ++failures;
+  }
+
+  BOOST_REQUIRE_EQUAL(failures, 0);
+  for (size_t i = 0; i < tokens.size(); ++i)
+    BOOST_REQUIRE_CLOSE(serial[i], parallel[i], 1e-10);
+
+  // An unseen token must not be mapped.
+  double value;
+  BOOST_REQUIRE(!di.TryMapString("yellow", 0, value));
+
+  // A numeric dimension parses the token directly.
+  DatasetInfo numericInfo(1);
+  BOOST_REQUIRE(numericInfo.TryMapString("4.25", 0, value));
+  BOOST_REQUIRE_CLOSE(value, 4.25, 1e-10);
+  BOOST_REQUIRE(!numericInfo.TryMapString("not_a_number", 0, value));
+}
+
 /**
  * Test loading regular CSV with DatasetInfo.  Everything should be numeric.
  */
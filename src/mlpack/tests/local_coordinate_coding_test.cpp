@@ -190,4 +190,44 @@ BOOST_AUTO_TEST_CASE(LocalCoordinateCodingTrainReturnObjective)
   BOOST_REQUIRE_EQUAL(std::isfinite(objVal), true);
 }
 
+/**
+ * Test that online mini-batch training produces a usable dictionary, and that
+ * feeding the data in chunks (as from a stream) refines the same model.
+ */
+BOOST_AUTO_TEST_CASE(LocalCoordinateCodingOnlineTrainTest)
+{
+  double lambda1 = 0.1;
+  uword nAtoms = 10;
+
+  mat X;
+  X.load("mnist_first250_training_4s_and_9s.arm");
+  uword nPoints = X.n_cols;
+
+  // Normalize each point since these are images.
+  for (uword i = 0; i < nPoints; i++)
+  {
+    X.col(i) /= norm(X.col(i), 2);
+  }
+
+  LocalCoordinateCoding lcc(nAtoms, lambda1);
+
+  // Train on the first half of the data, then refine with the second half, as
+  // if the chunks arrived from a stream.
+  double objVal = lcc.TrainOnline(X.cols(0, nPoints / 2 - 1), 25, 2);
+  BOOST_REQUIRE_EQUAL(std::isfinite(objVal), true);
+
+  objVal = lcc.TrainOnline(X.cols(nPoints / 2, nPoints - 1), 25, 2);
+  BOOST_REQUIRE_EQUAL(std::isfinite(objVal), true);
+
+  // The learned dictionary should have bounded atom norms and give a finite
+  // full-data objective.
+  for (uword j = 0; j < nAtoms; j++)
+    BOOST_REQUIRE_LE(norm(lcc.Dictionary().col(j), 2), 1.0 + 1e-8);
+
+  mat Z;
+  lcc.Encode(X, Z);
+  uvec adjacencies = find(Z);
+  BOOST_REQUIRE_EQUAL(std::isfinite(lcc.Objective(X, Z, adjacencies)), true);
+}
+
 BOOST_AUTO_TEST_SUITE_END();
@@ -482,6 +482,120 @@ BOOST_AUTO_TEST_CASE(LogisticRegressionFunctionRegularizationSeparableGradient)
   }
 }
 
+/**
+ * Test that the sparse-specialized Gradient() and EvaluateWithGradient() give
+ * the same results as the dense implementation.
+ */
+BOOST_AUTO_TEST_CASE(LogisticRegressionFunctionSparseGradient)
+{
+  const size_t points = 500;
+  const size_t dimension = 25;
+
+  // Create a random sparse dataset and its dense equivalent.
+  arma::sp_mat sparseData;
+  sparseData.sprandu(dimension, points, 0.1);
+  arma::mat denseData(sparseData);
+
+  arma::Row<size_t> responses(points);
+  for (size_t i = 0; i < points; ++i)
+    responses[i] = math::RandInt(0, 2);
+
+  LogisticRegressionFunction<arma::mat> denseLrf(denseData, responses, 0.5);
+  LogisticRegressionFunction<arma::sp_mat> sparseLrf(sparseData, responses,
+      0.5);
+
+  arma::rowvec parameters(dimension + 1);
+  parameters.randu();
+
+  // The full gradient must match the dense implementation exactly (up to
+  // floating-point reordering).
+  arma::mat denseGradient, sparseGradient;
+  denseLrf.Gradient(parameters, denseGradient);
+  sparseLrf.Gradient(parameters, sparseGradient);
+
+  BOOST_REQUIRE_EQUAL(sparseGradient.n_elem, denseGradient.n_elem);
+  for (size_t j = 0; j < denseGradient.n_elem; ++j)
+  {
+    if (std::abs(denseGradient[j]) < 1e-8)
+      BOOST_REQUIRE_SMALL(sparseGradient[j], 1e-8);
+    else
+      BOOST_REQUIRE_CLOSE(sparseGradient[j], denseGradient[j], 1e-5);
+  }
+
+  // The same must hold for batches and for EvaluateWithGradient().
+  denseLrf.Gradient(parameters, 100, denseGradient, 50);
+  sparseLrf.Gradient(parameters, 100, sparseGradient, 50);
+  for (size_t j = 0; j < denseGradient.n_elem; ++j)
+  {
+    if (std::abs(denseGradient[j]) < 1e-8)
+      BOOST_REQUIRE_SMALL(sparseGradient[j], 1e-8);
+    else
+      BOOST_REQUIRE_CLOSE(sparseGradient[j], denseGradient[j], 1e-5);
+  }
+
+  const double denseObjective = denseLrf.EvaluateWithGradient(parameters,
+      denseGradient);
+  const double sparseObjective = sparseLrf.EvaluateWithGradient(parameters,
+      sparseGradient);
+  BOOST_REQUIRE_CLOSE(sparseObjective, denseObjective, 1e-5);
+  for (size_t j = 0; j < denseGradient.n_elem; ++j)
+  {
+    if (std::abs(denseGradient[j]) < 1e-8)
+      BOOST_REQUIRE_SMALL(sparseGradient[j], 1e-8);
+    else
+      BOOST_REQUIRE_CLOSE(sparseGradient[j], denseGradient[j], 1e-5);
+  }
+}
+
+/**
+ * Test the lazily regularized sparse gradient: only features touched by the
+ * batch may be nonzero, and on those features the values must agree with the
+ * dense gradient (which regularizes every feature).
+ */
+BOOST_AUTO_TEST_CASE(LogisticRegressionFunctionLazySparseGradient)
+{
+  const size_t points = 500;
+  const size_t dimension = 25;
+
+  arma::sp_mat sparseData;
+  sparseData.sprandu(dimension, points, 0.05);
+  arma::mat denseData(sparseData);
+
+  arma::Row<size_t> responses(points);
+  for (size_t i = 0; i < points; ++i)
+    responses[i] = math::RandInt(0, 2);
+
+  LogisticRegressionFunction<arma::mat> denseLrf(denseData, responses, 0.5);
+  LogisticRegressionFunction<arma::sp_mat> sparseLrf(sparseData, responses,
+      0.5);
+
+  arma::rowvec parameters(dimension + 1);
+  parameters.randu();
+
+  for (size_t begin = 0; begin < points; begin += 100)
+  {
+    arma::mat denseGradient;
+    arma::sp_mat sparseGradient;
+    denseLrf.Gradient(parameters, begin, denseGradient, 5);
+    sparseLrf.Gradient(parameters, begin, sparseGradient, 5);
+
+    // Every nonzero of the sparse gradient must match the dense gradient,
+    // because on touched features lazy and full regularization coincide.
+    for (arma::sp_mat::const_iterator it = sparseGradient.begin();
+         it != sparseGradient.end(); ++it)
+      BOOST_REQUIRE_CLOSE((*it), denseGradient[it.col()], 1e-5);
+
+    // Features not touched by the batch must stay zero in the sparse
+    // gradient.
+    const arma::sp_mat batch(sparseData.cols(begin, begin + 4));
+    for (size_t j = 1; j < parameters.n_elem; ++j)
+    {
+      if (batch.row(j - 1).n_nonzero == 0)
+        BOOST_REQUIRE_EQUAL((double) sparseGradient[j], 0.0);
+    }
+  }
+}
+
 // Test training of logistic regression on a simple dataset.
 BOOST_AUTO_TEST_CASE(LogisticRegressionLBFGSSimpleTest)
 {
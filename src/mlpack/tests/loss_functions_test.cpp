@@ -30,6 +30,8 @@
 #include <mlpack/methods/ann/loss_functions/hinge_embedding_loss.hpp>
 #include <mlpack/methods/ann/loss_functions/cosine_embedding_loss.hpp>
 #include <mlpack/methods/ann/loss_functions/l1_loss.hpp>
+#include <mlpack/methods/ann/loss_functions/negative_log_likelihood.hpp>
+#include <mlpack/methods/ann/loss_functions/softmax_cross_entropy.hpp>
 #include <mlpack/methods/ann/init_rules/nguyen_widrow_init.hpp>
 #include <mlpack/methods/ann/ffn.hpp>
 
@@ -748,4 +750,64 @@ BOOST_AUTO_TEST_CASE(MarginRankingLossTest)
       "-0.753830 1.336900 0.000000 0.000000 -0.207000 0.328810"), 1e-6);
 }
 
+/*
+ * Simple test for the fused softmax cross-entropy layer: it must match the
+ * composition of LogSoftMax and NegativeLogLikelihood.
+ */
+BOOST_AUTO_TEST_CASE(SoftmaxCrossEntropyTest)
+{
+  arma::mat input = arma::randn(8, 5);
+  arma::mat target = arma::floor(8 * arma::randu(1, 5)) + 1;
+
+  SoftmaxCrossEntropy<> module;
+  const double error = module.Forward(input, target);
+
+  // Reference: LogSoftMax followed by NegativeLogLikelihood.
+  LogSoftMax<> logSoftMax;
+  NegativeLogLikelihood<> nll;
+  arma::mat logProbabilities;
+  logSoftMax.Forward(input, logProbabilities);
+  const double referenceError = nll.Forward(logProbabilities, target);
+  BOOST_REQUIRE_CLOSE(error, referenceError, 1e-3);
+
+  // The gradient with respect to the logits is softmax minus one-hot, so
+  // every column must sum to zero.
+  arma::mat output;
+  module.Backward(input, target, output);
+  BOOST_REQUIRE_EQUAL(output.n_rows, input.n_rows);
+  BOOST_REQUIRE_EQUAL(output.n_cols, input.n_cols);
+  for (size_t i = 0; i < output.n_cols; ++i)
+  {
+    BOOST_REQUIRE_SMALL(arma::accu(output.col(i)), 1e-10);
+    BOOST_REQUIRE_LT(output((size_t) target(i) - 1, i), 0.0);
+  }
+}
+
+/*
+ * Test the sampled-softmax mode: the loss must stay finite and the gradient
+ * must only touch the drawn classes and the targets.
+ */
+BOOST_AUTO_TEST_CASE(SampledSoftmaxCrossEntropyTest)
+{
+  arma::mat input = arma::randn(50, 4);
+  arma::mat target = arma::mat("1 10 25 50");
+
+  SoftmaxCrossEntropy<> module(5);
+  const double error = module.Forward(input, target);
+  BOOST_REQUIRE(std::isfinite(error));
+  BOOST_REQUIRE_GT(error, 0.0);
+
+  arma::mat output;
+  module.Backward(input, target, output);
+
+  // Each column sums to zero (the subset softmax sums to one and the target
+  // entry subtracts one), and at most numSamples + 1 entries are nonzero.
+  for (size_t i = 0; i < output.n_cols; ++i)
+  {
+    BOOST_REQUIRE_SMALL(arma::accu(output.col(i)), 1e-10);
+    BOOST_REQUIRE_LE(arma::accu(output.col(i) != 0), 6);
+    BOOST_REQUIRE_LT(output((size_t) target(i) - 1, i), 0.0);
+  }
+}
+
 BOOST_AUTO_TEST_SUITE_END();
@@ -646,6 +646,75 @@ BOOST_AUTO_TEST_CASE(LSHTrainTest)
   BOOST_REQUIRE_EQUAL(distances.n_rows, 3);
 }
 
+/**
+ * Test: verify that Insert(), Delete() and Compact() keep the hash tables
+ * consistent.  A query identical to an inserted point hashes to the same
+ * bucket in every table, so the inserted point must be retrieved with zero
+ * distance; after Delete() it must never be reported again; after Compact()
+ * all reported indices must refer to the shrunken reference set.
+ */
+BOOST_AUTO_TEST_CASE(IncrementalUpdateTest)
+{
+  const size_t numProj = 10;
+  const size_t numTables = 10;
+  const double hashWidth = 4.0;
+  const size_t secondHashSize = 99901;
+  const size_t bucketSize = 500;
+
+  arma::mat rdata;
+  GetPointset(1000, rdata);
+
+  // Train on the first 800 points, then insert the remaining 200.
+  arma::mat prefix = rdata.cols(0, 799);
+  LSHSearch<> lsh(prefix, numProj, numTables, hashWidth, secondHashSize,
+      bucketSize);
+
+  arma::mat suffix = rdata.cols(800, 999);
+  lsh.Insert(suffix);
+
+  BOOST_REQUIRE_EQUAL(lsh.ReferenceSet().n_cols, 1000);
+
+  // Query with exact copies of some inserted points; these hash identically
+  // to their originals, so they are guaranteed to land in the same buckets.
+  arma::mat qdata = rdata.cols(850, 854);
+
+  arma::Mat<size_t> neighbors;
+  arma::mat distances;
+  lsh.Search(qdata, 1, neighbors, distances);
+
+  for (size_t i = 0; i < qdata.n_cols; ++i)
+  {
+    BOOST_REQUIRE_EQUAL(neighbors(0, i), 850 + i);
+    BOOST_REQUIRE_SMALL(distances(0, i), 1e-10);
+  }
+
+  // Delete those points; an out-of-range index must be silently ignored.
+  arma::uvec deletions(6);
+  for (size_t i = 0; i < 5; ++i)
+    deletions[i] = 850 + i;
+  deletions[5] = 5000;
+  lsh.Delete(deletions);
+
+  lsh.Search(qdata, 1, neighbors, distances);
+  for (size_t i = 0; i < qdata.n_cols; ++i)
+  {
+    BOOST_REQUIRE_NE(neighbors(0, i), 850 + i);
+    BOOST_REQUIRE_LT(neighbors(0, i), 1000);
+  }
+
+  // Compaction reclaims the deleted columns and renumbers indices.
+  lsh.Compact();
+  BOOST_REQUIRE_EQUAL(lsh.ReferenceSet().n_cols, 995);
+
+  lsh.Search(qdata, 1, neighbors, distances);
+  for (size_t i = 0; i < qdata.n_cols; ++i)
+  {
+    BOOST_REQUIRE_LT(neighbors(0, i), 995);
+    BOOST_REQUIRE_GE(distances(0, i), 0.0);
+    BOOST_REQUIRE(!std::isinf(distances(0, i)));
+  }
+}
+
 /**
  * Test: this verifies ComputeRecall works correctly by providing two identical
  * vectors and requiring that Recall is equal to 1.
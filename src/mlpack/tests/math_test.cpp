@@ -9,7 +9,11 @@
  * 3-clause BSD license along with mlpack.  If not, see
  * http://www.opensource.org/licenses/BSD-3-Clause for more information.
  */
+#include <mlpack/core/math/blocked_ops.hpp>
 #include <mlpack/core/math/clamp.hpp>
+#include <mlpack/core/math/fast_math.hpp>
+#include <mlpack/core/math/log_add.hpp>
+#include <mlpack/core/math/make_alias.hpp>
 #include <mlpack/core/math/random.hpp>
 #include <mlpack/core/math/range.hpp>
 #include <boost/test/unit_test.hpp>
@@ -619,6 +623,36 @@ BOOST_AUTO_TEST_CASE(ShuffleTest)
     BOOST_REQUIRE_EQUAL(counts[i], 1);
 }
 
+/**
+ * Make sure ShuffleOrdering() gives a permutation and that PermuteColumns()
+ * applies it in-place correctly.
+ */
+BOOST_AUTO_TEST_CASE(PermuteColumnsTest)
+{
+  const arma::uvec ordering = ShuffleOrdering(25);
+
+  // Make sure the ordering is a permutation of [0, 25).
+  BOOST_REQUIRE_EQUAL(ordering.n_elem, 25);
+  arma::Row<size_t> counts(25, arma::fill::zeros);
+  for (size_t i = 0; i < 25; ++i)
+    counts[ordering[i]]++;
+  for (size_t i = 0; i < 25; ++i)
+    BOOST_REQUIRE_EQUAL(counts[i], 1);
+
+  arma::mat data(3, 25, arma::fill::randu);
+  data.row(0) = arma::linspace<arma::rowvec>(0, 24, 25);
+  const arma::mat oldData(data);
+
+  PermuteColumns(data, ordering);
+
+  // Column i of the input should have moved to column ordering[i].
+  for (size_t i = 0; i < 25; ++i)
+  {
+    for (size_t r = 0; r < 3; ++r)
+      BOOST_REQUIRE_CLOSE(data(r, ordering[i]), oldData(r, i), 1e-10);
+  }
+}
+
 /**
  * Make sure shuffling sparse data works.
  */
@@ -1009,4 +1043,242 @@ BOOST_AUTO_TEST_CASE(InplaceSparseShuffleWeightsTest)
   }
 }
 
+/**
+ * Make sure column range aliases of matrices and cube slices are views into
+ * the original memory, not copies.
+ */
+BOOST_AUTO_TEST_CASE(MakeAliasBatchTest)
+{
+  arma::mat data = arma::randu(5, 10);
+  arma::mat batch = MakeAlias(data, 2, 4);
+
+  BOOST_REQUIRE_EQUAL(batch.n_rows, 5);
+  BOOST_REQUIRE_EQUAL(batch.n_cols, 4);
+  BOOST_REQUIRE_EQUAL(batch.memptr(), data.colptr(2));
+
+  // Writing through the alias must modify the original data.
+  batch(0, 0) = 37.0;
+  BOOST_REQUIRE_CLOSE(data(0, 2), 37.0, 1e-5);
+
+  arma::cube sequences = arma::randu<arma::cube>(5, 10, 3);
+  arma::mat stepBatch = MakeAlias(sequences, 1, 3, 4);
+
+  BOOST_REQUIRE_EQUAL(stepBatch.n_rows, 5);
+  BOOST_REQUIRE_EQUAL(stepBatch.n_cols, 4);
+  BOOST_REQUIRE_EQUAL(stepBatch.memptr(), sequences.slice(1).colptr(3));
+
+  stepBatch(1, 1) = 37.0;
+  BOOST_REQUIRE_CLOSE(sequences(1, 4, 1), 37.0, 1e-5);
+}
+
+/**
+ * Make sure the vectorized log-sum reductions agree with AccuLog() on every
+ * column and row, including columns and rows with no mass at all.
+ */
+BOOST_AUTO_TEST_CASE(LogSumExpTest)
+{
+  arma::mat x = arma::randn(25, 40);
+  // Mix in some very small log values and an empty column and row.
+  x.col(3) -= 500.0;
+  x.col(7).fill(-std::numeric_limits<double>::infinity());
+  x.row(11).fill(-std::numeric_limits<double>::infinity());
+
+  arma::vec colSums, rowSums;
+  LogSumExp(x, colSums);
+  LogSumExpT(x, rowSums);
+
+  BOOST_REQUIRE_EQUAL(colSums.n_elem, x.n_cols);
+  BOOST_REQUIRE_EQUAL(rowSums.n_elem, x.n_rows);
+
+  for (size_t j = 0; j < x.n_cols; ++j)
+  {
+    const double expected = AccuLog(arma::vec(x.col(j)));
+    if (std::isfinite(expected))
+      BOOST_REQUIRE_CLOSE(colSums(j), expected, 1e-5);
+    else
+      BOOST_REQUIRE_EQUAL(colSums(j), expected);
+  }
+
+  for (size_t i = 0; i < x.n_rows; ++i)
+  {
+    const double expected = AccuLog(arma::vec(x.row(i).t()));
+    if (std::isfinite(expected))
+      BOOST_REQUIRE_CLOSE(rowSums(i), expected, 1e-5);
+    else
+      BOOST_REQUIRE_EQUAL(rowSums(i), expected);
+  }
+}
+
+/**
+ * The approximate exponential and logarithm must stay within roughly 1e-7
+ * relative error of libm across the usable range, and handle the edges the
+ * same way.
+ */
+BOOST_AUTO_TEST_CASE(FastMathTest)
+{
+  for (size_t trial = 0; trial < 10000; ++trial)
+  {
+    const double x = Random(-700.0, 700.0);
+    BOOST_REQUIRE_CLOSE(FastExp(x), std::exp(x), 1e-5);
+
+    const double y = std::pow(10.0, Random(-300.0, 300.0));
+    BOOST_REQUIRE_CLOSE(FastLog(y), std::log(y), 1e-5);
+  }
+
+  // Edge cases behave like libm.
+  BOOST_REQUIRE_EQUAL(FastExp(-750.0), 0.0);
+  BOOST_REQUIRE_EQUAL(FastExp(750.0),
+      std::numeric_limits<double>::infinity());
+  BOOST_REQUIRE_EQUAL(FastLog(0.0),
+      -std::numeric_limits<double>::infinity());
+  BOOST_REQUIRE(std::isnan(FastLog(-1.0)));
+  BOOST_REQUIRE_CLOSE(FastExp(0.0), 1.0, 1e-10);
+  BOOST_REQUIRE_SMALL(FastLog(1.0), 1e-12);
+
+  // Batch overloads match the scalar kernels.
+  arma::vec x = arma::randn<arma::vec>(100) * 10.0;
+  arma::vec expX, logExpX;
+  FastExp(x, expX);
+  FastLog(expX, logExpX);
+  for (size_t i = 0; i < x.n_elem; ++i)
+  {
+    BOOST_REQUIRE_CLOSE(expX[i], FastExp(x[i]), 1e-12);
+    BOOST_REQUIRE_CLOSE(logExpX[i] + 100.0, x[i] + 100.0, 1e-5);
+  }
+}
+
+/**
+ * The blocked ColumnCovariance() must agree with Armadillo's covariance of the
+ * transposed matrix, for both normalization types.
+ */
+BOOST_AUTO_TEST_CASE(ColumnCovarianceTest)
+{
+  // Use more columns than one block so several blocks get accumulated.
+  arma::mat x = arma::randu<arma::mat>(4, 1000) * 3.0 + 1.0;
+
+  const arma::mat c0 = ColumnCovariance(x, 0);
+  const arma::mat c1 = ColumnCovariance(x, 1);
+
+  const arma::mat ref0 = arma::cov(arma::trans(x), 0);
+  const arma::mat ref1 = arma::cov(arma::trans(x), 1);
+
+  BOOST_REQUIRE_EQUAL(c0.n_rows, ref0.n_rows);
+  BOOST_REQUIRE_EQUAL(c0.n_cols, ref0.n_cols);
+  for (size_t i = 0; i < c0.n_elem; ++i)
+  {
+    BOOST_REQUIRE_CLOSE(c0[i], ref0[i], 1e-8);
+    BOOST_REQUIRE_CLOSE(c1[i], ref1[i], 1e-8);
+  }
+}
+
+/**
+ * Seeding must give a reproducible stream on the calling thread, and different
+ * seeds must give different streams.
+ */
+BOOST_AUTO_TEST_CASE(ThreadLocalRandomSeedTest)
+{
+  math::RandomSeed(42);
+  arma::vec first(10);
+  for (size_t i = 0; i < first.n_elem; ++i)
+    first[i] = math::Random();
+
+  math::RandomSeed(42);
+  arma::vec second(10);
+  for (size_t i = 0; i < second.n_elem; ++i)
+    second[i] = math::Random();
+
+  math::RandomSeed(43);
+  arma::vec third(10);
+  for (size_t i = 0; i < third.n_elem; ++i)
+    third[i] = math::Random();
+
+  for (size_t i = 0; i < first.n_elem; ++i)
+    BOOST_REQUIRE_EQUAL(first[i], second[i]);
+
+  bool anyDifferent = false;
+  for (size_t i = 0; i < first.n_elem; ++i)
+    if (first[i] != third[i])
+      anyDifferent = true;
+  BOOST_REQUIRE(anyDifferent);
+}
+
+/**
+ * The blocked transpose must agree with Armadillo's transpose for a variety
+ * of shapes, including ones that are not multiples of the tile size.
+ */
+BOOST_AUTO_TEST_CASE(BlockedTransposeTest)
+{
+  const size_t rowSizes[5] = { 1, 7, 64, 100, 301 };
+  const size_t colSizes[5] = { 1, 13, 64, 257, 300 };
+
+  for (size_t t = 0; t < 5; ++t)
+  {
+    arma::mat input(rowSizes[t], colSizes[t], arma::fill::randu);
+
+    arma::mat output;
+    BlockedTranspose(input, output);
+
+    arma::mat expected = input.t();
+    BOOST_REQUIRE_EQUAL(output.n_rows, expected.n_rows);
+    BOOST_REQUIRE_EQUAL(output.n_cols, expected.n_cols);
+    for (size_t i = 0; i < expected.n_elem; ++i)
+      BOOST_REQUIRE_EQUAL(output[i], expected[i]);
+  }
+
+  // An empty matrix should just produce an empty result.
+  arma::mat empty, emptyOut;
+  BlockedTranspose(empty, emptyOut);
+  BOOST_REQUIRE_EQUAL(emptyOut.n_elem, 0);
+}
+
+/**
+ * Gathering columns and scattering them back must round-trip, and the
+ * gathered matrix must hold the requested columns in the requested order.
+ */
+BOOST_AUTO_TEST_CASE(GatherScatterColumnsTest)
+{
+  arma::mat input(10, 50, arma::fill::randu);
+
+  // Gather a permutation of the columns.
+  const arma::uvec indices = arma::shuffle(
+      arma::linspace<arma::uvec>(0, input.n_cols - 1, input.n_cols));
+
+  arma::mat gathered;
+  GatherColumns(input, indices, gathered);
+
+  BOOST_REQUIRE_EQUAL(gathered.n_rows, input.n_rows);
+  BOOST_REQUIRE_EQUAL(gathered.n_cols, indices.n_elem);
+  for (size_t j = 0; j < indices.n_elem; ++j)
+    for (size_t i = 0; i < input.n_rows; ++i)
+      BOOST_REQUIRE_EQUAL(gathered(i, j), input(i, indices[j]));
+
+  // Scattering the gathered columns back should reproduce the input.
+  arma::mat scattered(input.n_rows, input.n_cols);
+  ScatterColumns(gathered, indices, scattered);
+  CheckMatrices(scattered, input);
+
+  // Size mismatches must be reported.
+  arma::mat tooSmall(input.n_rows - 1, input.n_cols);
+  BOOST_REQUIRE_THROW(ScatterColumns(gathered, indices, tooSmall),
+      std::invalid_argument);
+  const arma::uvec shortIndices = indices.head(indices.n_elem - 1);
+  BOOST_REQUIRE_THROW(ScatterColumns(gathered, shortIndices, scattered),
+      std::invalid_argument);
+}
+
+/**
+ * GatherRow() must produce a contiguous copy of the requested row segment.
+ */
+BOOST_AUTO_TEST_CASE(GatherRowTest)
+{
+  arma::mat input(8, 30, arma::fill::randu);
+
+  arma::rowvec segment;
+  GatherRow(input, 3, 5, 12, segment);
+
+  BOOST_REQUIRE_EQUAL(segment.n_elem, 12);
+  for (size_t i = 0; i < segment.n_elem; ++i)
+    BOOST_REQUIRE_EQUAL(segment[i], input(3, 5 + i));
+}
+
 BOOST_AUTO_TEST_SUITE_END();
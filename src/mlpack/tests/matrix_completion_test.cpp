@@ -11,6 +11,7 @@
  */
 #include <mlpack/core.hpp>
 #include <mlpack/methods/matrix_completion/matrix_completion.hpp>
+#include <mlpack/methods/matrix_completion/als_matrix_completion.hpp>
 
 #include <boost/test/unit_test.hpp>
 #include "test_tools.hpp"
@@ -64,4 +65,40 @@ BOOST_AUTO_TEST_CASE(UniformMatrixCompletionSDP)
   }
 }
 
+/**
+ * The ALS-based solver should recover the same uniform low-rank matrix to
+ * reasonable accuracy.  The formulation is regularized and non-convex, so the
+ * tolerances are looser than for the SDP.
+ */
+BOOST_AUTO_TEST_CASE(UniformMatrixCompletionALS)
+{
+  arma::mat Xorig, values;
+  arma::umat indices;
+
+  data::Load("completion_X.csv", Xorig, true, false);
+  data::Load("completion_indices.csv", indices, true, false);
+
+  values.set_size(indices.n_cols);
+  for (size_t i = 0; i < indices.n_cols; ++i)
+  {
+    values(i) = Xorig(indices(0, i), indices(1, i));
+  }
+
+  arma::mat recovered;
+  ALSMatrixCompletion mc(Xorig.n_rows, Xorig.n_cols, indices, values, 5,
+      1e-4, 200, 1e-10);
+  mc.Recover(recovered);
+
+  // The observed entries should be fit closely.
+  double squaredError = 0.0, squaredNorm = 0.0;
+  for (size_t i = 0; i < indices.n_cols; ++i)
+  {
+    const double diff = recovered(indices(0, i), indices(1, i)) -
+        Xorig(indices(0, i), indices(1, i));
+    squaredError += diff * diff;
+    squaredNorm += std::pow(Xorig(indices(0, i), indices(1, i)), 2.0);
+  }
+  BOOST_REQUIRE_SMALL(std::sqrt(squaredError / squaredNorm), 0.05);
+}
+
 BOOST_AUTO_TEST_SUITE_END();
@@ -10,9 +10,11 @@
  */
 #include <mlpack/core.hpp>
 #include <mlpack/core/metrics/lmetric.hpp>
+#include <mlpack/core/metrics/mahalanobis_distance.hpp>
 #include <boost/test/unit_test.hpp>
 #include <mlpack/core/metrics/iou_metric.hpp>
 #include <mlpack/core/metrics/non_maximal_supression.hpp>
+#include <mlpack/core/metrics/pairwise_distances.hpp>
 #include "test_tools.hpp"
 
 using namespace std;
@@ -301,4 +303,151 @@ BOOST_AUTO_TEST_CASE(NMSMetricTest)
   CheckMatrices(desiredBoundingBox, selectedBoundingBox);
 }
 
+/**
+ * The batched distance computations must agree with pairwise metric calls,
+ * both on the specialized LMetric paths and on the generic fallback
+ * (Chebyshev distance).
+ */
+BOOST_AUTO_TEST_CASE(PairwiseDistancesTest)
+{
+  arma::mat a = arma::randu(5, 37);
+  arma::mat b = arma::randu(5, 11);
+
+  ManhattanDistance md;
+  EuclideanDistance ed;
+  SquaredEuclideanDistance sed;
+  ChebyshevDistance cd;
+
+  arma::vec oneToMany;
+  arma::mat allPairs;
+
+  // One-to-many distances for each metric.
+  for (size_t i = 0; i < a.n_cols; ++i)
+  {
+    PairwiseDistances(a.col(i), b, oneToMany, md);
+    for (size_t j = 0; j < b.n_cols; ++j)
+      BOOST_REQUIRE_CLOSE(oneToMany[j], md.Evaluate(a.col(i), b.col(j)), 1e-8);
+
+    PairwiseDistances(a.col(i), b, oneToMany, ed);
+    for (size_t j = 0; j < b.n_cols; ++j)
+      BOOST_REQUIRE_CLOSE(oneToMany[j], ed.Evaluate(a.col(i), b.col(j)), 1e-8);
+
+    PairwiseDistances(a.col(i), b, oneToMany, sed);
+    for (size_t j = 0; j < b.n_cols; ++j)
+      BOOST_REQUIRE_CLOSE(oneToMany[j], sed.Evaluate(a.col(i), b.col(j)),
+          1e-8);
+
+    PairwiseDistances(a.col(i), b, oneToMany, cd);
+    for (size_t j = 0; j < b.n_cols; ++j)
+      BOOST_REQUIRE_CLOSE(oneToMany[j], cd.Evaluate(a.col(i), b.col(j)), 1e-8);
+  }
+
+  // All-pairs distances for each metric.
+  PairwiseDistances(a, b, allPairs, md);
+  for (size_t i = 0; i < a.n_cols; ++i)
+    for (size_t j = 0; j < b.n_cols; ++j)
+      BOOST_REQUIRE_CLOSE(allPairs(i, j), md.Evaluate(a.col(i), b.col(j)),
+          1e-8);
+
+  PairwiseDistances(a, b, allPairs, ed);
+  for (size_t i = 0; i < a.n_cols; ++i)
+    for (size_t j = 0; j < b.n_cols; ++j)
+      BOOST_REQUIRE_CLOSE(allPairs(i, j), ed.Evaluate(a.col(i), b.col(j)),
+          1e-8);
+
+  PairwiseDistances(a, b, allPairs, sed);
+  for (size_t i = 0; i < a.n_cols; ++i)
+    for (size_t j = 0; j < b.n_cols; ++j)
+      BOOST_REQUIRE_CLOSE(allPairs(i, j), sed.Evaluate(a.col(i), b.col(j)),
+          1e-8);
+}
+
+/**
+ * The sparse batched distance kernels (index-merge loops for L1, sparse
+ * products for L2) must give the same results as the dense paths.
+ */
+BOOST_AUTO_TEST_CASE(SparsePairwiseDistancesTest)
+{
+  arma::sp_mat a, b;
+  a.sprandu(50, 37, 0.1);
+  b.sprandu(50, 11, 0.1);
+  const arma::mat aDense(a);
+  const arma::mat bDense(b);
+
+  ManhattanDistance md;
+  EuclideanDistance ed;
+  SquaredEuclideanDistance sed;
+
+  arma::vec oneToMany, oneToManyDense;
+  arma::mat allPairs, allPairsDense;
+
+  // One-to-many distances for each specialized metric.
+  for (size_t i = 0; i < a.n_cols; ++i)
+  {
+    PairwiseDistances(a.col(i), b, oneToMany, md);
+    PairwiseDistances(aDense.col(i), bDense, oneToManyDense, md);
+    for (size_t j = 0; j < b.n_cols; ++j)
+      BOOST_REQUIRE_CLOSE(oneToMany[j], oneToManyDense[j], 1e-8);
+
+    PairwiseDistances(a.col(i), b, oneToMany, ed);
+    PairwiseDistances(aDense.col(i), bDense, oneToManyDense, ed);
+    for (size_t j = 0; j < b.n_cols; ++j)
+      BOOST_REQUIRE_CLOSE(oneToMany[j], oneToManyDense[j], 1e-8);
+
+    PairwiseDistances(a.col(i), b, oneToMany, sed);
+    PairwiseDistances(aDense.col(i), bDense, oneToManyDense, sed);
+    for (size_t j = 0; j < b.n_cols; ++j)
+      BOOST_REQUIRE_CLOSE(oneToMany[j], oneToManyDense[j], 1e-8);
+  }
+
+  // All-pairs distances for each specialized metric.
+  PairwiseDistances(a, b, allPairs, md);
+  PairwiseDistances(aDense, bDense, allPairsDense, md);
+  CheckMatrices(allPairs, allPairsDense);
+
+  PairwiseDistances(a, b, allPairs, ed);
+  PairwiseDistances(aDense, bDense, allPairsDense, ed);
+  CheckMatrices(allPairs, allPairsDense);
+
+  PairwiseDistances(a, b, allPairs, sed);
+  PairwiseDistances(aDense, bDense, allPairsDense, sed);
+  CheckMatrices(allPairs, allPairsDense);
+}
+
+/**
+ * Batched Mahalanobis distances must match per-pair evaluation; they are
+ * computed by whitening once and then using plain L2 in the whitened space.
+ */
+BOOST_AUTO_TEST_CASE(PairwiseMahalanobisDistancesTest)
+{
+  arma::mat a = arma::randu(5, 23);
+  arma::mat b = arma::randu(5, 9);
+
+  // Build a random symmetric positive definite covariance matrix.
+  arma::mat l = arma::randn<arma::mat>(5, 5);
+  MahalanobisDistance<false> md(l * l.t() + 5.0 * arma::eye<arma::mat>(5, 5));
+  MahalanobisDistance<true> mdRoot(md.Covariance());
+
+  arma::vec oneToMany;
+  arma::mat allPairs;
+
+  for (size_t i = 0; i < a.n_cols; ++i)
+  {
+    PairwiseDistances(a.col(i), b, oneToMany, md);
+    for (size_t j = 0; j < b.n_cols; ++j)
+      BOOST_REQUIRE_CLOSE(oneToMany[j], md.Evaluate(a.col(i), b.col(j)), 1e-8);
+
+    PairwiseDistances(a.col(i), b, oneToMany, mdRoot);
+    for (size_t j = 0; j < b.n_cols; ++j)
+      BOOST_REQUIRE_CLOSE(oneToMany[j], mdRoot.Evaluate(a.col(i), b.col(j)),
+          1e-8);
+  }
+
+  PairwiseDistances(a, b, allPairs, md);
+  for (size_t i = 0; i < a.n_cols; ++i)
+    for (size_t j = 0; j < b.n_cols; ++j)
+      BOOST_REQUIRE_CLOSE(allPairs(i, j), md.Evaluate(a.col(i), b.col(j)),
+          1e-8);
+}
+
 BOOST_AUTO_TEST_SUITE_END();
@@ -249,6 +249,47 @@ BOOST_AUTO_TEST_CASE(SoftmaxSeparableGradient)
   BOOST_REQUIRE_CLOSE(gradient(1, 1), -2.0 * -0.1435886, 0.01);
 }
 
+/**
+ * With two well-separated clusters, the neighborhood-sampled separable
+ * objective and gradient should match the exact ones very closely: the
+ * contribution of points outside the neighborhood decays as
+ * exp(-distance^2).
+ */
+BOOST_AUTO_TEST_CASE(SoftmaxSampledNeighborhood)
+{
+  // Two clusters of six points each, far apart on the first dimension.
+  arma::mat data           = "-500 -500 -500 -500 -500 -500 "
+                             " 500  500  500  500  500  500;"
+                             "  -1    0    1    2    3    4 "
+                             "  -1    0    1    2    3    4 ";
+  arma::Row<size_t> labels = "   0    0    0    0    0    0 "
+                             "   1    1    1    1    1    1 ";
+
+  SoftmaxErrorFunction<SquaredEuclideanDistance> exact(data, labels);
+  SoftmaxErrorFunction<SquaredEuclideanDistance> sampled(data, labels);
+  sampled.NeighborhoodSize() = 5; // The rest of the cluster.
+
+  arma::mat coordinates = arma::eye<arma::mat>(2, 2);
+
+  arma::mat exactGradient(2, 2), sampledGradient(2, 2);
+  for (size_t i = 0; i < data.n_cols; ++i)
+  {
+    BOOST_REQUIRE_CLOSE(exact.Evaluate(coordinates, i, 1),
+                        sampled.Evaluate(coordinates, i, 1), 1e-8);
+
+    exact.Gradient(coordinates, i, exactGradient, 1);
+    sampled.Gradient(coordinates, i, sampledGradient, 1);
+
+    for (size_t j = 0; j < exactGradient.n_elem; ++j)
+    {
+      if (std::abs(exactGradient[j]) > 1e-8)
+        BOOST_REQUIRE_CLOSE(exactGradient[j], sampledGradient[j], 1e-5);
+      else
+        BOOST_REQUIRE_SMALL(sampledGradient[j], 1e-8);
+    }
+  }
+}
+
 //
 // Tests for the NCA algorithm.
 //
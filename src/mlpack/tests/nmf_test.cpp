@@ -16,6 +16,7 @@
 #include <mlpack/methods/amf/update_rules/nmf_mult_div.hpp>
 #include <mlpack/methods/amf/update_rules/nmf_als.hpp>
 #include <mlpack/methods/amf/update_rules/nmf_mult_dist.hpp>
+#include <mlpack/methods/amf/update_rules/nmf_mult_dist_blocked.hpp>
 
 #include <boost/test/unit_test.hpp>
 #include "test_tools.hpp"
@@ -69,6 +70,52 @@ BOOST_AUTO_TEST_CASE(NMFAcolDistTest)
       0.015);
 }
 
+/**
+ * Check the if the product of the calculated factorization is close to the
+ * input matrix, using the blocked parallel distance minimization update.
+ */
+BOOST_AUTO_TEST_CASE(NMFBlockedDistTest)
+{
+  mat w = randu<mat>(20, 12);
+  mat h = randu<mat>(12, 20);
+  mat v = w * h;
+  const size_t r = 12;
+
+  SimpleResidueTermination srt(1e-7, 10000);
+  AMF<SimpleResidueTermination,
+      RandomAcolInitialization<>,
+      NMFBlockedMultiplicativeDistanceUpdate> nmf(srt);
+  nmf.Apply(v, r, w, h);
+
+  mat wh = w * h;
+
+  BOOST_REQUIRE_SMALL(arma::norm(v - wh, "fro") / arma::norm(v, "fro"),
+      0.015);
+}
+
+/**
+ * Check that the blocked parallel distance minimization update also works on
+ * matrices larger than one tile, so that the tile boundaries are exercised.
+ */
+BOOST_AUTO_TEST_CASE(NMFBlockedDistLargeTest)
+{
+  mat w = randu<mat>(600, 6);
+  mat h = randu<mat>(6, 550);
+  mat v = w * h;
+  const size_t r = 6;
+
+  SimpleResidueTermination srt(1e-7, 10000);
+  AMF<SimpleResidueTermination,
+      RandomAcolInitialization<>,
+      NMFBlockedMultiplicativeDistanceUpdate> nmf(srt);
+  nmf.Apply(v, r, w, h);
+
+  mat wh = w * h;
+
+  BOOST_REQUIRE_SMALL(arma::norm(v - wh, "fro") / arma::norm(v, "fro"),
+      0.015);
+}
+
 /**
  * Check the if the product of the calculated factorization is close to the
  * input matrix. Random initialization divergence minimization update.
@@ -11,7 +11,9 @@
  * http://www.opensource.org/licenses/BSD-3-Clause for more information.
  */
 #include <mlpack/core.hpp>
+#include <mlpack/methods/pca/incremental_pca.hpp>
 #include <mlpack/methods/pca/pca.hpp>
+#include <mlpack/methods/pca/decomposition_policies/auto_svd_method.hpp>
 #include <mlpack/methods/pca/decomposition_policies/exact_svd_method.hpp>
 #include <mlpack/methods/pca/decomposition_policies/quic_svd_method.hpp>
 #include <mlpack/methods/pca/decomposition_policies/randomized_svd_method.hpp>
@@ -207,6 +209,15 @@ BOOST_AUTO_TEST_CASE(ArmaComparisonRandomizedPCATest)
   ArmaComparisonPCA<RandomizedSVDPolicy>();
 }
 
+/**
+ * Compare the output of our automatically dispatched PCA implementation with
+ * Armadillo's.
+ */
+BOOST_AUTO_TEST_CASE(ArmaComparisonAutoPCATest)
+{
+  ArmaComparisonPCA<AutoSVDPolicy>();
+}
+
 /**
  * Test that dimensionality reduction with exact-svd PCA works the same way
  * MATLAB does (which should be correct!).
@@ -216,6 +227,44 @@ BOOST_AUTO_TEST_CASE(ExactPCADimensionalityReductionTest)
   PCADimensionalityReduction<ExactSVDPolicy>();
 }
 
+/**
+ * Test that dimensionality reduction with the automatic policy works the same
+ * way MATLAB does (which should be correct!).
+ */
+BOOST_AUTO_TEST_CASE(AutoPCADimensionalityReductionTest)
+{
+  PCADimensionalityReduction<AutoSVDPolicy>();
+}
+
+/**
+ * Test that the automatic policy agrees with the exact policy on a matrix
+ * that is large enough to take the truncated branch.
+ */
+BOOST_AUTO_TEST_CASE(AutoPCATruncatedBranchTest)
+{
+  // 150 dimensions with 500 points and a requested rank of 10 dispatches to a
+  // truncated decomposition.  Give the data a dominant rank-10 structure so
+  // that the randomized estimate is accurate.
+  arma::mat data = arma::randn<arma::mat>(150, 10) *
+      arma::randn<arma::mat>(10, 500) +
+      0.01 * arma::randn<arma::mat>(150, 500);
+  arma::mat dataCopy(data);
+
+  PCA<ExactSVDPolicy> exactPCA;
+  exactPCA.Apply(data, (size_t) 10);
+
+  PCA<AutoSVDPolicy> autoPCA;
+  autoPCA.Apply(dataCopy, (size_t) 10);
+
+  BOOST_REQUIRE_EQUAL(data.n_rows, dataCopy.n_rows);
+  BOOST_REQUIRE_EQUAL(data.n_cols, dataCopy.n_cols);
+
+  // The variance along each principal component (the eigenvalues) must match.
+  for (size_t i = 0; i < data.n_rows; ++i)
+    BOOST_REQUIRE_CLOSE(arma::var(data.row(i)), arma::var(dataCopy.row(i)),
+        5.0);
+}
+
 /**
  * Test that dimensionality reduction with randomized block krylov PCA works the
  * same way MATLAB does (which should be correct!).
@@ -337,5 +386,91 @@ BOOST_AUTO_TEST_CASE(PCAScalingTest)
   BOOST_REQUIRE_CLOSE(accu(eigval), 3.0, 0.1); // 10% tolerance.
 }
 
+/**
+ * Test that IncrementalPCA fed with chunks gives the same basis as batch PCA
+ * on the full dataset.
+ */
+BOOST_AUTO_TEST_CASE(IncrementalPCAChunkedTest)
+{
+  arma::mat data = arma::randu<arma::mat>(5, 1000);
+
+  // Batch PCA results.
+  PCA<> p;
+  arma::mat score;
+  arma::vec eigVal;
+  arma::mat eigvec;
+  p.Apply(data, score, eigVal, eigvec);
+
+  // Feed the data in uneven chunks.
+  IncrementalPCA ipca;
+  ipca.Update(data.cols(0, 299));
+  ipca.Update(data.cols(300, 699));
+  ipca.Update(data.cols(700, 999));
+
+  BOOST_REQUIRE_EQUAL(ipca.Count(), 1000);
+
+  arma::vec incEigVal;
+  arma::mat incEigvec;
+  ipca.Apply(incEigVal, incEigvec);
+
+  for (size_t i = 0; i < eigVal.n_elem; ++i)
+    BOOST_REQUIRE_CLOSE(eigVal[i], incEigVal[i], 1e-5);
+
+  // Eigenvectors may differ in sign.
+  for (size_t i = 0; i < eigvec.n_cols; ++i)
+  {
+    const double dot = arma::dot(eigvec.col(i), incEigvec.col(i));
+    BOOST_REQUIRE_CLOSE(std::abs(dot), 1.0, 1e-5);
+  }
+
+  // Projections must match up to the sign of each component.
+  arma::mat incScore;
+  ipca.Transform(data, incScore);
+  for (size_t i = 0; i < score.n_rows; ++i)
+  {
+    const double dot = arma::dot(eigvec.col(i), incEigvec.col(i));
+    for (size_t j = 0; j < score.n_cols; ++j)
+    {
+      if (std::abs(score(i, j)) < 1e-8)
+        BOOST_REQUIRE_SMALL(incScore(i, j), 1e-8);
+      else
+        BOOST_REQUIRE_CLOSE(dot * score(i, j), incScore(i, j), 1e-5);
+    }
+  }
+}
+
+/**
+ * Test that merging two partial IncrementalPCA states gives exactly the state
+ * of a single pass over the concatenated shards.
+ */
+BOOST_AUTO_TEST_CASE(IncrementalPCAMergeTest)
+{
+  arma::mat data = arma::randu<arma::mat>(4, 800);
+
+  IncrementalPCA full;
+  full.Update(data);
+
+  IncrementalPCA shardA;
+  shardA.Update(data.cols(0, 499));
+  IncrementalPCA shardB;
+  shardB.Update(data.cols(500, 799));
+
+  shardA.Merge(shardB);
+
+  BOOST_REQUIRE_EQUAL(shardA.Count(), full.Count());
+
+  arma::vec fullEigVal, mergedEigVal;
+  arma::mat fullEigvec, mergedEigvec;
+  full.Apply(fullEigVal, fullEigvec);
+  shardA.Apply(mergedEigVal, mergedEigvec);
+
+  CheckMatrices(fullEigVal, mergedEigVal);
+  CheckMatrices(fullEigvec, mergedEigvec);
+
+  // Merging mismatched dimensionalities should be refused.
+  IncrementalPCA wrongDim;
+  wrongDim.Update(arma::randu<arma::mat>(6, 10));
+  BOOST_REQUIRE_THROW(shardA.Merge(wrongDim), std::invalid_argument);
+}
 
 BOOST_AUTO_TEST_SUITE_END();
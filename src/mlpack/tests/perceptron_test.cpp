@@ -208,6 +208,57 @@ BOOST_AUTO_TEST_CASE(TwoPoints)
   BOOST_CHECK_EQUAL(predictedLabels(0, 1), 1);
 }
 
+/**
+ * This tests that the batched trainer converges to a perfect classifier on a
+ * linearly separable dataset with 3 classes, and terminates once it does.
+ */
+BOOST_AUTO_TEST_CASE(TrainBatchRandom3)
+{
+  mat trainData;
+  trainData << 0 << 1 << 1 << 4 << 5 << 4 << 1 << 2 << 1 << endr
+            << 1 << 0 << 1 << 1 << 1 << 2 << 4 << 5 << 4 << endr;
+
+  Mat<size_t> labels;
+  labels << 0 << 0 << 0 << 1 << 1 << 1 << 2 << 2 << 2;
+
+  Perceptron<> p(3, trainData.n_rows, 1000);
+  p.TrainBatch(trainData, labels.row(0), 3);
+
+  // A violation-free epoch means the training data itself must be perfectly
+  // classified.
+  Row<size_t> predictedLabels(trainData.n_cols);
+  p.Classify(trainData, predictedLabels);
+
+  for (size_t i = 0; i < predictedLabels.n_cols; i++)
+    BOOST_CHECK_EQUAL(predictedLabels(0, i), labels(0, i));
+}
+
+/**
+ * The batched trainer should also handle instance weights, since it may be
+ * used for boosting; make sure the weighted path converges too.
+ */
+BOOST_AUTO_TEST_CASE(TrainBatchInstanceWeights)
+{
+  mat trainData;
+  trainData << 0 << 1 << 1 << 4 << 5 << 4 << 1 << 2 << 1 << endr
+            << 1 << 0 << 1 << 1 << 1 << 2 << 4 << 5 << 4 << endr;
+
+  Mat<size_t> labels;
+  labels << 0 << 0 << 0 << 1 << 1 << 1 << 2 << 2 << 2;
+
+  rowvec instanceWeights(trainData.n_cols);
+  instanceWeights.fill(0.5);
+
+  Perceptron<> p(3, trainData.n_rows, 1000);
+  p.TrainBatch(trainData, labels.row(0), 3, instanceWeights);
+
+  Row<size_t> predictedLabels(trainData.n_cols);
+  p.Classify(trainData, predictedLabels);
+
+  for (size_t i = 0; i < predictedLabels.n_cols; i++)
+    BOOST_CHECK_EQUAL(predictedLabels(0, i), labels(0, i));
+}
+
 /**
  * This tests the convergence of the perceptron on a dataset which has a
  * non-linearly separable dataset.
@@ -120,6 +120,47 @@ BOOST_AUTO_TEST_CASE(CartPoleWithDQN)
   BOOST_REQUIRE(converged);
 }
 
+//! Test vectorized multi-environment rollouts in Cart Pole task.
+BOOST_AUTO_TEST_CASE(CartPoleWithDQNParallelRollouts)
+{
+  // Set up the network.
+  SimpleDQN<> network(4, 128, 128, 2);
+
+  // Set up the policy and replay method.
+  GreedyPolicy<CartPole> policy(1.0, 1000, 0.1, 0.99);
+  RandomReplay<CartPole> replayMethod(10, 10000);
+
+  TrainingConfig config;
+  config.StepSize() = 0.01;
+  config.Discount() = 0.9;
+  config.TargetNetworkSyncInterval() = 100;
+  config.ExplorationSteps() = 100;
+  config.DoubleQLearning() = false;
+  config.StepLimit() = 200;
+
+  // Set up DQN agent.
+  QLearning<CartPole, decltype(network), AdamUpdate, decltype(policy)>
+      agent(config, network, policy, replayMethod);
+
+  // Roll out four environments at a time; the same replay buffer and network
+  // are trained, so the returns must stay finite and steps must accumulate
+  // across all instances.
+  const size_t stepsBefore = agent.TotalSteps();
+  for (size_t i = 0; i < 10; ++i)
+  {
+    const double averageReturn = agent.ParallelEpisodes(4);
+    BOOST_REQUIRE(std::isfinite(averageReturn));
+  }
+  BOOST_REQUIRE_GT(agent.TotalSteps(), stepsBefore);
+  BOOST_REQUIRE(agent.Network().Parameters().is_finite());
+
+  // The deterministic mode must work on parallel rollouts as well.
+  agent.Deterministic() = true;
+  const size_t deterministicSteps = agent.TotalSteps();
+  BOOST_REQUIRE(std::isfinite(agent.ParallelEpisodes(4)));
+  BOOST_REQUIRE_EQUAL(agent.TotalSteps(), deterministicSteps);
+}
+
 //! Test DQN in Cart Pole task with Prioritized Replay.
 BOOST_AUTO_TEST_CASE(CartPoleWithDQNPrioritizedReplay)
 {
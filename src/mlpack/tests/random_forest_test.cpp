@@ -10,7 +10,9 @@
  * http://www.opensource.org/licenses/BSD-3-Clause for more information.
  */
 #include <mlpack/core.hpp>
+#include <mlpack/core/data/shard.hpp>
 #include <mlpack/methods/random_forest/random_forest.hpp>
+#include <mlpack/methods/random_forest/flat_forest.hpp>
 #include <mlpack/methods/decision_tree/random_dimension_select.hpp>
 
 #include <boost/test/unit_test.hpp>
@@ -96,6 +98,34 @@ BOOST_AUTO_TEST_CASE(BootstrapWeightsTest)
   }
 }
 
+/**
+ * Make sure index-based bootstrap sampling gives valid indices, and that the
+ * out-of-bag indices are exactly the points that were never sampled.
+ */
+BOOST_AUTO_TEST_CASE(BootstrapIndicesTest)
+{
+  for (size_t trial = 0; trial < 5; ++trial)
+  {
+    arma::uvec indices, oobIndices;
+    BootstrapIndices(1000, indices, oobIndices);
+
+    BOOST_REQUIRE_EQUAL(indices.n_elem, 1000);
+
+    arma::uvec inBag(1000, arma::fill::zeros);
+    for (size_t i = 0; i < indices.n_elem; ++i)
+    {
+      BOOST_REQUIRE_LT(indices[i], 1000);
+      inBag[indices[i]] = 1;
+    }
+
+    // Every out-of-bag index must be unsampled, and together they must cover
+    // all unsampled points.
+    BOOST_REQUIRE_EQUAL(oobIndices.n_elem, 1000 - arma::accu(inBag));
+    for (size_t i = 0; i < oobIndices.n_elem; ++i)
+      BOOST_REQUIRE_EQUAL(inBag[oobIndices[i]], 0);
+  }
+}
+
 /**
  * Make sure an empty forest cannot predict.
  */
@@ -152,6 +182,42 @@ BOOST_AUTO_TEST_CASE(UnweightedNumericLearningTest)
   BOOST_REQUIRE_GE(rfCorrect, size_t(0.7 * testDataset.n_cols));
 }
 
+/**
+ * Test that the out-of-bag accuracy computed during training is a reasonable
+ * estimate of held-out accuracy.
+ */
+BOOST_AUTO_TEST_CASE(OOBAccuracyTest)
+{
+  // An untrained forest has no out-of-bag estimate.
+  RandomForest<> emptyRf;
+  BOOST_REQUIRE_EQUAL(emptyRf.OOBAccuracy(), 0.0);
+
+  // Load the vc2 dataset.
+  arma::mat dataset;
+  data::Load("vc2.csv", dataset);
+  arma::Row<size_t> labels;
+  data::Load("vc2_labels.txt", labels);
+
+  RandomForest<> rf(dataset, labels, 3, 20 /* 20 trees */, 1, 1e-7);
+
+  // With 20 trees, essentially every point is out-of-bag for some tree.
+  BOOST_REQUIRE_GT(rf.OOBAccuracy(), 0.0);
+  BOOST_REQUIRE_LE(rf.OOBAccuracy(), 1.0);
+
+  // The out-of-bag estimate should be in the same range as held-out accuracy.
+  arma::mat testDataset;
+  data::Load("vc2_test.csv", testDataset);
+  arma::Row<size_t> testLabels;
+  data::Load("vc2_test_labels.txt", testLabels);
+
+  arma::Row<size_t> predictions;
+  rf.Classify(testDataset, predictions);
+  const double testAccuracy = arma::accu(predictions == testLabels) /
+      (double) testDataset.n_cols;
+
+  BOOST_REQUIRE_GE(rf.OOBAccuracy(), 0.75 * testAccuracy);
+}
+
 /**
  * Test weighted numeric learning, making sure that we get better performance
  * than a single decision tree.
@@ -487,4 +553,100 @@ BOOST_AUTO_TEST_CASE(DifferentTreesTest)
   BOOST_REQUIRE_EQUAL(success, true);
 }
 
+/**
+ * Test that a flattened forest gives exactly the same predictions and
+ * probabilities as the forest it was built from.
+ */
+BOOST_AUTO_TEST_CASE(FlatForestEquivalenceTest)
+{
+  // Load the vc2 dataset.
+  arma::mat dataset;
+  data::Load("vc2.csv", dataset);
+  arma::Row<size_t> labels;
+  data::Load("vc2_labels.txt", labels);
+
+  RandomForest<> rf(dataset, labels, 3, 20 /* 20 trees */, 1, 1e-7);
+  FlatForest<RandomForest<>> ff(rf);
+
+  BOOST_REQUIRE_EQUAL(ff.NumTrees(), rf.NumTrees());
+  BOOST_REQUIRE_EQUAL(ff.NumClasses(), 3);
+
+  arma::mat testDataset;
+  data::Load("vc2_test.csv", testDataset);
+
+  arma::Row<size_t> rfPredictions, ffPredictions;
+  arma::mat rfProbabilities, ffProbabilities;
+  rf.Classify(testDataset, rfPredictions, rfProbabilities);
+  ff.Classify(testDataset, ffPredictions, ffProbabilities);
+
+  CheckMatrices(rfPredictions, ffPredictions);
+  for (size_t i = 0; i < rfProbabilities.n_elem; ++i)
+  {
+    if (std::abs(rfProbabilities[i]) < 1e-5)
+      BOOST_REQUIRE_SMALL(ffProbabilities[i], 1e-5);
+    else
+      BOOST_REQUIRE_CLOSE(rfProbabilities[i], ffProbabilities[i], 1e-5);
+  }
+}
+
+/**
+ * Test that forests trained on column shards of a dataset merge into one
+ * ensemble that holds all the trees and still classifies sensibly.
+ */
+BOOST_AUTO_TEST_CASE(RandomForestMergeTest)
+{
+  // Load the vc2 dataset.
+  arma::mat dataset;
+  data::Load("vc2.csv", dataset);
+  arma::Row<size_t> labels;
+  data::Load("vc2_labels.txt", labels);
+
+  // Train one forest per shard, as a data-parallel driver would.
+  RandomForest<> merged;
+  const size_t numWorkers = 2;
+  for (size_t worker = 0; worker < numWorkers; ++worker)
+  {
+    arma::mat shard;
+    arma::Row<size_t> shardLabels;
+    data::ShardColumns(dataset, worker, numWorkers, shard);
+    data::ShardColumns(labels, worker, numWorkers, shardLabels);
+
+    RandomForest<> rf(shard, shardLabels, 3, 10 /* 10 trees */);
+    merged.Merge(std::move(rf));
+  }
+
+  BOOST_REQUIRE_EQUAL(merged.NumTrees(), numWorkers * 10);
+
+  // The merged forest should classify the training set reasonably well.
+  arma::Row<size_t> predictions;
+  merged.Classify(dataset, predictions);
+  size_t correct = 0;
+  for (size_t i = 0; i < labels.n_elem; ++i)
+    if (predictions[i] == labels[i])
+      ++correct;
+
+  BOOST_REQUIRE_GT(double(correct) / double(labels.n_elem), 0.75);
+}
+
+/**
+ * Test that forests that cannot be flattened are rejected.
+ */
+BOOST_AUTO_TEST_CASE(FlatForestInvalidTest)
+{
+  // An untrained forest cannot be flattened.
+  RandomForest<> emptyRf;
+  BOOST_REQUIRE_THROW(FlatForest<RandomForest<>> ff(emptyRf),
+      std::invalid_argument);
+
+  // A forest with categorical (multiway) splits cannot be flattened.
+  arma::mat d;
+  arma::Row<size_t> l;
+  data::DatasetInfo di;
+  MockCategoricalData(d, l, di);
+
+  RandomForest<> rf(d, di, l, 5, 15 /* 15 trees */, 1);
+  BOOST_REQUIRE_THROW(FlatForest<RandomForest<>> ff(rf),
+      std::invalid_argument);
+}
+
 BOOST_AUTO_TEST_SUITE_END();
@@ -13,6 +13,7 @@
 #include <mlpack/methods/range_search/range_search.hpp>
 #include <mlpack/core/tree/cover_tree.hpp>
 #include <mlpack/methods/range_search/rs_model.hpp>
+#include <mlpack/methods/range_search/streaming_range_search.hpp>
 #include <boost/test/unit_test.hpp>
 #include "test_tools.hpp"
 
@@ -1696,4 +1697,49 @@ BOOST_AUTO_TEST_CASE(MoveOperatorNaiveTest)
   }
 }
 
+/**
+ * Make sure that StreamingRangeSearch over chunks of the reference set gives
+ * exactly the same results as RangeSearch over the full reference set, both
+ * for chunk sizes that divide the set evenly and for ones that do not.
+ */
+BOOST_AUTO_TEST_CASE(StreamingRangeSearchTest)
+{
+  arma::mat referenceData = arma::randu<arma::mat>(3, 1000);
+  arma::mat queryData = arma::randu<arma::mat>(3, 150);
+  const Range range(0.25, 1.05);
+
+  RangeSearch<> rs(referenceData);
+  vector<vector<size_t>> neighbors;
+  vector<vector<double>> distances;
+  rs.Search(queryData, range, neighbors, distances);
+  vector<vector<pair<double, size_t>>> sorted;
+  SortResults(neighbors, distances, sorted);
+
+  for (const size_t chunkSize : { 100, 333, 2000 })
+  {
+    StreamingRangeSearch<> streaming;
+    vector<vector<size_t>> streamNeighbors;
+    vector<vector<double>> streamDistances;
+    streaming.Search(referenceData, queryData, range, chunkSize,
+        streamNeighbors, streamDistances);
+
+    BOOST_REQUIRE_EQUAL(streaming.NumPointsProcessed(), 1000);
+
+    vector<vector<pair<double, size_t>>> sortedStream;
+    SortResults(streamNeighbors, streamDistances, sortedStream);
+
+    for (size_t i = 0; i < sorted.size(); ++i)
+    {
+      BOOST_REQUIRE_EQUAL(sortedStream[i].size(), sorted[i].size());
+
+      for (size_t j = 0; j < sorted[i].size(); ++j)
+      {
+        BOOST_REQUIRE_EQUAL(sortedStream[i][j].second, sorted[i][j].second);
+        BOOST_REQUIRE_CLOSE(sortedStream[i][j].first, sorted[i][j].first,
+            1e-5);
+      }
+    }
+  }
+}
+
 BOOST_AUTO_TEST_SUITE_END();
@@ -565,6 +565,54 @@ BOOST_AUTO_TEST_CASE(SingleTreeTraverserTest)
   }
 }
 
+/**
+ * A test to ensure that an STR bulk-loaded tree is structurally valid (all
+ * invariants hold, every point is present exactly once) and returns exact
+ * nearest neighbor results.
+ */
+BOOST_AUTO_TEST_CASE(BulkLoadConstructionTest)
+{
+  arma::mat dataset;
+  dataset.randu(8, 1000); // 1000 points in 8 dimensions.
+
+  typedef RTree<EuclideanDistance, NeighborSearchStat<NearestNeighborSort>,
+      arma::mat> TreeType;
+  TreeType rTree(dataset, 20, 8, 5, 2, 0, true /* bulk load */);
+
+  BOOST_REQUIRE_EQUAL(rTree.NumDescendants(), 1000);
+
+  CheckContainment(rTree);
+  CheckExactContainment(rTree);
+  CheckHierarchy(rTree);
+  CheckNumDescendants(rTree);
+
+  // Every point must appear exactly once.
+  std::vector<size_t> pointCounts(1000, 0);
+  for (size_t i = 0; i < rTree.NumDescendants(); ++i)
+    pointCounts[rTree.Descendant(i)]++;
+  for (size_t i = 0; i < pointCounts.size(); ++i)
+    BOOST_REQUIRE_EQUAL(pointCounts[i], 1);
+
+  // Nearest neighbor search with the bulk-loaded tree.
+  arma::Mat<size_t> neighbors1;
+  arma::mat distances1;
+  NeighborSearch<NearestNeighborSort, metric::LMetric<2, true>, arma::mat,
+      RTree> knn1(std::move(rTree), SINGLE_TREE_MODE);
+  knn1.Search(5, neighbors1, distances1);
+
+  // Nearest neighbor search the naive way.
+  arma::Mat<size_t> neighbors2;
+  arma::mat distances2;
+  KNN knn2(dataset, NAIVE_MODE);
+  knn2.Search(5, neighbors2, distances2);
+
+  for (size_t i = 0; i < neighbors1.size(); i++)
+  {
+    BOOST_REQUIRE_EQUAL(neighbors1[i], neighbors2[i]);
+    BOOST_REQUIRE_EQUAL(distances1[i], distances2[i]);
+  }
+}
+
 // A test to ensure that the SingleTreeTraverser is working correctly by
 // comparing its results to the results of a naive search.
 BOOST_AUTO_TEST_CASE(XTreeTraverserTest)
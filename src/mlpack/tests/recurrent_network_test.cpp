@@ -144,6 +144,49 @@ BOOST_AUTO_TEST_CASE(SequenceClassificationBRNNTest)
   BOOST_REQUIRE_GE(successes, 1);
 }
 
+/**
+ * Test that the in-place shuffle permutes the sequences without losing any of
+ * them, and keeps predictors and responses paired.
+ */
+BOOST_AUTO_TEST_CASE(RNNShuffleTest)
+{
+  const size_t points = 10, rho = 5;
+  RNN<NegativeLogLikelihood<> > model(rho);
+
+  // Tag each sequence with its index in every timestep.
+  arma::cube predictors(3, points, rho, arma::fill::randu);
+  arma::cube responses(1, points, rho);
+  for (size_t i = 0; i < points; ++i)
+  {
+    predictors.subcube(0, i, 0, 0, i, rho - 1).fill((double) i);
+    responses.subcube(0, i, 0, 0, i, rho - 1).fill((double) i);
+  }
+
+  model.Predictors() = predictors;
+  model.Responses() = responses;
+  model.Shuffle();
+
+  arma::Row<size_t> counts(points, arma::fill::zeros);
+  for (size_t i = 0; i < points; ++i)
+  {
+    const size_t index = (size_t) model.Predictors()(0, i, 0);
+
+    // The predictor column must move together with its response column, and
+    // all timesteps of a sequence must move together.
+    for (size_t t = 0; t < rho; ++t)
+    {
+      BOOST_REQUIRE_EQUAL((size_t) model.Predictors()(0, i, t), index);
+      BOOST_REQUIRE_EQUAL((size_t) model.Responses()(0, i, t), index);
+    }
+
+    counts[index]++;
+  }
+
+  // Make sure we only have each sequence once.
+  for (size_t i = 0; i < points; ++i)
+    BOOST_REQUIRE_EQUAL(counts[i], 1);
+}
+
 /**
  * Train the vanilla network on a larger dataset.
  */
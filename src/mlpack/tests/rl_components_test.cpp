@@ -20,6 +20,7 @@
 #include <mlpack/methods/reinforcement_learning/environment/continuous_double_pole_cart.hpp>
 #include <mlpack/methods/reinforcement_learning/environment/acrobot.hpp>
 #include <mlpack/methods/reinforcement_learning/environment/pendulum.hpp>
+#include <mlpack/methods/reinforcement_learning/replay/concurrent_random_replay.hpp>
 #include <mlpack/methods/reinforcement_learning/replay/random_replay.hpp>
 #include <mlpack/methods/reinforcement_learning/policy/greedy_policy.hpp>
 
@@ -266,6 +267,56 @@ BOOST_AUTO_TEST_CASE(RandomReplayTest)
   }
 }
 
+/**
+ * Construct a sharded concurrent replay instance and check if it works as
+ * it should be.
+ */
+BOOST_AUTO_TEST_CASE(ConcurrentRandomReplayTest)
+{
+  // Four transitions spread over two shards of two slots each.
+  ConcurrentRandomReplay<MountainCar> replay(1, 4, 2);
+  MountainCar env;
+  MountainCar::State state = env.InitialSample();
+  MountainCar::Action action = MountainCar::Action::forward;
+  MountainCar::State nextState;
+  double reward = env.Sample(state, action, nextState);
+  replay.Store(state, action, reward, nextState, env.IsTerminal(nextState));
+  arma::mat sampledState;
+  arma::icolvec sampledAction;
+  arma::colvec sampledReward;
+  arma::mat sampledNextState;
+  arma::icolvec sampledTerminal;
+
+  //! So far there should be only one record in the memory
+  replay.Sample(sampledState, sampledAction, sampledReward, sampledNextState,
+      sampledTerminal);
+
+  CheckMatrices(state.Encode(), sampledState);
+  BOOST_REQUIRE_EQUAL(action, arma::as_scalar(sampledAction));
+  BOOST_REQUIRE_CLOSE(reward, arma::as_scalar(sampledReward), 1e-5);
+  CheckMatrices(nextState.Encode(), sampledNextState);
+  BOOST_REQUIRE_EQUAL(false, arma::as_scalar(sampledTerminal));
+  BOOST_REQUIRE_EQUAL(1, replay.Size());
+
+  //! Overwrite the memory with a nonsense record; the calling thread only
+  //! writes into its own shard, so its ring wraps at the shard capacity.
+  for (size_t i = 0; i < 5; ++i)
+    replay.Store(nextState, action, reward, state, true);
+
+  BOOST_REQUIRE_EQUAL(2, replay.Size());
+
+  //! Sample several times, the original record shouldn't appear
+  for (size_t i = 0; i < 30; ++i)
+  {
+    replay.Sample(sampledState, sampledAction, sampledReward, sampledNextState,
+        sampledTerminal);
+
+    CheckMatrices(state.Encode(), sampledNextState);
+    CheckMatrices(nextState.Encode(), sampledState);
+    BOOST_REQUIRE_EQUAL(true, arma::as_scalar(sampledTerminal));
+  }
+}
+
 /**
  * Construct a greedy policy instance and check if it works as
  * it should be.
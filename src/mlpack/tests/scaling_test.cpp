@@ -15,6 +15,7 @@
 #include <mlpack/core/data/scaler_methods/max_abs_scaler.hpp>
 #include <mlpack/core/data/scaler_methods/standard_scaler.hpp>
 #include <mlpack/core/data/scaler_methods/mean_normalization.hpp>
+#include <mlpack/core/data/scaler_methods/hashed_interaction_expansion.hpp>
 
 #include <boost/test/unit_test.hpp>
 #include "test_tools.hpp"
@@ -60,6 +61,31 @@ BOOST_AUTO_TEST_CASE(MaxAbsScalerTest)
   CheckMatrices(dataset, temp);
 }
 
+/**
+ * The sparse MaxAbsScaler transform must agree with the dense one and must
+ * not create any new nonzero entries.
+ */
+BOOST_AUTO_TEST_CASE(MaxAbsScalerSparseTest)
+{
+  arma::sp_mat sparseDataset(dataset);
+
+  data::MaxAbsScaler scale;
+  scale.Fit(sparseDataset);
+
+  arma::sp_mat sparseScaled, sparseRestored;
+  scale.Transform(sparseDataset, sparseScaled);
+  scale.InverseTransform(sparseScaled, sparseRestored);
+
+  // The dense scaler fitted on the same data must give the same result.
+  data::MaxAbsScaler denseScale;
+  denseScale.Fit(dataset);
+  denseScale.Transform(dataset, scaleddataset);
+
+  BOOST_REQUIRE_EQUAL(sparseScaled.n_nonzero, sparseDataset.n_nonzero);
+  CheckMatrices(arma::mat(sparseScaled), scaleddataset);
+  CheckMatrices(arma::mat(sparseRestored), dataset);
+}
+
 /**
  * Test For Standard Scaler Class.
  */
@@ -137,6 +163,84 @@ BOOST_AUTO_TEST_CASE(ZeroScaleTest)
   CheckMatrices(dataset, temp);
 }
 
+/**
+ * Test that chunked PartialFit() gives the same scaling as one Fit() on the
+ * whole dataset.
+ */
+BOOST_AUTO_TEST_CASE(PartialFitTest)
+{
+  arma::mat input = arma::randu<arma::mat>(5, 50);
+
+  data::StandardScaler standardFull, standardChunked;
+  data::MinMaxScaler minMaxFull, minMaxChunked;
+  data::MaxAbsScaler maxAbsFull, maxAbsChunked;
+  data::MeanNormalization meanFull, meanChunked;
+
+  standardFull.Fit(input);
+  minMaxFull.Fit(input);
+  maxAbsFull.Fit(input);
+  meanFull.Fit(input);
+
+  // Feed the same data in three unequal chunks.
+  arma::mat chunks[3] = { input.cols(0, 9), input.cols(10, 36),
+      input.cols(37, 49) };
+  for (size_t i = 0; i < 3; ++i)
+  {
+    standardChunked.PartialFit(chunks[i]);
+    minMaxChunked.PartialFit(chunks[i]);
+    maxAbsChunked.PartialFit(chunks[i]);
+    meanChunked.PartialFit(chunks[i]);
+  }
+
+  CheckMatrices(arma::mat(standardFull.ItemMean()),
+      arma::mat(standardChunked.ItemMean()));
+  CheckMatrices(arma::mat(standardFull.ItemStdDev()),
+      arma::mat(standardChunked.ItemStdDev()));
+  CheckMatrices(arma::mat(minMaxFull.Scale()),
+      arma::mat(minMaxChunked.Scale()));
+  CheckMatrices(arma::mat(maxAbsFull.Scale()),
+      arma::mat(maxAbsChunked.Scale()));
+  CheckMatrices(arma::mat(meanFull.ItemMean()),
+      arma::mat(meanChunked.ItemMean()));
+  CheckMatrices(arma::mat(meanFull.Scale()), arma::mat(meanChunked.Scale()));
+}
+
+/**
+ * Test that the in-place Transform() overload matches the copying overload.
+ */
+BOOST_AUTO_TEST_CASE(InPlaceTransformTest)
+{
+  arma::mat input = arma::randu<arma::mat>(4, 30);
+
+  data::StandardScaler standard;
+  standard.Fit(input);
+  arma::mat expected, inPlace = input;
+  standard.Transform(input, expected);
+  standard.Transform(inPlace);
+  CheckMatrices(expected, inPlace);
+
+  data::MinMaxScaler minMax;
+  minMax.Fit(input);
+  minMax.Transform(input, expected);
+  inPlace = input;
+  minMax.Transform(inPlace);
+  CheckMatrices(expected, inPlace);
+
+  data::MaxAbsScaler maxAbs;
+  maxAbs.Fit(input);
+  maxAbs.Transform(input, expected);
+  inPlace = input;
+  maxAbs.Transform(inPlace);
+  CheckMatrices(expected, inPlace);
+
+  data::MeanNormalization meanNorm;
+  meanNorm.Fit(input);
+  meanNorm.Transform(input, expected);
+  inPlace = input;
+  meanNorm.Transform(inPlace);
+  CheckMatrices(expected, inPlace);
+}
+
 /**
  * Test for PCA whitening Scale.
  */
@@ -175,4 +279,71 @@ BOOST_AUTO_TEST_CASE(ZCAWhiteningTest)
   CheckMatrices(dataset, temp);
 }
 
+/**
+ * Test for the HashedInteractionExpansion class.
+ */
+BOOST_AUTO_TEST_CASE(HashedInteractionExpansionTest)
+{
+  arma::mat input(4, 3, arma::fill::randu);
+  // Make the second point a scaled copy of the first; every quadratic cross
+  // then scales by the square of the factor, whatever buckets it lands in.
+  input.col(1) = 2.0 * input.col(0);
+
+  const size_t numBuckets = 1024;
+  data::HashedInteractionExpansion expansion(numBuckets);
+  expansion.Fit(input);
+
+  arma::sp_mat output;
+  expansion.Transform(input, output);
+
+  BOOST_REQUIRE_EQUAL(output.n_rows, input.n_rows + numBuckets);
+  BOOST_REQUIRE_EQUAL(output.n_cols, input.n_cols);
+
+  // The original features must be preserved as the leading rows.
+  for (size_t c = 0; c < input.n_cols; ++c)
+    for (size_t r = 0; r < input.n_rows; ++r)
+      BOOST_REQUIRE_CLOSE((double) output(r, c), input(r, c), 1e-10);
+
+  // The crosses of the scaled point must be exactly 4x those of the first
+  // point, bucket for bucket.
+  for (size_t r = input.n_rows; r < output.n_rows; ++r)
+    BOOST_REQUIRE_SMALL((double) output(r, 1) - 4.0 * (double) output(r, 0),
+        1e-10);
+
+  // Sparse input must hash identically to dense input.
+  arma::sp_mat sparseInput(input);
+  arma::sp_mat sparseOutput;
+  expansion.Transform(sparseInput, sparseOutput);
+  BOOST_REQUIRE_SMALL(arma::accu(arma::abs(output - sparseOutput)), 1e-10);
+
+  // Without the passthrough the output holds the crosses alone, shifted up.
+  data::HashedInteractionExpansion crossesOnly(numBuckets, false);
+  crossesOnly.Fit(input);
+  arma::sp_mat crossedOutput;
+  crossesOnly.Transform(input, crossedOutput);
+  BOOST_REQUIRE_EQUAL(crossedOutput.n_rows, numBuckets);
+  for (size_t c = 0; c < input.n_cols; ++c)
+    for (size_t r = 0; r < numBuckets; ++r)
+      BOOST_REQUIRE_SMALL((double) crossedOutput(r, c) -
+          (double) output(r + input.n_rows, c), 1e-10);
+}
+
+/**
+ * The expansion must reject transforms before Fit() and dimensionality
+ * mismatches.
+ */
+BOOST_AUTO_TEST_CASE(HashedInteractionExpansionValidationTest)
+{
+  arma::mat input(4, 3, arma::fill::randu);
+  arma::sp_mat output;
+
+  data::HashedInteractionExpansion expansion(256);
+  BOOST_REQUIRE_THROW(expansion.Transform(input, output), std::runtime_error);
+
+  expansion.Fit(input);
+  arma::mat wrongDimensions(6, 3, arma::fill::randu);
+  BOOST_REQUIRE_THROW(expansion.Transform(wrongDimensions, output),
+      std::invalid_argument);
+}
+
 BOOST_AUTO_TEST_SUITE_END();
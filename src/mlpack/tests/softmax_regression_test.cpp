@@ -171,6 +171,57 @@ BOOST_AUTO_TEST_CASE(SoftmaxRegressionFunctionGradient)
   }
 }
 
+/**
+ * Streaming points through a fixed-size probability block must give the same
+ * objective and gradient as evaluating all points at once.
+ */
+BOOST_AUTO_TEST_CASE(SoftmaxRegressionFunctionChunkedEvaluate)
+{
+  const size_t points = 200;
+  const size_t inputSize = 10;
+  const size_t numClasses = 5;
+
+  // Initialize a random dataset.
+  arma::mat data;
+  data.randu(inputSize, points);
+
+  // Create random class labels.
+  arma::Row<size_t> labels(points);
+  for (size_t i = 0; i < points; i++)
+    labels(i) = math::RandInt(0, numClasses);
+
+  // Check both with and without an intercept term.
+  for (size_t intercept = 0; intercept <= 1; ++intercept)
+  {
+    SoftmaxRegressionFunction srf(data, labels, numClasses, 0.01,
+        (intercept == 1));
+    SoftmaxRegressionFunction srfChunked(data, labels, numClasses, 0.01,
+        (intercept == 1));
+    // A chunk size that does not evenly divide the number of points.
+    srfChunked.EvaluationChunkSize() = 33;
+
+    arma::mat parameters;
+    SoftmaxRegressionFunction::InitializeWeights(parameters, inputSize,
+        numClasses, (intercept == 1));
+
+    BOOST_REQUIRE_CLOSE(srf.Evaluate(parameters),
+        srfChunked.Evaluate(parameters), 1e-5);
+
+    arma::mat gradient, chunkedGradient;
+    srf.Gradient(parameters, gradient);
+    srfChunked.Gradient(parameters, chunkedGradient);
+
+    BOOST_REQUIRE_EQUAL(gradient.n_elem, chunkedGradient.n_elem);
+    for (size_t i = 0; i < gradient.n_elem; ++i)
+    {
+      if (std::abs(gradient[i]) < 1e-8)
+        BOOST_REQUIRE_SMALL(chunkedGradient[i], 1e-8);
+      else
+        BOOST_REQUIRE_CLOSE(gradient[i], chunkedGradient[i], 1e-5);
+    }
+  }
+}
+
 BOOST_AUTO_TEST_CASE(SoftmaxRegressionTwoClasses)
 {
   const size_t points = 1000;
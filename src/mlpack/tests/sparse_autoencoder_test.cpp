@@ -268,4 +268,104 @@ BOOST_AUTO_TEST_CASE(SparseAutoencoderFunctionGradient)
   }
 }
 
+/**
+ * The fused, sharded EvaluateWithGradient() must return exactly the same
+ * objective and gradient as the separate Evaluate() and Gradient() calls.
+ */
+BOOST_AUTO_TEST_CASE(SparseAutoencoderFunctionEvaluateWithGradient)
+{
+  const size_t points = 1000;
+  const size_t vSize = 20;
+  const size_t hSize = 10;
+  const size_t l2 = vSize;
+  const size_t l3 = 2 * hSize;
+
+  // Initialize a random dataset.
+  arma::mat data;
+  data.randu(vSize, points);
+
+  // Use nonzero regularization and KL divergence terms so that every part of
+  // the objective is exercised.
+  SparseAutoencoderFunction saf(data, vSize, hSize, 20, 20);
+
+  // Create a random set of parameters.
+  arma::mat parameters;
+  parameters.randu(l3 + 1, l2 + 1);
+
+  // Get the objective and gradient from the separate implementations.
+  const double cost = saf.Evaluate(parameters);
+  arma::mat gradient;
+  saf.Gradient(parameters, gradient);
+
+  // Get the objective and gradient from the fused implementation; run it
+  // twice so that the second call reuses the persistent workspaces.
+  for (size_t trial = 0; trial < 2; ++trial)
+  {
+    arma::mat fusedGradient;
+    const double fusedCost = saf.EvaluateWithGradient(parameters,
+        fusedGradient);
+
+    BOOST_REQUIRE_CLOSE(fusedCost, cost, 1e-8);
+    CheckMatrices(fusedGradient, gradient);
+  }
+}
+
+/**
+ * A mini-batch covering the entire dataset must reproduce the full objective
+ * and gradient exactly, since the batch fraction is one and the average
+ * hidden activations are computed over all points.
+ */
+BOOST_AUTO_TEST_CASE(SparseAutoencoderFunctionBatchEvaluate)
+{
+  const size_t points = 500;
+  const size_t vSize = 15;
+  const size_t hSize = 8;
+  const size_t l2 = vSize;
+  const size_t l3 = 2 * hSize;
+
+  // Initialize a random dataset.
+  arma::mat data;
+  data.randu(vSize, points);
+
+  SparseAutoencoderFunction saf(data, vSize, hSize, 20, 20);
+
+  BOOST_REQUIRE_EQUAL(saf.NumFunctions(), points);
+
+  // Create a random set of parameters.
+  arma::mat parameters;
+  parameters.randu(l3 + 1, l2 + 1);
+
+  const double cost = saf.Evaluate(parameters);
+  arma::mat gradient;
+  saf.Gradient(parameters, gradient);
+
+  // The objective over the whole dataset as one batch must match the full
+  // objective.
+  BOOST_REQUIRE_CLOSE(saf.Evaluate(parameters, 0, points), cost, 1e-8);
+
+  arma::mat batchGradient;
+  saf.Gradient(parameters, 0, batchGradient, points);
+  CheckMatrices(batchGradient, gradient);
+
+  arma::mat fusedBatchGradient;
+  const double fusedBatchCost = saf.EvaluateWithGradient(parameters, 0,
+      fusedBatchGradient, points);
+  BOOST_REQUIRE_CLOSE(fusedBatchCost, cost, 1e-8);
+  CheckMatrices(fusedBatchGradient, gradient);
+
+  // Shuffling only permutes the visitation order, so the whole dataset as one
+  // batch must still give the full objective.
+  saf.Shuffle();
+  BOOST_REQUIRE_CLOSE(saf.Evaluate(parameters, 0, points), cost, 1e-8);
+
+  // The objectives of the batches of an epoch must sum to something close to
+  // the full objective; the sparsity term is estimated per batch, so the sum
+  // is only approximate.
+  const size_t batchSize = 100;
+  double summedCost = 0;
+  for (size_t begin = 0; begin < points; begin += batchSize)
+    summedCost += saf.Evaluate(parameters, begin, batchSize);
+  BOOST_REQUIRE_CLOSE(summedCost, cost, 1.0);
+}
+
 BOOST_AUTO_TEST_SUITE_END();
@@ -215,4 +215,123 @@ BOOST_AUTO_TEST_CASE(SplitLabeledDataLargerTest)
   CheckDuplication(std::get<2>(value), std::get<3>(value));
 }
 
+/**
+ * Test that an index-based in-place split gives the same result as Split(),
+ * without copying the dataset.
+ */
+BOOST_AUTO_TEST_CASE(SplitIndicesInPlaceTest)
+{
+  mat input(3, 20);
+  input.randu();
+  const mat original = input;
+
+  // Set the labels to the column ID.
+  Row<size_t> labels = arma::linspace<Row<size_t>>(0, input.n_cols - 1,
+      input.n_cols);
+
+  uvec trainIndices, testIndices;
+  SplitIndices(input.n_cols, 0.25, trainIndices, testIndices);
+  BOOST_REQUIRE_EQUAL(trainIndices.n_elem, 15);
+  BOOST_REQUIRE_EQUAL(testIndices.n_elem, 5);
+
+  const size_t trainSize = ApplySplitInPlace(input, labels, trainIndices,
+      testIndices);
+  BOOST_REQUIRE_EQUAL(trainSize, 15);
+
+  // After the permutation every column must sit where its index says.
+  CompareData(original, input, labels);
+  CheckMatEqual(original, input);
+
+  // The aliases must view the two halves of the permuted matrix without
+  // copying anything.
+  auto views = SplitAlias(input, trainSize);
+  mat& trainView = std::get<0>(views);
+  mat& testView = std::get<1>(views);
+  BOOST_REQUIRE_EQUAL(trainView.n_cols, 15);
+  BOOST_REQUIRE_EQUAL(testView.n_cols, 5);
+  BOOST_REQUIRE_EQUAL(trainView.memptr(), input.memptr());
+  BOOST_REQUIRE_EQUAL(testView.memptr(), input.memptr() + 15 * input.n_rows);
+  CheckMatrices(trainView, mat(input.cols(0, 14)));
+  CheckMatrices(testView, mat(input.cols(15, 19)));
+
+  // Mismatched index sets must be rejected.
+  BOOST_REQUIRE_THROW(ApplySplitInPlace(input, trainIndices, trainIndices),
+      std::invalid_argument);
+}
+
+/**
+ * Test that the stratified split keeps the class proportions in both halves.
+ */
+BOOST_AUTO_TEST_CASE(StratifiedSplitTest)
+{
+  // 40 points of class 0, 10 points of class 1.
+  mat input(3, 50);
+  input.randu();
+  Row<size_t> labels(50);
+  labels.subvec(0, 39).fill(0);
+  labels.subvec(40, 49).fill(1);
+
+  mat trainData, testData;
+  Row<size_t> trainLabels, testLabels;
+  StratifiedSplit(input, labels, trainData, testData, trainLabels, testLabels,
+      0.2);
+
+  BOOST_REQUIRE_EQUAL(trainData.n_cols, 40);
+  BOOST_REQUIRE_EQUAL(testData.n_cols, 10);
+
+  // Each half must keep the 4:1 class ratio.
+  BOOST_REQUIRE_EQUAL(arma::accu(trainLabels == 0), 32);
+  BOOST_REQUIRE_EQUAL(arma::accu(trainLabels == 1), 8);
+  BOOST_REQUIRE_EQUAL(arma::accu(testLabels == 0), 8);
+  BOOST_REQUIRE_EQUAL(arma::accu(testLabels == 1), 2);
+
+  // No point may be lost or duplicated.
+  mat concat = arma::join_rows(trainData, testData);
+  CheckMatEqual(input, concat);
+}
+
+/**
+ * Test that the sparse Split() overloads produce the same columns as the
+ * input, without losing or duplicating any point.
+ */
+BOOST_AUTO_TEST_CASE(SparseSplitDataResultTest)
+{
+  // Every column gets one nonzero whose value encodes the column index, so
+  // the split output can be matched back to the input columns.
+  arma::sp_mat input(5, 20);
+  for (size_t i = 0; i < input.n_cols; ++i)
+    input(i % input.n_rows, i) = i + 1.0;
+
+  // The labels also encode the column index.
+  Row<size_t> labels = arma::linspace<Row<size_t>>(0, input.n_cols - 1,
+      input.n_cols);
+
+  arma::sp_mat trainData, testData;
+  Row<size_t> trainLabels, testLabels;
+  Split(input, labels, trainData, testData, trainLabels, testLabels, 0.25);
+
+  BOOST_REQUIRE_EQUAL(trainData.n_cols, 15);
+  BOOST_REQUIRE_EQUAL(testData.n_cols, 5);
+  BOOST_REQUIRE_EQUAL(trainLabels.n_elem, 15);
+  BOOST_REQUIRE_EQUAL(testLabels.n_elem, 5);
+
+  // Each output column must be exactly the input column its label points to.
+  for (size_t i = 0; i < trainData.n_cols; ++i)
+    CheckMatrices(mat(trainData.col(i)), mat(input.col(trainLabels[i])));
+  for (size_t i = 0; i < testData.n_cols; ++i)
+    CheckMatrices(mat(testData.col(i)), mat(input.col(testLabels[i])));
+
+  // No label may be lost or duplicated.
+  Row<size_t> allLabels = arma::join_rows(trainLabels, testLabels);
+  BOOST_REQUIRE_EQUAL(Row<size_t>(arma::sort(allLabels, "ascend")).n_elem,
+      labels.n_elem);
+  BOOST_REQUIRE(arma::all(Row<size_t>(arma::sort(allLabels, "ascend")) ==
+      labels));
+
+  // The unlabeled overload without shuffling must return contiguous halves.
+  Split(input, trainData, testData, 0.25, false);
+  CheckMatrices(mat(trainData), mat(input.cols(0, 14)));
+  CheckMatrices(mat(testData), mat(input.cols(15, 19)));
+}
+
 BOOST_AUTO_TEST_SUITE_END();
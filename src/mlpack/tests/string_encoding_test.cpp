@@ -14,10 +14,12 @@
 #include <mlpack/core/boost_backport/boost_backport_string_view.hpp>
 #include <mlpack/core/data/tokenizers/split_by_any_of.hpp>
 #include <mlpack/core/data/tokenizers/char_extract.hpp>
+#include <mlpack/core/data/tokenizers/tokenized_corpus.hpp>
 #include <mlpack/core/data/string_encoding.hpp>
 #include <mlpack/core/data/string_encoding_policies/dictionary_encoding_policy.hpp>
 #include <mlpack/core/data/string_encoding_policies/bag_of_words_encoding_policy.hpp>
 #include <mlpack/core/data/string_encoding_policies/tf_idf_encoding_policy.hpp>
+#include <mlpack/core/data/hashing_encoding.hpp>
 #include <boost/test/unit_test.hpp>
 #include <memory>
 #include "test_tools.hpp"
@@ -183,6 +185,73 @@ BOOST_AUTO_TEST_CASE(OnePassDictionaryEncodingTest)
 }
 
 
+/**
+ * Test the hashing trick encoding algorithm.
+ */
+BOOST_AUTO_TEST_CASE(HashingEncodingTest)
+{
+  arma::mat output;
+  HashingEncoding encoder(16);
+  SplitByAnyOf tokenizer(" .,\"");
+
+  encoder.Encode(stringEncodingInput, output, tokenizer);
+
+  BOOST_REQUIRE_EQUAL(output.n_rows, 16);
+  BOOST_REQUIRE_EQUAL(output.n_cols, 3);
+
+  // Every token lands in exactly one feature, so the column sums must equal
+  // the token counts of the documents (see DictionaryEncodingTest).
+  BOOST_REQUIRE_EQUAL(arma::accu(output.col(0)), 16);
+  BOOST_REQUIRE_EQUAL(arma::accu(output.col(1)), 33);
+  BOOST_REQUIRE_EQUAL(arma::accu(output.col(2)), 15);
+
+  // The encoding is stateless, so a second pass must give the same result.
+  arma::mat secondOutput;
+  encoder.Encode(stringEncodingInput, secondOutput, tokenizer);
+  CheckMatrices(output, secondOutput);
+
+  // Identical documents must encode to identical columns.
+  vector<string> repeated = { stringEncodingInput[0], stringEncodingInput[0] };
+  encoder.Encode(repeated, output, tokenizer);
+  CheckMatrices(arma::mat(output.col(0)), arma::mat(output.col(1)));
+
+  BOOST_REQUIRE_THROW(HashingEncoding badEncoder(0), std::invalid_argument);
+}
+
+/**
+ * Test the row-major (sequence) mode of the hashing trick encoding algorithm.
+ */
+BOOST_AUTO_TEST_CASE(OnePassHashingEncodingTest)
+{
+  vector<vector<size_t>> output;
+  HashingEncoding encoder(16);
+  SplitByAnyOf tokenizer(" .,\"");
+
+  encoder.Encode(stringEncodingInput, output, tokenizer);
+
+  BOOST_REQUIRE_EQUAL(output.size(), 3);
+  BOOST_REQUIRE_EQUAL(output[0].size(), 16);
+  BOOST_REQUIRE_EQUAL(output[1].size(), 33);
+  BOOST_REQUIRE_EQUAL(output[2].size(), 15);
+
+  // All labels must lie in [1, numFeatures].
+  for (size_t i = 0; i < output.size(); i++)
+  {
+    for (size_t j = 0; j < output[i].size(); j++)
+    {
+      BOOST_REQUIRE_GE(output[i][j], 1);
+      BOOST_REQUIRE_LE(output[i][j], 16);
+    }
+  }
+
+  // The same token must always receive the same label.  The token "machine"
+  // occurs at position 8 of the first document and positions 6, 19 and 30 of
+  // the second one (see OnePassDictionaryEncodingTest).
+  BOOST_REQUIRE_EQUAL(output[0][8], output[1][6]);
+  BOOST_REQUIRE_EQUAL(output[1][6], output[1][19]);
+  BOOST_REQUIRE_EQUAL(output[1][19], output[1][30]);
+}
+
 /**
  * Test the SplitByAnyOf tokenizer.
  */
@@ -242,6 +311,38 @@ BOOST_AUTO_TEST_CASE(SplitByAnyOfTokenizerUnicodeTest)
     BOOST_REQUIRE_EQUAL(tokens[i], expectedUtf8Tokens[i]);
 }
 
+/**
+ * Test that TokenizedCorpus stores the same tokens the tokenizer extracts,
+ * in the same per-document order.
+ */
+BOOST_AUTO_TEST_CASE(TokenizedCorpusTest)
+{
+  SplitByAnyOf tokenizer(" ,.");
+  TokenizedCorpus<boost::string_view> corpus(stringEncodingInput, tokenizer);
+
+  BOOST_REQUIRE_EQUAL(corpus.Documents(), stringEncodingInput.size());
+
+  size_t totalTokens = 0;
+  for (size_t i = 0; i < stringEncodingInput.size(); i++)
+  {
+    boost::string_view line(stringEncodingInput[i]);
+    boost::string_view token = tokenizer(line);
+    size_t numTokens = 0;
+
+    while (!token.empty())
+    {
+      BOOST_REQUIRE_EQUAL(corpus.Token(i, numTokens), token);
+      token = tokenizer(line);
+      numTokens++;
+    }
+
+    BOOST_REQUIRE_EQUAL(corpus.NumTokens(i), numTokens);
+    totalTokens += numTokens;
+  }
+
+  BOOST_REQUIRE_EQUAL(corpus.Tokens().size(), totalTokens);
+}
+
 /**
  * Test the CharExtract tokenizer.
  */
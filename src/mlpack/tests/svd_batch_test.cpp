@@ -44,6 +44,40 @@ BOOST_AUTO_TEST_CASE(SVDBatchConvergenceElementTest)
                    amf.TerminationPolicy().MaxIterations());
 }
 
+/**
+ * Make sure SVD batch learning with negative sampling still converges, and
+ * that the sampled implicit zeros pull the predictions of unobserved entries
+ * towards zero.
+ */
+BOOST_AUTO_TEST_CASE(SVDBatchNegativeSamplingTest)
+{
+  // Build a sparse implicit-feedback style matrix: ones at random positions.
+  sp_mat data;
+  data.sprandu(100, 100, 0.05);
+  data = arma::spones(data);
+
+  AMF<SimpleToleranceTermination<sp_mat>,
+      AverageInitialization,
+      SVDBatchLearning> amf(SimpleToleranceTermination<sp_mat>(),
+                            AverageInitialization(),
+                            SVDBatchLearning(0.0002, 0, 0, 0.9, 3));
+  mat m1, m2;
+  amf.Apply(data, 2, m1, m2);
+
+  BOOST_REQUIRE_NE(amf.TerminationPolicy().Iteration(),
+                   amf.TerminationPolicy().MaxIterations());
+
+  // The mean prediction over the observed entries should be clearly higher
+  // than the mean prediction over all entries.
+  const mat predictions = m1 * m2;
+  double observedMean = 0.0;
+  for (sp_mat::const_iterator it = data.begin(); it != data.end(); ++it)
+    observedMean += predictions(it.row(), it.col());
+  observedMean /= data.n_nonzero;
+
+  BOOST_REQUIRE_GT(observedMean, arma::mean(arma::mean(predictions)));
+}
+
 //! This is used to ensure we start from the same initial point.
 class SpecificRandomInitialization
 {
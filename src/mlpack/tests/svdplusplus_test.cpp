@@ -550,6 +550,115 @@ BOOST_AUTO_TEST_CASE(SVDPlusPlusFunctionParallelOptimize)
   BOOST_REQUIRE_SMALL(relativeError, 1e-2);
 }
 
+// Test the Hogwild-style training mode of the SVDPlusPlus driver class.
+BOOST_AUTO_TEST_CASE(SVDPlusPlusHogwildApplyTest)
+{
+  // Define useful constants.
+  const size_t numUsers = 100;
+  const size_t numItems = 100;
+  const size_t numRatings = 1000;
+  const size_t numImplicit = 500;
+  const size_t iterations = 30;
+  const size_t rank = 5;
+  const double alpha = 0.01;
+  const double lambda = 0;
+
+  // Initiate random parameters.
+  arma::mat parameters = arma::randu(rank + 1, numUsers + 2 * numItems);
+
+  // Make a random rating dataset.
+  arma::mat data = arma::randu(3, numRatings);
+  data.row(0) = floor(data.row(0) * numUsers);
+  data.row(1) = floor(data.row(1) * numItems);
+
+  // Manually set last row to maximum user and maximum item.
+  data(0, numRatings - 1) = numUsers - 1;
+  data(1, numRatings - 1) = numItems - 1;
+
+  // Make a random implicit dataset in the (user, item) pair form that the
+  // driver's Apply() accepts.
+  arma::mat implicitPairs = arma::randu(2, numImplicit);
+  implicitPairs.row(0) = floor(implicitPairs.row(0) * numUsers);
+  implicitPairs.row(1) = floor(implicitPairs.row(1) * numItems);
+
+  // Build the equivalent sparse matrix for generating the ratings.
+  arma::umat locations(2, numImplicit);
+  arma::vec values(numImplicit, arma::fill::ones);
+  for (size_t i = 0; i < numImplicit; ++i)
+  {
+    locations(0, i) = (arma::uword) implicitPairs(1, i);
+    locations(1, i) = (arma::uword) implicitPairs(0, i);
+  }
+  arma::sp_mat implicitData(locations, values, numItems, numUsers);
+
+  // Make rating entries based on the parameters.
+  for (size_t i = 0; i < numRatings; i++)
+  {
+    const size_t user = data(0, i);
+    const size_t item = data(1, i) + numUsers;
+    const size_t implicitStart = numUsers + numItems;
+
+    const double userBias = parameters(rank, user);
+    const double itemBias = parameters(rank, item);
+
+    // Iterate through each item which the user interacted with to calculate
+    // user vector.
+    arma::vec userVec(rank, arma::fill::zeros);
+    arma::sp_mat::const_iterator it = implicitData.begin_col(user);
+    arma::sp_mat::const_iterator it_end = implicitData.end_col(user);
+    size_t implicitCount = 0;
+    for (; it != it_end; ++it)
+    {
+      userVec += parameters.col(implicitStart + it.row()).subvec(0, rank - 1);
+      implicitCount += 1;
+    }
+    if (implicitCount != 0)
+      userVec /= std::sqrt(implicitCount);
+    userVec += parameters.col(user).subvec(0, rank - 1);
+
+    data(2, i) = userBias + itemBias +
+        arma::dot(userVec, parameters.col(item).subvec(0, rank - 1));
+  }
+
+  // Train with sharded ratings and unsynchronized updates.
+  SVDPlusPlus<ens::ParallelSGD<ens::ConstantStep>> svdPP(iterations, alpha,
+      lambda);
+  arma::mat u, v, y;
+  arma::vec p, q;
+  svdPP.Apply(data, implicitPairs, rank, u, v, p, q, y);
+
+  // Get predicted ratings from the extracted factors and biases.
+  arma::mat predictedData(1, numRatings);
+  for (size_t i = 0; i < numRatings; i++)
+  {
+    const size_t user = data(0, i);
+    const size_t item = data(1, i);
+
+    arma::vec userVec(rank, arma::fill::zeros);
+    arma::sp_mat::const_iterator it = implicitData.begin_col(user);
+    arma::sp_mat::const_iterator it_end = implicitData.end_col(user);
+    size_t implicitCount = 0;
+    for (; it != it_end; ++it)
+    {
+      userVec += y.col(it.row());
+      implicitCount += 1;
+    }
+    if (implicitCount != 0)
+      userVec /= std::sqrt(implicitCount);
+    userVec += v.col(user);
+
+    predictedData(0, i) = q(user) + p(item) +
+        arma::dot(userVec, u.row(item).t());
+  }
+
+  // Calculate relative error.
+  const double relativeError = arma::norm(data.row(2) - predictedData, "frob") /
+                               arma::norm(data, "frob");
+
+  // Relative error should be small.
+  BOOST_REQUIRE_SMALL(relativeError, 1e-2);
+}
+
 #endif
 
 BOOST_AUTO_TEST_SUITE_END();
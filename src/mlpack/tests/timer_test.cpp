@@ -19,6 +19,9 @@
 #endif
 
 #include <mlpack/core.hpp>
+#include <mlpack/core/util/memory_counters.hpp>
+#include <mlpack/core/util/parallelism.hpp>
+#include <mlpack/core/util/perf_counters.hpp>
 
 #include <boost/test/unit_test.hpp>
 #include "test_tools.hpp"
@@ -147,4 +150,136 @@ BOOST_AUTO_TEST_CASE(DisabledTimingTest)
   BOOST_REQUIRE(Timer::Get("test_timer") == std::chrono::microseconds(0));
 }
 
+/**
+ * The scoped profiler must aggregate repeated scopes, nest children under
+ * their enclosing scope, and export both in the JSON output.
+ */
+BOOST_AUTO_TEST_CASE(ScopedProfilerTest)
+{
+  Profiler::Reset();
+
+  const size_t outerTimer = Profiler::RegisterTimer("outer");
+  const size_t innerTimer = Profiler::RegisterTimer("inner");
+
+  // Registering the same name again must give the same ID.
+  BOOST_REQUIRE_EQUAL(Profiler::RegisterTimer("outer"), outerTimer);
+
+  for (size_t i = 0; i < 3; ++i)
+  {
+    ScopedTimer outer(outerTimer);
+    for (size_t j = 0; j < 2; ++j)
+    {
+      ScopedTimer inner(innerTimer);
+      #ifdef _WIN32
+      Sleep(1);
+      #else
+      usleep(1000);
+      #endif
+    }
+  }
+
+  std::ostringstream output;
+  Profiler::PrintJSON(output);
+  const std::string json = output.str();
+
+  // The inner scope must appear as a child of the outer scope, entered six
+  // times in total.
+  BOOST_REQUIRE_NE(json.find("\"name\": \"outer\""), std::string::npos);
+  BOOST_REQUIRE_NE(json.find("\"name\": \"inner\""), std::string::npos);
+  BOOST_REQUIRE_NE(json.find("\"calls\": 3"), std::string::npos);
+  BOOST_REQUIRE_NE(json.find("\"calls\": 6"), std::string::npos);
+  BOOST_REQUIRE_LT(json.find("\"name\": \"outer\""),
+      json.find("\"name\": \"inner\""));
+
+  Profiler::Reset();
+}
+
+/**
+ * Hardware counters must accumulate for a named region when they are
+ * available, and read as zero when they are not (so instrumented code needs
+ * no platform checks).
+ */
+BOOST_AUTO_TEST_CASE(PerfCountersTest)
+{
+  PerfCounters::Enable();
+  PerfCounters::Start("counter_region");
+
+  // Some busy work so that cycles accumulate.
+  volatile double sum = 0.0;
+  for (size_t i = 1; i < 200000; ++i)
+    sum += 1.0 / (double) i;
+
+  PerfCounters::Stop("counter_region");
+
+  if (PerfCounters::Available())
+    BOOST_REQUIRE_GT(PerfCounters::Get("counter_region").cycles, 0);
+  else
+    BOOST_REQUIRE_EQUAL(PerfCounters::Get("counter_region").cycles, 0);
+
+  // A region that was never started must read as zero.
+  BOOST_REQUIRE_EQUAL(PerfCounters::Get("no_such_region").cycles, 0);
+
+  PerfCounters::Reset();
+  PerfCounters::Disable();
+}
+
+/**
+ * Memory counters must see Armadillo allocations made inside a region when
+ * tracking was compiled in, and read as zero when it was not (so
+ * instrumented code needs no build-flag checks).
+ */
+BOOST_AUTO_TEST_CASE(MemoryCountersTest)
+{
+  MemoryCounters::Enable();
+  MemoryCounters::Start("memory_region");
+
+  // Allocate something Armadillo-sized so the region has a peak.
+  arma::mat data(100, 100, arma::fill::randu);
+  data += 1.0;
+
+  MemoryCounters::Stop("memory_region");
+
+  if (MemoryCounters::Available())
+  {
+    BOOST_REQUIRE_GE(MemoryCounters::Get("memory_region").peakBytes,
+        100 * 100 * sizeof(double));
+    BOOST_REQUIRE_GT(MemoryCounters::Get("memory_region").allocations, 0);
+  }
+  else
+  {
+    BOOST_REQUIRE_EQUAL(MemoryCounters::Get("memory_region").peakBytes, 0);
+  }
+
+  // A region that was never started must read as zero.
+  BOOST_REQUIRE_EQUAL(MemoryCounters::Get("no_such_region").peakBytes, 0);
+
+  MemoryCounters::Reset();
+  MemoryCounters::Disable();
+}
+
+/**
+ * Thread budgets must resolve in order: subsystem cap, then global cap; and
+ * removing a cap must restore the default.
+ */
+BOOST_AUTO_TEST_CASE(ParallelismBudgetTest)
+{
+  const size_t defaultThreads = Parallelism::MaxThreads();
+  BOOST_REQUIRE_GE(defaultThreads, 1);
+
+  // A subsystem cap must bound that subsystem only.
+  Parallelism::Threads("test_subsystem", 1);
+  BOOST_REQUIRE_EQUAL(Parallelism::Threads("test_subsystem"), 1);
+  BOOST_REQUIRE_EQUAL(Parallelism::Threads("other_subsystem"),
+      defaultThreads);
+
+  // The global cap must bound every subsystem.
+  Parallelism::MaxThreads(1);
+  BOOST_REQUIRE_EQUAL(Parallelism::Threads("other_subsystem"), 1);
+
+  // Removing the caps must restore the defaults.
+  Parallelism::Reset();
+  BOOST_REQUIRE_EQUAL(Parallelism::Threads("test_subsystem"),
+      defaultThreads);
+}
+
 BOOST_AUTO_TEST_SUITE_END();
@@ -14,6 +14,7 @@
 #include <mlpack/core/metrics/lmetric.hpp>
 #include <mlpack/core/metrics/mahalanobis_distance.hpp>
 #include <mlpack/core/tree/cover_tree/cover_tree.hpp>
+#include <mlpack/core/tree/morton_sort.hpp>
 #include <mlpack/core/tree/rectangle_tree.hpp>
 
 #include <queue>
@@ -287,6 +288,42 @@ BOOST_AUTO_TEST_CASE(HRectBoundMinDistanceBound)
   BOOST_REQUIRE_SMALL(c.MinDistance(c), 1e-5);
 }
 
+/**
+ * Ensure that the batched MinDistances() call agrees with per-pair
+ * MinDistance() calls.
+ */
+BOOST_AUTO_TEST_CASE(HRectBoundBatchMinDistanceBound)
+{
+  math::FixedRandomSeed();
+
+  HRectBound<EuclideanDistance> b(5);
+  for (size_t d = 0; d < 5; ++d)
+  {
+    const double lo = math::Random(-5.0, 5.0);
+    b[d] = Range(lo, lo + math::Random(0.0, 3.0));
+  }
+
+  std::vector<HRectBound<EuclideanDistance>> candidates(20,
+      HRectBound<EuclideanDistance>(5));
+  std::vector<const HRectBound<EuclideanDistance>*> candidatePtrs;
+  for (size_t i = 0; i < candidates.size(); ++i)
+  {
+    for (size_t d = 0; d < 5; ++d)
+    {
+      const double lo = math::Random(-5.0, 5.0);
+      candidates[i][d] = Range(lo, lo + math::Random(0.0, 3.0));
+    }
+    candidatePtrs.push_back(&candidates[i]);
+  }
+
+  arma::vec distances;
+  b.MinDistances(candidatePtrs, distances);
+
+  BOOST_REQUIRE_EQUAL(distances.n_elem, candidates.size());
+  for (size_t i = 0; i < candidates.size(); ++i)
+    BOOST_REQUIRE_CLOSE(distances[i], b.MinDistance(candidates[i]), 1e-10);
+}
+
 /**
  * Ensure that we calculate the correct maximum distance between a bound and a
  * point.  This uses the same test cases as the MinDistance test.
@@ -524,6 +561,31 @@ BOOST_AUTO_TEST_CASE(HRectBoundOrOperatorPoint)
   BOOST_REQUIRE_SMALL(b.MinWidth(), 1e-5);
 }
 
+/**
+ * Test that expanding a bound with sparse points (which walks only the
+ * nonzero entries and accounts for the implicit zeros) gives exactly the
+ * same bound as expanding with the densified points.
+ */
+BOOST_AUTO_TEST_CASE(HRectBoundOrOperatorSparseMatrix)
+{
+  arma::sp_mat data;
+  data.sprandn(20, 150, 0.1);
+  const arma::mat dense(data);
+
+  HRectBound<EuclideanDistance> b(20);
+  HRectBound<EuclideanDistance> bDense(20);
+
+  b |= data;
+  bDense |= dense;
+
+  for (size_t i = 0; i < 20; ++i)
+  {
+    BOOST_REQUIRE_CLOSE(b[i].Lo(), bDense[i].Lo(), 1e-10);
+    BOOST_REQUIRE_CLOSE(b[i].Hi(), bDense[i].Hi(), 1e-10);
+  }
+  BOOST_REQUIRE_CLOSE(b.MinWidth(), bDense.MinWidth(), 1e-10);
+}
+
 /**
  * Test that we can expand the bound to include another bound.
  */
@@ -1360,6 +1422,277 @@ BOOST_AUTO_TEST_CASE(KdTreeTest)
   TreeType root(dataset);
 }
 
+/**
+ * The element type of a tree's bound should follow the element type of the
+ * dataset, so single-precision datasets get single-precision bounds.
+ */
+BOOST_AUTO_TEST_CASE(TreeBoundElemTypeTest)
+{
+  typedef KDTree<EuclideanDistance, EmptyStatistic, arma::fmat> FloatTreeType;
+  typedef BallTree<EuclideanDistance, EmptyStatistic, arma::fmat>
+      FloatBallTreeType;
+
+  static_assert(std::is_same<FloatTreeType::ElemType, float>::value,
+      "kd-tree ElemType should be float for arma::fmat");
+  static_assert(std::is_same<
+      typename std::remove_reference<
+          decltype(std::declval<FloatTreeType>().Bound()[0].Lo())>::type,
+      float>::value, "kd-tree bound ranges should hold floats");
+  static_assert(std::is_same<
+      typename std::remove_reference<
+          decltype(std::declval<FloatBallTreeType>().Bound().Radius())>::type,
+      float>::value, "ball tree bound radius should be a float");
+
+  // Also make sure a float tree builds and holds its data correctly.
+  arma::fmat dataset(4, 300, arma::fill::randu);
+  FloatTreeType tree(dataset);
+  BOOST_REQUIRE_EQUAL(tree.Count(), 300);
+  CheckPointBounds(tree);
+}
+
+/**
+ * Make sure that a parallel kd-tree build gives exactly the same tree as a
+ * serial build: the split procedure is deterministic, so only the order in
+ * which subtrees are constructed may differ.
+ */
+BOOST_AUTO_TEST_CASE(ParallelKdTreeBuildTest)
+{
+  typedef KDTree<EuclideanDistance, EmptyStatistic, arma::mat> TreeType;
+
+  arma::mat dataset(8, 10000);
+  dataset.randu();
+
+  std::vector<size_t> serialNewToOld, parallelNewToOld;
+  TreeType serialRoot(dataset, serialNewToOld, 20, false);
+  TreeType parallelRoot(dataset, parallelNewToOld, 20, true);
+
+  // The point permutations must be identical.
+  BOOST_REQUIRE_EQUAL(serialNewToOld.size(), parallelNewToOld.size());
+  for (size_t i = 0; i < serialNewToOld.size(); ++i)
+    BOOST_REQUIRE_EQUAL(serialNewToOld[i], parallelNewToOld[i]);
+
+  // The parallel-built tree must still satisfy the bound invariants.
+  BOOST_REQUIRE_EQUAL(parallelRoot.Count(), dataset.n_cols);
+  CheckPointBounds(parallelRoot);
+}
+
+/**
+ * Test that Compact() preserves the structure of a kd-tree: node counts,
+ * point memberships, and bound invariants must be unchanged after the nodes
+ * are relocated into the arena.
+ */
+BOOST_AUTO_TEST_CASE(KdTreeCompactTest)
+{
+  typedef KDTree<EuclideanDistance, EmptyStatistic, arma::mat> TreeType;
+
+  arma::mat dataset(5, 5000);
+  dataset.randu();
+
+  TreeType root(dataset);
+
+  // Record the preorder (begin, count) sequence before compaction.
+  std::vector<std::pair<size_t, size_t>> before;
+  std::stack<TreeType*> stack;
+  stack.push(&root);
+  while (!stack.empty())
+  {
+    TreeType* node = stack.top();
+    stack.pop();
+    before.push_back(std::make_pair(node->Begin(), node->Count()));
+    if (node->Right())
+      stack.push(node->Right());
+    if (node->Left())
+      stack.push(node->Left());
+  }
+
+  root.Compact();
+
+  // Compacting twice should be a no-op.
+  root.Compact();
+
+  // The preorder (begin, count) sequence must be unchanged.
+  size_t index = 0;
+  stack.push(&root);
+  while (!stack.empty())
+  {
+    TreeType* node = stack.top();
+    stack.pop();
+    BOOST_REQUIRE_LT(index, before.size());
+    BOOST_REQUIRE_EQUAL(node->Begin(), before[index].first);
+    BOOST_REQUIRE_EQUAL(node->Count(), before[index].second);
+    ++index;
+    if (node->Right())
+    {
+      BOOST_REQUIRE_EQUAL(node->Right()->Parent(), node);
+      stack.push(node->Right());
+    }
+    if (node->Left())
+    {
+      BOOST_REQUIRE_EQUAL(node->Left()->Parent(), node);
+      stack.push(node->Left());
+    }
+  }
+  BOOST_REQUIRE_EQUAL(index, before.size());
+
+  // The compacted tree must still satisfy the bound invariants.
+  CheckPointBounds(root);
+}
+
+// Check that the point ranges of a tree are consistent: each internal node's
+// count is the sum of its children's counts, and the leaf ranges tile
+// [0, numPoints) contiguously.
+template<typename TreeType>
+void CheckPointRanges(TreeType& node, const size_t numPoints)
+{
+  std::vector<std::pair<size_t, size_t>> leaves;
+  std::stack<TreeType*> stack;
+  stack.push(&node);
+  while (!stack.empty())
+  {
+    TreeType* current = stack.top();
+    stack.pop();
+    if (current->IsLeaf())
+    {
+      if (current->Count() > 0)
+        leaves.push_back(std::make_pair(current->Begin(), current->Count()));
+    }
+    else
+    {
+      BOOST_REQUIRE_EQUAL(current->Count(),
+          current->Left()->Count() + current->Right()->Count());
+      stack.push(current->Right());
+      stack.push(current->Left());
+    }
+  }
+
+  std::sort(leaves.begin(), leaves.end());
+  size_t next = 0;
+  for (size_t i = 0; i < leaves.size(); ++i)
+  {
+    BOOST_REQUIRE_EQUAL(leaves[i].first, next);
+    next += leaves[i].second;
+  }
+  BOOST_REQUIRE_EQUAL(next, numPoints);
+}
+
+/**
+ * Insert and delete points incrementally, and make sure the tree invariants
+ * hold after every batch of updates and after a rebuild.
+ */
+BOOST_AUTO_TEST_CASE(IncrementalKdTreeUpdateTest)
+{
+  typedef KDTree<EuclideanDistance, EmptyStatistic, arma::mat> TreeType;
+
+  arma::mat dataset(4, 300);
+  dataset.randu();
+
+  TreeType root(dataset);
+
+  // Insert some new points, spread a bit beyond the original unit cube so
+  // that the bounds must actually widen.
+  for (size_t i = 0; i < 50; ++i)
+  {
+    arma::vec point(4);
+    point.randu();
+    point *= 1.5;
+    const size_t index = root.InsertPoint(point);
+
+    BOOST_REQUIRE_LT(index, root.Dataset().n_cols);
+    for (size_t d = 0; d < 4; ++d)
+      BOOST_REQUIRE_CLOSE(root.Dataset()(d, index), point[d], 1e-10);
+  }
+
+  BOOST_REQUIRE_EQUAL(root.NumDescendants(), 350);
+  BOOST_REQUIRE_EQUAL(root.Dataset().n_cols, 350);
+  CheckPointRanges(root, 350);
+  CheckPointBounds(root);
+
+  // Now delete some points (from assorted positions).
+  for (size_t i = 0; i < 30; ++i)
+    root.DeletePoint(math::RandInt(0, root.NumDescendants()));
+
+  BOOST_REQUIRE_EQUAL(root.NumDescendants(), 320);
+  BOOST_REQUIRE_EQUAL(root.Dataset().n_cols, 320);
+  CheckPointRanges(root, 320);
+  CheckPointBounds(root);
+
+  // The imbalance measure must be a valid child fraction.
+  const double imbalance = root.Imbalance();
+  BOOST_REQUIRE_GE(imbalance, 0.5);
+  BOOST_REQUIRE_LE(imbalance, 1.0);
+
+  // A rebuild must preserve the point set and restore the invariants.
+  arma::mat before(root.Dataset());
+  root.Rebuild();
+
+  BOOST_REQUIRE_EQUAL(root.NumDescendants(), 320);
+  CheckPointRanges(root, 320);
+  CheckPointBounds(root);
+
+  // Every original point must still be present exactly once (the rebuild may
+  // reorder the dataset).
+  std::vector<bool> found(320, false);
+  for (size_t i = 0; i < 320; ++i)
+  {
+    bool matched = false;
+    for (size_t j = 0; j < 320; ++j)
+    {
+      if (!found[j] &&
+          arma::approx_equal(before.col(i), root.Dataset().col(j),
+              "absdiff", 1e-10))
+      {
+        found[j] = true;
+        matched = true;
+        break;
+      }
+    }
+    BOOST_REQUIRE(matched);
+  }
+}
+
+/**
+ * The Morton pre-sort must produce a permutation of the original dataset,
+ * with a correct oldFromNew mapping, and must be deterministic (so sorting a
+ * sorted dataset leaves it unchanged).  Trees built on the sorted data must
+ * still be valid.
+ */
+BOOST_AUTO_TEST_CASE(MortonOrderTest)
+{
+  arma::mat dataset(3, 1000);
+  dataset.randu();
+  arma::mat original(dataset);
+
+  std::vector<size_t> oldFromNew;
+  MortonOrder(dataset, oldFromNew);
+
+  // The mapping must be a permutation, and every column must come from where
+  // the mapping says it does.
+  BOOST_REQUIRE_EQUAL(oldFromNew.size(), 1000);
+  std::vector<bool> seen(1000, false);
+  for (size_t i = 0; i < 1000; ++i)
+  {
+    BOOST_REQUIRE_LT(oldFromNew[i], 1000);
+    BOOST_REQUIRE(!seen[oldFromNew[i]]);
+    seen[oldFromNew[i]] = true;
+
+    for (size_t d = 0; d < 3; ++d)
+      BOOST_REQUIRE_CLOSE(dataset(d, i), original(d, oldFromNew[i]), 1e-10);
+  }
+
+  // Sorting the already sorted dataset must be the identity permutation.
+  arma::mat sorted(dataset);
+  std::vector<size_t> identity;
+  MortonOrder(sorted, identity);
+  for (size_t i = 0; i < 1000; ++i)
+    BOOST_REQUIRE_EQUAL(identity[i], i);
+  CheckMatrices(sorted, dataset);
+
+  // A tree built on the sorted dataset must satisfy the usual invariants.
+  typedef KDTree<EuclideanDistance, EmptyStatistic, arma::mat> TreeType;
+  TreeType root(dataset);
+  CheckPointBounds(root);
+}
+
 BOOST_AUTO_TEST_CASE(MaxRPTreeTest)
 {
   typedef MaxRPTree<EuclideanDistance, EmptyStatistic, arma::mat> TreeType;
@@ -10,6 +10,7 @@
  * http://www.opensource.org/licenses/BSD-3-Clause for more information.
  */
 #include <mlpack/methods/emst/union_find.hpp>
+#include <mlpack/methods/emst/concurrent_union_find.hpp>
 
 #include <mlpack/core.hpp>
 #include <boost/test/unit_test.hpp>
@@ -51,4 +52,55 @@ BOOST_AUTO_TEST_CASE(TestUnion)
   BOOST_REQUIRE(testUnionFind.Find(6) == testUnionFind.Find(3));
 }
 
+BOOST_AUTO_TEST_CASE(ConcurrentTestFind)
+{
+  static const size_t testSize = 10;
+  ConcurrentUnionFind testUnionFind(testSize);
+
+  for (size_t i = 0; i < testSize; i++)
+    BOOST_REQUIRE(testUnionFind.Find(i) == i);
+
+  testUnionFind.Union(0, 1);
+  testUnionFind.Union(1, 2);
+
+  BOOST_REQUIRE(testUnionFind.Find(2) == testUnionFind.Find(0));
+}
+
+BOOST_AUTO_TEST_CASE(ConcurrentTestUnion)
+{
+  static const size_t testSize = 10;
+  ConcurrentUnionFind testUnionFind(testSize);
+
+  testUnionFind.Union(0, 1);
+  testUnionFind.Union(2, 3);
+  testUnionFind.Union(0, 2);
+  testUnionFind.Union(5, 0);
+  testUnionFind.Union(0, 6);
+
+  BOOST_REQUIRE(testUnionFind.Find(0) == testUnionFind.Find(1));
+  BOOST_REQUIRE(testUnionFind.Find(2) == testUnionFind.Find(3));
+  BOOST_REQUIRE(testUnionFind.Find(1) == testUnionFind.Find(5));
+  BOOST_REQUIRE(testUnionFind.Find(6) == testUnionFind.Find(3));
+}
+
+/**
+ * Perform many unions from multiple threads at once, and check that the
+ * resulting components are correct and that each component's representative is
+ * its smallest index.
+ */
+BOOST_AUTO_TEST_CASE(ConcurrentParallelUnionTest)
+{
+  static const size_t testSize = 10000;
+  ConcurrentUnionFind testUnionFind(testSize);
+
+  // Unite every element with its neighbor two steps away, in parallel; this
+  // produces two components (even indices and odd indices).
+  #pragma omp parallel for
+  for (omp_size_t i = 0; i < (omp_size_t) (testSize - 2); ++i)
+    testUnionFind.Union(i, i + 2);
+
+  for (size_t i = 0; i < testSize; ++i)
+    BOOST_REQUIRE_EQUAL(testUnionFind.Find(i), i % 2);
+}
+
 BOOST_AUTO_TEST_SUITE_END();